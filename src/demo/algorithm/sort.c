@@ -230,6 +230,64 @@ static tb_void_t tb_sort_int_test_func_quick()
     // free
     tb_free(data);
 }
+static tb_void_t tb_sort_int_test_perf_parallel(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data);
+    
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_long(&array_iterator, data, n);
+
+    // make
+    for (i = 0; i < n; i++) data[i] = tb_random_range(TB_MINS16, TB_MAXS16);
+    
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_parallel_sort_all(iterator, tb_null);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_parallel_sort_int_all: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // free
+    tb_free(data);
+}
+static tb_void_t tb_sort_int_test_perf_radix(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data);
+    
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_long(&array_iterator, data, n);
+
+    // make
+    for (i = 0; i < n; i++) data[i] = tb_random_range(TB_MINS16, TB_MAXS16);
+    
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_radix_sort_all(iterator);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_radix_sort_int_all: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // free
+    tb_free(data);
+}
 static tb_void_t tb_sort_int_test_perf_heap(tb_size_t n)
 {
     __tb_volatile__ tb_size_t i = 0;
@@ -475,6 +533,113 @@ static tb_void_t tb_sort_str_test_perf_heap(tb_size_t n)
     for (i = 0; i < n; i++) tb_free(data[i]);
     tb_free(data);
 }
+static tb_void_t tb_sort_str_test_perf_radix(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_char_t** data = (tb_char_t**)tb_nalloc0(n, sizeof(tb_char_t*));
+    tb_assert_and_check_return(data);
+
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_str(&array_iterator, data, n);
+
+    // make
+    tb_char_t s[256] = {0};
+    for (i = 0; i < n; i++) 
+    {
+        tb_long_t r = tb_snprintf(s, 256, "%x", tb_random_range(0, TB_MAXU32)); 
+        s[r] = '\0'; 
+        data[i] = tb_strdup(s);
+    }
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_radix_sort_all(iterator);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_radix_sort_str_all: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(tb_strcmp(data[i - 1], data[i]) <= 0);
+
+    // free data
+    for (i = 0; i < n; i++) tb_free(data[i]);
+    tb_free(data);
+}
+static tb_long_t tb_sort_mem_test_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    // the keys
+    tb_uint32_t lkey = *((tb_uint32_t const*)litem);
+    tb_uint32_t rkey = *((tb_uint32_t const*)ritem);
+
+    // comp
+    return lkey < rkey? -1 : (lkey > rkey);
+}
+static tb_void_t tb_sort_mem_test_perf_vector(tb_size_t n, tb_bool_t parallel)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init vector of the 16-bytes records
+    tb_vector_ref_t vector = tb_vector_init(n, tb_element_mem(16, tb_null, tb_null));
+    tb_assert_and_check_return(vector);
+
+    // make
+    tb_uint32_t record[4] = {0};
+    for (i = 0; i < n; i++) 
+    {
+        record[0] = tb_random_range(0, TB_MAXU32);
+        record[1] = (tb_uint32_t)i;
+        tb_vector_insert_tail(vector, record);
+    }
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    if (parallel) tb_parallel_sort_all(vector, tb_sort_mem_test_comp);
+    else tb_quick_sort_all(vector, tb_sort_mem_test_comp);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_%s_sort_mem_all: %lld ms", parallel? "parallel" : "quick", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(tb_sort_mem_test_comp(vector, tb_iterator_item(vector, i - 1), tb_iterator_item(vector, i)) <= 0);
+
+    // exit vector
+    tb_vector_exit(vector);
+}
+static tb_long_t tb_sort_long_test_comp_desc(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+{
+    // comp in the descending order
+    return ((tb_long_t)ldata < (tb_long_t)rdata) - ((tb_long_t)ldata > (tb_long_t)rdata);
+}
+static tb_void_t tb_sort_long_test_func_vector_desc()
+{
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000;
+
+    // init vector with the descending comparator
+    tb_element_t element = tb_element_long();
+    element.comp = tb_sort_long_test_comp_desc;
+    tb_vector_ref_t vector = tb_vector_init(n, element);
+    tb_assert_and_check_return(vector);
+
+    // make
+    for (i = 0; i < n; i++) tb_vector_insert_tail(vector, (tb_cpointer_t)tb_random_range(0, (tb_long_t)n));
+
+    // sort by the element comparator
+    tb_sort_all(vector, tb_null);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break((tb_long_t)tb_iterator_item(vector, i - 1) >= (tb_long_t)tb_iterator_item(vector, i));
+    tb_trace_i("tb_sort_all: vector: descending: %s", i == n? "ok" : "failed");
+
+    // exit vector
+    tb_vector_exit(vector);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
@@ -485,6 +650,7 @@ tb_int_t tb_demo_algorithm_sort_main(tb_int_t argc, tb_char_t** argv)
     tb_sort_int_test_func_quick();
     tb_sort_int_test_func_bubble();
     tb_sort_int_test_func_insert();
+    tb_sort_long_test_func_vector_desc();
 
     // perf
     tb_sort_int_test_perf(1000);
@@ -492,11 +658,25 @@ tb_int_t tb_demo_algorithm_sort_main(tb_int_t argc, tb_char_t** argv)
     tb_sort_int_test_perf_quick(1000);
     tb_sort_int_test_perf_bubble(1000);
     tb_sort_int_test_perf_insert(1000);
+    tb_sort_int_test_perf_radix(1000);
     tb_sort_str_test_perf(1000);
     tb_sort_str_test_perf_heap(1000);
     tb_sort_str_test_perf_quick(1000);
     tb_sort_str_test_perf_bubble(1000);
     tb_sort_str_test_perf_insert(1000);
+    tb_sort_str_test_perf_radix(1000);
+
+    // perf for the large contiguous items
+    tb_sort_int_test_perf(1000000);
+    tb_sort_int_test_perf_quick(1000000);
+    tb_sort_int_test_perf_parallel(1000000);
+    tb_sort_int_test_perf_radix(1000000);
+    tb_sort_int_test_perf_heap(1000000);
+    tb_sort_str_test_perf(1000000);
+    tb_sort_str_test_perf_quick(1000000);
+    tb_sort_str_test_perf_radix(1000000);
+    tb_sort_mem_test_perf_vector(1000000, tb_false);
+    tb_sort_mem_test_perf_vector(1000000, tb_true);
 
     return 0;
 }
@@ -344,8 +344,8 @@ tb_int_t tb_demo_asio_aicpd_main(tb_int_t argc, tb_char_t** argv)
     tb_thread_ref_t     loop[16] = {tb_null};
     do
     {
-        // init aicp
-        aicp = tb_aicp_init(16);
+        // init aicp with the sharded reactors
+        aicp = tb_aicp_init_sharded(16, 0);
         tb_assert_and_check_break(aicp);
 
         // init sock aico
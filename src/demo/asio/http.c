@@ -3,6 +3,43 @@
  */
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default pipelined request count
+#define TB_DEMO_HTTP_PIPE_COUNT             (300)
+
+// the response content of the pipelined requests
+#define TB_DEMO_HTTP_PIPE_CONTENT           "hello world!"
+
+// the chunk count of the chunked response
+#define TB_DEMO_HTTP_PIPE_CHUNKN            (3)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the pipe type
+typedef struct __tb_demo_http_pipe_t
+{
+    // the request count
+    tb_size_t           count;
+
+    // the next response index
+    tb_size_t           index;
+
+    // the ok count
+    tb_size_t           ok;
+
+    // the failed count
+    tb_size_t           failed;
+
+    // the finished event
+    tb_event_ref_t      event;
+
+}tb_demo_http_pipe_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -51,6 +88,167 @@ static tb_bool_t tb_demo_aicp_http_post_func(tb_aicp_http_ref_t http, tb_size_t
     return tb_true;
 }
 
+static tb_long_t tb_demo_aicp_http_pipe_body_func(tb_aicp_httpd_session_ref_t session, tb_byte_t* data, tb_size_t size, tb_cpointer_t priv)
+{
+    // the left chunk count
+    tb_size_t* left = (tb_size_t*)priv;
+    tb_assert_and_check_return_val(left, -1);
+
+    // end or closed? 
+    if (!data || !*left || size < sizeof(TB_DEMO_HTTP_PIPE_CONTENT) - 1)
+    {
+        tb_free(left);
+        return -1;
+    }
+
+    // fill one chunk
+    (*left)--;
+    tb_memcpy(data, TB_DEMO_HTTP_PIPE_CONTENT, sizeof(TB_DEMO_HTTP_PIPE_CONTENT) - 1);
+    return sizeof(TB_DEMO_HTTP_PIPE_CONTENT) - 1;
+}
+static tb_bool_t tb_demo_aicp_http_pipe_serve_func(tb_aicp_httpd_session_ref_t session, tb_http_request_t const* request, tb_byte_t const* data, tb_size_t size, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(request && request->path, tb_false);
+
+    // respond the content with the content length
+    if (!tb_strcmp(request->path, "/sized"))
+        return tb_aicp_httpd_resp_data(session, TB_HTTP_CODE_OK, "text/plain", (tb_byte_t const*)TB_DEMO_HTTP_PIPE_CONTENT, sizeof(TB_DEMO_HTTP_PIPE_CONTENT) - 1);
+
+    // respond the content with the chunked encoding
+    tb_size_t* left = tb_malloc0_type(tb_size_t);
+    tb_assert_and_check_return_val(left, tb_false);
+    *left = TB_DEMO_HTTP_PIPE_CHUNKN;
+    if (!tb_aicp_httpd_resp_body(session, TB_HTTP_CODE_OK, "text/plain", -1, tb_demo_aicp_http_pipe_body_func, left))
+    {
+        tb_free(left);
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_aicp_http_pipe_func(tb_aicp_http_ref_t http, tb_size_t state, tb_http_status_t const* status, tb_byte_t const* data, tb_size_t size, tb_cpointer_t priv)
+{
+    // check
+    tb_demo_http_pipe_t* pipe = (tb_demo_http_pipe_t*)priv;
+    tb_assert_and_check_return_val(pipe, tb_false);
+
+    // the responses are notified in order, the odd requests are chunked
+    tb_size_t index = pipe->index++;
+    tb_size_t need = (sizeof(TB_DEMO_HTTP_PIPE_CONTENT) - 1) * ((index & 1)? TB_DEMO_HTTP_PIPE_CHUNKN : 1);
+
+    // check the response
+    if (    state == TB_STATE_OK && status && status->code == TB_HTTP_CODE_OK && data && size == need 
+        &&  !tb_strncmp((tb_char_t const*)data + size - (sizeof(TB_DEMO_HTTP_PIPE_CONTENT) - 1), TB_DEMO_HTTP_PIPE_CONTENT, sizeof(TB_DEMO_HTTP_PIPE_CONTENT) - 1))
+        pipe->ok++;
+    else
+    {
+        // trace
+        tb_trace_e("pipe[%lu]: failed, state: %s, code: %lu, size: %lu", index, tb_state_cstr(state), status? (tb_size_t)status->code : 0, size);
+
+        // failed
+        pipe->failed++;
+    }
+
+    // finished?
+    if (pipe->ok + pipe->failed == pipe->count) tb_event_post(pipe->event);
+
+    // ok
+    return tb_true;
+}
+static tb_pointer_t tb_demo_aicp_http_pipe_loop(tb_cpointer_t priv)
+{
+    // loop aicp
+    tb_aicp_ref_t aicp = (tb_aicp_ref_t)priv;
+    if (aicp) tb_aicp_loop(aicp);
+
+    // exit
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+static tb_void_t tb_demo_aicp_http_pipe(tb_size_t count)
+{
+    // done
+    tb_aicp_ref_t           aicp = tb_null;
+    tb_aicp_httpd_ref_t     httpd = tb_null;
+    tb_aicp_http_ref_t      http = tb_null;
+    tb_thread_ref_t         loop = tb_null;
+    tb_demo_http_pipe_t     pipe = {0};
+    do
+    {
+        // init pipe
+        pipe.count = count;
+        pipe.event = tb_event_init();
+        tb_assert_and_check_break(pipe.event);
+
+        // init aicp
+        aicp = tb_aicp_init(16);
+        tb_assert_and_check_break(aicp);
+
+        // init httpd on the random local port
+        tb_ipaddr_t addr;
+        tb_ipaddr_set(&addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4);
+        httpd = tb_aicp_httpd_init(aicp, &addr, tb_demo_aicp_http_pipe_serve_func, tb_null);
+        tb_assert_and_check_break(httpd);
+
+        // start httpd
+        if (!tb_aicp_httpd_start(httpd)) break;
+
+        // init loop
+        loop = tb_thread_init(tb_null, tb_demo_aicp_http_pipe_loop, aicp, 0);
+        tb_assert_and_check_break(loop);
+
+        // init http
+        http = tb_aicp_http_init(aicp);
+        tb_assert_and_check_break(http);
+
+        // init url
+        tb_char_t url[64];
+        tb_snprintf(url, sizeof(url), "http://127.0.0.1:%u/", tb_ipaddr_port(tb_aicp_httpd_addr(httpd)));
+        if (!tb_aicp_http_ctrl(http, TB_HTTP_OPTION_SET_URL, url)) break;
+
+        // pipeline the requests, mixing the content length and the chunked responses
+        tb_size_t i = 0;
+        tb_hong_t time = tb_mclock();
+        for (i = 0; i < count; i++)
+        {
+            if (!tb_aicp_http_pipe(http, (i & 1)? "/chunked" : "/sized", tb_demo_aicp_http_pipe_func, &pipe)) break;
+        }
+        tb_assert_and_check_break(i == count);
+
+        // wait all responses
+        tb_long_t wait = tb_event_wait(pipe.event, 30000);
+        time = tb_mclock() - time;
+
+        // trace
+        tb_trace_i("pipe: %s: %lu requests, ok: %lu, failed: %lu, %lld ms", wait > 0? "finished" : "timeout", count, pipe.ok, pipe.failed, time);
+
+    } while (0);
+
+    // exit http
+    if (http) tb_aicp_http_exit(http);
+
+    // exit httpd
+    if (httpd) tb_aicp_httpd_exit(httpd);
+
+    // kill aicp
+    if (aicp) tb_aicp_kill(aicp);
+
+    // exit loop
+    if (loop)
+    {
+        tb_thread_wait(loop, -1);
+        tb_thread_exit(loop);
+    }
+
+    // exit aicp
+    if (aicp) tb_aicp_exit(aicp);
+
+    // exit event
+    if (pipe.event) tb_event_exit(pipe.event);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
@@ -59,6 +257,13 @@ tb_int_t tb_demo_asio_http_main(tb_int_t argc, tb_char_t** argv)
     // check
     tb_assert_and_check_return_val(argv[1], 0);
 
+    // pipeline the requests to the local httpd: --pipe [count]
+    if (!tb_strcmp(argv[1], "--pipe"))
+    {
+        tb_demo_aicp_http_pipe(argv[2]? tb_atoi(argv[2]) : TB_DEMO_HTTP_PIPE_COUNT);
+        return 0;
+    }
+
     // done
     tb_aicp_ref_t           aicp = tb_null;
     tb_aicp_http_ref_t      http = tb_null;
@@ -0,0 +1,290 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the loop count of the server
+#define TB_DEMO_HTTPD_BENCH_LOOP_MAXN                   (4)
+
+// the client maximum count
+#define TB_DEMO_HTTPD_BENCH_CLIENT_MAXN                 (64)
+
+// the pipelined request maximum count
+#define TB_DEMO_HTTPD_BENCH_PIPE_MAXN                   (64)
+
+// the response content
+#define TB_DEMO_HTTPD_BENCH_CONTENT                     "hello world!"
+
+// the request
+#define TB_DEMO_HTTPD_BENCH_REQUEST                     "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bench type
+typedef struct __tb_demo_httpd_bench_t
+{
+    // the server address
+    tb_ipaddr_t         addr;
+
+    // the pipelined request count
+    tb_size_t           pipe;
+
+    // is stopped?
+    tb_atomic_t         stop;
+
+    // the response count
+    tb_atomic_t         count;
+
+    // the failed client count
+    tb_atomic_t         failed;
+
+}tb_demo_httpd_bench_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * server
+ */
+static tb_bool_t tb_demo_httpd_bench_func(tb_aicp_httpd_session_ref_t session, tb_http_request_t const* request, tb_byte_t const* data, tb_size_t size, tb_cpointer_t priv)
+{
+    // respond the content
+    return tb_aicp_httpd_resp_data(session, TB_HTTP_CODE_OK, "text/plain", (tb_byte_t const*)TB_DEMO_HTTPD_BENCH_CONTENT, sizeof(TB_DEMO_HTTPD_BENCH_CONTENT) - 1);
+}
+static tb_pointer_t tb_demo_httpd_bench_loop(tb_cpointer_t priv)
+{
+    // loop aicp
+    tb_aicp_ref_t aicp = (tb_aicp_ref_t)priv;
+    if (aicp) tb_aicp_loop(aicp);
+
+    // exit
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * client
+ */
+static tb_bool_t tb_demo_httpd_bench_send(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t size)
+{
+    // send all data
+    tb_size_t send = 0;
+    while (send < size)
+    {
+        tb_long_t real = tb_socket_send(sock, data + send, size - send);
+        if (real > 0) send += real;
+        else if (!real)
+        {
+            // wait it
+            if (tb_aioo_wait(sock, TB_AIOE_CODE_SEND, 10000) <= 0) return tb_false;
+        }
+        else return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_long_t tb_demo_httpd_bench_recv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size)
+{
+    // recv some data
+    while (1)
+    {
+        tb_long_t real = tb_socket_recv(sock, data, size);
+        if (real) return real;
+
+        // wait it
+        if (tb_aioo_wait(sock, TB_AIOE_CODE_RECV, 10000) <= 0) return -1;
+    }
+}
+static tb_pointer_t tb_demo_httpd_bench_client(tb_cpointer_t priv)
+{
+    // the bench
+    tb_demo_httpd_bench_t* bench = (tb_demo_httpd_bench_t*)priv;
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_socket_ref_t sock = tb_null;
+    do
+    {
+        // check
+        tb_assert_and_check_break(bench);
+
+        // init sock
+        sock = tb_socket_init(TB_SOCKET_TYPE_TCP, tb_ipaddr_family(&bench->addr));
+        tb_assert_and_check_break(sock);
+
+        // connect it
+        tb_long_t conn = -1;
+        while (!(conn = tb_socket_connect(sock, &bench->addr)))
+        {
+            conn = tb_aioo_wait(sock, TB_AIOE_CODE_CONN, 10000);
+            tb_check_break(conn > 0);
+        }
+        tb_check_break(conn > 0);
+
+        // make the pipelined requests
+        tb_char_t   reqs[TB_DEMO_HTTPD_BENCH_PIPE_MAXN * sizeof(TB_DEMO_HTTPD_BENCH_REQUEST)];
+        tb_size_t   reqn = sizeof(TB_DEMO_HTTPD_BENCH_REQUEST) - 1;
+        tb_size_t   i = 0;
+        for (i = 0; i < bench->pipe; i++) tb_memcpy(reqs + i * reqn, TB_DEMO_HTTPD_BENCH_REQUEST, reqn);
+
+        // done requests
+        tb_byte_t   data[8192];
+        tb_size_t   size = 0;
+        tb_size_t   left = 0;
+        while (!tb_atomic_get(&bench->stop))
+        {
+            // send the pipelined requests
+            left = bench->pipe;
+            if (!tb_demo_httpd_bench_send(sock, (tb_byte_t const*)reqs, bench->pipe * reqn)) break;
+
+            // recv all responses
+            while (left)
+            {
+                // recv data
+                tb_long_t real = tb_demo_httpd_bench_recv(sock, data + size, sizeof(data) - size);
+                tb_check_break(real > 0);
+                size += real;
+
+                // parse the responses: head + content
+                tb_size_t   cont = sizeof(TB_DEMO_HTTPD_BENCH_CONTENT) - 1;
+                tb_byte_t*  p = data;
+                tb_byte_t*  e = data + size;
+                while (left && p < e)
+                {
+                    // find the head end
+                    tb_byte_t* q = p;
+                    while (q + 3 < e && tb_memcmp(q, "\r\n\r\n", 4)) q++;
+                    tb_check_break(q + 3 < e && q + 4 + cont <= e);
+
+                    // check the response
+                    tb_assert_and_check_break(!tb_strncmp((tb_char_t const*)p, "HTTP/1.1 200", 12));
+
+                    // next response
+                    p = q + 4 + cont;
+                    left--;
+                }
+
+                // remove the parsed responses
+                size = e - p;
+                if (size) tb_memmov(data, p, size);
+                tb_check_break(size < sizeof(data));
+            }
+            tb_check_break(!left);
+
+            // save count
+            tb_atomic_fetch_and_add(&bench->count, bench->pipe);
+        }
+
+        // ok? all responses have been received
+        ok = !left;
+
+    } while (0);
+
+    // failed?
+    if (!ok && bench) tb_atomic_fetch_and_inc(&bench->failed);
+
+    // exit sock
+    if (sock) tb_socket_exit(sock);
+
+    // exit
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_asio_httpd_bench_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the arguments: [clients] [seconds] [pipe]
+    tb_size_t clients   = argc > 1? tb_atoi(argv[1]) : 8;
+    tb_size_t seconds   = argc > 2? tb_atoi(argv[2]) : 5;
+    tb_size_t pipe      = argc > 3? tb_atoi(argv[3]) : 16;
+    clients = tb_max(tb_min(clients, TB_DEMO_HTTPD_BENCH_CLIENT_MAXN), 1);
+    pipe    = tb_max(tb_min(pipe, TB_DEMO_HTTPD_BENCH_PIPE_MAXN), 1);
+
+    // done
+    tb_aicp_ref_t           aicp = tb_null;
+    tb_aicp_httpd_ref_t     httpd = tb_null;
+    tb_thread_ref_t         loop[TB_DEMO_HTTPD_BENCH_LOOP_MAXN] = {0};
+    tb_thread_ref_t         client[TB_DEMO_HTTPD_BENCH_CLIENT_MAXN] = {0};
+    tb_demo_httpd_bench_t   bench = {{0}};
+    tb_size_t               i = 0;
+    do
+    {
+        // init aicp
+        aicp = tb_aicp_init(TB_DEMO_HTTPD_BENCH_CLIENT_MAXN + 16);
+        tb_assert_and_check_break(aicp);
+
+        // init httpd on the random local port
+        tb_ipaddr_t addr;
+        tb_ipaddr_set(&addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4);
+        httpd = tb_aicp_httpd_init(aicp, &addr, tb_demo_httpd_bench_func, tb_null);
+        tb_assert_and_check_break(httpd);
+
+        // start httpd
+        if (!tb_aicp_httpd_start(httpd)) break;
+
+        // init loop
+        for (i = 0; i < tb_arrayn(loop); i++) loop[i] = tb_thread_init(tb_null, tb_demo_httpd_bench_loop, aicp, 0);
+
+        // init bench
+        tb_ipaddr_copy(&bench.addr, tb_aicp_httpd_addr(httpd));
+        bench.pipe = pipe;
+
+        // trace
+        tb_trace_i("bench: %{ipaddr}, clients: %lu, pipe: %lu, %lus ..", &bench.addr, clients, pipe, seconds);
+
+        // init clients
+        tb_hong_t time = tb_mclock();
+        for (i = 0; i < clients; i++) client[i] = tb_thread_init(tb_null, tb_demo_httpd_bench_client, &bench, 0);
+
+        // wait some time
+        tb_msleep(seconds * 1000);
+
+        // stop and wait clients
+        tb_atomic_set(&bench.stop, 1);
+        for (i = 0; i < clients; i++)
+        {
+            if (client[i])
+            {
+                tb_thread_wait(client[i], -1);
+                tb_thread_exit(client[i]);
+            }
+        }
+        time = tb_mclock() - time;
+
+        // trace
+        tb_size_t count = tb_atomic_get(&bench.count);
+        tb_trace_i("bench: %lu requests, %lld ms, %lld req/s, failed clients: %lu", count, time, time > 0? ((tb_hong_t)count * 1000) / time : 0, tb_atomic_get(&bench.failed));
+
+    } while (0);
+
+    // exit httpd
+    if (httpd) tb_aicp_httpd_exit(httpd);
+    httpd = tb_null;
+
+    // kill aicp
+    if (aicp) tb_aicp_kill(aicp);
+
+    // exit loop
+    for (i = 0; i < tb_arrayn(loop); i++)
+    {
+        if (loop[i])
+        {
+            tb_thread_wait(loop[i], -1);
+            tb_thread_exit(loop[i]);
+        }
+    }
+
+    // exit aicp
+    if (aicp) tb_aicp_exit(aicp);
+    aicp = tb_null;
+
+    // ok
+    return 0;
+}
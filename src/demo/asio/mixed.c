@@ -0,0 +1,434 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the port
+#define TB_DEMO_PORT                (9191)
+
+// the ping count
+#define TB_DEMO_PING_MAXN           (5000)
+
+// the ping size
+#define TB_DEMO_PING_SIZE           (16)
+
+// the disk block size
+#define TB_DEMO_DISK_BLOCK          (1 << 16)
+
+// the disk file maximum size
+#define TB_DEMO_DISK_MAXN           (1 << 28)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the demo context type
+typedef struct __tb_demo_context_t
+{
+    // the aicp
+    tb_aicp_ref_t       aicp;
+
+    // the finished event
+    tb_event_ref_t      event;
+
+    // the listening aico
+    tb_aico_ref_t       server;
+
+    // the ping aico
+    tb_aico_ref_t       client;
+
+    // the disk aico
+    tb_aico_ref_t       disk;
+
+    // the ping data
+    tb_byte_t           ping[TB_DEMO_PING_SIZE];
+
+    // the pong data
+    tb_byte_t           pong[TB_DEMO_PING_SIZE];
+
+    // the echo data
+    tb_byte_t           echo[TB_DEMO_PING_SIZE];
+
+    // the disk data
+    tb_byte_t*          data;
+
+    // the disk offset
+    tb_hize_t           seek;
+
+    // the disk written size
+    tb_hize_t           size;
+
+    // the ping count
+    tb_size_t           count;
+
+    // the ping start time
+    tb_hong_t           time;
+
+    // the total latency
+    tb_hong_t           total;
+
+    // the maximum latency
+    tb_hong_t           maxn;
+
+    // the ping count which latency is larger than 1ms
+    tb_size_t           stall;
+
+    // is finished?
+    tb_bool_t           finished;
+
+}tb_demo_context_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t tb_demo_aico_clos(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_CLOS, tb_false);
+
+    // exit aico
+    tb_aico_exit(aice->aico);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_demo_finish(tb_demo_context_t* context)
+{
+    // finish it
+    if (!context->finished)
+    {
+        context->finished = tb_true;
+        tb_event_post(context->event);
+    }
+}
+static tb_bool_t tb_demo_disk_writ_func(tb_aice_ref_t aice);
+static tb_bool_t tb_demo_disk_fsync_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_FSYNC, tb_false);
+
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)aice->priv;
+    tb_assert_and_check_return_val(context, tb_false);
+
+    // ok and not finished? write the next block
+    if (aice->state == TB_STATE_OK && !context->finished)
+    {
+        // rewind it
+        if (context->seek + TB_DEMO_DISK_BLOCK > TB_DEMO_DISK_MAXN) context->seek = 0;
+
+        // post writ
+        if (!tb_aico_writ(aice->aico, context->seek, context->data, TB_DEMO_DISK_BLOCK, tb_demo_disk_writ_func, context)) return tb_false;
+    }
+    // closed or failed?
+    else tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_disk_writ_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_WRIT, tb_false);
+
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)aice->priv;
+    tb_assert_and_check_return_val(context, tb_false);
+
+    // ok and not finished? sync it
+    if (aice->state == TB_STATE_OK && !context->finished)
+    {
+        // save size
+        context->seek += aice->u.writ.real;
+        context->size += aice->u.writ.real;
+
+        // post fsync
+        if (!tb_aico_fsync(aice->aico, tb_demo_disk_fsync_func, context)) return tb_false;
+    }
+    // closed or failed?
+    else tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_echo_recv_func(tb_aice_ref_t aice);
+static tb_bool_t tb_demo_echo_send_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // ok? recv the next ping
+    if (aice->state == TB_STATE_OK)
+    {
+        if (!tb_aico_recv(aice->aico, (tb_byte_t*)aice->u.send.data, TB_DEMO_PING_SIZE, tb_demo_echo_recv_func, aice->priv)) return tb_false;
+    }
+    // closed or failed?
+    else tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_echo_recv_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_RECV, tb_false);
+
+    // ok? send it back
+    if (aice->state == TB_STATE_OK)
+    {
+        if (!tb_aico_send(aice->aico, aice->u.recv.data, aice->u.recv.real, tb_demo_echo_send_func, aice->priv)) return tb_false;
+    }
+    // closed or failed?
+    else tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_server_acpt_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_ACPT, tb_false);
+
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)aice->priv;
+    tb_assert_and_check_return_val(context, tb_false);
+
+    // acpt ok?
+    if (aice->state == TB_STATE_OK)
+    {
+        // recv the ping
+        if (!tb_aico_recv(aice->u.acpt.aico, context->echo, TB_DEMO_PING_SIZE, tb_demo_echo_recv_func, context)) return tb_false;
+    }
+    // killed or failed?
+    else tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_client_recv_func(tb_aice_ref_t aice);
+static tb_bool_t tb_demo_client_send_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)aice->priv;
+    tb_assert_and_check_return_val(context, tb_false);
+
+    // ok? recv the pong
+    if (aice->state == TB_STATE_OK)
+    {
+        if (!tb_aico_recv(aice->aico, context->pong, TB_DEMO_PING_SIZE, tb_demo_client_recv_func, context)) return tb_false;
+    }
+    // closed or failed?
+    else
+    {
+        tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+        tb_demo_finish(context);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_client_recv_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_RECV, tb_false);
+
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)aice->priv;
+    tb_assert_and_check_return_val(context, tb_false);
+
+    // ok?
+    if (aice->state == TB_STATE_OK && aice->u.recv.real == TB_DEMO_PING_SIZE)
+    {
+        // the latency
+        tb_hong_t latency = tb_uclock() - context->time;
+        context->total += latency;
+        if (latency > context->maxn) context->maxn = latency;
+        if (latency > 1000) context->stall++;
+
+        // send the next ping
+        if (++context->count < TB_DEMO_PING_MAXN)
+        {
+            context->time = tb_uclock();
+            if (!tb_aico_send(aice->aico, context->ping, TB_DEMO_PING_SIZE, tb_demo_client_send_func, context)) return tb_false;
+        }
+        else
+        {
+            tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+            tb_demo_finish(context);
+        }
+    }
+    // closed or failed?
+    else
+    {
+        tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+        tb_demo_finish(context);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_client_conn_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_CONN, tb_false);
+
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)aice->priv;
+    tb_assert_and_check_return_val(context, tb_false);
+
+    // conn ok? send the first ping
+    if (aice->state == TB_STATE_OK)
+    {
+        context->time = tb_uclock();
+        if (!tb_aico_send(aice->aico, context->ping, TB_DEMO_PING_SIZE, tb_demo_client_send_func, context)) return tb_false;
+    }
+    // timeout or failed?
+    else
+    {
+        // trace
+        tb_trace_i("conn[%p]: state: %s", aice->aico, tb_state_cstr(aice->state));
+
+        // finish it
+        tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+        tb_demo_finish(context);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_pointer_t tb_demo_loop(tb_cpointer_t priv)
+{
+    // loop aicp
+    tb_aicp_ref_t aicp = (tb_aicp_ref_t)priv;
+    if (aicp) tb_aicp_loop(aicp);
+
+    // exit
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+static tb_void_t tb_demo_test(tb_char_t const* path, tb_bool_t disk)
+{
+    // init context
+    tb_demo_context_t context;
+    tb_memset(&context, 0, sizeof(tb_demo_context_t));
+
+    // done
+    tb_thread_ref_t loop = tb_null;
+    do
+    {
+        // init aicp
+        context.aicp = tb_aicp_init(16);
+        tb_assert_and_check_break(context.aicp);
+
+        // init event
+        context.event = tb_event_init();
+        tb_assert_and_check_break(context.event);
+
+        // init addr
+        tb_ipaddr_t addr;
+        tb_ipaddr_set(&addr, "127.0.0.1", TB_DEMO_PORT, TB_IPADDR_FAMILY_IPV4);
+
+        // init server
+        context.server = tb_aico_init(context.aicp);
+        tb_assert_and_check_break(context.server);
+        if (!tb_aico_open_sock_from_type(context.server, TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4)) break;
+        if (!tb_socket_bind(tb_aico_sock(context.server), &addr)) break;
+        if (!tb_socket_listen(tb_aico_sock(context.server), 5)) break;
+        if (!tb_aico_acpt(context.server, tb_demo_server_acpt_func, &context)) break;
+
+        // init disk
+        if (disk)
+        {
+            // init data
+            context.data = tb_malloc_bytes(TB_DEMO_DISK_BLOCK);
+            tb_assert_and_check_break(context.data);
+            tb_memset(context.data, 'x', TB_DEMO_DISK_BLOCK);
+
+            // open file
+            context.disk = tb_aico_init(context.aicp);
+            tb_assert_and_check_break(context.disk);
+            if (!tb_aico_open_file_from_path(context.disk, path, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC | TB_FILE_MODE_BINARY)) break;
+
+            // post writ
+            if (!tb_aico_writ(context.disk, 0, context.data, TB_DEMO_DISK_BLOCK, tb_demo_disk_writ_func, &context)) break;
+        }
+
+        // init client
+        context.client = tb_aico_init(context.aicp);
+        tb_assert_and_check_break(context.client);
+        if (!tb_aico_open_sock_from_type(context.client, TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4)) break;
+        if (!tb_aico_conn(context.client, &addr, tb_demo_client_conn_func, &context)) break;
+
+        // only one loop, the disk i/o will stall all socket completions if it is done in the loop
+        loop = tb_thread_init(tb_null, tb_demo_loop, context.aicp, 0);
+        tb_assert_and_check_break(loop);
+
+        // wait the pings
+        tb_event_wait(context.event, -1);
+
+        // trace
+        tb_trace_i("%s: pings: %lu, avg: %lld us, max: %lld us, stalls(> 1ms): %lu, disk: %llu MB"
+                , disk? "socket + disk" : "socket       "
+                , context.count
+                , context.total / tb_max(context.count, 1)
+                , context.maxn
+                , context.stall
+                , context.size >> 20);
+
+    } while (0);
+
+    // exit aicp
+    if (context.aicp)
+    {
+        // kill all
+        tb_aicp_kill_all(context.aicp);
+
+        // wait all
+        tb_aicp_wait_all(context.aicp, -1);
+
+        // kill aicp
+        tb_aicp_kill(context.aicp);
+    }
+
+    // exit loop
+    if (loop)
+    {
+        tb_thread_wait(loop, -1);
+        tb_thread_exit(loop);
+    }
+
+    // exit aicp
+    if (context.aicp) tb_aicp_exit(context.aicp);
+
+    // exit event
+    if (context.event) tb_event_exit(context.event);
+
+    // exit data
+    if (context.data) tb_free(context.data);
+
+    // remove file
+    if (disk) tb_file_remove(path);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_asio_mixed_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the disk file path
+    tb_char_t const* path = argv[1]? argv[1] : "/tmp/tbox_demo_mixed.bin";
+
+    // the socket latency without the disk i/o
+    tb_demo_test(path, tb_false);
+
+    // the socket latency with the disk i/o
+    tb_demo_test(path, tb_true);
+    return 0;
+}
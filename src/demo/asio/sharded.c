@@ -0,0 +1,379 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the port
+#define TB_DEMO_PORT                (9192)
+
+// the shard count
+#define TB_DEMO_SHARD_MAXN          (4)
+
+// the loop count, less than the shard count for stealing the aice from the shards without loop
+#define TB_DEMO_LOOP_MAXN           (2)
+
+// the client count
+#define TB_DEMO_CLIENT_MAXN         (16)
+
+// the ping count for each client
+#define TB_DEMO_PING_MAXN           (2000)
+
+// the ping size
+#define TB_DEMO_PING_SIZE           (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the demo client type
+typedef struct __tb_demo_client_t
+{
+    // the context
+    struct __tb_demo_context_t*     context;
+
+    // the ping data
+    tb_byte_t                       ping[TB_DEMO_PING_SIZE];
+
+    // the pong data
+    tb_byte_t                       pong[TB_DEMO_PING_SIZE];
+
+    // the ping count
+    tb_size_t                       count;
+
+}tb_demo_client_t;
+
+// the demo session type
+typedef struct __tb_demo_session_t
+{
+    // the echo data
+    tb_byte_t                       echo[TB_DEMO_PING_SIZE];
+
+}tb_demo_session_t;
+
+// the demo context type
+typedef struct __tb_demo_context_t
+{
+    // the aicp
+    tb_aicp_ref_t                   aicp;
+
+    // the finished event
+    tb_event_ref_t                  event;
+
+    // the listening aico
+    tb_aico_ref_t                   server;
+
+    // the clients
+    tb_demo_client_t                clients[TB_DEMO_CLIENT_MAXN];
+
+    // the sessions
+    tb_demo_session_t               sessions[TB_DEMO_CLIENT_MAXN];
+
+    // the accepted count
+    tb_atomic_t                     accepted;
+
+    // the finished client count
+    tb_atomic_t                     finished;
+
+    // the ping count of all clients
+    tb_atomic_t                     pings;
+
+}tb_demo_context_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t tb_demo_aico_clos(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_CLOS, tb_false);
+
+    // exit aico
+    tb_aico_exit(aice->aico);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_demo_client_finish(tb_demo_context_t* context)
+{
+    // all clients have been finished?
+    if (tb_atomic_fetch_and_inc(&context->finished) + 1 == TB_DEMO_CLIENT_MAXN) tb_event_post(context->event);
+}
+static tb_bool_t tb_demo_echo_recv_func(tb_aice_ref_t aice);
+static tb_bool_t tb_demo_echo_send_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // ok? recv the next ping
+    if (aice->state == TB_STATE_OK)
+    {
+        if (!tb_aico_recv(aice->aico, (tb_byte_t*)aice->u.send.data, TB_DEMO_PING_SIZE, tb_demo_echo_recv_func, aice->priv)) return tb_false;
+    }
+    // closed, killed or failed?
+    else tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_echo_recv_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_RECV, tb_false);
+
+    // ok? send it back
+    if (aice->state == TB_STATE_OK)
+    {
+        if (!tb_aico_send(aice->aico, aice->u.recv.data, aice->u.recv.real, tb_demo_echo_send_func, aice->priv)) return tb_false;
+    }
+    // closed, killed or failed?
+    else tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_server_acpt_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_ACPT, tb_false);
+
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)aice->priv;
+    tb_assert_and_check_return_val(context, tb_false);
+
+    // acpt ok?
+    if (aice->state == TB_STATE_OK)
+    {
+        // the session
+        tb_size_t indx = (tb_size_t)tb_atomic_fetch_and_inc(&context->accepted);
+        tb_assert_and_check_return_val(indx < TB_DEMO_CLIENT_MAXN, tb_false);
+
+        // recv the ping
+        tb_byte_t* echo = context->sessions[indx].echo;
+        if (!tb_aico_recv(aice->u.acpt.aico, echo, TB_DEMO_PING_SIZE, tb_demo_echo_recv_func, context)) return tb_false;
+    }
+    // killed or failed?
+    else tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_client_recv_func(tb_aice_ref_t aice);
+static tb_bool_t tb_demo_client_send_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // the client
+    tb_demo_client_t* client = (tb_demo_client_t*)aice->priv;
+    tb_assert_and_check_return_val(client && client->context, tb_false);
+
+    // ok? recv the pong
+    if (aice->state == TB_STATE_OK)
+    {
+        if (!tb_aico_recv(aice->aico, client->pong, TB_DEMO_PING_SIZE, tb_demo_client_recv_func, client)) return tb_false;
+    }
+    // closed or failed?
+    else
+    {
+        tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+        tb_demo_client_finish(client->context);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_client_recv_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_RECV, tb_false);
+
+    // the client
+    tb_demo_client_t* client = (tb_demo_client_t*)aice->priv;
+    tb_assert_and_check_return_val(client && client->context, tb_false);
+
+    // ok?
+    if (aice->state == TB_STATE_OK && aice->u.recv.real == TB_DEMO_PING_SIZE)
+    {
+        // send the next ping
+        tb_atomic_fetch_and_inc(&client->context->pings);
+        if (++client->count < TB_DEMO_PING_MAXN)
+        {
+            if (!tb_aico_send(aice->aico, client->ping, TB_DEMO_PING_SIZE, tb_demo_client_send_func, client)) return tb_false;
+        }
+        /* finished? keep waiting the next pong which will never come,
+         * so the killing aicos are spread across all shards when exiting
+         */
+        else
+        {
+            if (!tb_aico_recv(aice->aico, client->pong, TB_DEMO_PING_SIZE, tb_demo_client_recv_func, client)) return tb_false;
+            tb_demo_client_finish(client->context);
+        }
+    }
+    // closed, killed or failed?
+    else 
+    {
+        // close it
+        tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+
+        // finish it if the pings have been not finished
+        if (client->count < TB_DEMO_PING_MAXN) tb_demo_client_finish(client->context);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_demo_client_conn_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_CONN, tb_false);
+
+    // the client
+    tb_demo_client_t* client = (tb_demo_client_t*)aice->priv;
+    tb_assert_and_check_return_val(client && client->context, tb_false);
+
+    // conn ok? send the first ping
+    if (aice->state == TB_STATE_OK)
+    {
+        if (!tb_aico_send(aice->aico, client->ping, TB_DEMO_PING_SIZE, tb_demo_client_send_func, client)) return tb_false;
+    }
+    // timeout or failed?
+    else
+    {
+        // trace
+        tb_trace_i("conn[%p]: state: %s", aice->aico, tb_state_cstr(aice->state));
+
+        // finish it
+        tb_aico_clos(aice->aico, tb_demo_aico_clos, tb_null);
+        tb_demo_client_finish(client->context);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_pointer_t tb_demo_loop(tb_cpointer_t priv)
+{
+    // loop aicp
+    tb_aicp_ref_t aicp = (tb_aicp_ref_t)priv;
+    if (aicp) tb_aicp_loop(aicp);
+
+    // exit
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_asio_sharded_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init context
+    tb_demo_context_t context;
+    tb_memset(&context, 0, sizeof(tb_demo_context_t));
+
+    // done
+    tb_size_t       i = 0;
+    tb_hong_t       time = 0;
+    tb_thread_ref_t loop[TB_DEMO_LOOP_MAXN] = {tb_null};
+    do
+    {
+        /* init aicp with the sharded reactors
+         *
+         * @note the sharded aicp always uses the aiop proactor
+         */
+        context.aicp = tb_aicp_init_sharded((TB_DEMO_CLIENT_MAXN << 1) + 16, TB_DEMO_SHARD_MAXN);
+        tb_assert_and_check_break(context.aicp);
+
+        // init event
+        context.event = tb_event_init();
+        tb_assert_and_check_break(context.event);
+
+        // init addr
+        tb_ipaddr_t addr;
+        tb_ipaddr_set(&addr, "127.0.0.1", TB_DEMO_PORT, TB_IPADDR_FAMILY_IPV4);
+
+        // init server
+        context.server = tb_aico_init(context.aicp);
+        tb_assert_and_check_break(context.server);
+        if (!tb_aico_open_sock_from_type(context.server, TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4)) break;
+        if (!tb_socket_bind(tb_aico_sock(context.server), &addr)) break;
+        if (!tb_socket_listen(tb_aico_sock(context.server), TB_DEMO_CLIENT_MAXN)) break;
+        if (!tb_aico_acpt(context.server, tb_demo_server_acpt_func, &context)) break;
+
+        // init clients
+        for (i = 0; i < TB_DEMO_CLIENT_MAXN; i++)
+        {
+            // init client
+            tb_demo_client_t* client = &context.clients[i];
+            client->context = &context;
+            tb_memset(client->ping, 'a' + (tb_int_t)i, TB_DEMO_PING_SIZE);
+
+            // conn it
+            tb_aico_ref_t aico = tb_aico_init(context.aicp);
+            tb_assert_and_check_break(aico);
+            if (!tb_aico_open_sock_from_type(aico, TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4)) break;
+            if (!tb_aico_conn(aico, &addr, tb_demo_client_conn_func, client)) break;
+        }
+        tb_assert_and_check_break(i == TB_DEMO_CLIENT_MAXN);
+
+        // init loops
+        time = tb_mclock();
+        for (i = 0; i < TB_DEMO_LOOP_MAXN; i++)
+        {
+            loop[i] = tb_thread_init(tb_null, tb_demo_loop, context.aicp, 0);
+            tb_assert_and_check_break(loop[i]);
+        }
+        tb_assert_and_check_break(i == TB_DEMO_LOOP_MAXN);
+
+        // wait the pings
+        tb_event_wait(context.event, -1);
+        time = tb_mclock() - time;
+
+        // trace
+        tb_trace_i("shards: %d, loops: %d, clients: %d, pings: %ld, time: %lld ms"
+                , TB_DEMO_SHARD_MAXN
+                , TB_DEMO_LOOP_MAXN
+                , TB_DEMO_CLIENT_MAXN
+                , tb_atomic_get(&context.pings)
+                , time);
+
+    } while (0);
+
+    // exit aicp
+    if (context.aicp)
+    {
+        // kill all, some killing aicos are pinned to the shards without loop
+        time = tb_mclock();
+        tb_aicp_kill_all(context.aicp);
+
+        // wait all
+        tb_long_t wait = tb_aicp_wait_all(context.aicp, 5000);
+        time = tb_mclock() - time;
+
+        // trace
+        tb_trace_i("kill all: %s, time: %lld ms", wait > 0? "ok" : "timeout", time);
+
+        // kill aicp
+        tb_aicp_kill(context.aicp);
+    }
+
+    // exit loops
+    for (i = 0; i < TB_DEMO_LOOP_MAXN; i++)
+    {
+        if (loop[i])
+        {
+            tb_thread_wait(loop[i], -1);
+            tb_thread_exit(loop[i]);
+        }
+    }
+
+    // exit aicp
+    if (context.aicp) tb_aicp_exit(context.aicp);
+
+    // exit event
+    if (context.event) tb_event_exit(context.event);
+    return 0;
+}
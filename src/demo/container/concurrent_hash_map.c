@@ -0,0 +1,214 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the thread maximum count
+#define TB_DEMO_THREAD_MAXN         (64)
+
+// the item count
+#define TB_DEMO_ITEM_MAXN           (100000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the benchmark type
+typedef struct __tb_demo_benchmark_t
+{
+    // the mode: 0: spinlock + hash_map, 1: concurrent hash map
+    tb_size_t                       mode;
+
+    // the operation count for each thread
+    tb_size_t                       count;
+
+    // the write ratio, per 1000 operations
+    tb_size_t                       writes;
+
+    // the found count
+    tb_atomic_t                     found;
+
+    // the lock for the hash map
+    tb_spinlock_t                   lock;
+
+    // the hash map
+    tb_hash_map_ref_t               hash_map;
+
+    // the concurrent hash map
+    tb_concurrent_hash_map_ref_t    concurrent_hash_map;
+
+}tb_demo_benchmark_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_find_func(tb_pointer_t name, tb_pointer_t data, tb_cpointer_t priv)
+{
+    // copy data
+    tb_strlcpy((tb_char_t*)priv, (tb_char_t const*)data, 32);
+}
+static tb_bool_t tb_demo_pred_func(tb_pointer_t name, tb_pointer_t data, tb_cpointer_t priv)
+{
+    // remove the odd items
+    return ((tb_size_t)name & 0x1)? tb_true : tb_false;
+}
+static tb_void_t tb_concurrent_hash_map_test()
+{
+    // init hash map
+    tb_concurrent_hash_map_ref_t hash_map = tb_concurrent_hash_map_init(0, 0, tb_element_size(), tb_element_str(tb_true));
+    tb_assert_and_check_return(hash_map);
+
+    // insert items
+    tb_size_t i = 0;
+    tb_bool_t ok = tb_true;
+    tb_char_t data[32];
+    for (i = 0; i < 1000; i++)
+    {
+        tb_snprintf(data, sizeof(data), "%lu", i);
+        tb_concurrent_hash_map_insert(hash_map, (tb_pointer_t)i, data);
+    }
+    if (tb_concurrent_hash_map_size(hash_map) != 1000) ok = tb_false;
+
+    // find items
+    for (i = 0; i < 1000 && ok; i++)
+    {
+        tb_char_t copy[32] = {0};
+        tb_snprintf(data, sizeof(data), "%lu", i);
+        if (!tb_concurrent_hash_map_find(hash_map, (tb_pointer_t)i, tb_demo_find_func, copy) || tb_strcmp(copy, data)) ok = tb_false;
+    }
+    if (tb_concurrent_hash_map_find(hash_map, (tb_pointer_t)1000, tb_null, tb_null)) ok = tb_false;
+
+    // remove items
+    tb_bool_t removed0 = tb_concurrent_hash_map_remove(hash_map, (tb_pointer_t)0);
+    tb_bool_t removed1 = tb_concurrent_hash_map_remove(hash_map, (tb_pointer_t)0);
+    tb_size_t removed  = tb_concurrent_hash_map_remove_if(hash_map, tb_demo_pred_func, tb_null);
+    if (!removed0 || removed1 || removed != 500 || tb_concurrent_hash_map_size(hash_map) != 499) ok = tb_false;
+
+    // clear items
+    tb_concurrent_hash_map_clear(hash_map);
+    if (tb_concurrent_hash_map_size(hash_map)) ok = tb_false;
+
+    // trace
+    if (ok) tb_trace_i("test: ok");
+    else tb_trace_e("test: failed");
+    tb_assert(ok);
+
+    // exit hash map
+    tb_concurrent_hash_map_exit(hash_map);
+}
+static tb_pointer_t tb_demo_benchmark_worker(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_benchmark_t* benchmark = (tb_demo_benchmark_t*)priv;
+    tb_assert_and_check_return_val(benchmark, tb_null);
+
+    // done
+    tb_size_t i = 0;
+    tb_size_t found = 0;
+    tb_size_t count = benchmark->count;
+    for (i = 0; i < count; i++)
+    {
+        // the key and operation
+        tb_size_t key = tb_random_range(0, TB_DEMO_ITEM_MAXN);
+        tb_bool_t write = tb_random_range(0, 1000) < benchmark->writes;
+        switch (benchmark->mode)
+        {
+        case 0:
+            {
+                tb_spinlock_enter(&benchmark->lock);
+                if (write) tb_hash_map_insert(benchmark->hash_map, (tb_pointer_t)key, (tb_pointer_t)key);
+                else if (tb_hash_map_get(benchmark->hash_map, (tb_pointer_t)key)) found++;
+                tb_spinlock_leave(&benchmark->lock);
+            }
+            break;
+        case 1:
+            {
+                if (write) tb_concurrent_hash_map_insert(benchmark->concurrent_hash_map, (tb_pointer_t)key, (tb_pointer_t)key);
+                else if (tb_concurrent_hash_map_get(benchmark->concurrent_hash_map, (tb_pointer_t)key)) found++;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    tb_atomic_fetch_and_add(&benchmark->found, (tb_long_t)found);
+
+    // exit thread
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+static tb_void_t tb_demo_benchmark_test(tb_size_t mode, tb_size_t threads, tb_size_t count, tb_size_t writes)
+{
+    // init benchmark
+    tb_demo_benchmark_t benchmark;
+    tb_memset(&benchmark, 0, sizeof(tb_demo_benchmark_t));
+    benchmark.mode                  = mode;
+    benchmark.count                 = count;
+    benchmark.writes                = writes;
+    benchmark.hash_map              = tb_hash_map_init(0, tb_element_size(), tb_element_size());
+    benchmark.concurrent_hash_map   = tb_concurrent_hash_map_init(0, TB_DEMO_ITEM_MAXN, tb_element_size(), tb_element_size());
+    tb_spinlock_init(&benchmark.lock);
+    tb_assert_and_check_return(benchmark.hash_map && benchmark.concurrent_hash_map);
+
+    // fill the even items
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEMO_ITEM_MAXN; i += 2)
+    {
+        tb_hash_map_insert(benchmark.hash_map, (tb_pointer_t)i, (tb_pointer_t)i);
+        tb_concurrent_hash_map_insert(benchmark.concurrent_hash_map, (tb_pointer_t)i, (tb_pointer_t)i);
+    }
+
+    // init workers
+    tb_thread_ref_t workers[TB_DEMO_THREAD_MAXN] = {0};
+    tb_hong_t       time = tb_mclock();
+    for (i = 0; i < threads; i++) workers[i] = tb_thread_init(tb_null, tb_demo_benchmark_worker, &benchmark, 0);
+
+    // wait them
+    for (i = 0; i < threads; i++)
+    {
+        if (workers[i])
+        {
+            tb_thread_wait(workers[i], -1);
+            tb_thread_exit(workers[i]);
+        }
+    }
+    time = tb_mclock() - time;
+
+    // trace
+    static tb_char_t const* s_modes[] = {"spinlock + hash_map", "concurrent_hash_map"};
+    tb_trace_i("%s: threads: %lu, writes: %lu/1000, found: %ld, time: %lld ms, %lld ops/ms", s_modes[mode], threads, writes, tb_atomic_get(&benchmark.found), time, (tb_hong_t)(threads * count) / tb_max(time, 1));
+
+    // exit benchmark
+    tb_spinlock_exit(&benchmark.lock);
+    tb_hash_map_exit(benchmark.hash_map);
+    tb_concurrent_hash_map_exit(benchmark.concurrent_hash_map);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_concurrent_hash_map_main(tb_int_t argc, tb_char_t** argv)
+{
+    // test it
+    tb_concurrent_hash_map_test();
+
+    // the thread maximum count and the operation count for each thread
+    tb_size_t maxn = argv[1]? tb_atoi(argv[1]) : tb_processor_count();
+    tb_size_t count = (argv[1] && argv[2])? tb_atoi(argv[2]) : 1000000;
+    maxn = tb_min(tb_max(maxn, 1), TB_DEMO_THREAD_MAXN);
+
+    // done
+    tb_size_t threads = 1;
+    for (threads = 1; threads <= maxn; threads <<= 1)
+    {
+        tb_demo_benchmark_test(0, threads, count, 0);
+        tb_demo_benchmark_test(1, threads, count, 0);
+        tb_demo_benchmark_test(0, threads, count, 10);
+        tb_demo_benchmark_test(1, threads, count, 10);
+    }
+    return 0;
+}
@@ -0,0 +1,241 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+#ifdef __tb_debug__
+#   define tb_flat_hash_map_test_dump(h)            tb_flat_hash_map_dump(h)
+#else
+#   define tb_flat_hash_map_test_dump(h)
+#endif
+
+#define tb_flat_hash_map_test_get_s2i(h, s)         do {tb_assert(tb_strlen((tb_char_t*)s) == (tb_size_t)tb_flat_hash_map_get(h, (tb_char_t*)(s))); } while (0);
+#define tb_flat_hash_map_test_insert_s2i(h, s)      do {tb_size_t n = tb_strlen((tb_char_t*)(s)); tb_flat_hash_map_insert(h, (tb_char_t*)(s), (tb_pointer_t)n); } while (0);
+#define tb_flat_hash_map_test_remove_s2i(h, s)      do {tb_flat_hash_map_remove(h, s); tb_assert(!tb_flat_hash_map_find(h, s)); } while (0);
+
+#define tb_flat_hash_map_test_get_i2i(h, i)         do {tb_assert(i == (tb_size_t)tb_flat_hash_map_get(h, (tb_pointer_t)i)); } while (0);
+#define tb_flat_hash_map_test_insert_i2i(h, i)      do {tb_flat_hash_map_insert(h, (tb_pointer_t)i, (tb_pointer_t)i); } while (0);
+#define tb_flat_hash_map_test_remove_i2i(h, i)      do {tb_flat_hash_map_remove(h, (tb_pointer_t)i); tb_assert(!tb_flat_hash_map_find(h, (tb_pointer_t)i)); } while (0);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_void_t tb_flat_hash_map_test_s2i_func()
+{
+    // init hash
+    tb_flat_hash_map_ref_t hash = tb_flat_hash_map_init(8, tb_element_str(tb_true), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // set
+    tb_flat_hash_map_test_insert_s2i(hash, "0");
+    tb_flat_hash_map_test_insert_s2i(hash, "01");
+    tb_flat_hash_map_test_insert_s2i(hash, "012");
+    tb_flat_hash_map_test_insert_s2i(hash, "0123");
+    tb_flat_hash_map_test_insert_s2i(hash, "01234");
+    tb_flat_hash_map_test_insert_s2i(hash, "012345");
+    tb_flat_hash_map_test_insert_s2i(hash, "0123456");
+    tb_flat_hash_map_test_insert_s2i(hash, "01234567");
+    tb_flat_hash_map_test_insert_s2i(hash, "012345678");
+    tb_flat_hash_map_test_insert_s2i(hash, "0123456789");
+    tb_flat_hash_map_test_insert_s2i(hash, "9876543210");
+    tb_flat_hash_map_test_insert_s2i(hash, "876543210");
+    tb_flat_hash_map_test_insert_s2i(hash, "76543210");
+    tb_flat_hash_map_test_insert_s2i(hash, "6543210");
+    tb_flat_hash_map_test_insert_s2i(hash, "543210");
+    tb_flat_hash_map_test_insert_s2i(hash, "43210");
+    tb_flat_hash_map_test_insert_s2i(hash, "3210");
+    tb_flat_hash_map_test_insert_s2i(hash, "210");
+    tb_flat_hash_map_test_insert_s2i(hash, "10");
+    tb_flat_hash_map_test_insert_s2i(hash, "0");
+    tb_assert(tb_flat_hash_map_size(hash) == 19);
+    tb_flat_hash_map_test_dump(hash);
+
+    // get
+    tb_flat_hash_map_test_get_s2i(hash, "01");
+    tb_flat_hash_map_test_get_s2i(hash, "0123456789");
+    tb_flat_hash_map_test_get_s2i(hash, "9876543210");
+    tb_flat_hash_map_test_get_s2i(hash, "10");
+    tb_flat_hash_map_test_get_s2i(hash, "0");
+
+    // del
+    tb_flat_hash_map_test_remove_s2i(hash, "01");
+    tb_flat_hash_map_test_remove_s2i(hash, "012");
+    tb_flat_hash_map_test_remove_s2i(hash, "0123456789");
+    tb_flat_hash_map_test_remove_s2i(hash, "0123456789");
+    tb_assert(tb_flat_hash_map_size(hash) == 16);
+    tb_flat_hash_map_test_get_s2i(hash, "9876543210");
+    tb_flat_hash_map_test_dump(hash);
+
+    // walk
+    tb_size_t count = 0;
+    tb_size_t wrong = 0;
+    tb_for_all (tb_flat_hash_map_item_ref_t, item, hash)
+    {
+        if (tb_strlen((tb_char_t const*)item->name) != (tb_size_t)item->data) wrong++;
+        count++;
+    }
+    tb_assert(!wrong && count == tb_flat_hash_map_size(hash));
+    tb_trace_i("s2i: walk: %lu, wrong: %lu", count, wrong);
+
+    // clear
+    tb_flat_hash_map_clear(hash);
+    tb_assert(!tb_flat_hash_map_size(hash) && tb_iterator_head(hash) == tb_iterator_tail(hash));
+    tb_flat_hash_map_test_dump(hash);
+
+    tb_flat_hash_map_exit(hash);
+}
+static tb_void_t tb_flat_hash_map_test_i2i_func()
+{
+    // init hash
+    tb_flat_hash_map_ref_t hash = tb_flat_hash_map_init(0, tb_element_long(), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // insert and grow it
+    tb_size_t i = 0;
+    tb_size_t n = 100000;
+    for (i = 0; i < n; i++) tb_flat_hash_map_test_insert_i2i(hash, i);
+    for (i = 0; i < n; i++) tb_flat_hash_map_test_get_i2i(hash, i);
+    tb_assert(tb_flat_hash_map_size(hash) == n);
+
+    // remove the odd items
+    for (i = 1; i < n; i += 2) tb_flat_hash_map_test_remove_i2i(hash, i);
+    for (i = 0; i < n; i += 2) tb_flat_hash_map_test_get_i2i(hash, i);
+    tb_assert(tb_flat_hash_map_size(hash) == (n >> 1));
+
+    // reuse the deleted slots
+    tb_size_t maxn = tb_flat_hash_map_maxn(hash);
+    for (i = 0; i < 10; i++)
+    {
+        tb_size_t j = 0;
+        for (j = 1; j < n; j += 2) tb_flat_hash_map_test_insert_i2i(hash, j + n * (i + 1));
+        for (j = 1; j < n; j += 2) tb_flat_hash_map_test_remove_i2i(hash, j + n * (i + 1));
+    }
+    for (i = 0; i < n; i += 2) tb_flat_hash_map_test_get_i2i(hash, i);
+    tb_assert(tb_flat_hash_map_size(hash) == (n >> 1) && tb_flat_hash_map_maxn(hash) == maxn);
+
+    // trace
+    tb_trace_i("i2i: size: %lu, maxn: %lu => %lu", tb_flat_hash_map_size(hash), maxn, tb_flat_hash_map_maxn(hash));
+
+    tb_flat_hash_map_exit(hash);
+}
+static tb_bool_t tb_flat_hash_map_test_walk_item(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+{
+    // check
+    tb_assert(item && value);
+
+    // remove the odd items
+    tb_size_t* count = (tb_size_t*)value;
+    if ((tb_size_t)((tb_flat_hash_map_item_ref_t)item)->data & 0x1) return tb_true;
+
+    // count the even items
+    (*count)++;
+    return tb_false;
+}
+static tb_void_t tb_flat_hash_map_test_walk_func()
+{
+    // init hash
+    tb_flat_hash_map_ref_t hash = tb_flat_hash_map_init(0, tb_element_long(), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // add items
+    tb_size_t i = 0;
+    tb_size_t n = 10000;
+    for (i = 0; i < n; i++) tb_flat_hash_map_test_insert_i2i(hash, i);
+
+    // remove the odd items
+    tb_size_t count = 0;
+    tb_remove_if(hash, tb_flat_hash_map_test_walk_item, &count);
+    tb_assert(count == (n >> 1) && tb_flat_hash_map_size(hash) == (n >> 1));
+    for (i = 0; i < n; i += 2) tb_flat_hash_map_test_get_i2i(hash, i);
+
+    tb_flat_hash_map_exit(hash);
+}
+static tb_void_t tb_flat_hash_map_test_i2i_perf()
+{
+    // init hash
+    tb_hash_map_ref_t       hash = tb_hash_map_init(0, tb_element_long(), tb_element_long());
+    tb_flat_hash_map_ref_t  flat = tb_flat_hash_map_init(0, tb_element_long(), tb_element_long());
+    tb_assert_and_check_return(hash && flat);
+
+    // make keys
+    tb_size_t   i = 0;
+    tb_size_t   n = 1000000;
+    tb_size_t*  keys = tb_nalloc_type(n, tb_size_t);
+    tb_assert_and_check_return(keys);
+    for (i = 0; i < n; i++) keys[i] = tb_random_range(0, TB_MAXU32);
+
+    // hash map
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++) tb_hash_map_insert(hash, (tb_pointer_t)keys[i], (tb_pointer_t)keys[i]);
+    for (i = 0; i < n; i++) tb_assert(keys[i] == (tb_size_t)tb_hash_map_get(hash, (tb_pointer_t)keys[i]));
+    t = tb_mclock() - t;
+    tb_trace_i("i2i: hash_map: size: %lu, time: %lld ms", tb_hash_map_size(hash), t);
+
+    // flat hash map
+    t = tb_mclock();
+    for (i = 0; i < n; i++) tb_flat_hash_map_insert(flat, (tb_pointer_t)keys[i], (tb_pointer_t)keys[i]);
+    for (i = 0; i < n; i++) tb_assert(keys[i] == (tb_size_t)tb_flat_hash_map_get(flat, (tb_pointer_t)keys[i]));
+    t = tb_mclock() - t;
+    tb_trace_i("i2i: flat_hash_map: size: %lu, time: %lld ms", tb_flat_hash_map_size(flat), t);
+
+    // exit
+    tb_free(keys);
+    tb_hash_map_exit(hash);
+    tb_flat_hash_map_exit(flat);
+}
+static tb_void_t tb_flat_hash_map_test_s2i_perf()
+{
+    // init hash
+    tb_hash_map_ref_t       hash = tb_hash_map_init(0, tb_element_str(tb_true), tb_element_long());
+    tb_flat_hash_map_ref_t  flat = tb_flat_hash_map_init(0, tb_element_str(tb_true), tb_element_long());
+    tb_assert_and_check_return(hash && flat);
+
+    // make keys
+    tb_size_t   i = 0;
+    tb_size_t   n = 200000;
+    tb_char_t*  keys = (tb_char_t*)tb_nalloc0(n, 16);
+    tb_assert_and_check_return(keys);
+    for (i = 0; i < n; i++) tb_snprintf(keys + (i << 4), 16, "%x", tb_random_range(0, TB_MAXU32));
+
+    // hash map
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++) tb_hash_map_insert(hash, keys + (i << 4), (tb_pointer_t)i);
+    for (i = 0; i < n; i++) tb_hash_map_get(hash, keys + (i << 4));
+    t = tb_mclock() - t;
+    tb_trace_i("s2i: hash_map: size: %lu, time: %lld ms", tb_hash_map_size(hash), t);
+
+    // flat hash map
+    t = tb_mclock();
+    for (i = 0; i < n; i++) tb_flat_hash_map_insert(flat, keys + (i << 4), (tb_pointer_t)i);
+    for (i = 0; i < n; i++) tb_flat_hash_map_get(flat, keys + (i << 4));
+    t = tb_mclock() - t;
+    tb_trace_i("s2i: flat_hash_map: size: %lu, time: %lld ms", tb_flat_hash_map_size(flat), t);
+
+    // exit
+    tb_free(keys);
+    tb_hash_map_exit(hash);
+    tb_flat_hash_map_exit(flat);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_flat_hash_map_main(tb_int_t argc, tb_char_t** argv)
+{
+#if 1
+    tb_flat_hash_map_test_s2i_func();
+    tb_flat_hash_map_test_i2i_func();
+    tb_flat_hash_map_test_walk_func();
+#endif
+
+#if 1
+    tb_flat_hash_map_test_i2i_perf();
+    tb_flat_hash_map_test_s2i_perf();
+#endif
+
+    return 0;
+}
@@ -580,6 +580,88 @@ static tb_void_t tb_hash_map_test_walk_perf()
     // exit 
     tb_hash_map_exit(hash);
 }
+static tb_void_t tb_hash_map_test_latency_dump(tb_char_t const* name, tb_size_t* times, tb_size_t count)
+{
+    // sort times
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_size(&array_iterator, times, count);
+    tb_sort_all(iterator, tb_null);
+
+    // trace percentiles
+    tb_trace_i("%s: p50: %lu us, p99: %lu us, p99.9: %lu us, p99.99: %lu us, max: %lu us", name
+            ,   times[count * 50 / 100]
+            ,   times[count * 99 / 100]
+            ,   times[count * 999 / 1000]
+            ,   times[count * 9999 / 10000]
+            ,   times[count - 1]);
+}
+static tb_void_t tb_hash_map_test_latency_perf(tb_size_t bucket_size, tb_size_t count)
+{
+    // init hash, grow the buckets from the default size if no bucket size
+    tb_hash_map_ref_t hash = bucket_size? tb_hash_map_init(bucket_size, tb_element_long(), tb_element_long()) : tb_hash_map_init_grow(0, tb_element_long(), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // done
+    tb_size_t* keys = tb_null;
+    tb_size_t* times = tb_null;
+    do
+    {
+        // init keys and times
+        keys = tb_nalloc_type(count, tb_size_t);
+        times = tb_nalloc_type(count, tb_size_t);
+        tb_assert_and_check_break(keys && times);
+
+        // make keys
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++) keys[i] = tb_random_range(0, TB_MAXU32);
+
+        // trace
+        tb_trace_i("latency: bucket: %lu, count: %lu", bucket_size, count);
+
+        // insert items
+        tb_hong_t t = 0;
+        tb_hong_t total = tb_mclock();
+        for (i = 0; i < count; i++)
+        {
+            t = tb_uclock();
+            tb_hash_map_insert(hash, (tb_pointer_t)keys[i], (tb_pointer_t)keys[i]);
+            times[i] = (tb_size_t)(tb_uclock() - t);
+        }
+        total = tb_mclock() - total;
+        tb_trace_i("insert: time: %lld ms", total);
+        tb_hash_map_test_latency_dump("insert", times, count);
+
+        // get items
+        total = tb_mclock();
+        for (i = 0; i < count; i++)
+        {
+            t = tb_uclock();
+            tb_hash_map_get(hash, (tb_pointer_t)keys[i]);
+            times[i] = (tb_size_t)(tb_uclock() - t);
+        }
+        total = tb_mclock() - total;
+        tb_trace_i("get: time: %lld ms", total);
+        tb_hash_map_test_latency_dump("get", times, count);
+
+        // remove items
+        total = tb_mclock();
+        for (i = 0; i < count; i++)
+        {
+            t = tb_uclock();
+            tb_hash_map_remove(hash, (tb_pointer_t)keys[i]);
+            times[i] = (tb_size_t)(tb_uclock() - t);
+        }
+        total = tb_mclock() - total;
+        tb_trace_i("remove: time: %lld ms, left: %lu", total, tb_hash_map_size(hash));
+        tb_hash_map_test_latency_dump("remove", times, count);
+
+    } while (0);
+
+    // exit
+    if (keys) tb_free(keys);
+    if (times) tb_free(times);
+    tb_hash_map_exit(hash);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
@@ -606,5 +688,12 @@ tb_int_t tb_demo_container_hash_map_main(tb_int_t argc, tb_char_t** argv)
     tb_hash_map_test_walk_perf();
 #endif
 
+#if 1
+    // the latency percentiles of the growing buckets and the large fixed buckets 
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 1000000;
+    tb_hash_map_test_latency_perf(0, count);
+    tb_hash_map_test_latency_perf(TB_HASH_MAP_BUCKET_SIZE_LARGE, count);
+#endif
+
     return 0;
 }
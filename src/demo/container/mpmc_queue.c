@@ -0,0 +1,287 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the thread maximum count
+#define TB_DEMO_THREAD_MAXN         (64)
+
+// the queue maxn
+#define TB_DEMO_QUEUE_MAXN          (4096)
+
+// the batch count
+#define TB_DEMO_BATCH_MAXN          (32)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the benchmark type
+typedef struct __tb_demo_benchmark_t
+{
+    // the mode: 0: spinlock + queue, 1: mpmc queue, 2: mpmc queue with batch
+    tb_size_t               mode;
+
+    // the item count for each producer
+    tb_size_t               count;
+
+    // the consumed item count
+    tb_atomic_t             consumed;
+
+    // the consumed item sum
+    tb_atomic_t             sum;
+
+    // the total item count
+    tb_size_t               total;
+
+    // the lock for the queue
+    tb_spinlock_t           lock;
+
+    // the queue
+    tb_queue_ref_t          queue;
+
+    // the mpmc queue
+    tb_mpmc_queue_ref_t     mpmc_queue;
+
+}tb_demo_benchmark_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_mpmc_queue_test()
+{
+    // init queue
+    tb_mpmc_queue_ref_t queue = tb_mpmc_queue_init(10);
+    tb_assert_and_check_return(queue);
+
+    // the maxn will be aligned by pow2
+    tb_bool_t ok = tb_mpmc_queue_maxn(queue) == 16;
+
+    // push and pop
+    tb_size_t i = 0;
+    tb_pointer_t data = tb_null;
+    for (i = 0; i < 16; i++) tb_mpmc_queue_push(queue, (tb_cpointer_t)(i + 1));
+    tb_bool_t pushed = tb_mpmc_queue_push(queue, (tb_cpointer_t)17);
+    if (!tb_mpmc_queue_full(queue) || pushed) ok = tb_false;
+    for (i = 0; i < 16; i++)
+    {
+        tb_bool_t popped = tb_mpmc_queue_pop(queue, &data);
+        if (!popped || data != (tb_pointer_t)(i + 1)) ok = tb_false;
+    }
+    tb_bool_t popped = tb_mpmc_queue_pop(queue, &data);
+    if (!tb_mpmc_queue_null(queue) || popped) ok = tb_false;
+
+    // push and pop list
+    tb_cpointer_t   ilist[TB_DEMO_BATCH_MAXN];
+    tb_pointer_t    olist[TB_DEMO_BATCH_MAXN];
+    for (i = 0; i < TB_DEMO_BATCH_MAXN; i++) ilist[i] = (tb_cpointer_t)(i + 1);
+    tb_size_t size0 = tb_mpmc_queue_push_list(queue, ilist, 10);
+    tb_size_t size1 = tb_mpmc_queue_push_list(queue, ilist + 10, TB_DEMO_BATCH_MAXN - 10);
+    if (size0 != 10 || size1 != 6) ok = tb_false;
+    size0 = tb_mpmc_queue_pop_list(queue, olist, 4);
+    if (size0 != 4 || olist[3] != (tb_pointer_t)4) ok = tb_false;
+    size1 = tb_mpmc_queue_pop_list(queue, olist, TB_DEMO_BATCH_MAXN);
+    if (size1 != 12 || olist[11] != (tb_pointer_t)16) ok = tb_false;
+    if (!tb_mpmc_queue_null(queue)) ok = tb_false;
+
+    // trace
+    if (ok) tb_trace_i("test: ok");
+    else tb_trace_e("test: failed");
+    tb_assert(ok);
+
+    // exit queue
+    tb_mpmc_queue_exit(queue);
+}
+static tb_pointer_t tb_demo_benchmark_producer(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_benchmark_t* benchmark = (tb_demo_benchmark_t*)priv;
+    tb_assert_and_check_return_val(benchmark, tb_null);
+
+    // done
+    tb_size_t       i = 0;
+    tb_size_t       n = 0;
+    tb_size_t       count = benchmark->count;
+    tb_cpointer_t   list[TB_DEMO_BATCH_MAXN];
+    while (i < count)
+    {
+        switch (benchmark->mode)
+        {
+        case 0:
+            {
+                // push it
+                tb_spinlock_enter(&benchmark->lock);
+                if (tb_queue_size(benchmark->queue) < TB_DEMO_QUEUE_MAXN)
+                {
+                    tb_queue_put(benchmark->queue, (tb_cpointer_t)(i + 1));
+                    i++;
+                }
+                tb_spinlock_leave(&benchmark->lock);
+            }
+            break;
+        case 1:
+            {
+                // push it
+                if (tb_mpmc_queue_push(benchmark->mpmc_queue, (tb_cpointer_t)(i + 1))) i++;
+            }
+            break;
+        case 2:
+            {
+                // push them
+                n = tb_min(count - i, TB_DEMO_BATCH_MAXN);
+                tb_size_t j = 0;
+                for (j = 0; j < n; j++) list[j] = (tb_cpointer_t)(i + j + 1);
+                i += tb_mpmc_queue_push_list(benchmark->mpmc_queue, list, n);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    // exit thread
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+static tb_pointer_t tb_demo_benchmark_consumer(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_benchmark_t* benchmark = (tb_demo_benchmark_t*)priv;
+    tb_assert_and_check_return_val(benchmark, tb_null);
+
+    // done
+    tb_size_t       j = 0;
+    tb_size_t       n = 0;
+    tb_size_t       sum = 0;
+    tb_pointer_t    data = tb_null;
+    tb_pointer_t    list[TB_DEMO_BATCH_MAXN];
+    while ((tb_size_t)tb_atomic_get(&benchmark->consumed) < benchmark->total)
+    {
+        // pop items
+        n = 0;
+        switch (benchmark->mode)
+        {
+        case 0:
+            {
+                // pop it
+                tb_spinlock_enter(&benchmark->lock);
+                if (!tb_queue_null(benchmark->queue))
+                {
+                    list[n++] = tb_queue_get(benchmark->queue);
+                    tb_queue_pop(benchmark->queue);
+                }
+                tb_spinlock_leave(&benchmark->lock);
+            }
+            break;
+        case 1:
+            {
+                // pop it
+                if (tb_mpmc_queue_pop(benchmark->mpmc_queue, &data)) list[n++] = data;
+            }
+            break;
+        case 2:
+            {
+                // pop them
+                n = tb_mpmc_queue_pop_list(benchmark->mpmc_queue, list, TB_DEMO_BATCH_MAXN);
+            }
+            break;
+        default:
+            break;
+        }
+
+        // consume them
+        if (n)
+        {
+            for (j = 0, sum = 0; j < n; j++) sum += (tb_size_t)list[j];
+            tb_atomic_fetch_and_add(&benchmark->sum, (tb_long_t)sum);
+            tb_atomic_fetch_and_add(&benchmark->consumed, (tb_long_t)n);
+        }
+    }
+
+    // exit thread
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+static tb_void_t tb_demo_benchmark_test(tb_size_t mode, tb_size_t threads, tb_size_t count)
+{
+    // init benchmark
+    tb_demo_benchmark_t benchmark;
+    tb_memset(&benchmark, 0, sizeof(tb_demo_benchmark_t));
+    benchmark.mode          = mode;
+    benchmark.count         = count;
+    benchmark.total         = threads * count;
+    benchmark.queue         = tb_queue_init(0, tb_element_ptr(tb_null, tb_null));
+    benchmark.mpmc_queue    = tb_mpmc_queue_init(TB_DEMO_QUEUE_MAXN);
+    tb_spinlock_init(&benchmark.lock);
+    tb_assert_and_check_return(benchmark.queue && benchmark.mpmc_queue);
+
+    // init producers and consumers
+    tb_size_t       i = 0;
+    tb_thread_ref_t producers[TB_DEMO_THREAD_MAXN] = {0};
+    tb_thread_ref_t consumers[TB_DEMO_THREAD_MAXN] = {0};
+    tb_hong_t       time = tb_mclock();
+    for (i = 0; i < threads; i++)
+    {
+        producers[i] = tb_thread_init(tb_null, tb_demo_benchmark_producer, &benchmark, 0);
+        consumers[i] = tb_thread_init(tb_null, tb_demo_benchmark_consumer, &benchmark, 0);
+    }
+
+    // wait them
+    for (i = 0; i < threads; i++)
+    {
+        if (producers[i])
+        {
+            tb_thread_wait(producers[i], -1);
+            tb_thread_exit(producers[i]);
+        }
+        if (consumers[i])
+        {
+            tb_thread_wait(consumers[i], -1);
+            tb_thread_exit(consumers[i]);
+        }
+    }
+    time = tb_mclock() - time;
+
+    // check sum
+    tb_size_t sum = threads * ((count * (count + 1)) >> 1);
+    tb_size_t real = (tb_size_t)tb_atomic_get(&benchmark.sum);
+    if (real != sum) tb_trace_e("sum: %lu != %lu", real, sum);
+    tb_assert(real == sum);
+
+    // trace
+    static tb_char_t const* s_modes[] = {"spinlock + queue  ", "mpmc_queue        ", "mpmc_queue(batch) "};
+    tb_trace_i("%s: producers/consumers: %lu, items: %lu, time: %lld ms, %lld items/ms", s_modes[mode], threads, benchmark.total, time, (tb_hong_t)benchmark.total / tb_max(time, 1));
+
+    // exit benchmark
+    tb_spinlock_exit(&benchmark.lock);
+    tb_queue_exit(benchmark.queue);
+    tb_mpmc_queue_exit(benchmark.mpmc_queue);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_mpmc_queue_main(tb_int_t argc, tb_char_t** argv)
+{
+    // test it
+    tb_mpmc_queue_test();
+
+    // the producer/consumer maximum count and the item count for each producer
+    tb_size_t maxn = argv[1]? tb_atoi(argv[1]) : tb_processor_count();
+    tb_size_t count = (argv[1] && argv[2])? tb_atoi(argv[2]) : 1000000;
+    maxn = tb_min(tb_max(maxn, 1), TB_DEMO_THREAD_MAXN);
+
+    // done
+    tb_size_t threads = 1;
+    for (threads = 1; threads <= maxn; threads <<= 1)
+    {
+        tb_demo_benchmark_test(0, threads, count);
+        tb_demo_benchmark_test(1, threads, count);
+        tb_demo_benchmark_test(2, threads, count);
+    }
+    return 0;
+}
@@ -0,0 +1,374 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_unrolled_list_insert_head_test()
+{
+    // init
+    tb_unrolled_list_ref_t list = tb_unrolled_list_init(0, tb_element_long());
+    tb_assert_and_check_return(list);
+
+    // done
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000000;
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++) tb_unrolled_list_insert_head(list, (tb_pointer_t)0xd);
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("tb_unrolled_list_insert_head(%d): %lld ms, size: %d, maxn: %d", n, t, tb_unrolled_list_size(list), tb_unrolled_list_maxn(list));
+
+    // check
+    tb_assert(tb_unrolled_list_size(list) == n);
+    tb_assert(tb_unrolled_list_head(list) == (tb_pointer_t)0xd);
+    tb_assert(tb_unrolled_list_last(list) == (tb_pointer_t)0xd);
+
+    // exit
+    tb_unrolled_list_exit(list);
+}
+static tb_void_t tb_unrolled_list_insert_tail_test()
+{
+    // init
+    tb_unrolled_list_ref_t list = tb_unrolled_list_init(0, tb_element_long());
+    tb_assert_and_check_return(list);
+
+    // done
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000000;
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++) tb_unrolled_list_insert_tail(list, (tb_pointer_t)0xd);
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("tb_unrolled_list_insert_tail(%d): %lld ms, size: %d, maxn: %d", n, t, tb_unrolled_list_size(list), tb_unrolled_list_maxn(list));
+
+    // check
+    tb_assert(tb_unrolled_list_size(list) == n);
+    tb_assert(tb_unrolled_list_head(list) == (tb_pointer_t)0xd);
+    tb_assert(tb_unrolled_list_last(list) == (tb_pointer_t)0xd);
+
+    // exit
+    tb_unrolled_list_exit(list);
+}
+static tb_void_t tb_unrolled_list_remove_head_test()
+{
+    // init
+    tb_unrolled_list_ref_t list = tb_unrolled_list_init(0, tb_element_long());
+    tb_assert_and_check_return(list);
+
+    // make list
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000000;
+    for (i = 0; i < n; i++) tb_unrolled_list_insert_tail(list, (tb_pointer_t)0xd);
+
+    // done
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++) tb_unrolled_list_remove_head(list);
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("tb_unrolled_list_remove_head(%d): %lld ms, size: %d, maxn: %d", n, t, tb_unrolled_list_size(list), tb_unrolled_list_maxn(list));
+
+    // check
+    tb_assert(!tb_unrolled_list_size(list));
+
+    // exit
+    tb_unrolled_list_exit(list);
+}
+static tb_void_t tb_unrolled_list_remove_last_test()
+{
+    // init
+    tb_unrolled_list_ref_t list = tb_unrolled_list_init(0, tb_element_long());
+    tb_assert_and_check_return(list);
+
+    // make list
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000000;
+    for (i = 0; i < n; i++) tb_unrolled_list_insert_tail(list, (tb_pointer_t)0xd);
+
+    // done
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++) tb_unrolled_list_remove_last(list);
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("tb_unrolled_list_remove_last(%d): %lld ms, size: %d, maxn: %d", n, t, tb_unrolled_list_size(list), tb_unrolled_list_maxn(list));
+
+    // check
+    tb_assert(!tb_unrolled_list_size(list));
+
+    // exit
+    tb_unrolled_list_exit(list);
+}
+static tb_void_t tb_unrolled_list_iterator_next_test()
+{
+    // init
+    tb_unrolled_list_ref_t list = tb_unrolled_list_init(0, tb_element_size());
+    tb_assert_and_check_return(list);
+
+    // make list
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000000;
+    for (i = 0; i < n; i++) tb_unrolled_list_insert_head(list, (tb_pointer_t)0xd);
+
+    // done
+    tb_hong_t t = tb_mclock();
+    tb_for_all(tb_size_t, item, list) tb_used(item);
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("tb_unrolled_list_iterator_next(%d): %lld ms, size: %d, maxn: %d", n, t, tb_unrolled_list_size(list), tb_unrolled_list_maxn(list));
+
+    // exit
+    tb_unrolled_list_exit(list);
+}
+static tb_void_t tb_unrolled_list_iterator_prev_test()
+{
+    // init
+    tb_unrolled_list_ref_t list = tb_unrolled_list_init(0, tb_element_size());
+    tb_assert_and_check_return(list);
+
+    // make list
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000000;
+    for (i = 0; i < n; i++) tb_unrolled_list_insert_head(list, (tb_pointer_t)0xd);
+
+    // done
+    tb_hong_t t = tb_mclock();
+    tb_rfor_all(tb_size_t, item, list) tb_used(item);
+    t = tb_mclock() - t;
+
+    // trace
+    tb_trace_i("tb_unrolled_list_iterator_prev(%d): %lld ms, size: %d, maxn: %d", n, t, tb_unrolled_list_size(list), tb_unrolled_list_maxn(list));
+
+    // exit
+    tb_unrolled_list_exit(list);
+}
+static tb_void_t tb_unrolled_list_str_dump(tb_unrolled_list_ref_t list)
+{
+    // trace
+    tb_trace_i("str size: %d, maxn: %d", tb_unrolled_list_size(list), tb_unrolled_list_maxn(list));
+
+    // done
+    tb_for_all (tb_char_t*, item, list)
+    {
+        // trace
+        tb_trace_i("str at[%lx]: %s", item_itor, item);
+    }
+}
+static tb_void_t tb_unrolled_list_str_test()
+{
+    // init list, using the small chunk for splitting and merging chunks
+    tb_unrolled_list_ref_t list = tb_unrolled_list_init(4, tb_element_str(tb_true));
+    tb_assert_and_check_return(list);
+
+    // trace
+    tb_trace_i("=============================================================");
+    tb_trace_i("insert:");
+
+    // insert
+    tb_size_t i = tb_unrolled_list_insert_tail(list, "0000000000");
+    tb_unrolled_list_insert_tail(list, "1111111111");
+    tb_unrolled_list_insert_tail(list, "2222222222");
+    tb_unrolled_list_insert_tail(list, "3333333333");
+    tb_unrolled_list_insert_tail(list, "4444444444");
+    tb_unrolled_list_insert_head(list, "5555555555");
+    tb_unrolled_list_insert_head(list, "6666666666");
+    i = tb_unrolled_list_insert_next(list, i, "7777777777");
+    i = tb_unrolled_list_insert_next(list, i, "8888888888");
+    tb_unrolled_list_insert_prev(list, i, "9999999999");
+
+    // dump
+    tb_unrolled_list_str_dump(list);
+
+    // trace
+    tb_trace_i("=============================================================");
+    tb_trace_i("remove:");
+
+    // remove
+    tb_unrolled_list_remove_head(list);
+    tb_unrolled_list_remove_last(list);
+    i = tb_unrolled_list_remove(list, tb_iterator_next(list, tb_iterator_head(list)));
+    tb_unrolled_list_remove(list, i);
+
+    // dump
+    tb_unrolled_list_str_dump(list);
+
+    // trace
+    tb_trace_i("=============================================================");
+    tb_trace_i("replace:");
+
+    // replace
+    tb_unrolled_list_replace_head(list, "aaaaaaaaaa");
+    tb_unrolled_list_replace_last(list, "ffffffffff");
+
+    // dump
+    tb_unrolled_list_str_dump(list);
+
+    // exit list
+    tb_unrolled_list_exit(list);
+}
+static tb_void_t tb_unrolled_list_check_test()
+{
+    // init list and the vector for checking it
+    tb_unrolled_list_ref_t  list = tb_unrolled_list_init(8, tb_element_long());
+    tb_vector_ref_t         vector = tb_vector_init(0, tb_element_long());
+    tb_assert_and_check_return(list && vector);
+
+    // insert and remove the random items
+    tb_size_t i = 0;
+    tb_size_t n = 100000;
+    tb_bool_t ok = tb_true;
+    for (i = 0; i < n && ok; i++)
+    {
+        // the random position
+        tb_size_t size = tb_vector_size(vector);
+        tb_size_t pos = size? tb_random_range(0, size) : 0;
+
+        // the list itor at this position
+        tb_size_t itor = tb_iterator_head(list);
+        tb_size_t j = pos;
+        while (j--) itor = tb_iterator_next(list, itor);
+
+        // remove or insert it
+        if (size && pos < size && tb_random_range(0, 3) == 0)
+        {
+            tb_unrolled_list_remove(list, itor);
+            tb_vector_remove(vector, pos);
+        }
+        else
+        {
+            tb_unrolled_list_insert_prev(list, itor, (tb_pointer_t)i);
+            tb_vector_insert_prev(vector, pos, (tb_pointer_t)i);
+        }
+
+        // check them
+        if (!(i & 1023) || i + 1 == n)
+        {
+            tb_size_t k = 0;
+            tb_for_all (tb_long_t, item, list)
+            {
+                if (item != (tb_long_t)tb_iterator_item(vector, k++)) ok = tb_false;
+            }
+            tb_rfor_all (tb_long_t, ritem, list)
+            {
+                if (ritem != (tb_long_t)tb_iterator_item(vector, --k)) ok = tb_false;
+            }
+            if (tb_unrolled_list_size(list) != tb_vector_size(vector)) ok = tb_false;
+        }
+    }
+
+    // trace
+    tb_trace_i("tb_unrolled_list_check(%lu): %s, size: %lu", n, ok? "ok" : "failed", tb_unrolled_list_size(list));
+
+    // exit list and vector
+    tb_unrolled_list_exit(list);
+    tb_vector_exit(vector);
+}
+static tb_void_t tb_unrolled_list_perf_test()
+{
+    // insert
+    tb_unrolled_list_insert_head_test();
+    tb_unrolled_list_insert_tail_test();
+
+    // remove
+    tb_unrolled_list_remove_head_test();
+    tb_unrolled_list_remove_last_test();
+
+    // iterator
+    tb_unrolled_list_iterator_next_test();
+    tb_unrolled_list_iterator_prev_test();
+}
+static tb_bool_t tb_unrolled_list_test_walk_item(tb_iterator_ref_t iterator, tb_pointer_t item, tb_cpointer_t priv)
+{
+    // done
+    tb_hize_t* test = (tb_hize_t*)priv;
+    test[0] += (tb_size_t)item;
+    test[1]++;
+
+    // continue
+    return tb_true;
+}
+static tb_void_t tb_unrolled_list_walk_perf_done(tb_char_t const* name, tb_iterator_ref_t list)
+{
+    // walk all
+    tb_hize_t test[2] = {0};
+    tb_hong_t t = tb_mclock();
+    tb_walk_all(list, tb_unrolled_list_test_walk_item, test);
+    t = tb_mclock() - t;
+
+    // find the missing item
+    tb_hong_t f = tb_mclock();
+    tb_size_t itor = tb_find_all(list, (tb_pointer_t)(tb_size_t)-1);
+    f = tb_mclock() - f;
+
+    // count all
+    tb_hong_t c = tb_mclock();
+    tb_size_t count = tb_count_all(list, (tb_pointer_t)0xd);
+    c = tb_mclock() - c;
+
+    // trace
+    tb_trace_i("%s: walk: %lld ms, find: %lld ms, count: %lld ms, sum: %llx, size: %llu, found: %s, count: %lu"
+        , name, t, f, c, test[0], test[1], itor != tb_iterator_tail(list)? "yes" : "no", count);
+}
+static tb_void_t tb_unrolled_list_walk_perf()
+{
+    // init lists
+    tb_list_ref_t           list = tb_list_init(0, tb_element_long());
+    tb_single_list_ref_t    single_list = tb_single_list_init(0, tb_element_long());
+    tb_unrolled_list_ref_t  unrolled_list = tb_unrolled_list_init(0, tb_element_long());
+    tb_assert_and_check_return(list && single_list && unrolled_list);
+
+    // make lists, the nodes of the linked lists are scattered by the random insertion
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000000;
+    for (i = 0; i < n; i++)
+    {
+        tb_long_t item = tb_random_range(0, 0xf);
+        if (i & 1)
+        {
+            tb_list_insert_tail(list, (tb_pointer_t)item);
+            tb_single_list_insert_tail(single_list, (tb_pointer_t)item);
+            tb_unrolled_list_insert_tail(unrolled_list, (tb_pointer_t)item);
+        }
+        else
+        {
+            tb_list_insert_head(list, (tb_pointer_t)item);
+            tb_single_list_insert_head(single_list, (tb_pointer_t)item);
+            tb_unrolled_list_insert_head(unrolled_list, (tb_pointer_t)item);
+        }
+    }
+
+    // done
+    tb_unrolled_list_walk_perf_done("list", list);
+    tb_unrolled_list_walk_perf_done("single_list", single_list);
+    tb_unrolled_list_walk_perf_done("unrolled_list", unrolled_list);
+
+    // exit lists
+    tb_list_exit(list);
+    tb_single_list_exit(single_list);
+    tb_unrolled_list_exit(unrolled_list);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_unrolled_list_main(tb_int_t argc, tb_char_t** argv)
+{
+    tb_unrolled_list_str_test();
+    tb_unrolled_list_check_test();
+
+#if 1
+    tb_unrolled_list_perf_test();
+#endif
+
+#if 1
+    tb_unrolled_list_walk_perf();
+#endif
+
+    return 0;
+}
@@ -99,6 +99,86 @@ static tb_size_t tb_vector_insert_tail_test()
 
     return n / ((tb_uint32_t)(t) + 1);
 }
+static tb_size_t tb_vector_insert_items_test()
+{
+    // init
+    tb_vector_ref_t vector = tb_vector_init(TB_VECTOR_GROW_SIZE, tb_element_uint32());
+    tb_assert_and_check_return_val(vector, 0);
+
+    // make items
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000000;
+    tb_uint32_t* items = tb_nalloc_type(n, tb_uint32_t);
+    tb_assert_and_check_return_val(items, 0);
+    for (i = 0; i < n; i++) items[i] = (tb_uint32_t)i;
+
+    // insert them one by one
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++) tb_vector_insert_tail(vector, (tb_pointer_t)(tb_size_t)items[i]);
+    t = tb_mclock() - t;
+
+    // time
+    tb_trace_i("tb_vector_insert_tail(%lu): %lld ms, size: %lu, maxn: %lu", n, t, tb_vector_size(vector), tb_vector_maxn(vector));
+
+    // insert them by one call
+    tb_hong_t b = tb_mclock();
+    tb_vector_insert_tail_items(vector, items, n);
+    tb_vector_insert_items(vector, 0, items, n);
+    b = tb_mclock() - b;
+
+    // time
+    tb_trace_i("tb_vector_insert_items(%lu): %lld ms, size: %lu, maxn: %lu", n + n, b, tb_vector_size(vector), tb_vector_maxn(vector));
+
+    // check
+    tb_assert(tb_vector_size(vector) == n + n + n);
+    tb_assert(tb_iterator_item(vector, n - 1) == (tb_pointer_t)(n - 1));
+    tb_assert(tb_iterator_item(vector, n + n + n - 1) == (tb_pointer_t)(n - 1));
+
+    // replace them
+    tb_vector_replace_items(vector, n, items + 1, n - 1);
+    tb_assert(tb_iterator_item(vector, n) == (tb_pointer_t)1);
+
+    // remove them
+    tb_vector_nremove_last(vector, n + n);
+    tb_assert(tb_vector_size(vector) == n);
+
+    // shrink it
+    tb_vector_shrink(vector);
+    tb_trace_i("tb_vector_shrink(%lu): size: %lu, maxn: %lu", n, tb_vector_size(vector), tb_vector_maxn(vector));
+
+    // exit
+    tb_free(items);
+    tb_vector_exit(vector);
+
+    return n / ((tb_uint32_t)(t) + 1);
+}
+static tb_size_t tb_vector_insert_items_str_test()
+{
+    // init
+    tb_vector_ref_t vector = tb_vector_init(TB_VECTOR_GROW_SIZE, tb_element_str(tb_true));
+    tb_assert_and_check_return_val(vector, 0);
+
+    // reserve it
+    __tb_volatile__ tb_size_t n = 100000;
+    tb_vector_reserve(vector, n + n);
+
+    // insert items
+    tb_char_t const* items[] = {"hello", "world", "how", "are", "you"};
+    tb_hong_t t = tb_mclock();
+    while (tb_vector_size(vector) < n) tb_vector_insert_tail_items(vector, items, tb_arrayn(items));
+    t = tb_mclock() - t;
+
+    // time
+    tb_trace_i("tb_vector_insert_items(%lu): %lld ms, size: %lu, maxn: %lu", n, t, tb_vector_size(vector), tb_vector_maxn(vector));
+
+    // check
+    tb_assert(!tb_strcmp((tb_char_t const*)tb_vector_last(vector), "you"));
+
+    // exit
+    tb_vector_exit(vector);
+
+    return n / ((tb_uint32_t)(t) + 1);
+}
 static tb_size_t tb_vector_ninsert_test()
 {
     // init
@@ -716,6 +796,8 @@ static tb_void_t tb_vector_perf_test()
     score += tb_vector_ninsert_test();
     score += tb_vector_ninsert_head_test();
     score += tb_vector_ninsert_tail_test();
+    score += tb_vector_insert_items_test();
+    score += tb_vector_insert_items_str_test();
 
     tb_trace_i("=============================================================");
     tb_trace_i("remove performance:");
@@ -69,10 +69,13 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(asio_dns)
 ,   TB_DEMO_MAIN_ITEM(asio_http)
 ,   TB_DEMO_MAIN_ITEM(asio_httpd)
+,   TB_DEMO_MAIN_ITEM(asio_httpd_bench)
 ,   TB_DEMO_MAIN_ITEM(asio_aiopc)
 ,   TB_DEMO_MAIN_ITEM(asio_aiopd)
 ,   TB_DEMO_MAIN_ITEM(asio_aicpc)
 ,   TB_DEMO_MAIN_ITEM(asio_aicpd)
+,   TB_DEMO_MAIN_ITEM(asio_mixed)
+,   TB_DEMO_MAIN_ITEM(asio_sharded)
 #endif
 
     // math
@@ -117,6 +120,7 @@ static tb_demo_t g_demo[] =
 #ifdef TB_CONFIG_MODULE_HAVE_OBJECT
 ,   TB_DEMO_MAIN_ITEM(object_jcat)
 ,   TB_DEMO_MAIN_ITEM(object_json)
+,   TB_DEMO_MAIN_ITEM(object_json_reader)
 ,   TB_DEMO_MAIN_ITEM(object_bin)
 ,   TB_DEMO_MAIN_ITEM(object_xml)
 ,   TB_DEMO_MAIN_ITEM(object_bplist)
@@ -156,6 +160,9 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(memory_queue_buffer)
 ,   TB_DEMO_MAIN_ITEM(memory_static_buffer)
 ,   TB_DEMO_MAIN_ITEM(memory_impl_static_fixed_pool)
+#ifdef TB_CONFIG_MODULE_HAVE_THREAD
+,   TB_DEMO_MAIN_ITEM(memory_benchmark)
+#endif
 
     // network
 #ifdef TB_CONFIG_MODULE_HAVE_NETWORK
@@ -203,6 +210,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(container_stack)
 ,   TB_DEMO_MAIN_ITEM(container_vector)
 ,   TB_DEMO_MAIN_ITEM(container_hash_map)
+,   TB_DEMO_MAIN_ITEM(container_flat_hash_map)
 ,   TB_DEMO_MAIN_ITEM(container_hash_set)
 ,   TB_DEMO_MAIN_ITEM(container_queue)
 ,   TB_DEMO_MAIN_ITEM(container_circle_queue)
@@ -210,7 +218,12 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(container_list_entry)
 ,   TB_DEMO_MAIN_ITEM(container_single_list)
 ,   TB_DEMO_MAIN_ITEM(container_single_list_entry)
+,   TB_DEMO_MAIN_ITEM(container_unrolled_list)
 ,   TB_DEMO_MAIN_ITEM(container_bloom_filter)
+#ifdef TB_CONFIG_MODULE_HAVE_THREAD
+,   TB_DEMO_MAIN_ITEM(container_mpmc_queue)
+,   TB_DEMO_MAIN_ITEM(container_concurrent_hash_map)
+#endif
 
     // algorithm
 ,   TB_DEMO_MAIN_ITEM(algorithm_find)
@@ -69,10 +69,13 @@ TB_DEMO_MAIN_DECL(libm_integer);
 TB_DEMO_MAIN_DECL(asio_dns);
 TB_DEMO_MAIN_DECL(asio_http);
 TB_DEMO_MAIN_DECL(asio_httpd);
+TB_DEMO_MAIN_DECL(asio_httpd_bench);
 TB_DEMO_MAIN_DECL(asio_aiopc);
 TB_DEMO_MAIN_DECL(asio_aiopd);
 TB_DEMO_MAIN_DECL(asio_aicpc);
 TB_DEMO_MAIN_DECL(asio_aicpd);
+TB_DEMO_MAIN_DECL(asio_mixed);
+TB_DEMO_MAIN_DECL(asio_sharded);
 
 // math
 TB_DEMO_MAIN_DECL(math_fixed);
@@ -107,6 +110,7 @@ TB_DEMO_MAIN_DECL(other_charset);
 // object
 TB_DEMO_MAIN_DECL(object_jcat);
 TB_DEMO_MAIN_DECL(object_json);
+TB_DEMO_MAIN_DECL(object_json_reader);
 TB_DEMO_MAIN_DECL(object_bin);
 TB_DEMO_MAIN_DECL(object_xml);
 TB_DEMO_MAIN_DECL(object_xplist);
@@ -143,6 +147,7 @@ TB_DEMO_MAIN_DECL(memory_buffer);
 TB_DEMO_MAIN_DECL(memory_queue_buffer);
 TB_DEMO_MAIN_DECL(memory_static_buffer);
 TB_DEMO_MAIN_DECL(memory_impl_static_fixed_pool);
+TB_DEMO_MAIN_DECL(memory_benchmark);
 
 // network
 #ifdef TB_CONFIG_MODULE_HAVE_NETWORK
@@ -188,6 +193,7 @@ TB_DEMO_MAIN_DECL(container_heap);
 TB_DEMO_MAIN_DECL(container_stack);
 TB_DEMO_MAIN_DECL(container_vector);
 TB_DEMO_MAIN_DECL(container_hash_map);
+TB_DEMO_MAIN_DECL(container_flat_hash_map);
 TB_DEMO_MAIN_DECL(container_hash_set);
 TB_DEMO_MAIN_DECL(container_queue);
 TB_DEMO_MAIN_DECL(container_circle_queue);
@@ -195,7 +201,10 @@ TB_DEMO_MAIN_DECL(container_list);
 TB_DEMO_MAIN_DECL(container_list_entry);
 TB_DEMO_MAIN_DECL(container_single_list);
 TB_DEMO_MAIN_DECL(container_single_list_entry);
+TB_DEMO_MAIN_DECL(container_unrolled_list);
 TB_DEMO_MAIN_DECL(container_bloom_filter);
+TB_DEMO_MAIN_DECL(container_mpmc_queue);
+TB_DEMO_MAIN_DECL(container_concurrent_hash_map);
 
 // algorithm
 TB_DEMO_MAIN_DECL(algorithm_find);
@@ -0,0 +1,139 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the thread maximum count
+#define TB_DEMO_THREAD_MAXN         (64)
+
+// the live data maximum count for each thread
+#define TB_DEMO_LIVE_MAXN           (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the benchmark context type
+typedef struct __tb_demo_benchmark_t
+{
+    // the allocator
+    tb_allocator_ref_t      allocator;
+
+    // the loop count for each thread
+    tb_size_t               loop;
+
+}tb_demo_benchmark_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_pointer_t tb_demo_benchmark_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_benchmark_t const* benchmark = (tb_demo_benchmark_t const*)priv;
+    tb_assert_and_check_return_val(benchmark && benchmark->allocator, tb_null);
+
+    // done
+    tb_allocator_ref_t  allocator = benchmark->allocator;
+    tb_pointer_t        list[TB_DEMO_LIVE_MAXN] = {0};
+    tb_size_t           rand = 0xbeaf + tb_thread_self();
+    tb_size_t           indx = 0;
+    tb_size_t           loop = benchmark->loop;
+    for (indx = 0; indx < loop; indx++)
+    {
+        // make rand
+        rand = (rand * 10807 + 1) & 0xffffffff;
+
+        // free the old data
+        tb_size_t slot = rand & (TB_DEMO_LIVE_MAXN - 1);
+        if (list[slot]) tb_allocator_free(allocator, list[slot]);
+
+        // make the new data: 1 - 512B mostly
+        list[slot] = tb_allocator_malloc(allocator, (rand & 0x7) ? ((rand >> 8) & 511) + 1 : ((rand >> 8) & 3071) + 1);
+        tb_assert_and_check_break(list[slot]);
+    }
+
+    // free all
+    for (indx = 0; indx < TB_DEMO_LIVE_MAXN; indx++)
+    {
+        if (list[indx]) tb_allocator_free(allocator, list[indx]);
+    }
+
+    // exit thread
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+static tb_void_t tb_demo_benchmark_test(tb_char_t const* name, tb_allocator_ref_t allocator, tb_size_t threads, tb_size_t loop)
+{
+    // init benchmark
+    tb_demo_benchmark_t benchmark;
+    benchmark.allocator = allocator;
+    benchmark.loop      = loop;
+
+    // init threads
+    tb_size_t       i = 0;
+    tb_thread_ref_t list[TB_DEMO_THREAD_MAXN] = {0};
+    tb_hong_t       time = tb_mclock();
+    for (i = 0; i < threads; i++)
+        list[i] = tb_thread_init(tb_null, tb_demo_benchmark_loop, &benchmark, 0);
+
+    // wait threads
+    for (i = 0; i < threads; i++)
+    {
+        if (list[i])
+        {
+            tb_thread_wait(list[i], -1);
+            tb_thread_exit(list[i]);
+        }
+    }
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("%s: threads: %lu, malloc/free: %lu, time: %lld ms, %lld ops/ms", name, threads, threads * loop, time, (tb_hong_t)(threads * loop) / tb_max(time, 1));
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_memory_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the thread maximum count and the loop count for each thread
+    tb_size_t maxn = argv[1]? tb_atoi(argv[1]) : (tb_processor_count() << 1);
+    tb_size_t loop = (argv[1] && argv[2])? tb_atoi(argv[2]) : 1000000;
+    maxn = tb_min(tb_max(maxn, 1), TB_DEMO_THREAD_MAXN);
+
+    // init the default allocator for comparing the thread cache
+    tb_allocator_ref_t large_allocator = tb_large_allocator_init(tb_null, 0);
+    tb_allocator_ref_t allocator = large_allocator? tb_default_allocator_init(large_allocator) : tb_null;
+    if (allocator)
+    {
+        // done
+        tb_size_t threads = 1;
+        for (threads = 1; threads <= maxn; threads <<= 1)
+        {
+            // the default allocator with the thread cache
+            allocator->flag &= ~TB_ALLOCATOR_FLAG_NOCACHE;
+            tb_demo_benchmark_test("cached ", allocator, threads, loop);
+
+            // the default allocator without the thread cache
+            allocator->flag |= TB_ALLOCATOR_FLAG_NOCACHE;
+            tb_demo_benchmark_test("nocache", allocator, threads, loop);
+
+            // the native allocator
+            tb_demo_benchmark_test("native ", tb_native_allocator(), threads, loop);
+        }
+    }
+
+    // exit allocator
+    if (allocator) tb_allocator_exit(allocator);
+    allocator = tb_null;
+
+    // exit large allocator
+    if (large_allocator) tb_allocator_exit(large_allocator);
+    large_allocator = tb_null;
+    return 0;
+}
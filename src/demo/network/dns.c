@@ -27,12 +27,55 @@ static tb_void_t tb_dns_test_done(tb_char_t const* name)
     }
     else tb_trace_i("[demo]: %s failed", name);
 }
+static tb_void_t tb_dns_test_cache()
+{
+    // save some addresses
+    tb_size_t   i = 0;
+    tb_char_t   name[64];
+    tb_ipaddr_t addr;
+    for (i = 0; i < 16; i++)
+    {
+        tb_snprintf(name, sizeof(name), "host%lu.tboox.org", i);
+        tb_ipaddr_ip_cstr_set(&addr, "10.0.0.1", TB_IPADDR_FAMILY_IPV4);
+        tb_dns_cache_set_ttl(name, &addr, i & 1? 0 : 60);
+    }
+
+    // save a failed host name
+    tb_dns_cache_set_failed("www.xxxxx.com", 0);
+    if (tb_dns_cache_failed("www.xxxxx.com") && !tb_dns_cache_get("www.xxxxx.com", &addr))
+        tb_trace_i("[demo]: cache: www.xxxxx.com failed");
+
+    // lookup them
+    tb_size_t   n = 1000000;
+    tb_size_t   found = 0;
+    tb_hong_t   time = tb_mclock();
+    for (i = 0; i < n; i++)
+    {
+        tb_snprintf(name, sizeof(name), "host%lu.tboox.org", i & 31);
+        if (tb_dns_cache_get(name, &addr)) found++;
+    }
+    time = tb_mclock() - time;
+
+    // dump stat
+    tb_dns_cache_stat_t stat;
+    tb_dns_cache_stat(&stat);
+    tb_trace_i("[demo]: cache: lookup: %lu, found: %lu, %lld ms", n, found, time);
+    tb_trace_i("[demo]: cache: hits: %lu, misses: %lu, expired: %lu, failed: %lu, evicted: %lu, contention: %lu, size: %lu, hit_rate: %lu.%02lu%%"
+        , stat.hits, stat.misses, stat.expired, stat.failed, stat.evicted, stat.contention, stat.size, stat.hit_rate / 100, stat.hit_rate % 100);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_network_dns_main(tb_int_t argc, tb_char_t** argv)
 {
+    // test the dns cache
+    if (argc > 1 && !tb_strcmp(argv[1], "--cache"))
+    {
+        tb_dns_test_cache();
+        return 0;
+    }
+
     // test the invalid host
 #if TB_DNS_TEST_INVALID_HOST
     // add not dns host
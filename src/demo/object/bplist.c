@@ -3,11 +3,59 @@
  */ 
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */ 
+static tb_void_t tb_demo_object_bplist_test()
+{
+    // the temporary file
+    tb_char_t path[TB_PATH_MAXN];
+    tb_size_t size = tb_directory_temporary(path, sizeof(path));
+    tb_assert_and_check_return(size && size + 16 < sizeof(path));
+    tb_snprintf(path + size, sizeof(path) - size, "/test.bplist");
+
+    // make object with the empty strings
+    tb_object_ref_t object = tb_object_dictionary_init(TB_OBJECT_DICTIONARY_SIZE_MICRO, tb_false);
+    tb_assert_and_check_return(object);
+    tb_object_dictionary_insert(object, "empty", tb_object_string_init_from_cstr(tb_null));
+    tb_object_dictionary_insert(object, "hello", tb_object_string_init_from_cstr("hello world"));
+
+    // writ it
+    tb_long_t writ = tb_object_writ_to_url(object, path, TB_OBJECT_FORMAT_BPLIST);
+    tb_object_exit(object);
+    tb_assert_and_check_return(writ > 0);
+
+    // read it
+    object = tb_object_read_from_url(path);
+    tb_assert_and_check_return(object);
+
+    // check it
+    tb_object_ref_t empty = tb_object_dictionary_value(object, "empty");
+    tb_object_ref_t hello = tb_object_dictionary_value(object, "hello");
+    if (empty && !tb_object_string_size(empty) && hello && !tb_strcmp(tb_object_string_cstr(hello), "hello world"))
+        tb_trace_i("test: ok");
+    else tb_trace_e("test: failed");
+
+    // dump it
+    tb_object_dump(object, TB_OBJECT_FORMAT_XML);
+
+    // exit it
+    tb_object_exit(object);
+    tb_file_remove(path);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_object_bplist_main(tb_int_t argc, tb_char_t** argv)
 {
+    // test the empty strings
+    if (argc < 3)
+    {
+        tb_demo_object_bplist_test();
+        return 0;
+    }
+
     // read object
     tb_object_ref_t object = tb_object_read_from_url(argv[1]);
 
@@ -8,21 +8,39 @@
  */ 
 tb_int_t tb_demo_object_dump_main(tb_int_t argc, tb_char_t** argv)
 {
+    // read it into the arena? 
+    tb_object_arena_ref_t arena = tb_null;
+    if (argv[1] && !tb_strcmp(argv[1], "--arena"))
+    {
+        arena = tb_object_arena_init(0);
+        argv++;
+    }
+
     // read
-    tb_object_ref_t root = tb_object_read_from_url(argv[1]);
+    tb_hong_t       time = tb_mclock();
+    tb_object_ref_t root = arena? tb_object_arena_read_from_url(arena, argv[1]) : tb_object_read_from_url(argv[1]);
+    time = tb_mclock() - time;
     if (root)
     {
+        // trace
+        tb_trace_i("load: %lld ms", time);
+        if (arena) tb_trace_i("arena: used: %lu bytes, size: %lu bytes", tb_object_arena_used(arena), tb_object_arena_size(arena));
+
         // seek?
         tb_object_ref_t object = root;
         if (argv[2]) object = tb_object_seek(root, argv[2], tb_true);
 
         // dump object
         if (object) tb_object_dump(object, TB_OBJECT_FORMAT_XML);
-
-        // exit object
-        tb_object_exit(root);
     }
-    
+
+    // exit object or arena
+    time = tb_mclock();
+    if (arena) tb_object_arena_exit(arena);
+    else if (root) tb_object_exit(root);
+    time = tb_mclock() - time;
+
+    // trace
+    if (root) tb_trace_i("free: %lld ms", time);
     return 0;
 }
-
@@ -0,0 +1,146 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */ 
+static tb_void_t tb_demo_json_reader_dump(tb_char_t const* url)
+{
+    // init reader
+    tb_json_reader_ref_t reader = tb_json_reader_init();
+    if (reader)
+    {
+        // open reader
+        if (tb_json_reader_open(reader, tb_stream_init_from_url(url), tb_true))
+        {
+            // walk
+            tb_size_t event = TB_JSON_READER_EVENT_NONE;
+            while ((event = tb_json_reader_next(reader)))
+            {
+                // the level
+                tb_size_t t = tb_json_reader_level(reader);
+                if (event == TB_JSON_READER_EVENT_OBJECT_BEG || event == TB_JSON_READER_EVENT_ARRAY_BEG) t--;
+
+                // dump it
+                switch (event)
+                {
+                case TB_JSON_READER_EVENT_OBJECT_BEG:
+                    while (t--) tb_printf("\t");
+                    tb_printf("{\n");
+                    break;
+                case TB_JSON_READER_EVENT_OBJECT_END:
+                    while (t--) tb_printf("\t");
+                    tb_printf("}\n");
+                    break;
+                case TB_JSON_READER_EVENT_ARRAY_BEG:
+                    while (t--) tb_printf("\t");
+                    tb_printf("[\n");
+                    break;
+                case TB_JSON_READER_EVENT_ARRAY_END:
+                    while (t--) tb_printf("\t");
+                    tb_printf("]\n");
+                    break;
+                case TB_JSON_READER_EVENT_KEY:
+                    while (t--) tb_printf("\t");
+                    tb_printf("\"%s\":\n", tb_json_reader_string(reader, tb_null));
+                    break;
+                case TB_JSON_READER_EVENT_STRING:
+                    while (t--) tb_printf("\t");
+                    tb_printf("\"%s\"\n", tb_json_reader_string(reader, tb_null));
+                    break;
+                case TB_JSON_READER_EVENT_NUMBER:
+                    while (t--) tb_printf("\t");
+                    tb_printf("%s\n", tb_json_reader_number(reader));
+                    break;
+                case TB_JSON_READER_EVENT_TRUE:
+                    while (t--) tb_printf("\t");
+                    tb_printf("true\n");
+                    break;
+                case TB_JSON_READER_EVENT_FALSE:
+                    while (t--) tb_printf("\t");
+                    tb_printf("false\n");
+                    break;
+                case TB_JSON_READER_EVENT_NULL:
+                    while (t--) tb_printf("\t");
+                    tb_printf("null\n");
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            // failed?
+            if (tb_json_reader_failed(reader)) tb_trace_e("invalid json: %s", url);
+        }
+
+        // exit reader
+        tb_json_reader_exit(reader);
+    }
+}
+static tb_void_t tb_demo_json_reader_bench(tb_char_t const* url)
+{
+    // read events
+    tb_size_t count = 0;
+    tb_hong_t time = tb_mclock();
+    tb_json_reader_ref_t reader = tb_json_reader_init();
+    if (reader)
+    {
+        // walk all events
+        if (tb_json_reader_open(reader, tb_stream_init_from_url(url), tb_true))
+        {
+            while (tb_json_reader_next(reader)) count++;
+            if (tb_json_reader_failed(reader)) tb_trace_e("invalid json: %s", url);
+        }
+
+        // exit reader
+        tb_json_reader_exit(reader);
+    }
+    time = tb_mclock() - time;
+    tb_trace_i("json_reader: %lu events, %lld ms", count, time);
+
+    // read object
+    time = tb_mclock();
+    tb_object_ref_t object = tb_object_read_from_url(url);
+    time = tb_mclock() - time;
+    tb_trace_i("object_read: %s, %lld ms", object? "ok" : "failed", time);
+
+    // exit object
+    time = tb_mclock();
+    if (object) tb_object_exit(object);
+    time = tb_mclock() - time;
+    tb_trace_i("object_exit: %lld ms", time);
+
+    // read object into the arena
+    tb_object_arena_ref_t arena = tb_object_arena_init(0);
+    if (arena)
+    {
+        // read object
+        time = tb_mclock();
+        object = tb_object_arena_read_from_url(arena, url);
+        time = tb_mclock() - time;
+        tb_trace_i("object_arena_read: %s, %lld ms, used: %lu bytes, size: %lu bytes", object? "ok" : "failed", time, tb_object_arena_used(arena), tb_object_arena_size(arena));
+
+        // exit arena
+        time = tb_mclock();
+        tb_object_arena_exit(arena);
+        time = tb_mclock() - time;
+        tb_trace_i("object_arena_exit: %lld ms", time);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_object_json_reader_main(tb_int_t argc, tb_char_t** argv)
+{
+    // check
+    tb_assert_and_check_return_val(argc > 1 && argv[1], 0);
+
+    // bench it? compare it with tb_object_read
+    if (argc > 2 && !tb_strcmp(argv[1], "--bench")) tb_demo_json_reader_bench(argv[2]);
+    // dump it
+    else tb_demo_json_reader_dump(argv[1]);
+    return 0;
+}
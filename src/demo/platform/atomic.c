@@ -3,6 +3,80 @@
  */ 
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the perf count
+#ifdef __tb_debug__
+#   define TB_DEMO_ATOMIC_PERF_MAXN     (1000000)
+#else
+#   define TB_DEMO_ATOMIC_PERF_MAXN     (100000000)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */ 
+static tb_void_t tb_demo_atomic_perf()
+{
+    // init
+    tb_atomic_t a = 0;
+    tb_long_t   s = 0;
+    tb_size_t   i = 0;
+    tb_size_t   n = TB_DEMO_ATOMIC_PERF_MAXN;
+
+    // get: sequentially consistent
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++) s += tb_atomic_get(&a);
+    t = tb_mclock() - t;
+    tb_trace_i("perf: get: seq_cst: %lld ms", t);
+
+    // get: acquire
+    t = tb_mclock();
+    for (i = 0; i < n; i++) s += tb_atomic_get_explicit(&a, TB_ATOMIC_ACQUIRE);
+    t = tb_mclock() - t;
+    tb_trace_i("perf: get: acquire: %lld ms", t);
+
+    // set: sequentially consistent
+    t = tb_mclock();
+    for (i = 0; i < n; i++) tb_atomic_set(&a, i);
+    t = tb_mclock() - t;
+    tb_trace_i("perf: set: seq_cst: %lld ms", t);
+
+    // set: release
+    t = tb_mclock();
+    for (i = 0; i < n; i++) tb_atomic_set_explicit(&a, i, TB_ATOMIC_RELEASE);
+    t = tb_mclock() - t;
+    tb_trace_i("perf: set: release: %lld ms", t);
+
+    // inc: sequentially consistent
+    t = tb_mclock();
+    for (i = 0; i < n; i++) tb_atomic_fetch_and_inc(&a);
+    t = tb_mclock() - t;
+    tb_trace_i("perf: inc: seq_cst: %lld ms", t);
+
+    // inc: relaxed
+    t = tb_mclock();
+    for (i = 0; i < n; i++) tb_atomic_fetch_and_inc_explicit(&a, TB_ATOMIC_RELAXED);
+    t = tb_mclock() - t;
+    tb_trace_i("perf: inc: relaxed: %lld ms", t);
+
+    // pset: sequentially consistent
+    t = tb_mclock();
+    for (i = 0; i < n; i++) tb_atomic_fetch_and_pset(&a, 0, 0);
+    t = tb_mclock() - t;
+    tb_trace_i("perf: pset: seq_cst: %lld ms", t);
+
+    // pset: acquire
+    t = tb_mclock();
+    for (i = 0; i < n; i++) tb_atomic_fetch_and_pset_explicit(&a, 0, 0, TB_ATOMIC_ACQUIRE);
+    t = tb_mclock() - t;
+    tb_trace_i("perf: pset: acquire: %lld ms", t);
+
+    // trace
+    tb_trace_i("perf: %ld", s + tb_atomic_get(&a));
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
@@ -29,5 +103,17 @@ tb_int_t tb_demo_platform_atomic_main(tb_int_t argc, tb_char_t** argv)
     tb_trace_i("%ld", tb_atomic_xor_and_fetch(&a, 0xff));
     tb_trace_i("%ld", tb_atomic_or_and_fetch(&a, 0xff));
 
+    // the explicit memory order
+    tb_atomic_set_explicit(&a, 0, TB_ATOMIC_RELEASE);
+    tb_trace_i("%ld", tb_atomic_get_explicit(&a, TB_ATOMIC_ACQUIRE));
+    tb_trace_i("%ld", tb_atomic_fetch_and_pset_explicit(&a, 0, 1, TB_ATOMIC_ACQ_REL));
+    tb_trace_i("%ld", tb_atomic_fetch_and_inc_explicit(&a, TB_ATOMIC_RELAXED));
+    tb_trace_i("%ld", tb_atomic_fetch_and_dec_explicit(&a, TB_ATOMIC_ACQ_REL));
+    tb_trace_i("%ld", tb_atomic_add_and_fetch_explicit(&a, 10, TB_ATOMIC_RELAXED));
+    tb_trace_i("%ld", tb_atomic_fetch_and_set_explicit(&a, 0, TB_ATOMIC_ACQUIRE));
+
+    // perf
+    tb_demo_atomic_perf();
+
     return 0;
 }
@@ -3,6 +3,29 @@
  */
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the root tasks count for the work-stealing mode
+#define TB_DEMO_SPAWN_ROOTN         (8)
+
+// the children count of each task for the work-stealing mode
+#define TB_DEMO_SPAWN_FANOUT        (8)
+
+// the task depth for the work-stealing mode
+#define TB_DEMO_SPAWN_DEPTH         (3)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */ 
+
+// the work-stealing pool
+static tb_thread_pool_ref_t         g_spawn_pool = tb_null;
+
+// the done count of the work-stealing tasks
+static tb_atomic_t                  g_spawn_done = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * test
  */ 
@@ -19,12 +42,77 @@ static tb_void_t tb_demo_task_time_exit(tb_thread_pool_worker_ref_t worker, tb_c
     // trace
     tb_trace_i("exit: %u ms", tb_p2u32(priv));
 }
+static tb_void_t tb_demo_task_spawn_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // the depth
+    tb_size_t depth = tb_p2u32(priv);
+
+    // done it
+    tb_atomic_fetch_and_inc(&g_spawn_done);
+
+    // post the children from the worker, they will be pushed to the local jobs and stolen by the idle workers
+    tb_size_t i = 0;
+    for (i = 0; depth && i < TB_DEMO_SPAWN_FANOUT; i++)
+        tb_thread_pool_task_post(g_spawn_pool, "spawn", tb_demo_task_spawn_done, tb_null, tb_u2p(depth - 1), tb_false);
+
+    // do some works for the leaf task
+    if (!depth) tb_usleep(tb_random_range(0, 100));
+}
+static tb_void_t tb_demo_thread_pool_stealing()
+{
+    // init the work-stealing pool
+    g_spawn_pool = tb_thread_pool_init_stealing(4, 0);
+    tb_assert_and_check_return(g_spawn_pool);
+
+    // the total tasks count of each root task
+    tb_size_t i = 0;
+    tb_size_t n = 1;
+    tb_size_t total = 0;
+    for (i = 0; i <= TB_DEMO_SPAWN_DEPTH; i++, n *= TB_DEMO_SPAWN_FANOUT) total += n;
+
+    // post the root tasks from the main thread and wait them
+    tb_hong_t time = tb_mclock();
+    for (i = 0; i < TB_DEMO_SPAWN_ROOTN; i++)
+        tb_thread_pool_task_post(g_spawn_pool, "root", tb_demo_task_spawn_done, tb_null, tb_u2p(TB_DEMO_SPAWN_DEPTH), tb_false);
+    tb_long_t wait = tb_thread_pool_task_wait_all(g_spawn_pool, -1);
+    time = tb_mclock() - time;
+
+    // trace
+    tb_size_t done = (tb_size_t)tb_atomic_get(&g_spawn_done);
+    tb_trace_i("stealing: wait: %ld, done: %lu, total: %lu, workers: %lu, time: %lld ms", wait, done, total * TB_DEMO_SPAWN_ROOTN, tb_thread_pool_worker_size(g_spawn_pool), time);
+    if (done != total * TB_DEMO_SPAWN_ROOTN) tb_trace_e("stealing: some tasks have been lost!");
+
+    // post them again and kill them
+    for (i = 0; i < TB_DEMO_SPAWN_ROOTN; i++)
+        tb_thread_pool_task_post(g_spawn_pool, "root", tb_demo_task_spawn_done, tb_null, tb_u2p(TB_DEMO_SPAWN_DEPTH), tb_false);
+    tb_thread_pool_task_kill_all(g_spawn_pool);
+    wait = tb_thread_pool_task_wait_all(g_spawn_pool, -1);
+
+    // trace
+    tb_trace_i("stealing: killed: wait: %ld, done: %lu, left: %lu", wait, (tb_size_t)tb_atomic_get(&g_spawn_done) - done, tb_thread_pool_task_size(g_spawn_pool));
+
+#ifdef __tb_debug__
+    // dump it
+    tb_thread_pool_dump(g_spawn_pool);
+#endif
+
+    // exit it
+    tb_thread_pool_exit(g_spawn_pool);
+    g_spawn_pool = tb_null;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_platform_thread_pool_main(tb_int_t argc, tb_char_t** argv)
 {
+    // test the work-stealing mode
+    if (argc > 1 && !tb_strcmp(argv[1], "--stealing"))
+    {
+        tb_demo_thread_pool_stealing();
+        return 0;
+    }
+
 #if 0
     // post task: 60s
     tb_thread_pool_task_post(tb_thread_pool(), "60000ms", tb_demo_task_time_done, tb_null, (tb_cpointer_t)60000, tb_false);
@@ -20,11 +20,129 @@ static tb_void_t tb_demo_timer_task_func(tb_bool_t killed, tb_cpointer_t priv)
     }
 }
 
+static tb_void_t tb_demo_timer_bench_func(tb_bool_t killed, tb_cpointer_t priv)
+{
+    // the fired count
+    (*((tb_size_t*)priv))++;
+}
+static tb_void_t tb_demo_timer_bench(tb_size_t count)
+{
+    // init timer
+    tb_timer_ref_t timer = tb_timer_init(count, tb_false);
+    tb_assert_and_check_return(timer);
+
+    // init tasks
+    tb_timer_task_ref_t* tasks = tb_nalloc0_type(count, tb_timer_task_ref_t);
+    tb_assert_and_check_return(tasks);
+
+    // post tasks with the random delay: [1s, 60s)
+    tb_size_t i = 0;
+    tb_size_t fired = 0;
+    tb_hong_t time = tb_mclock();
+    for (i = 0; i < count; i++) tasks[i] = tb_timer_task_init(timer, tb_random_range(1000, 60000), tb_false, tb_demo_timer_bench_func, &fired);
+    time = tb_mclock() - time;
+    tb_trace_i("timer: post: %lu tasks, %lld ms", count, time);
+
+    // kill some tasks
+    tb_size_t killn = tb_min(count, 10000);
+    time = tb_mclock();
+    for (i = 0; i < killn; i++) if (tasks[i]) tb_timer_task_kill(timer, tasks[i]);
+    time = tb_mclock() - time;
+    tb_trace_i("timer: kill: %lu tasks, %lld ms", killn, time);
+
+    // cancel tasks
+    time = tb_mclock();
+    for (i = 0; i < count; i++) if (tasks[i]) tb_timer_task_exit(timer, tasks[i]);
+    time = tb_mclock() - time;
+    tb_trace_i("timer: cancel: %lu tasks, %lld ms", count, time);
+
+    // post tasks with the random delay: [0, 1s) and expire them
+    time = tb_mclock();
+    for (i = 0; i < count; i++) tb_timer_task_post(timer, tb_random_range(0, 1000), tb_false, tb_demo_timer_bench_func, &fired);
+    while (fired < count) 
+    {
+        tb_size_t delay = tb_timer_delay(timer);
+        if (delay && delay != (tb_size_t)-1) tb_msleep(delay);
+        tb_timer_spak(timer);
+    }
+    time = tb_mclock() - time;
+    tb_trace_i("timer: expire: %lu tasks, %lld ms", count, time);
+
+    // exit tasks
+    tb_free(tasks);
+
+    // exit timer
+    tb_timer_exit(timer);
+}
+static tb_void_t tb_demo_ltimer_bench_func(tb_bool_t killed, tb_cpointer_t priv)
+{
+    // the fired count
+    (*((tb_size_t*)priv))++;
+}
+static tb_void_t tb_demo_ltimer_bench(tb_size_t count)
+{
+    // init timer
+    tb_ltimer_ref_t timer = tb_ltimer_init(count, TB_LTIMER_TICK_100MS, tb_false);
+    tb_assert_and_check_return(timer);
+
+    // init tasks
+    tb_ltimer_task_ref_t* tasks = tb_nalloc0_type(count, tb_ltimer_task_ref_t);
+    tb_assert_and_check_return(tasks);
+
+    // post tasks with the random delay: [1s, 60s)
+    tb_size_t i = 0;
+    tb_size_t fired = 0;
+    tb_hong_t time = tb_mclock();
+    for (i = 0; i < count; i++) tasks[i] = tb_ltimer_task_init(timer, tb_random_range(1000, 60000), tb_false, tb_demo_ltimer_bench_func, &fired);
+    time = tb_mclock() - time;
+    tb_trace_i("ltimer: post: %lu tasks, %lld ms", count, time);
+
+    // kill some tasks
+    tb_size_t killn = tb_min(count, 10000);
+    time = tb_mclock();
+    for (i = 0; i < killn; i++) if (tasks[i]) tb_ltimer_task_kill(timer, tasks[i]);
+    time = tb_mclock() - time;
+    tb_trace_i("ltimer: kill: %lu tasks, %lld ms", killn, time);
+
+    // cancel tasks
+    time = tb_mclock();
+    for (i = 0; i < count; i++) if (tasks[i]) tb_ltimer_task_exit(timer, tasks[i]);
+    time = tb_mclock() - time;
+    tb_trace_i("ltimer: cancel: %lu tasks, %lld ms", count, time);
+
+    // post tasks with the random delay: [0, 1s) and expire them
+    time = tb_mclock();
+    for (i = 0; i < count; i++) tb_ltimer_task_post(timer, tb_random_range(0, 1000), tb_false, tb_demo_ltimer_bench_func, &fired);
+    while (fired < count) 
+    {
+        tb_size_t delay = tb_ltimer_delay(timer);
+        if (delay && delay != (tb_size_t)-1) tb_msleep(delay);
+        tb_ltimer_spak(timer);
+    }
+    time = tb_mclock() - time;
+    tb_trace_i("ltimer: expire: %lu tasks, %lld ms", count, time);
+
+    // exit tasks
+    tb_free(tasks);
+
+    // exit timer
+    tb_ltimer_exit(timer);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_platform_timer_main(tb_int_t argc, tb_char_t** argv)
 {
+    // bench: post, cancel and expire tasks
+    if (argc > 1 && !tb_strcmp(argv[1], "--bench"))
+    {
+        tb_size_t count = argc > 2? tb_atoi(argv[2]) : 1000000;
+        tb_demo_timer_bench(count);
+        tb_demo_ltimer_bench(count);
+        return 0;
+    }
+
     // add task: every
     tb_timer_task_post(tb_timer(), 1000, tb_true, tb_demo_timer_task_func, "every");
 
@@ -35,9 +35,9 @@ target("demo")
     add_files("utils/*.c|option.c") 
     add_files("other/*.c|charset.c") 
     add_files("string/*.c") 
-    add_files("memory/**.c") 
+    add_files("memory/**.c|benchmark.c") 
     add_files("platform/*.c|thread*.c|semaphore.c|event.c|lock.c|timer.c|ltimer.c|exception.c") 
-    add_files("container/*.c") 
+    add_files("container/*.c|mpmc_queue.c|concurrent_hash_map.c") 
     add_files("algorithm/*.c") 
     add_files("stream/stream.c") 
     add_files("stream/stream/*.c") 
@@ -63,6 +63,9 @@ target("demo")
         add_files("platform/ltimer.c") 
         add_files("platform/exception.c") 
         add_files("platform/semaphore.c") 
+        add_files("memory/benchmark.c") 
+        add_files("container/mpmc_queue.c")
+        add_files("container/concurrent_hash_map.c") 
     end
 
     -- add the source files for the xml module
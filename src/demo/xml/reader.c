@@ -3,11 +3,103 @@
  */ 
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * bench
+ */ 
+static tb_size_t tb_demo_xml_reader_bench_done(tb_char_t const* url, tb_bool_t slice, tb_hize_t* psize)
+{
+    // init reader
+    tb_size_t           count = 0;
+    tb_xml_reader_ref_t reader = tb_xml_reader_init();
+    if (reader)
+    {
+        // open reader
+        if (tb_xml_reader_open(reader, tb_stream_init_from_url(url), tb_true))
+        {
+            // walk
+            tb_size_t event = TB_XML_READER_EVENT_NONE;
+            while ((event = tb_xml_reader_next(reader)))
+            {
+                switch (event)
+                {
+                case TB_XML_READER_EVENT_ELEMENT_EMPTY: 
+                case TB_XML_READER_EVENT_ELEMENT_BEG: 
+                    {
+                        if (slice)
+                        {
+                            tb_size_t       itor = 0;
+                            tb_xml_slice_t  name;
+                            tb_xml_slice_t  data;
+                            if (tb_xml_reader_element_slice(reader, &name)) count++;
+                            while (tb_xml_reader_attribute_slice(reader, &itor, &name, &data)) count++;
+                        }
+                        else
+                        {
+                            if (tb_xml_reader_element(reader)) count++;
+                            tb_xml_node_ref_t attr = tb_xml_reader_attributes(reader);
+                            for (; attr; attr = attr->next) count++;
+                        }
+                    }
+                    break;
+                case TB_XML_READER_EVENT_TEXT: 
+                    {
+                        if (slice)
+                        {
+                            tb_xml_slice_t text;
+                            if (tb_xml_reader_text_slice(reader, &text)) count++;
+                        }
+                        else if (tb_xml_reader_text(reader)) count++;
+                    }
+                    break;
+                default:
+                    count++;
+                    break;
+                }
+            }
+
+            // the stream size
+            if (psize) *psize = tb_stream_offset(tb_xml_reader_stream(reader));
+        }
+
+        // exit reader
+        tb_xml_reader_exit(reader);
+    }
+
+    // ok
+    return count;
+}
+static tb_void_t tb_demo_xml_reader_bench(tb_char_t const* url)
+{
+    // done
+    tb_size_t i = 0;
+    for (i = 0; i < 2; i++)
+    {
+        // read all nodes
+        tb_hize_t size = 0;
+        tb_hong_t time = tb_mclock();
+        tb_size_t count = tb_demo_xml_reader_bench_done(url, i? tb_true : tb_false, &size);
+        time = tb_mclock() - time;
+
+        // trace
+        tb_trace_i("%s: %lu nodes, %llu bytes, %lld ms, %lld MB/s", i? "slice" : "cstr", count, size, time, time > 0? (tb_hong_t)((size * 1000) / (time << 20)) : 0);
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_xml_reader_main(tb_int_t argc, tb_char_t** argv)
 {
+    // check
+    tb_assert_and_check_return_val(argc > 1 && argv[1], 0);
+
+    // bench it? compare the c-string and slice interfaces
+    if (argc > 2 && !tb_strcmp(argv[1], "--bench")) 
+    {
+        tb_demo_xml_reader_bench(argv[2]);
+        return 0;
+    }
+
     // init reader
     tb_xml_reader_ref_t reader = tb_xml_reader_init();
     if (reader)
@@ -37,6 +37,8 @@
 #include "sort.h"
 #include "heap_sort.h"
 #include "quick_sort.h"
+#include "radix_sort.h"
+#include "parallel_sort.h"
 #include "insert_sort.h"
 #include "bubble_sort.h"
 #include "find.h"
@@ -0,0 +1,437 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        parallel_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "parallel_sort.h"
+#include "sort.h"
+#include "quick_sort.h"
+#include "../libc/libc.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum items count of each part
+#ifdef __tb_small__
+#   define TB_PARALLEL_SORT_PART_MINN       (4096)
+#else
+#   define TB_PARALLEL_SORT_PART_MINN       (16384)
+#endif
+
+// the maximum parts count
+#define TB_PARALLEL_SORT_PART_MAXN          (64)
+
+#ifdef TB_CONFIG_MODULE_HAVE_THREAD
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the parallel sort job type
+ *
+ * sort: sort the items of [head, tail)
+ * merge: merge [head, midd) and [midd, tail) and output the merged items of [head + ohead, head + otail)
+ */
+typedef struct __tb_parallel_sort_job_t
+{
+    // the head
+    tb_size_t               head;
+
+    // the midd
+    tb_size_t               midd;
+
+    // the tail
+    tb_size_t               tail;
+
+    // the output head, relative to the head
+    tb_size_t               ohead;
+
+    // the output tail, relative to the head
+    tb_size_t               otail;
+
+}tb_parallel_sort_job_t;
+
+// the parallel sort round type, all jobs of one round are done by the caller and the posted tasks
+typedef struct __tb_parallel_sort_round_t
+{
+    // the reference count of the caller and the posted tasks
+    tb_atomic_t             refn;
+
+    // the next job index
+    tb_atomic_t             next;
+
+    // the finished jobs count
+    tb_atomic_t             done;
+
+    // the semaphore for waiting the last job
+    tb_semaphore_ref_t      semaphore;
+
+    // the iterator
+    tb_iterator_ref_t       iterator;
+
+    // the comparer
+    tb_iterator_comp_t      comp;
+
+    // the iterator head of the sorted items
+    tb_size_t               head;
+
+    // the step
+    tb_size_t               step;
+
+    // the source items for merging 
+    tb_byte_t const*        isrc;
+
+    // the dest items for merging, only sort the parts of the iterator if be null
+    tb_byte_t*              idst;
+
+    // the jobs count
+    tb_size_t               jobs_size;
+
+    // the jobs
+    tb_parallel_sort_job_t  jobs[1];
+
+}tb_parallel_sort_round_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_long_t tb_parallel_sort_comp(tb_parallel_sort_round_t* round, tb_size_t litor, tb_size_t ritor)
+{
+    // the iterator
+    tb_iterator_ref_t iterator = round->iterator;
+
+    // compare the source items
+    return round->comp(iterator, iterator->load(iterator, round->isrc + litor * round->step), iterator->load(iterator, round->isrc + ritor * round->step));
+}
+static tb_size_t tb_parallel_sort_rank(tb_parallel_sort_round_t* round, tb_parallel_sort_job_t const* job, tb_size_t rank)
+{
+    /* find the left items count in the first rank merged items
+     *
+     * the left item is merged first if it is equal to the right item
+     */
+    tb_size_t lsize = job->midd - job->head;
+    tb_size_t rsize = job->tail - job->midd;
+    tb_size_t l = rank > rsize? rank - rsize : 0;
+    tb_size_t r = tb_min(rank, lsize);
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (tb_parallel_sort_comp(round, job->head + m, job->midd + rank - m - 1) <= 0) l = m + 1;
+        else r = m;
+    }
+    return l;
+}
+static tb_void_t tb_parallel_sort_merge(tb_parallel_sort_round_t* round, tb_parallel_sort_job_t const* job)
+{
+    // the left and right ranges of the output items
+    tb_size_t lhead = job->head + tb_parallel_sort_rank(round, job, job->ohead);
+    tb_size_t ltail = job->head + tb_parallel_sort_rank(round, job, job->otail);
+    tb_size_t rhead = job->midd + job->ohead - (lhead - job->head);
+    tb_size_t rtail = job->midd + job->otail - (ltail - job->head);
+
+    // merge them
+    tb_size_t           step = round->step;
+    tb_byte_t const*    isrc = round->isrc;
+    tb_byte_t*          odst = round->idst + (job->head + job->ohead) * step;
+    while (lhead < ltail && rhead < rtail)
+    {
+        if (tb_parallel_sort_comp(round, lhead, rhead) <= 0) tb_memcpy(odst, isrc + lhead++ * step, step);
+        else tb_memcpy(odst, isrc + rhead++ * step, step);
+        odst += step;
+    }
+
+    // copy the left items
+    if (lhead < ltail) 
+    {
+        tb_memcpy(odst, isrc + lhead * step, (ltail - lhead) * step);
+        odst += (ltail - lhead) * step;
+    }
+    if (rhead < rtail) tb_memcpy(odst, isrc + rhead * step, (rtail - rhead) * step);
+}
+static tb_bool_t tb_parallel_sort_round_loop(tb_parallel_sort_round_t* round)
+{
+    // do the left jobs
+    tb_bool_t   last = tb_false;
+    tb_size_t   index = 0;
+    while ((index = (tb_size_t)tb_atomic_fetch_and_inc(&round->next)) < round->jobs_size)
+    {
+        // done job
+        tb_parallel_sort_job_t const* job = &round->jobs[index];
+        if (round->idst) tb_parallel_sort_merge(round, job);
+        else tb_quick_sort(round->iterator, round->head + job->head, round->head + job->tail, round->comp);
+
+        // the last finished job?
+        if ((tb_size_t)tb_atomic_inc_and_fetch(&round->done) == round->jobs_size) last = tb_true;
+    }
+
+    // is the last?
+    return last;
+}
+static tb_parallel_sort_round_t* tb_parallel_sort_round_init(tb_iterator_ref_t iterator, tb_size_t head, tb_iterator_comp_t comp, tb_size_t jobs_size)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_parallel_sort_round_t*   round = tb_null;
+    do
+    {
+        // make round
+        round = (tb_parallel_sort_round_t*)tb_malloc0(sizeof(tb_parallel_sort_round_t) + (jobs_size - 1) * sizeof(tb_parallel_sort_job_t));
+        tb_assert_and_check_break(round);
+
+        // init round
+        round->refn         = 1;
+        round->iterator     = iterator;
+        round->comp         = comp;
+        round->head         = head;
+        round->step         = tb_iterator_step(iterator);
+        round->jobs_size    = jobs_size;
+
+        // init semaphore
+        round->semaphore = tb_semaphore_init(0);
+        tb_assert_and_check_break(round->semaphore);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (round) tb_free(round);
+        round = tb_null;
+    }
+
+    // ok?
+    return round;
+}
+static tb_void_t tb_parallel_sort_round_exit(tb_parallel_sort_round_t* round)
+{
+    // the last reference? exit it
+    if (tb_atomic_fetch_and_dec(&round->refn) == 1)
+    {
+        // exit semaphore
+        if (round->semaphore) tb_semaphore_exit(round->semaphore);
+        round->semaphore = tb_null;
+
+        // exit it
+        tb_free(round);
+    }
+}
+static tb_void_t tb_parallel_sort_task_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // the round
+    tb_parallel_sort_round_t* round = (tb_parallel_sort_round_t*)priv;
+    tb_assert_and_check_return(round);
+
+    // do jobs and notify the caller if the last job is finished here
+    if (tb_parallel_sort_round_loop(round)) tb_semaphore_post(round->semaphore, 1);
+}
+static tb_void_t tb_parallel_sort_task_exit(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // the round
+    tb_parallel_sort_round_t* round = (tb_parallel_sort_round_t*)priv;
+    tb_assert_and_check_return(round);
+
+    // exit it
+    tb_parallel_sort_round_exit(round);
+}
+static tb_void_t tb_parallel_sort_round_done(tb_parallel_sort_round_t* round, tb_thread_pool_ref_t pool, tb_size_t tasks)
+{
+    // post tasks
+    tb_size_t i = 0;
+    for (i = 0; i < tasks && i + 1 < round->jobs_size; i++)
+    {
+        tb_atomic_fetch_and_inc(&round->refn);
+        if (!tb_thread_pool_task_post(pool, "parallel_sort", tb_parallel_sort_task_done, tb_parallel_sort_task_exit, round, tb_false))
+        {
+            tb_atomic_fetch_and_dec(&round->refn);
+            break;
+        }
+    }
+
+    /* do jobs in the current thread too, 
+     *
+     * all jobs may be done here if the workers are busy, 
+     * so the posted tasks will do nothing and it will not be deadlocked if be called in the worker
+     */
+    if (!tb_parallel_sort_round_loop(round)) 
+    {
+        // wait the last job of the other workers
+        while ((tb_size_t)tb_atomic_get(&round->done) < round->jobs_size)
+        {
+            if (tb_semaphore_wait(round->semaphore, -1) < 0) tb_msleep(1);
+        }
+    }
+
+    // exit round
+    tb_parallel_sort_round_exit(round);
+}
+static tb_bool_t tb_parallel_sort_done(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
+{
+    // the contiguous items only
+    tb_byte_t* data = (tb_byte_t*)tb_iterator_buff(iterator);
+    tb_check_return_val(data, tb_false);
+
+    // the parts count
+    tb_size_t count = tail - head;
+    tb_size_t parts = tb_min(tb_processor_count(), count / TB_PARALLEL_SORT_PART_MINN);
+    if (parts > TB_PARALLEL_SORT_PART_MAXN) parts = TB_PARALLEL_SORT_PART_MAXN;
+    tb_check_return_val(parts > 1, tb_false);
+
+    // the thread pool
+    tb_thread_pool_ref_t pool = tb_thread_pool();
+    tb_check_return_val(pool, tb_false);
+
+    // the comparer
+    if (!comp) comp = tb_iterator_comp;
+
+    // done
+    tb_bool_t   ok = tb_false;
+    tb_size_t   step = tb_iterator_step(iterator);
+    tb_byte_t*  temp = tb_null;
+    tb_size_t   bounds[TB_PARALLEL_SORT_PART_MAXN + 1];
+    do
+    {
+        // make the temp items for merging
+        temp = (tb_byte_t*)tb_malloc(count * step);
+        tb_check_break(temp);
+
+        // init the sort round
+        tb_parallel_sort_round_t* round = tb_parallel_sort_round_init(iterator, head, comp, parts);
+        tb_check_break(round);
+
+        // init the parts
+        tb_size_t i = 0;
+        for (i = 0; i <= parts; i++) bounds[i] = (count / parts) * i + tb_min(i, count % parts);
+        for (i = 0; i < parts; i++)
+        {
+            round->jobs[i].head = bounds[i];
+            round->jobs[i].tail = bounds[i + 1];
+        }
+
+        // sort the parts
+        tb_parallel_sort_round_done(round, pool, parts - 1);
+
+        // merge the parts
+        tb_size_t   runs = parts;
+        tb_byte_t*  isrc = data + head * step;
+        tb_byte_t*  idst = temp;
+        while (runs > 1)
+        {
+            // split each merging of two runs to some jobs for using all workers
+            tb_size_t pairs = runs >> 1;
+            tb_size_t jobs = tb_max(parts / pairs, 1);
+
+            // init the merge round
+            round = tb_parallel_sort_round_init(iterator, head, comp, pairs * jobs + (runs & 1));
+            tb_check_break(round);
+            round->isrc = isrc;
+            round->idst = idst;
+
+            // init jobs
+            tb_size_t j = 0;
+            tb_parallel_sort_job_t* job = round->jobs;
+            for (i = 0; i < pairs; i++)
+            {
+                tb_size_t size = bounds[(i << 1) + 2] - bounds[i << 1];
+                for (j = 0; j < jobs; j++, job++)
+                {
+                    job->head   = bounds[i << 1];
+                    job->midd   = bounds[(i << 1) + 1];
+                    job->tail   = bounds[(i << 1) + 2];
+                    job->ohead  = (size / jobs) * j + tb_min(j, size % jobs);
+                    job->otail  = (size / jobs) * (j + 1) + tb_min(j + 1, size % jobs);
+                }
+            }
+
+            // copy the last odd run
+            if (runs & 1)
+            {
+                job->head   = bounds[runs - 1];
+                job->midd   = bounds[runs];
+                job->tail   = bounds[runs];
+                job->ohead  = 0;
+                job->otail  = job->tail - job->head;
+            }
+
+            // merge them
+            tb_parallel_sort_round_done(round, pool, parts - 1);
+
+            // update the runs
+            for (i = 0; i < pairs; i++) bounds[i] = bounds[i << 1];
+            if (runs & 1) bounds[i++] = bounds[runs - 1];
+            bounds[i] = count;
+            runs = i;
+
+            // swap the source and dest
+            tb_swap(tb_byte_t*, isrc, idst);
+        }
+
+        // the merged items are at the temp? copy them back
+        if (isrc != data + head * step) tb_memcpy(data + head * step, isrc, count * step);
+
+        // ok?
+        ok = runs == 1;
+
+    } while (0);
+
+    // exit the temp items
+    if (temp) tb_free(temp);
+
+    // ok?
+    return ok;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_parallel_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(iterator);
+
+    // no elements?
+    tb_check_return(head != tail);
+
+    // readonly?
+    tb_assert_and_check_return(!(tb_iterator_mode(iterator) & TB_ITERATOR_MODE_READONLY));
+
+#ifdef TB_CONFIG_MODULE_HAVE_THREAD
+    // sort the contiguous items in parallel
+    if ((tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) && tb_parallel_sort_done(iterator, head, tail, comp)) return ;
+#endif
+
+    // sort them in the current thread
+    if (tb_iterator_buff(iterator)) tb_quick_sort(iterator, head, tail, comp);
+    else tb_sort(iterator, head, tail, comp);
+}
+tb_void_t tb_parallel_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp)
+{
+    tb_parallel_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), comp);
+}
@@ -0,0 +1,66 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        parallel_sort.h
+ * @ingroup     algorithm
+ *
+ */
+#ifndef TB_ALGORITHM_PARALLEL_SORT_H
+#define TB_ALGORITHM_PARALLEL_SORT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the parallel sorter, O(nlog(n)/p + n)
+ *
+ * sort the parts of the contiguous items on the thread pool and merge them,
+ * it is the same as tb_sort() if the items are not contiguous or the thread module is disabled.
+ *
+ * @note the comparer will be called in the worker threads 
+ *
+ * @param iterator  the iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ * @param comp      the comparer
+ */
+tb_void_t           tb_parallel_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp);
+
+/*! the parallel sorter for all
+ *
+ * @param iterator  the iterator
+ * @param comp      the comparer
+ */
+tb_void_t           tb_parallel_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -26,8 +26,196 @@
  * includes
  */
 #include "quick_sort.h"
+#include "heap_sort.h"
 #include "../libc/libc.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the insertion sort threshold for the contiguous items
+#define TB_QUICK_SORT_BUFF_INSERT_MAXN      (16)
+
+// the slot of the contiguous items
+#define tb_quick_sort_buff_slot(data, itor, step)     ((data) + (itor) * (step))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the quick sorter type for the contiguous items
+typedef struct __tb_quick_sort_buff_t
+{
+    // the iterator
+    tb_iterator_ref_t       iterator;
+
+    // the comparer
+    tb_iterator_comp_t      comp;
+
+    // the items buffer
+    tb_byte_t*              data;
+
+    // the step
+    tb_size_t               step;
+
+    // the pivot key
+    tb_byte_t*              key;
+
+    // the swap temp
+    tb_byte_t*              temp;
+
+}tb_quick_sort_buff_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_long_t tb_quick_sort_buff_comp(tb_quick_sort_buff_t* sorter, tb_cpointer_t lslot, tb_cpointer_t rslot)
+{
+    return sorter->comp(sorter->iterator, sorter->iterator->load(sorter->iterator, lslot), sorter->iterator->load(sorter->iterator, rslot));
+}
+static __tb_inline__ tb_void_t tb_quick_sort_buff_swap(tb_quick_sort_buff_t* sorter, tb_byte_t* lslot, tb_byte_t* rslot)
+{
+    // swap the pointer slots
+    if (sorter->step == sizeof(tb_pointer_t))
+    {
+        tb_pointer_t temp = *((tb_pointer_t*)lslot);
+        *((tb_pointer_t*)lslot) = *((tb_pointer_t*)rslot);
+        *((tb_pointer_t*)rslot) = temp;
+    }
+    // swap the other slots
+    else
+    {
+        tb_memcpy(sorter->temp, lslot, sorter->step);
+        tb_memcpy(lslot, rslot, sorter->step);
+        tb_memcpy(rslot, sorter->temp, sorter->step);
+    }
+}
+static tb_void_t tb_quick_sort_buff_insert(tb_quick_sort_buff_t* sorter, tb_size_t head, tb_size_t tail)
+{
+    // init
+    tb_byte_t*  data = sorter->data;
+    tb_size_t   step = sorter->step;
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    for (i = head + 1; i < tail; i++)
+    {
+        // find the hole of the key
+        tb_byte_t* slot = tb_quick_sort_buff_slot(data, i, step);
+        j = i;
+        while (j > head && tb_quick_sort_buff_comp(sorter, slot, tb_quick_sort_buff_slot(data, j - 1, step)) < 0) j--;
+
+        // no moving?
+        tb_check_continue(j != i);
+
+        // key => hole, move the items between them
+        tb_memcpy(sorter->key, slot, step);
+        tb_memmov(tb_quick_sort_buff_slot(data, j + 1, step), tb_quick_sort_buff_slot(data, j, step), (i - j) * step);
+        tb_memcpy(tb_quick_sort_buff_slot(data, j, step), sorter->key, step);
+    }
+}
+static tb_size_t tb_quick_sort_buff_partition(tb_quick_sort_buff_t* sorter, tb_size_t head, tb_size_t tail)
+{
+    // init
+    tb_byte_t*  data = sorter->data;
+    tb_size_t   step = sorter->step;
+    tb_byte_t*  l = tb_quick_sort_buff_slot(data, head, step);
+    tb_byte_t*  m = tb_quick_sort_buff_slot(data, head + ((tail - head) >> 1), step);
+    tb_byte_t*  r = tb_quick_sort_buff_slot(data, tail - 1, step);
+
+    // the median of three: l <= m <= r
+    if (tb_quick_sort_buff_comp(sorter, m, l) < 0) tb_quick_sort_buff_swap(sorter, m, l);
+    if (tb_quick_sort_buff_comp(sorter, r, m) < 0) 
+    {
+        tb_quick_sort_buff_swap(sorter, r, m);
+        if (tb_quick_sort_buff_comp(sorter, m, l) < 0) tb_quick_sort_buff_swap(sorter, m, l);
+    }
+
+    // the pivot key
+    tb_memcpy(sorter->key, m, step);
+
+    // partition it, the median of three has bounded both sides
+    l += step;
+    r -= step;
+    while (1)
+    {
+        while (tb_quick_sort_buff_comp(sorter, l, sorter->key) < 0) l += step;
+        while (tb_quick_sort_buff_comp(sorter, sorter->key, r) < 0) r -= step;
+        tb_check_break(l < r);
+
+        // swap and next
+        tb_quick_sort_buff_swap(sorter, l, r);
+        l += step;
+        r -= step;
+    }
+
+    // [head, hole) <= key <= [hole, tail)
+    return (l - data) / step;
+}
+static tb_void_t tb_quick_sort_buff_done(tb_quick_sort_buff_t* sorter, tb_size_t head, tb_size_t tail, tb_size_t depth)
+{
+    // sort the larger part in loop and the smaller part recursively, the stack depth is O(log(n))
+    while (tail - head > TB_QUICK_SORT_BUFF_INSERT_MAXN)
+    {
+        // too deep? using the heap sort for the worst case
+        if (!depth--) 
+        {
+            tb_heap_sort(sorter->iterator, head, tail, sorter->comp);
+            return ;
+        }
+
+        // partition it
+        tb_size_t hole = tb_quick_sort_buff_partition(sorter, head, tail);
+        if (hole - head < tail - hole)
+        {
+            tb_quick_sort_buff_done(sorter, head, hole, depth);
+            head = hole;
+        }
+        else
+        {
+            tb_quick_sort_buff_done(sorter, hole, tail, depth);
+            tail = hole;
+        }
+    }
+
+    // sort the small part
+    tb_quick_sort_buff_insert(sorter, head, tail);
+}
+static tb_bool_t tb_quick_sort_buff(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
+{
+    // the items buffer
+    tb_byte_t* data = (tb_byte_t*)tb_iterator_buff(iterator);
+    tb_check_return_val(data, tb_false);
+
+    // init the key and temp
+    tb_size_t           step = tb_iterator_step(iterator);
+    tb_size_t           cache[16];
+    tb_byte_t*          buff = step <= (sizeof(cache) >> 1)? (tb_byte_t*)cache : (tb_byte_t*)tb_malloc(step << 1);
+    tb_assert_and_check_return_val(buff && step, tb_false);
+
+    // init sorter
+    tb_quick_sort_buff_t sorter;
+    sorter.iterator = iterator;
+    sorter.comp     = comp? comp : tb_iterator_comp;
+    sorter.data     = data;
+    sorter.step     = step;
+    sorter.key      = buff;
+    sorter.temp     = buff + step;
+
+    // limit the depth to 2 * log2(n)
+    tb_size_t depth = 0;
+    tb_size_t count = tail - head;
+    for (; count; count >>= 1) depth += 2;
+
+    // done
+    tb_quick_sort_buff_done(&sorter, head, tail, depth);
+
+    // exit the key and temp
+    if (buff != (tb_byte_t*)cache) tb_free(buff);
+
+    // ok
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -37,6 +225,9 @@ tb_void_t tb_quick_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t ta
     tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
     tb_check_return(head != tail);
 
+    // the contiguous items? sort them directly 
+    if (tb_quick_sort_buff(iterator, head, tail, comp)) return ;
+
     // init
     tb_size_t       step = tb_iterator_step(iterator);
     tb_pointer_t    key = step > sizeof(tb_pointer_t)? tb_malloc(step) : tb_null;
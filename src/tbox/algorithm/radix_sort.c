@@ -0,0 +1,313 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        radix_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "radix_sort.h"
+#include "sort.h"
+#include "quick_sort.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the insertion sort threshold for the strings
+#define TB_RADIX_SORT_STR_INSERT_MAXN       (32)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_hize_t tb_radix_sort_uint_key(tb_byte_t const* slot, tb_size_t step)
+{
+    switch (step)
+    {
+    case 1: return *slot;
+    case 2: return *((tb_uint16_t const*)slot);
+    case 4: return *((tb_uint32_t const*)slot);
+    default: return *((tb_hize_t const*)slot);
+    }
+}
+static __tb_inline__ tb_void_t tb_radix_sort_uint_copy(tb_byte_t* dslot, tb_byte_t const* sslot, tb_size_t step)
+{
+    switch (step)
+    {
+    case 1: *dslot = *sslot; break;
+    case 2: *((tb_uint16_t*)dslot) = *((tb_uint16_t const*)sslot); break;
+    case 4: *((tb_uint32_t*)dslot) = *((tb_uint32_t const*)sslot); break;
+    default: *((tb_hize_t*)dslot) = *((tb_hize_t const*)sslot); break;
+    }
+}
+static tb_bool_t tb_radix_sort_uint(tb_byte_t* data, tb_size_t count, tb_size_t step, tb_bool_t bsigned)
+{
+    // make the digit counts of all bytes and the temp items
+    tb_size_t* counts = (tb_size_t*)tb_malloc0((step << 8) * sizeof(tb_size_t) + count * step);
+    tb_assert_and_check_return_val(counts, tb_false);
+
+    // flip the sign bit for the signed integers, the negative numbers will be at the front
+    tb_hize_t sign = bsigned? ((tb_hize_t)1 << ((step << 3) - 1)) : 0;
+
+    // count the digits of all bytes in one pass
+    tb_size_t   i = 0;
+    tb_size_t   d = 0;
+    tb_byte_t*  p = data;
+    for (i = 0; i < count; i++, p += step)
+    {
+        tb_hize_t key = tb_radix_sort_uint_key(p, step) ^ sign;
+        for (d = 0; d < step; d++) counts[(d << 8) + (tb_size_t)((key >> (d << 3)) & 0xff)]++;
+    }
+
+    // sort them by the digit of each byte from the lowest byte
+    tb_byte_t* isrc = data;
+    tb_byte_t* idst = (tb_byte_t*)(counts + (step << 8));
+    for (d = 0; d < step; d++)
+    {
+        // the digit counts of this byte
+        tb_size_t*  heads = counts + (d << 8);
+        tb_size_t   shift = d << 3;
+
+        // all items have the same digit? skip this byte
+        if (heads[(tb_size_t)(((tb_radix_sort_uint_key(isrc, step) ^ sign) >> shift) & 0xff)] == count) continue;
+
+        // the counts => the heads
+        tb_size_t sum = 0;
+        for (i = 0; i < 256; i++)
+        {
+            tb_size_t n = heads[i];
+            heads[i] = sum;
+            sum += n;
+        }
+
+        // distribute the items
+        for (i = 0, p = isrc; i < count; i++, p += step)
+        {
+            tb_size_t digit = (tb_size_t)(((tb_radix_sort_uint_key(p, step) ^ sign) >> shift) & 0xff);
+            tb_radix_sort_uint_copy(idst + heads[digit]++ * step, p, step);
+        }
+
+        // swap the source and dest
+        tb_swap(tb_byte_t*, isrc, idst);
+    }
+
+    // the sorted items are at the temp? copy them back
+    if (isrc != data) tb_memcpy(data, isrc, count * step);
+
+    // exit counts and temp
+    tb_free(counts);
+
+    // ok
+    return tb_true;
+}
+static __tb_inline__ tb_size_t tb_radix_sort_str_digit(tb_char_t const* s, tb_size_t depth)
+{
+    // the null string is empty
+    return s? (tb_byte_t)s[depth] : 0;
+}
+static __tb_inline__ tb_long_t tb_radix_sort_str_comp(tb_char_t const* l, tb_char_t const* r, tb_size_t depth)
+{
+    // the null string is empty
+    tb_byte_t const* pl = (tb_byte_t const*)(l? l + depth : "");
+    tb_byte_t const* pr = (tb_byte_t const*)(r? r + depth : "");
+
+    // compare them from the depth, the front characters are all equal
+    for (; *pl && *pl == *pr; pl++, pr++) ;
+    return (tb_long_t)*pl - (tb_long_t)*pr;
+}
+static tb_void_t tb_radix_sort_str_insert(tb_char_t const** data, tb_size_t count, tb_size_t depth)
+{
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (i = 1; i < count; i++)
+    {
+        tb_char_t const* key = data[i];
+        for (j = i; j > 0 && tb_radix_sort_str_comp(key, data[j - 1], depth) < 0; j--) data[j] = data[j - 1];
+        data[j] = key;
+    }
+}
+static tb_void_t tb_radix_sort_str_done(tb_char_t const** data, tb_char_t const** temp, tb_size_t count, tb_size_t depth)
+{
+    /* sort the largest bucket in loop and the other buckets recursively, 
+     * the other buckets are not larger than the half of items, so the stack depth is O(log(n))
+     */
+    tb_size_t i = 0;
+    tb_size_t tails[256];
+    while (count > TB_RADIX_SORT_STR_INSERT_MAXN)
+    {
+        // count the digits of this depth
+        tb_memset(tails, 0, sizeof(tails));
+        for (i = 0; i < count; i++) tails[tb_radix_sort_str_digit(data[i], depth)]++;
+
+        // all items have the same digit? 
+        tb_size_t digit = tb_radix_sort_str_digit(data[0], depth);
+        if (tails[digit] == count)
+        {
+            // all strings are ended and equal? 
+            tb_check_return(digit);
+
+            // the next depth
+            depth++;
+            continue;
+        }
+
+        // the counts => the heads
+        tb_size_t sum = 0;
+        for (i = 0; i < 256; i++)
+        {
+            tb_size_t n = tails[i];
+            tails[i] = sum;
+            sum += n;
+        }
+
+        // distribute the items, the heads => the tails
+        for (i = 0; i < count; i++) temp[tails[tb_radix_sort_str_digit(data[i], depth)]++] = data[i];
+        tb_memcpy(data, temp, count * sizeof(tb_char_t const*));
+
+        // sort the buckets of the next depth, the ended strings of the bucket[0] have been sorted
+        tb_size_t largest = 0;
+        tb_size_t largest_head = 0;
+        tb_size_t largest_size = 0;
+        for (i = 1; i < 256; i++)
+        {
+            tb_size_t head = tails[i - 1];
+            tb_size_t size = tails[i] - head;
+            if (size > largest_size)
+            {
+                // sort the previous largest bucket
+                if (largest_size > 1) tb_radix_sort_str_done(data + largest_head, temp + largest_head, largest_size, depth + 1);
+
+                // save the largest bucket
+                largest         = i;
+                largest_head    = head;
+                largest_size    = size;
+            }
+            else if (size > 1) tb_radix_sort_str_done(data + head, temp + head, size, depth + 1);
+        }
+        tb_assert_and_check_return(largest);
+
+        // sort the largest bucket
+        data   += largest_head;
+        temp   += largest_head;
+        count   = largest_size;
+        depth++;
+    }
+
+    // sort the small bucket
+    tb_radix_sort_str_insert(data, count, depth);
+}
+static tb_bool_t tb_radix_sort_str(tb_char_t const** data, tb_size_t count)
+{
+    // make the temp items
+    tb_char_t const** temp = (tb_char_t const**)tb_nalloc(count, sizeof(tb_char_t const*));
+    tb_assert_and_check_return_val(temp, tb_false);
+
+    // sort them
+    tb_radix_sort_str_done(data, temp, count, 0);
+
+    // exit the temp items
+    tb_free(temp);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_radix_sort_done(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail)
+{
+    // radix sortable?
+    tb_check_return_val(tb_radix_sort_able(iterator), tb_false);
+
+    // the items
+    tb_size_t   step = tb_iterator_step(iterator);
+    tb_byte_t*  data = (tb_byte_t*)tb_iterator_buff(iterator) + head * step;
+
+    // sort them
+    tb_bool_t ok = tb_false;
+    switch (tb_iterator_type(iterator))
+    {
+    case TB_ELEMENT_TYPE_STR:
+        ok = tb_radix_sort_str((tb_char_t const**)data, tail - head);
+        break;
+    case TB_ELEMENT_TYPE_LONG:
+        ok = tb_radix_sort_uint(data, tail - head, step, tb_true);
+        break;
+    default:
+        ok = tb_radix_sort_uint(data, tail - head, step, tb_false);
+        break;
+    }
+
+    // ok?
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_radix_sort_able(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_assert_and_check_return_val(iterator, tb_false);
+
+    // the contiguous random access items only
+    tb_check_return_val((tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) && tb_iterator_buff(iterator), tb_false);
+
+    // the known types only
+    tb_size_t step = tb_iterator_step(iterator);
+    switch (tb_iterator_type(iterator))
+    {
+    case TB_ELEMENT_TYPE_UINT8:
+    case TB_ELEMENT_TYPE_UINT16:
+    case TB_ELEMENT_TYPE_UINT32:
+    case TB_ELEMENT_TYPE_SIZE:
+    case TB_ELEMENT_TYPE_LONG:
+        return (step == 1 || step == 2 || step == 4 || step == 8)? tb_true : tb_false;
+    case TB_ELEMENT_TYPE_STR:
+        return step == sizeof(tb_char_t const*)? tb_true : tb_false;
+    default:
+        break;
+    }
+
+    // no
+    return tb_false;
+}
+tb_void_t tb_radix_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail)
+{
+    // check
+    tb_assert_and_check_return(iterator);
+
+    // no elements?
+    tb_check_return(head != tail);
+
+    // readonly?
+    tb_assert_and_check_return(!(tb_iterator_mode(iterator) & TB_ITERATOR_MODE_READONLY));
+
+    // sort them by radix
+    if (tb_radix_sort_done(iterator, head, tail)) return ;
+
+    // sort them by comparing
+    if (tb_iterator_buff(iterator)) tb_quick_sort(iterator, head, tail, tb_null);
+    else tb_sort(iterator, head, tail, tb_null);
+}
+tb_void_t tb_radix_sort_all(tb_iterator_ref_t iterator)
+{
+    tb_radix_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator));
+}
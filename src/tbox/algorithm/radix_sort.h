@@ -0,0 +1,72 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        radix_sort.h
+ * @ingroup     algorithm
+ *
+ */
+#ifndef TB_ALGORITHM_RADIX_SORT_H
+#define TB_ALGORITHM_RADIX_SORT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the radix sortable items?
+ *
+ * the contiguous items of long, size, uint8, uint16, uint32 and str (case-sensitive) types
+ *
+ * @param iterator  the iterator
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_radix_sort_able(tb_iterator_ref_t iterator);
+
+/*! the radix sorter, O(n * k)
+ *
+ * sort the integers by lsd radix sort and the strings by msd radix sort, 
+ * it is the same as tb_sort() with the default comparer if the items are not radix sortable.
+ *
+ * @param iterator  the iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ */
+tb_void_t           tb_radix_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail);
+
+/*! the radix sorter for all
+ *
+ * @param iterator  the iterator
+ */
+tb_void_t           tb_radix_sort_all(tb_iterator_ref_t iterator);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
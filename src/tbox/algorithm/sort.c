@@ -31,8 +31,24 @@
 #include "quick_sort.h"
 #include "insert_sort.h"
 #include "bubble_sort.h"
+#include "radix_sort.h"
+#include "parallel_sort.h"
 #include "../libc/libc.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum items count for sorting the contiguous items in parallel
+#ifdef __tb_small__
+#   define TB_SORT_PARALLEL_MINN        (131072)
+#else
+#   define TB_SORT_PARALLEL_MINN        (65536)
+#endif
+
+// the minimum items count for sorting the integers and strings by radix
+#define TB_SORT_RADIX_MINN              (256)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -50,7 +66,17 @@ tb_void_t tb_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb
     // random access iterator? 
     if (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) 
     {
-        if (tb_distance(iterator, head, tail) > 100000) tb_heap_sort(iterator, head, tail, comp);
+        // the contiguous items? sort them in parallel if there are too many items
+        tb_size_t size = tb_distance(iterator, head, tail);
+        if (tb_iterator_buff(iterator)) 
+        {
+            // sort the integers and strings by radix if they are compared in the natural order
+            if (size >= TB_SORT_RADIX_MINN && (!comp || comp == tb_iterator_comp) && tb_radix_sort_able(iterator)) 
+                tb_radix_sort(iterator, head, tail);
+            else if (size >= TB_SORT_PARALLEL_MINN) tb_parallel_sort(iterator, head, tail, comp);
+            else tb_quick_sort(iterator, head, tail, comp);
+        }
+        else if (size > 100000) tb_heap_sort(iterator, head, tail, comp);
         else tb_quick_sort(iterator, head, tail, comp); //!< @note the recursive stack size is limit
     }
     else tb_bubble_sort(iterator, head, tail, comp);
@@ -83,7 +83,7 @@ tb_bool_t tb_aico_open_sock(tb_aico_ref_t aico, tb_socket_ref_t sock)
     do
     {
         // closed?
-        tb_assert_and_check_break(tb_atomic_get(&impl->state) == TB_STATE_CLOSED);
+        tb_assert_and_check_break(tb_atomic_get_explicit(&impl->state, TB_ATOMIC_ACQUIRE) == TB_STATE_CLOSED);
         tb_assert_and_check_break(!impl->type && !impl->handle);
 
         // bind type and handle
@@ -95,7 +95,7 @@ tb_bool_t tb_aico_open_sock(tb_aico_ref_t aico, tb_socket_ref_t sock)
         tb_assert_and_check_break(ok);
 
         // opened
-        tb_atomic_set(&impl->state, TB_STATE_OPENED);
+        tb_atomic_set_explicit(&impl->state, TB_STATE_OPENED, TB_ATOMIC_RELEASE);
 
     } while (0);
 
@@ -115,7 +115,7 @@ tb_bool_t tb_aico_open_sock_from_type(tb_aico_ref_t aico, tb_size_t type, tb_siz
     do
     {
         // closed?
-        tb_assert_and_check_break(tb_atomic_get(&impl->state) == TB_STATE_CLOSED);
+        tb_assert_and_check_break(tb_atomic_get_explicit(&impl->state, TB_ATOMIC_ACQUIRE) == TB_STATE_CLOSED);
         tb_assert_and_check_break(!impl->type && !impl->handle);
 
         // init sock
@@ -131,7 +131,7 @@ tb_bool_t tb_aico_open_sock_from_type(tb_aico_ref_t aico, tb_size_t type, tb_siz
         tb_assert_and_check_break(ok);
 
         // opened
-        tb_atomic_set(&impl->state, TB_STATE_OPENED);
+        tb_atomic_set_explicit(&impl->state, TB_STATE_OPENED, TB_ATOMIC_RELEASE);
 
     } while (0);
 
@@ -158,7 +158,7 @@ tb_bool_t tb_aico_open_file(tb_aico_ref_t aico, tb_file_ref_t file)
     do
     {
         // closed?
-        tb_assert_and_check_break(tb_atomic_get(&impl->state) == TB_STATE_CLOSED);
+        tb_assert_and_check_break(tb_atomic_get_explicit(&impl->state, TB_ATOMIC_ACQUIRE) == TB_STATE_CLOSED);
         tb_assert_and_check_break(!impl->type && !impl->handle);
 
         // bind type and handle
@@ -170,7 +170,7 @@ tb_bool_t tb_aico_open_file(tb_aico_ref_t aico, tb_file_ref_t file)
         tb_assert_and_check_break(ok);
 
         // opened
-        tb_atomic_set(&impl->state, TB_STATE_OPENED);
+        tb_atomic_set_explicit(&impl->state, TB_STATE_OPENED, TB_ATOMIC_RELEASE);
 
     } while (0);
 
@@ -190,7 +190,7 @@ tb_bool_t tb_aico_open_file_from_path(tb_aico_ref_t aico, tb_char_t const* path,
     do
     {
         // closed?
-        tb_assert_and_check_break(tb_atomic_get(&impl->state) == TB_STATE_CLOSED);
+        tb_assert_and_check_break(tb_atomic_get_explicit(&impl->state, TB_ATOMIC_ACQUIRE) == TB_STATE_CLOSED);
         tb_assert_and_check_break(!impl->type && !impl->handle);
 
         // init file
@@ -206,7 +206,7 @@ tb_bool_t tb_aico_open_file_from_path(tb_aico_ref_t aico, tb_char_t const* path,
         tb_assert_and_check_break(ok);
 
         // opened
-        tb_atomic_set(&impl->state, TB_STATE_OPENED);
+        tb_atomic_set_explicit(&impl->state, TB_STATE_OPENED, TB_ATOMIC_RELEASE);
 
     } while (0);
 
@@ -233,7 +233,7 @@ tb_bool_t tb_aico_open_task(tb_aico_ref_t aico, tb_bool_t ltimer)
     do
     {
         // closed?
-        tb_assert_and_check_break(tb_atomic_get(&impl->state) == TB_STATE_CLOSED);
+        tb_assert_and_check_break(tb_atomic_get_explicit(&impl->state, TB_ATOMIC_ACQUIRE) == TB_STATE_CLOSED);
         tb_assert_and_check_break(!impl->type);
 
         // bind type and handle
@@ -246,7 +246,7 @@ tb_bool_t tb_aico_open_task(tb_aico_ref_t aico, tb_bool_t ltimer)
         tb_assert_and_check_break(ok);
 
         // opened
-        tb_atomic_set(&impl->state, TB_STATE_OPENED);
+        tb_atomic_set_explicit(&impl->state, TB_STATE_OPENED, TB_ATOMIC_RELEASE);
 
     } while (0);
 
@@ -262,7 +262,7 @@ tb_void_t tb_aico_exit(tb_aico_ref_t aico)
 
     // wait closing?
     tb_size_t tryn = 15;
-    while (tb_atomic_get(&impl->state) != TB_STATE_CLOSED && tryn--)
+    while (tb_atomic_get_explicit(&impl->state, TB_ATOMIC_ACQUIRE) != TB_STATE_CLOSED && tryn--)
     {
         // trace
         tb_trace_d("exit[%p]: type: %lu, handle: %p, state: %s: wait: ..", aico, tb_aico_type(aico), impl->handle, tb_state_cstr(tb_atomic_get(&impl->state)));
@@ -295,19 +295,19 @@ tb_void_t tb_aico_kill(tb_aico_ref_t aico)
     tb_assert_and_check_return(impl && aicp_impl && aicp_impl->ptor && aicp_impl->ptor->kilo);
 
     // the impl is killed and not worked?
-    tb_check_return(!tb_atomic_get(&aicp_impl->kill) || tb_atomic_get(&aicp_impl->work));
+    tb_check_return(!tb_atomic_get_explicit(&aicp_impl->kill, TB_ATOMIC_RELAXED) || tb_atomic_get_explicit(&aicp_impl->work, TB_ATOMIC_RELAXED));
 
     // trace
     tb_trace_d("kill: aico[%p]: type: %lu, handle: %p: state: %s: ..", aico, tb_aico_type(aico), impl->handle, tb_state_cstr(tb_atomic_get(&((tb_aico_impl_t*)aico)->state)));
 
     // opened? killed
-    if (TB_STATE_OPENED == tb_atomic_fetch_and_pset(&impl->state, TB_STATE_OPENED, TB_STATE_KILLED))
+    if (TB_STATE_OPENED == tb_atomic_fetch_and_pset_explicit(&impl->state, TB_STATE_OPENED, TB_STATE_KILLED, TB_ATOMIC_ACQ_REL))
     { 
         // trace
         tb_trace_d("kill: aico[%p]: type: %lu, handle: %p: ok", aico, tb_aico_type(aico), impl->handle);
     }
     // pending? kill it
-    else if (TB_STATE_PENDING == tb_atomic_fetch_and_pset(&impl->state, TB_STATE_PENDING, TB_STATE_KILLING)) 
+    else if (TB_STATE_PENDING == tb_atomic_fetch_and_pset_explicit(&impl->state, TB_STATE_PENDING, TB_STATE_KILLING, TB_ATOMIC_ACQ_REL)) 
     {
         // kill aico
         aicp_impl->ptor->kilo(aicp_impl->ptor, impl);
@@ -359,7 +359,7 @@ tb_long_t tb_aico_timeout(tb_aico_ref_t aico, tb_size_t type)
     tb_assert_and_check_return_val(impl && type < tb_arrayn(impl->timeout), -1);
 
     // the impl timeout
-    return tb_atomic_get((tb_atomic_t*)(impl->timeout + type));
+    return tb_atomic_get_explicit((tb_atomic_t*)(impl->timeout + type), TB_ATOMIC_RELAXED);
 }
 tb_void_t tb_aico_timeout_set(tb_aico_ref_t aico, tb_size_t type, tb_long_t timeout)
 {
@@ -368,7 +368,7 @@ tb_void_t tb_aico_timeout_set(tb_aico_ref_t aico, tb_size_t type, tb_long_t time
     tb_assert_and_check_return(impl && type < tb_arrayn(impl->timeout));
 
     // set the impl timeout
-    tb_atomic_set((tb_atomic_t*)(impl->timeout + type), timeout);
+    tb_atomic_set_explicit((tb_atomic_t*)(impl->timeout + type), timeout, TB_ATOMIC_RELAXED);
 }
 tb_bool_t tb_aico_clos_try(tb_aico_ref_t aico)
 {
@@ -377,7 +377,7 @@ tb_bool_t tb_aico_clos_try(tb_aico_ref_t aico)
     tb_assert_and_check_return_val(impl && impl->aicp, tb_false);
 
     // closed?
-    return (tb_atomic_get(&impl->state) == TB_STATE_CLOSED)? tb_true : tb_false;
+    return (tb_atomic_get_explicit(&impl->state, TB_ATOMIC_ACQUIRE) == TB_STATE_CLOSED)? tb_true : tb_false;
 }
 tb_bool_t tb_aico_clos_(tb_aico_ref_t aico, tb_aico_func_t func, tb_cpointer_t priv __tb_debug_decl__)
 {
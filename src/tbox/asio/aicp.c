@@ -39,6 +39,13 @@
 #include "../memory/memory.h"
 #include "../platform/platform.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the global aicp instance
+static tb_atomic_t  g_aicp = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -168,6 +175,9 @@ static tb_handle_t tb_aicp_instance_init(tb_cpointer_t* ppriv)
         // ok
         ok = tb_true;
 
+        // save the global aicp
+        tb_atomic_set(&g_aicp, (tb_size_t)aicp);
+
     } while (0);
 
     // failed?
@@ -186,6 +196,9 @@ static tb_void_t tb_aicp_instance_exit(tb_handle_t handle, tb_cpointer_t priv)
     // check
     tb_assert_and_check_return(handle);
 
+    // clear the global aicp
+    tb_atomic_set0(&g_aicp);
+
     // wait all
     if (!tb_aicp_wait_all((tb_aicp_ref_t)handle, 5000)) return ;
 
@@ -222,7 +235,15 @@ tb_aicp_ref_t tb_aicp()
 {
     return (tb_aicp_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_AICP, tb_aicp_instance_init, tb_aicp_instance_exit, tb_aicp_instance_kill, tb_null);
 }
+tb_bool_t tb_aicp_is_global(tb_aicp_ref_t aicp)
+{
+    return (aicp && (tb_size_t)aicp == (tb_size_t)tb_atomic_get(&g_aicp))? tb_true : tb_false;
+}
 tb_aicp_ref_t tb_aicp_init(tb_size_t maxn)
+{
+    return tb_aicp_init_sharded(maxn, 1);
+}
+tb_aicp_ref_t tb_aicp_init_sharded(tb_size_t maxn, tb_size_t shard)
 {
     // check iovec
     tb_assert_and_check_return_val(tb_memberof_eq(tb_aice_recv_t, data, tb_iovec_t, data), tb_null);
@@ -267,6 +288,7 @@ tb_aicp_ref_t tb_aicp_init(tb_size_t maxn)
 #else
         impl->maxn = maxn? maxn : (1 << 8);
 #endif
+        impl->shard = shard? shard : tb_processor_count();
 
         // init lock
         if (!tb_spinlock_init(&impl->lock)) break;
@@ -324,7 +346,7 @@ tb_bool_t tb_aicp_exit(tb_aicp_ref_t aicp)
 
     // wait workers exiting 
     tb_hong_t time = tb_mclock();
-    while (tb_atomic_get(&impl->work) && (tb_mclock() < time + 5000)) tb_msleep(500);
+    while (tb_atomic_get_explicit(&impl->work, TB_ATOMIC_ACQUIRE) && (tb_mclock() < time + 5000)) tb_msleep(500);
 
     // exit proactor
     if (impl->ptor)
@@ -370,7 +392,7 @@ tb_bool_t tb_aicp_post_(tb_aicp_ref_t aicp, tb_aice_ref_t aice __tb_debug_decl__
     tb_assert_and_check_return_val(aico, tb_false);
 
     // opened or killed or closed? pending it
-    tb_size_t state = tb_atomic_fetch_and_pset(&aico->state, TB_STATE_OPENED, TB_STATE_PENDING);
+    tb_size_t state = tb_atomic_fetch_and_pset_explicit(&aico->state, TB_STATE_OPENED, TB_STATE_PENDING, TB_ATOMIC_ACQ_REL);
     if (state == TB_STATE_OPENED || state == TB_STATE_KILLED)
     {
         // save debug info
@@ -405,7 +427,7 @@ tb_bool_t tb_aicp_post_after_(tb_aicp_ref_t aicp, tb_size_t delay, tb_aice_ref_t
     tb_assert_and_check_return_val(aice && aice->aico, tb_false);
 
     // killed?
-    tb_check_return_val(!tb_atomic_get(&impl->kill_all), tb_false);
+    tb_check_return_val(!tb_atomic_get_explicit(&impl->kill_all, TB_ATOMIC_RELAXED), tb_false);
 
     // no delay?
     if (!delay) return tb_aicp_post_(aicp, aice __tb_debug_args__);
@@ -442,7 +464,7 @@ tb_void_t tb_aicp_loop_util(tb_aicp_ref_t aicp, tb_bool_t (*stop)(tb_cpointer_t
     tb_long_t (*loop_spak)(tb_aicp_ptor_impl_t* , tb_handle_t, tb_aice_ref_t , tb_long_t ) = ptor->loop_spak;
 
     // worker++
-    tb_atomic_fetch_and_inc(&impl->work);
+    tb_atomic_fetch_and_inc_explicit(&impl->work, TB_ATOMIC_RELAXED);
 
     // init loop
     tb_handle_t loop = ptor->loop_init? ptor->loop_init(ptor) : tb_null;
@@ -478,7 +500,7 @@ tb_void_t tb_aicp_loop_util(tb_aicp_ref_t aicp, tb_bool_t (*stop)(tb_cpointer_t
 
         // pending? clear state if be not accept or accept failed
         tb_size_t state = TB_STATE_OPENED;
-        state = (resp.code != TB_AICE_CODE_ACPT || resp.state != TB_STATE_OK)? tb_atomic_fetch_and_pset(&aico->state, TB_STATE_PENDING, state) : tb_atomic_get(&aico->state);
+        state = (resp.code != TB_AICE_CODE_ACPT || resp.state != TB_STATE_OK)? tb_atomic_fetch_and_pset_explicit(&aico->state, TB_STATE_PENDING, state, TB_ATOMIC_ACQ_REL) : tb_atomic_get_explicit(&aico->state, TB_ATOMIC_ACQUIRE);
 
         // killed or killing?
         if (state == TB_STATE_KILLED || state == TB_STATE_KILLING)
@@ -487,7 +509,7 @@ tb_void_t tb_aicp_loop_util(tb_aicp_ref_t aicp, tb_bool_t (*stop)(tb_cpointer_t
             resp.state = TB_STATE_KILLED;
 
             // killing? update to the killed state
-            tb_atomic_fetch_and_pset(&aico->state, TB_STATE_KILLING, TB_STATE_KILLED);
+            tb_atomic_fetch_and_pset_explicit(&aico->state, TB_STATE_KILLING, TB_STATE_KILLED, TB_ATOMIC_ACQ_REL);
         }
 
         // done func, @note maybe the aico exit will be called
@@ -502,7 +524,7 @@ tb_void_t tb_aicp_loop_util(tb_aicp_ref_t aicp, tb_bool_t (*stop)(tb_cpointer_t
         }
 
         // killing? update to the killed state
-        tb_atomic_fetch_and_pset(&aico->state, TB_STATE_KILLING, TB_STATE_KILLED);
+        tb_atomic_fetch_and_pset_explicit(&aico->state, TB_STATE_KILLING, TB_STATE_KILLED, TB_ATOMIC_ACQ_REL);
 
         // stop it?
         if (stop && stop(priv)) tb_aicp_kill(aicp);
@@ -512,7 +534,7 @@ tb_void_t tb_aicp_loop_util(tb_aicp_ref_t aicp, tb_bool_t (*stop)(tb_cpointer_t
     if (ptor->loop_exit) ptor->loop_exit(ptor, loop);
 
     // worker--
-    tb_atomic_fetch_and_dec(&impl->work);
+    tb_atomic_fetch_and_dec_explicit(&impl->work, TB_ATOMIC_RELEASE);
 
     // trace
     tb_trace_d("loop[%p]: exit", loop);
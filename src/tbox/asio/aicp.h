@@ -55,6 +55,16 @@ __tb_extern_c_enter__
  */
 tb_aicp_ref_t       tb_aicp(tb_noarg_t);
 
+/*! is the global aicp instance?
+ *
+ * @note it will not init the global aicp instance
+ *
+ * @param aicp      the aicp
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_aicp_is_global(tb_aicp_ref_t aicp);
+
 /*! init the aicp
  *
  * @param maxn      the aico maxn, using the default maxn if be zero
@@ -63,6 +73,24 @@ tb_aicp_ref_t       tb_aicp(tb_noarg_t);
  */
 tb_aicp_ref_t       tb_aicp_init(tb_size_t maxn);
 
+/*! init the aicp with the sharded reactors
+ *
+ * each reactor shard has its own aiop, spak loop and spak queues,
+ * the aico will be pinned to one shard when it is opened.
+ *
+ * the loop will spak the aice from its own shard first and steal it from the other shards if idle,
+ * so we need call tb_aicp_loop() in multiple threads for scaling it with the cores.
+ *
+ * @note only for the aiop proactor, the iocp proactor will ignore the shard count,
+ * and the io_uring proactor will not be used if the shard count is larger than one
+ *
+ * @param maxn      the aico maxn, using the default maxn if be zero
+ * @param shard     the reactor shard count, using the processor count if be zero
+ *
+ * @return          the aicp
+ */
+tb_aicp_ref_t       tb_aicp_init_sharded(tb_size_t maxn, tb_size_t shard);
+
 /*! exit the aicp
  *
  * @param aicp      the aicp
@@ -35,6 +35,7 @@
 #include "aice.h"
 #include "aicp.h"
 #include "http.h"
+#include "httpd.h"
 #include "dns.h"
 #include "ssl.h"
 
@@ -73,6 +73,9 @@ typedef struct __tb_aicp_dns_impl_t
     // the server size
     tb_size_t               size;
 
+    // the ttl of the found address
+    tb_size_t               ttl;
+
     // the data
     tb_byte_t               data[TB_DNS_RPKT_MAXN];
 
@@ -267,6 +270,9 @@ static tb_bool_t tb_aicp_dns_resp_done(tb_aicp_dns_impl_t* impl, tb_size_t size,
                     tb_ipaddr_ipv4_set(addr, &ipv4);
                 }
 
+                // save ttl
+                impl->ttl = answer.res.ttl;
+
                 // found it
                 found = 1;
 
@@ -333,7 +339,7 @@ static tb_bool_t tb_aicp_dns_resp_func(tb_aice_ref_t aice)
     if (!tb_ipaddr_ip_is_empty(&addr) || (from_cache = tb_dns_cache_get(impl->host, &addr))) 
     {
         // save to cache 
-        if (!from_cache) tb_dns_cache_set(impl->host, &addr);
+        if (!from_cache) tb_dns_cache_set_ttl(impl->host, &addr, impl->ttl);
         
         // done func
         impl->done.func((tb_aicp_dns_ref_t)impl, impl->host, &addr, impl->done.priv);
@@ -357,8 +363,12 @@ static tb_bool_t tb_aicp_dns_resp_func(tb_aice_ref_t aice)
         }
     }
 
-    // failed? done func
-    if (!ok) impl->done.func((tb_aicp_dns_ref_t)impl, impl->host, tb_null, impl->done.priv);
+    // failed? cache it for a while and done func
+    if (!ok) 
+    {
+        tb_dns_cache_set_failed(impl->host, 0);
+        impl->done.func((tb_aicp_dns_ref_t)impl, impl->host, tb_null, impl->done.priv);
+    }
 
     // continue
     return tb_true;
@@ -412,8 +422,12 @@ static tb_bool_t tb_aicp_dns_reqt_func(tb_aice_ref_t aice)
         }
     }
 
-    // failed? done func
-    if (!ok) impl->done.func((tb_aicp_dns_ref_t)impl, impl->host, tb_null, impl->done.priv);
+    // failed? cache it for a while and done func
+    if (!ok) 
+    {
+        tb_dns_cache_set_failed(impl->host, 0);
+        impl->done.func((tb_aicp_dns_ref_t)impl, impl->host, tb_null, impl->done.priv);
+    }
 
     // continue 
     return tb_true;
@@ -512,6 +526,9 @@ tb_bool_t tb_aicp_dns_done(tb_aicp_dns_ref_t dns, tb_char_t const* host, tb_long
 
     // save host
     tb_strlcpy(impl->host, host, sizeof(impl->host));
+
+    // reset ttl
+    impl->ttl = 0;
  
     // only address? ok
     tb_ipaddr_t addr = {0};
@@ -528,6 +545,13 @@ tb_bool_t tb_aicp_dns_done(tb_aicp_dns_ref_t dns, tb_char_t const* host, tb_long
         return tb_true;
     }
 
+    // failed recently? fail fast
+    if (tb_dns_cache_failed(impl->host))
+    {
+        impl->done.func(dns, impl->host, tb_null, impl->done.priv);
+        return tb_true;
+    }
+
     // init server list
     if (!impl->size) impl->size = tb_dns_server_get(impl->list);
     tb_check_return_val(impl->size, tb_false);
@@ -45,11 +45,97 @@
 #include "../network/impl/http/option.h"
 #include "../network/impl/http/status.h"
 #include "../network/impl/http/method.h"
+#include "../network/impl/http/pool.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the pipelined requests maxn in flight
+#ifdef __tb_small__
+#   define TB_AICP_HTTP_PIPE_MAXN           (8)
+#else
+#   define TB_AICP_HTTP_PIPE_MAXN           (16)
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the aicp http pipe step enum
+typedef enum __tb_aicp_http_pipe_step_e
+{
+    TB_AICP_HTTP_PIPE_STEP_HEAD             = 0     //!< the response head
+,   TB_AICP_HTTP_PIPE_STEP_DATA             = 1     //!< the content data with the content size
+,   TB_AICP_HTTP_PIPE_STEP_DATA_ALL         = 2     //!< the content data until the connection is closed
+,   TB_AICP_HTTP_PIPE_STEP_CHUNK_HEAD       = 3     //!< the chunk size line
+,   TB_AICP_HTTP_PIPE_STEP_CHUNK_DATA       = 4     //!< the chunk data
+,   TB_AICP_HTTP_PIPE_STEP_CHUNK_TAIL       = 5     //!< the "\r\n" after the chunk data
+,   TB_AICP_HTTP_PIPE_STEP_CHUNK_TRAILER    = 6     //!< the trailer lines after the last chunk
+
+}tb_aicp_http_pipe_step_e;
+
+// the aicp http pipe item type
+typedef struct __tb_aicp_http_pipe_item_t
+{
+    // the func
+    tb_aicp_http_pipe_func_t        func;
+
+    // the priv
+    tb_cpointer_t                   priv;
+
+    // the path
+    tb_char_t*                      path;
+
+    // the args
+    tb_char_t const*                args;
+
+}tb_aicp_http_pipe_item_t;
+
+// the aicp http pipe type
+typedef struct __tb_aicp_http_pipe_t
+{
+    // the lock
+    tb_spinlock_t                   lock;
+
+    // the queued items, the front items have been sent and are waiting for the responses
+    tb_queue_ref_t                  items;
+
+    // the sent count
+    tb_size_t                       sent;
+
+    // the maxn of the sent items, it will be one if the server does not support pipelining
+    tb_size_t                       maxn;
+
+    // the response count of the current connection
+    tb_size_t                       resp;
+
+    // the retry count of the current request
+    tb_size_t                       tryn;
+
+    // the state for the left items
+    tb_size_t                       state;
+
+    // the head data of the sent requests
+    tb_buffer_t                     head;
+
+    // the content data of the current response
+    tb_buffer_t                     data;
+
+    // the left size of the current content or chunk
+    tb_hize_t                       left;
+
+    // the parse step
+    tb_uint8_t                      step;
+
+    // is running?
+    tb_uint8_t                      brunning    : 1;
+
+    // is the reused connection?
+    tb_uint8_t                      breused     : 1;
+
+}tb_aicp_http_pipe_t;
+
 // the aicp http impl open and read type
 typedef struct __tb_aicp_http_open_read_t
 {
@@ -146,12 +232,27 @@ typedef struct __tb_aicp_http_impl_t
     // the redirect tryn
     tb_size_t                       redirect_tryn;
 
+    // is the reused alived connection?
+    tb_uint8_t                      breused     : 1;
+
+    // has been responded?
+    tb_uint8_t                      bresponded  : 1;
+
+    // is retrying on a new connection?
+    tb_uint8_t                      bretrying   : 1;
+
     // the content read 
     tb_hize_t                       content_read;
 
+    // the content offset of the sstream
+    tb_hize_t                       content_offset;
+
     // the clos opening
     tb_aicp_http_clos_opening_t     clos_opening;
 
+    // the pipe
+    tb_aicp_http_pipe_t             pipe;
+
     // the open and read, writ, seek, ...
     union
     {
@@ -180,14 +281,16 @@ typedef struct __tb_aicp_http_impl_t
  * declaration
  */
 static tb_bool_t tb_aicp_http_open_done(tb_aicp_http_impl_t* impl);
+static tb_bool_t tb_aicp_http_pipe_conn(tb_aicp_http_impl_t* impl);
+static tb_void_t tb_aicp_http_pipe_writ(tb_aicp_http_impl_t* impl);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-static tb_char_t const* tb_aicp_http_head_format(tb_aicp_http_impl_t* impl, tb_hize_t post_size, tb_size_t* head_size, tb_size_t* state)
+static tb_char_t const* tb_aicp_http_head_format(tb_aicp_http_impl_t* impl, tb_char_t const* path, tb_char_t const* args, tb_hize_t post_size, tb_size_t* head_size, tb_size_t* state)
 {
     // check
-    tb_assert_and_check_return_val(impl && head_size, tb_null);
+    tb_assert_and_check_return_val(impl && path && head_size, tb_null);
 
     // clear line data
     tb_string_clear(&impl->line_data);
@@ -201,13 +304,6 @@ static tb_char_t const* tb_aicp_http_head_format(tb_aicp_http_impl_t* impl, tb_h
     tb_char_t const* method = tb_http_method_cstr(impl->option.method);
     tb_assert_and_check_return_val(method, tb_null);
 
-    // init path
-    tb_char_t const* path = tb_url_path(&impl->option.url);
-    tb_assert_and_check_return_val(path, tb_null);
-
-    // init args
-    tb_char_t const* args = tb_url_args(&impl->option.url);
-
     // init host
     tb_char_t const* host = tb_url_host(&impl->option.url);
     tb_assert_and_check_return_val(host, tb_null);
@@ -217,7 +313,7 @@ static tb_char_t const* tb_aicp_http_head_format(tb_aicp_http_impl_t* impl, tb_h
     tb_hash_map_insert(impl->head, "Accept", "*/*");
 
     // init connection
-    tb_hash_map_insert(impl->head, "Connection", impl->status.balived? "keep-alive" : "close");
+    tb_hash_map_insert(impl->head, "Connection", (impl->status.balived || impl->option.version)? "keep-alive" : "close");
 
     // init cookies
     tb_bool_t cookie = tb_false;
@@ -465,6 +561,11 @@ static tb_bool_t tb_aicp_http_head_resp_done(tb_aicp_http_impl_t* impl)
             impl->status.state = TB_STATE_HTTP_RESPONSE_500 + (impl->status.code - 500);
         else impl->status.state = TB_STATE_HTTP_RESPONSE_UNK;
 
+        // keep alive for HTTP/1.1 if it is requested, it may be changed by the "Connection" field
+        tb_char_t const* connection = (tb_char_t const*)tb_hash_map_get(impl->head, "Connection");
+        impl->status.balived = (impl->status.version && connection && !tb_stricmp(connection, "keep-alive"))? 1 : 0;
+        if (!tb_async_stream_ctrl(impl->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, impl->status.balived? tb_true : tb_false)) return tb_false;
+
         // check state code: 4xx & 5xx
         if (impl->status.code >= 400 && impl->status.code < 600) return tb_false;
     }
@@ -657,6 +758,9 @@ static tb_bool_t tb_aicp_http_head_read_func(tb_async_stream_ref_t stream, tb_si
         // ok? 
         tb_check_break(state == TB_STATE_OK);
 
+        // responded
+        if (real) impl->bresponded = 1;
+
         // reset state
         state = TB_STATE_UNKNOWN_ERROR;
 
@@ -686,6 +790,15 @@ static tb_bool_t tb_aicp_http_head_read_func(tb_async_stream_ref_t stream, tb_si
                 // strip '\r' if exists
                 tb_char_t const*    pb = tb_string_cstr(&impl->line_data);
                 tb_size_t           pn = tb_string_size(&impl->line_data);
+
+                // skip the empty lines before the status line, .e.g the left CRLF of the last response
+                if (!impl->line_size && pb && (!pn || (pn == 1 && pb[0] == '\r')))
+                {
+                    tb_string_clear(&impl->line_data);
+                    continue;
+                }
+
+                // check
                 if (!pb || !pn)
                 {
                     ok = -1;
@@ -745,6 +858,9 @@ static tb_bool_t tb_aicp_http_head_read_func(tb_async_stream_ref_t stream, tb_si
             // trace
             tb_trace_d("response: ok");
 
+            // save the content offset
+            impl->content_offset = tb_async_stream_offset(impl->sstream) - (e - p);
+
             // redirect?
             if (tb_string_size(&impl->status.location) && impl->redirect_tryn++ < impl->option.redirect)
             {
@@ -1031,7 +1147,7 @@ static tb_bool_t tb_aicp_http_post_open_func(tb_size_t state, tb_hize_t offset,
 
         // the head data and size
         tb_size_t           head_size = 0;
-        tb_char_t const*    head_data = tb_aicp_http_head_format(impl, size, &head_size, &state);
+        tb_char_t const*    head_data = tb_aicp_http_head_format(impl, tb_url_path(&impl->option.url), tb_url_args(&impl->option.url), size, &head_size, &state);
         tb_check_break(head_data && head_size);
         
         // trace
@@ -1086,7 +1202,7 @@ static tb_bool_t tb_aicp_http_sock_open_func(tb_async_stream_ref_t stream, tb_si
         {
             // the head data and size
             tb_size_t           head_size = 0;
-            tb_char_t const*    head_data = tb_aicp_http_head_format(impl, 0, &head_size, tb_null);
+            tb_char_t const*    head_data = tb_aicp_http_head_format(impl, tb_url_path(&impl->option.url), tb_url_args(&impl->option.url), 0, &head_size, tb_null);
             tb_check_break(head_data && head_size);
             
             // trace
@@ -1179,6 +1295,162 @@ static tb_bool_t tb_aicp_http_task_func(tb_async_stream_ref_t stream, tb_size_t
     // done func
     return impl->func.task((tb_aicp_http_ref_t)impl, state, impl->priv);
 }
+static tb_void_t tb_aicp_http_sstream_clos_func(tb_async_stream_ref_t stream, tb_size_t state, tb_cpointer_t priv)
+{
+    // exit the alived sock stream after closing it
+    tb_async_stream_exit(stream);
+}
+static tb_bool_t tb_aicp_http_sstream_open_func(tb_async_stream_ref_t stream, tb_size_t state, tb_cpointer_t priv)
+{
+    // not keep alive now
+    tb_async_stream_ctrl(stream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+
+    // close the connection and exit it
+    if (state != TB_STATE_OK || !tb_async_stream_clos(stream, tb_aicp_http_sstream_clos_func, tb_null))
+        tb_async_stream_exit(stream);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_aicp_http_sstream_exit(tb_handle_t stream)
+{
+    // check
+    tb_assert_and_check_return(stream);
+
+    /* reopen the alived sock stream directly and close the connection without waiting it, 
+     * because it may be exited at the aicp loop
+     */
+    if (!tb_async_stream_open((tb_async_stream_ref_t)stream, tb_aicp_http_sstream_open_func, tb_null))
+        tb_async_stream_exit((tb_async_stream_ref_t)stream);
+}
+static tb_void_t tb_aicp_http_sstream_set(tb_aicp_http_impl_t* impl, tb_async_stream_ref_t sstream)
+{
+    // check
+    tb_assert_and_check_return(impl && sstream);
+
+    // exit the old sock stream
+    if (impl->sstream) tb_async_stream_exit(impl->sstream);
+
+    // switch to the new sock stream
+    impl->stream = impl->sstream = sstream;
+
+    // the filter streams cannot refer to the old sock stream
+    if (impl->cstream) tb_async_stream_ctrl(impl->cstream, TB_STREAM_CTRL_FLTR_SET_STREAM, sstream);
+    if (impl->zstream) tb_async_stream_ctrl(impl->zstream, TB_STREAM_CTRL_FLTR_SET_STREAM, sstream);
+}
+static tb_bool_t tb_aicp_http_alive_able(tb_aicp_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->sstream, tb_false);
+
+    /* only for the global aicp and non-ssl connection,
+     * the idle connection will hinder exiting the private aicp and the async ssl session cannot be resumed now
+     */
+    return (    TB_STATE_KILLING != tb_atomic_get(&impl->state)
+            &&  tb_aicp_is_global(tb_async_stream_aicp(impl->sstream))
+            &&  !tb_url_ssl(tb_async_stream_url(impl->sstream)))? tb_true : tb_false;
+}
+static tb_void_t tb_aicp_http_alive_check(tb_aicp_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->sstream);
+
+    // alived and opened?
+    tb_check_return(impl->status.balived && tb_async_stream_is_opened(impl->sstream));
+
+    // the whole content have been read? the connection can be reused
+    tb_bool_t finished = tb_false;
+    if (impl->content_offset && tb_aicp_http_alive_able(impl))
+    {
+        // chunked? the end chunk have been read
+        if (impl->status.bchunked)
+        {
+            tb_stream_filter_ref_t filter = tb_null;
+            if (    impl->cstream
+                &&  tb_async_stream_is_opened(impl->cstream)
+                &&  tb_async_stream_ctrl(impl->cstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter) && filter)
+                finished = tb_stream_filter_beof(filter);
+        }
+        // the content size is known?
+        else if (impl->status.content_size >= 0)
+            finished = tb_async_stream_offset(impl->sstream) == impl->content_offset + impl->status.content_size;
+    }
+
+    // not finished? close the connection
+    if (!finished)
+    {
+        impl->status.balived = 0;
+        tb_async_stream_ctrl(impl->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+    }
+}
+static tb_void_t tb_aicp_http_alive_save(tb_aicp_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->sstream);
+
+    // alived and closed?
+    tb_check_return(impl->status.balived && tb_async_stream_is_closed(impl->sstream));
+
+    // the alived sock stream will be taken away
+    impl->status.balived = 0;
+
+    // killed? it will be exited with the http
+    tb_check_return(TB_STATE_KILLING != tb_atomic_get(&impl->state));
+
+    // the aicp
+    tb_aicp_ref_t aicp = tb_async_stream_aicp(impl->sstream);
+    tb_assert_and_check_return(aicp);
+
+    // init a new sock stream for the next connection
+    tb_async_stream_ref_t sstream = tb_async_stream_init_sock(aicp);
+    tb_assert_and_check_return(sstream);
+
+    // put the alived sock stream to the pool, it will be closed if failed
+    tb_async_stream_ref_t alived = impl->sstream;
+    impl->sstream = tb_null;
+    if (!tb_http_pool_put(aicp, tb_async_stream_url(alived), alived, tb_aicp_http_sstream_exit))
+        tb_aicp_http_sstream_exit(alived);
+
+    // switch to the new sock stream
+    tb_aicp_http_sstream_set(impl, sstream);
+}
+static tb_void_t tb_aicp_http_alive_load(tb_aicp_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->sstream);
+
+    // the global aicp and non-ssl connection?
+    tb_aicp_ref_t aicp = tb_async_stream_aicp(impl->sstream);
+    tb_check_return(tb_aicp_is_global(aicp) && !tb_url_ssl(&impl->option.url));
+
+    // get the idle connection of this host from the pool
+    tb_async_stream_ref_t sstream = tb_null;
+    while ((sstream = (tb_async_stream_ref_t)tb_http_pool_get(aicp, &impl->option.url)))
+    {
+        // the connection is still alived? 
+        tb_socket_ref_t sock = tb_null;
+        if (tb_async_stream_ctrl(sstream, TB_STREAM_CTRL_SOCK_GET_SOCK, &sock) && tb_http_pool_alived(sock)) break;
+
+        // trace
+        tb_trace_d("connect: drop the closed connection: %s", tb_url_cstr(tb_async_stream_url(sstream)));
+
+        // closed by the server? exit it
+        tb_aicp_http_sstream_exit(sstream);
+    }
+    tb_check_return(sstream);
+
+    // trace
+    tb_trace_d("connect: reuse the alived connection: %s", tb_url_cstr(tb_async_stream_url(sstream)));
+
+    // switch to the alived sock stream
+    tb_aicp_http_sstream_set(impl, sstream);
+
+    // keep alive
+    impl->status.balived = 1;
+
+    // reused
+    impl->breused = 1;
+}
 static tb_void_t tb_aicp_http_clos_clear(tb_aicp_http_impl_t* impl)
 {
     // check
@@ -1187,6 +1459,9 @@ static tb_void_t tb_aicp_http_clos_clear(tb_aicp_http_impl_t* impl)
     // reset stream
     impl->stream = impl->sstream;
 
+    // put the alived connection to the pool
+    tb_aicp_http_alive_save(impl);
+
     // clear the content read size
     impl->content_read = 0;
 
@@ -1239,6 +1514,53 @@ static tb_void_t tb_aicp_http_clos_opening_func(tb_aicp_http_ref_t http, tb_size
     impl->status.state = impl->clos_opening.state;
     impl->clos_opening.func(http, impl->status.state, &impl->status, impl->clos_opening.priv);
 }
+static tb_bool_t tb_aicp_http_open_prep(tb_aicp_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->sstream, tb_false);
+
+    // reset stream
+    impl->stream = impl->sstream;
+
+    // put the alived connection to the pool
+    tb_aicp_http_alive_save(impl);
+
+    // clear the reused and responded state
+    impl->breused       = 0;
+    impl->bresponded    = 0;
+
+    // reuse the idle connection of this host, but connect it directly if retrying
+    if (!impl->bretrying) tb_aicp_http_alive_load(impl);
+    impl->bretrying = 0;
+
+    // the host is changed?
+    tb_bool_t           host_changed = tb_true;
+    tb_char_t const*    host_old = tb_null;
+    tb_char_t const*    host_new = tb_url_host(&impl->option.url);
+    tb_async_stream_ctrl(impl->stream, TB_STREAM_CTRL_GET_HOST, &host_old);
+    if (host_old && host_new && !tb_stricmp(host_old, host_new)) host_changed = tb_false;
+
+    // trace
+    tb_trace_d("connect: host: %s", host_changed? "changed" : "keep");
+
+    // ctrl stream
+    if (!tb_async_stream_ctrl(impl->stream, TB_STREAM_CTRL_SET_URL, tb_url_cstr(&impl->option.url))) return tb_false;
+    if (!tb_async_stream_ctrl(impl->stream, TB_STREAM_CTRL_SET_TIMEOUT, impl->option.timeout)) return tb_false;
+
+    // dump option
+#if defined(__tb_debug__) && TB_TRACE_MODULE_DEBUG
+    tb_http_option_dump(&impl->option);
+#endif
+
+    // clear status
+    tb_http_status_cler(&impl->status, host_changed);
+
+    // clear the content offset
+    impl->content_offset = 0;
+
+    // ok
+    return tb_true;
+}
 static tb_void_t tb_aicp_http_open_clos(tb_async_stream_ref_t stream, tb_size_t state, tb_cpointer_t priv)
 {
     // check
@@ -1262,30 +1584,8 @@ static tb_void_t tb_aicp_http_open_clos(tb_async_stream_ref_t stream, tb_size_t
         // reset state
         state = TB_STATE_HTTP_UNKNOWN_ERROR;
 
-        // reset stream
-        impl->stream = impl->sstream;
-
-        // the host is changed?
-        tb_bool_t           host_changed = tb_true;
-        tb_char_t const*    host_old = tb_null;
-        tb_char_t const*    host_new = tb_url_host(&impl->option.url);
-        tb_async_stream_ctrl(impl->stream, TB_STREAM_CTRL_GET_HOST, &host_old);
-        if (host_old && host_new && !tb_stricmp(host_old, host_new)) host_changed = tb_false;
-
-        // trace
-        tb_trace_d("connect: host: %s", host_changed? "changed" : "keep");
-
-        // ctrl stream
-        if (!tb_async_stream_ctrl(impl->stream, TB_STREAM_CTRL_SET_URL, tb_url_cstr(&impl->option.url))) break;
-        if (!tb_async_stream_ctrl(impl->stream, TB_STREAM_CTRL_SET_TIMEOUT, impl->option.timeout)) break;
-
-        // dump option
-#if defined(__tb_debug__) && TB_TRACE_MODULE_DEBUG
-        tb_http_option_dump(&impl->option);
-#endif
-
-        // clear status
-        tb_http_status_cler(&impl->status, host_changed);
+        // prepare to open the stream
+        if (!tb_aicp_http_open_prep(impl)) break;
 
         // open the stream
         ok = tb_async_stream_open(impl->stream, tb_aicp_http_sock_open_func, impl);
@@ -1313,11 +1613,41 @@ static tb_bool_t tb_aicp_http_open_done(tb_aicp_http_impl_t* impl)
     // check
     tb_assert_and_check_return_val(impl && impl->stream && impl->func.open, tb_false);
 
+    // check the alived connection before closing it
+    tb_aicp_http_alive_check(impl);
+
     // close transfer
     if (impl->transfer) return tb_async_transfer_clos(impl->transfer, tb_aicp_http_open_clos_transfer, impl);
     // close stream 
     else return tb_async_stream_clos(impl->stream, tb_aicp_http_open_clos, impl);
 }
+static tb_bool_t tb_aicp_http_open_retry(tb_aicp_http_impl_t* impl, tb_size_t state)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->sstream, tb_false);
+
+    // the reused connection is broken before responding? it may have been closed by the server
+    tb_check_return_val(impl->breused && !impl->bresponded && state != TB_STATE_KILLED, tb_false);
+
+    // killed?
+    tb_check_return_val(TB_STATE_KILLING != tb_atomic_get(&impl->state), tb_false);
+
+    // trace
+    tb_trace_d("open: retry: %s, state: %s", tb_url_cstr(&impl->option.url), tb_state_cstr(state));
+
+    // not keep alive
+    impl->status.balived = 0;
+    tb_async_stream_ctrl(impl->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+
+    // retry only once on a new connection
+    impl->breused   = 0;
+    impl->bretrying = 1;
+    if (tb_aicp_http_open_done(impl)) return tb_true;
+
+    // failed
+    impl->bretrying = 0;
+    return tb_false;
+}
 static tb_bool_t tb_aicp_http_open_func(tb_aicp_http_impl_t* impl, tb_size_t state, tb_aicp_http_open_func_t func, tb_cpointer_t priv)
 {
     // check
@@ -1334,6 +1664,8 @@ static tb_bool_t tb_aicp_http_open_func(tb_aicp_http_impl_t* impl, tb_size_t sta
         impl->status.state = state;
         if (func) ok = func((tb_aicp_http_ref_t)impl, state, &impl->status, priv);
     }
+    // retry it on a new connection?
+    else if (tb_aicp_http_open_retry(impl, state)) ok = tb_true;
     // failed? 
     else 
     {
@@ -1349,6 +1681,601 @@ static tb_bool_t tb_aicp_http_open_func(tb_aicp_http_impl_t* impl, tb_size_t sta
     // ok?
     return ok;
 }
+static tb_void_t tb_aicp_http_pipe_item_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_aicp_http_pipe_item_t* item = (tb_aicp_http_pipe_item_t*)buff;
+    tb_assert_and_check_return(item);
+
+    // exit path
+    if (item->path) tb_free(item->path);
+    item->path = tb_null;
+}
+static tb_bool_t tb_aicp_http_pipe_notify(tb_aicp_http_impl_t* impl, tb_size_t state, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // enter
+    tb_spinlock_enter(&impl->pipe.lock);
+
+    // pop the front item
+    tb_aicp_http_pipe_item_t item = {0};
+    if (impl->pipe.items && tb_queue_size(impl->pipe.items))
+    {
+        // save the item, the path will be freed after notifying it
+        tb_aicp_http_pipe_item_t* head = (tb_aicp_http_pipe_item_t*)tb_queue_head(impl->pipe.items);
+        if (head)
+        {
+            item = *head;
+            head->path = tb_null;
+        }
+
+        // pop it
+        tb_queue_pop(impl->pipe.items);
+
+        // update the sent count
+        if (impl->pipe.sent) impl->pipe.sent--;
+    }
+
+    // leave
+    tb_spinlock_leave(&impl->pipe.lock);
+
+    // no item?
+    tb_check_return_val(item.func, tb_false);
+
+    // done func
+    item.func((tb_aicp_http_ref_t)impl, state, &impl->status, data, size, item.priv);
+
+    // exit path
+    if (item.path) tb_free(item.path);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_aicp_http_pipe_clear(tb_aicp_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // clear step
+    impl->pipe.step = TB_AICP_HTTP_PIPE_STEP_HEAD;
+    impl->pipe.left = 0;
+
+    // clear line
+    impl->line_size = 0;
+    tb_string_clear(&impl->line_data);
+
+    // clear content data
+    tb_buffer_clear(&impl->pipe.data);
+
+    // clear status
+    tb_http_status_cler(&impl->status, tb_false);
+}
+static tb_void_t tb_aicp_http_pipe_stop(tb_aicp_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // killed?
+    if (TB_STATE_KILLING == tb_atomic_get(&impl->state)) impl->pipe.state = TB_STATE_KILLED;
+
+    // trace
+    tb_trace_d("pipe: stop: %s", tb_state_cstr(impl->pipe.state));
+
+    // failed? notify all left items
+    if (impl->pipe.state != TB_STATE_OK)
+    {
+        while (tb_aicp_http_pipe_notify(impl, impl->pipe.state, tb_null, 0)) ;
+    }
+
+    // enter
+    tb_spinlock_enter(&impl->pipe.lock);
+
+    // no left items? stop it
+    tb_bool_t bconn = tb_false;
+    if (!impl->pipe.items || !tb_queue_size(impl->pipe.items))
+    {
+        // stop it
+        impl->pipe.sent     = 0;
+        impl->pipe.brunning = 0;
+
+        // closed
+        if (TB_STATE_KILLING != tb_atomic_get(&impl->state)) tb_atomic_set(&impl->state, TB_STATE_CLOSED);
+    }
+    // the new items have been queued?
+    else bconn = tb_true;
+
+    // leave
+    tb_spinlock_leave(&impl->pipe.lock);
+
+    // connect it again for the new items
+    if (bconn)
+    {
+        impl->pipe.state = TB_STATE_OK;
+        tb_aicp_http_pipe_conn(impl);
+    }
+}
+static tb_void_t tb_aicp_http_pipe_clos_func(tb_async_stream_ref_t stream, tb_size_t state, tb_cpointer_t priv)
+{
+    // check
+    tb_aicp_http_impl_t* impl = (tb_aicp_http_impl_t*)priv;
+    tb_assert_and_check_return(impl && impl->sstream);
+
+    // trace
+    tb_trace_d("pipe: clos: notify: %s", tb_state_cstr(state));
+
+    // reset stream
+    impl->stream = impl->sstream;
+
+    // put the alived connection to the pool
+    tb_aicp_http_alive_save(impl);
+
+    // stop it
+    tb_aicp_http_pipe_stop(impl);
+}
+static tb_void_t tb_aicp_http_pipe_clos(tb_aicp_http_impl_t* impl, tb_size_t state)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->stream);
+
+    // trace
+    tb_trace_d("pipe: clos: %s", tb_state_cstr(state));
+
+    // save the state for the left items
+    impl->pipe.state = state;
+
+    // failed or cannot be reused? not keep alive
+    if (state != TB_STATE_OK || !tb_aicp_http_alive_able(impl))
+    {
+        impl->status.balived = 0;
+        tb_async_stream_ctrl(impl->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+    }
+
+    // close the connection
+    if (!tb_async_stream_clos(impl->stream, tb_aicp_http_pipe_clos_func, impl)) tb_aicp_http_pipe_stop(impl);
+}
+static tb_void_t tb_aicp_http_pipe_break(tb_aicp_http_impl_t* impl, tb_size_t state)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->sstream);
+
+    // trace
+    tb_trace_d("pipe: break: resp: %lu, sent: %lu, reused: %u, state: %s", impl->pipe.resp, impl->pipe.sent, impl->pipe.breused, tb_state_cstr(state));
+
+    // killed?
+    if (TB_STATE_KILLING == tb_atomic_get(&impl->state))
+    {
+        tb_aicp_http_pipe_clos(impl, TB_STATE_KILLED);
+        return ;
+    }
+
+    // the new connection is closed without any response?
+    if (!impl->pipe.resp && !impl->pipe.breused)
+    {
+        // the server may not support pipelining, fall back to sending the requests one by one
+        if (impl->pipe.maxn > 1) impl->pipe.maxn = 1;
+        // failed again? notify the front request
+        else if (impl->pipe.tryn++)
+        {
+            impl->pipe.tryn = 0;
+            tb_aicp_http_pipe_notify(impl, state, tb_null, 0);
+        }
+    }
+
+    // not keep alive
+    impl->status.balived = 0;
+    tb_async_stream_ctrl(impl->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+
+    // the left items count
+    tb_spinlock_enter(&impl->pipe.lock);
+    tb_size_t left = impl->pipe.items? tb_queue_size(impl->pipe.items) : 0;
+    tb_spinlock_leave(&impl->pipe.lock);
+
+    // no left items? close it
+    if (!left) tb_aicp_http_pipe_clos(impl, TB_STATE_OK);
+    // send the left requests again on a new connection
+    else if (!tb_aicp_http_pipe_conn(impl))
+    {
+        impl->pipe.state = state;
+        tb_aicp_http_pipe_stop(impl);
+    }
+}
+static tb_bool_t tb_aicp_http_pipe_resp(tb_aicp_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // trace
+    tb_trace_d("pipe: resp: code: %lu, size: %lu, alived: %u", impl->status.code, tb_buffer_size(&impl->pipe.data), impl->status.balived);
+
+    // the response count of this connection
+    impl->pipe.resp++;
+    impl->pipe.tryn = 0;
+
+    // will the connection be closed by the server?
+    tb_bool_t balived = impl->status.balived? tb_true : tb_false;
+
+    // notify the front request
+    tb_aicp_http_pipe_notify(impl, impl->status.state, tb_buffer_data(&impl->pipe.data), tb_buffer_size(&impl->pipe.data));
+
+    // clear the response
+    tb_aicp_http_pipe_clear(impl);
+
+    // closed? send the left requests on a new connection
+    if (!balived)
+    {
+        tb_aicp_http_pipe_break(impl, TB_STATE_CLOSED);
+        return tb_false;
+    }
+
+    // all sent requests have been responded? send the next requests
+    if (!impl->pipe.sent)
+    {
+        tb_aicp_http_pipe_writ(impl);
+        return tb_false;
+    }
+
+    // continue to parse the next response
+    return tb_true;
+}
+static tb_long_t tb_aicp_http_pipe_line(tb_aicp_http_impl_t* impl, tb_char_t const* line, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(impl && line, -1);
+
+    // done
+    switch (impl->pipe.step)
+    {
+    case TB_AICP_HTTP_PIPE_STEP_HEAD:
+        {
+            // skip the empty lines before the status line
+            if (!size && !impl->line_size) return 0;
+
+            // trace
+            tb_trace_d("pipe: response: %s", line);
+
+            // do callback
+            if (impl->option.head_func && !impl->option.head_func(line, impl->option.head_priv)) return -1;
+
+            // end?
+            if (!size)
+            {
+                // clear line size
+                impl->line_size = 0;
+
+                // 1xx? the final response will be followed
+                if (impl->status.code < 200)
+                {
+                    tb_http_status_cler(&impl->status, tb_false);
+                    return 0;
+                }
+
+                // no content?
+                if (impl->status.code == 204 || impl->status.code == 304) return 1;
+
+                // chunked?
+                if (impl->status.bchunked)
+                {
+                    impl->pipe.step = TB_AICP_HTTP_PIPE_STEP_CHUNK_HEAD;
+                    return 0;
+                }
+
+                // the content size is known?
+                if (impl->status.content_size >= 0)
+                {
+                    impl->pipe.left = impl->status.content_size;
+                    impl->pipe.step = TB_AICP_HTTP_PIPE_STEP_DATA;
+                    return impl->pipe.left? 0 : 1;
+                }
+
+                // the content is ended by closing the connection
+                impl->status.balived = 0;
+                impl->pipe.step = TB_AICP_HTTP_PIPE_STEP_DATA_ALL;
+                return 0;
+            }
+
+            // done the head response, the 4xx and 5xx response will also be notified
+            if (!tb_aicp_http_head_resp_done(impl) && (impl->line_size || impl->status.code < 400)) return -1;
+
+            // line++
+            impl->line_size++;
+        }
+        break;
+    case TB_AICP_HTTP_PIPE_STEP_CHUNK_HEAD:
+        {
+            // skip the empty line
+            tb_check_return_val(size, 0);
+
+            // the chunk size, the last chunk if be zero
+            impl->pipe.left = tb_s16tou64(line);
+            impl->pipe.step = impl->pipe.left? TB_AICP_HTTP_PIPE_STEP_CHUNK_DATA : TB_AICP_HTTP_PIPE_STEP_CHUNK_TRAILER;
+        }
+        break;
+    case TB_AICP_HTTP_PIPE_STEP_CHUNK_TAIL:
+        {
+            // check
+            tb_assert_and_check_return_val(!size, -1);
+
+            // the next chunk
+            impl->pipe.step = TB_AICP_HTTP_PIPE_STEP_CHUNK_HEAD;
+        }
+        break;
+    case TB_AICP_HTTP_PIPE_STEP_CHUNK_TRAILER:
+        // end?
+        return size? 0 : 1;
+    default:
+        tb_assert_and_check_return_val(0, -1);
+    }
+
+    // continue
+    return 0;
+}
+static tb_bool_t tb_aicp_http_pipe_read_func(tb_async_stream_ref_t stream, tb_size_t state, tb_byte_t const* data, tb_size_t real, tb_size_t size, tb_cpointer_t priv)
+{
+    // check
+    tb_aicp_http_impl_t* impl = (tb_aicp_http_impl_t*)priv;
+    tb_assert_and_check_return_val(impl && impl->stream, tb_false);
+
+    // trace
+    tb_trace_d("pipe: read: real: %lu, size: %lu, state: %s", real, size, tb_state_cstr(state));
+
+    // killed?
+    if (TB_STATE_KILLING == tb_atomic_get(&impl->state))
+    {
+        tb_aicp_http_pipe_clos(impl, TB_STATE_KILLED);
+        return tb_false;
+    }
+
+    // failed or closed?
+    if (state != TB_STATE_OK)
+    {
+        // the content is ended by closing the connection? done this response
+        if (state == TB_STATE_CLOSED && impl->pipe.step == TB_AICP_HTTP_PIPE_STEP_DATA_ALL)
+            tb_aicp_http_pipe_resp(impl);
+        // send the left requests again on a new connection
+        else tb_aicp_http_pipe_break(impl, state);
+        return tb_false;
+    }
+
+    // walk
+    tb_char_t const*    p = (tb_char_t const*)data;
+    tb_char_t const*    e = p + real;
+    while (p < e)
+    {
+        // the content data?
+        tb_size_t step = impl->pipe.step;
+        if (    step == TB_AICP_HTTP_PIPE_STEP_DATA
+            ||  step == TB_AICP_HTTP_PIPE_STEP_DATA_ALL
+            ||  step == TB_AICP_HTTP_PIPE_STEP_CHUNK_DATA)
+        {
+            // the data size
+            tb_size_t n = e - p;
+            if (step != TB_AICP_HTTP_PIPE_STEP_DATA_ALL && n > impl->pipe.left) n = (tb_size_t)impl->pipe.left;
+
+            // save data
+            tb_buffer_memncat(&impl->pipe.data, (tb_byte_t const*)p, n);
+            p += n;
+
+            // the left size
+            if (step == TB_AICP_HTTP_PIPE_STEP_DATA_ALL) continue;
+            impl->pipe.left -= n;
+            tb_check_continue(!impl->pipe.left);
+
+            // the chunk end?
+            if (step == TB_AICP_HTTP_PIPE_STEP_CHUNK_DATA) impl->pipe.step = TB_AICP_HTTP_PIPE_STEP_CHUNK_TAIL;
+            // the response end?
+            else if (!tb_aicp_http_pipe_resp(impl)) return tb_false;
+            continue;
+        }
+
+        // the char
+        tb_char_t ch = *p++;
+
+        // append char to line
+        if (ch != '\n')
+        {
+            tb_string_chrcat(&impl->line_data, ch);
+            continue;
+        }
+
+        // strip '\r' if exists
+        tb_char_t const*    pb = tb_string_cstr(&impl->line_data);
+        tb_size_t           pn = tb_string_size(&impl->line_data);
+        if (pb && pn && pb[pn - 1] == '\r') tb_string_strip(&impl->line_data, --pn);
+
+        // done line
+        tb_long_t ok = pb? tb_aicp_http_pipe_line(impl, pb, pn) : -1;
+
+        // clear line data
+        tb_string_clear(&impl->line_data);
+
+        // failed?
+        if (ok < 0)
+        {
+            tb_aicp_http_pipe_clos(impl, TB_STATE_HTTP_UNKNOWN_ERROR);
+            return tb_false;
+        }
+        // the response end?
+        else if (ok > 0 && !tb_aicp_http_pipe_resp(impl)) return tb_false;
+    }
+
+    // continue to read
+    return tb_true;
+}
+static tb_bool_t tb_aicp_http_pipe_writ_func(tb_async_stream_ref_t stream, tb_size_t state, tb_byte_t const* data, tb_size_t real, tb_size_t size, tb_cpointer_t priv)
+{
+    // check
+    tb_aicp_http_impl_t* impl = (tb_aicp_http_impl_t*)priv;
+    tb_assert_and_check_return_val(impl && impl->stream, tb_false);
+
+    // trace
+    tb_trace_d("pipe: writ: real: %lu, size: %lu, state: %s", real, size, tb_state_cstr(state));
+
+    // killed?
+    if (TB_STATE_KILLING == tb_atomic_get(&impl->state))
+    {
+        tb_aicp_http_pipe_clos(impl, TB_STATE_KILLED);
+        return tb_false;
+    }
+
+    // failed? the reused connection may have been closed by the server
+    if (state != TB_STATE_OK)
+    {
+        tb_aicp_http_pipe_break(impl, state);
+        return tb_false;
+    }
+
+    // not finished? continue it
+    tb_check_return_val(real >= size, tb_true);
+
+    // read the responses
+    if (!tb_async_stream_read(impl->stream, 0, tb_aicp_http_pipe_read_func, impl))
+        tb_aicp_http_pipe_break(impl, TB_STATE_HTTP_UNKNOWN_ERROR);
+
+    // ok
+    return tb_false;
+}
+static tb_void_t tb_aicp_http_pipe_writ(tb_aicp_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->stream);
+
+    // clear the head data
+    tb_buffer_clear(&impl->pipe.head);
+
+    // enter
+    tb_spinlock_enter(&impl->pipe.lock);
+
+    // make the head data of the front items
+    tb_size_t sent = 0;
+    tb_size_t left = 0;
+    tb_size_t state = TB_STATE_HTTP_UNKNOWN_ERROR;
+    if (impl->pipe.items)
+    {
+        // the left count
+        left = tb_queue_size(impl->pipe.items);
+
+        // walk items
+        tb_for_all (tb_aicp_http_pipe_item_t*, item, impl->pipe.items)
+        {
+            // enough?
+            tb_check_break(item && sent < impl->pipe.maxn);
+
+            // make head
+            tb_size_t           head_size = 0;
+            tb_char_t const*    head_data = tb_aicp_http_head_format(impl, item->path, item->args, 0, &head_size, &state);
+            tb_check_break(head_data && head_size);
+
+            // append head
+            tb_buffer_memncat(&impl->pipe.head, (tb_byte_t const*)head_data, head_size);
+            sent++;
+        }
+    }
+
+    // save the sent count
+    impl->pipe.sent = sent;
+
+    // leave
+    tb_spinlock_leave(&impl->pipe.lock);
+
+    // no requests? close it
+    if (!sent)
+    {
+        tb_aicp_http_pipe_clos(impl, left? state : TB_STATE_OK);
+        return ;
+    }
+
+    // trace
+    tb_trace_d("pipe: writ: %lu requests, %lu bytes", sent, tb_buffer_size(&impl->pipe.head));
+
+    // clear the response
+    tb_aicp_http_pipe_clear(impl);
+
+    // writ the requests back-to-back
+    if (!tb_async_stream_writ(impl->stream, tb_buffer_data(&impl->pipe.head), tb_buffer_size(&impl->pipe.head), tb_aicp_http_pipe_writ_func, impl))
+        tb_aicp_http_pipe_break(impl, TB_STATE_HTTP_UNKNOWN_ERROR);
+}
+static tb_bool_t tb_aicp_http_pipe_open_func(tb_async_stream_ref_t stream, tb_size_t state, tb_cpointer_t priv)
+{
+    // check
+    tb_aicp_http_impl_t* impl = (tb_aicp_http_impl_t*)priv;
+    tb_assert_and_check_return_val(impl && impl->stream, tb_false);
+
+    // trace
+    tb_trace_d("pipe: open: %s, reused: %u", tb_state_cstr(state), impl->pipe.breused);
+
+    // killed?
+    if (TB_STATE_KILLING == tb_atomic_get(&impl->state)) state = TB_STATE_KILLED;
+
+    // failed?
+    if (state != TB_STATE_OK) tb_aicp_http_pipe_clos(impl, state);
+    else
+    {
+        // opened
+        tb_atomic_pset(&impl->state, TB_STATE_OPENING, TB_STATE_OPENED);
+
+        // writ the requests
+        tb_aicp_http_pipe_writ(impl);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_aicp_http_pipe_conn_func(tb_async_stream_ref_t stream, tb_size_t state, tb_cpointer_t priv)
+{
+    // check
+    tb_aicp_http_impl_t* impl = (tb_aicp_http_impl_t*)priv;
+    tb_assert_and_check_return(impl && impl->stream);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // ok?
+        tb_check_break(state == TB_STATE_OK);
+
+        // killed?
+        if (TB_STATE_KILLING == tb_atomic_get(&impl->state))
+        {
+            state = TB_STATE_KILLED;
+            break;
+        }
+
+        // reset state
+        state = TB_STATE_HTTP_UNKNOWN_ERROR;
+
+        // prepare to open the stream
+        if (!tb_aicp_http_open_prep(impl)) break;
+
+        // clear the pipe of this connection, the sent items without response will be sent again
+        impl->pipe.sent     = 0;
+        impl->pipe.resp     = 0;
+        impl->pipe.breused  = impl->status.balived;
+
+        // open the stream
+        ok = tb_async_stream_open(impl->stream, tb_aicp_http_pipe_open_func, impl);
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        impl->pipe.state = state;
+        tb_aicp_http_pipe_stop(impl);
+    }
+}
+static tb_bool_t tb_aicp_http_pipe_conn(tb_aicp_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->stream, tb_false);
+
+    // trace
+    tb_trace_d("pipe: conn: %s: ..", tb_url_cstr(&impl->option.url));
+
+    // close the last connection and open it again
+    return tb_async_stream_clos(impl->stream, tb_aicp_http_pipe_conn_func, impl);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -1394,6 +2321,11 @@ tb_aicp_http_ref_t tb_aicp_http_init(tb_aicp_ref_t aicp)
         // init status
         if (!tb_http_status_init(&impl->status)) break;
 
+        // init pipe
+        if (!tb_spinlock_init(&impl->pipe.lock)) break;
+        if (!tb_buffer_init(&impl->pipe.head)) break;
+        if (!tb_buffer_init(&impl->pipe.data)) break;
+
         // ok
         ok = tb_true;
 
@@ -1476,6 +2408,16 @@ tb_bool_t tb_aicp_http_exit(tb_aicp_http_ref_t http)
     // exit stream
     impl->stream = tb_null;
 
+    // exit the left pipe items
+    while (tb_aicp_http_pipe_notify(impl, TB_STATE_KILLED, tb_null, 0)) ;
+    if (impl->pipe.items) tb_queue_exit(impl->pipe.items);
+    impl->pipe.items = tb_null;
+
+    // exit pipe
+    tb_buffer_exit(&impl->pipe.data);
+    tb_buffer_exit(&impl->pipe.head);
+    tb_spinlock_exit(&impl->pipe.lock);
+
     // exit status
     tb_http_status_exit(&impl->status);
 
@@ -1580,6 +2522,15 @@ tb_bool_t tb_aicp_http_clos_try(tb_aicp_http_ref_t http)
             break;
         }
 
+        // the pipe is running? wait it
+        tb_spinlock_enter(&impl->pipe.lock);
+        tb_bool_t brunning = impl->pipe.brunning;
+        tb_spinlock_leave(&impl->pipe.lock);
+        if (brunning) break;
+
+        // check the alived connection before closing it
+        tb_aicp_http_alive_check(impl);
+
         // try closing transfer
         if (impl->transfer && !tb_async_transfer_clos_try(impl->transfer)) break;
 
@@ -1638,6 +2589,14 @@ tb_bool_t tb_aicp_http_read_after(tb_aicp_http_ref_t http, tb_size_t delay, tb_s
 
         // break?
         tb_check_return_val(ok, tb_true);
+
+        // end? the alived connection will not be closed by the server
+        if (impl->status.content_size >= 0 && impl->content_read >= (tb_hize_t)impl->status.content_size)
+        {
+            // done func: closed
+            func(http, TB_STATE_CLOSED, cache_data, 0, cache_size, priv);
+            return tb_true;
+        }
     }
 
     // init read
@@ -1730,6 +2689,93 @@ tb_bool_t tb_aicp_http_open_seek(tb_aicp_http_ref_t http, tb_hize_t offset, tb_a
     // open and seek
     return tb_aicp_http_seek(http, offset, func, priv);
 }
+tb_bool_t tb_aicp_http_pipe(tb_aicp_http_ref_t http, tb_char_t const* path, tb_aicp_http_pipe_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_aicp_http_impl_t* impl = (tb_aicp_http_impl_t*)http;
+    tb_assert_and_check_return_val(impl && impl->stream && path && func, tb_false);
+
+    // only for the get method
+    tb_assert_and_check_return_val(impl->option.method == TB_HTTP_METHOD_GET, tb_false);
+
+    // make item
+    tb_aicp_http_pipe_item_t item;
+    item.func = func;
+    item.priv = priv;
+    item.path = tb_strdup(path);
+    item.args = tb_null;
+    tb_assert_and_check_return_val(item.path, tb_false);
+
+    // split the path and args
+    tb_char_t* args = tb_strchr(item.path, '?');
+    if (args)
+    {
+        *args++ = '\0';
+        if (*args) item.args = args;
+    }
+
+    // enter
+    tb_spinlock_enter(&impl->pipe.lock);
+
+    // done
+    tb_bool_t ok = tb_false;
+    tb_bool_t bconn = tb_false;
+    do
+    {
+        // not running? start it
+        if (!impl->pipe.brunning)
+        {
+            // opening it, the http must be closed
+            tb_size_t state = tb_atomic_fetch_and_pset(&impl->state, TB_STATE_CLOSED, TB_STATE_OPENING);
+            tb_check_break(state == TB_STATE_CLOSED);
+
+            // init items
+            if (!impl->pipe.items) impl->pipe.items = tb_queue_init(0, tb_element_mem(sizeof(tb_aicp_http_pipe_item_t), tb_aicp_http_pipe_item_free, tb_null));
+            if (!impl->pipe.items)
+            {
+                tb_atomic_set(&impl->state, TB_STATE_CLOSED);
+                break;
+            }
+
+            // init pipe
+            impl->pipe.maxn     = TB_AICP_HTTP_PIPE_MAXN;
+            impl->pipe.tryn     = 0;
+            impl->pipe.sent     = 0;
+            impl->pipe.state    = TB_STATE_OK;
+            impl->pipe.brunning = 1;
+
+            // connect it
+            bconn = tb_true;
+        }
+
+        // put item
+        tb_queue_put(impl->pipe.items, &item);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&impl->pipe.lock);
+
+    // failed?
+    if (!ok)
+    {
+        // trace
+        tb_trace_e("pipe: %s: the http is not closed!", path);
+
+        // exit path
+        tb_free(item.path);
+        return tb_false;
+    }
+
+    // trace
+    tb_trace_d("pipe: %s: ..", path);
+
+    // connect it if be not running
+    return bconn? tb_aicp_http_pipe_conn(impl) : tb_true;
+}
 tb_aicp_ref_t tb_aicp_http_aicp(tb_aicp_http_ref_t http)
 {
     // check
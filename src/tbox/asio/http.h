@@ -97,6 +97,19 @@ typedef tb_bool_t   (*tb_aicp_http_seek_func_t)(tb_aicp_http_ref_t http, tb_size
  */
 typedef tb_bool_t   (*tb_aicp_http_task_func_t)(tb_aicp_http_ref_t http, tb_size_t state, tb_cpointer_t priv);
 
+/*! the aicp http pipe func type
+ *
+ * @param http      the http handle
+ * @param state     the state, .e.g ok, killed or the state of the http response
+ * @param status    the http status of this response
+ * @param data      the whole content data of this response
+ * @param size      the content size
+ * @param priv      the func private data
+ *
+ * @return          tb_true: ok, tb_false: error, but not break aicp
+ */
+typedef tb_bool_t   (*tb_aicp_http_pipe_func_t)(tb_aicp_http_ref_t http, tb_size_t state, tb_http_status_t const* status, tb_byte_t const* data, tb_size_t size, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -218,6 +231,35 @@ tb_bool_t           tb_aicp_http_open_read(tb_aicp_http_ref_t http, tb_size_t si
  */
 tb_bool_t           tb_aicp_http_open_seek(tb_aicp_http_ref_t http, tb_hize_t offset, tb_aicp_http_seek_func_t func, tb_cpointer_t priv);
 
+/*! pipeline the GET request to the host of the http url
+ *
+ * the queued requests are written back-to-back on one connection and the responses are notified in order,
+ * the requests without response will be sent again on a new connection if the server closes it,
+ * and it will fall back to sending them one by one if the server closes the new connection without any response.
+ *
+ * the http must be closed or be pipelining, and kill or exit it to cancel the left requests.
+ *
+ * @code
+ * tb_bool_t tb_aicp_http_pipe_func(tb_aicp_http_ref_t http, tb_size_t state, tb_http_status_t const* status, tb_byte_t const* data, tb_size_t size, tb_cpointer_t priv)
+ * {
+ *      tb_trace_i("pipe: %s: %s: %lu bytes", (tb_char_t const*)priv, tb_state_cstr(state), size);
+ *      return tb_true;
+ * }
+ *
+ * tb_aicp_http_ctrl(http, TB_HTTP_OPTION_SET_URL, "http://www.xxx.com");
+ * tb_aicp_http_pipe(http, "/a.png", tb_aicp_http_pipe_func, "a");
+ * tb_aicp_http_pipe(http, "/b.png?size=small", tb_aicp_http_pipe_func, "b");
+ * @endcode
+ *
+ * @param http      the http
+ * @param path      the request path with the args, .e.g "/a/b.png?size=small"
+ * @param func      the func
+ * @param priv      the func data
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_aicp_http_pipe(tb_aicp_http_ref_t http, tb_char_t const* path, tb_aicp_http_pipe_func_t func, tb_cpointer_t priv);
+
 /*! the http aicp
  *
  * @param http      the http
@@ -0,0 +1,1327 @@
+/*!The Treasure Box Library
+ *
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox;
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ *
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        httpd.c
+ * @ingroup     asio
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "aicp_httpd"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "httpd.h"
+#include "aico.h"
+#include "aicp.h"
+#include "../libc/libc.h"
+#include "../network/network.h"
+#include "../platform/platform.h"
+#include "../container/container.h"
+#include "../algorithm/algorithm.h"
+#include "../network/impl/http/date.h"
+#include "../network/impl/http/method.h"
+#include "../network/impl/http/status.h"
+#include "../network/impl/http/request.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the session buffer maxn, the request head and content must be less than it
+#ifdef __tb_small__
+#   define TB_AICP_HTTPD_SESSION_BUFF_MAXN      (4096)
+#else
+#   define TB_AICP_HTTPD_SESSION_BUFF_MAXN      (8192)
+#endif
+
+// the session timeout, 15s
+#define TB_AICP_HTTPD_SESSION_TIMEOUT           (15000)
+
+// the body buffer maxn for the streaming response
+#ifdef __tb_small__
+#   define TB_AICP_HTTPD_BODY_MAXN              (8192)
+#else
+#   define TB_AICP_HTTPD_BODY_MAXN              (32768)
+#endif
+
+// the chunk head maxn, .e.g "ffff\r\n"
+#define TB_AICP_HTTPD_CHUNK_HEAD_MAXN           (16)
+
+// the listen backlog
+#define TB_AICP_HTTPD_BACKLOG                   (1024)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the aicp httpd session wait enum
+typedef enum __tb_aicp_httpd_wait_e
+{
+    TB_AICP_HTTPD_WAIT_NONE     = 0 //!< sending, receiving or handling
+,   TB_AICP_HTTPD_WAIT_RESP     = 1 //!< wait the response of the request
+,   TB_AICP_HTTPD_WAIT_BODY     = 2 //!< wait the body data, the body is paused
+,   TB_AICP_HTTPD_WAIT_RESUME   = 3 //!< the body has been resumed before pausing it
+
+}tb_aicp_httpd_wait_e;
+
+// the aicp httpd impl type
+typedef struct __tb_aicp_httpd_impl_t
+{
+    // the aicp
+    tb_aicp_ref_t                   aicp;
+
+    // the listen aico
+    tb_aico_ref_t                   aico;
+
+    // the listen address
+    tb_ipaddr_t                     addr;
+
+    // the request func
+    tb_aicp_httpd_func_t            func;
+
+    // the request func private data
+    tb_cpointer_t                   priv;
+
+    // the state
+    tb_atomic_t                     state;
+
+    // is listening?
+    tb_atomic_t                     listening;
+
+    // the lock
+    tb_spinlock_t                   lock;
+
+    // the sessions
+    tb_list_entry_head_t            sessions;
+
+}tb_aicp_httpd_impl_t;
+
+// the aicp httpd session type
+typedef struct __tb_aicp_httpd_session_t
+{
+    // the list entry
+    tb_list_entry_t                 entry;
+
+    // the httpd
+    tb_aicp_httpd_impl_t*           httpd;
+
+    // the aico
+    tb_aico_ref_t                   aico;
+
+    // the wait state
+    tb_atomic_t                     wait;
+
+    // the request
+    tb_http_request_t               request;
+
+    // the received data size
+    tb_size_t                       rsize;
+
+    // the data size of the current request, including the head and content
+    tb_size_t                       rused;
+
+    // the response head
+    tb_buffer_t                     head;
+
+    // the extra response heads
+    tb_buffer_t                     extra;
+
+    // the response file
+    tb_file_ref_t                   file;
+
+    // the response file offset
+    tb_hize_t                       file_seek;
+
+    // the response file left size
+    tb_hize_t                       file_left;
+
+    // the response body func
+    tb_aicp_httpd_body_func_t       body_func;
+
+    // the response body func private data
+    tb_cpointer_t                   body_priv;
+
+    // the response body left size, -1 if unknown
+    tb_hong_t                       body_left;
+
+    // the response body data
+    tb_byte_t*                      body_data;
+
+    // the cached date
+    tb_time_t                       date;
+
+    // the cached date cstring
+    tb_char_t                       date_cstr[32];
+
+    // keep alive after the response?
+    tb_uint8_t                      balived     : 1;
+
+    // is chunked response?
+    tb_uint8_t                      bchunked    : 1;
+
+    // has the body of the response?
+    tb_uint8_t                      bcontent    : 1;
+
+    // has sent 100-continue?
+    tb_uint8_t                      bcontinue   : 1;
+
+    // has parsed the request head? it has been terminated in place and cannot be parsed again
+    tb_uint8_t                      bheaded     : 1;
+
+    // the request data
+    tb_byte_t                       data[TB_AICP_HTTPD_SESSION_BUFF_MAXN];
+
+}tb_aicp_httpd_session_t;
+
+// the aicp httpd mime type
+typedef struct __tb_aicp_httpd_mime_t
+{
+    // the file extension
+    tb_char_t const*                extension;
+
+    // the content type
+    tb_char_t const*                type;
+
+}tb_aicp_httpd_mime_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the mimes
+static tb_aicp_httpd_mime_t const g_mimes[] =
+{
+    {"css",     "text/css"                  }
+,   {"gif",     "image/gif"                 }
+,   {"htm",     "text/html"                 }
+,   {"html",    "text/html"                 }
+,   {"ico",     "image/x-icon"              }
+,   {"jpeg",    "image/jpeg"                }
+,   {"jpg",     "image/jpeg"                }
+,   {"js",      "application/javascript"    }
+,   {"json",    "application/json"          }
+,   {"pdf",     "application/pdf"           }
+,   {"png",     "image/png"                 }
+,   {"svg",     "image/svg+xml"             }
+,   {"txt",     "text/plain"                }
+,   {"xml",     "text/xml"                  }
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+static tb_void_t tb_aicp_httpd_session_next(tb_aicp_httpd_session_t* session);
+static tb_void_t tb_aicp_httpd_body_next(tb_aicp_httpd_session_t* session);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_char_t const* tb_aicp_httpd_mime(tb_char_t const* path)
+{
+    // the file extension
+    tb_char_t const* extension = tb_strrchr(path, '.');
+    if (extension && !tb_strchr(extension, '/'))
+    {
+        // find it
+        tb_size_t i = 0;
+        for (i = 0; i < tb_arrayn(g_mimes); i++)
+        {
+            if (!tb_stricmp(g_mimes[i].extension, extension + 1)) return g_mimes[i].type;
+        }
+    }
+
+    // the default type
+    return "application/octet-stream";
+}
+static tb_bool_t tb_aicp_httpd_aico_clos_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_CLOS, tb_false);
+
+    // exit aico
+    tb_aico_exit(aice->aico);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_aicp_httpd_session_exit(tb_aicp_httpd_session_t* session)
+{
+    // check
+    tb_assert_and_check_return(session);
+
+    // the body is not finished? notify it
+    if (session->body_func) session->body_func((tb_aicp_httpd_session_ref_t)session, tb_null, 0, session->body_priv);
+    session->body_func = tb_null;
+
+    // exit file
+    if (session->file) tb_file_exit(session->file);
+    session->file = tb_null;
+
+    // exit body data
+    if (session->body_data) tb_free(session->body_data);
+    session->body_data = tb_null;
+
+    // exit head
+    tb_buffer_exit(&session->head);
+    tb_buffer_exit(&session->extra);
+
+    // exit it
+    tb_free(session);
+}
+static tb_bool_t tb_aicp_httpd_session_clos_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_CLOS, tb_false);
+
+    // the session
+    tb_aicp_httpd_session_t* session = (tb_aicp_httpd_session_t*)aice->priv;
+    tb_assert_and_check_return_val(session && session->httpd, tb_false);
+
+    // trace
+    tb_trace_d("session[%p]: clos: %s", aice->aico, tb_state_cstr(aice->state));
+
+    // remove it first, the killing httpd will not access the exited aico
+    tb_aicp_httpd_impl_t* httpd = session->httpd;
+    tb_spinlock_enter(&httpd->lock);
+    tb_list_entry_remove(&httpd->sessions, &session->entry);
+    session->aico = tb_null;
+    tb_spinlock_leave(&httpd->lock);
+
+    // exit aico
+    tb_aico_exit(aice->aico);
+
+    // exit it
+    tb_aicp_httpd_session_exit(session);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_aicp_httpd_session_clos(tb_aicp_httpd_session_t* session)
+{
+    // check
+    tb_assert_and_check_return(session && session->aico);
+
+    // trace
+    tb_trace_d("session[%p]: clos: ..", session->aico);
+
+    // close it
+    tb_aico_clos(session->aico, tb_aicp_httpd_session_clos_func, session);
+}
+static tb_bool_t tb_aicp_httpd_session_kill_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->code == TB_AICE_CODE_RUNTASK, tb_false);
+
+    // the session
+    tb_aicp_httpd_session_t* session = (tb_aicp_httpd_session_t*)aice->priv;
+    tb_assert_and_check_return_val(session, tb_false);
+
+    // close it
+    tb_aicp_httpd_session_clos(session);
+
+    // ok
+    return tb_true;
+}
+static tb_aicp_httpd_session_t* tb_aicp_httpd_session_init(tb_aicp_httpd_impl_t* httpd, tb_aico_ref_t aico)
+{
+    // check
+    tb_assert_and_check_return_val(httpd && aico, tb_null);
+
+    // make session
+    tb_aicp_httpd_session_t* session = tb_malloc0_type(tb_aicp_httpd_session_t);
+    tb_assert_and_check_return_val(session, tb_null);
+
+    // init session
+    session->httpd  = httpd;
+    session->aico   = aico;
+    session->wait   = TB_AICP_HTTPD_WAIT_NONE;
+
+    // init head
+    tb_buffer_init(&session->head);
+    tb_buffer_init(&session->extra);
+
+    // init timeout
+    tb_aico_timeout_set(aico, TB_AICO_TIMEOUT_RECV, TB_AICP_HTTPD_SESSION_TIMEOUT);
+    tb_aico_timeout_set(aico, TB_AICO_TIMEOUT_SEND, TB_AICP_HTTPD_SESSION_TIMEOUT);
+
+    // send the small responses immediately
+    tb_socket_ctrl(tb_aico_sock(aico), TB_SOCKET_CTRL_SET_TCP_NODELAY, tb_true);
+
+    // ok
+    return session;
+}
+static tb_bool_t tb_aicp_httpd_session_recv_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_RECV, tb_false);
+
+    // the session
+    tb_aicp_httpd_session_t* session = (tb_aicp_httpd_session_t*)aice->priv;
+    tb_assert_and_check_return_val(session && session->httpd, tb_false);
+
+    // trace
+    tb_trace_d("session[%p]: recv: real: %lu, state: %s", aice->aico, aice->u.recv.real, tb_state_cstr(aice->state));
+
+    // closed, killed or timeout?
+    if (aice->state != TB_STATE_OK || TB_STATE_OK != tb_atomic_get(&session->httpd->state))
+    {
+        tb_aicp_httpd_session_clos(session);
+        return tb_true;
+    }
+
+    // save the received size
+    session->rsize += aice->u.recv.real;
+    tb_assert(session->rsize <= sizeof(session->data));
+
+    // handle the received requests
+    tb_aicp_httpd_session_next(session);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_aicp_httpd_session_recv(tb_aicp_httpd_session_t* session)
+{
+    // check
+    tb_assert_and_check_return(session && session->aico && session->rsize < sizeof(session->data));
+
+    // recv data
+    if (!tb_aico_recv(session->aico, session->data + session->rsize, sizeof(session->data) - session->rsize, tb_aicp_httpd_session_recv_func, session))
+        tb_aicp_httpd_session_clos(session);
+}
+static tb_bool_t tb_aicp_httpd_session_continue_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // the session
+    tb_aicp_httpd_session_t* session = (tb_aicp_httpd_session_t*)aice->priv;
+    tb_assert_and_check_return_val(session, tb_false);
+
+    // failed?
+    if (aice->state != TB_STATE_OK) tb_aicp_httpd_session_clos(session);
+    // continue to send it
+    else if (aice->u.send.real < aice->u.send.size)
+    {
+        if (!tb_aico_send(aice->aico, aice->u.send.data + aice->u.send.real, aice->u.send.size - aice->u.send.real, tb_aicp_httpd_session_continue_func, session))
+            tb_aicp_httpd_session_clos(session);
+    }
+    // recv the request content
+    else tb_aicp_httpd_session_recv(session);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_aicp_httpd_head_check(tb_char_t const* cstr, tb_bool_t bname)
+{
+    // the line breaks will inject the response heads, and the name cannot contain ':'
+    for (; *cstr; cstr++)
+    {
+        if (*cstr == '\r' || *cstr == '\n' || (bname && *cstr == ':')) return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_aicp_httpd_head_cat(tb_buffer_ref_t head, tb_char_t const* name, tb_char_t const* data)
+{
+    tb_buffer_memncat(head, (tb_byte_t const*)name, tb_strlen(name));
+    tb_buffer_memncat(head, (tb_byte_t const*)": ", 2);
+    tb_buffer_memncat(head, (tb_byte_t const*)data, tb_strlen(data));
+    tb_buffer_memncat(head, (tb_byte_t const*)"\r\n", 2);
+}
+static tb_void_t tb_aicp_httpd_resp_init(tb_aicp_httpd_session_t* session, tb_size_t code, tb_char_t const* type, tb_hong_t size, tb_time_t mtime)
+{
+    // check
+    tb_assert_and_check_return(session && session->httpd);
+
+    // the request
+    tb_http_request_t const* request = &session->request;
+
+    // keep alive?
+    session->balived = request->balived && TB_STATE_OK == tb_atomic_get(&session->httpd->state);
+
+    // has content?
+    session->bcontent = request->method != TB_HTTP_METHOD_HEAD && code >= 200 && code != TB_HTTP_CODE_NO_CONTENT && code != TB_HTTP_CODE_NOT_MODIFIED;
+
+    // the unknown content size? use the chunked encoding for HTTP/1.1 and close the connection for HTTP/1.0
+    session->bchunked = 0;
+    if (size < 0)
+    {
+        if (request->version) session->bchunked = 1;
+        else session->balived = 0;
+    }
+
+    // update the cached date
+    tb_time_t now = tb_cache_time();
+    if (now != session->date || !session->date_cstr[0])
+    {
+        session->date = now;
+        if (!tb_http_date_to_cstr(now, session->date_cstr, sizeof(session->date_cstr))) session->date_cstr[0] = '\0';
+    }
+
+    // the status line
+    tb_char_t data[64];
+    tb_long_t real = tb_snprintf(data, sizeof(data) - 1, "HTTP/1.%u %lu %s\r\n", request->version, code, tb_http_status_code_cstr(code));
+    tb_assert_and_check_return(real > 0);
+
+    // init head
+    tb_buffer_ref_t head = &session->head;
+    tb_buffer_memncpy(head, (tb_byte_t const*)data, real);
+    tb_aicp_httpd_head_cat(head, "Server", TB_VERSION_SHORT_STRING);
+    if (session->date_cstr[0]) tb_aicp_httpd_head_cat(head, "Date", session->date_cstr);
+
+    // the content type and size, no content for 204 and 304
+    if (code >= 200 && code != TB_HTTP_CODE_NO_CONTENT && code != TB_HTTP_CODE_NOT_MODIFIED)
+    {
+        // the content type
+        tb_aicp_httpd_head_cat(head, "Content-Type", type? type : "text/html");
+
+        // the content size
+        if (size >= 0)
+        {
+            real = tb_snprintf(data, sizeof(data) - 1, "%lld", size);
+            if (real > 0)
+            {
+                data[real] = '\0';
+                tb_aicp_httpd_head_cat(head, "Content-Length", data);
+            }
+        }
+        else if (session->bchunked) tb_aicp_httpd_head_cat(head, "Transfer-Encoding", "chunked");
+    }
+
+    // the last modified date
+    if (mtime && tb_http_date_to_cstr(mtime, data, sizeof(data))) tb_aicp_httpd_head_cat(head, "Last-Modified", data);
+
+    // the connection
+    tb_aicp_httpd_head_cat(head, "Connection", session->balived? "keep-alive" : "close");
+
+    // the extra heads
+    if (tb_buffer_size(&session->extra)) tb_buffer_memncat(head, tb_buffer_data(&session->extra), tb_buffer_size(&session->extra));
+    tb_buffer_clear(&session->extra);
+
+    // end
+    tb_buffer_memncat(head, (tb_byte_t const*)"\r\n", 2);
+}
+static tb_void_t tb_aicp_httpd_resp_done(tb_aicp_httpd_session_t* session)
+{
+    // check
+    tb_assert_and_check_return(session);
+
+    // trace
+    tb_trace_d("session[%p]: resp: done, alived: %u", session->aico, session->balived);
+
+    // exit file
+    if (session->file) tb_file_exit(session->file);
+    session->file = tb_null;
+
+    // clear body
+    session->body_func = tb_null;
+    session->body_priv = tb_null;
+
+    // not keep alive? close it
+    if (!session->balived || TB_STATE_OK != tb_atomic_get(&session->httpd->state))
+    {
+        tb_aicp_httpd_session_clos(session);
+        return ;
+    }
+
+    // remove the handled request and move the pipelined requests to the head
+    tb_assert(session->rused <= session->rsize);
+    if (session->rused < session->rsize) tb_memmov(session->data, session->data + session->rused, session->rsize - session->rused);
+    session->rsize -= session->rused;
+    session->rused = 0;
+    session->bcontinue = 0;
+    session->bheaded = 0;
+
+    // handle the next request
+    tb_aicp_httpd_session_next(session);
+}
+static tb_bool_t tb_aicp_httpd_resp_sendf_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_SENDF, tb_false);
+
+    // the session
+    tb_aicp_httpd_session_t* session = (tb_aicp_httpd_session_t*)aice->priv;
+    tb_assert_and_check_return_val(session && session->file, tb_false);
+
+    // trace
+    tb_trace_d("session[%p]: sendf: real: %lu, size: %llu, state: %s", aice->aico, aice->u.sendf.real, aice->u.sendf.size, tb_state_cstr(aice->state));
+
+    // failed?
+    if (aice->state != TB_STATE_OK || !aice->u.sendf.real)
+    {
+        tb_aicp_httpd_session_clos(session);
+        return tb_true;
+    }
+
+    // save offset
+    session->file_seek += aice->u.sendf.real;
+    session->file_left -= tb_min(session->file_left, aice->u.sendf.real);
+
+    // finished?
+    if (!session->file_left) tb_aicp_httpd_resp_done(session);
+    // continue to send it
+    else if (!tb_aico_sendf(aice->aico, session->file, session->file_seek, session->file_left, tb_aicp_httpd_resp_sendf_func, session))
+        tb_aicp_httpd_session_clos(session);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_aicp_httpd_resp_send_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // the session
+    tb_aicp_httpd_session_t* session = (tb_aicp_httpd_session_t*)aice->priv;
+    tb_assert_and_check_return_val(session, tb_false);
+
+    // trace
+    tb_trace_d("session[%p]: send: real: %lu, size: %lu, state: %s", aice->aico, aice->u.send.real, aice->u.send.size, tb_state_cstr(aice->state));
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // failed?
+        tb_check_break(aice->state == TB_STATE_OK);
+
+        // not finished? continue to send it
+        if (aice->u.send.real < aice->u.send.size)
+        {
+            ok = tb_aico_send(aice->aico, aice->u.send.data + aice->u.send.real, aice->u.send.size - aice->u.send.real, tb_aicp_httpd_resp_send_func, session);
+            break;
+        }
+
+        // send the file
+        if (session->file && session->file_left)
+        {
+            ok = tb_aico_sendf(aice->aico, session->file, session->file_seek, session->file_left, tb_aicp_httpd_resp_sendf_func, session);
+            break;
+        }
+
+        // send the body
+        if (session->body_func) tb_aicp_httpd_body_next(session);
+        // finished
+        else tb_aicp_httpd_resp_done(session);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed? close it
+    if (!ok) tb_aicp_httpd_session_clos(session);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_aicp_httpd_resp_send(tb_aicp_httpd_session_t* session)
+{
+    // check
+    tb_assert_and_check_return(session && session->aico);
+
+    // trace
+    tb_trace_d("session[%p]: resp: %lu bytes", session->aico, tb_buffer_size(&session->head));
+
+    // send the response head
+    if (!tb_aico_send(session->aico, tb_buffer_data(&session->head), tb_buffer_size(&session->head), tb_aicp_httpd_resp_send_func, session))
+        tb_aicp_httpd_session_clos(session);
+}
+static tb_void_t tb_aicp_httpd_resp_data_done(tb_aicp_httpd_session_t* session, tb_size_t code, tb_char_t const* type, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(session);
+
+    // make head
+    tb_aicp_httpd_resp_init(session, code, type, size, 0);
+
+    // append data
+    if (session->bcontent && data && size) tb_buffer_memncat(&session->head, data, size);
+
+    // send it
+    tb_aicp_httpd_resp_send(session);
+}
+static tb_void_t tb_aicp_httpd_resp_error(tb_aicp_httpd_session_t* session, tb_size_t code)
+{
+    // check
+    tb_assert_and_check_return(session);
+
+    // trace
+    tb_trace_d("session[%p]: error: %lu", session->aico, code);
+
+    // the error info
+    tb_char_t data[256];
+    tb_long_t size = tb_snprintf(data, sizeof(data) - 1, "<html><body><h1>%lu %s</h1></body></html>", code, tb_http_status_code_cstr(code));
+    if (size < 0) size = 0;
+
+    // the request cannot be continued, close the connection after responding
+    session->request.balived = 0;
+
+    // respond it
+    tb_aicp_httpd_resp_data_done(session, code, "text/html", (tb_byte_t const*)data, size);
+}
+static tb_bool_t tb_aicp_httpd_resp_enter(tb_aicp_httpd_session_t* session)
+{
+    // only respond the waiting request once
+    return TB_AICP_HTTPD_WAIT_RESP == tb_atomic_fetch_and_pset(&session->wait, TB_AICP_HTTPD_WAIT_RESP, TB_AICP_HTTPD_WAIT_NONE);
+}
+static tb_bool_t tb_aicp_httpd_body_send_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_SEND, tb_false);
+
+    // the session
+    tb_aicp_httpd_session_t* session = (tb_aicp_httpd_session_t*)aice->priv;
+    tb_assert_and_check_return_val(session, tb_false);
+
+    // failed?
+    if (aice->state != TB_STATE_OK) tb_aicp_httpd_session_clos(session);
+    // not finished? continue to send it
+    else if (aice->u.send.real < aice->u.send.size)
+    {
+        if (!tb_aico_send(aice->aico, aice->u.send.data + aice->u.send.real, aice->u.send.size - aice->u.send.real, tb_aicp_httpd_body_send_func, session))
+            tb_aicp_httpd_session_clos(session);
+    }
+    // pull the next body data
+    else if (session->body_func) tb_aicp_httpd_body_next(session);
+    // finished
+    else tb_aicp_httpd_resp_done(session);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_aicp_httpd_body_next(tb_aicp_httpd_session_t* session)
+{
+    // check
+    tb_assert_and_check_return(session && session->httpd && session->body_func && session->body_data);
+
+    // killed? close it
+    if (TB_STATE_OK != tb_atomic_get(&session->httpd->state))
+    {
+        tb_aicp_httpd_session_clos(session);
+        return ;
+    }
+
+    // the body has been finished?
+    if (!session->body_left)
+    {
+        session->body_func = tb_null;
+        tb_aicp_httpd_resp_done(session);
+        return ;
+    }
+
+    // the body data buffer, reserve the chunk head and tail
+    tb_byte_t*  data = session->body_data + TB_AICP_HTTPD_CHUNK_HEAD_MAXN;
+    tb_size_t   maxn = TB_AICP_HTTPD_BODY_MAXN;
+    if (session->body_left > 0 && session->body_left < (tb_hong_t)maxn) maxn = (tb_size_t)session->body_left;
+
+    // pull the body data
+    tb_long_t real = 0;
+    while (1)
+    {
+        // the data will be pulled
+        tb_atomic_set(&session->wait, TB_AICP_HTTPD_WAIT_NONE);
+
+        // pull it
+        real = session->body_func((tb_aicp_httpd_session_ref_t)session, data, maxn, session->body_priv);
+        tb_check_break(!real);
+
+        // no data now? pause it if not be resumed
+        if (TB_AICP_HTTPD_WAIT_RESUME != tb_atomic_fetch_and_pset(&session->wait, TB_AICP_HTTPD_WAIT_NONE, TB_AICP_HTTPD_WAIT_BODY))
+        {
+            // trace
+            tb_trace_d("session[%p]: body: paused", session->aico);
+            return ;
+        }
+    }
+
+    // end?
+    tb_size_t size = 0;
+    if (real < 0)
+    {
+        // the body has been finished
+        session->body_func = tb_null;
+
+        // not finished for the known content size? close it
+        if (session->body_left > 0)
+        {
+            tb_aicp_httpd_session_clos(session);
+            return ;
+        }
+
+        // no chunked? finished
+        if (!session->bchunked)
+        {
+            // the unknown content size will be ended by closing connection
+            tb_aicp_httpd_resp_done(session);
+            return ;
+        }
+
+        // the last chunk
+        data = session->body_data;
+        tb_memcpy(data, "0\r\n\r\n", 5);
+        size = 5;
+    }
+    else
+    {
+        // check
+        tb_assert_and_check_return(real <= (tb_long_t)maxn);
+        size = (tb_size_t)real;
+
+        // update the left size
+        if (session->body_left > 0) session->body_left -= size;
+
+        // make chunk
+        if (session->bchunked)
+        {
+            // the chunk head
+            tb_char_t head[TB_AICP_HTTPD_CHUNK_HEAD_MAXN];
+            tb_long_t head_size = tb_snprintf(head, sizeof(head) - 1, "%lx\r\n", size);
+            tb_assert_and_check_return(head_size > 0 && head_size <= TB_AICP_HTTPD_CHUNK_HEAD_MAXN);
+
+            // the chunk data
+            data -= head_size;
+            tb_memcpy(data, head, head_size);
+            tb_memcpy(data + head_size + size, "\r\n", 2);
+            size += head_size + 2;
+        }
+    }
+
+    // send it
+    if (!tb_aico_send(session->aico, data, size, tb_aicp_httpd_body_send_func, session))
+        tb_aicp_httpd_session_clos(session);
+}
+static tb_void_t tb_aicp_httpd_session_done(tb_aicp_httpd_session_t* session)
+{
+    // check
+    tb_assert_and_check_return(session && session->httpd && session->httpd->func);
+
+    // the request content
+    tb_http_request_t const*    request = &session->request;
+    tb_byte_t const*            data = request->content_size > 0? session->data + request->head_size : tb_null;
+    tb_size_t                   size = request->content_size > 0? (tb_size_t)request->content_size : 0;
+
+    // wait the response
+    tb_atomic_set(&session->wait, TB_AICP_HTTPD_WAIT_RESP);
+
+    // done request, @note the session may be closed after starting the response
+    if (!session->httpd->func((tb_aicp_httpd_session_ref_t)session, request, data, size, session->httpd->priv))
+    {
+        // respond the internal error if the response has not been started
+        if (tb_aicp_httpd_resp_enter(session)) tb_aicp_httpd_resp_error(session, TB_HTTP_CODE_INTERNAL_SERVER_ERROR);
+    }
+}
+static tb_void_t tb_aicp_httpd_session_next(tb_aicp_httpd_session_t* session)
+{
+    // check
+    tb_assert_and_check_return(session && !session->rused);
+
+    // parse the request head if not parsed
+    tb_http_request_t* request = &session->request;
+    if (!session->bheaded)
+    {
+        // parse it
+        tb_long_t ok = tb_http_request_parse(request, (tb_char_t*)session->data, session->rsize);
+
+        // bad request?
+        if (ok < 0)
+        {
+            tb_aicp_httpd_resp_error(session, TB_HTTP_CODE_BAD_REQUEST);
+            return ;
+        }
+
+        // not finished?
+        if (!ok)
+        {
+            // continue to recv it
+            if (session->rsize < sizeof(session->data)) tb_aicp_httpd_session_recv(session);
+            // the head is too large
+            else
+            {
+                request->method  = TB_HTTP_METHOD_GET;
+                request->version = 1;
+                tb_aicp_httpd_resp_error(session, TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG);
+            }
+            return ;
+        }
+
+        // trace
+        tb_trace_d("session[%p]: request: %s %s, content: %lld, alived: %u", session->aico, tb_http_method_cstr(request->method), request->path, request->content_size, request->balived);
+
+        // not implemented method or chunked content?
+        if (request->code != TB_HTTP_CODE_OK || request->bchunked)
+        {
+            tb_aicp_httpd_resp_error(session, request->code != TB_HTTP_CODE_OK? request->code : TB_HTTP_CODE_LENGTH_REQUIRED);
+            return ;
+        }
+
+        // the request content is too large?
+        if (request->content_size > (tb_hong_t)(sizeof(session->data) - request->head_size))
+        {
+            tb_aicp_httpd_resp_error(session, TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG);
+            return ;
+        }
+
+        // parsed
+        session->bheaded = 1;
+    }
+
+    // the request content size
+    tb_size_t content_size = request->content_size > 0? (tb_size_t)request->content_size : 0;
+
+    // the request content is not finished?
+    if (request->head_size + content_size > session->rsize)
+    {
+        // send 100-continue first if the client expects it
+        if (request->bexpect && request->version && !session->bcontinue)
+        {
+            // send it
+            static tb_char_t const s_continue[] = "HTTP/1.1 100 Continue\r\n\r\n";
+            session->bcontinue = 1;
+            if (!tb_aico_send(session->aico, (tb_byte_t const*)s_continue, sizeof(s_continue) - 1, tb_aicp_httpd_session_continue_func, session))
+                tb_aicp_httpd_session_clos(session);
+        }
+        // continue to recv it
+        else tb_aicp_httpd_session_recv(session);
+        return ;
+    }
+
+    // save the request size
+    session->rused = request->head_size + content_size;
+
+    // done request
+    tb_aicp_httpd_session_done(session);
+}
+static tb_bool_t tb_aicp_httpd_acpt_func(tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(aice && aice->aico && aice->code == TB_AICE_CODE_ACPT, tb_false);
+
+    // the httpd
+    tb_aicp_httpd_impl_t* httpd = (tb_aicp_httpd_impl_t*)aice->priv;
+    tb_assert_and_check_return_val(httpd, tb_false);
+
+    // failed or killed? stop listening
+    if (aice->state != TB_STATE_OK)
+    {
+        // trace
+        tb_trace_d("acpt: %s", tb_state_cstr(aice->state));
+
+        // stop it
+        tb_atomic_set(&httpd->listening, 0);
+        return tb_true;
+    }
+
+    // check
+    tb_assert_and_check_return_val(aice->u.acpt.aico, tb_false);
+
+    // trace
+    tb_trace_d("acpt: aico: %p, addr: %{ipaddr}", aice->u.acpt.aico, &aice->u.acpt.addr);
+
+    // init session
+    tb_aicp_httpd_session_t* session = tb_aicp_httpd_session_init(httpd, aice->u.acpt.aico);
+    if (session)
+    {
+        // add session if not be killed
+        tb_spinlock_enter(&httpd->lock);
+        tb_bool_t ok = TB_STATE_OK == tb_atomic_get(&httpd->state);
+        if (ok) tb_list_entry_insert_tail(&httpd->sessions, &session->entry);
+        tb_spinlock_leave(&httpd->lock);
+
+        // recv the request
+        if (ok) tb_aicp_httpd_session_recv(session);
+        // killed? exit it
+        else
+        {
+            tb_aicp_httpd_session_exit(session);
+            session = tb_null;
+        }
+    }
+
+    // failed? close the connection
+    if (!session) tb_aico_clos(aice->u.acpt.aico, tb_aicp_httpd_aico_clos_func, tb_null);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_aicp_httpd_ref_t tb_aicp_httpd_init(tb_aicp_ref_t aicp, tb_ipaddr_ref_t addr, tb_aicp_httpd_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(aicp && addr && func, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_aicp_httpd_impl_t*   impl = tb_null;
+    do
+    {
+        // make impl
+        impl = tb_malloc0_type(tb_aicp_httpd_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init impl
+        impl->aicp      = aicp;
+        impl->func      = func;
+        impl->priv      = priv;
+        impl->state     = TB_STATE_OK;
+        impl->listening = 0;
+
+        // init lock
+        if (!tb_spinlock_init(&impl->lock)) break;
+
+        // init sessions
+        tb_list_entry_init(&impl->sessions, tb_aicp_httpd_session_t, entry, tb_null);
+
+        // init aico
+        impl->aico = tb_aico_init(aicp);
+        tb_assert_and_check_break(impl->aico);
+
+        // open aico
+        if (!tb_aico_open_sock_from_type(impl->aico, TB_SOCKET_TYPE_TCP, tb_ipaddr_family(addr))) break;
+
+        // bind address
+        if (!tb_socket_bind(tb_aico_sock(impl->aico), addr)) break;
+
+        // save the bound address, the port may be chosen by the system
+        if (!tb_socket_local(tb_aico_sock(impl->aico), &impl->addr)) tb_ipaddr_copy(&impl->addr, addr);
+
+        // listen it
+        if (!tb_socket_listen(tb_aico_sock(impl->aico), TB_AICP_HTTPD_BACKLOG)) break;
+
+        // trace
+        tb_trace_d("init: %{ipaddr}: ok", &impl->addr);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_aicp_httpd_exit((tb_aicp_httpd_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (tb_aicp_httpd_ref_t)impl;
+}
+tb_void_t tb_aicp_httpd_kill(tb_aicp_httpd_ref_t httpd)
+{
+    // check
+    tb_aicp_httpd_impl_t* impl = (tb_aicp_httpd_impl_t*)httpd;
+    tb_assert_and_check_return(impl);
+
+    // killed?
+    tb_check_return(TB_STATE_OK == tb_atomic_fetch_and_pset(&impl->state, TB_STATE_OK, TB_STATE_KILLING));
+
+    // trace
+    tb_trace_d("kill: ..");
+
+    // kill the listen aico
+    if (impl->aico) tb_aico_kill(impl->aico);
+
+    // kill all sessions
+    tb_spinlock_enter(&impl->lock);
+    tb_for_all_if (tb_aicp_httpd_session_t*, session, tb_list_entry_itor(&impl->sessions), session)
+    {
+        // kill aico
+        if (session->aico) tb_aico_kill(session->aico);
+
+        // the paused body will not be resumed? close it
+        if (TB_AICP_HTTPD_WAIT_BODY == tb_atomic_fetch_and_pset(&session->wait, TB_AICP_HTTPD_WAIT_BODY, TB_AICP_HTTPD_WAIT_NONE))
+            tb_aico_task_run(session->aico, 0, tb_aicp_httpd_session_kill_func, session);
+    }
+    tb_spinlock_leave(&impl->lock);
+}
+tb_bool_t tb_aicp_httpd_exit(tb_aicp_httpd_ref_t httpd)
+{
+    // check
+    tb_aicp_httpd_impl_t* impl = (tb_aicp_httpd_impl_t*)httpd;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // trace
+    tb_trace_d("exit: ..");
+
+    // kill it first
+    tb_aicp_httpd_kill(httpd);
+
+    // wait all sessions and the listening to be finished
+    tb_size_t tryn = 30;
+    tb_size_t size = 0;
+    while (tryn--)
+    {
+        // the session count
+        tb_spinlock_enter(&impl->lock);
+        size = tb_list_entry_size(&impl->sessions);
+        tb_spinlock_leave(&impl->lock);
+
+        // ok?
+        tb_check_break(size || tb_atomic_get(&impl->listening));
+
+        // wait some time
+        tb_msleep(200);
+    }
+
+    // failed?
+    if (size || tb_atomic_get(&impl->listening))
+    {
+        // trace
+        tb_trace_e("exit: %lu sessions are not closed!", size);
+        return tb_false;
+    }
+
+    // exit the listen aico
+    if (impl->aico) tb_aico_clos(impl->aico, tb_aicp_httpd_aico_clos_func, tb_null);
+    impl->aico = tb_null;
+
+    // exit sessions
+    tb_list_entry_exit(&impl->sessions);
+
+    // exit lock
+    tb_spinlock_exit(&impl->lock);
+
+    // exit it
+    tb_free(impl);
+
+    // trace
+    tb_trace_d("exit: ok");
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_aicp_httpd_start(tb_aicp_httpd_ref_t httpd)
+{
+    // check
+    tb_aicp_httpd_impl_t* impl = (tb_aicp_httpd_impl_t*)httpd;
+    tb_assert_and_check_return_val(impl && impl->aico, tb_false);
+
+    // killed?
+    tb_check_return_val(TB_STATE_OK == tb_atomic_get(&impl->state), tb_false);
+
+    // started?
+    tb_check_return_val(!tb_atomic_fetch_and_set(&impl->listening, 1), tb_true);
+
+    // trace
+    tb_trace_d("start: %{ipaddr}", &impl->addr);
+
+    // accept the connections
+    if (!tb_aico_acpt(impl->aico, tb_aicp_httpd_acpt_func, impl))
+    {
+        tb_atomic_set(&impl->listening, 0);
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_ipaddr_ref_t tb_aicp_httpd_addr(tb_aicp_httpd_ref_t httpd)
+{
+    // check
+    tb_aicp_httpd_impl_t* impl = (tb_aicp_httpd_impl_t*)httpd;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the listen address
+    return &impl->addr;
+}
+tb_aicp_ref_t tb_aicp_httpd_aicp(tb_aicp_httpd_ref_t httpd)
+{
+    // check
+    tb_aicp_httpd_impl_t* impl = (tb_aicp_httpd_impl_t*)httpd;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the aicp
+    return impl->aicp;
+}
+tb_bool_t tb_aicp_httpd_resp_head(tb_aicp_httpd_session_ref_t session, tb_char_t const* name, tb_char_t const* data)
+{
+    // check
+    tb_aicp_httpd_session_t* impl = (tb_aicp_httpd_session_t*)session;
+    tb_assert_and_check_return_val(impl && name && data, tb_false);
+
+    // must be before responding
+    tb_check_return_val(TB_AICP_HTTPD_WAIT_RESP == tb_atomic_get(&impl->wait), tb_false);
+
+    // the head line cannot be broken
+    tb_check_return_val(tb_aicp_httpd_head_check(name, tb_true) && tb_aicp_httpd_head_check(data, tb_false), tb_false);
+
+    // add head
+    tb_aicp_httpd_head_cat(&impl->extra, name, data);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_aicp_httpd_resp_data(tb_aicp_httpd_session_ref_t session, tb_size_t code, tb_char_t const* type, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_aicp_httpd_session_t* impl = (tb_aicp_httpd_session_t*)session;
+    tb_assert_and_check_return_val(impl && (data || !size), tb_false);
+
+    // enter the response
+    tb_check_return_val(tb_aicp_httpd_resp_enter(impl), tb_false);
+
+    // respond it
+    tb_aicp_httpd_resp_data_done(impl, code, type, data, size);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_aicp_httpd_resp_file(tb_aicp_httpd_session_ref_t session, tb_char_t const* path, tb_char_t const* type)
+{
+    // check
+    tb_aicp_httpd_session_t* impl = (tb_aicp_httpd_session_t*)session;
+    tb_assert_and_check_return_val(impl && path, tb_false);
+
+    // enter the response
+    tb_check_return_val(tb_aicp_httpd_resp_enter(impl), tb_false);
+
+    // done
+    tb_size_t code = TB_HTTP_CODE_NOT_FOUND;
+    do
+    {
+        // the file info
+        tb_file_info_t info = {0};
+        tb_check_break(tb_file_info(path, &info) && info.type == TB_FILE_TYPE_FILE);
+
+        // not modified?
+        if (impl->request.modified_since && info.mtime && info.mtime <= impl->request.modified_since)
+        {
+            tb_aicp_httpd_resp_init(impl, TB_HTTP_CODE_NOT_MODIFIED, tb_null, 0, info.mtime);
+            tb_aicp_httpd_resp_send(impl);
+            return tb_true;
+        }
+
+        // the content type
+        if (!type) type = tb_aicp_httpd_mime(path);
+
+        // make head
+        tb_aicp_httpd_resp_init(impl, TB_HTTP_CODE_OK, type, info.size, info.mtime);
+
+        // open file if has content
+        if (impl->bcontent && info.size)
+        {
+            // init file
+            tb_assert(!impl->file);
+            impl->file = tb_file_init(path, TB_FILE_MODE_RO | TB_FILE_MODE_BINARY | TB_FILE_MODE_ASIO);
+            tb_check_break_state(impl->file, code, TB_HTTP_CODE_FORBIDDEN);
+
+            // send the whole file after the head
+            impl->file_seek = 0;
+            impl->file_left = info.size;
+        }
+
+        // trace
+        tb_trace_d("session[%p]: file: %s, size: %llu", impl->aico, path, info.size);
+
+        // send it
+        tb_aicp_httpd_resp_send(impl);
+
+        // ok
+        code = TB_HTTP_CODE_OK;
+
+    } while (0);
+
+    // failed?
+    if (code != TB_HTTP_CODE_OK)
+    {
+        // the error info
+        tb_char_t data[256];
+        tb_long_t size = tb_snprintf(data, sizeof(data) - 1, "<html><body><h1>%lu %s</h1></body></html>", code, tb_http_status_code_cstr(code));
+        if (size < 0) size = 0;
+
+        // respond it
+        tb_aicp_httpd_resp_data_done(impl, code, "text/html", (tb_byte_t const*)data, size);
+    }
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_aicp_httpd_resp_body(tb_aicp_httpd_session_ref_t session, tb_size_t code, tb_char_t const* type, tb_hong_t size, tb_aicp_httpd_body_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_aicp_httpd_session_t* impl = (tb_aicp_httpd_session_t*)session;
+    tb_assert_and_check_return_val(impl && func, tb_false);
+
+    // init body data
+    if (!impl->body_data) impl->body_data = tb_malloc_bytes(TB_AICP_HTTPD_CHUNK_HEAD_MAXN + TB_AICP_HTTPD_BODY_MAXN + 2);
+    tb_assert_and_check_return_val(impl->body_data, tb_false);
+
+    // enter the response
+    tb_check_return_val(tb_aicp_httpd_resp_enter(impl), tb_false);
+
+    // make head
+    tb_aicp_httpd_resp_init(impl, code, type, size, 0);
+
+    // init body
+    impl->body_func = func;
+    impl->body_priv = priv;
+    impl->body_left = size;
+
+    // no content? notify the body func and finish it after the head
+    if (!impl->bcontent || !size)
+    {
+        if (impl->bcontent) impl->body_left = 0;
+        else
+        {
+            impl->body_func = tb_null;
+            func(session, tb_null, 0, priv);
+        }
+    }
+
+    // send it
+    tb_aicp_httpd_resp_send(impl);
+
+    // ok
+    return tb_true;
+}
+tb_void_t tb_aicp_httpd_resp_resume(tb_aicp_httpd_session_ref_t session)
+{
+    // check
+    tb_aicp_httpd_session_t* impl = (tb_aicp_httpd_session_t*)session;
+    tb_assert_and_check_return(impl);
+
+    // resume it
+    while (1)
+    {
+        // paused? pull the body data
+        tb_size_t wait = tb_atomic_fetch_and_pset(&impl->wait, TB_AICP_HTTPD_WAIT_BODY, TB_AICP_HTTPD_WAIT_NONE);
+        if (wait == TB_AICP_HTTPD_WAIT_BODY)
+        {
+            tb_aicp_httpd_body_next(impl);
+            break;
+        }
+
+        // not pulling?
+        tb_check_break(wait == TB_AICP_HTTPD_WAIT_NONE);
+
+        // pulling now? pull it again after pausing
+        tb_check_break(TB_AICP_HTTPD_WAIT_NONE != tb_atomic_fetch_and_pset(&impl->wait, TB_AICP_HTTPD_WAIT_NONE, TB_AICP_HTTPD_WAIT_RESUME));
+    }
+}
@@ -0,0 +1,209 @@
+/*!The Treasure Box Library
+ *
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox;
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ *
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        httpd.h
+ * @ingroup     asio
+ *
+ */
+#ifndef TB_ASIO_HTTPD_H
+#define TB_ASIO_HTTPD_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "aicp.h"
+#include "../network/http.h"
+#include "../network/ipaddr.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the aicp httpd ref type
+typedef struct{}*   tb_aicp_httpd_ref_t;
+
+/// the aicp httpd session ref type
+typedef struct{}*   tb_aicp_httpd_session_ref_t;
+
+/*! the aicp httpd request func type
+ *
+ * the response must be started by tb_aicp_httpd_resp_xxx() in this func or later in any thread,
+ * the next request of the keep-alive or pipelined session will be handled after the response is finished.
+ *
+ * @param session   the session
+ * @param request   the request, it is valid until the response is finished
+ * @param data      the request content data if has Content-Length, tb_null if no content
+ * @param size      the request content size
+ * @param priv      the func private data
+ *
+ * @return          tb_true: ok, tb_false: failed, respond 500 if the response has not been started
+ */
+typedef tb_bool_t   (*tb_aicp_httpd_func_t)(tb_aicp_httpd_session_ref_t session, tb_http_request_t const* request, tb_byte_t const* data, tb_size_t size, tb_cpointer_t priv);
+
+/*! the aicp httpd body func type for the streaming response
+ *
+ * it will be called only after the last data has been sent, so the producer is throttled by the client.
+ *
+ * @param session   the session
+ * @param data      the body data buffer, tb_null if the body is not needed (.e.g HEAD) or the session is closed before finishing it,
+ *                  the session cannot be used after it
+ * @param size      the body data buffer size
+ * @param priv      the func private data
+ *
+ * @return          the real size, 0: no data now and call tb_aicp_httpd_resp_resume() later, -1: end
+ */
+typedef tb_long_t   (*tb_aicp_httpd_body_func_t)(tb_aicp_httpd_session_ref_t session, tb_byte_t* data, tb_size_t size, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the httpd
+ *
+ * @param aicp      the aicp
+ * @param addr      the listen address, the port will be chosen by the system if it is zero
+ * @param func      the request func
+ * @param priv      the func private data
+ *
+ * @return          the httpd
+ */
+tb_aicp_httpd_ref_t tb_aicp_httpd_init(tb_aicp_ref_t aicp, tb_ipaddr_ref_t addr, tb_aicp_httpd_func_t func, tb_cpointer_t priv);
+
+/*! kill the httpd, stop accepting and kill all sessions
+ *
+ * @param httpd     the httpd
+ */
+tb_void_t           tb_aicp_httpd_kill(tb_aicp_httpd_ref_t httpd);
+
+/*! exit the httpd
+ *
+ * @note it will wait all sessions to be closed
+ *
+ * @param httpd     the httpd
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_aicp_httpd_exit(tb_aicp_httpd_ref_t httpd);
+
+/*! start the httpd and accept the connections
+ *
+ * @param httpd     the httpd
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_aicp_httpd_start(tb_aicp_httpd_ref_t httpd);
+
+/*! the httpd listen address
+ *
+ * @param httpd     the httpd
+ *
+ * @return          the listen address
+ */
+tb_ipaddr_ref_t     tb_aicp_httpd_addr(tb_aicp_httpd_ref_t httpd);
+
+/*! the httpd aicp
+ *
+ * @param httpd     the httpd
+ *
+ * @return          the aicp
+ */
+tb_aicp_ref_t       tb_aicp_httpd_aicp(tb_aicp_httpd_ref_t httpd);
+
+/*! add the response head before starting the response
+ *
+ * @param session   the session
+ * @param name      the head name, .e.g "Cache-Control"
+ * @param data      the head value
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_aicp_httpd_resp_head(tb_aicp_httpd_session_ref_t session, tb_char_t const* name, tb_char_t const* data);
+
+/*! respond the data
+ *
+ * @param session   the session
+ * @param code      the http code
+ * @param type      the content type, "text/html" if be null
+ * @param data      the content data, it will be copied
+ * @param size      the content size
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_aicp_httpd_resp_data(tb_aicp_httpd_session_ref_t session, tb_size_t code, tb_char_t const* type, tb_byte_t const* data, tb_size_t size);
+
+/*! respond the file with zero-copy
+ *
+ * respond 404 if the file is not found and 304 if it is not modified since the request date.
+ *
+ * @param session   the session
+ * @param path      the file path
+ * @param type      the content type, guess it from the file extension if be null
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_aicp_httpd_resp_file(tb_aicp_httpd_session_ref_t session, tb_char_t const* path, tb_char_t const* type);
+
+/*! respond the streaming body
+ *
+ * @code
+    static tb_long_t tb_demo_body_func(tb_aicp_httpd_session_ref_t session, tb_byte_t* data, tb_size_t size, tb_cpointer_t priv)
+    {
+        // the session is closed?
+        if (!data) return -1;
+
+        // no data now? call tb_aicp_httpd_resp_resume(session) if the data is ready
+        // ...
+
+        // fill data
+        // ...
+        return real;
+    }
+
+    // respond the body with the chunked encoding
+    tb_aicp_httpd_resp_body(session, TB_HTTP_CODE_OK, "text/plain", -1, tb_demo_body_func, tb_null);
+ * @endcode
+ *
+ * @param session   the session
+ * @param code      the http code
+ * @param type      the content type, "text/html" if be null
+ * @param size      the content size, use the chunked encoding if be -1
+ * @param func      the body func
+ * @param priv      the func private data
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_aicp_httpd_resp_body(tb_aicp_httpd_session_ref_t session, tb_size_t code, tb_char_t const* type, tb_hong_t size, tb_aicp_httpd_body_func_t func, tb_cpointer_t priv);
+
+/*! resume the paused streaming body
+ *
+ * @param session   the session
+ */
+tb_void_t           tb_aicp_httpd_resp_resume(tb_aicp_httpd_session_ref_t session);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -25,11 +25,36 @@
  */
 #include "prefix.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the reactor shard maximum count
+#ifdef __tb_small__
+#   define TB_AIOP_PTOR_SHARD_MAXN          (16)
+#else
+#   define TB_AIOP_PTOR_SHARD_MAXN          (64)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
-// the aiop ptor type
+/* the aiop ptor type
+ *
+ * the ptor is also the first reactor shard, and each shard has its own aiop, spak loop and spak queues:
+ *
+ * main: | shard 0 (self) | shard 1 | ... | shard n - 1 |
+ *            |                |                 |
+ *          aiop             aiop              aiop
+ *          loop             loop              loop
+ *          spak             spak              spak
+ *
+ * the aico is pinned to one shard when it is opened, and the aicp loop is pinned to one shard when it is started.
+ *
+ * each aicp loop owns its timer for the tasks and the timeouts, it only adds and spaks the tasks of this timer,
+ * and the other threads cancel these tasks by posting the messages to this loop.
+ */
 typedef struct __tb_aiop_ptor_impl_t
 {
     // the ptor base
@@ -48,9 +73,6 @@ typedef struct __tb_aiop_ptor_impl_t
     // the spak lock
     tb_spinlock_t               lock;
 
-    // the spak wait
-    tb_semaphore_ref_t          wait;
-
     // the spak loop
     tb_thread_ref_t             loop;
 
@@ -59,12 +81,6 @@ typedef struct __tb_aiop_ptor_impl_t
 
     // the aioe size
     tb_size_t                   maxn;
- 
-    // the timer for task
-    tb_timer_ref_t              timer;
-
-    // the low precision timer for timeout
-    tb_ltimer_ref_t             ltimer;
 
     // the private data for file
     tb_handle_t                 fpriv;
@@ -75,8 +91,73 @@ typedef struct __tb_aiop_ptor_impl_t
     // the killing aico list
     tb_vector_ref_t             klist;
 
+    /* the aicp loops pinned to this shard
+     *
+     * it is only appended under the klock and freed after exiting all loops, 
+     * so we can walk it without lock for waking up these loops
+     */
+    struct __tb_aiop_ptor_loop_t* volatile  loops;
+
+    // the main ptor, it is the first shard
+    struct __tb_aiop_ptor_impl_t*   main;
+
+    // the shard index
+    tb_size_t                   shard_indx;
+
+    // the loop count of this shard
+    tb_atomic_t                 shard_work;
+
+    // the shard list, only for the main ptor
+    struct __tb_aiop_ptor_impl_t**  shard_list;
+
+    // the shard count, only for the main ptor
+    tb_size_t                   shard_size;
+
+    // the next shard index for pinning aico, only for the main ptor
+    tb_atomic_t                 shard_aico;
+
+    // the next shard index for pinning loop, only for the main ptor
+    tb_atomic_t                 shard_loop;
+
 }tb_aiop_ptor_impl_t;
 
+// the aiop loop message type
+typedef struct __tb_aiop_loop_mesg_t
+{
+    // the timer task
+    tb_timer_task_ref_t         task;
+
+    // kill it? otherwise exit it
+    tb_bool_t                   kill;
+
+}tb_aiop_loop_mesg_t;
+
+// the aiop loop type
+typedef struct __tb_aiop_ptor_loop_t
+{
+    // the shard of this loop
+    tb_aiop_ptor_impl_t*        home;
+
+    // the thread of this loop, it will be cleared after exiting this loop
+    tb_size_t                   self;
+
+    // the wait of this loop
+    tb_semaphore_ref_t          wait;
+
+    // the timer for task and timeout, only this loop adds and spaks it
+    tb_timer_ref_t              timer;
+
+    // the message lock
+    tb_spinlock_t               mlock;
+
+    // the message list for cancelling the tasks of this timer from the other threads
+    tb_vector_ref_t             mlist;
+
+    // the next loop of this shard
+    struct __tb_aiop_ptor_loop_t*   next;
+
+}tb_aiop_ptor_loop_t;
+
 // the aiop aico type
 typedef struct __tb_aiop_aico_t
 {
@@ -95,6 +176,9 @@ typedef struct __tb_aiop_aico_t
     // the task
     tb_handle_t                 task;
 
+    // the loop which owns the timer of this task
+    tb_aiop_ptor_loop_t*        loop;
+
     /* wait ok? avoid spak double aice when wait killed/timeout and ok at same time
      * need lock it using impl->lock
      */
@@ -103,9 +187,6 @@ typedef struct __tb_aiop_aico_t
     // is waiting?
     tb_uint8_t                  waiting : 1;
 
-    // is ltimer?
-    tb_uint8_t                  bltimer : 1;
-
 }tb_aiop_aico_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -118,11 +199,7 @@ static tb_void_t    tb_aicp_file_kilo(tb_aiop_ptor_impl_t* impl, tb_aico_impl_t*
 static tb_bool_t    tb_aicp_file_post(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice);
 static tb_void_t    tb_aicp_file_kill(tb_aiop_ptor_impl_t* impl);
 static tb_void_t    tb_aicp_file_poll(tb_aiop_ptor_impl_t* impl);
-static tb_long_t    tb_aicp_file_spak_read(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice);
-static tb_long_t    tb_aicp_file_spak_writ(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice);
-static tb_long_t    tb_aicp_file_spak_readv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice);
-static tb_long_t    tb_aicp_file_spak_writv(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice);
-static tb_long_t    tb_aicp_file_spak_fsync(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice);
+static tb_void_t    tb_aicp_file_room(tb_aiop_ptor_impl_t* impl);
  
 /* //////////////////////////////////////////////////////////////////////////////////////
  * spak
@@ -159,19 +236,131 @@ static __tb_inline__ tb_size_t tb_aiop_aioe_code(tb_aice_ref_t aice)
     // the aioe code
     return s_code[aice->code];
 }
+static tb_bool_t tb_aiop_spak_work_shard(tb_aiop_ptor_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // the worker size of this shard
+    tb_size_t work = tb_atomic_get(&impl->shard_work);
+    tb_check_return_val(work, tb_false);
+
+    /* post the wait of all loops in this shard
+     *
+     * each loop has its own wait, so the posted value will not be taken by the other loops
+     */
+    tb_aiop_ptor_loop_t* loop = impl->loops;
+    for (; loop; loop = loop->next)
+    {
+        if (loop->self && tb_semaphore_value(loop->wait) <= 0) tb_semaphore_post(loop->wait, 1);
+    }
+
+    // ok
+    return tb_true;
+}
 static tb_void_t tb_aiop_spak_work(tb_aiop_ptor_impl_t* impl)
 {
     // check
-    tb_assert_and_check_return(impl && impl->wait && impl->base.aicp);
+    tb_assert_and_check_return(impl && impl->main);
 
-    // the worker size
-    tb_size_t work = tb_atomic_get(&impl->base.aicp->work);
+    // work the loops of this shard
+    tb_check_return(!tb_aiop_spak_work_shard(impl));
 
-    // the semaphore value
-    tb_long_t value = tb_semaphore_value(impl->wait);
-    
-    // post wait
-    if (value >= 0 && value < work) tb_semaphore_post(impl->wait, work - value);
+    // no loop for this shard? work the loops of all shards for stealing it
+    tb_size_t               i = 0;
+    tb_aiop_ptor_impl_t*    main = impl->main;
+    for (i = 0; i < main->shard_size; i++) 
+    {
+        if (main->shard_list[i] != impl) tb_aiop_spak_work_shard(main->shard_list[i]);
+    }
+}
+static tb_void_t tb_aiop_loop_post(tb_aiop_ptor_loop_t* loop, tb_timer_task_ref_t task, tb_bool_t kill)
+{
+    // check
+    tb_assert_and_check_return(loop && loop->mlist && task);
+
+    // init message
+    tb_aiop_loop_mesg_t mesg;
+    mesg.task = task;
+    mesg.kill = kill;
+
+    // post message
+    tb_spinlock_enter(&loop->mlock);
+    tb_vector_insert_tail(loop->mlist, &mesg);
+    tb_spinlock_leave(&loop->mlock);
+
+    /* wake up this loop for spaking the killed task
+     *
+     * @note the exited task need not wake up it, it will be removed when this loop spaks next time,
+     * and it will be ignored by the timeout func if it expires before it
+     */
+    if (kill && tb_semaphore_value(loop->wait) <= 0) tb_semaphore_post(loop->wait, 1);
+}
+static tb_void_t tb_aiop_loop_spak(tb_aiop_ptor_loop_t* loop)
+{
+    // check
+    tb_assert_and_check_return(loop && loop->mlist && loop->timer);
+
+    // enter
+    tb_spinlock_enter(&loop->mlock);
+
+    // cancel the tasks of the other threads
+    if (tb_vector_size(loop->mlist))
+    {
+        tb_for_all_if (tb_aiop_loop_mesg_t*, mesg, loop->mlist, mesg)
+        {
+            if (mesg->kill) tb_timer_task_kill(loop->timer, mesg->task);
+            else tb_timer_task_exit(loop->timer, mesg->task);
+        }
+        tb_vector_clear(loop->mlist);
+    }
+
+    // leave
+    tb_spinlock_leave(&loop->mlock);
+}
+static __tb_inline__ tb_bool_t tb_aiop_loop_task_live(tb_aiop_aico_t* aico)
+{
+    /* the expired task is done in the owner loop, 
+     * it is dead if it has been exited or the aico has been waited in the other loop after exiting it
+     */
+    return (aico->task && aico->loop && aico->loop->self == tb_thread_self())? tb_true : tb_false;
+}
+static tb_void_t tb_aiop_loop_task_exit(tb_aiop_aico_t* aico)
+{
+    // check
+    tb_assert_and_check_return(aico);
+
+    // no task?
+    tb_check_return(aico->task);
+
+    // the loop of this task
+    tb_aiop_ptor_loop_t* loop = aico->loop;
+    tb_assert_and_check_return(loop && loop->timer);
+
+    /* mark this task dead before posting it
+     *
+     * the owner loop may be spaking its timer now and this task may have been popped before spaking the exit message,
+     * so the timeout func will ignore it if it is not the current task of this aico
+     */
+    tb_timer_task_ref_t task = aico->task;
+    aico->task = tb_null;
+
+    // exit it directly if it is in this loop, otherwise post it to the loop of this task
+    if (loop->self == tb_thread_self()) tb_timer_task_exit(loop->timer, task);
+    else tb_aiop_loop_post(loop, task, tb_false);
+}
+static tb_void_t tb_aiop_loop_task_kill(tb_aiop_aico_t* aico)
+{
+    // check
+    tb_assert_and_check_return(aico && aico->task);
+
+    // the loop of this task
+    tb_aiop_ptor_loop_t* loop = aico->loop;
+    tb_assert_and_check_return(loop && loop->timer);
+
+    // kill it directly if it is in this loop, otherwise post it to the loop of this task
+    if (loop->self == tb_thread_self()) tb_timer_task_kill(loop->timer, aico->task);
+    else tb_aiop_loop_post(loop, aico->task, tb_true);
 }
 static tb_bool_t tb_aiop_push_sock(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
 {
@@ -306,7 +495,7 @@ static tb_pointer_t tb_aiop_spak_loop(tb_cpointer_t priv)
     do
     {
         // check
-        tb_assert_and_check_break(impl && impl->aiop && impl->list && impl->timer && impl->ltimer && aicp);
+        tb_assert_and_check_break(impl && impl->aiop && impl->list && aicp);
 
         // trace
         tb_trace_d("loop: init");
@@ -314,18 +503,11 @@ static tb_pointer_t tb_aiop_spak_loop(tb_cpointer_t priv)
         // loop 
         while (!tb_atomic_get(&aicp->kill))
         {
-            // the delay
-            tb_size_t delay = tb_timer_delay(impl->timer);
-
-            // the ldelay
-            tb_size_t ldelay = tb_ltimer_delay(impl->ltimer);
-            tb_assert_and_check_break(ldelay != -1);
-
             // trace
             tb_trace_d("loop: wait: ..");
 
-            // wait aioe
-            tb_long_t real = tb_aiop_wait(impl->aiop, impl->list, impl->maxn, tb_min(delay, ldelay));
+            // wait aioe, the timers are spaked in the aicp loops
+            tb_long_t real = tb_aiop_wait(impl->aiop, impl->list, impl->maxn, -1);
 
             // trace
             tb_trace_d("loop: wait: %ld", real);
@@ -333,12 +515,6 @@ static tb_pointer_t tb_aiop_spak_loop(tb_cpointer_t priv)
             // spak ctime
             tb_cache_time_spak();
 
-            // spak timer
-            if (!tb_timer_spak(impl->timer)) break;
-
-            // spak ltimer
-            if (!tb_ltimer_spak(impl->ltimer)) break;
-
             // killed?
             tb_check_break(real >= 0);
 
@@ -422,7 +598,13 @@ static tb_void_t tb_aiop_spak_wait_timeout(tb_bool_t killed, tb_cpointer_t priv)
 {
     // the aico
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)priv;
-    tb_assert_and_check_return(aico && aico->waiting);
+    tb_assert_and_check_return(aico);
+
+    // has been spaked? the killed task may be done after spaking the events
+    tb_check_return(aico->waiting);
+
+    // has been exited by the other thread? it is not the current task of this aico now
+    tb_check_return(tb_aiop_loop_task_live(aico));
 
     // the impl
     tb_aiop_ptor_impl_t* impl = aico->impl;
@@ -478,11 +660,11 @@ static tb_void_t tb_aiop_spak_wait_timeout(tb_bool_t killed, tb_cpointer_t priv)
 static tb_bool_t tb_aiop_spak_wait(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
 {   
     // check
-    tb_assert_and_check_return_val(impl && impl->aiop && impl->ltimer && aice, tb_false);
+    tb_assert_and_check_return_val(impl && impl->aiop && aice, tb_false);
 
     // the aico
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aice->aico;
-    tb_assert_and_check_return_val(aico && aico->base.handle && !aico->task, tb_false);
+    tb_assert_and_check_return_val(aico && aico->base.handle && aico->loop && !aico->task, tb_false);
 
     // the aioe code
     tb_size_t code = tb_aiop_aioe_code(aice);
@@ -496,6 +678,20 @@ static tb_bool_t tb_aiop_spak_wait(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     tb_aice_t prev = aico->aice;
     do
     {
+        /* add timeout task before waiting the events
+         *
+         * @note the event may be spaked in the other loop immediately after waiting it,
+         * and that loop will exit this task and change aico->loop,
+         * so the killing loop will not add the other task for the waiting aico
+         */
+        tb_long_t timeout = tb_aico_impl_timeout_from_code((tb_aico_impl_t*)aico, aice->code);
+        if (timeout >= 0)
+        {
+            // add it to the timer of this loop, this loop will update its delay before waiting next time
+            aico->task = tb_timer_task_init(aico->loop->timer, timeout, tb_false, tb_aiop_spak_wait_timeout, aico);
+            tb_assert_and_check_break(aico->task);
+        }
+
         // wait it
         aico->aice = *aice;
         aico->waiting = 1;
@@ -508,30 +704,25 @@ static tb_bool_t tb_aiop_spak_wait(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
         if (tb_aiop_have(impl->aiop, TB_AIOE_CODE_CLEAR))
             code |= TB_AIOE_CODE_CLEAR;
 
+        /* enter the spak lock
+         *
+         * the event may be pushed by the spak loop and spaked in the other loop before saving the aioo,
+         * and that loop will wait it again with the null aioo, so we hold the lock which is needed for pushing it
+         */
+        tb_spinlock_enter(&impl->lock);
+
         // have aioo?
         if (!aico->aioo) 
         {
             // addo wait
-            if (!(aico->aioo = tb_aiop_addo(impl->aiop, aico->base.handle, code, &aico->aice))) break;
-        }
-        else
-        {
-            // sete wait
-            if (!tb_aiop_sete(impl->aiop, aico->aioo, code, &aico->aice)) break;
-        }
-
-        // add timeout task
-        tb_long_t timeout = tb_aico_impl_timeout_from_code((tb_aico_impl_t*)aico, aice->code);
-        if (timeout >= 0) 
-        {
-            // add it
-            aico->task = tb_ltimer_task_init(impl->ltimer, timeout, tb_false, tb_aiop_spak_wait_timeout, aico);
-            tb_assert_and_check_break(aico->task);
-            aico->bltimer = 1;
+            aico->aioo = tb_aiop_addo(impl->aiop, aico->base.handle, code, &aico->aice);
+            ok = aico->aioo? tb_true : tb_false;
         }
+        // sete wait
+        else ok = tb_aiop_sete(impl->aiop, aico->aioo, code, &aico->aice);
 
-        // ok
-        ok = tb_true;
+        // leave the spak lock
+        tb_spinlock_leave(&impl->lock);
 
     } while (0);
 
@@ -541,6 +732,9 @@ static tb_bool_t tb_aiop_spak_wait(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
         // trace
         tb_trace_d("wait: aico: %p, code: %lu: failed", aico, aice->code);
 
+        // exit the timeout task
+        tb_aiop_loop_task_exit(aico);
+
         // restore it
         aico->aice = prev;
         aico->waiting = 0;
@@ -1080,6 +1274,9 @@ static tb_void_t tb_aiop_spak_runtask_timeout(tb_bool_t killed, tb_cpointer_t pr
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)priv;
     tb_assert_and_check_return(aico && aico->waiting);
 
+    // has been exited by the other thread? it is not the current task of this aico now
+    tb_check_return(tb_aiop_loop_task_live(aico));
+
     // the impl
     tb_aiop_ptor_impl_t* impl = aico->impl;
     tb_assert_and_check_return(impl);
@@ -1118,13 +1315,13 @@ static tb_void_t tb_aiop_spak_runtask_timeout(tb_bool_t killed, tb_cpointer_t pr
 static tb_long_t tb_aiop_spak_runtask(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
 {
     // check
-    tb_assert_and_check_return_val(impl && impl->aiop && impl->ltimer && impl->timer && aice, -1);
+    tb_assert_and_check_return_val(impl && aice, -1);
     tb_assert_and_check_return_val(aice->code == TB_AICE_CODE_RUNTASK, -1);
     tb_assert_and_check_return_val(aice->u.runtask.when, -1);
 
     // the aico
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aice->aico;
-    tb_assert_and_check_return_val(aico && !aico->task, -1);
+    tb_assert_and_check_return_val(aico && aico->loop && !aico->task, -1);
 
     // now
     tb_hong_t now = tb_cache_time_mclock();
@@ -1149,25 +1346,8 @@ static tb_long_t tb_aiop_spak_runtask(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t a
         aico->aice = *aice;
         aico->waiting = 1;
 
-        // add timeout task, is the higher precision timer?
-        if (aico->base.handle)
-        {
-            // the top when
-            tb_hize_t top = tb_timer_top(impl->timer);
-
-            // add task
-            aico->task = tb_timer_task_init_at(impl->timer, aice->u.runtask.when, 0, tb_false, tb_aiop_spak_runtask_timeout, aico);
-            aico->bltimer = 0;
-
-            // the top task is changed? spak aiop
-            if (aico->task && aice->u.runtask.when < top)
-                tb_aiop_spak(impl->aiop);
-        }
-        else
-        {
-            aico->task = tb_ltimer_task_init_at(impl->ltimer, aice->u.runtask.when, 0, tb_false, tb_aiop_spak_runtask_timeout, aico);
-            aico->bltimer = 1;
-        }
+        // add timeout task to the timer of this loop
+        aico->task = tb_timer_task_init_at(aico->loop->timer, aice->u.runtask.when, 0, tb_false, tb_aiop_spak_runtask_timeout, aico);
 
         // wait
         ok = 0;
@@ -1179,7 +1359,7 @@ static tb_long_t tb_aiop_spak_runtask(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t a
 static tb_long_t tb_aiop_spak_clos(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
 {
     // check
-    tb_assert_and_check_return_val(impl && impl->aiop && impl->ltimer && impl->timer && aice, -1);
+    tb_assert_and_check_return_val(impl && impl->aiop && aice, -1);
     tb_assert_and_check_return_val(aice->code == TB_AICE_CODE_CLOS, -1);
 
     // the aico
@@ -1190,13 +1370,7 @@ static tb_long_t tb_aiop_spak_clos(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     tb_trace_d("clos: aico: %p, code: %u: %s", aico, aice->code, tb_state_cstr(tb_atomic_get(&aico->base.state)));
  
     // exit the timer task
-    if (aico->task) 
-    {
-        if (aico->bltimer) tb_ltimer_task_exit(impl->ltimer, aico->task);
-        else tb_timer_task_exit(impl->timer, aico->task);
-        aico->bltimer = 0;
-    }
-    aico->task = tb_null;
+    tb_aiop_loop_task_exit(aico);
 
     // exit the sock 
     if (aico->base.type == TB_AICO_TYPE_SOCK)
@@ -1231,29 +1405,26 @@ static tb_long_t tb_aiop_spak_clos(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     for (i = 0; i < n; i++) aico->base.timeout[i] = -1;
 
     // closed
-    tb_atomic_set(&aico->base.state, TB_STATE_CLOSED);
+    tb_atomic_set_explicit(&aico->base.state, TB_STATE_CLOSED, TB_ATOMIC_RELEASE);
 
     // ok
     aice->state = TB_STATE_OK;
     return 1;
 }
-static tb_long_t tb_aiop_spak_done(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
+static tb_long_t tb_aiop_spak_done(tb_aiop_ptor_impl_t* impl, tb_aiop_ptor_loop_t* loop, tb_aice_ref_t aice)
 {
     // check
-    tb_assert_and_check_return_val(impl && impl->timer && impl->ltimer && aice, -1);
+    tb_assert_and_check_return_val(impl && loop && aice, -1);
 
     // the aico
     tb_aiop_aico_t* aico = (tb_aiop_aico_t*)aice->aico;
     tb_assert_and_check_return_val(aico, -1);
 
     // remove task
-    if (aico->task) 
-    {
-        if (aico->bltimer) tb_ltimer_task_exit(impl->ltimer, aico->task);
-        else tb_timer_task_exit(impl->timer, aico->task);
-        aico->bltimer = 0;
-    }
-    aico->task = tb_null;
+    tb_aiop_loop_task_exit(aico);
+
+    // the next task will be added to the timer of this loop
+    aico->loop = loop;
 
     // spak the killed aice if not closing
     if (tb_aico_impl_is_killed(&aico->base) && aice->code != TB_AICE_CODE_CLOS)
@@ -1306,11 +1477,12 @@ static tb_long_t tb_aiop_spak_done(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     ,   tb_aiop_spak_usendv
     ,   tb_aiop_spak_sendf
 
-    ,   tb_aicp_file_spak_read
-    ,   tb_aicp_file_spak_writ
-    ,   tb_aicp_file_spak_readv
-    ,   tb_aicp_file_spak_writv
-    ,   tb_aicp_file_spak_fsync
+        // the file aice has been done in the file workers
+    ,   tb_null
+    ,   tb_null
+    ,   tb_null
+    ,   tb_null
+    ,   tb_null
 
     ,   tb_aiop_spak_runtask
     ,   tb_null
@@ -1320,10 +1492,13 @@ static tb_long_t tb_aiop_spak_done(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice
     // done spak 
     return s_spak[aice->code](impl, aice);
 }
-static tb_void_t tb_aiop_spak_klist(tb_aiop_ptor_impl_t* impl)
+static tb_void_t tb_aiop_spak_klist(tb_aiop_ptor_impl_t* impl, tb_aiop_ptor_loop_t* loop)
 {
     // check
-    tb_assert_and_check_return(impl && impl->klist);
+    tb_assert_and_check_return(impl && impl->klist && loop && loop->timer);
+
+    // no killing aico? only peek it without the lock, it will be spaked in the next time after waking up this loop
+    tb_check_return(tb_vector_size(impl->klist));
 
     // enter
     tb_spinlock_enter(&impl->klock);
@@ -1340,20 +1515,15 @@ static tb_void_t tb_aiop_spak_klist(tb_aiop_ptor_impl_t* impl)
             // sock?
             if (aico->type == TB_AICO_TYPE_SOCK) 
             {
-                // add it first if do not exists timeout task
-                if (!aiop_aico->task) 
+                // add it to the timer of this loop first if do not exists timeout task, the aico not waiting will be spaked as killed
+                if (!aiop_aico->task && aiop_aico->waiting)
                 {
-                    aiop_aico->task = tb_ltimer_task_init(impl->ltimer, 10000, tb_false, tb_aiop_spak_wait_timeout, aico);
-                    aiop_aico->bltimer = 1;
+                    aiop_aico->loop = loop;
+                    aiop_aico->task = tb_timer_task_init(loop->timer, 10000, tb_false, tb_aiop_spak_wait_timeout, aico);
                 }
 
                 // kill the task
-                if (aiop_aico->task) 
-                {
-                    // kill task
-                    if (aiop_aico->bltimer) tb_ltimer_task_kill(impl->ltimer, aiop_aico->task);
-                    else tb_timer_task_kill(impl->timer, aiop_aico->task);
-                }
+                if (aiop_aico->task) tb_aiop_loop_task_kill(aiop_aico);
             }
             else if (aico->type == TB_AICO_TYPE_FILE)
             {
@@ -1364,18 +1534,13 @@ static tb_void_t tb_aiop_spak_klist(tb_aiop_ptor_impl_t* impl)
             // trace
             tb_trace_d("kill: aico: %p, type: %u: ok", aico, aico->type);
         }
-    }
 
-    // clear the killing aico list
-    tb_vector_clear(impl->klist);
+        // clear the killing aico list
+        tb_vector_clear(impl->klist);
+    }
 
     // leave
     tb_spinlock_leave(&impl->klock);
-
-    /* the aiop will wait long time if the lastest task wait period is too long
-     * so spak the aiop manually for spak the timer
-     */
-    tb_aiop_spak(impl->aiop);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -1384,13 +1549,18 @@ static tb_void_t tb_aiop_spak_klist(tb_aiop_ptor_impl_t* impl)
 static tb_bool_t tb_aiop_ptor_addo(tb_aicp_ptor_impl_t* ptor, tb_aico_impl_t* aico)
 {
     // check
-    tb_aiop_ptor_impl_t* impl = (tb_aiop_ptor_impl_t*)ptor;
-    tb_assert_and_check_return_val(impl && impl->aiop && aico, tb_false);
+    tb_aiop_ptor_impl_t* main = (tb_aiop_ptor_impl_t*)ptor;
+    tb_assert_and_check_return_val(main && main->shard_list && main->shard_size && aico, tb_false);
             
     // the aiop aico
     tb_aiop_aico_t* aiop_aico = (tb_aiop_aico_t*)aico;
 
+    // pin it to the next shard
+    tb_size_t shard = main->shard_size > 1? (tb_size_t)tb_atomic_fetch_and_inc(&main->shard_aico) % main->shard_size : 0;
+
     // init impl
+    tb_aiop_ptor_impl_t* impl = main->shard_list[shard];
+    tb_assert_and_check_return_val(impl && impl->aiop, tb_false);
     aiop_aico->impl = impl;
 
     // done
@@ -1431,11 +1601,15 @@ static tb_bool_t tb_aiop_ptor_addo(tb_aicp_ptor_impl_t* ptor, tb_aico_impl_t* ai
 static tb_void_t tb_aiop_ptor_kilo(tb_aicp_ptor_impl_t* ptor, tb_aico_impl_t* aico)
 {
     // check
-    tb_aiop_ptor_impl_t* impl = (tb_aiop_ptor_impl_t*)ptor;
-    tb_assert_and_check_return(impl && impl->klist && aico);
+    tb_assert_and_check_return(ptor && aico);
+
+    // the shard of this aico
+    tb_aiop_ptor_impl_t* impl = ((tb_aiop_aico_t*)aico)->impl;
+    if (!impl) impl = (tb_aiop_ptor_impl_t*)ptor;
+    tb_assert_and_check_return(impl->klist);
 
     // trace
-    tb_trace_d("kill: aico: %p, type: %u: ..", aico, aico->type);
+    tb_trace_d("kill: aico: %p, type: %u, shard: %lu: ..", aico, aico->type, impl->shard_indx);
 
     // append the killing aico
     tb_spinlock_enter(&impl->klock);
@@ -1448,8 +1622,11 @@ static tb_void_t tb_aiop_ptor_kilo(tb_aicp_ptor_impl_t* ptor, tb_aico_impl_t* ai
 static tb_bool_t tb_aiop_ptor_post(tb_aicp_ptor_impl_t* ptor, tb_aice_ref_t aice)
 {
     // check
-    tb_aiop_ptor_impl_t* impl = (tb_aiop_ptor_impl_t*)ptor;
-    tb_assert_and_check_return_val(impl && aice && aice->aico, tb_false);
+    tb_assert_and_check_return_val(ptor && aice && aice->aico, tb_false);
+
+    // the shard of this aico
+    tb_aiop_ptor_impl_t* impl = ((tb_aiop_aico_t*)aice->aico)->impl;
+    if (!impl) impl = (tb_aiop_ptor_impl_t*)ptor;
 
     // optimizate to spak the clos aice 
     if (aice->code == TB_AICE_CODE_CLOS)
@@ -1513,8 +1690,8 @@ static tb_bool_t tb_aiop_ptor_post(tb_aicp_ptor_impl_t* ptor, tb_aice_ref_t aice
         break;
     }
 
-    // work it 
-    if (ok) tb_aiop_spak_work(impl);
+    // work it, the file aice will be spaked after it has been done in the file workers
+    if (ok && aico->type != TB_AICO_TYPE_FILE) tb_aiop_spak_work(impl);
 
     // ok?
     return ok;
@@ -1522,33 +1699,35 @@ static tb_bool_t tb_aiop_ptor_post(tb_aicp_ptor_impl_t* ptor, tb_aice_ref_t aice
 static tb_void_t tb_aiop_ptor_kill(tb_aicp_ptor_impl_t* ptor)
 {
     // check
-    tb_aiop_ptor_impl_t* impl = (tb_aiop_ptor_impl_t*)ptor;
-    tb_assert_and_check_return(impl && impl->timer && impl->ltimer && impl->aiop);
+    tb_aiop_ptor_impl_t* main = (tb_aiop_ptor_impl_t*)ptor;
+    tb_assert_and_check_return(main && main->shard_list);
 
     // trace
     tb_trace_d("kill: ..");
 
-    // kill aiop
-    tb_aiop_kill(impl->aiop);
+    // kill all shards
+    tb_size_t i = 0;
+    for (i = 0; i < main->shard_size; i++)
+    {
+        // the shard
+        tb_aiop_ptor_impl_t* impl = main->shard_list[i];
+        tb_assert_and_check_continue(impl && impl->aiop);
 
-    // kill file
-    tb_aicp_file_kill(impl); 
+        // kill aiop
+        tb_aiop_kill(impl->aiop);
 
-    // work it
-    tb_aiop_spak_work(impl);
+        // kill file
+        tb_aicp_file_kill(impl); 
+
+        // work it
+        tb_aiop_spak_work_shard(impl);
+    }
 }
-static tb_void_t tb_aiop_ptor_exit(tb_aicp_ptor_impl_t* ptor)
+static tb_void_t tb_aiop_ptor_exit_loop(tb_aiop_ptor_impl_t* impl)
 {
     // check
-    tb_aiop_ptor_impl_t* impl = (tb_aiop_ptor_impl_t*)ptor;
     tb_assert_and_check_return(impl);
 
-    // trace
-    tb_trace_d("exit");
-
-    // exit file
-    tb_aicp_file_exit(impl);
-
     // exit loop
     if (impl->loop)
     {
@@ -1561,6 +1740,45 @@ static tb_void_t tb_aiop_ptor_exit(tb_aicp_ptor_impl_t* ptor)
         tb_thread_exit(impl->loop);
         impl->loop = tb_null;
     }
+}
+static tb_void_t tb_aiop_ptor_loop_exit_impl(tb_aiop_ptor_loop_t* loop)
+{
+    // check
+    tb_assert_and_check_return(loop);
+
+    // exit messages, the exited tasks will be freed with the timer
+    tb_spinlock_enter(&loop->mlock);
+    if (loop->mlist) tb_vector_exit(loop->mlist);
+    loop->mlist = tb_null;
+    tb_spinlock_leave(&loop->mlock);
+
+    // exit timer
+    if (loop->timer) tb_timer_exit(loop->timer);
+    loop->timer = tb_null;
+
+    // exit wait
+    if (loop->wait) tb_semaphore_exit(loop->wait);
+    loop->wait = tb_null;
+
+    // exit lock
+    tb_spinlock_exit(&loop->mlock);
+
+    // exit it
+    tb_free(loop);
+}
+static tb_void_t tb_aiop_ptor_exit_shard(tb_aiop_ptor_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // trace
+    tb_trace_d("exit: shard: %lu", impl->shard_indx);
+
+    // exit file
+    tb_aicp_file_exit(impl);
+
+    // exit loop
+    tb_aiop_ptor_exit_loop(impl);
 
     // exit spak
     tb_spinlock_enter(&impl->lock);
@@ -1570,10 +1788,16 @@ static tb_void_t tb_aiop_ptor_exit(tb_aicp_ptor_impl_t* ptor)
     impl->spak[1] = tb_null;
     tb_spinlock_leave(&impl->lock);
 
-    // exit kill
+    // exit kill and loops
     tb_spinlock_enter(&impl->klock);
     if (impl->klist) tb_vector_exit(impl->klist);
     impl->klist = tb_null;
+    while (impl->loops)
+    {
+        tb_aiop_ptor_loop_t* loop = impl->loops;
+        impl->loops = loop->next;
+        tb_aiop_ptor_loop_exit_impl(loop);
+    }
     tb_spinlock_leave(&impl->klock);
 
     // exit aiop
@@ -1584,40 +1808,148 @@ static tb_void_t tb_aiop_ptor_exit(tb_aicp_ptor_impl_t* ptor)
     if (impl->list) tb_free(impl->list);
     impl->list = tb_null;
 
-    // exit wait
-    if (impl->wait) tb_semaphore_exit(impl->wait);
-    impl->wait = tb_null;
-
-    // exit timer
-    if (impl->timer) tb_timer_exit(impl->timer);
-    impl->timer = tb_null;
-
-    // exit ltimer
-    if (impl->ltimer) tb_ltimer_exit(impl->ltimer);
-    impl->ltimer = tb_null;
-
     // exit lock
     tb_spinlock_exit(&impl->lock);
 
     // exit it
     tb_free(impl);
 }
-static tb_long_t tb_aiop_ptor_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t loop, tb_aice_ref_t resp, tb_long_t timeout)
+static tb_void_t tb_aiop_ptor_exit(tb_aicp_ptor_impl_t* ptor)
+{
+    // check
+    tb_aiop_ptor_impl_t* main = (tb_aiop_ptor_impl_t*)ptor;
+    tb_assert_and_check_return(main);
+
+    // trace
+    tb_trace_d("exit");
+
+    // exit the other shards
+    if (main->shard_list)
+    {
+        /* exit the loops of all shards first
+         *
+         * the accepted aico will be pinned to the other shard in the spak loop
+         */
+        tb_size_t i = 0;
+        for (i = 0; i < main->shard_size; i++)
+        {
+            if (main->shard_list[i]) tb_aiop_ptor_exit_loop(main->shard_list[i]);
+        }
+
+        // exit the file workers, they will push the done aice to all shards
+        tb_aicp_file_exit(main);
+
+        // exit shards
+        for (i = 1; i < main->shard_size; i++)
+        {
+            if (main->shard_list[i]) tb_aiop_ptor_exit_shard(main->shard_list[i]);
+            main->shard_list[i] = tb_null;
+        }
+        tb_free(main->shard_list);
+        main->shard_list = tb_null;
+    }
+    main->shard_size = 0;
+
+    // exit the main shard
+    tb_aiop_ptor_exit_shard(main);
+}
+static tb_handle_t tb_aiop_ptor_loop_init(tb_aicp_ptor_impl_t* ptor)
 {
     // check
-    tb_aiop_ptor_impl_t* impl = (tb_aiop_ptor_impl_t*)ptor;
-    tb_aicp_impl_t*      aicp = impl? impl->base.aicp : tb_null;
-    tb_assert_and_check_return_val(impl && impl->wait && aicp && resp, -1);
+    tb_aiop_ptor_impl_t* main = (tb_aiop_ptor_impl_t*)ptor;
+    tb_assert_and_check_return_val(main && main->shard_list && main->shard_size, tb_null);
+
+    // pin this loop to the next shard
+    tb_size_t shard = main->shard_size > 1? (tb_size_t)tb_atomic_fetch_and_inc(&main->shard_loop) % main->shard_size : 0;
+
+    // the shard
+    tb_aiop_ptor_impl_t* impl = main->shard_list[shard];
+    tb_assert_and_check_return_val(impl && impl->base.aicp, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_aiop_ptor_loop_t*    loop = tb_null;
+    do
+    {
+        // make loop
+        loop = tb_malloc0_type(tb_aiop_ptor_loop_t);
+        tb_assert_and_check_break(loop);
+
+        // init loop
+        loop->home = impl;
+        loop->self = tb_thread_self();
+
+        // init the message lock
+        if (!tb_spinlock_init(&loop->mlock)) break;
+
+        // init wait
+        loop->wait = tb_semaphore_init(0);
+        tb_assert_and_check_break(loop->wait);
+
+        // init the message list
+        loop->mlist = tb_vector_init((impl->base.aicp->maxn >> 6) + 16, tb_element_mem(sizeof(tb_aiop_loop_mesg_t), tb_null, tb_null));
+        tb_assert_and_check_break(loop->mlist);
+
+        // init timer and using cache time, it is a hierarchical timing wheel for both the tasks and the timeouts
+        loop->timer = tb_timer_init(impl->base.aicp->maxn, tb_true);
+        tb_assert_and_check_break(loop->timer);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
 
-    // spak the killing list
-    tb_aiop_spak_klist(impl);
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (loop) tb_aiop_ptor_loop_exit_impl(loop);
+        return tb_null;
+    }
+
+    // trace
+    tb_trace_d("loop[%u]: init: shard: %lu", (tb_uint16_t)tb_thread_self(), shard);
+
+    /* append this loop to its shard
+     *
+     * @note it will be freed after exiting the shard, the other threads maybe cancel its tasks still
+     */
+    tb_spinlock_enter(&impl->klock);
+    loop->next = impl->loops;
+    impl->loops = loop;
+    tb_spinlock_leave(&impl->klock);
+
+    // work it
+    tb_atomic_fetch_and_inc(&impl->shard_work);
+
+    // ok
+    return (tb_handle_t)loop;
+}
+static tb_void_t tb_aiop_ptor_loop_exit(tb_aicp_ptor_impl_t* ptor, tb_handle_t handle)
+{
+    // check
+    tb_aiop_ptor_loop_t* loop = (tb_aiop_ptor_loop_t*)handle;
+    tb_assert_and_check_return(loop && loop->home);
+
+    // trace
+    tb_trace_d("loop[%u]: exit: shard: %lu", (tb_uint16_t)tb_thread_self(), loop->home->shard_indx);
+
+    // the tasks of this loop will be cancelled by the messages after exiting it
+    loop->self = 0;
+
+    // unwork it
+    tb_atomic_fetch_and_dec(&loop->home->shard_work);
+}
+static tb_long_t tb_aiop_ptor_spak_shard(tb_aiop_ptor_impl_t* impl, tb_aiop_ptor_loop_t* loop, tb_aice_ref_t resp)
+{
+    // check
+    tb_assert_and_check_return_val(impl && loop && resp, -1);
 
     // enter 
     tb_spinlock_enter(&impl->lock);
 
     // done
     tb_long_t ok = -1;
-    tb_bool_t null = tb_false;
     do
     {
         // check
@@ -1627,7 +1959,7 @@ static tb_long_t tb_aiop_ptor_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t loop,
         ok = 0;
 
         // spak aice from the higher priority spak first
-        if (!(null = tb_queue_null(impl->spak[0]))) 
+        if (!tb_queue_null(impl->spak[0])) 
         {
             // get resp
             tb_aice_ref_t aice = tb_queue_get(impl->spak[0]);
@@ -1637,7 +1969,7 @@ static tb_long_t tb_aiop_ptor_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t loop,
                 *resp = *aice;
 
                 // trace
-                tb_trace_d("spak[%u]: code: %lu, priority: 0, size: %lu", (tb_uint16_t)tb_thread_self(), aice->code, tb_queue_size(impl->spak[0]));
+                tb_trace_d("spak[%u]: code: %lu, priority: 0, shard: %lu, size: %lu", (tb_uint16_t)tb_thread_self(), aice->code, impl->shard_indx, tb_queue_size(impl->spak[0]));
 
                 // pop it
                 tb_queue_pop(impl->spak[0]);
@@ -1648,7 +1980,7 @@ static tb_long_t tb_aiop_ptor_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t loop,
         }
 
         // no aice? spak aice from the lower priority spak next
-        if (!ok && !(null = tb_queue_null(impl->spak[1]))) 
+        if (!ok && !tb_queue_null(impl->spak[1])) 
         {
             // get resp
             tb_aice_ref_t aice = tb_queue_get(impl->spak[1]);
@@ -1658,7 +1990,7 @@ static tb_long_t tb_aiop_ptor_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t loop,
                 *resp = *aice;
 
                 // trace
-                tb_trace_d("spak[%u]: code: %lu, priority: 1, size: %lu", (tb_uint16_t)tb_thread_self(), aice->code, tb_queue_size(impl->spak[1]));
+                tb_trace_d("spak[%u]: code: %lu, priority: 1, shard: %lu, size: %lu", (tb_uint16_t)tb_thread_self(), aice->code, impl->shard_indx, tb_queue_size(impl->spak[1]));
 
                 // pop it
                 tb_queue_pop(impl->spak[1]);
@@ -1673,34 +2005,80 @@ static tb_long_t tb_aiop_ptor_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t loop,
     // leave 
     tb_spinlock_leave(&impl->lock);
 
-    // done it
-    if (ok) ok = tb_aiop_spak_done(impl, resp);
+    // spaked? the file workers waiting the room of the full spak queue can push it now
+    if (ok > 0) tb_aicp_file_room(impl);
+
+    // ok?
+    return ok;
+}
+static tb_long_t tb_aiop_ptor_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t handle, tb_aice_ref_t resp, tb_long_t timeout)
+{
+    // check
+    tb_aiop_ptor_impl_t* main = (tb_aiop_ptor_impl_t*)ptor;
+    tb_aiop_ptor_loop_t* loop = (tb_aiop_ptor_loop_t*)handle;
+    tb_aicp_impl_t*      aicp = main? main->base.aicp : tb_null;
+    tb_assert_and_check_return_val(main && main->shard_list && aicp && loop && loop->timer && loop->wait && resp, -1);
+
+    // the shard of this loop
+    tb_aiop_ptor_impl_t* home = loop->home;
+    tb_assert_and_check_return_val(home, -1);
+
+    // cancel the tasks of this loop from the other threads
+    tb_aiop_loop_spak(loop);
+
+    // spak the timer of this loop, the expired tasks will be pushed to the spak queues
+    if (!tb_timer_spak(loop->timer)) return -1;
+
+    /* spak the killing lists of all shards
+     *
+     * @note the shard without its own loop is not always stolen, so its killing aicos may be not spaked
+     */
+    tb_size_t i = 0;
+    for (i = 0; i < main->shard_size; i++) tb_aiop_spak_klist(main->shard_list[i], loop);
+
+    // spak aice from the shard of this loop first
+    tb_aiop_ptor_impl_t*    impl = home;
+    tb_long_t               ok = tb_aiop_ptor_spak_shard(impl, loop, resp);
 
-    // null? wait it
-    tb_check_return_val(!ok && null, ok);
+    // no aice? steal aice from the other shards
+    if (!ok && main->shard_size > 1)
+    {
+        tb_size_t n = main->shard_size;
+        for (i = 1; i < n && !ok; i++)
+        {
+            // the next shard
+            impl = main->shard_list[(home->shard_indx + i) % n];
+            tb_assert_and_check_break(impl);
+
+            // steal it
+            ok = tb_aiop_ptor_spak_shard(impl, loop, resp);
+        }
+    }
+
+    // failed?
+    tb_check_return_val(ok >= 0, -1);
+
+    // done it using the shard of this aice
+    if (ok) return tb_aiop_spak_done(impl, loop, resp);
     
     // killed? break it
     tb_check_return_val(!tb_atomic_get(&aicp->kill), -1);
 
+    // wait until the next task of this loop is expired at most
+    tb_size_t delay = tb_timer_delay(loop->timer);
+    if (delay != (tb_size_t)-1 && (timeout < 0 || delay < (tb_size_t)timeout)) timeout = (tb_long_t)delay;
+
     // trace
-    tb_trace_d("wait[%u]: ..", (tb_uint16_t)tb_thread_self());
+    tb_trace_d("wait[%u]: shard: %lu, timeout: %ld: ..", (tb_uint16_t)tb_thread_self(), home->shard_indx, timeout);
 
     // wait some time
-    if (tb_semaphore_wait(impl->wait, timeout) < 0) return -1;
+    if (timeout && tb_semaphore_wait(loop->wait, timeout) < 0) return -1;
 
     // timeout 
     return 0;
 }
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * file implementation
- */
-#include "aicp_file.c"
-
-/* //////////////////////////////////////////////////////////////////////////////////////
- * interfaces
- */
-static tb_aicp_ptor_impl_t* tb_aiop_ptor_init(tb_aicp_impl_t* aicp)
+static tb_aiop_ptor_impl_t* tb_aiop_ptor_init_shard(tb_aicp_impl_t* aicp, tb_aiop_ptor_impl_t* main, tb_size_t indx)
 {
     // check
     tb_assert_and_check_return_val(aicp && aicp->maxn, tb_null);
@@ -1722,15 +2100,17 @@ static tb_aicp_ptor_impl_t* tb_aiop_ptor_init(tb_aicp_impl_t* aicp)
         impl->base.addo         = tb_aiop_ptor_addo;
         impl->base.kilo         = tb_aiop_ptor_kilo;
         impl->base.post         = tb_aiop_ptor_post;
+        impl->base.loop_init    = tb_aiop_ptor_loop_init;
+        impl->base.loop_exit    = tb_aiop_ptor_loop_exit;
         impl->base.loop_spak    = tb_aiop_ptor_spak;
 
+        // init shard
+        impl->main              = main? main : impl;
+        impl->shard_indx        = indx;
+
         // init lock
         if (!tb_spinlock_init(&impl->lock)) break;
 
-        // init wait
-        impl->wait = tb_semaphore_init(0);
-        tb_assert_and_check_break(impl->wait);
-
         // init aiop
         impl->aiop = tb_aiop_init(aicp->maxn);
         tb_assert_and_check_break(impl->aiop);
@@ -1751,14 +2131,6 @@ static tb_aicp_ptor_impl_t* tb_aiop_ptor_init(tb_aicp_impl_t* aicp)
         impl->list = tb_nalloc0(impl->maxn, sizeof(tb_aioe_t));
         tb_assert_and_check_break(impl->list);
 
-        // init timer and using cache time
-        impl->timer = tb_timer_init((aicp->maxn >> 4) + 16, tb_true);
-        tb_assert_and_check_break(impl->timer);
-
-        // init ltimer and using cache time
-        impl->ltimer = tb_ltimer_init(aicp->maxn, TB_LTIMER_TICK_S, tb_true);
-        tb_assert_and_check_break(impl->ltimer);
-
         // init the killing list lock
         if (!tb_spinlock_init(&impl->klock)) break;
 
@@ -1771,9 +2143,71 @@ static tb_aicp_ptor_impl_t* tb_aiop_ptor_init(tb_aicp_impl_t* aicp)
         tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&impl->lock, "aicp_aiop");
 #endif
 
-        // init loop
-        impl->loop = tb_thread_init(tb_null, tb_aiop_spak_loop, impl, 0);
-        tb_assert_and_check_break(impl->loop);
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_aiop_ptor_exit_shard(impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return impl;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * file implementation
+ */
+#include "aicp_file.c"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+static tb_aicp_ptor_impl_t* tb_aiop_ptor_init(tb_aicp_impl_t* aicp)
+{
+    // check
+    tb_assert_and_check_return_val(aicp && aicp->maxn, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_aiop_ptor_impl_t*    main = tb_null;
+    do
+    {
+        // init the main shard
+        main = tb_aiop_ptor_init_shard(aicp, tb_null, 0);
+        tb_assert_and_check_break(main);
+
+        // init the shard list
+        main->shard_size = tb_min(tb_max(aicp->shard, 1), TB_AIOP_PTOR_SHARD_MAXN);
+        main->shard_list = tb_nalloc0_type(main->shard_size, tb_aiop_ptor_impl_t*);
+        tb_assert_and_check_break(main->shard_list);
+
+        // init the other shards
+        tb_size_t i = 0;
+        main->shard_list[0] = main;
+        for (i = 1; i < main->shard_size; i++)
+        {
+            main->shard_list[i] = tb_aiop_ptor_init_shard(aicp, main, i);
+            tb_assert_and_check_break(main->shard_list[i]);
+        }
+        tb_check_break(i == main->shard_size);
+
+        // init the spak loops
+        for (i = 0; i < main->shard_size; i++)
+        {
+            tb_aiop_ptor_impl_t* impl = main->shard_list[i];
+            impl->loop = tb_thread_init(tb_null, tb_aiop_spak_loop, impl, 0);
+            tb_assert_and_check_break(impl->loop);
+        }
+        tb_check_break(i == main->shard_size);
+
+        // trace
+        tb_trace_d("init: shards: %lu", main->shard_size);
 
         // ok
         ok = tb_true;
@@ -1784,11 +2218,11 @@ static tb_aicp_ptor_impl_t* tb_aiop_ptor_init(tb_aicp_impl_t* aicp)
     if (!ok)
     {
         // exit it
-        if (impl) tb_aiop_ptor_exit((tb_aicp_ptor_impl_t*)impl);
+        if (main) tb_aiop_ptor_exit((tb_aicp_ptor_impl_t*)main);
         return tb_null;
     }
 
     // ok?
-    return (tb_aicp_ptor_impl_t*)impl;
+    return (tb_aicp_ptor_impl_t*)main;
 }
 
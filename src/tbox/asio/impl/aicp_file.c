@@ -27,64 +27,71 @@
 #include "prefix.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * macros
  */
-static tb_bool_t tb_aicp_file_init(tb_aiop_ptor_impl_t* impl)
-{
-    return tb_true;
-}
-static tb_void_t tb_aicp_file_exit(tb_aiop_ptor_impl_t* impl)
-{
-}
-static tb_bool_t tb_aicp_file_addo(tb_aiop_ptor_impl_t* impl, tb_aico_impl_t* aico)
-{
-    return tb_true;
-}
-static tb_void_t tb_aicp_file_kilo(tb_aiop_ptor_impl_t* impl, tb_aico_impl_t* aico)
-{
-    // check
-    tb_file_ref_t file = tb_aico_file((tb_aico_ref_t)aico);
-    tb_assert_and_check_return(file);
-    
-    // kill it
-    tb_file_exit(file);
-}
-static tb_bool_t tb_aicp_file_post(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
+
+// the file worker maximum count
+#ifdef __tb_small__
+#   define TB_AICP_FILE_WORKER_MAXN         (4)
+#else
+#   define TB_AICP_FILE_WORKER_MAXN         (16)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the file engine type
+ *
+ * the file aice will be done in the file workers instead of the spak loops,
+ * so the blocking disk i/o will not stall the socket completions of all loops.
+ *
+ * post: aice => jobs => workers: pread/pwrite/fsync => the spak queue of the aico shard => loop
+ *
+ * the file aices are done in order for the same aico, 
+ * because every aico only has one pending aice and the jobs queue is fifo.
+ *
+ * the worker will wait the room if the spak queue is full, and the spak loop will wake it up after spaking one aice,
+ * the done aice will be spaked as the killed aice by the worker directly if all loops have been exited.
+ *
+ * the engine is owned by the main ptor and shared for all shards,
+ * the workers will be started when the first file aico is added.
+ */
+typedef struct __tb_aicp_file_t
 {
-    // check
-    tb_assert_and_check_return_val(impl && aice, tb_false);
-        
-    // the priority
-    tb_size_t priority = tb_aice_impl_priority(aice);
-    tb_assert_and_check_return_val(priority < tb_arrayn(impl->spak) && impl->spak[priority], tb_false);
+    // the jobs lock
+    tb_spinlock_t               lock;
 
-    // enter 
-    tb_spinlock_enter(&impl->lock);
+    // the jobs
+    tb_queue_ref_t              jobs;
 
-    // post aice
-    tb_bool_t ok = tb_true;
-    if (!tb_queue_full(impl->spak[priority])) 
-    {
-        // put
-        tb_queue_put(impl->spak[priority], aice);
+    // the jobs wait
+    tb_semaphore_ref_t          wait;
 
-        // trace
-        tb_trace_d("post: code: %lu, priority: %lu, size: %lu", aice->code, priority, tb_queue_size(impl->spak[priority]));
-    }
-    else
-    {
-        // failed
-        ok = tb_false;
+    // the room wait of the spak queues
+    tb_semaphore_ref_t          room;
 
-        // assert
-        tb_assert(0);
-    }
+    // the worker count of waiting the room
+    tb_atomic_t                 full;
 
-    // leave 
-    tb_spinlock_leave(&impl->lock);
+    // the workers
+    tb_thread_ref_t             workers[TB_AICP_FILE_WORKER_MAXN];
 
-    // ok?
-    return ok;
+    // the worker count
+    tb_size_t                   worker_size;
+
+    // is killed?
+    tb_atomic_t                 kill;
+
+}tb_aicp_file_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static __tb_inline__ tb_aicp_file_t* tb_aicp_file_engine(tb_aiop_ptor_impl_t* impl)
+{
+    // the engine of the main ptor
+    return (impl && impl->main)? (tb_aicp_file_t*)impl->main->fpriv : tb_null;
 }
 static tb_long_t tb_aicp_file_spak_read(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
 {
@@ -227,10 +234,373 @@ static tb_long_t tb_aicp_file_spak_fsync(tb_aiop_ptor_impl_t* impl, tb_aice_ref_
     // ok?
     return 1;
 }
+static tb_long_t tb_aicp_file_spak_done(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(impl && aice && aice->aico, -1);
+
+    // killed?
+    if (tb_aico_impl_is_killed((tb_aico_impl_t*)aice->aico))
+    {
+        // trace
+        tb_trace_d("file: aico: %p, code: %lu: killed", aice->aico, aice->code);
+
+        // killed
+        aice->state = TB_STATE_KILLED;
+        return 1;
+    }
+
+    // done it
+    switch (aice->code)
+    {
+    case TB_AICE_CODE_READ:     return tb_aicp_file_spak_read(impl, aice);
+    case TB_AICE_CODE_WRIT:     return tb_aicp_file_spak_writ(impl, aice);
+    case TB_AICE_CODE_READV:    return tb_aicp_file_spak_readv(impl, aice);
+    case TB_AICE_CODE_WRITV:    return tb_aicp_file_spak_writv(impl, aice);
+    case TB_AICE_CODE_FSYNC:    return tb_aicp_file_spak_fsync(impl, aice);
+    default:
+        break;
+    }
+
+    // failed
+    tb_assert(0);
+    aice->state = TB_STATE_FAILED;
+    return 1;
+}
+static tb_void_t tb_aicp_file_spak_kill(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
+{
+    // check
+    tb_aico_impl_t* aico = (tb_aico_impl_t*)aice->aico;
+    tb_assert_and_check_return(impl && aico);
+
+    // trace
+    tb_trace_d("file: aico: %p, code: %lu: killed without loops", aico, aice->code);
+
+    // pending? clear state like the spak loop
+    tb_atomic_fetch_and_pset_explicit(&aico->state, TB_STATE_PENDING, TB_STATE_OPENED, TB_ATOMIC_ACQ_REL);
+
+    // all loops have been exited, done func as the killed aice, @note maybe the aico exit will be called
+    aice->state = TB_STATE_KILLED;
+    if (aice->func && !aice->func(aice))
+    {
+        // trace
+        tb_trace_e("file: aico: %p, code: %lu: done aice func failed!", aico, aice->code);
+    }
+
+    // killing? update to the killed state
+    tb_atomic_fetch_and_pset_explicit(&aico->state, TB_STATE_KILLING, TB_STATE_KILLED, TB_ATOMIC_ACQ_REL);
+}
+static tb_void_t tb_aicp_file_spak_push(tb_aicp_file_t* file, tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return(file && file->room && impl && impl->base.aicp && aice);
+
+    // the priority
+    tb_size_t priority = tb_aice_impl_priority(aice);
+    tb_assert_and_check_return(priority < tb_arrayn(impl->spak));
+
+    // push the done aice to the spak queue of this shard, the spak loop will spak it directly because it is not pending
+    tb_aicp_impl_t* aicp = impl->base.aicp;
+    while (1)
+    {
+        // all loops have been exited? nobody will spak it, done it as the killed aice directly
+        if (tb_atomic_get(&aicp->kill_all) && !tb_atomic_get(&aicp->work)) 
+        {
+            tb_aicp_file_spak_kill(impl, aice);
+            return ;
+        }
+
+        // enter 
+        tb_spinlock_enter(&impl->lock);
+
+        // push it if not full, or wait the room after the loops spak some aices
+        tb_bool_t ok = tb_false;
+        if (impl->spak[priority] && !tb_queue_full(impl->spak[priority])) 
+        {
+            tb_queue_put(impl->spak[priority], aice);
+            ok = tb_true;
+        }
+        else tb_atomic_fetch_and_inc(&file->full);
+
+        // leave 
+        tb_spinlock_leave(&impl->lock);
+
+        // ok? work it
+        if (ok)
+        {
+            tb_aiop_spak_work(impl);
+            break;
+        }
+
+        // full? wake up the loops and wait the room, @note the timeout only for checking whether all loops have been exited
+        tb_aiop_spak_work(impl);
+        tb_semaphore_wait(file->room, 100);
+        tb_atomic_fetch_and_dec(&file->full);
+    }
+}
+static tb_void_t tb_aicp_file_room(tb_aiop_ptor_impl_t* impl)
+{
+    // some workers are waiting the room of the spak queues? wake up one
+    tb_aicp_file_t* file = tb_aicp_file_engine(impl);
+    if (file && file->room && tb_atomic_get(&file->full)) tb_semaphore_post(file->room, 1);
+}
+static tb_pointer_t tb_aicp_file_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_aicp_file_t* file = (tb_aicp_file_t*)priv;
+    tb_assert_and_check_return_val(file && file->jobs && file->wait, tb_null);
+
+    // trace
+    tb_trace_d("file: worker[%lu]: init", tb_thread_self());
+
+    // done
+    while (1)
+    {
+        // pop one job
+        tb_aice_t   aice;
+        tb_bool_t   ok = tb_false;
+        tb_spinlock_enter(&file->lock);
+        if (!tb_queue_null(file->jobs))
+        {
+            aice = *((tb_aice_ref_t)tb_queue_get(file->jobs));
+            tb_queue_pop(file->jobs);
+            ok = tb_true;
+        }
+        tb_spinlock_leave(&file->lock);
+
+        // no jobs? 
+        if (!ok)
+        {
+            // killed? exit it
+            tb_check_break(!tb_atomic_get(&file->kill));
+
+            // wait jobs
+            if (tb_semaphore_wait(file->wait, -1) < 0) break;
+            continue ;
+        }
+
+        // the shard of this aico
+        tb_aiop_ptor_impl_t* impl = ((tb_aiop_aico_t*)aice.aico)->impl;
+        tb_assert_and_check_continue(impl);
+
+        // killed? spak it as the killed aice
+        if (tb_atomic_get(&file->kill)) aice.state = TB_STATE_KILLED;
+        // done the blocking file i/o
+        else if (tb_aicp_file_spak_done(impl, &aice) < 0) aice.state = TB_STATE_FAILED;
+
+        // push it to the spak loop
+        tb_aicp_file_spak_push(file, impl, &aice);
+    }
+
+    // trace
+    tb_trace_d("file: worker[%lu]: exit", tb_thread_self());
+
+    // exit
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+static tb_bool_t tb_aicp_file_init(tb_aiop_ptor_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->base.aicp && impl->main, tb_false);
+
+    // only init the engine for the main ptor
+    tb_check_return_val(impl->main == impl, tb_true);
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_aicp_file_t* file = tb_null;
+    do
+    {
+        // make file
+        file = tb_malloc0_type(tb_aicp_file_t);
+        tb_assert_and_check_break(file);
+
+        // init lock
+        if (!tb_spinlock_init(&file->lock)) break;
+
+        // init jobs, every aico only has one pending aice
+        file->jobs = tb_queue_init(impl->base.aicp->maxn + 16, tb_element_mem(sizeof(tb_aice_t), tb_null, tb_null));
+        tb_assert_and_check_break(file->jobs);
+
+        // init wait
+        file->wait = tb_semaphore_init(0);
+        tb_assert_and_check_break(file->wait);
+
+        // init room
+        file->room = tb_semaphore_init(0);
+        tb_assert_and_check_break(file->room);
+
+        // register lock profiler
+#ifdef TB_LOCK_PROFILER_ENABLE
+        tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&file->lock, "aicp_file");
+#endif
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // save it
+    impl->fpriv = (tb_handle_t)file;
+
+    // failed? exit it
+    if (!ok) tb_aicp_file_exit(impl);
+
+    // ok?
+    return ok;
+}
+static tb_void_t tb_aicp_file_exit(tb_aiop_ptor_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // the file, only for the main ptor
+    tb_aicp_file_t* file = (tb_aicp_file_t*)impl->fpriv;
+    tb_check_return(file);
+
+    // kill it
+    tb_aicp_file_kill(impl);
+
+    // exit workers
+    tb_size_t i = 0;
+    for (i = 0; i < file->worker_size; i++)
+    {
+        if (file->workers[i])
+        {
+            // wait it
+            tb_long_t wait = 0;
+            if ((wait = tb_thread_wait(file->workers[i], 5000)) <= 0)
+            {
+                // trace
+                tb_trace_e("file: worker[%lu]: wait failed: %ld!", i, wait);
+            }
+
+            // exit it
+            tb_thread_exit(file->workers[i]);
+            file->workers[i] = tb_null;
+        }
+    }
+    file->worker_size = 0;
+
+    // exit jobs
+    tb_spinlock_enter(&file->lock);
+    if (file->jobs) tb_queue_exit(file->jobs);
+    file->jobs = tb_null;
+    tb_spinlock_leave(&file->lock);
+
+    // exit wait
+    if (file->wait) tb_semaphore_exit(file->wait);
+    file->wait = tb_null;
+
+    // exit room
+    if (file->room) tb_semaphore_exit(file->room);
+    file->room = tb_null;
+
+    // exit lock
+    tb_spinlock_exit(&file->lock);
+
+    // exit it
+    tb_free(file);
+    impl->fpriv = tb_null;
+}
+static tb_bool_t tb_aicp_file_addo(tb_aiop_ptor_impl_t* impl, tb_aico_impl_t* aico)
+{
+    // check
+    tb_aicp_file_t* file = tb_aicp_file_engine(impl);
+    tb_assert_and_check_return_val(file && aico, tb_false);
+
+    // enter
+    tb_spinlock_enter(&file->lock);
+
+    // start the workers for the first file aico
+    if (!file->worker_size && !tb_atomic_get(&file->kill))
+    {
+        // the worker count, the disk i/o is blocking and need not the cpu, so we may use more workers
+        tb_size_t count = tb_min(tb_max(tb_processor_count() << 1, 2), TB_AICP_FILE_WORKER_MAXN);
+
+        // init workers
+        for (file->worker_size = 0; file->worker_size < count; file->worker_size++)
+        {
+            file->workers[file->worker_size] = tb_thread_init(tb_null, tb_aicp_file_loop, file, 0);
+            tb_assert_and_check_break(file->workers[file->worker_size]);
+        }
+
+        // trace
+        tb_trace_d("file: workers: %lu", file->worker_size);
+    }
+
+    // ok?
+    tb_bool_t ok = file->worker_size? tb_true : tb_false;
+
+    // leave
+    tb_spinlock_leave(&file->lock);
+
+    // ok?
+    return ok;
+}
+static tb_void_t tb_aicp_file_kilo(tb_aiop_ptor_impl_t* impl, tb_aico_impl_t* aico)
+{
+    /* the waiting job of this aico will be spaked as the killed aice by the worker,
+     * and the running job can not be interrupted, we need only wait it.
+     *
+     * @note we cannot close the file here, because the worker may be using it now
+     */
+}
+static tb_bool_t tb_aicp_file_post(tb_aiop_ptor_impl_t* impl, tb_aice_ref_t aice)
+{
+    // check
+    tb_aicp_file_t* file = tb_aicp_file_engine(impl);
+    tb_assert_and_check_return_val(file && aice, tb_false);
+
+    // enter 
+    tb_spinlock_enter(&file->lock);
+
+    // post aice
+    tb_bool_t ok = tb_true;
+    if (file->jobs && !tb_queue_full(file->jobs)) 
+    {
+        // put
+        tb_queue_put(file->jobs, aice);
+
+        // trace
+        tb_trace_d("post: code: %lu, jobs: %lu", aice->code, tb_queue_size(file->jobs));
+    }
+    else
+    {
+        // failed
+        ok = tb_false;
+
+        // trace
+        tb_trace_e("post: code: %lu: failed, the file jobs is full!", aice->code);
+    }
+
+    // leave 
+    tb_spinlock_leave(&file->lock);
+
+    // work it
+    if (ok) tb_semaphore_post(file->wait, 1);
+
+    // ok?
+    return ok;
+}
 static tb_void_t tb_aicp_file_kill(tb_aiop_ptor_impl_t* impl)
 {
+    // check
+    tb_aicp_file_t* file = tb_aicp_file_engine(impl);
+    tb_check_return(file);
+
+    // kill it
+    if (!tb_atomic_fetch_and_set(&file->kill, 1))
+    {
+        // trace
+        tb_trace_d("file: kill: ..");
+
+        // wake up all workers
+        if (file->wait && file->worker_size) tb_semaphore_post(file->wait, file->worker_size);
+        if (file->room && tb_atomic_get(&file->full)) tb_semaphore_post(file->room, file->worker_size);
+    }
 }
 static tb_void_t tb_aicp_file_poll(tb_aiop_ptor_impl_t* impl)
 {
 }
-
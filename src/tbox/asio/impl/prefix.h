@@ -168,6 +168,9 @@ typedef struct __tb_aicp_impl_t
     // the object maxn
     tb_size_t                   maxn;
 
+    // the reactor shard count
+    tb_size_t                   shard;
+
     // the ptor
     tb_aicp_ptor_impl_t*        ptor;
 
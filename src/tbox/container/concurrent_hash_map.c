@@ -0,0 +1,420 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        concurrent_hash_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "concurrent_hash_map"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "concurrent_hash_map.h"
+#include "flat_hash_map.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the shard maximum count
+#define TB_CONCURRENT_HASH_MAP_SHARD_MAXN           (256)
+
+// the lock value of the writer
+#define TB_CONCURRENT_HASH_MAP_LOCK_WRITER          (-1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the concurrent hash map shard type, uses the individual cache line
+typedef __tb_cacheline_aligned__ struct __tb_concurrent_hash_map_shard_t
+{
+    // the read-write lock, > 0: the reader count, -1: locked by the writer
+    tb_atomic_t                     lock;
+
+    // the waiting writer count, the new readers will wait it for avoiding to starve the writers
+    tb_atomic_t                     wait;
+
+    // the item size
+    tb_atomic_t                     size;
+
+    // the contention count, the lock has been held by the others when entering it
+    tb_atomic_t                     contention;
+
+    // the hash map
+    tb_flat_hash_map_ref_t          hash_map;
+
+}__tb_cacheline_aligned__ tb_concurrent_hash_map_shard_t;
+
+// the concurrent hash map impl type
+typedef struct __tb_concurrent_hash_map_impl_t
+{
+    // the shards
+    tb_concurrent_hash_map_shard_t* shards;
+
+    // the shard count
+    tb_size_t                       shard_count;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+}tb_concurrent_hash_map_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_concurrent_hash_map_shard_t* tb_concurrent_hash_map_shard(tb_concurrent_hash_map_impl_t* impl, tb_cpointer_t name)
+{
+    /* select the shard by the second hash func
+     *
+     * the flat hash map of the shard uses the first hash func, 
+     * so the items of the same shard can also be distributed well
+     */
+    return &impl->shards[impl->element_name.hash(&impl->element_name, name, impl->shard_count - 1, 1)];
+}
+static __tb_inline__ tb_void_t tb_concurrent_hash_map_read_enter(tb_concurrent_hash_map_shard_t* shard)
+{
+    // init tryn
+    tb_size_t tryn = 5;
+
+    // lock it
+    tb_bool_t contended = tb_false;
+    while (1)
+    {
+        // add a reader if no writers are running or waiting
+        tb_long_t lock = tb_atomic_get(&shard->lock);
+        if (lock >= 0 && !tb_atomic_get(&shard->wait) && tb_atomic_fetch_and_pset(&shard->lock, lock, lock + 1) == lock) break;
+
+        // contended? only count it once for each entering
+        if (!contended)
+        {
+            tb_atomic_fetch_and_inc(&shard->contention);
+            contended = tb_true;
+        }
+
+        // yield the processor
+        if (!tryn--)
+        {
+            tb_sched_yield();
+            tryn = 5;
+        }
+    }
+}
+static __tb_inline__ tb_void_t tb_concurrent_hash_map_read_leave(tb_concurrent_hash_map_shard_t* shard)
+{
+    tb_atomic_fetch_and_dec(&shard->lock);
+}
+static __tb_inline__ tb_void_t tb_concurrent_hash_map_write_enter(tb_concurrent_hash_map_shard_t* shard)
+{
+    // init tryn
+    tb_size_t tryn = 5;
+
+    // wait it, the new readers will be blocked
+    tb_atomic_fetch_and_inc(&shard->wait);
+
+    // lock it after all readers and writers have left
+    tb_bool_t contended = tb_false;
+    while (tb_atomic_fetch_and_pset(&shard->lock, 0, TB_CONCURRENT_HASH_MAP_LOCK_WRITER))
+    {
+        // contended? only count it once for each entering
+        if (!contended)
+        {
+            tb_atomic_fetch_and_inc(&shard->contention);
+            contended = tb_true;
+        }
+
+        // yield the processor
+        if (!tryn--)
+        {
+            tb_sched_yield();
+            tryn = 5;
+        }
+    }
+
+    // the waiting is finished
+    tb_atomic_fetch_and_dec(&shard->wait);
+}
+static __tb_inline__ tb_void_t tb_concurrent_hash_map_write_leave(tb_concurrent_hash_map_shard_t* shard)
+{
+    tb_atomic_set0(&shard->lock);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_concurrent_hash_map_ref_t tb_concurrent_hash_map_init(tb_size_t shard_count, tb_size_t item_maxn, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.hash, tb_null);
+
+    // done
+    tb_bool_t                       ok = tb_false;
+    tb_concurrent_hash_map_impl_t*  impl = tb_null;
+    do
+    {
+        // using the default shard count
+        if (!shard_count) shard_count = tb_processor_count() << 2;
+
+        // align the shard count by pow2
+        shard_count = tb_align_pow2(tb_min(tb_max(shard_count, 4), TB_CONCURRENT_HASH_MAP_SHARD_MAXN));
+
+        // make hash map
+        impl = tb_malloc0_type(tb_concurrent_hash_map_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init element
+        impl->element_name = element_name;
+
+        // make shards
+        impl->shards = tb_nalloc0_type(shard_count, tb_concurrent_hash_map_shard_t);
+        tb_assert_and_check_break(impl->shards);
+
+        // init shards
+        tb_size_t i = 0;
+        for (i = 0; i < shard_count; i++)
+        {
+            // make the hash map of this shard
+            impl->shards[i].hash_map = tb_flat_hash_map_init(item_maxn / shard_count, element_name, element_data);
+            tb_assert_and_check_break(impl->shards[i].hash_map);
+
+            // update the shard count, ensure that only the initialized shards will be freed if failed
+            impl->shard_count++;
+        }
+        tb_check_break(i == shard_count);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_concurrent_hash_map_exit((tb_concurrent_hash_map_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (tb_concurrent_hash_map_ref_t)impl;
+}
+tb_void_t tb_concurrent_hash_map_exit(tb_concurrent_hash_map_ref_t hash_map)
+{
+    // check
+    tb_concurrent_hash_map_impl_t* impl = (tb_concurrent_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return(impl);
+
+    // exit shards
+    if (impl->shards)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < impl->shard_count; i++)
+        {
+            if (impl->shards[i].hash_map) tb_flat_hash_map_exit(impl->shards[i].hash_map);
+            impl->shards[i].hash_map = tb_null;
+        }
+        tb_free(impl->shards);
+    }
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t tb_concurrent_hash_map_clear(tb_concurrent_hash_map_ref_t hash_map)
+{
+    // check
+    tb_concurrent_hash_map_impl_t* impl = (tb_concurrent_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return(impl && impl->shards);
+
+    // clear shards one by one
+    tb_size_t i = 0;
+    for (i = 0; i < impl->shard_count; i++)
+    {
+        tb_concurrent_hash_map_shard_t* shard = &impl->shards[i];
+        tb_concurrent_hash_map_write_enter(shard);
+        tb_flat_hash_map_clear(shard->hash_map);
+        tb_atomic_set0(&shard->size);
+        tb_concurrent_hash_map_write_leave(shard);
+    }
+}
+tb_pointer_t tb_concurrent_hash_map_get(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name)
+{
+    // check
+    tb_concurrent_hash_map_impl_t* impl = (tb_concurrent_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return_val(impl && impl->shards, tb_null);
+
+    // the shard
+    tb_concurrent_hash_map_shard_t* shard = tb_concurrent_hash_map_shard(impl, name);
+
+    // get it
+    tb_concurrent_hash_map_read_enter(shard);
+    tb_pointer_t data = tb_flat_hash_map_get(shard->hash_map, name);
+    tb_concurrent_hash_map_read_leave(shard);
+
+    // ok?
+    return data;
+}
+tb_bool_t tb_concurrent_hash_map_find(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name, tb_concurrent_hash_map_find_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_concurrent_hash_map_impl_t* impl = (tb_concurrent_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return_val(impl && impl->shards, tb_false);
+
+    // the shard
+    tb_concurrent_hash_map_shard_t* shard = tb_concurrent_hash_map_shard(impl, name);
+
+    // enter the read lock
+    tb_concurrent_hash_map_read_enter(shard);
+
+    // find it
+    tb_size_t itor = tb_flat_hash_map_find(shard->hash_map, name);
+    tb_bool_t ok = itor != tb_iterator_tail(shard->hash_map);
+
+    /* access it 
+     *
+     * @note we cannot use tb_iterator_item here, 
+     * because the current item of the iterator will be modified by the other readers
+     */
+    if (ok && func) func((tb_pointer_t)name, tb_flat_hash_map_get(shard->hash_map, name), priv);
+
+    // leave the read lock
+    tb_concurrent_hash_map_read_leave(shard);
+
+    // ok?
+    return ok;
+}
+tb_bool_t tb_concurrent_hash_map_insert(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_concurrent_hash_map_impl_t* impl = (tb_concurrent_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return_val(impl && impl->shards, tb_false);
+
+    // the shard
+    tb_concurrent_hash_map_shard_t* shard = tb_concurrent_hash_map_shard(impl, name);
+
+    // insert it
+    tb_concurrent_hash_map_write_enter(shard);
+    tb_bool_t ok = tb_flat_hash_map_insert(shard->hash_map, name, data) != tb_iterator_tail(shard->hash_map);
+    tb_atomic_set(&shard->size, tb_flat_hash_map_size(shard->hash_map));
+    tb_concurrent_hash_map_write_leave(shard);
+
+    // ok?
+    return ok;
+}
+tb_bool_t tb_concurrent_hash_map_remove(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name)
+{
+    // check
+    tb_concurrent_hash_map_impl_t* impl = (tb_concurrent_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return_val(impl && impl->shards, tb_false);
+
+    // the shard
+    tb_concurrent_hash_map_shard_t* shard = tb_concurrent_hash_map_shard(impl, name);
+
+    // remove it
+    tb_concurrent_hash_map_write_enter(shard);
+    tb_size_t size = tb_flat_hash_map_size(shard->hash_map);
+    tb_flat_hash_map_remove(shard->hash_map, name);
+    tb_bool_t ok = tb_flat_hash_map_size(shard->hash_map) < size;
+    tb_atomic_set(&shard->size, tb_flat_hash_map_size(shard->hash_map));
+    tb_concurrent_hash_map_write_leave(shard);
+
+    // ok?
+    return ok;
+}
+tb_size_t tb_concurrent_hash_map_remove_if(tb_concurrent_hash_map_ref_t hash_map, tb_concurrent_hash_map_pred_func_t pred, tb_cpointer_t priv)
+{
+    // check
+    tb_concurrent_hash_map_impl_t* impl = (tb_concurrent_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return_val(impl && impl->shards && pred, 0);
+
+    // walk shards one by one
+    tb_size_t i = 0;
+    tb_size_t removed = 0;
+    for (i = 0; i < impl->shard_count; i++)
+    {
+        // the shard
+        tb_concurrent_hash_map_shard_t* shard = &impl->shards[i];
+
+        // enter the write lock
+        tb_concurrent_hash_map_write_enter(shard);
+
+        // walk items, the other items will not be moved after removing an item from the flat hash map
+        tb_iterator_ref_t   iterator = (tb_iterator_ref_t)shard->hash_map;
+        tb_size_t           itor = tb_iterator_head(iterator);
+        tb_size_t           tail = tb_iterator_tail(iterator);
+        while (itor != tail)
+        {
+            // the next itor
+            tb_size_t next = tb_iterator_next(iterator, itor);
+
+            // remove it?
+            tb_flat_hash_map_item_ref_t item = (tb_flat_hash_map_item_ref_t)tb_iterator_item(iterator, itor);
+            if (item && pred(item->name, item->data, priv)) 
+            {
+                tb_iterator_remove(iterator, itor);
+                removed++;
+            }
+
+            // next
+            itor = next;
+        }
+
+        // update size
+        tb_atomic_set(&shard->size, tb_flat_hash_map_size(shard->hash_map));
+
+        // leave the write lock
+        tb_concurrent_hash_map_write_leave(shard);
+    }
+
+    // ok
+    return removed;
+}
+tb_size_t tb_concurrent_hash_map_size(tb_concurrent_hash_map_ref_t hash_map)
+{
+    // check
+    tb_concurrent_hash_map_impl_t* impl = (tb_concurrent_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return_val(impl && impl->shards, 0);
+
+    // the size of all shards, it is only a snapshot
+    tb_size_t i = 0;
+    tb_size_t size = 0;
+    for (i = 0; i < impl->shard_count; i++) size += (tb_size_t)tb_atomic_get(&impl->shards[i].size);
+    return size;
+}
+tb_size_t tb_concurrent_hash_map_contention(tb_concurrent_hash_map_ref_t hash_map)
+{
+    // check
+    tb_concurrent_hash_map_impl_t* impl = (tb_concurrent_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return_val(impl && impl->shards, 0);
+
+    // the contention count of all shards
+    tb_size_t i = 0;
+    tb_size_t contention = 0;
+    for (i = 0; i < impl->shard_count; i++) contention += (tb_size_t)tb_atomic_get(&impl->shards[i].contention);
+    return contention;
+}
@@ -0,0 +1,203 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        concurrent_hash_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_CONCURRENT_HASH_MAP_H
+#define TB_CONTAINER_CONCURRENT_HASH_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the thread-safe concurrent hash map ref type
+ *
+ * <pre>
+ *
+ * hash(name) => shard
+ *
+ * shards: |  rwlock  |  rwlock  |  rwlock  |  rwlock  | ...
+ *         | flat map | flat map | flat map | flat map | ...
+ *
+ * get/find:            enter the read lock of the shard, the readers of the same shard will not be blocked
+ * insert/remove:       enter the write lock of the shard, only block the readers and writers of this shard
+ * remove_if/clear:     enter the write lock of all shards one by one
+ *
+ * </pre>
+ *
+ * @note the map is not an iterator, because the items may be changed by other threads
+ */
+typedef struct{}*               tb_concurrent_hash_map_ref_t;
+
+/*! the find func type 
+ *
+ * @param name                  the item name
+ * @param data                  the item data
+ * @param priv                  the user private data
+ */
+typedef tb_void_t               (*tb_concurrent_hash_map_find_func_t)(tb_pointer_t name, tb_pointer_t data, tb_cpointer_t priv);
+
+/*! the predicate func type 
+ *
+ * @param name                  the item name
+ * @param data                  the item data
+ * @param priv                  the user private data
+ *
+ * @return                      tb_true: remove this item, tb_false: keep this item
+ */
+typedef tb_bool_t               (*tb_concurrent_hash_map_pred_func_t)(tb_pointer_t name, tb_pointer_t data, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init concurrent hash map
+ *
+ * @param shard_count           the shard count, using the default count if be zero
+ * @param item_maxn             the reserved item count, using the default size if be zero
+ * @param element_name          the item for name
+ * @param element_data          the item for data
+ *
+ * @return                      the concurrent hash map
+ */
+tb_concurrent_hash_map_ref_t    tb_concurrent_hash_map_init(tb_size_t shard_count, tb_size_t item_maxn, tb_element_t element_name, tb_element_t element_data);
+
+/*! exit concurrent hash map
+ *
+ * @param hash_map              the concurrent hash map
+ */
+tb_void_t                       tb_concurrent_hash_map_exit(tb_concurrent_hash_map_ref_t hash_map);
+
+/*! clear concurrent hash map
+ *
+ * @param hash_map              the concurrent hash map
+ */
+tb_void_t                       tb_concurrent_hash_map_clear(tb_concurrent_hash_map_ref_t hash_map);
+
+/*! get item data from name
+ *
+ * @note the data may be freed by other threads after returning, 
+ * so it is only safe for the integer or the pointer data without the free func,
+ * please use tb_concurrent_hash_map_find for accessing the other data.
+ *
+ * @param hash_map              the concurrent hash map
+ * @param name                  the item name
+ *
+ * @return                      the item data
+ */
+tb_pointer_t                    tb_concurrent_hash_map_get(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! find item from name and access it under the read lock
+ *
+ * @code
+ *
+ * static tb_void_t tb_demo_find_func(tb_pointer_t name, tb_pointer_t data, tb_cpointer_t priv)
+ * {
+ *      // copy data
+ *      tb_memcpy((tb_pointer_t)priv, data, sizeof(tb_demo_data_t));
+ * }
+ *
+ * // find item and copy data
+ * tb_demo_data_t data;
+ * if (tb_concurrent_hash_map_find(hash_map, name, tb_demo_find_func, &data))
+ * {
+ *      // ...
+ * }
+ * @endcode
+ *
+ * @param hash_map              the concurrent hash map
+ * @param name                  the item name
+ * @param func                  the find func, will be called if found and the func can be null
+ * @param priv                  the user private data
+ *
+ * @return                      tb_true if found or tb_false
+ */
+tb_bool_t                       tb_concurrent_hash_map_find(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name, tb_concurrent_hash_map_find_func_t func, tb_cpointer_t priv);
+
+/*! insert item data from name
+ *
+ * @note the pair (name => data) is unique
+ *
+ * @param hash_map              the concurrent hash map
+ * @param name                  the item name
+ * @param data                  the item data
+ *
+ * @return                      tb_true or tb_false
+ */
+tb_bool_t                       tb_concurrent_hash_map_insert(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name, tb_cpointer_t data);
+
+/*! remove item from name
+ *
+ * @param hash_map              the concurrent hash map
+ * @param name                  the item name
+ *
+ * @return                      tb_true if removed or tb_false
+ */
+tb_bool_t                       tb_concurrent_hash_map_remove(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! remove items if the predicate is ok
+ *
+ * @note the shards will be locked one by one, and the predicate can also be used to walk all items
+ *
+ * @param hash_map              the concurrent hash map
+ * @param pred                  the predicate func
+ * @param priv                  the user private data
+ *
+ * @return                      the removed item count
+ */
+tb_size_t                       tb_concurrent_hash_map_remove_if(tb_concurrent_hash_map_ref_t hash_map, tb_concurrent_hash_map_pred_func_t pred, tb_cpointer_t priv);
+
+/*! the concurrent hash map size
+ *
+ * @param hash_map              the concurrent hash map
+ *
+ * @return                      the concurrent hash map size
+ */
+tb_size_t                       tb_concurrent_hash_map_size(tb_concurrent_hash_map_ref_t hash_map);
+
+/*! the contention count of the concurrent hash map
+ *
+ * the count will be increased if the shard lock has been held by the others when entering it
+ *
+ * @param hash_map              the concurrent hash map
+ *
+ * @return                      the contention count
+ */
+tb_size_t                       tb_concurrent_hash_map_contention(tb_concurrent_hash_map_ref_t hash_map);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
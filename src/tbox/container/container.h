@@ -35,13 +35,17 @@
 #include "vector.h"
 #include "hash_set.h"
 #include "hash_map.h"
+#include "flat_hash_map.h"
+#include "concurrent_hash_map.h"
 #include "queue.h"
 #include "circle_queue.h"
 #include "priority_queue.h"
+#include "mpmc_queue.h"
 #include "list.h"
 #include "list_entry.h"
 #include "single_list.h"
 #include "single_list_entry.h"
+#include "unrolled_list.h"
 #include "bloom_filter.h"
 
 #endif
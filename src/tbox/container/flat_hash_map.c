@@ -0,0 +1,689 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        flat_hash_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "flat_hash_map"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "flat_hash_map.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the group size, the control bytes of one group will be probed at once
+#define TB_FLAT_HASH_MAP_GROUP_SIZE                     (16)
+
+// the control byte for the empty slot
+#define TB_FLAT_HASH_MAP_CTRL_EMPTY                     (0x80)
+
+// the control byte for the deleted slot
+#define TB_FLAT_HASH_MAP_CTRL_DELETED                   (0xfe)
+
+// the control byte is full? the full slot is tagged by h2: 0xxxxxxx
+#define tb_flat_hash_map_ctrl_is_full(ctrl)             (!((ctrl) & 0x80))
+
+// the group index from the hash value
+#define tb_flat_hash_map_hash_h1(hash)                  ((hash) >> 7)
+
+// the 7-bits tag from the hash value
+#define tb_flat_hash_map_hash_h2(hash)                  ((tb_byte_t)((hash) & 0x7f))
+
+// the usable slot count, the maximum load factor: 7/8
+#define tb_flat_hash_map_growth(maxn)                   ((maxn) - ((maxn) >> 3))
+
+// the default item maxn
+#ifdef __tb_small__
+#   define TB_FLAT_HASH_MAP_ITEM_SIZE_DEFAULT           TB_FLAT_HASH_MAP_ITEM_SIZE_MICRO
+#else
+#   define TB_FLAT_HASH_MAP_ITEM_SIZE_DEFAULT           TB_FLAT_HASH_MAP_ITEM_SIZE_SMALL
+#endif
+
+// the item maximum size
+#define TB_FLAT_HASH_MAP_ITEM_MAXN                      (1 << 28)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the flat hash map impl type
+typedef struct __tb_flat_hash_map_impl_t
+{
+    // the item itor
+    tb_iterator_t                   itor;
+
+    // the control bytes, one byte for each slot
+    tb_byte_t*                      ctrl;
+
+    // the item slots
+    tb_byte_t*                      data;
+
+    // the current item for iterator
+    tb_flat_hash_map_item_t         item;
+
+    // the item size
+    tb_size_t                       item_size;
+
+    // the item maxn, the count of all slots
+    tb_size_t                       item_maxn;
+
+    // the count of the empty slots which can be used before growing
+    tb_size_t                       item_left;
+
+    // the item step
+    tb_size_t                       item_step;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+    // the element for data
+    tb_element_t                    element_data;
+
+}tb_flat_hash_map_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match(tb_byte_t const* group, tb_byte_t h2)
+{
+#ifdef TB_ARCH_SSE2
+    __m128i ctrl = _mm_loadu_si128((__m128i const*)group);
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((tb_char_t)h2)));
+#else
+    tb_size_t   i = 0;
+    tb_uint32_t mask = 0;
+    for (i = 0; i < TB_FLAT_HASH_MAP_GROUP_SIZE; i++)
+        if (group[i] == h2) mask |= (1 << i);
+    return mask;
+#endif
+}
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match_empty(tb_byte_t const* group)
+{
+    return tb_flat_hash_map_group_match(group, TB_FLAT_HASH_MAP_CTRL_EMPTY);
+}
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match_free(tb_byte_t const* group)
+{
+#ifdef TB_ARCH_SSE2
+    // the empty or deleted slot: 1xxxxxxx
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)group));
+#else
+    tb_size_t   i = 0;
+    tb_uint32_t mask = 0;
+    for (i = 0; i < TB_FLAT_HASH_MAP_GROUP_SIZE; i++)
+        if (!tb_flat_hash_map_ctrl_is_full(group[i])) mask |= (1 << i);
+    return mask;
+#endif
+}
+static __tb_inline__ tb_size_t tb_flat_hash_map_hash(tb_flat_hash_map_impl_t* impl, tb_cpointer_t name)
+{
+    // the full hash value, h1 and h2 will be split from it
+    return impl->element_name.hash(&impl->element_name, name, (tb_size_t)-1, 0);
+}
+static tb_size_t tb_flat_hash_map_item_find(tb_flat_hash_map_impl_t* impl, tb_cpointer_t name, tb_size_t hash)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->ctrl && impl->data && impl->item_maxn, 0);
+
+    // the group mask
+    tb_size_t group_mask = (impl->item_maxn / TB_FLAT_HASH_MAP_GROUP_SIZE) - 1;
+
+    // probe groups
+    tb_byte_t   h2 = tb_flat_hash_map_hash_h2(hash);
+    tb_size_t   step = impl->item_step;
+    tb_size_t   group = tb_flat_hash_map_hash_h1(hash) & group_mask;
+    tb_size_t   probe = 0;
+    for (probe = 0; probe <= group_mask; probe++)
+    {
+        // the control bytes of this group
+        tb_byte_t const* ctrl = impl->ctrl + group * TB_FLAT_HASH_MAP_GROUP_SIZE;
+
+        // compare all items with the same tag in this group
+        tb_uint32_t mask = tb_flat_hash_map_group_match(ctrl, h2);
+        while (mask)
+        {
+            // the slot
+            tb_size_t slot = group * TB_FLAT_HASH_MAP_GROUP_SIZE + tb_bits_fb1_u32_le(mask);
+
+            // found?
+            if (!impl->element_name.comp(&impl->element_name, name, impl->element_name.data(&impl->element_name, impl->data + slot * step)))
+                return slot + 1;
+
+            // clear the lowest bit
+            mask &= mask - 1;
+        }
+
+        // not found if there is an empty slot in this group
+        tb_check_break(!tb_flat_hash_map_group_match_empty(ctrl));
+
+        // the next group
+        group = (group + probe + 1) & group_mask;
+    }
+
+    // not found
+    return 0;
+}
+static tb_size_t tb_flat_hash_map_item_free(tb_byte_t const* ctrl, tb_size_t maxn, tb_size_t hash)
+{
+    // the group mask
+    tb_size_t group_mask = (maxn / TB_FLAT_HASH_MAP_GROUP_SIZE) - 1;
+
+    // probe the first empty or deleted slot
+    tb_size_t group = tb_flat_hash_map_hash_h1(hash) & group_mask;
+    tb_size_t probe = 0;
+    for (probe = 0; probe <= group_mask; probe++)
+    {
+        // found?
+        tb_uint32_t mask = tb_flat_hash_map_group_match_free(ctrl + group * TB_FLAT_HASH_MAP_GROUP_SIZE);
+        if (mask) return group * TB_FLAT_HASH_MAP_GROUP_SIZE + tb_bits_fb1_u32_le(mask);
+
+        // the next group
+        group = (group + probe + 1) & group_mask;
+    }
+
+    // the map is always not full, will not be here
+    tb_assert(0);
+    return 0;
+}
+static tb_bool_t tb_flat_hash_map_resize(tb_flat_hash_map_impl_t* impl, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(impl && maxn >= TB_FLAT_HASH_MAP_GROUP_SIZE && maxn <= TB_FLAT_HASH_MAP_ITEM_MAXN, tb_false);
+    tb_assert_and_check_return_val(impl->item_size < tb_flat_hash_map_growth(maxn), tb_false);
+
+    // done
+    tb_bool_t   ok = tb_false;
+    tb_byte_t*  ctrl = tb_null;
+    tb_byte_t*  data = tb_null;
+    do
+    {
+        // make the new control bytes
+        ctrl = (tb_byte_t*)tb_malloc(maxn);
+        tb_assert_and_check_break(ctrl);
+
+        // make the new slots
+        data = (tb_byte_t*)tb_nalloc0(maxn, impl->item_step);
+        tb_assert_and_check_break(data);
+
+        // all slots are empty now
+        tb_memset(ctrl, TB_FLAT_HASH_MAP_CTRL_EMPTY, maxn);
+
+        // move all items to the new slots, the items are only moved and need not dupl or free them
+        if (impl->ctrl && impl->data)
+        {
+            tb_size_t i = 0;
+            tb_size_t n = impl->item_maxn;
+            tb_size_t step = impl->item_step;
+            for (i = 0; i < n; i++)
+            {
+                // full?
+                tb_check_continue(tb_flat_hash_map_ctrl_is_full(impl->ctrl[i]));
+
+                // the item
+                tb_byte_t const* item = impl->data + i * step;
+
+                // rehash it
+                tb_size_t hash = tb_flat_hash_map_hash(impl, impl->element_name.data(&impl->element_name, item));
+                tb_size_t slot = tb_flat_hash_map_item_free(ctrl, maxn, hash);
+
+                // move it
+                ctrl[slot] = tb_flat_hash_map_hash_h2(hash);
+                tb_memcpy(data + slot * step, item, step);
+            }
+        }
+
+        // free the old slots
+        if (impl->ctrl) tb_free(impl->ctrl);
+        if (impl->data) tb_free(impl->data);
+
+        // update the slots
+        impl->ctrl      = ctrl;
+        impl->data      = data;
+        impl->item_maxn = maxn;
+        impl->item_left = tb_flat_hash_map_growth(maxn) - impl->item_size;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        if (ctrl) tb_free(ctrl);
+        if (data) tb_free(data);
+    }
+
+    // ok?
+    return ok;
+}
+static tb_void_t tb_flat_hash_map_item_free_at(tb_flat_hash_map_impl_t* impl, tb_size_t slot)
+{
+    // the item
+    tb_byte_t* item = impl->data + slot * impl->item_step;
+
+    // free it
+    if (impl->element_name.free) impl->element_name.free(&impl->element_name, item);
+    if (impl->element_data.free) impl->element_data.free(&impl->element_data, item + impl->element_name.size);
+}
+static tb_size_t tb_flat_hash_map_itor_size(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)iterator;
+    tb_assert(impl);
+
+    // the size
+    return impl->item_size;
+}
+static tb_size_t tb_flat_hash_map_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)iterator;
+    tb_assert(impl && impl->ctrl && itor <= impl->item_maxn);
+
+    // the next slot
+    tb_size_t slot = itor;
+    tb_size_t maxn = impl->item_maxn;
+
+    // find the next full slot in the current group
+    for (; slot < maxn && (slot & (TB_FLAT_HASH_MAP_GROUP_SIZE - 1)); slot++)
+        if (tb_flat_hash_map_ctrl_is_full(impl->ctrl[slot])) return slot + 1;
+
+    // find the next full slot from the next groups
+    for (; slot < maxn; slot += TB_FLAT_HASH_MAP_GROUP_SIZE)
+    {
+        tb_uint32_t mask = ~tb_flat_hash_map_group_match_free(impl->ctrl + slot) & 0xffff;
+        if (mask) return slot + tb_bits_fb1_u32_le(mask) + 1;
+    }
+
+    // tail
+    return 0;
+}
+static tb_size_t tb_flat_hash_map_itor_head(tb_iterator_ref_t iterator)
+{
+    return tb_flat_hash_map_itor_next(iterator, 0);
+}
+static tb_size_t tb_flat_hash_map_itor_tail(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_pointer_t tb_flat_hash_map_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)iterator;
+    tb_assert_and_check_return_val(impl && itor && itor <= impl->item_maxn, tb_null);
+
+    // the slot
+    tb_size_t slot = itor - 1;
+    tb_check_return_val(tb_flat_hash_map_ctrl_is_full(impl->ctrl[slot]), tb_null);
+
+    // get item
+    tb_byte_t const* item = impl->data + slot * impl->item_step;
+    impl->item.name = impl->element_name.data(&impl->element_name, item);
+    impl->item.data = impl->element_data.data(&impl->element_data, item + impl->element_name.size);
+    return &(impl->item);
+}
+static tb_void_t tb_flat_hash_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)iterator;
+    tb_assert(impl && itor && itor <= impl->item_maxn);
+
+    // the slot
+    tb_size_t slot = itor - 1;
+    tb_check_return(tb_flat_hash_map_ctrl_is_full(impl->ctrl[slot]));
+
+    // note: copy data only, will destroy the hash index if copy name
+    impl->element_data.copy(&impl->element_data, impl->data + slot * impl->item_step + impl->element_name.size, item);
+}
+static tb_long_t tb_flat_hash_map_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t lelement, tb_cpointer_t relement)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)iterator;
+    tb_assert(impl && impl->element_name.comp && lelement && relement);
+    
+    // done
+    return impl->element_name.comp(&impl->element_name, ((tb_flat_hash_map_item_ref_t)lelement)->name, ((tb_flat_hash_map_item_ref_t)relement)->name);
+}
+static tb_void_t tb_flat_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)iterator;
+    tb_assert(impl && itor && itor <= impl->item_maxn);
+
+    // the slot
+    tb_size_t slot = itor - 1;
+    tb_assert_and_check_return(tb_flat_hash_map_ctrl_is_full(impl->ctrl[slot]));
+
+    // free item
+    tb_flat_hash_map_item_free_at(impl, slot);
+
+    /* mark this slot as empty if there is an empty slot in the same group
+     *
+     * this group has never been full and no probing sequence can pass over it,
+     * so the lookup will be still stopped at this group. 
+     * otherwise, we need mark it as deleted for keeping the probing sequence.
+     */
+    if (tb_flat_hash_map_group_match_empty(impl->ctrl + (slot & ~(TB_FLAT_HASH_MAP_GROUP_SIZE - 1))))
+    {
+        impl->ctrl[slot] = TB_FLAT_HASH_MAP_CTRL_EMPTY;
+        impl->item_left++;
+    }
+    else impl->ctrl[slot] = TB_FLAT_HASH_MAP_CTRL_DELETED;
+
+    // update the item size
+    impl->item_size--;
+}
+static tb_void_t tb_flat_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)iterator;
+    tb_assert_and_check_return(impl);
+
+    // no size
+    tb_check_return(size);
+
+    // remove items: [itor, next), the other items will not be moved after removing
+    tb_size_t itor = prev? tb_flat_hash_map_itor_next(iterator, prev) : tb_flat_hash_map_itor_head(iterator);
+    while (itor && itor != next && size--)
+    {
+        // the next itor
+        tb_size_t temp = tb_flat_hash_map_itor_next(iterator, itor);
+
+        // remove it
+        tb_flat_hash_map_itor_remove(iterator, itor);
+
+        // next
+        itor = temp;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_flat_hash_map_ref_t tb_flat_hash_map_init(tb_size_t item_maxn, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.size && element_name.hash && element_name.comp && element_name.data && element_name.dupl, tb_null);
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
+
+    // check item maxn
+    if (!item_maxn) item_maxn = TB_FLAT_HASH_MAP_ITEM_SIZE_DEFAULT;
+    tb_assert_and_check_return_val(item_maxn < tb_flat_hash_map_growth(TB_FLAT_HASH_MAP_ITEM_MAXN), tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_flat_hash_map_impl_t*    impl = tb_null;
+    do
+    {
+        // make hash_map
+        impl = tb_malloc0_type(tb_flat_hash_map_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init hash_map func
+        impl->element_name = element_name;
+        impl->element_data = element_data;
+        impl->item_step    = element_name.size + element_data.size;
+
+        // init item itor
+        impl->itor.mode             = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_MUTABLE;
+        impl->itor.priv             = tb_null;
+        impl->itor.step             = sizeof(tb_flat_hash_map_item_t);
+        impl->itor.size             = tb_flat_hash_map_itor_size;
+        impl->itor.head             = tb_flat_hash_map_itor_head;
+        impl->itor.tail             = tb_flat_hash_map_itor_tail;
+        impl->itor.prev             = tb_null;
+        impl->itor.next             = tb_flat_hash_map_itor_next;
+        impl->itor.item             = tb_flat_hash_map_itor_item;
+        impl->itor.copy             = tb_flat_hash_map_itor_copy;
+        impl->itor.comp             = tb_flat_hash_map_itor_comp;
+        impl->itor.remove           = tb_flat_hash_map_itor_remove;
+        impl->itor.remove_range     = tb_flat_hash_map_itor_remove_range;
+
+        // init slots, ensure that all reserved items can be inserted without growing
+        tb_size_t maxn = tb_align_pow2(item_maxn + (item_maxn / 7) + 1);
+        if (maxn < TB_FLAT_HASH_MAP_GROUP_SIZE) maxn = TB_FLAT_HASH_MAP_GROUP_SIZE;
+        if (!tb_flat_hash_map_resize(impl, maxn)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_flat_hash_map_exit((tb_flat_hash_map_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (tb_flat_hash_map_ref_t)impl;
+}
+tb_void_t tb_flat_hash_map_exit(tb_flat_hash_map_ref_t hash_map)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return(impl);
+
+    // clear it
+    tb_flat_hash_map_clear(hash_map);
+
+    // free slots
+    if (impl->ctrl) tb_free(impl->ctrl);
+    if (impl->data) tb_free(impl->data);
+
+    // free it
+    tb_free(impl);
+}
+tb_void_t tb_flat_hash_map_clear(tb_flat_hash_map_ref_t hash_map)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return(impl);
+
+    // no slots?
+    tb_check_return(impl->ctrl && impl->data);
+
+    // free items
+    if (impl->item_size && (impl->element_name.free || impl->element_data.free))
+    {
+        tb_size_t i = 0;
+        tb_size_t n = impl->item_maxn;
+        for (i = 0; i < n; i++)
+        {
+            if (tb_flat_hash_map_ctrl_is_full(impl->ctrl[i]))
+                tb_flat_hash_map_item_free_at(impl, i);
+        }
+    }
+
+    // all slots are empty now
+    tb_memset(impl->ctrl, TB_FLAT_HASH_MAP_CTRL_EMPTY, impl->item_maxn);
+
+    // reset info
+    impl->item_size = 0;
+    impl->item_left = tb_flat_hash_map_growth(impl->item_maxn);
+    tb_memset(&impl->item, 0, sizeof(tb_flat_hash_map_item_t));
+}
+tb_pointer_t tb_flat_hash_map_get(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // find it
+    tb_size_t itor = tb_flat_hash_map_item_find(impl, name, tb_flat_hash_map_hash(impl, name));
+    tb_check_return_val(itor, tb_null);
+
+    // get data
+    return impl->element_data.data(&impl->element_data, impl->data + (itor - 1) * impl->item_step + impl->element_name.size);
+}
+tb_size_t tb_flat_hash_map_find(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // find it
+    return tb_flat_hash_map_item_find(impl, name, tb_flat_hash_map_hash(impl, name));
+}
+tb_size_t tb_flat_hash_map_insert(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the hash value
+    tb_size_t hash = tb_flat_hash_map_hash(impl, name);
+
+    // find it
+    tb_size_t itor = tb_flat_hash_map_item_find(impl, name, hash);
+    if (itor)
+    {
+        // replace data
+        impl->element_data.repl(&impl->element_data, impl->data + (itor - 1) * impl->item_step + impl->element_name.size, data);
+    }
+    else
+    {
+        // no empty slots? grow it or only clean the deleted slots
+        if (!impl->item_left)
+        {
+            // grow it if the items use more than 25/32 slots, otherwise only rehash it for dropping the deleted slots
+            tb_size_t maxn = impl->item_maxn;
+            if (maxn == TB_FLAT_HASH_MAP_GROUP_SIZE || impl->item_size * 32 > maxn * 25) maxn <<= 1;
+            if (!tb_flat_hash_map_resize(impl, maxn)) return 0;
+        }
+
+        // get a free slot
+        tb_size_t slot = tb_flat_hash_map_item_free(impl->ctrl, impl->item_maxn, hash);
+        tb_assert_and_check_return_val(slot < impl->item_maxn, 0);
+
+        // use an empty slot? 
+        if (impl->ctrl[slot] == TB_FLAT_HASH_MAP_CTRL_EMPTY) impl->item_left--;
+
+        // dupl item
+        tb_byte_t* item = impl->data + slot * impl->item_step;
+        impl->element_name.dupl(&impl->element_name, item, name);
+        impl->element_data.dupl(&impl->element_data, item + impl->element_name.size, data);
+        impl->ctrl[slot] = tb_flat_hash_map_hash_h2(hash);
+
+        // update the item size
+        impl->item_size++;
+
+        // the itor
+        itor = slot + 1;
+    }
+
+    // ok?
+    return itor;
+}
+tb_void_t tb_flat_hash_map_remove(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return(impl);
+
+    // find it
+    tb_size_t itor = tb_flat_hash_map_item_find(impl, name, tb_flat_hash_map_hash(impl, name));
+    if (itor) tb_flat_hash_map_itor_remove((tb_iterator_ref_t)impl, itor);
+}
+tb_size_t tb_flat_hash_map_size(tb_flat_hash_map_ref_t hash_map)
+{
+    // check
+    tb_flat_hash_map_impl_t const* impl = (tb_flat_hash_map_impl_t const*)hash_map;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the size
+    return impl->item_size;
+}
+tb_size_t tb_flat_hash_map_maxn(tb_flat_hash_map_ref_t hash_map)
+{
+    // check
+    tb_flat_hash_map_impl_t const* impl = (tb_flat_hash_map_impl_t const*)hash_map;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the maxn
+    return impl->item_maxn;
+}
+#ifdef __tb_debug__
+tb_void_t tb_flat_hash_map_dump(tb_flat_hash_map_ref_t hash_map)
+{
+    // check
+    tb_flat_hash_map_impl_t* impl = (tb_flat_hash_map_impl_t*)hash_map;
+    tb_assert_and_check_return(impl && impl->ctrl && impl->data);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("flat_hash_map: size: %lu, maxn: %lu, left: %lu", impl->item_size, impl->item_maxn, impl->item_left);
+
+    // done
+    tb_size_t i = 0;
+    tb_char_t name[4096];
+    tb_char_t data[4096];
+    for (i = 0; i < impl->item_maxn; i++)
+    {
+        // full?
+        tb_check_continue(tb_flat_hash_map_ctrl_is_full(impl->ctrl[i]));
+
+        // the item
+        tb_byte_t const* item = impl->data + i * impl->item_step;
+
+        // the item name
+        tb_pointer_t element_name = impl->element_name.data(&impl->element_name, item);
+
+        // the item data
+        tb_pointer_t element_data = impl->element_data.data(&impl->element_data, item + impl->element_name.size);
+
+        // trace
+        if (impl->element_name.cstr && impl->element_data.cstr)
+        {
+            tb_trace_i("slot[%lu]: %s => %s", i, impl->element_name.cstr(&impl->element_name, element_name, name, sizeof(name)), impl->element_data.cstr(&impl->element_data, element_data, data, sizeof(data)));
+        }
+        else if (impl->element_name.cstr) 
+        {
+            tb_trace_i("slot[%lu]: %s => %p", i, impl->element_name.cstr(&impl->element_name, element_name, name, sizeof(name)), element_data);
+        }
+        else if (impl->element_data.cstr) 
+        {
+            tb_trace_i("slot[%lu]: %p => %s", i, element_name, impl->element_data.cstr(&impl->element_data, element_data, data, sizeof(data)));
+        }
+        else 
+        {
+            tb_trace_i("slot[%lu]: %p => %p", i, element_name, element_data);
+        }
+    }
+}
+#endif
@@ -0,0 +1,203 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        flat_hash_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_FLAT_HASH_MAP_H
+#define TB_CONTAINER_FLAT_HASH_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the micro flat hash map item size
+#define TB_FLAT_HASH_MAP_ITEM_SIZE_MICRO                (16)
+
+/// the small flat hash map item size
+#define TB_FLAT_HASH_MAP_ITEM_SIZE_SMALL                (256)
+
+/// the large flat hash map item size
+#define TB_FLAT_HASH_MAP_ITEM_SIZE_LARGE                (65536)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the flat hash map item type
+typedef struct __tb_flat_hash_map_item_t
+{
+    /// the item name
+    tb_pointer_t        name;
+
+    /// the item data
+    tb_pointer_t        data;
+
+}tb_flat_hash_map_item_t, *tb_flat_hash_map_item_ref_t;
+
+/*! the flat hash map ref type
+ *
+ * the open addressing hash map with the swiss-table-style control bytes
+ *
+ * <pre>
+ *
+ * hash(name) => h1: the group index, h2: the 7-bits tag of the control byte
+ *
+ *                 group 0                       group 1                       group n
+ * ctrl:      |h2|h2|--|h2|~~|...|h2|        |h2|--|--|h2|...|--|        ...
+ *             16 bytes, probed at once      16 bytes, probed at once
+ *
+ * item:      |name,data|name,data|...       |name,data|...             ...
+ *
+ * --: empty, ~~: deleted
+ *
+ * the group probing sequence: h1, h1 + 1, h1 + 1 + 2, h1 + 1 + 2 + 3, ...
+ *
+ * </pre>
+ *
+ * @note the itor of the same item will be changed after the map is grown
+ */
+typedef tb_iterator_ref_t tb_flat_hash_map_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init flat hash map
+ *
+ * @param item_maxn     the reserved item count, using the default size if be zero
+ * @param element_name  the item for name
+ * @param element_data  the item for data
+ *
+ * @return              the flat hash map
+ */
+tb_flat_hash_map_ref_t  tb_flat_hash_map_init(tb_size_t item_maxn, tb_element_t element_name, tb_element_t element_data);
+
+/*! exit flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_exit(tb_flat_hash_map_ref_t hash_map);
+
+/*! clear flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_clear(tb_flat_hash_map_ref_t hash_map);
+
+/*! get item data from name
+ *
+ * @note 
+ * the return value may be zero if the item type is integer
+ * so we need call tb_flat_hash_map_find for judging whether to get value successfully
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ *
+ * @return              the item data
+ */
+tb_pointer_t            tb_flat_hash_map_get(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! find item from name
+ *
+ * @code
+ *
+ * // find item
+ * tb_size_t itor = tb_flat_hash_map_find(hash_map, name);
+ * if (itor != tb_iterator_tail(hash_map))
+ * {
+ *      // get item
+ *      tb_flat_hash_map_item_ref_t item = (tb_flat_hash_map_item_ref_t)tb_iterator_item(hash_map, itor);
+ *      tb_assert(item);
+ *
+ *      // remove it
+ *      tb_iterator_remove(hash_map, itor);
+ * }
+ * @endcode
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ *
+ * @return              the item itor
+ */
+tb_size_t               tb_flat_hash_map_find(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! insert item data from name
+ *
+ * @note the pair (name => data) is unique
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              the item itor, return the tail if failed
+ */
+tb_size_t               tb_flat_hash_map_insert(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name, tb_cpointer_t data);
+
+/*! remove item from name
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ */
+tb_void_t               tb_flat_hash_map_remove(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! the flat hash map size
+ *
+ * @param hash_map      the flat hash map
+ *
+ * @return              the flat hash map size
+ */
+tb_size_t               tb_flat_hash_map_size(tb_flat_hash_map_ref_t hash_map);
+
+/*! the flat hash map maxn
+ *
+ * @param hash_map      the flat hash map
+ *
+ * @return              the flat hash map maxn, the count of all slots
+ */
+tb_size_t               tb_flat_hash_map_maxn(tb_flat_hash_map_ref_t hash_map);
+
+#ifdef __tb_debug__
+/*! dump flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_dump(tb_flat_hash_map_ref_t hash_map);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
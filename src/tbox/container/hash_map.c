@@ -68,6 +68,23 @@
 // the hash_map bucket item maximum size
 #define TB_HASH_MAP_BUCKET_ITEM_MAXN                    (1 << 16)
 
+/* the hash_map bucket maximum size for growing
+ *
+ * @note the buckets of the old and new hash list are indexed together when growing,
+ * so the index of the buckets need not be overflow
+ */
+#if TB_CPU_BIT64
+#   define TB_HASH_MAP_BUCKET_GROW_MAXN                 (1 << 20)
+#else
+#   define TB_HASH_MAP_BUCKET_GROW_MAXN                 (1 << 15)
+#endif
+
+// the average item count of each bucket for growing the buckets
+#define TB_HASH_MAP_BUCKET_LOAD                         (8)
+
+// the maximum bucket count which will be moved to the new hash list for each insert or remove
+#define TB_HASH_MAP_BUCKET_MOVE                         (4)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -95,6 +112,18 @@ typedef struct __tb_hash_map_impl_t
     // the hash list size
     tb_size_t                       hash_size;
 
+    // the old hash list which is being moved to the new hash list incrementally
+    tb_hash_map_item_list_t**       hash_list_old;
+
+    // the old hash list size
+    tb_size_t                       hash_size_old;
+
+    // the next bucket of the old hash list which will be moved
+    tb_size_t                       hash_move;
+
+    // grow the buckets incrementally?
+    tb_bool_t                       hash_grow;
+
     // the current item for iterator
     tb_hash_map_item_t              item;
 
@@ -118,25 +147,39 @@ typedef struct __tb_hash_map_impl_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static __tb_inline__ tb_hash_map_item_list_t** tb_hash_map_list(tb_hash_map_impl_t* impl, tb_size_t buck)
+{
+    // the bucket of the old hash list? it is indexed after the new hash list
+    if (buck >= impl->hash_size)
+    {
+        tb_assert(impl->hash_list_old && buck - impl->hash_size < impl->hash_size_old);
+        return &impl->hash_list_old[buck - impl->hash_size];
+    }
+    return &impl->hash_list[buck];
+}
+static __tb_inline__ tb_size_t tb_hash_map_buck_size(tb_hash_map_impl_t* impl)
+{
+    return impl->hash_size + impl->hash_size_old;
+}
 #if 0
 // linear finder
-static tb_bool_t tb_hash_map_item_find(tb_hash_map_impl_t* impl, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
+static tb_bool_t tb_hash_map_item_find_from(tb_hash_map_impl_t* impl, tb_hash_map_item_list_t** hash_list, tb_size_t hash_size, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
 {
-    tb_assert_and_check_return_val(impl && impl->hash_list && impl->hash_size, tb_false);
+    tb_assert_and_check_return_val(impl && hash_list && hash_size, tb_false);
     
     // get step
     tb_size_t step = impl->element_name.size + impl->element_data.size;
     tb_assert_and_check_return_val(step, tb_false);
 
     // comupte impl from name
-    tb_size_t buck = impl->element_name.hash(&impl->element_name, name, impl->hash_size - 1, 0);
-    tb_assert_and_check_return_val(buck < impl->hash_size, tb_false);
+    tb_size_t buck = impl->element_name.hash(&impl->element_name, name, hash_size - 1, 0);
+    tb_assert_and_check_return_val(buck < hash_size, tb_false);
 
     // update buck
     if (pbuck) *pbuck = buck;
 
     // get list
-    tb_hash_map_item_list_t* list = impl->hash_list[buck];
+    tb_hash_map_item_list_t* list = hash_list[buck];
     tb_check_return_val(list && list->size, tb_false);
 
     // find item
@@ -161,24 +204,24 @@ static tb_bool_t tb_hash_map_item_find(tb_hash_map_impl_t* impl, tb_cpointer_t n
 }
 #else
 // binary finder
-static tb_bool_t tb_hash_map_item_find(tb_hash_map_impl_t* impl, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
+static tb_bool_t tb_hash_map_item_find_from(tb_hash_map_impl_t* impl, tb_hash_map_item_list_t** hash_list, tb_size_t hash_size, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
 {
     // check
-    tb_assert_and_check_return_val(impl && impl->hash_list && impl->hash_size, tb_false);
+    tb_assert_and_check_return_val(impl && hash_list && hash_size, tb_false);
     
     // get step
     tb_size_t step = impl->element_name.size + impl->element_data.size;
     tb_assert_and_check_return_val(step, tb_false);
 
     // comupte impl from name
-    tb_size_t buck = impl->element_name.hash(&impl->element_name, name, impl->hash_size - 1, 0);
-    tb_assert_and_check_return_val(buck < impl->hash_size, tb_false);
+    tb_size_t buck = impl->element_name.hash(&impl->element_name, name, hash_size - 1, 0);
+    tb_assert_and_check_return_val(buck < hash_size, tb_false);
 
     // update buck
     if (pbuck) *pbuck = buck;
 
     // get list
-    tb_hash_map_item_list_t* list = impl->hash_list[buck];
+    tb_hash_map_item_list_t* list = hash_list[buck];
     tb_check_return_val(list && list->size, tb_false);
 
     // find item
@@ -214,17 +257,38 @@ static tb_bool_t tb_hash_map_item_find(tb_hash_map_impl_t* impl, tb_cpointer_t n
     return !t? tb_true : tb_false;
 }
 #endif
+static tb_bool_t tb_hash_map_item_find(tb_hash_map_impl_t* impl, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
+{
+    // check
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // find it from the new hash list, the position for inserting will be returned if not found
+    if (tb_hash_map_item_find_from(impl, impl->hash_list, impl->hash_size, name, pbuck, pitem)) return tb_true;
+
+    // find it from the old hash list if it is being moved
+    tb_size_t buck = 0;
+    tb_size_t item = 0;
+    if (impl->hash_list_old && tb_hash_map_item_find_from(impl, impl->hash_list_old, impl->hash_size_old, name, &buck, &item))
+    {
+        if (pbuck) *pbuck = impl->hash_size + buck;
+        if (pitem) *pitem = item;
+        return tb_true;
+    }
+
+    // not found
+    return tb_false;
+}
 static tb_bool_t tb_hash_map_item_at(tb_hash_map_impl_t* impl, tb_size_t buck, tb_size_t item, tb_pointer_t* pname, tb_pointer_t* pdata)
 {
     // check
-    tb_assert_and_check_return_val(impl && impl->hash_list && impl->hash_size && buck < impl->hash_size, tb_false);
+    tb_assert_and_check_return_val(impl && impl->hash_list && impl->hash_size && buck < tb_hash_map_buck_size(impl), tb_false);
     
     // get step
     tb_size_t step = impl->element_name.size + impl->element_data.size;
     tb_assert_and_check_return_val(step, tb_false);
 
     // get list
-    tb_hash_map_item_list_t* list = impl->hash_list[buck];
+    tb_hash_map_item_list_t* list = *tb_hash_map_list(impl, buck);
     tb_check_return_val(list && list->size && item < list->size, tb_false);
 
     // get name
@@ -236,6 +300,202 @@ static tb_bool_t tb_hash_map_item_at(tb_hash_map_impl_t* impl, tb_size_t buck, t
     // ok
     return tb_true;
 }
+static tb_byte_t* tb_hash_map_item_make(tb_hash_map_impl_t* impl, tb_size_t buck, tb_size_t item)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->hash_list && buck < impl->hash_size, tb_null);
+
+    // the step
+    tb_size_t step = impl->element_name.size + impl->element_data.size;
+    tb_assert_and_check_return_val(step, tb_null);
+
+    // get list
+    tb_hash_map_item_list_t* list = impl->hash_list[buck];
+    
+    // insert item
+    if (list)
+    {
+        // grow?
+        if (list->size >= list->maxn)
+        {
+            // check
+            tb_assert_and_check_return_val(impl->item_grow, tb_null);
+
+            // resize maxn
+            tb_size_t maxn = tb_align_pow2(list->maxn + impl->item_grow);
+            tb_assert_and_check_return_val(maxn > list->maxn, tb_null);
+
+            // realloc it
+            list = (tb_hash_map_item_list_t*)tb_ralloc(list, sizeof(tb_hash_map_item_list_t) + maxn * step);  
+            tb_assert_and_check_return_val(list, tb_null);
+
+            // update the impl item maxn
+            impl->item_maxn += maxn - list->maxn;
+
+            // update maxn
+            list->maxn = maxn;
+
+            // reattach list
+            impl->hash_list[buck] = list;
+        }
+        tb_assert_and_check_return_val(item <= list->size && list->size < list->maxn, tb_null);
+
+        // move items
+        if (item != list->size) tb_memmov(((tb_byte_t*)&list[1]) + (item + 1) * step, ((tb_byte_t*)&list[1]) + item * step, (list->size - item) * step);
+
+        // update size
+        list->size++;
+    }
+    // create list for adding item
+    else
+    {
+        // check
+        tb_assert_and_check_return_val(impl->item_grow && !item, tb_null);
+
+        // make list
+        list = (tb_hash_map_item_list_t*)tb_malloc0(sizeof(tb_hash_map_item_list_t) + impl->item_grow * step);
+        tb_assert_and_check_return_val(list, tb_null);
+
+        // init list
+        list->size = 1;
+        list->maxn = impl->item_grow;
+
+        // attach list
+        impl->hash_list[buck] = list;
+
+        // update the impl item maxn
+        impl->item_maxn += list->maxn;
+    }
+
+    // the item position
+    return ((tb_byte_t*)&list[1]) + item * step;
+}
+static tb_void_t tb_hash_map_move_buck(tb_hash_map_impl_t* impl, tb_size_t buck_old)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->hash_list_old && buck_old < impl->hash_size_old);
+
+    // the step
+    tb_size_t step = impl->element_name.size + impl->element_data.size;
+    tb_assert_and_check_return(step);
+
+    // the old list
+    tb_hash_map_item_list_t* list = impl->hash_list_old[buck_old];
+    tb_check_return(list);
+
+    /* move items to the new hash list from the tail
+     *
+     * the items are only moved and need not dupl or free them,
+     * and the remaining items are still in the old list if failed
+     */
+    while (list->size)
+    {
+        // the item
+        tb_byte_t const* data = ((tb_byte_t*)&list[1]) + (list->size - 1) * step;
+
+        // find the position in the new hash list
+        tb_size_t buck = 0;
+        tb_size_t item = 0;
+        if (tb_hash_map_item_find_from(impl, impl->hash_list, impl->hash_size, impl->element_name.data(&impl->element_name, data), &buck, &item))
+        {
+            // the item has been moved? will not be here
+            tb_assert(0);
+            break;
+        }
+
+        // make a new item
+        tb_byte_t* move = tb_hash_map_item_make(impl, buck, item);
+        tb_assert_and_check_break(move);
+
+        // move it
+        tb_memcpy(move, data, step);
+        list->size--;
+    }
+
+    // all items have been moved? free the old list
+    if (!list->size)
+    {
+        impl->item_maxn -= list->maxn;
+        impl->hash_list_old[buck_old] = tb_null;
+        tb_free(list);
+    }
+}
+static tb_void_t tb_hash_map_move_next(tb_hash_map_impl_t* impl, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // no moving?
+    tb_check_return(impl->hash_list_old);
+
+    // move some next buckets
+    while (count-- && impl->hash_move < impl->hash_size_old)
+    {
+        // move it
+        tb_hash_map_move_buck(impl, impl->hash_move);
+
+        // failed? try it again next time
+        tb_check_break(!impl->hash_list_old[impl->hash_move]);
+
+        // the next bucket
+        impl->hash_move++;
+    }
+
+    // all buckets have been moved? free the old hash list
+    if (impl->hash_move >= impl->hash_size_old)
+    {
+        // trace
+        tb_trace_d("move: %lu => %lu: ok", impl->hash_size_old, impl->hash_size);
+
+        // free it
+        tb_free(impl->hash_list_old);
+        impl->hash_list_old = tb_null;
+        impl->hash_size_old = 0;
+        impl->hash_move     = 0;
+    }
+}
+static tb_void_t tb_hash_map_move(tb_hash_map_impl_t* impl, tb_cpointer_t name)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // no moving?
+    tb_check_return(impl->hash_list_old);
+
+    // move the bucket of this name first, ensure that this item only exists in the new hash list
+    tb_hash_map_move_buck(impl, impl->element_name.hash(&impl->element_name, name, impl->hash_size_old - 1, 0));
+
+    // move some next buckets
+    tb_hash_map_move_next(impl, TB_HASH_MAP_BUCKET_MOVE);
+}
+static tb_void_t tb_hash_map_grow(tb_hash_map_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->hash_list && impl->hash_size);
+
+    // need grow it? the buckets are fixed if the growing mode is not enabled
+    tb_check_return(impl->hash_grow);
+    tb_check_return(!impl->hash_list_old && impl->item_size >= impl->hash_size * TB_HASH_MAP_BUCKET_LOAD);
+    tb_check_return((impl->hash_size << 1) <= TB_HASH_MAP_BUCKET_GROW_MAXN);
+
+    // make the new hash list
+    tb_hash_map_item_list_t** hash_list = (tb_hash_map_item_list_t**)tb_nalloc0(impl->hash_size << 1, sizeof(tb_size_t));
+    tb_assert_and_check_return(hash_list);
+
+    // trace
+    tb_trace_d("grow: %lu => %lu, size: %lu", impl->hash_size, impl->hash_size << 1, impl->item_size);
+
+    /* the old hash list will be moved to the new hash list incrementally
+     *
+     * a bounded number of buckets are moved for each insert or remove, and one bucket is moved for each lookup,
+     * so the lookup-heavy map will also finish moving. the lookup will find the items from the both hash lists until all buckets have been moved.
+     */
+    impl->hash_list_old = impl->hash_list;
+    impl->hash_size_old = impl->hash_size;
+    impl->hash_move     = 0;
+    impl->hash_list     = hash_list;
+    impl->hash_size     = impl->hash_size << 1;
+}
 static tb_size_t tb_hash_map_itor_size(tb_iterator_ref_t iterator)
 {
     // check
@@ -253,10 +513,10 @@ static tb_size_t tb_hash_map_itor_head(tb_iterator_ref_t iterator)
 
     // find the head
     tb_size_t i = 0;
-    tb_size_t n = impl->hash_size;
+    tb_size_t n = tb_hash_map_buck_size(impl);
     for (i = 0; i < n; i++)
     {
-        tb_hash_map_item_list_t* list = impl->hash_list[i];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list(impl, i);
         if (list && list->size) return tb_hash_map_index_make(i + 1, 1);
     }
     return 0;
@@ -279,17 +539,18 @@ static tb_size_t tb_hash_map_itor_next(tb_iterator_ref_t iterator, tb_size_t ito
     // compute index
     buck--;
     item--;
-    tb_assert(buck < impl->hash_size && (item + 1) < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+    tb_assert(buck < tb_hash_map_buck_size(impl) && (item + 1) < TB_HASH_MAP_BUCKET_ITEM_MAXN);
 
     // find the next from the current buck first
-    if (impl->hash_list[buck] && item + 1 < impl->hash_list[buck]->size) return tb_hash_map_index_make(buck + 1, item + 2);
+    tb_hash_map_item_list_t* list = *tb_hash_map_list(impl, buck);
+    if (list && item + 1 < list->size) return tb_hash_map_index_make(buck + 1, item + 2);
 
     // find the next from the next buckets
     tb_size_t i;
-    tb_size_t n = impl->hash_size;
+    tb_size_t n = tb_hash_map_buck_size(impl);
     for (i = buck + 1; i < n; i++)
     {
-        tb_hash_map_item_list_t* list = impl->hash_list[i];
+        list = *tb_hash_map_list(impl, i);
         if (list && list->size) return tb_hash_map_index_make(i + 1, 1);
     }
 
@@ -322,14 +583,14 @@ static tb_void_t tb_hash_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t ito
     tb_size_t b = tb_hash_map_index_buck(itor);
     tb_size_t i = tb_hash_map_index_item(itor);
     tb_assert(b && i); b--; i--;
-    tb_assert(b < impl->hash_size);
+    tb_assert(b < tb_hash_map_buck_size(impl));
 
     // step
     tb_size_t step = impl->element_name.size + impl->element_data.size;
     tb_assert(step);
 
     // list
-    tb_hash_map_item_list_t* list = impl->hash_list[b];
+    tb_hash_map_item_list_t* list = *tb_hash_map_list(impl, b);
     tb_check_return(list && list->size && i < list->size);
 
     // note: copy data only, will destroy impl index if copy name
@@ -354,14 +615,15 @@ static tb_void_t tb_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t i
     tb_size_t buck = tb_hash_map_index_buck(itor);
     tb_size_t item = tb_hash_map_index_item(itor);
     tb_assert(buck && item); buck--; item--;
-    tb_assert(buck < impl->hash_size);
+    tb_assert(buck < tb_hash_map_buck_size(impl));
 
     // the step
     tb_size_t step = impl->element_name.size + impl->element_data.size;
     tb_assert(step);
 
     // get list
-    tb_hash_map_item_list_t* list = impl->hash_list[buck];
+    tb_hash_map_item_list_t** plist = tb_hash_map_list(impl, buck);
+    tb_hash_map_item_list_t*  list = *plist;
     tb_assert(list && list->size && item < list->size);
 
     // free item
@@ -380,11 +642,14 @@ static tb_void_t tb_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t i
     // remove list
     else 
     {
+        // update the impl item maxn
+        impl->item_maxn -= list->maxn;
+
         // free it
         tb_free(list);
 
         // reset
-        impl->hash_list[buck] = tb_null;
+        *plist = tb_null;
     }
 
     // update the impl item size
@@ -403,6 +668,9 @@ static tb_void_t tb_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_si
     tb_size_t step = impl->element_name.size + impl->element_data.size;
     tb_assert(step);
 
+    // the bucket count
+    tb_size_t buck_size = tb_hash_map_buck_size(impl);
+
     // the first itor
     tb_size_t itor = prev? tb_hash_map_itor_next(iterator, prev) : tb_hash_map_itor_head(iterator);
 
@@ -414,7 +682,7 @@ static tb_void_t tb_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_si
     // compute index
     buck_head--;
     item_head--;
-    tb_assert(buck_head < impl->hash_size && item_head < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+    tb_assert(buck_head < buck_size && item_head < TB_HASH_MAP_BUCKET_ITEM_MAXN);
 
     // the last buck and the tail item
     tb_size_t buck_last;
@@ -429,11 +697,11 @@ static tb_void_t tb_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_si
         // compute index
         buck_last--;
         item_tail--;
-        tb_assert(buck_last < impl->hash_size && item_tail < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+        tb_assert(buck_last < buck_size && item_tail < TB_HASH_MAP_BUCKET_ITEM_MAXN);
     }
     else 
     {
-        buck_last = impl->hash_size - 1;
+        buck_last = buck_size - 1;
         item_tail = -1;
     }
 
@@ -445,7 +713,7 @@ static tb_void_t tb_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_si
     for (buck = buck_head, item = item_head; buck <= buck_last; buck++, item = 0)
     {
         // the list
-        tb_hash_map_item_list_t* list = impl->hash_list[buck];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list(impl, buck);
         tb_check_continue(list && list->size);
 
         // the tail
@@ -545,6 +813,18 @@ tb_hash_map_ref_t tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_n
     // ok?
     return (tb_hash_map_ref_t)impl;
 }
+tb_hash_map_ref_t tb_hash_map_init_grow(tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data)
+{
+    // init hash_map
+    tb_hash_map_impl_t* impl = (tb_hash_map_impl_t*)tb_hash_map_init(bucket_size, element_name, element_data);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // enable the growing mode
+    impl->hash_grow = tb_true;
+
+    // ok
+    return (tb_hash_map_ref_t)impl;
+}
 tb_void_t tb_hash_map_exit(tb_hash_map_ref_t hash_map)
 {
     // check
@@ -570,12 +850,13 @@ tb_void_t tb_hash_map_clear(tb_hash_map_ref_t hash_map)
     tb_size_t step = impl->element_name.size + impl->element_data.size;
     tb_assert_and_check_return(step);
 
-    // clear impl
+    // clear impl, the old hash list will be cleared too if it is being moved
     tb_size_t i = 0;
-    tb_size_t n = impl->hash_size;
+    tb_size_t n = tb_hash_map_buck_size(impl);
     for (i = 0; i < n; i++)
     {
-        tb_hash_map_item_list_t* list = impl->hash_list[i];
+        tb_hash_map_item_list_t** plist = tb_hash_map_list(impl, i);
+        tb_hash_map_item_list_t*  list = *plist;
         if (list)
         {
             // free items
@@ -594,9 +875,15 @@ tb_void_t tb_hash_map_clear(tb_hash_map_ref_t hash_map)
             // free list
             tb_free(list);
         }
-        impl->hash_list[i] = tb_null;
+        *plist = tb_null;
     }
 
+    // free the old hash list
+    if (impl->hash_list_old) tb_free(impl->hash_list_old);
+    impl->hash_list_old = tb_null;
+    impl->hash_size_old = 0;
+    impl->hash_move     = 0;
+
     // reset info
     impl->item_size = 0;
     impl->item_maxn = 0;
@@ -608,6 +895,12 @@ tb_pointer_t tb_hash_map_get(tb_hash_map_ref_t hash_map, tb_cpointer_t name)
     tb_hash_map_impl_t* impl = (tb_hash_map_impl_t*)hash_map;
     tb_assert_and_check_return_val(impl, tb_null);
 
+    /* move the next bucket of the old hash list if it is being moved
+     *
+     * @note the old hash list only exists in the growing mode, so the lookup is read-only for the fixed buckets
+     */
+    if (impl->hash_grow && impl->hash_list_old) tb_hash_map_move_next(impl, 1);
+
     // find it
     tb_size_t buck = 0;
     tb_size_t item = 0;
@@ -623,6 +916,12 @@ tb_size_t tb_hash_map_find(tb_hash_map_ref_t hash_map, tb_cpointer_t name)
     tb_hash_map_impl_t* impl = (tb_hash_map_impl_t*)hash_map;
     tb_assert_and_check_return_val(impl, 0);
 
+    /* move the next bucket of the old hash list if it is being moved
+     *
+     * @note the old hash list only exists in the growing mode, so the lookup is read-only for the fixed buckets
+     */
+    if (impl->hash_grow && impl->hash_list_old) tb_hash_map_move_next(impl, 1);
+
     // find
     tb_size_t buck = 0;
     tb_size_t item = 0;
@@ -644,82 +943,37 @@ tb_size_t tb_hash_map_insert(tb_hash_map_ref_t hash_map, tb_cpointer_t name, tb_
     if (tb_hash_map_item_find(impl, name, &buck, &item))
     {
         // check
-        tb_assert_and_check_return_val(buck < impl->hash_size, 0);
+        tb_assert_and_check_return_val(buck < tb_hash_map_buck_size(impl), 0);
 
         // get list
-        tb_hash_map_item_list_t* list = impl->hash_list[buck];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list(impl, buck);
         tb_assert_and_check_return_val(list && list->size && item < list->size, 0);
 
-        // replace data
+        // replace data in place, the items will not be moved for the opened iterators
         impl->element_data.repl(&impl->element_data, ((tb_byte_t*)&list[1]) + item * step + impl->element_name.size, data);
     }
     else
     {
-        // check
-        tb_assert_and_check_return_val(buck < impl->hash_size, 0);
+        // grow the buckets if the items are too many
+        tb_hash_map_grow(impl);
 
-        // get list
-        tb_hash_map_item_list_t* list = impl->hash_list[buck];
-        
-        // insert item
-        if (list)
+        // move some buckets of the old hash list if it is being moved
+        if (impl->hash_list_old)
         {
-            // grow?
-            if (list->size >= list->maxn)
-            {
-                // check
-                tb_assert_and_check_return_val(impl->item_grow, 0);
-
-                // resize maxn
-                tb_size_t maxn = tb_align_pow2(list->maxn + impl->item_grow);
-                tb_assert_and_check_return_val(maxn > list->maxn, 0);
-
-                // realloc it
-                list = (tb_hash_map_item_list_t*)tb_ralloc(list, sizeof(tb_hash_map_item_list_t) + maxn * step);  
-                tb_assert_and_check_return_val(list, 0);
-
-                // update the impl item maxn
-                impl->item_maxn += maxn - list->maxn;
-
-                // update maxn
-                list->maxn = maxn;
-
-                // reattach list
-                impl->hash_list[buck] = list;
-            }
-            tb_assert_and_check_return_val(item <= list->size && list->size < list->maxn, 0);
-
-            // move items
-            if (item != list->size) tb_memmov(((tb_byte_t*)&list[1]) + (item + 1) * step, ((tb_byte_t*)&list[1]) + item * step, (list->size - item) * step);
-
-            // dupl item
-            list->size++;
-            impl->element_name.dupl(&impl->element_name, ((tb_byte_t*)&list[1]) + item * step, name);
-            impl->element_data.dupl(&impl->element_data, ((tb_byte_t*)&list[1]) + item * step + impl->element_name.size, data);
+            // move them
+            tb_hash_map_move(impl, name);
 
+            // find the inserted position again, it may be changed after moving
+            tb_hash_map_item_find(impl, name, &buck, &item);
         }
-        // create list for adding item
-        else
-        {
-            // check
-            tb_assert_and_check_return_val(impl->item_grow, 0);
 
-            // make list
-            list = (tb_hash_map_item_list_t*)tb_malloc0(sizeof(tb_hash_map_item_list_t) + impl->item_grow * step);
-            tb_assert_and_check_return_val(list, 0);
+        // make item
+        tb_byte_t* slot = tb_hash_map_item_make(impl, buck, item);
+        tb_assert_and_check_return_val(slot, 0);
 
-            // init list
-            list->size = 1;
-            list->maxn = impl->item_grow;
-            impl->element_name.dupl(&impl->element_name, ((tb_byte_t*)&list[1]), name);
-            impl->element_data.dupl(&impl->element_data, ((tb_byte_t*)&list[1]) + impl->element_name.size, data);
-
-            // attach list
-            impl->hash_list[buck] = list;
-
-            // update the impl item maxn
-            impl->item_maxn += list->maxn;
-        }
+        // dupl item
+        impl->element_name.dupl(&impl->element_name, slot, name);
+        impl->element_data.dupl(&impl->element_data, slot + impl->element_name.size, data);
 
         // update the impl item size
         impl->item_size++;
@@ -737,8 +991,17 @@ tb_void_t tb_hash_map_remove(tb_hash_map_ref_t hash_map, tb_cpointer_t name)
     // find it
     tb_size_t buck = 0;
     tb_size_t item = 0;
-    if (tb_hash_map_item_find(impl, name, &buck, &item))
-        tb_hash_map_itor_remove((tb_iterator_ref_t)impl, tb_hash_map_index_make(buck + 1, item + 1));
+    tb_check_return(tb_hash_map_item_find(impl, name, &buck, &item));
+
+    // move some buckets of the old hash list if it is being moved, and find it again
+    if (impl->hash_list_old)
+    {
+        tb_hash_map_move(impl, name);
+        tb_check_return(tb_hash_map_item_find(impl, name, &buck, &item));
+    }
+
+    // remove it
+    tb_hash_map_itor_remove((tb_iterator_ref_t)impl, tb_hash_map_index_make(buck + 1, item + 1));
 }
 tb_size_t tb_hash_map_size(tb_hash_map_ref_t hash_map)
 {
@@ -771,16 +1034,16 @@ tb_void_t tb_hash_map_dump(tb_hash_map_ref_t hash_map)
 
     // trace
     tb_trace_i("");
-    tb_trace_i("hash_map: size: %lu", tb_hash_map_size(hash_map));
+    tb_trace_i("hash_map: size: %lu, buck: %lu, moving: %lu/%lu", tb_hash_map_size(hash_map), impl->hash_size, impl->hash_move, impl->hash_size_old);
 
     // done
     tb_size_t i = 0;
     tb_char_t name[4096];
     tb_char_t data[4096];
-    for (i = 0; i < impl->hash_size; i++)
+    for (i = 0; i < tb_hash_map_buck_size(impl); i++)
     {
         // the list
-        tb_hash_map_item_list_t* list = impl->hash_list[i];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list(impl, i);
         if (list)
         {
             // trace
@@ -90,6 +90,15 @@ typedef struct __tb_hash_map_item_t
  *
  * </pre>
  *
+ * the buckets are fixed for tb_hash_map_init() and the lookups will not move any items.
+ *
+ * the buckets will be grown for tb_hash_map_init_grow() if there are too many items, 
+ * and the items of the old buckets are moved to the new buckets incrementally 
+ * when inserting a new item, removing an existing item or finding an item.
+ *
+ * @note the items may be moved and the opened iterators will be invalidated after inserting a new item or removing an item,
+ * and after finding an item too if the buckets are being grown, but replacing the data of an existing item will not move any items.
+ *
  * @note the itor of the same item is mutable
  */
 typedef tb_iterator_ref_t tb_hash_map_ref_t;
@@ -98,7 +107,7 @@ typedef tb_iterator_ref_t tb_hash_map_ref_t;
  * interfaces
  */
 
-/*! init hash map
+/*! init hash map with the fixed buckets
  *
  * @param bucket_size   the hash bucket size, using the default size if be zero
  * @param element_name  the item for name
@@ -108,6 +117,18 @@ typedef tb_iterator_ref_t tb_hash_map_ref_t;
  */
 tb_hash_map_ref_t       tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data);
 
+/*! init hash map which grows the buckets incrementally
+ *
+ * @note the items may be moved by tb_hash_map_get() and tb_hash_map_find() when the buckets are being grown
+ *
+ * @param bucket_size   the initial hash bucket size, using the default size if be zero
+ * @param element_name  the item for name
+ * @param element_data  the item for data
+ *
+ * @return              the hash map
+ */
+tb_hash_map_ref_t       tb_hash_map_init_grow(tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data);
+
 /*! exit hash map
  *
  * @param hash_map      the hash map
@@ -126,6 +147,10 @@ tb_void_t               tb_hash_map_clear(tb_hash_map_ref_t hash_map);
  * the return value may be zero if the item type is integer
  * so we need call tb_hash_map_find for judging whether to get value successfully
  *
+ * @note 
+ * the items may be moved by the next tb_hash_map_get() if the buckets are being grown for tb_hash_map_init_grow(),
+ * so the returned data will be invalidated if it points into the item, e.g. the data of tb_element_mem()
+ *
  * @code
  *
  * // find item and get item data
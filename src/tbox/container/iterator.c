@@ -47,6 +47,14 @@ tb_size_t tb_iterator_step(tb_iterator_ref_t iterator)
     // step
     return iterator->step;
 }
+tb_size_t tb_iterator_type(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_assert(iterator);
+
+    // type
+    return iterator->type;
+}
 tb_size_t tb_iterator_size(tb_iterator_ref_t iterator)
 {
     // check
@@ -127,6 +135,22 @@ tb_void_t tb_iterator_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpoint
     // copy
     return iterator->copy(iterator, itor, item);
 }
+tb_pointer_t tb_iterator_buff(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_assert(iterator);
+
+    // buff
+    return iterator->buff? iterator->buff(iterator) : tb_null;
+}
+tb_pointer_t tb_iterator_load(tb_iterator_ref_t iterator, tb_cpointer_t slot)
+{
+    // check
+    tb_assert(iterator && iterator->load);
+
+    // load
+    return iterator->load(iterator, slot);
+}
 tb_long_t tb_iterator_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
 {
     // check
@@ -58,6 +58,9 @@ typedef struct __tb_iterator_t
     /// the iterator step
     tb_size_t               step;
 
+    /// the item type of the contiguous items if they are compared in the natural order by the iterator comp, tb_element_type_t, optional
+    tb_size_t               type;
+
     /// the iterator priv
     tb_pointer_t            priv;
 
@@ -94,6 +97,12 @@ typedef struct __tb_iterator_t
     /// the iterator remove range
     tb_void_t               (*remove_range)(struct __tb_iterator_t* iterator, tb_size_t prev, tb_size_t next, tb_size_t size);
 
+    /// the iterator buff, the contiguous items buffer of the random access iterator, optional
+    tb_pointer_t            (*buff)(struct __tb_iterator_t* iterator);
+
+    /// the iterator load, load the item from the slot of the items buffer, must be given if buff exists
+    tb_pointer_t            (*load)(struct __tb_iterator_t* iterator, tb_cpointer_t slot);
+
 }tb_iterator_t;
 
 /// the array iterator type
@@ -197,6 +206,16 @@ tb_size_t           tb_iterator_mode(tb_iterator_ref_t iterator);
  */
 tb_size_t           tb_iterator_step(tb_iterator_ref_t iterator);
 
+/*! the item type of the contiguous items
+ *
+ * the items of the known type can be sorted by the radix sorter, .e.g long, size, uint8/16/32 and str
+ * 
+ * @param iterator  the iterator
+ *
+ * @return          the item type, TB_ELEMENT_TYPE_NULL if be unknown or not be compared in the natural order
+ */
+tb_size_t           tb_iterator_type(tb_iterator_ref_t iterator);
+
 /*! the iterator size
  * 
  * @param iterator  the iterator
@@ -280,6 +299,26 @@ tb_void_t           tb_iterator_remove_range(tb_iterator_ref_t iterator, tb_size
  */
 tb_void_t           tb_iterator_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item);
 
+/*! the contiguous items buffer of the iterator
+ *
+ * the item of the itor is stored at (buff + itor * step), 
+ * the items can be moved by copying their slots directly, .e.g for sorting
+ * 
+ * @param iterator  the iterator
+ *
+ * @return          the items buffer, tb_null if the items are not contiguous
+ */
+tb_pointer_t        tb_iterator_buff(tb_iterator_ref_t iterator);
+
+/*! load the iterator item from the slot of the items buffer
+ * 
+ * @param iterator  the iterator
+ * @param slot      the item slot in the items buffer
+ *
+ * @return          the iterator item
+ */
+tb_pointer_t        tb_iterator_load(tb_iterator_ref_t iterator, tb_cpointer_t slot);
+
 /*! compare the iterator item
  * 
  * @param iterator  the iterator
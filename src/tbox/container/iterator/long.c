@@ -45,6 +45,7 @@ tb_iterator_ref_t tb_iterator_make_for_long(tb_array_iterator_ref_t iterator, tb
 
     // init
     iterator->base.comp = tb_iterator_long_comp;
+    iterator->base.type = TB_ELEMENT_TYPE_LONG;
 
     // ok
     return (tb_iterator_ref_t)iterator;
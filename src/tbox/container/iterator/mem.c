@@ -46,6 +46,11 @@ static tb_void_t tb_iterator_mem_copy(tb_iterator_ref_t iterator, tb_size_t itor
     // copy
     tb_memcpy((tb_byte_t*)((tb_array_iterator_ref_t)iterator)->items + itor * iterator->step, item, iterator->step);
 }
+static tb_pointer_t tb_iterator_mem_load(tb_iterator_ref_t iterator, tb_cpointer_t slot)
+{
+    // the item is the slot
+    return (tb_pointer_t)slot;
+}
 static tb_long_t tb_iterator_mem_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
 {
     // check
@@ -71,6 +76,7 @@ tb_iterator_ref_t tb_iterator_make_for_mem(tb_array_iterator_ref_t iterator, tb_
     iterator->base.item = tb_iterator_mem_item;
     iterator->base.copy = tb_iterator_mem_copy;
     iterator->base.comp = tb_iterator_mem_comp;
+    iterator->base.load = tb_iterator_mem_load;
 
     // ok
     return (tb_iterator_ref_t)iterator;
@@ -27,6 +27,7 @@
  * includes
  */
 #include "../prefix.h"
+#include "../element.h"
 #include "../iterator.h"
 #include "../../libc/libc.h"
 #include "../../utils/utils.h"
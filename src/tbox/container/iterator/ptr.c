@@ -82,6 +82,22 @@ static tb_void_t tb_iterator_ptr_copy(tb_iterator_ref_t iterator, tb_size_t itor
     // copy
     ((tb_cpointer_t*)((tb_array_iterator_ref_t)iterator)->items)[itor] = item;
 }
+static tb_pointer_t tb_iterator_ptr_buff(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_assert(iterator);
+
+    // the items
+    return ((tb_array_iterator_ref_t)iterator)->items;
+}
+static tb_pointer_t tb_iterator_ptr_load(tb_iterator_ref_t iterator, tb_cpointer_t slot)
+{
+    // check
+    tb_assert(slot);
+
+    // the item
+    return *((tb_pointer_t*)slot);
+}
 static tb_long_t tb_iterator_ptr_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
 {
     return (litem < ritem)? -1 : (litem > ritem);
@@ -99,6 +115,7 @@ tb_iterator_ref_t tb_iterator_make_for_ptr(tb_array_iterator_ref_t iterator, tb_
     iterator->base.mode     = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE | TB_ITERATOR_MODE_RACCESS | TB_ITERATOR_MODE_MUTABLE;
     iterator->base.priv     = tb_null;
     iterator->base.step     = sizeof(tb_pointer_t);
+    iterator->base.type     = TB_ELEMENT_TYPE_NULL;
     iterator->base.size     = tb_iterator_ptr_size;
     iterator->base.head     = tb_iterator_ptr_head;
     iterator->base.tail     = tb_iterator_ptr_tail;
@@ -107,6 +124,8 @@ tb_iterator_ref_t tb_iterator_make_for_ptr(tb_array_iterator_ref_t iterator, tb_
     iterator->base.item     = tb_iterator_ptr_item;
     iterator->base.copy     = tb_iterator_ptr_copy;
     iterator->base.comp     = tb_iterator_ptr_comp;
+    iterator->base.buff     = tb_iterator_ptr_buff;
+    iterator->base.load     = tb_iterator_ptr_load;
     iterator->items      = items;
     iterator->count         = count;
 
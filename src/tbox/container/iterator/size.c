@@ -33,5 +33,11 @@
 tb_iterator_ref_t tb_iterator_make_for_size(tb_array_iterator_ref_t iterator, tb_size_t* items, tb_size_t count)
 {
     // make iterator for the pointer array
-    return tb_iterator_make_for_ptr(iterator, (tb_pointer_t*)items, count);
+    if (!tb_iterator_make_for_ptr(iterator, (tb_pointer_t*)items, count)) return tb_null;
+
+    // init
+    iterator->base.type = TB_ELEMENT_TYPE_SIZE;
+
+    // ok
+    return (tb_iterator_ref_t)iterator;
 }
@@ -56,6 +56,7 @@ tb_iterator_ref_t tb_iterator_make_for_str(tb_array_iterator_ref_t iterator, tb_
 
     // init
     iterator->base.comp = tb_iterator_str_comp;
+    iterator->base.type = TB_ELEMENT_TYPE_STR;
 
     // ok
     return (tb_iterator_ref_t)iterator;
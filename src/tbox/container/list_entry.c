@@ -26,6 +26,7 @@
  * includes
  */
 #include "list_entry.h"
+#include "element.h"
 #include "../libc/libc.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -159,6 +160,7 @@ tb_void_t tb_list_entry_init_(tb_list_entry_head_ref_t list, tb_size_t entry_off
     list->itor.mode         = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE;
     list->itor.priv         = tb_null;
     list->itor.step         = entry_size;
+    list->itor.type         = TB_ELEMENT_TYPE_NULL;
     list->itor.size         = tb_list_entry_itor_size;
     list->itor.head         = tb_list_entry_itor_head;
     list->itor.last         = tb_list_entry_itor_last;
@@ -170,6 +172,8 @@ tb_void_t tb_list_entry_init_(tb_list_entry_head_ref_t list, tb_size_t entry_off
     list->itor.remove       = tb_list_entry_itor_remove;
     list->itor.remove_range = tb_list_entry_itor_remove_range;
     list->itor.comp = tb_null;
+    list->itor.buff = tb_null;
+    list->itor.load = tb_null;
 }
 tb_void_t tb_list_entry_exit(tb_list_entry_head_ref_t list)
 {
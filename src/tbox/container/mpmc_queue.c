@@ -0,0 +1,388 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        mpmc_queue.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "mpmc_queue.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#ifdef __tb_small__
+#   define TB_MPMC_QUEUE_SIZE_DEFAULT           (256)
+#else
+#   define TB_MPMC_QUEUE_SIZE_DEFAULT           (65536)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the mpmc queue cell type
+typedef struct __tb_mpmc_queue_cell_t
+{
+    // the sequence
+    tb_atomic_t             seq;
+
+    // the data
+    tb_cpointer_t           data;
+
+}tb_mpmc_queue_cell_t;
+
+// the mpmc queue impl type
+typedef struct __tb_mpmc_queue_impl_t
+{
+    // the cells
+    tb_mpmc_queue_cell_t*   cells;
+
+    // the maxn
+    tb_size_t               maxn;
+
+    // the head for the consumers, uses the individual cache line
+    tb_atomic_t             head __tb_cacheline_aligned__;
+
+    // the tail for the producers, uses the individual cache line
+    tb_atomic_t             tail __tb_cacheline_aligned__;
+
+}tb_mpmc_queue_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_mpmc_queue_ref_t tb_mpmc_queue_init(tb_size_t maxn)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_mpmc_queue_impl_t*   impl = tb_null;
+    do
+    {
+        // using the default maxn
+        if (!maxn) maxn = TB_MPMC_QUEUE_SIZE_DEFAULT;
+
+        // align by pow2
+        maxn = tb_align_pow2(maxn);
+        tb_assert_and_check_break(maxn > 1);
+
+        /* make queue
+         *
+         * @note the head and tail are aligned by the cache line, 
+         * but tb_malloc only aligns the data by the pool, so we need align it by the cache line explicitly
+         */
+        impl = (tb_mpmc_queue_impl_t*)tb_align_malloc0(sizeof(tb_mpmc_queue_impl_t), TB_SMP_CACHE_BYTES);
+        tb_assert_and_check_break(impl);
+
+        // make cells
+        impl->maxn  = maxn;
+        impl->cells = tb_nalloc0_type(maxn, tb_mpmc_queue_cell_t);
+        tb_assert_and_check_break(impl->cells);
+
+        // init the cell sequences, the cell[i] is free for the position i
+        tb_size_t i = 0;
+        for (i = 0; i < maxn; i++) impl->cells[i].seq = (tb_long_t)i;
+
+        // init head and tail
+        tb_atomic_set0(&impl->head);
+        tb_atomic_set0(&impl->tail);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_mpmc_queue_exit((tb_mpmc_queue_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (tb_mpmc_queue_ref_t)impl;
+}
+tb_void_t tb_mpmc_queue_exit(tb_mpmc_queue_ref_t queue)
+{
+    // check
+    tb_mpmc_queue_impl_t* impl = (tb_mpmc_queue_impl_t*)queue;
+    tb_assert_and_check_return(impl);
+
+    // exit cells
+    if (impl->cells) tb_free(impl->cells);
+    impl->cells = tb_null;
+
+    // exit it
+    tb_align_free(impl);
+}
+tb_bool_t tb_mpmc_queue_push(tb_mpmc_queue_ref_t queue, tb_cpointer_t data)
+{
+    // check
+    tb_mpmc_queue_impl_t* impl = (tb_mpmc_queue_impl_t*)queue;
+    tb_assert_and_check_return_val(impl && impl->cells, tb_false);
+
+    // claim one free cell
+    tb_size_t               mask = impl->maxn - 1;
+    tb_size_t               tail = (tb_size_t)tb_atomic_get(&impl->tail);
+    tb_mpmc_queue_cell_t*   cell = tb_null;
+    while (1)
+    {
+        // the cell and it's sequence
+        cell = &impl->cells[tail & mask];
+        tb_long_t diff = (tb_long_t)((tb_size_t)tb_atomic_get(&cell->seq) - tail);
+
+        // free? claim it
+        if (!diff)
+        {
+            // ok?
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&impl->tail, (tb_long_t)tail, (tb_long_t)(tail + 1));
+            if (prev == tail) break;
+
+            // the tail has been claimed by the other producer, try the new tail 
+            tail = prev;
+        }
+        // full? 
+        else if (diff < 0) return tb_false;
+        // the tail has been updated
+        else tail = (tb_size_t)tb_atomic_get(&impl->tail);
+    }
+
+    // save data
+    cell->data = data;
+
+    // publish it for the consumers
+    tb_atomic_set(&cell->seq, (tb_long_t)(tail + 1));
+
+    // ok
+    return tb_true;
+}
+tb_size_t tb_mpmc_queue_push_list(tb_mpmc_queue_ref_t queue, tb_cpointer_t const* list, tb_size_t size)
+{
+    // check
+    tb_mpmc_queue_impl_t* impl = (tb_mpmc_queue_impl_t*)queue;
+    tb_assert_and_check_return_val(impl && impl->cells && list, 0);
+
+    // no items?
+    tb_check_return_val(size, 0);
+
+    // claim the free cells
+    tb_size_t   i = 0;
+    tb_size_t   n = 0;
+    tb_size_t   mask = impl->maxn - 1;
+    tb_size_t   tail = (tb_size_t)tb_atomic_get(&impl->tail);
+    while (1)
+    {
+        // the first cell
+        tb_long_t diff = (tb_long_t)((tb_size_t)tb_atomic_get(&impl->cells[tail & mask].seq) - tail);
+
+        // full?
+        if (diff < 0) return 0;
+        // the tail has been updated
+        else if (diff > 0) 
+        {
+            tail = (tb_size_t)tb_atomic_get(&impl->tail);
+            continue;
+        }
+
+        /* count the continuous free cells 
+         *
+         * the free cell will not be changed before claiming the tail, 
+         * so we need not check them again after claiming them
+         */
+        for (n = 1; n < size && n < impl->maxn; n++)
+        {
+            if ((tb_size_t)tb_atomic_get(&impl->cells[(tail + n) & mask].seq) != tail + n) break;
+        }
+
+        // claim them
+        tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&impl->tail, (tb_long_t)tail, (tb_long_t)(tail + n));
+        if (prev == tail) break;
+
+        // the tail has been claimed by the other producer, try the new tail 
+        tail = prev;
+    }
+
+    // save data and publish them for the consumers
+    for (i = 0; i < n; i++)
+    {
+        // the cell
+        tb_mpmc_queue_cell_t* cell = &impl->cells[(tail + i) & mask];
+
+        // save data
+        cell->data = list[i];
+
+        // publish it
+        tb_atomic_set(&cell->seq, (tb_long_t)(tail + i + 1));
+    }
+
+    // ok
+    return n;
+}
+tb_bool_t tb_mpmc_queue_pop(tb_mpmc_queue_ref_t queue, tb_pointer_t* pdata)
+{
+    // check
+    tb_mpmc_queue_impl_t* impl = (tb_mpmc_queue_impl_t*)queue;
+    tb_assert_and_check_return_val(impl && impl->cells && pdata, tb_false);
+
+    // claim one full cell
+    tb_size_t               mask = impl->maxn - 1;
+    tb_size_t               head = (tb_size_t)tb_atomic_get(&impl->head);
+    tb_mpmc_queue_cell_t*   cell = tb_null;
+    while (1)
+    {
+        // the cell and it's sequence
+        cell = &impl->cells[head & mask];
+        tb_long_t diff = (tb_long_t)((tb_size_t)tb_atomic_get(&cell->seq) - (head + 1));
+
+        // full? claim it
+        if (!diff)
+        {
+            // ok?
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&impl->head, (tb_long_t)head, (tb_long_t)(head + 1));
+            if (prev == head) break;
+
+            // the head has been claimed by the other consumer, try the new head 
+            head = prev;
+        }
+        // null?
+        else if (diff < 0) return tb_false;
+        // the head has been updated
+        else head = (tb_size_t)tb_atomic_get(&impl->head);
+    }
+
+    // save data
+    *pdata = (tb_pointer_t)cell->data;
+
+    // free it for the producers of the next round
+    tb_atomic_set(&cell->seq, (tb_long_t)(head + impl->maxn));
+
+    // ok
+    return tb_true;
+}
+tb_size_t tb_mpmc_queue_pop_list(tb_mpmc_queue_ref_t queue, tb_pointer_t* list, tb_size_t maxn)
+{
+    // check
+    tb_mpmc_queue_impl_t* impl = (tb_mpmc_queue_impl_t*)queue;
+    tb_assert_and_check_return_val(impl && impl->cells && list, 0);
+
+    // no space?
+    tb_check_return_val(maxn, 0);
+
+    // claim the full cells
+    tb_size_t   i = 0;
+    tb_size_t   n = 0;
+    tb_size_t   mask = impl->maxn - 1;
+    tb_size_t   head = (tb_size_t)tb_atomic_get(&impl->head);
+    while (1)
+    {
+        // the first cell
+        tb_long_t diff = (tb_long_t)((tb_size_t)tb_atomic_get(&impl->cells[head & mask].seq) - (head + 1));
+
+        // null?
+        if (diff < 0) return 0;
+        // the head has been updated
+        else if (diff > 0)
+        {
+            head = (tb_size_t)tb_atomic_get(&impl->head);
+            continue;
+        }
+
+        /* count the continuous full cells
+         *
+         * the full cell will not be changed before claiming the head, 
+         * so we need not check them again after claiming them
+         */
+        for (n = 1; n < maxn && n < impl->maxn; n++)
+        {
+            if ((tb_size_t)tb_atomic_get(&impl->cells[(head + n) & mask].seq) != head + n + 1) break;
+        }
+
+        // claim them
+        tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&impl->head, (tb_long_t)head, (tb_long_t)(head + n));
+        if (prev == head) break;
+
+        // the head has been claimed by the other consumer, try the new head 
+        head = prev;
+    }
+
+    // save data and free them for the producers of the next round
+    for (i = 0; i < n; i++)
+    {
+        // the cell
+        tb_mpmc_queue_cell_t* cell = &impl->cells[(head + i) & mask];
+
+        // save data
+        list[i] = (tb_pointer_t)cell->data;
+
+        // free it
+        tb_atomic_set(&cell->seq, (tb_long_t)(head + i + impl->maxn));
+    }
+
+    // ok
+    return n;
+}
+tb_size_t tb_mpmc_queue_size(tb_mpmc_queue_ref_t queue)
+{
+    // check
+    tb_mpmc_queue_impl_t* impl = (tb_mpmc_queue_impl_t*)queue;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the head and tail
+    tb_size_t head = (tb_size_t)tb_atomic_get(&impl->head);
+    tb_size_t tail = (tb_size_t)tb_atomic_get(&impl->tail);
+
+    // the size, the head may be larger than the tail if the tail is read later
+    tb_long_t size = (tb_long_t)(tail - head);
+    return size > 0? tb_min((tb_size_t)size, impl->maxn) : 0;
+}
+tb_size_t tb_mpmc_queue_maxn(tb_mpmc_queue_ref_t queue)
+{
+    // check
+    tb_mpmc_queue_impl_t* impl = (tb_mpmc_queue_impl_t*)queue;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the maxn
+    return impl->maxn;
+}
+tb_bool_t tb_mpmc_queue_full(tb_mpmc_queue_ref_t queue)
+{
+    // check
+    tb_mpmc_queue_impl_t* impl = (tb_mpmc_queue_impl_t*)queue;
+    tb_assert_and_check_return_val(impl, tb_true);
+
+    // full?
+    return tb_mpmc_queue_size(queue) == impl->maxn;
+}
+tb_bool_t tb_mpmc_queue_null(tb_mpmc_queue_ref_t queue)
+{
+    // check
+    tb_mpmc_queue_impl_t* impl = (tb_mpmc_queue_impl_t*)queue;
+    tb_assert_and_check_return_val(impl, tb_true);
+
+    // null?
+    return !tb_mpmc_queue_size(queue);
+}
@@ -0,0 +1,163 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        mpmc_queue.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_MPMC_QUEUE_H
+#define TB_CONTAINER_MPMC_QUEUE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the lock-free multi-producer and multi-consumer queue ref type
+ *
+ * <pre>
+ * the bounded ring of cells, each cell has a sequence number:
+ *
+ * cells: |  seq: 4  |  seq: 5  |  seq: 3  |  seq: 4  |
+ *        | data: x  | data: x  | data: d0 | data: d1 |
+ *                               head                  tail: 4
+ *
+ * push: the cell is free if seq == tail, claim it by cas(tail), and set seq = tail + 1
+ * pop:  the cell is full if seq == head + 1, claim it by cas(head), and set seq = head + maxn
+ *
+ * performance:
+ *
+ * push: O(1), lock-free
+ * pop:  O(1), lock-free
+ * </pre>
+ *
+ * @note the item is a pointer and the queue need not free it,
+ *       the item maxn will be aligned by power of 2
+ */
+typedef struct{}*       tb_mpmc_queue_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init queue
+ *
+ * @param maxn          the item maxn, using the default maxn if be zero
+ *
+ * @return              the queue
+ */
+tb_mpmc_queue_ref_t     tb_mpmc_queue_init(tb_size_t maxn);
+
+/*! exit queue
+ *
+ * @note the left items will not be freed
+ *
+ * @param queue         the queue
+ */
+tb_void_t               tb_mpmc_queue_exit(tb_mpmc_queue_ref_t queue);
+
+/*! push the queue item
+ *
+ * @param queue         the queue
+ * @param data          the item data
+ *
+ * @return              tb_true or tb_false if be full
+ */
+tb_bool_t               tb_mpmc_queue_push(tb_mpmc_queue_ref_t queue, tb_cpointer_t data);
+
+/*! push the queue items
+ *
+ * claim the free cells as many as possible by one cas operation
+ *
+ * @param queue         the queue
+ * @param list          the item list
+ * @param size          the item count
+ *
+ * @return              the real pushed item count, the head items of the list will be pushed first
+ */
+tb_size_t               tb_mpmc_queue_push_list(tb_mpmc_queue_ref_t queue, tb_cpointer_t const* list, tb_size_t size);
+
+/*! pop the queue item
+ *
+ * @param queue         the queue
+ * @param pdata         the item data pointer
+ *
+ * @return              tb_true or tb_false if be null
+ */
+tb_bool_t               tb_mpmc_queue_pop(tb_mpmc_queue_ref_t queue, tb_pointer_t* pdata);
+
+/*! pop the queue items
+ *
+ * claim the full cells as many as possible by one cas operation
+ *
+ * @param queue         the queue
+ * @param list          the item list
+ * @param maxn          the item list maxn
+ *
+ * @return              the real popped item count
+ */
+tb_size_t               tb_mpmc_queue_pop_list(tb_mpmc_queue_ref_t queue, tb_pointer_t* list, tb_size_t maxn);
+
+/*! the queue size, only an approximate value if the queue is being used by other threads
+ *
+ * @param queue         the queue
+ *
+ * @return              the queue size
+ */
+tb_size_t               tb_mpmc_queue_size(tb_mpmc_queue_ref_t queue);
+
+/*! the queue maxn
+ *
+ * @param queue         the queue
+ *
+ * @return              the queue maxn
+ */
+tb_size_t               tb_mpmc_queue_maxn(tb_mpmc_queue_ref_t queue);
+
+/*! the queue full?
+ *
+ * @param queue         the queue
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_mpmc_queue_full(tb_mpmc_queue_ref_t queue);
+
+/*! the queue null?
+ *
+ * @param queue         the queue
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_mpmc_queue_null(tb_mpmc_queue_ref_t queue);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
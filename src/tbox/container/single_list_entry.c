@@ -26,6 +26,7 @@
  * includes
  */
 #include "single_list_entry.h"
+#include "element.h"
 #include "../libc/libc.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -137,6 +138,7 @@ tb_void_t tb_single_list_entry_init_(tb_single_list_entry_head_ref_t list, tb_si
     list->itor.mode         = TB_ITERATOR_MODE_FORWARD;
     list->itor.priv         = tb_null;
     list->itor.step         = entry_size;
+    list->itor.type         = TB_ELEMENT_TYPE_NULL;
     list->itor.size         = tb_single_list_entry_itor_size;
     list->itor.head         = tb_single_list_entry_itor_head;
     list->itor.last         = tb_single_list_entry_itor_last;
@@ -146,6 +148,8 @@ tb_void_t tb_single_list_entry_init_(tb_single_list_entry_head_ref_t list, tb_si
     list->itor.copy         = tb_single_list_entry_itor_copy;
     list->itor.remove_range = tb_single_list_entry_itor_remove_range;
     list->itor.comp         = tb_null;
+    list->itor.buff         = tb_null;
+    list->itor.load         = tb_null;
 }
 tb_void_t tb_single_list_entry_exit(tb_single_list_entry_head_ref_t list)
 {
@@ -0,0 +1,657 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        unrolled_list.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "unrolled_list"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "unrolled_list.h"
+#include "../libc/libc.h"
+#include "../memory/memory.h"
+#include "../algorithm/algorithm.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default chunk bytes
+#ifdef __tb_small__ 
+#   define TB_UNROLLED_LIST_CHUNK_SIZE      (1024)
+#else
+#   define TB_UNROLLED_LIST_CHUNK_SIZE      (2048)
+#endif
+
+// the chunk items maxn, the item index is stored in the low byte of the itor
+#define TB_UNROLLED_LIST_CHUNK_MAXN         (256)
+
+// the chunk items minn
+#define TB_UNROLLED_LIST_CHUNK_MINN         (4)
+
+// the chunk align, the low byte of the chunk address is always zero
+#define TB_UNROLLED_LIST_CHUNK_ALIGN        (256)
+
+// the list maxn
+#ifdef __tb_small__
+#   define TB_UNROLLED_LIST_MAXN            (1 << 16)
+#else
+#   define TB_UNROLLED_LIST_MAXN            (1 << 30)
+#endif
+
+// the chunk data offset
+#define tb_unrolled_list_chunk_data_offset()    tb_align8(sizeof(tb_unrolled_list_chunk_t))
+
+// the item slot of the chunk
+#define tb_unrolled_list_chunk_slot(impl, chunk, index) \
+                                                ((tb_byte_t*)(chunk) + tb_unrolled_list_chunk_data_offset() + (index) * (impl)->element.size)
+
+// make itor from the chunk and the item index
+#define tb_unrolled_list_itor_make(chunk, index)    ((tb_size_t)(chunk) | (index))
+
+// the chunk of the itor
+#define tb_unrolled_list_itor_chunk(itor)       ((tb_unrolled_list_chunk_t*)((itor) & ~(tb_size_t)(TB_UNROLLED_LIST_CHUNK_ALIGN - 1)))
+
+// the item index of the itor
+#define tb_unrolled_list_itor_index(itor)       ((itor) & (TB_UNROLLED_LIST_CHUNK_ALIGN - 1))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the unrolled list chunk type
+typedef struct __tb_unrolled_list_chunk_t
+{
+    // the prev chunk
+    struct __tb_unrolled_list_chunk_t*  prev;
+
+    // the next chunk
+    struct __tb_unrolled_list_chunk_t*  next;
+
+    // the head index of the items
+    tb_size_t                           head;
+
+    // the items count
+    tb_size_t                           size;
+
+}tb_unrolled_list_chunk_t;
+
+// the unrolled list impl type
+typedef struct __tb_unrolled_list_impl_t
+{
+    // the itor
+    tb_iterator_t               itor;
+
+    // the head chunk
+    tb_unrolled_list_chunk_t*   head;
+
+    // the last chunk
+    tb_unrolled_list_chunk_t*   last;
+
+    // the items count
+    tb_size_t                   size;
+
+    // the items maxn of each chunk
+    tb_size_t                   chunk_maxn;
+
+    // the chunk bytes
+    tb_size_t                   chunk_size;
+
+    // the element
+    tb_element_t                element;
+
+}tb_unrolled_list_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_unrolled_list_chunk_t* tb_unrolled_list_chunk_init(tb_unrolled_list_impl_t* impl, tb_unrolled_list_chunk_t* prev, tb_size_t head)
+{
+    // make chunk
+    tb_unrolled_list_chunk_t* chunk = (tb_unrolled_list_chunk_t*)tb_align_malloc(impl->chunk_size, TB_UNROLLED_LIST_CHUNK_ALIGN);
+    tb_assert_and_check_return_val(chunk, tb_null);
+
+    // init chunk
+    chunk->head = head;
+    chunk->size = 0;
+
+    // insert it to the next of the prev chunk
+    chunk->prev = prev;
+    chunk->next = prev? prev->next : impl->head;
+    if (chunk->next) chunk->next->prev = chunk;
+    else impl->last = chunk;
+    if (prev) prev->next = chunk;
+    else impl->head = chunk;
+
+    // ok
+    return chunk;
+}
+static tb_void_t tb_unrolled_list_chunk_exit(tb_unrolled_list_impl_t* impl, tb_unrolled_list_chunk_t* chunk)
+{
+    // remove it
+    if (chunk->prev) chunk->prev->next = chunk->next;
+    else impl->head = chunk->next;
+    if (chunk->next) chunk->next->prev = chunk->prev;
+    else impl->last = chunk->prev;
+
+    // exit it
+    tb_align_free(chunk);
+}
+static tb_void_t tb_unrolled_list_chunk_compact(tb_unrolled_list_impl_t* impl, tb_unrolled_list_chunk_t* chunk)
+{
+    // move the items to the front of the chunk
+    if (chunk->head)
+    {
+        if (chunk->size) tb_memmov(tb_unrolled_list_chunk_slot(impl, chunk, 0), tb_unrolled_list_chunk_slot(impl, chunk, chunk->head), chunk->size * impl->element.size);
+        chunk->head = 0;
+    }
+}
+static tb_size_t tb_unrolled_list_chunk_insert(tb_unrolled_list_impl_t* impl, tb_unrolled_list_chunk_t* chunk, tb_size_t offset)
+{
+    // check
+    tb_assert(chunk->size < impl->chunk_maxn && offset <= chunk->size);
+
+    // the item step
+    tb_size_t step = impl->element.size;
+
+    // the item index
+    tb_size_t index = chunk->head + offset;
+
+    // there is free space at the end? move the back items to the next slot
+    if (chunk->head + chunk->size < impl->chunk_maxn)
+    {
+        if (offset < chunk->size) tb_memmov(tb_unrolled_list_chunk_slot(impl, chunk, index + 1), tb_unrolled_list_chunk_slot(impl, chunk, index), (chunk->size - offset) * step);
+    }
+    // move the front items to the prev slot
+    else
+    {
+        // check
+        tb_assert(chunk->head);
+
+        // move them
+        if (offset) tb_memmov(tb_unrolled_list_chunk_slot(impl, chunk, chunk->head - 1), tb_unrolled_list_chunk_slot(impl, chunk, chunk->head), offset * step);
+        chunk->head--;
+        index--;
+    }
+
+    // update the items count
+    chunk->size++;
+    impl->size++;
+
+    // the item index
+    return index;
+}
+static tb_size_t tb_unrolled_list_itor_size(tb_iterator_ref_t iterator)
+{
+    // the size
+    return tb_unrolled_list_size((tb_unrolled_list_ref_t)iterator);
+}
+static tb_size_t tb_unrolled_list_itor_head(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)iterator;
+    tb_assert(impl);
+
+    // head
+    return impl->head? tb_unrolled_list_itor_make(impl->head, impl->head->head) : (tb_size_t)impl;
+}
+static tb_size_t tb_unrolled_list_itor_last(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)iterator;
+    tb_assert(impl);
+
+    // last
+    return impl->last? tb_unrolled_list_itor_make(impl->last, impl->last->head + impl->last->size - 1) : (tb_size_t)impl;
+}
+static tb_size_t tb_unrolled_list_itor_tail(tb_iterator_ref_t iterator)
+{
+    // tail
+    return (tb_size_t)iterator;
+}
+static tb_size_t tb_unrolled_list_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_assert(iterator && itor && itor != (tb_size_t)iterator);
+
+    // the chunk
+    tb_unrolled_list_chunk_t* chunk = tb_unrolled_list_itor_chunk(itor);
+
+    // the next item in this chunk?
+    if (tb_unrolled_list_itor_index(itor) + 1 < chunk->head + chunk->size) return itor + 1;
+
+    // the head item in the next chunk
+    return chunk->next? tb_unrolled_list_itor_make(chunk->next, chunk->next->head) : (tb_size_t)iterator;
+}
+static tb_size_t tb_unrolled_list_itor_prev(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_assert(iterator && itor);
+
+    // the tail? return the last item
+    if (itor == (tb_size_t)iterator) return tb_unrolled_list_itor_last(iterator);
+
+    // the chunk
+    tb_unrolled_list_chunk_t* chunk = tb_unrolled_list_itor_chunk(itor);
+
+    // the prev item in this chunk?
+    if (tb_unrolled_list_itor_index(itor) > chunk->head) return itor - 1;
+
+    // the last item in the prev chunk
+    return chunk->prev? tb_unrolled_list_itor_make(chunk->prev, chunk->prev->head + chunk->prev->size - 1) : (tb_size_t)iterator;
+}
+static tb_pointer_t tb_unrolled_list_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)iterator;
+    tb_assert(impl && itor && itor != (tb_size_t)impl);
+
+    // data
+    return impl->element.data(&impl->element, tb_unrolled_list_chunk_slot(impl, tb_unrolled_list_itor_chunk(itor), tb_unrolled_list_itor_index(itor)));
+}
+static tb_void_t tb_unrolled_list_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)iterator;
+    tb_assert(impl && itor && itor != (tb_size_t)impl);
+
+    // copy
+    impl->element.copy(&impl->element, tb_unrolled_list_chunk_slot(impl, tb_unrolled_list_itor_chunk(itor), tb_unrolled_list_itor_index(itor)), item);
+}
+static tb_long_t tb_unrolled_list_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)iterator;
+    tb_assert(impl && impl->element.comp);
+
+    // comp
+    return impl->element.comp(&impl->element, litem, ritem);
+}
+static tb_void_t tb_unrolled_list_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // remove it
+    tb_unrolled_list_remove((tb_unrolled_list_ref_t)iterator, itor);
+}
+static tb_void_t tb_unrolled_list_itor_remove_range(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // no size?
+    tb_check_return(size);
+
+    // the list size
+    tb_size_t list_size = tb_unrolled_list_size((tb_unrolled_list_ref_t)iterator);
+    tb_check_return(list_size);
+
+    // limit size
+    if (size > list_size) size = list_size;
+
+    // remove the body items
+    if (prev) 
+    {
+        /* the next itor may be changed after removing the items in the same chunk, 
+         * so we remove them by the given size
+         */
+        tb_size_t itor = tb_iterator_next((tb_unrolled_list_ref_t)iterator, prev);
+        while (itor != (tb_size_t)iterator && size--) itor = tb_unrolled_list_remove((tb_unrolled_list_ref_t)iterator, itor);
+    }
+    // remove the head items
+    else 
+    {
+        while (size--) tb_unrolled_list_remove_head((tb_unrolled_list_ref_t)iterator);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_unrolled_list_ref_t tb_unrolled_list_init(tb_size_t chunk, tb_element_t element)
+{
+    // check
+    tb_assert_and_check_return_val(element.size && element.data && element.dupl && element.repl, tb_null);
+    tb_assert_and_check_return_val(chunk <= TB_UNROLLED_LIST_CHUNK_MAXN, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_unrolled_list_impl_t*    impl = tb_null;
+    do
+    {
+        // using the default chunk
+        if (!chunk) 
+        {
+            chunk = (TB_UNROLLED_LIST_CHUNK_SIZE - tb_unrolled_list_chunk_data_offset()) / element.size;
+            if (chunk > TB_UNROLLED_LIST_CHUNK_MAXN) chunk = TB_UNROLLED_LIST_CHUNK_MAXN;
+        }
+        if (chunk < TB_UNROLLED_LIST_CHUNK_MINN) chunk = TB_UNROLLED_LIST_CHUNK_MINN;
+
+        // make list
+        impl = tb_malloc0_type(tb_unrolled_list_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init element
+        impl->element = element;
+
+        // init chunk, the chunk must be larger than the item index range for the itor
+        impl->chunk_maxn = chunk;
+        impl->chunk_size = tb_max(tb_unrolled_list_chunk_data_offset() + chunk * element.size, TB_UNROLLED_LIST_CHUNK_ALIGN);
+
+        // init iterator
+        impl->itor.mode         = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE;
+        impl->itor.priv         = tb_null;
+        impl->itor.step         = element.size;
+        impl->itor.size         = tb_unrolled_list_itor_size;
+        impl->itor.head         = tb_unrolled_list_itor_head;
+        impl->itor.last         = tb_unrolled_list_itor_last;
+        impl->itor.tail         = tb_unrolled_list_itor_tail;
+        impl->itor.prev         = tb_unrolled_list_itor_prev;
+        impl->itor.next         = tb_unrolled_list_itor_next;
+        impl->itor.item         = tb_unrolled_list_itor_item;
+        impl->itor.copy         = tb_unrolled_list_itor_copy;
+        impl->itor.comp         = tb_unrolled_list_itor_comp;
+        impl->itor.remove       = tb_unrolled_list_itor_remove;
+        impl->itor.remove_range = tb_unrolled_list_itor_remove_range;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_unrolled_list_exit((tb_unrolled_list_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (tb_unrolled_list_ref_t)impl;
+}
+tb_void_t tb_unrolled_list_exit(tb_unrolled_list_ref_t list)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)list;
+    tb_assert_and_check_return(impl);
+    
+    // clear data
+    tb_unrolled_list_clear((tb_unrolled_list_ref_t)impl);
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t tb_unrolled_list_clear(tb_unrolled_list_ref_t list)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)list;
+    tb_assert_and_check_return(impl);
+
+    // exit all chunks
+    tb_unrolled_list_chunk_t* chunk = impl->head;
+    while (chunk)
+    {
+        // free the items
+        if (impl->element.free)
+        {
+            tb_size_t i = 0;
+            for (i = 0; i < chunk->size; i++) 
+                impl->element.free(&impl->element, tb_unrolled_list_chunk_slot(impl, chunk, chunk->head + i));
+        }
+
+        // exit this chunk
+        tb_unrolled_list_chunk_t* next = chunk->next;
+        tb_align_free(chunk);
+        chunk = next;
+    }
+
+    // clear it
+    impl->head = tb_null;
+    impl->last = tb_null;
+    impl->size = 0;
+}
+tb_pointer_t tb_unrolled_list_head(tb_unrolled_list_ref_t list)
+{
+    return tb_iterator_item(list, tb_iterator_head(list));
+}
+tb_pointer_t tb_unrolled_list_last(tb_unrolled_list_ref_t list)
+{
+    return tb_iterator_item(list, tb_iterator_last(list));
+}
+tb_size_t tb_unrolled_list_size(tb_unrolled_list_ref_t list)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)list;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the size
+    return impl->size;
+}
+tb_size_t tb_unrolled_list_maxn(tb_unrolled_list_ref_t list)
+{
+    // the item maxn
+    return TB_UNROLLED_LIST_MAXN;
+}
+tb_size_t tb_unrolled_list_insert_prev(tb_unrolled_list_ref_t list, tb_size_t itor, tb_cpointer_t data)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)list;
+    tb_assert_and_check_return_val(impl && impl->element.dupl && itor, 0);
+
+    // full?
+    tb_assert_and_check_return_val(impl->size < TB_UNROLLED_LIST_MAXN, (tb_size_t)impl);
+
+    // the chunk and the item offset in it
+    tb_size_t                   offset = 0;
+    tb_unrolled_list_chunk_t*   chunk = tb_null;
+    if (itor == (tb_size_t)impl)
+    {
+        // append it to the last chunk
+        chunk = impl->last;
+        if (!chunk || chunk->size == impl->chunk_maxn) chunk = tb_unrolled_list_chunk_init(impl, impl->last, 0);
+        tb_assert_and_check_return_val(chunk, (tb_size_t)impl);
+
+        // the offset
+        offset = chunk->size;
+    }
+    else
+    {
+        // the chunk and offset
+        chunk   = tb_unrolled_list_itor_chunk(itor);
+        offset  = tb_unrolled_list_itor_index(itor) - chunk->head;
+        tb_assert(offset < chunk->size);
+
+        // the chunk is full?
+        if (chunk->size == impl->chunk_maxn)
+        {
+            // insert it before the head item?
+            if (!offset)
+            {
+                // append it to the prev chunk if it is not full
+                if (chunk->prev && chunk->prev->size < impl->chunk_maxn) 
+                {
+                    chunk   = chunk->prev;
+                    offset  = chunk->size;
+                }
+                // insert it to the new prev chunk and grow it from the end
+                else 
+                {
+                    chunk = tb_unrolled_list_chunk_init(impl, chunk->prev, impl->chunk_maxn);
+                    tb_assert_and_check_return_val(chunk, (tb_size_t)impl);
+                }
+            }
+            // split this chunk
+            else
+            {
+                // make the next chunk
+                tb_unrolled_list_chunk_t* next = tb_unrolled_list_chunk_init(impl, chunk, 0);
+                tb_assert_and_check_return_val(next, (tb_size_t)impl);
+
+                // move the back half items to the next chunk
+                tb_size_t half = chunk->size >> 1;
+                next->size = chunk->size - half;
+                tb_memcpy(tb_unrolled_list_chunk_slot(impl, next, 0), tb_unrolled_list_chunk_slot(impl, chunk, chunk->head + half), next->size * impl->element.size);
+                chunk->size = half;
+
+                // insert it to the next chunk?
+                if (offset > half)
+                {
+                    chunk   = next;
+                    offset -= half;
+                }
+            }
+        }
+    }
+
+    // insert the item slot
+    tb_size_t index = tb_unrolled_list_chunk_insert(impl, chunk, offset);
+
+    // init the item data
+    impl->element.dupl(&impl->element, tb_unrolled_list_chunk_slot(impl, chunk, index), data);
+
+    // ok
+    return tb_unrolled_list_itor_make(chunk, index);
+}
+tb_size_t tb_unrolled_list_insert_next(tb_unrolled_list_ref_t list, tb_size_t itor, tb_cpointer_t data)
+{
+    return tb_unrolled_list_insert_prev(list, tb_iterator_next(list, itor), data);
+}
+tb_size_t tb_unrolled_list_insert_head(tb_unrolled_list_ref_t list, tb_cpointer_t data)
+{
+    return tb_unrolled_list_insert_prev(list, tb_iterator_head(list), data);
+}
+tb_size_t tb_unrolled_list_insert_tail(tb_unrolled_list_ref_t list, tb_cpointer_t data)
+{
+    return tb_unrolled_list_insert_prev(list, tb_iterator_tail(list), data);
+}
+tb_void_t tb_unrolled_list_replace(tb_unrolled_list_ref_t list, tb_size_t itor, tb_cpointer_t data)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)list;
+    tb_assert_and_check_return(impl && impl->element.repl && itor && itor != (tb_size_t)impl);
+
+    // replace data
+    impl->element.repl(&impl->element, tb_unrolled_list_chunk_slot(impl, tb_unrolled_list_itor_chunk(itor), tb_unrolled_list_itor_index(itor)), data);
+}
+tb_void_t tb_unrolled_list_replace_head(tb_unrolled_list_ref_t list, tb_cpointer_t data)
+{
+    tb_unrolled_list_replace(list, tb_iterator_head(list), data);
+}
+tb_void_t tb_unrolled_list_replace_last(tb_unrolled_list_ref_t list, tb_cpointer_t data)
+{
+    tb_unrolled_list_replace(list, tb_iterator_last(list), data);
+}
+tb_size_t tb_unrolled_list_remove(tb_unrolled_list_ref_t list, tb_size_t itor)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)list;
+    tb_assert_and_check_return_val(impl && itor, 0);
+
+    // the tail?
+    tb_check_return_val(itor != (tb_size_t)impl, (tb_size_t)impl);
+
+    // the chunk and the item offset in it
+    tb_size_t                   step = impl->element.size;
+    tb_size_t                   index = tb_unrolled_list_itor_index(itor);
+    tb_unrolled_list_chunk_t*   chunk = tb_unrolled_list_itor_chunk(itor);
+    tb_size_t                   offset = index - chunk->head;
+    tb_assert_and_check_return_val(offset < chunk->size, (tb_size_t)impl);
+
+    // free the item data
+    if (impl->element.free) impl->element.free(&impl->element, tb_unrolled_list_chunk_slot(impl, chunk, index));
+
+    // move the front items to the next slot if there are less front items
+    if (offset < (chunk->size >> 1))
+    {
+        if (offset) tb_memmov(tb_unrolled_list_chunk_slot(impl, chunk, chunk->head + 1), tb_unrolled_list_chunk_slot(impl, chunk, chunk->head), offset * step);
+        chunk->head++;
+    }
+    // move the back items to the prev slot
+    else if (offset + 1 < chunk->size) 
+        tb_memmov(tb_unrolled_list_chunk_slot(impl, chunk, index), tb_unrolled_list_chunk_slot(impl, chunk, index + 1), (chunk->size - offset - 1) * step);
+
+    // update the items count
+    chunk->size--;
+    impl->size--;
+
+    // the chunk is empty? exit it
+    if (!chunk->size)
+    {
+        tb_unrolled_list_chunk_t* next = chunk->next;
+        tb_unrolled_list_chunk_exit(impl, chunk);
+        return next? tb_unrolled_list_itor_make(next, next->head) : (tb_size_t)impl;
+    }
+
+    // merge the next chunk to this chunk if both are sparse
+    tb_unrolled_list_chunk_t* next = chunk->next;
+    if (next && chunk->size + next->size <= (impl->chunk_maxn >> 1))
+    {
+        // make the free space at the end
+        if (chunk->head + chunk->size + next->size > impl->chunk_maxn) tb_unrolled_list_chunk_compact(impl, chunk);
+
+        // move the next items
+        tb_memcpy(tb_unrolled_list_chunk_slot(impl, chunk, chunk->head + chunk->size), tb_unrolled_list_chunk_slot(impl, next, next->head), next->size * step);
+        chunk->size += next->size;
+
+        // exit the next chunk
+        tb_unrolled_list_chunk_exit(impl, next);
+    }
+
+    // the next item
+    if (offset < chunk->size) return tb_unrolled_list_itor_make(chunk, chunk->head + offset);
+    return chunk->next? tb_unrolled_list_itor_make(chunk->next, chunk->next->head) : (tb_size_t)impl;
+}
+tb_void_t tb_unrolled_list_remove_head(tb_unrolled_list_ref_t list)
+{
+    tb_unrolled_list_remove(list, tb_iterator_head(list));
+}
+tb_void_t tb_unrolled_list_remove_last(tb_unrolled_list_ref_t list)
+{
+    tb_unrolled_list_remove(list, tb_iterator_last(list));
+}
+#ifdef __tb_debug__
+tb_void_t tb_unrolled_list_dump(tb_unrolled_list_ref_t list)
+{
+    // check
+    tb_unrolled_list_impl_t* impl = (tb_unrolled_list_impl_t*)list;
+    tb_assert_and_check_return(impl);
+
+    // trace
+    tb_trace_i("unrolled_list: size: %lu, chunk: %lu", tb_unrolled_list_size(list), impl->chunk_maxn);
+
+    // done
+    tb_char_t cstr[4096];
+    tb_for_all (tb_pointer_t, data, list)
+    {
+        // trace
+        if (impl->element.cstr) 
+        {
+            tb_trace_i("    %s", impl->element.cstr(&impl->element, data, cstr, sizeof(cstr)));
+        }
+        else
+        {
+            tb_trace_i("    %p", data);
+        }
+    }
+}
+#endif
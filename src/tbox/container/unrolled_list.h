@@ -0,0 +1,228 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        unrolled_list.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_UNROLLED_LIST_H
+#define TB_CONTAINER_UNROLLED_LIST_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the unrolled doubly-linked list ref type
+ *
+ * the items are stored in the doubly-linked chunks and each chunk holds many contiguous items,
+ * so walking it is mostly sequential memory reads.
+ *
+ * <pre>
+ * list: tail => |-----------------| => |-----------------| => ... => |-----------------| => tail
+ *        |      | item item item  |    | item item item  |           | item item item  |     |
+ *        |       head chunk                                            last chunk            |
+ *        <-----------------------------------------------------------------------------------
+ *
+ * performance: 
+ *
+ * insert:
+ * insert midd: fast
+ * insert head: fast
+ * insert tail: fast
+ * insert next: fast
+ *
+ * remove:
+ * remove midd: fast
+ * remove head: fast
+ * remove last: fast
+ * remove next: fast
+ *
+ * iterator:
+ * next: fast
+ * prev: fast
+ * </pre>
+ *
+ * @note the iterators of the items in the same chunk will be changed after inserting or removing items
+ */
+typedef tb_iterator_ref_t   tb_unrolled_list_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init list
+ *
+ * @param chunk     the items count of each chunk, using the default count if be zero, must be not larger than 256
+ * @param element   the element
+ *
+ * @return          the list
+ */
+tb_unrolled_list_ref_t  tb_unrolled_list_init(tb_size_t chunk, tb_element_t element);
+
+/*! exit list
+ *
+ * @param list      the list
+ */
+tb_void_t               tb_unrolled_list_exit(tb_unrolled_list_ref_t list);
+
+/*! clear list
+ *
+ * @param list      the list
+ */
+tb_void_t               tb_unrolled_list_clear(tb_unrolled_list_ref_t list);
+
+/*! the list head item
+ *
+ * @param list      the list
+ *
+ * @return          the head item
+ */
+tb_pointer_t            tb_unrolled_list_head(tb_unrolled_list_ref_t list);
+
+/*! the list last item
+ *
+ * @param list      the list
+ *
+ * @return          the last item
+ */
+tb_pointer_t            tb_unrolled_list_last(tb_unrolled_list_ref_t list);
+
+/*! insert the prev item
+ *
+ * @param list      the list
+ * @param itor      the item itor
+ * @param data      the item data
+ *
+ * @return          the item itor
+ */
+tb_size_t               tb_unrolled_list_insert_prev(tb_unrolled_list_ref_t list, tb_size_t itor, tb_cpointer_t data);
+
+/*! insert the next item
+ *
+ * @param list      the list
+ * @param itor      the item itor
+ * @param data      the item data
+ *
+ * @return          the item itor
+ */
+tb_size_t               tb_unrolled_list_insert_next(tb_unrolled_list_ref_t list, tb_size_t itor, tb_cpointer_t data);
+
+/*! insert the head item
+ *
+ * @param list      the list
+ * @param data      the item data
+ *
+ * @return          the item itor
+ */
+tb_size_t               tb_unrolled_list_insert_head(tb_unrolled_list_ref_t list, tb_cpointer_t data);
+
+/*! insert the tail item
+ *
+ * @param list      the list
+ * @param data      the item data
+ *
+ * @return          the item itor
+ */
+tb_size_t               tb_unrolled_list_insert_tail(tb_unrolled_list_ref_t list, tb_cpointer_t data);
+
+/*! replace the item
+ *
+ * @param list      the list
+ * @param itor      the item itor
+ * @param data      the item data
+ */
+tb_void_t               tb_unrolled_list_replace(tb_unrolled_list_ref_t list, tb_size_t itor, tb_cpointer_t data);
+
+/*! replace the head item
+ *
+ * @param list      the list
+ * @param data      the item data
+ */
+tb_void_t               tb_unrolled_list_replace_head(tb_unrolled_list_ref_t list, tb_cpointer_t data);
+
+/*! replace the tail item
+ *
+ * @param list      the list
+ * @param data      the item data
+ */
+tb_void_t               tb_unrolled_list_replace_last(tb_unrolled_list_ref_t list, tb_cpointer_t data);
+
+/*! remove the item
+ *
+ * @param list      the list
+ * @param itor      the item itor
+ *
+ * @return          the next item
+ */
+tb_size_t               tb_unrolled_list_remove(tb_unrolled_list_ref_t list, tb_size_t itor);
+
+/*! remove the head item
+ *
+ * @param list      the list
+ */
+tb_void_t               tb_unrolled_list_remove_head(tb_unrolled_list_ref_t list);
+
+/*! remove the last item
+ *
+ * @param list      the list
+ */
+tb_void_t               tb_unrolled_list_remove_last(tb_unrolled_list_ref_t list);
+
+/*! the item count
+ *
+ * @param list      the list
+ *
+ * @return          the item count
+ */
+tb_size_t               tb_unrolled_list_size(tb_unrolled_list_ref_t list);
+
+/*! the item max count
+ *
+ * @param list      the list
+ *
+ * @return          the item max count
+ */
+tb_size_t               tb_unrolled_list_maxn(tb_unrolled_list_ref_t list);
+
+#ifdef __tb_debug__
+/*! dump list
+ *
+ * @param list      the list
+ */
+tb_void_t               tb_unrolled_list_dump(tb_unrolled_list_ref_t list);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
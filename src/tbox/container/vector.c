@@ -82,11 +82,92 @@ typedef struct __tb_vector_impl_t
     // the element
     tb_element_t            element;
 
+    // is plain old data? the item value is stored in the slot directly and need not be freed
+    tb_bool_t               pod;
+
 }tb_vector_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static tb_bool_t tb_vector_element_is_pod(tb_element_ref_t element)
+{
+    // the default element of the integer types
+    tb_element_t pod;
+    switch (element->type)
+    {
+    case TB_ELEMENT_TYPE_LONG:      pod = tb_element_long();     break;
+    case TB_ELEMENT_TYPE_SIZE:      pod = tb_element_size();     break;
+    case TB_ELEMENT_TYPE_UINT8:     pod = tb_element_uint8();    break;
+    case TB_ELEMENT_TYPE_UINT16:    pod = tb_element_uint16();   break;
+    case TB_ELEMENT_TYPE_UINT32:    pod = tb_element_uint32();   break;
+    default: return tb_false;
+    }
+
+    // the element callbacks are not hooked?
+    return (    element->size == pod.size
+            &&  element->free == pod.free
+            &&  element->dupl == pod.dupl
+            &&  element->repl == pod.repl
+            &&  element->nfree == pod.nfree
+            &&  element->ndupl == pod.ndupl
+            &&  element->nrepl == pod.nrepl)? tb_true : tb_false;
+}
+static tb_size_t tb_vector_element_type(tb_element_ref_t element)
+{
+    // the default element of the known types
+    tb_element_t stock;
+    switch (element->type)
+    {
+    case TB_ELEMENT_TYPE_LONG:      stock = tb_element_long();     break;
+    case TB_ELEMENT_TYPE_SIZE:      stock = tb_element_size();     break;
+    case TB_ELEMENT_TYPE_UINT8:     stock = tb_element_uint8();    break;
+    case TB_ELEMENT_TYPE_UINT16:    stock = tb_element_uint16();   break;
+    case TB_ELEMENT_TYPE_UINT32:    stock = tb_element_uint32();   break;
+    case TB_ELEMENT_TYPE_STR:
+        {
+            // only the case-sensitive strings are compared in the natural order of the bytes
+            tb_check_return_val(element->flag, TB_ELEMENT_TYPE_NULL);
+            stock = tb_element_str(tb_true);
+        }
+        break;
+    default: return TB_ELEMENT_TYPE_NULL;
+    }
+
+    // the items are compared in the natural order? otherwise the comparator has been hooked and they cannot be sorted by radix
+    return (element->size == stock.size && element->comp == stock.comp)? element->type : TB_ELEMENT_TYPE_NULL;
+}
+static __tb_inline__ tb_void_t tb_vector_pod_save(tb_byte_t* slot, tb_cpointer_t data, tb_size_t size)
+{
+    // save the item value
+    switch (size)
+    {
+    case 1: *slot = (tb_uint8_t)(tb_size_t)data; break;
+    case 2: *((tb_uint16_t*)slot) = (tb_uint16_t)(tb_size_t)data; break;
+    case 4: *((tb_uint32_t*)slot) = (tb_uint32_t)(tb_size_t)data; break;
+    default: *((tb_size_t*)slot) = (tb_size_t)data; break;
+    }
+}
+static tb_bool_t tb_vector_buff_resize(tb_vector_impl_t* impl, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(maxn >= impl->size && maxn < TB_VECTOR_MAXN, tb_false);
+
+    // realloc data
+    tb_byte_t* data = (tb_byte_t*)tb_ralloc(impl->data, maxn * impl->element.size);
+    tb_assert_and_check_return_val(data, tb_false);
+
+    // must be align by 4-bytes
+    tb_assert_and_check_return_val(!(((tb_size_t)data) & 3), tb_false);
+
+    // clear the grow data
+    if (maxn > impl->maxn) tb_memset(data + impl->maxn * impl->element.size, 0, (maxn - impl->maxn) * impl->element.size);
+
+    // save data and maxn
+    impl->data = data;
+    impl->maxn = maxn;
+    return tb_true;
+}
 static tb_size_t tb_vector_itor_size(tb_iterator_ref_t iterator)
 {
     // check
@@ -166,6 +247,24 @@ static tb_long_t tb_vector_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t l
     // comp
     return impl->element.comp(&impl->element, litem, ritem);
 }
+static tb_pointer_t tb_vector_itor_buff(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_vector_impl_t* impl = (tb_vector_impl_t*)iterator;
+    tb_assert(impl);
+
+    // the data
+    return impl->data;
+}
+static tb_pointer_t tb_vector_itor_load(tb_iterator_ref_t iterator, tb_cpointer_t slot)
+{
+    // check
+    tb_vector_impl_t* impl = (tb_vector_impl_t*)iterator;
+    tb_assert(impl);
+
+    // the item
+    return impl->element.data(&impl->element, slot);
+}
 static tb_void_t tb_vector_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
 {
     // remove it
@@ -206,12 +305,14 @@ tb_vector_ref_t tb_vector_init(tb_size_t grow, tb_element_t element)
         impl->grow      = grow;
         impl->maxn      = grow;
         impl->element   = element;
+        impl->pod       = tb_vector_element_is_pod(&element);
         tb_assert_and_check_break(impl->maxn < TB_VECTOR_MAXN);
 
         // init iterator
         impl->itor.mode         = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE | TB_ITERATOR_MODE_RACCESS | TB_ITERATOR_MODE_MUTABLE;
         impl->itor.priv         = tb_null;
         impl->itor.step         = element.size;
+        impl->itor.type         = tb_vector_element_type(&element);
         impl->itor.size         = tb_vector_itor_size;
         impl->itor.head         = tb_vector_itor_head;
         impl->itor.last         = tb_vector_itor_last;
@@ -223,6 +324,8 @@ tb_vector_ref_t tb_vector_init(tb_size_t grow, tb_element_t element)
         impl->itor.comp         = tb_vector_itor_comp;
         impl->itor.remove       = tb_vector_itor_remove;
         impl->itor.remove_range = tb_vector_itor_remove_range;
+        impl->itor.buff         = tb_vector_itor_buff;
+        impl->itor.load         = tb_vector_itor_load;
 
         // make data
         impl->data = (tb_byte_t*)tb_nalloc0(impl->maxn, element.size);
@@ -267,8 +370,8 @@ tb_void_t tb_vector_clear(tb_vector_ref_t vector)
     tb_assert_and_check_return(impl);
 
     // free data
-    if (impl->element.nfree)
-        impl->element.nfree(&impl->element, impl->data, impl->size);
+    if (impl->pod) tb_memset(impl->data, 0, impl->size * impl->element.size);
+    else if (impl->element.nfree) impl->element.nfree(&impl->element, impl->data, impl->size);
 
     // reset size 
     impl->size = 0;
@@ -359,33 +462,41 @@ tb_bool_t tb_vector_resize(tb_vector_ref_t vector, tb_size_t size)
     if (size < impl->size)
     {
         // free data
-        if (impl->element.nfree) 
-            impl->element.nfree(&impl->element, impl->data + size * impl->element.size, impl->size - size);
+        if (impl->pod) tb_memset(impl->data + size * impl->element.size, 0, (impl->size - size) * impl->element.size);
+        else if (impl->element.nfree) impl->element.nfree(&impl->element, impl->data + size * impl->element.size, impl->size - size);
     }
 
-    // resize buffer
-    if (size > impl->maxn)
-    {
-        tb_size_t maxn = tb_align4(size + impl->grow);
-        tb_assert_and_check_return_val(maxn < TB_VECTOR_MAXN, tb_false);
+    // resize buffer, grow it by the half size at least for appending many items
+    if (size > impl->maxn && !tb_vector_buff_resize(impl, tb_align4(size + tb_max(impl->grow, size >> 1)))) return tb_false;
 
-        // realloc data
-        impl->data = (tb_byte_t*)tb_ralloc(impl->data, maxn * impl->element.size);
-        tb_assert_and_check_return_val(impl->data, tb_false);
+    // update size
+    impl->size = size;
+    return tb_true;
+}
+tb_bool_t tb_vector_reserve(tb_vector_ref_t vector, tb_size_t maxn)
+{
+    // check
+    tb_vector_impl_t* impl = (tb_vector_impl_t*)vector;
+    tb_assert_and_check_return_val(impl, tb_false);
 
-        // must be align by 4-bytes
-        tb_assert_and_check_return_val(!(((tb_size_t)(impl->data)) & 3), tb_false);
+    // enough?
+    tb_check_return_val(maxn > impl->maxn, tb_true);
 
-        // clear the grow data
-        tb_memset(impl->data + impl->size * impl->element.size, 0, (maxn - impl->maxn) * impl->element.size);
+    // grow buffer
+    return tb_vector_buff_resize(impl, tb_align4(maxn));
+}
+tb_bool_t tb_vector_shrink(tb_vector_ref_t vector)
+{
+    // check
+    tb_vector_impl_t* impl = (tb_vector_impl_t*)vector;
+    tb_assert_and_check_return_val(impl, tb_false);
 
-        // save maxn
-        impl->maxn = maxn;
-    }
+    // the new maxn, keep one item at least
+    tb_size_t maxn = tb_align4(impl->size? impl->size : 1);
+    tb_check_return_val(maxn < impl->maxn, tb_true);
 
-    // update size
-    impl->size = size;
-    return tb_true;
+    // shrink buffer
+    return tb_vector_buff_resize(impl, maxn);
 }
 tb_void_t tb_vector_insert_prev(tb_vector_ref_t vector, tb_size_t itor, tb_cpointer_t data)
 {
@@ -397,7 +508,8 @@ tb_void_t tb_vector_insert_prev(tb_vector_ref_t vector, tb_size_t itor, tb_cpoin
     tb_size_t osize = impl->size;
 
     // grow a item
-    if (!tb_vector_resize(vector, osize + 1)) 
+    if (osize < impl->maxn) impl->size++;
+    else if (!tb_vector_resize(vector, osize + 1)) 
     {
         tb_trace_d("impl resize: %u => %u failed", osize, osize + 1);
         return ;
@@ -407,7 +519,8 @@ tb_void_t tb_vector_insert_prev(tb_vector_ref_t vector, tb_size_t itor, tb_cpoin
     if (osize != itor) tb_memmov(impl->data + (itor + 1) * impl->element.size, impl->data + itor * impl->element.size, (osize - itor) * impl->element.size);
 
     // save data
-    impl->element.dupl(&impl->element, impl->data + itor * impl->element.size, data);
+    if (impl->pod) tb_vector_pod_save(impl->data + itor * impl->element.size, data, impl->element.size);
+    else impl->element.dupl(&impl->element, impl->data + itor * impl->element.size, data);
 }
 tb_void_t tb_vector_insert_next(tb_vector_ref_t vector, tb_size_t itor, tb_cpointer_t data)
 {
@@ -455,6 +568,45 @@ tb_void_t tb_vector_ninsert_tail(tb_vector_ref_t vector, tb_cpointer_t data, tb_
 {
     tb_vector_ninsert_prev(vector, tb_vector_size(vector), data, size);
 }
+tb_void_t tb_vector_insert_items(tb_vector_ref_t vector, tb_size_t itor, tb_cpointer_t items, tb_size_t size)
+{
+    // check
+    tb_vector_impl_t* impl = (tb_vector_impl_t*)vector;
+    tb_assert_and_check_return(impl && impl->data && items && itor <= impl->size);
+
+    // no items?
+    tb_check_return(size);
+
+    // save size
+    tb_size_t osize = impl->size;
+
+    // grow size
+    if (!tb_vector_resize(vector, osize + size)) 
+    {
+        tb_trace_d("impl resize: %u => %u failed", osize, osize + size);
+        return ;
+    }
+
+    // move items if not at tail
+    tb_size_t   step = impl->element.size;
+    tb_byte_t*  data = impl->data + itor * step;
+    if (osize != itor) tb_memmov(data + size * step, data, (osize - itor) * step);
+
+    // copy the plain old data directly
+    if (impl->pod) tb_memcpy(data, items, size * step);
+    // duplicate items
+    else
+    {
+        tb_byte_t const* p = (tb_byte_t const*)items;
+        tb_byte_t const* e = p + size * step;
+        for (; p < e; p += step, data += step) 
+            impl->element.dupl(&impl->element, data, impl->element.data(&impl->element, p));
+    }
+}
+tb_void_t tb_vector_insert_tail_items(tb_vector_ref_t vector, tb_cpointer_t items, tb_size_t size)
+{
+    tb_vector_insert_items(vector, tb_vector_size(vector), items, size);
+}
 tb_void_t tb_vector_replace(tb_vector_ref_t vector, tb_size_t itor, tb_cpointer_t data)
 {
     // check
@@ -462,7 +614,8 @@ tb_void_t tb_vector_replace(tb_vector_ref_t vector, tb_size_t itor, tb_cpointer_
     tb_assert_and_check_return(impl && impl->data && itor <= impl->size);
 
     // replace data
-    impl->element.repl(&impl->element, impl->data + itor * impl->element.size, data);
+    if (impl->pod) tb_vector_pod_save(impl->data + itor * impl->element.size, data, impl->element.size);
+    else impl->element.repl(&impl->element, impl->data + itor * impl->element.size, data);
 }
 tb_void_t tb_vector_replace_head(tb_vector_ref_t vector, tb_cpointer_t data)
 {
@@ -502,6 +655,29 @@ tb_void_t tb_vector_nreplace_last(tb_vector_ref_t vector, tb_cpointer_t data, tb
     // replace
     tb_vector_nreplace(vector, size >= impl->size? 0 : impl->size - size, data, size);
 }
+tb_void_t tb_vector_replace_items(tb_vector_ref_t vector, tb_size_t itor, tb_cpointer_t items, tb_size_t size)
+{
+    // check
+    tb_vector_impl_t* impl = (tb_vector_impl_t*)vector;
+    tb_assert_and_check_return(impl && impl->data && items && itor <= impl->size);
+
+    // strip size
+    if (itor + size > impl->size) size = impl->size - itor;
+    tb_check_return(size);
+
+    // copy the plain old data directly
+    tb_size_t   step = impl->element.size;
+    tb_byte_t*  data = impl->data + itor * step;
+    if (impl->pod) tb_memcpy(data, items, size * step);
+    // replace items
+    else
+    {
+        tb_byte_t const* p = (tb_byte_t const*)items;
+        tb_byte_t const* e = p + size * step;
+        for (; p < e; p += step, data += step) 
+            impl->element.repl(&impl->element, data, impl->element.data(&impl->element, p));
+    }
+}
 tb_void_t tb_vector_remove(tb_vector_ref_t vector, tb_size_t itor)
 {   
     // check
@@ -511,11 +687,14 @@ tb_void_t tb_vector_remove(tb_vector_ref_t vector, tb_size_t itor)
     if (impl->size)
     {
         // do free
-        if (impl->element.free) impl->element.free(&impl->element, impl->data + itor * impl->element.size);
+        if (!impl->pod && impl->element.free) impl->element.free(&impl->element, impl->data + itor * impl->element.size);
 
         // move data if itor is not last
         if (itor < impl->size - 1) tb_memmov(impl->data + itor * impl->element.size, impl->data + (itor + 1) * impl->element.size, (impl->size - itor - 1) * impl->element.size);
 
+        // clear the last item
+        if (impl->pod) tb_memset(impl->data + (impl->size - 1) * impl->element.size, 0, impl->element.size);
+
         // resize
         impl->size--;
     }
@@ -533,7 +712,8 @@ tb_void_t tb_vector_remove_last(tb_vector_ref_t vector)
     if (impl->size)
     {
         // do free
-        if (impl->element.free) impl->element.free(&impl->element, impl->data + (impl->size - 1) * impl->element.size);
+        if (impl->pod) tb_memset(impl->data + (impl->size - 1) * impl->element.size, 0, impl->element.size);
+        else if (impl->element.free) impl->element.free(&impl->element, impl->data + (impl->size - 1) * impl->element.size);
 
         // resize
         impl->size--;
@@ -559,7 +739,7 @@ tb_void_t tb_vector_nremove(tb_vector_ref_t vector, tb_size_t itor, tb_size_t si
     tb_size_t left = impl->size - itor - size;
 
     // free data
-    if (impl->element.nfree)
+    if (!impl->pod && impl->element.nfree)
         impl->element.nfree(&impl->element, impl->data + itor * impl->element.size, size);
 
     // move the left data
@@ -570,6 +750,9 @@ tb_void_t tb_vector_nremove(tb_vector_ref_t vector, tb_size_t itor, tb_size_t si
         tb_memmov(pd, ps, left * impl->element.size);
     }
 
+    // clear the removed items at the end
+    if (impl->pod) tb_memset(impl->data + (impl->size - size) * impl->element.size, 0, size * impl->element.size);
+
     // update size
     impl->size -= size;
 }
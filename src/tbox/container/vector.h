@@ -156,6 +156,23 @@ tb_pointer_t        tb_vector_last(tb_vector_ref_t vector);
  */
 tb_bool_t           tb_vector_resize(tb_vector_ref_t vector, tb_size_t size);
 
+/*! reserve the vector buffer for the given items count
+ *
+ * @param vector    the vector
+ * @param maxn      the items count
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_vector_reserve(tb_vector_ref_t vector, tb_size_t maxn);
+
+/*! shrink the vector buffer to fit the items
+ *
+ * @param vector    the vector
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_vector_shrink(tb_vector_ref_t vector);
+
 /*! clear the vector
  *
  * @param vector    the vector
@@ -235,6 +252,26 @@ tb_void_t           tb_vector_ninsert_head(tb_vector_ref_t vector, tb_cpointer_t
  */
 tb_void_t           tb_vector_ninsert_tail(tb_vector_ref_t vector, tb_cpointer_t data, tb_size_t size);
 
+/*! insert the vector prev items from the given item slots
+ *
+ * the slots are the contiguous items of this element, e.g. tb_uint32_t[] for tb_element_uint32(), tb_char_t*[] for tb_element_str(),
+ * they are copied directly if the element is the integer type, otherwise duplicated one by one.
+ *
+ * @param vector    the vector
+ * @param itor      the item itor
+ * @param items     the item slots
+ * @param size      the item count
+ */
+tb_void_t           tb_vector_insert_items(tb_vector_ref_t vector, tb_size_t itor, tb_cpointer_t items, tb_size_t size);
+
+/*! insert the vector tail items from the given item slots
+ *
+ * @param vector    the vector
+ * @param items     the item slots
+ * @param size      the item count
+ */
+tb_void_t           tb_vector_insert_tail_items(tb_vector_ref_t vector, tb_cpointer_t items, tb_size_t size);
+
 /*! replace the vector item
  *
  * @param vector    the vector
@@ -286,6 +323,15 @@ tb_void_t           tb_vector_nreplace_head(tb_vector_ref_t vector, tb_cpointer_
  */
 tb_void_t           tb_vector_nreplace_last(tb_vector_ref_t vector, tb_cpointer_t data, tb_size_t size);
 
+/*! replace the vector items from the given item slots
+ *
+ * @param vector    the vector
+ * @param itor      the item itor
+ * @param items     the item slots
+ * @param size      the item count
+ */
+tb_void_t           tb_vector_replace_items(tb_vector_ref_t vector, tb_size_t itor, tb_cpointer_t items, tb_size_t size);
+
 /*! remove the vector item
  *
  * @param vector    the vector
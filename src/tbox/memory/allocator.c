@@ -65,7 +65,7 @@ tb_pointer_t tb_allocator_malloc_(tb_allocator_ref_t allocator, tb_size_t size _
     tb_assert_and_check_return_val(allocator, tb_null);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_enter(&allocator->lock);
 
     // malloc it
     tb_pointer_t data = tb_null;
@@ -80,7 +80,7 @@ tb_pointer_t tb_allocator_malloc_(tb_allocator_ref_t allocator, tb_size_t size _
     tb_assertf(!(((tb_size_t)data) & (TB_POOL_DATA_ALIGN - 1)), "malloc(%lu): unaligned data: %p", size, data);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return data;
@@ -127,7 +127,7 @@ tb_pointer_t tb_allocator_ralloc_(tb_allocator_ref_t allocator, tb_pointer_t dat
     tb_assert_and_check_return_val(allocator, tb_null);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_enter(&allocator->lock);
 
     // ralloc it
     tb_pointer_t data_new = tb_null;
@@ -156,7 +156,7 @@ tb_pointer_t tb_allocator_ralloc_(tb_allocator_ref_t allocator, tb_pointer_t dat
     tb_assertf(!(((tb_size_t)data_new) & (TB_POOL_DATA_ALIGN - 1)), "ralloc(%lu): unaligned data: %p", size, data);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return data_new;
@@ -167,7 +167,7 @@ tb_bool_t tb_allocator_free_(tb_allocator_ref_t allocator, tb_pointer_t data __t
     tb_assert_and_check_return_val(allocator, tb_false);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_enter(&allocator->lock);
 
     // trace
     tb_trace_d("free(%p): at %s(): %d, %s", data __tb_debug_args__);
@@ -193,7 +193,7 @@ tb_bool_t tb_allocator_free_(tb_allocator_ref_t allocator, tb_pointer_t data __t
 #endif
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return ok;
@@ -204,7 +204,7 @@ tb_pointer_t tb_allocator_large_malloc_(tb_allocator_ref_t allocator, tb_size_t
     tb_assert_and_check_return_val(allocator, tb_null);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_enter(&allocator->lock);
 
     // malloc it
     tb_pointer_t data = tb_null;
@@ -225,7 +225,7 @@ tb_pointer_t tb_allocator_large_malloc_(tb_allocator_ref_t allocator, tb_size_t
     tb_assert(!real || *real >= size);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return data;
@@ -272,7 +272,7 @@ tb_pointer_t tb_allocator_large_ralloc_(tb_allocator_ref_t allocator, tb_pointer
     tb_assert_and_check_return_val(allocator, tb_null);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_enter(&allocator->lock);
 
     // ralloc it
     tb_pointer_t data_new = tb_null;
@@ -307,7 +307,7 @@ tb_pointer_t tb_allocator_large_ralloc_(tb_allocator_ref_t allocator, tb_pointer
     tb_assertf(!(((tb_size_t)data_new) & (TB_POOL_DATA_ALIGN - 1)), "ralloc(%lu): unaligned data: %p", size, data);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return data_new;
@@ -318,7 +318,7 @@ tb_bool_t tb_allocator_large_free_(tb_allocator_ref_t allocator, tb_pointer_t da
     tb_assert_and_check_return_val(allocator, tb_false);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_enter(&allocator->lock);
 
     // trace
     tb_trace_d("large_free(%p): at %s(): %d, %s", data __tb_debug_args__);
@@ -344,7 +344,7 @@ tb_bool_t tb_allocator_large_free_(tb_allocator_ref_t allocator, tb_pointer_t da
 #endif
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    if (!(allocator->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_leave(&allocator->lock);
 
     // ok?
     return ok;
@@ -81,12 +81,24 @@ typedef enum __tb_allocator_type_e
 
 }tb_allocator_type_e;
 
+/// the allocator flag enum
+typedef enum __tb_allocator_flag_e
+{
+    TB_ALLOCATOR_FLAG_NONE      = 0
+,   TB_ALLOCATOR_FLAG_NOLOCK    = 1     //!< the allocator is thread-safe itself and does not need the global lock
+,   TB_ALLOCATOR_FLAG_NOCACHE   = 2     //!< do not cache the small data for each thread, only for the default allocator
+
+}tb_allocator_flag_e;
+
 /// the allocator type
 typedef struct __tb_allocator_t
 {
     /// the type
     tb_size_t               type;
 
+    /// the flag
+    tb_size_t               flag;
+
     /// the lock
     tb_spinlock_t           lock;
 
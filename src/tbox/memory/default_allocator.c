@@ -36,6 +36,7 @@
 #include "large_allocator.h"
 #include "default_allocator.h"
 #include "impl/prefix.h"
+#include "impl/thread_cache.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -53,6 +54,11 @@ typedef struct __tb_default_allocator_t
     // the small allocator
     tb_allocator_ref_t      small_allocator;
 
+#ifdef TB_THREAD_CACHE_ENABLE
+    // the thread caches of the small allocator
+    tb_thread_caches_ref_t  thread_caches;
+#endif
+
 }tb_default_allocator_t, *tb_default_allocator_ref_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -67,6 +73,12 @@ static tb_void_t tb_default_allocator_exit(tb_allocator_ref_t self)
     // enter
     tb_spinlock_enter(&allocator->base.lock);
 
+#ifdef TB_THREAD_CACHE_ENABLE
+    // drain and detach the thread caches before exiting the small allocator
+    if (allocator->thread_caches) tb_thread_caches_exit(allocator->thread_caches);
+    allocator->thread_caches = tb_null;
+#endif
+
     // exit small allocator
     if (allocator->small_allocator) tb_allocator_exit(allocator->small_allocator);
     allocator->small_allocator = tb_null;
@@ -89,8 +101,20 @@ static tb_pointer_t tb_default_allocator_malloc(tb_allocator_ref_t self, tb_size
     // check
     tb_assert_and_check_return_val(allocator->large_allocator && allocator->small_allocator && size, tb_null);
 
-    // done
-    return size <= TB_SMALL_ALLOCATOR_DATA_MAXN? tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__) : tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
+    // large data?
+    if (size > TB_SMALL_ALLOCATOR_DATA_MAXN) return tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
+
+#ifdef TB_THREAD_CACHE_ENABLE
+    // malloc it from the thread cache first without the lock
+    if (allocator->thread_caches && !(allocator->base.flag & TB_ALLOCATOR_FLAG_NOCACHE))
+    {
+        tb_pointer_t data = tb_thread_cache_malloc(allocator->thread_caches, size);
+        if (data) return data;
+    }
+#endif
+
+    // malloc it from the small allocator
+    return tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__);
 }
 static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_pointer_t data, tb_size_t size __tb_debug_decl__)
 {
@@ -120,7 +144,17 @@ static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_poin
 
         // small => small
         if (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN && size <= TB_SMALL_ALLOCATOR_DATA_MAXN)
+        {
+#ifdef TB_THREAD_CACHE_ENABLE
+            // ralloc it from the thread cache first without the lock
+            if (allocator->thread_caches && !(allocator->base.flag & TB_ALLOCATOR_FLAG_NOCACHE))
+            {
+                data_new = tb_thread_cache_ralloc(allocator->thread_caches, data, size);
+                if (data_new) break;
+            }
+#endif
             data_new = tb_allocator_ralloc_(allocator->small_allocator, data, size __tb_debug_args__);
+        }
         // small => large
         else if (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN)
         {
@@ -172,8 +206,20 @@ static tb_bool_t tb_default_allocator_free(tb_allocator_ref_t self, tb_pointer_t
         tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
         tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "free invalid data: %p", data);
 
-        // free it
-        ok = (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN)? tb_allocator_free_(allocator->small_allocator, data __tb_debug_args__) : tb_allocator_large_free_(allocator->large_allocator, data __tb_debug_args__);
+        // free the large data
+        if (data_head->size > TB_SMALL_ALLOCATOR_DATA_MAXN)
+        {
+            ok = tb_allocator_large_free_(allocator->large_allocator, data __tb_debug_args__);
+            break;
+        }
+
+#ifdef TB_THREAD_CACHE_ENABLE
+        // free it to the thread cache first without the lock
+        if (allocator->thread_caches && !(allocator->base.flag & TB_ALLOCATOR_FLAG_NOCACHE) && (ok = tb_thread_cache_free(allocator->thread_caches, data))) break;
+#endif
+
+        // free it to the small allocator
+        ok = tb_allocator_free_(allocator->small_allocator, data __tb_debug_args__);
 
     } while (0);
 
@@ -319,6 +365,7 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
 
         // init base
         allocator->base.type            = TB_ALLOCATOR_DEFAULT;
+        allocator->base.flag            = TB_ALLOCATOR_FLAG_NOLOCK;
         allocator->base.malloc          = tb_default_allocator_malloc;
         allocator->base.ralloc          = tb_default_allocator_ralloc;
         allocator->base.free            = tb_default_allocator_free;
@@ -336,6 +383,11 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
         allocator->small_allocator = tb_small_allocator_init(large_allocator);
         tb_assert_and_check_break(allocator->small_allocator);
 
+#ifdef TB_THREAD_CACHE_ENABLE
+        // init the thread caches, the data will be allocated from the small allocator directly if failed
+        allocator->thread_caches = tb_thread_caches_init(allocator->small_allocator);
+#endif
+
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
         tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&allocator->base.lock, TB_TRACE_MODULE_NAME);
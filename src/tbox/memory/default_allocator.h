@@ -72,6 +72,11 @@ tb_allocator_ref_t          tb_default_allocator(tb_byte_t* data, tb_size_t size
  * |-----------------------------------------------------------------------------|
  * |                              default allocator                              |
  *  -----------------------------------------------------------------------------
+ *
+ * </pre>
+ *
+ * the default allocator does not enter the global lock because the large and small allocator are thread-safe,
+ * and the small data will be cached for each thread if the thread cache is enabled.
  * 
  * @param large_allocator   the large allocator, cannot be null
  *
@@ -0,0 +1,468 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        thread_cache.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "thread_cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "thread_cache.h"
+#include "../small_allocator.h"
+
+#ifdef TB_THREAD_CACHE_ENABLE
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bin count, same as the fixed pools of the small allocator
+#define TB_THREAD_CACHE_BIN_MAXN            (12)
+
+// the batch bytes for refilling and draining the bin
+#define TB_THREAD_CACHE_BATCH_BYTES         (8192)
+
+// the batch count minimum
+#define TB_THREAD_CACHE_BATCH_MINN          (4)
+
+// the batch count maximum
+#define TB_THREAD_CACHE_BATCH_MAXN          (32)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the thread cache bin type
+typedef struct __tb_thread_cache_bin_t
+{
+    // the free data list, the next data is stored at the head of the free data
+    tb_pointer_t                head;
+
+    // the free data count
+    tb_size_t                   size;
+
+}tb_thread_cache_bin_t;
+
+// the thread cache type
+typedef struct __tb_thread_cache_t
+{
+    // the list entry of the thread caches
+    tb_list_entry_t                 entry;
+
+    // the next cache of the current thread
+    struct __tb_thread_cache_t*     next;
+
+    // the thread caches, it will be null after the cache is detached from the exited allocator
+    struct __tb_thread_caches_t*    caches;
+
+    // the bins
+    tb_thread_cache_bin_t           bins[TB_THREAD_CACHE_BIN_MAXN];
+
+}tb_thread_cache_t, *tb_thread_cache_ref_t;
+
+// the thread caches type of the small allocator
+typedef struct __tb_thread_caches_t
+{
+    // the small allocator
+    tb_allocator_ref_t              allocator;
+
+    // the caches of all threads
+    tb_list_entry_head_t            list;
+
+}tb_thread_caches_t;
+
+// the thread cache list type of the current thread
+typedef struct __tb_thread_cache_list_t
+{
+    // the thread store base
+    tb_thread_store_data_t          base;
+
+    // the caches of the current thread, one cache for each allocator
+    tb_thread_cache_ref_t           head;
+
+}tb_thread_cache_list_t, *tb_thread_cache_list_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+/* the lock of all thread caches
+ *
+ * it protects the cache lists of the allocators and the attached allocator of each cache,
+ * because the thread and the allocator may be exited at the same time
+ */
+static tb_spinlock_t                g_lock = TB_SPINLOCK_INIT;
+
+// the bin space
+static tb_size_t const g_bin_space[TB_THREAD_CACHE_BIN_MAXN] = 
+{
+    16, 32, 64, 96, 128, 192, 256, 384, 512, 1024, 2048, 3072
+};
+
+// the bin index for 1 - 512B, indexed by (size - 1) >> 4
+static tb_byte_t const g_bin_index[32] = 
+{
+    0, 1, 2, 2, 3, 3, 4, 4
+,   5, 5, 5, 5, 6, 6, 6, 6
+,   7, 7, 7, 7, 7, 7, 7, 7
+,   8, 8, 8, 8, 8, 8, 8, 8
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_size_t tb_thread_cache_bin_index(tb_size_t size)
+{
+    // check
+    tb_assert(size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
+
+    // 1 - 512B?
+    if (size <= 512) return g_bin_index[(size - 1) >> 4];
+
+    // 513B - 3KB
+    return size <= 1024? 9 : (size <= 2048? 10 : 11);
+}
+static __tb_inline__ tb_size_t tb_thread_cache_bin_batch(tb_size_t index)
+{
+    // the batch count
+    tb_size_t batch = TB_THREAD_CACHE_BATCH_BYTES / g_bin_space[index];
+    return tb_max(tb_min(batch, TB_THREAD_CACHE_BATCH_MAXN), TB_THREAD_CACHE_BATCH_MINN);
+}
+static tb_void_t tb_thread_cache_bin_drain(tb_thread_cache_ref_t cache, tb_size_t index, tb_size_t count)
+{
+    // check
+    tb_allocator_ref_t allocator = cache->caches? cache->caches->allocator : tb_null;
+    tb_assert(allocator && allocator->free && index < TB_THREAD_CACHE_BIN_MAXN);
+
+    // the bin
+    tb_thread_cache_bin_t* bin = &cache->bins[index];
+    tb_check_return(bin->size && count);
+
+    // enter
+    tb_spinlock_enter(&allocator->lock);
+
+    // free data to the small allocator
+    while (bin->head && count--)
+    {
+        // pop it
+        tb_pointer_t data = bin->head;
+        bin->head = *((tb_pointer_t*)data);
+        bin->size--;
+
+        // free it
+        allocator->free(allocator, data);
+    }
+
+    // leave
+    tb_spinlock_leave(&allocator->lock);
+}
+static tb_bool_t tb_thread_cache_bin_refill(tb_thread_cache_ref_t cache, tb_size_t index)
+{
+    // check
+    tb_allocator_ref_t allocator = cache->caches? cache->caches->allocator : tb_null;
+    tb_assert(allocator && allocator->malloc && index < TB_THREAD_CACHE_BIN_MAXN);
+
+    // the bin
+    tb_thread_cache_bin_t* bin = &cache->bins[index];
+
+    // the space and batch count
+    tb_size_t space = g_bin_space[index];
+    tb_size_t count = tb_thread_cache_bin_batch(index);
+
+    // enter
+    tb_spinlock_enter(&allocator->lock);
+
+    // malloc data from the small allocator
+    while (count--)
+    {
+        // malloc it
+        tb_pointer_t data = allocator->malloc(allocator, space);
+        tb_check_break(data);
+
+        // push it
+        *((tb_pointer_t*)data) = bin->head;
+        bin->head = data;
+        bin->size++;
+    }
+
+    // leave
+    tb_spinlock_leave(&allocator->lock);
+
+    // ok?
+    return bin->head? tb_true : tb_false;
+}
+static tb_void_t tb_thread_cache_detach(tb_thread_cache_ref_t cache)
+{
+    // check
+    tb_assert(cache);
+
+    // attached?
+    tb_thread_caches_t* caches = cache->caches;
+    tb_check_return(caches);
+
+    // drain all bins to the small allocator
+    tb_size_t i = 0;
+    for (i = 0; i < TB_THREAD_CACHE_BIN_MAXN; i++)
+        tb_thread_cache_bin_drain(cache, i, cache->bins[i].size);
+
+    // remove it from the thread caches
+    tb_list_entry_remove(&caches->list, &cache->entry);
+
+    // detach it
+    cache->caches = tb_null;
+}
+static tb_void_t tb_thread_cache_list_exit(tb_thread_store_data_t* data)
+{
+    // check
+    tb_thread_cache_list_ref_t list = (tb_thread_cache_list_ref_t)data;
+    tb_assert_and_check_return(list);
+
+    // exit all caches of the current thread
+    while (list->head)
+    {
+        // the cache
+        tb_thread_cache_ref_t cache = list->head;
+        list->head = cache->next;
+
+        // detach it if the allocator has been not exited
+        tb_spinlock_enter(&g_lock);
+        tb_thread_cache_detach(cache);
+        tb_spinlock_leave(&g_lock);
+
+        // exit cache
+        tb_native_memory_free(cache);
+    }
+
+    // exit list
+    tb_native_memory_free(list);
+}
+static tb_thread_cache_list_ref_t tb_thread_cache_list(tb_bool_t make)
+{
+    // get the cache list of the current thread
+    tb_thread_cache_list_ref_t list = (tb_thread_cache_list_ref_t)tb_thread_store_getp_type(TB_THREAD_STORE_DATA_TYPE_ALLOCATOR);
+    if (!list && make)
+    {
+        /* make list
+         *
+         * @note uses the native memory because the allocator may be not inited now
+         */
+        list = (tb_thread_cache_list_ref_t)tb_native_memory_malloc0(sizeof(tb_thread_cache_list_t));
+        tb_assert_and_check_return_val(list, tb_null);
+
+        // init list
+        list->base.type = TB_THREAD_STORE_DATA_TYPE_ALLOCATOR;
+        list->base.free = tb_thread_cache_list_exit;
+
+        // save list, all caches will be drained when the thread exits
+        tb_thread_store_setp((tb_thread_store_data_t const*)list);
+
+        // the thread store has been not inited or exited? 
+        if (tb_thread_store_getp_type(TB_THREAD_STORE_DATA_TYPE_ALLOCATOR) != (tb_thread_store_data_ref_t)list)
+        {
+            tb_native_memory_free(list);
+            list = tb_null;
+        }
+    }
+
+    // ok?
+    return list;
+}
+static tb_thread_cache_ref_t tb_thread_cache_get(tb_thread_caches_t* caches, tb_bool_t make)
+{
+    // the cache list of the current thread
+    tb_thread_cache_list_ref_t list = tb_thread_cache_list(make);
+    tb_check_return_val(list, tb_null);
+
+    // find the cache of the given allocator, and the detached cache can be reused
+    tb_thread_cache_ref_t cache = list->head;
+    tb_thread_cache_ref_t cache_free = tb_null;
+    for (; cache && cache->caches != caches; cache = cache->next)
+        if (!cache->caches && !cache_free) cache_free = cache;
+    if (cache || !make) return cache;
+
+    // make cache if no detached cache
+    cache = cache_free;
+    if (!cache)
+    {
+        // make cache
+        cache = (tb_thread_cache_ref_t)tb_native_memory_malloc0(sizeof(tb_thread_cache_t));
+        tb_assert_and_check_return_val(cache, tb_null);
+
+        // save cache to the current thread
+        cache->next = list->head;
+        list->head  = cache;
+    }
+
+    // attach it to the thread caches of the allocator
+    tb_spinlock_enter(&g_lock);
+    tb_list_entry_insert_tail(&caches->list, &cache->entry);
+    cache->caches = caches;
+    tb_spinlock_leave(&g_lock);
+
+    // ok
+    return cache;
+}
+static __tb_inline__ tb_pointer_t tb_thread_cache_pop(tb_thread_cache_ref_t cache, tb_size_t size)
+{
+    // the bin
+    tb_size_t               index = tb_thread_cache_bin_index(size);
+    tb_thread_cache_bin_t*  bin = &cache->bins[index];
+
+    // refill it if be empty
+    if (!bin->head && !tb_thread_cache_bin_refill(cache, index)) return tb_null;
+
+    // pop it
+    tb_pointer_t data = bin->head;
+    bin->head = *((tb_pointer_t*)data);
+    bin->size--;
+
+    // update size
+    (((tb_pool_data_head_t*)data)[-1]).size = size;
+
+    // ok
+    return data;
+}
+static __tb_inline__ tb_void_t tb_thread_cache_push(tb_thread_cache_ref_t cache, tb_pointer_t data)
+{
+    // the bin
+    tb_size_t               index = tb_thread_cache_bin_index((((tb_pool_data_head_t*)data)[-1]).size);
+    tb_thread_cache_bin_t*  bin = &cache->bins[index];
+
+    // push it
+    *((tb_pointer_t*)data) = bin->head;
+    bin->head = data;
+    bin->size++;
+
+    // drain a batch if too many
+    tb_size_t batch = tb_thread_cache_bin_batch(index);
+    if (bin->size > (batch << 1)) tb_thread_cache_bin_drain(cache, index, batch);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_thread_caches_ref_t tb_thread_caches_init(tb_allocator_ref_t allocator)
+{
+    // check
+    tb_assert_and_check_return_val(allocator, tb_null);
+
+    /* make caches
+     *
+     * @note uses the native memory because the caches may be detached after the allocator is exited
+     */
+    tb_thread_caches_t* caches = (tb_thread_caches_t*)tb_native_memory_malloc0(sizeof(tb_thread_caches_t));
+    tb_assert_and_check_return_val(caches, tb_null);
+
+    // init caches
+    caches->allocator = allocator;
+    tb_list_entry_init(&caches->list, tb_thread_cache_t, entry, tb_null);
+
+    // ok
+    return (tb_thread_caches_ref_t)caches;
+}
+tb_void_t tb_thread_caches_exit(tb_thread_caches_ref_t self)
+{
+    // check
+    tb_thread_caches_t* caches = (tb_thread_caches_t*)self;
+    tb_assert_and_check_return(caches);
+
+    // enter
+    tb_spinlock_enter(&g_lock);
+
+    /* drain and detach the caches of all threads
+     *
+     * the detached caches will be freed or reused by their threads later
+     */
+    while (tb_list_entry_size(&caches->list))
+        tb_thread_cache_detach((tb_thread_cache_ref_t)tb_list_entry(&caches->list, tb_list_entry_head(&caches->list)));
+
+    // leave
+    tb_spinlock_leave(&g_lock);
+
+    // exit caches
+    tb_list_entry_exit(&caches->list);
+    tb_native_memory_free(caches);
+}
+tb_pointer_t tb_thread_cache_malloc(tb_thread_caches_ref_t caches, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(caches && size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN, tb_null);
+
+    // the cache
+    tb_thread_cache_ref_t cache = tb_thread_cache_get((tb_thread_caches_t*)caches, tb_true);
+    tb_check_return_val(cache, tb_null);
+
+    // pop it
+    return tb_thread_cache_pop(cache, size);
+}
+tb_pointer_t tb_thread_cache_ralloc(tb_thread_caches_ref_t caches, tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(caches && data && size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN, tb_null);
+
+    // the cache
+    tb_thread_cache_ref_t cache = tb_thread_cache_get((tb_thread_caches_t*)caches, tb_true);
+    tb_check_return_val(cache, tb_null);
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assert_and_check_return_val(data_head->size && data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN, tb_null);
+
+    // same space? only update size
+    if (tb_thread_cache_bin_index(data_head->size) == tb_thread_cache_bin_index(size))
+    {
+        data_head->size = size;
+        return data;
+    }
+
+    // make the new data
+    tb_pointer_t data_new = tb_thread_cache_pop(cache, size);
+    tb_check_return_val(data_new, tb_null);
+
+    // copy the old data
+    tb_memcpy_(data_new, data, tb_min(data_head->size, size));
+
+    // free the old data
+    tb_thread_cache_push(cache, data);
+
+    // ok
+    return data_new;
+}
+tb_bool_t tb_thread_cache_free(tb_thread_caches_ref_t caches, tb_pointer_t data)
+{
+    // check
+    tb_assert_and_check_return_val(caches && data, tb_false);
+
+    // the cache, do not make it for freeing data
+    tb_thread_cache_ref_t cache = tb_thread_cache_get((tb_thread_caches_t*)caches, tb_false);
+    tb_check_return_val(cache, tb_false);
+
+    // push it
+    tb_thread_cache_push(cache, data);
+
+    // ok
+    return tb_true;
+}
+#endif
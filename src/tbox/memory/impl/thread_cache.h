@@ -0,0 +1,137 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        thread_cache.h
+ *
+ */
+#ifndef TB_MEMORY_IMPL_THREAD_CACHE_H
+#define TB_MEMORY_IMPL_THREAD_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* enable the thread cache?
+ *
+ * it requires the native thread store and is disabled for the debug mode 
+ * because the cached data cannot be checked by the fixed pool
+ */
+#if defined(TB_CONFIG_MEMORY_HAVE_THREAD_CACHE) \
+    && defined(TB_CONFIG_MODULE_HAVE_THREAD) \
+    && defined(TB_THREAD_STORE_HAVE_NATIVE) \
+    && !defined(__tb_debug__)
+#   define TB_THREAD_CACHE_ENABLE
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+#ifdef TB_THREAD_CACHE_ENABLE
+
+// the thread caches ref type of the small allocator
+typedef struct{}*       tb_thread_caches_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the thread caches of the small allocator
+ *
+ * each thread makes its own cache for this allocator when it mallocs data at the first time,
+ * and all caches are kept here, so they can be drained and detached before the allocator is exited
+ *
+ * @param allocator     the small allocator
+ *
+ * @return              the thread caches
+ */
+tb_thread_caches_ref_t  tb_thread_caches_init(tb_allocator_ref_t allocator);
+
+/* exit the thread caches 
+ *
+ * @note the cached data of all threads will be drained to the small allocator and their caches will be detached,
+ * so it must be called before exiting the small allocator
+ *
+ * @param caches        the thread caches
+ */
+tb_void_t               tb_thread_caches_exit(tb_thread_caches_ref_t caches);
+
+/* malloc the small data from the cache of the current thread
+ *
+ * <pre>
+ *
+ *  thread0             thread1             threadN
+ *  ------------        ------------        ------------
+ * | 16B: o-o-o |      | 16B: o-o   |      | 16B:       |
+ * | 32B: o     |      | 32B: o-o-o |      | 32B: o-o   |
+ * | ...        |      | ...        |      | ...        |
+ *  ------------        ------------        ------------
+ *       |                   |                   |
+ *       | refill and drain in batches with the lock
+ *       |                   |                   |
+ *  ------------------------------------------------------
+ * |                   small allocator                    |
+ *  ------------------------------------------------------
+ *
+ * </pre>
+ *
+ * @param caches        the thread caches
+ * @param size          the data size, must be <= TB_SMALL_ALLOCATOR_DATA_MAXN
+ *
+ * @return              the data address, return tb_null if the thread cache is not available
+ */
+tb_pointer_t            tb_thread_cache_malloc(tb_thread_caches_ref_t caches, tb_size_t size);
+
+/* realloc the small data from the cache of the current thread
+ *
+ * @param caches        the thread caches
+ * @param data          the data address
+ * @param size          the data size, must be <= TB_SMALL_ALLOCATOR_DATA_MAXN
+ *
+ * @return              the new data address, return tb_null if the thread cache is not available
+ */
+tb_pointer_t            tb_thread_cache_ralloc(tb_thread_caches_ref_t caches, tb_pointer_t data, tb_size_t size);
+
+/* free the small data to the cache of the current thread
+ *
+ * @param caches        the thread caches
+ * @param data          the data address
+ *
+ * @return              tb_true or tb_false if the thread cache is not available
+ */
+tb_bool_t               tb_thread_cache_free(tb_thread_caches_ref_t caches, tb_pointer_t data);
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -55,24 +55,41 @@
 typedef struct __tb_dns_cache_t
 {
     // the hash
-    tb_hash_map_ref_t       hash;
+    tb_concurrent_hash_map_ref_t    hash;
 
-    // the times
-    tb_hize_t               times;
+}tb_dns_cache_t;
+
+// the dns cache stat type, uses the individual cache line for the frequently updated counters
+typedef __tb_cacheline_aligned__ struct __tb_dns_cache_stat_impl_t
+{
+    // the hit count
+    tb_atomic_t                     hits;
 
-    // the expired
-    tb_size_t               expired;
+    // the miss count
+    tb_atomic_t                     misses;
 
-}tb_dns_cache_t;
+    // the expired count
+    tb_atomic_t                     expired;
+
+    // the hit count of the failed host names
+    tb_atomic_t                     failed;
+
+    // the evicted count
+    tb_atomic_t                     evicted;
+
+}__tb_cacheline_aligned__ tb_dns_cache_stat_impl_t;
 
 // the dns cache addr type
 typedef struct __tb_dns_cache_addr_t
 {
-    // the addr
-    tb_ipaddr_t             addr;
+    // the addr, empty if this host name is failed
+    tb_ipaddr_t                     addr;
 
-    // the time
-    tb_size_t               time;
+    // the last accessed time, it will be updated by the readers
+    tb_atomic_t                     time;
+
+    // the expired time
+    tb_size_t                       expired;
 
 }tb_dns_cache_addr_t;
 
@@ -80,45 +97,160 @@ typedef struct __tb_dns_cache_addr_t
  * globals
  */
 
-// the lock
-static tb_spinlock_t        g_lock = TB_SPINLOCK_INIT;
+// the lock for initializing and evicting
+static tb_spinlock_t                g_lock = TB_SPINLOCK_INIT;
 
 // the cache
-static tb_dns_cache_t       g_cache = {0};
+static tb_dns_cache_t               g_cache = {0};
+
+// the stat
+static tb_dns_cache_stat_impl_t     g_stat = {0};
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * helper
  */
 static __tb_inline__ tb_size_t tb_dns_cache_now()
 {
-    return (tb_size_t)(tb_cache_time_spak() / 1000);
+    /* the cached time is only updated by the timer, the aicp loop and the cache setter,
+     * so it may be never updated if the process only looks up the cached addresses.
+     *
+     * we get the current time for each lookup and only update the shared time if it is older than one second,
+     * so the lookups need not write the shared time frequently and the expired addresses will also be evicted.
+     *
+     * @note the saved addresses use the cached time, so we must get the same wall clock here and not tb_mclock()
+     */
+    tb_timeval_t tv = {0};
+    if (!tb_gettimeofday(&tv, tb_null)) return (tb_size_t)tb_cache_time();
+
+    // update the shared time if it is older than one second
+    tb_hong_t now = ((tb_hong_t)tv.tv_sec * 1000 + tv.tv_usec / 1000);
+    if (now >= tb_cache_time_mclock() + 1000) tb_cache_time_spak();
+    return (tb_size_t)(now / 1000);
+}
+static tb_void_t tb_dns_cache_find_func(tb_pointer_t name, tb_pointer_t data, tb_cpointer_t priv)
+{
+    // check
+    tb_dns_cache_addr_t*    caddr = (tb_dns_cache_addr_t*)data;
+    tb_dns_cache_addr_t*    result = (tb_dns_cache_addr_t*)priv;
+    tb_assert(caddr && result);
+
+    // update the accessed time, we need not write it again in the same second
+    tb_size_t now = (tb_size_t)result->time;
+    if ((tb_size_t)tb_atomic_get(&caddr->time) != now) tb_atomic_set(&caddr->time, now);
+
+    // save result, we need copy the whole address, because tb_ipaddr_copy does not clear the empty address
+    result->addr    = caddr->addr;
+    result->expired = caddr->expired;
 }
-static tb_bool_t tb_dns_cache_clear(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+static tb_bool_t tb_dns_cache_find(tb_char_t const* name, tb_dns_cache_addr_t* caddr)
 {
     // check
-    tb_assert(item);
+    tb_assert_and_check_return_val(g_cache.hash, tb_false);
 
-    // the dns cache address
-    tb_dns_cache_addr_t const* caddr = (tb_dns_cache_addr_t const*)((tb_hash_map_item_ref_t)item)->data;
+    // find it under the read lock of the shard
+    caddr->time = (tb_atomic_t)tb_dns_cache_now();
+    return tb_concurrent_hash_map_find(g_cache.hash, name, tb_dns_cache_find_func, caddr);
+}
+static tb_bool_t tb_dns_cache_pred_expired(tb_pointer_t name, tb_pointer_t data, tb_cpointer_t priv)
+{
+    // check
+    tb_dns_cache_addr_t const* caddr = (tb_dns_cache_addr_t const*)data;
     tb_assert(caddr);
 
     // is expired?
-    tb_bool_t ok = tb_false;
-    if (caddr->time < g_cache.expired)
+    tb_bool_t ok = ((tb_size_t)priv >= caddr->expired);
+
+    // trace
+    if (ok) tb_trace_d("del: %s => %{ipaddr}, expired: %lu", (tb_char_t const*)name, &caddr->addr, caddr->expired);
+
+    // ok?
+    return ok;
+}
+static tb_bool_t tb_dns_cache_pred_times(tb_pointer_t name, tb_pointer_t data, tb_cpointer_t priv)
+{
+    // check
+    tb_dns_cache_addr_t const*  caddr = (tb_dns_cache_addr_t const*)data;
+    tb_hize_t*                  times = (tb_hize_t*)priv;
+    tb_assert(caddr && times);
+
+    // sum the accessed times
+    *times += (tb_size_t)tb_atomic_get(&caddr->time);
+
+    // only walk it
+    return tb_false;
+}
+static tb_bool_t tb_dns_cache_pred_older(tb_pointer_t name, tb_pointer_t data, tb_cpointer_t priv)
+{
+    // check
+    tb_dns_cache_addr_t const* caddr = (tb_dns_cache_addr_t const*)data;
+    tb_assert(caddr);
+
+    // is older than the average accessed time?
+    tb_bool_t ok = ((tb_size_t)tb_atomic_get(&caddr->time) < (tb_size_t)priv);
+
+    // trace
+    if (ok) tb_trace_d("del: %s => %{ipaddr}, time: %lu", (tb_char_t const*)name, &caddr->addr, (tb_size_t)tb_atomic_get(&caddr->time));
+
+    // ok?
+    return ok;
+}
+static tb_void_t tb_dns_cache_evict(tb_size_t now)
+{
+    /* only one thread is evicting the items, 
+     * and the others will insert the new items directly, the cache maxn may be exceeded temporarily
+     */
+    tb_check_return(tb_spinlock_enter_try(&g_lock));
+
+    // remove the expired items first
+    tb_size_t removed = tb_concurrent_hash_map_remove_if(g_cache.hash, tb_dns_cache_pred_expired, tb_u2p(now));
+
+    // remove the items older than the average accessed time if be still full
+    tb_size_t size = tb_concurrent_hash_map_size(g_cache.hash);
+    if (size >= TB_DNS_CACHE_MAXN)
     {
-        // remove it
-        ok = tb_true;
+        // the accessed times
+        tb_hize_t times = 0;
+        tb_concurrent_hash_map_remove_if(g_cache.hash, tb_dns_cache_pred_times, &times);
+
+        // the older time
+        tb_size_t older = (tb_size_t)(times / size) + 1;
 
         // trace
-        tb_trace_d("del: %s => %{ipaddr}, time: %u, size: %u", (tb_char_t const*)item->name, &caddr->addr, caddr->time, tb_hash_map_size(g_cache.hash));
+        tb_trace_d("older: %lu", older);
 
-        // update times
-        tb_assert(g_cache.times >= caddr->time);
-        g_cache.times -= caddr->time;
+        // remove the older items
+        removed += tb_concurrent_hash_map_remove_if(g_cache.hash, tb_dns_cache_pred_older, tb_u2p(older));
     }
 
-    // ok?
-    return ok;
+    // update the evicted count
+    if (removed) tb_atomic_fetch_and_add(&g_stat.evicted, removed);
+
+    // leave
+    tb_spinlock_leave(&g_lock);
+}
+static tb_void_t tb_dns_cache_save(tb_char_t const* name, tb_ipaddr_ref_t addr, tb_size_t ttl)
+{
+    // check
+    tb_assert_and_check_return(g_cache.hash);
+
+    // update the cached time
+    tb_size_t now = (tb_size_t)(tb_cache_time_spak() / 1000);
+
+    // init addr
+    tb_dns_cache_addr_t caddr;
+    caddr.time      = (tb_atomic_t)now;
+    caddr.expired   = now + ttl;
+    if (addr) tb_ipaddr_copy(&caddr.addr, addr);
+    else tb_ipaddr_clear(&caddr.addr);
+
+    // remove the expired items if full
+    if (tb_concurrent_hash_map_size(g_cache.hash) >= TB_DNS_CACHE_MAXN) tb_dns_cache_evict(now);
+
+    // save addr
+    tb_concurrent_hash_map_insert(g_cache.hash, name, &caddr);
+
+    // trace
+    tb_trace_d("set: %s => %{ipaddr}, ttl: %lu, size: %lu", name, &caddr.addr, ttl, tb_concurrent_hash_map_size(g_cache.hash));
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -134,7 +266,7 @@ tb_bool_t tb_dns_cache_init()
     do
     {
         // init hash
-        if (!g_cache.hash) g_cache.hash = tb_hash_map_init(tb_align8(tb_isqrti(TB_DNS_CACHE_MAXN) + 1), tb_element_str(tb_false), tb_element_mem(sizeof(tb_dns_cache_addr_t), tb_null, tb_null));
+        if (!g_cache.hash) g_cache.hash = tb_concurrent_hash_map_init(0, TB_DNS_CACHE_MAXN, tb_element_str(tb_false), tb_element_mem(sizeof(tb_dns_cache_addr_t), tb_null, tb_null));
         tb_assert_and_check_break(g_cache.hash);
 
         // ok
@@ -157,14 +289,11 @@ tb_void_t tb_dns_cache_exit()
     tb_spinlock_enter(&g_lock);
 
     // exit hash
-    if (g_cache.hash) tb_hash_map_exit(g_cache.hash);
+    if (g_cache.hash) tb_concurrent_hash_map_exit(g_cache.hash);
     g_cache.hash = tb_null;
 
-    // exit times
-    g_cache.times = 0;
-
-    // exit expired 
-    g_cache.expired = 0;
+    // exit stat
+    tb_memset(&g_stat, 0, sizeof(g_stat));
 
     // leave
     tb_spinlock_leave(&g_lock);
@@ -193,44 +322,50 @@ tb_bool_t tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr)
     // clear address
     tb_ipaddr_clear(addr);
 
-    // enter
-    tb_spinlock_enter(&g_lock);
-
     // done
     tb_bool_t ok = tb_false;
     do
     {
-        // check
-        tb_assert_and_check_break(g_cache.hash);
-
         // get the host address
-        tb_dns_cache_addr_t* caddr = (tb_dns_cache_addr_t*)tb_hash_map_get(g_cache.hash, name);
-        tb_check_break(caddr);
+        tb_dns_cache_addr_t caddr;
+        if (!tb_dns_cache_find(name, &caddr)) break;
 
         // trace
-        tb_trace_d("get: %s => %{ipaddr}, time: %u => %u, size: %u", name, &caddr->addr, caddr->time, tb_dns_cache_now(), tb_hash_map_size(g_cache.hash));
+        tb_trace_d("get: %s => %{ipaddr}, time: %lu, expired: %lu", name, &caddr.addr, (tb_size_t)caddr.time, caddr.expired);
 
-        // update time
-        tb_assert_and_check_break(g_cache.times >= caddr->time);
-        g_cache.times -= caddr->time;
-        caddr->time = tb_dns_cache_now();
-        g_cache.times += caddr->time;
+        // expired? it will be evicted or replaced later
+        if ((tb_size_t)caddr.time >= caddr.expired) 
+        {
+            tb_atomic_fetch_and_inc(&g_stat.expired);
+            break;
+        }
+
+        // failed host name?
+        if (tb_ipaddr_ip_is_empty(&caddr.addr)) 
+        {
+            tb_atomic_fetch_and_inc(&g_stat.failed);
+            break;
+        }
 
         // save address
-        tb_ipaddr_copy(addr, &caddr->addr);
+        tb_ipaddr_copy(addr, &caddr.addr);
 
         // ok
         ok = tb_true;
 
     } while (0);
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+    // update the stat
+    tb_atomic_fetch_and_inc(ok? &g_stat.hits : &g_stat.misses);
 
     // ok?
     return ok;
 }
 tb_void_t tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr)
+{
+    tb_dns_cache_set_ttl(name, addr, 0);
+}
+tb_void_t tb_dns_cache_set_ttl(tb_char_t const* name, tb_ipaddr_ref_t addr, tb_size_t ttl)
 {
     // check
     tb_assert_and_check_return(name && addr);
@@ -239,52 +374,49 @@ tb_void_t tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr)
     tb_assert(!tb_ipaddr_ip_is_empty(addr));
 
     // trace
-    tb_trace_d("set: %s => %{ipaddr}", name, addr);
-
-    // init addr
-    tb_dns_cache_addr_t caddr;
-    caddr.time = tb_dns_cache_now();
-    tb_ipaddr_copy(&caddr.addr, addr);
-
-    // enter
-    tb_spinlock_enter(&g_lock);
+    tb_trace_d("set: %s => %{ipaddr}, ttl: %lu", name, addr, ttl);
 
-    // done
-    do
-    {
-        // check
-        tb_assert_and_check_break(g_cache.hash);
-
-        // remove the expired items if full
-        if (tb_hash_map_size(g_cache.hash) >= TB_DNS_CACHE_MAXN)
-        {
-            // the expired time
-            g_cache.expired = ((tb_size_t)(g_cache.times / tb_hash_map_size(g_cache.hash)) + 1);
-
-            // check
-            tb_assert_and_check_break(g_cache.expired);
-
-            // trace
-            tb_trace_d("expired: %lu", g_cache.expired);
-
-            // remove the expired times
-            tb_remove_if(g_cache.hash, tb_dns_cache_clear, tb_null);
-        }
-
-        // check
-        tb_assert_and_check_break(tb_hash_map_size(g_cache.hash) < TB_DNS_CACHE_MAXN);
-
-        // save addr
-        tb_hash_map_insert(g_cache.hash, name, &caddr);
+    // save it
+    tb_dns_cache_save(name, addr, ttl? ttl : TB_DNS_CACHE_TTL_DEFAULT);
+}
+tb_void_t tb_dns_cache_set_failed(tb_char_t const* name, tb_size_t ttl)
+{
+    // check
+    tb_assert_and_check_return(name);
 
-        // update times
-        g_cache.times += caddr.time;
+    // trace
+    tb_trace_d("failed: %s, ttl: %lu", name, ttl);
 
-        // trace
-        tb_trace_d("set: %s => %{ipaddr}, time: %u, size: %u", name, &caddr.addr, caddr.time, tb_hash_map_size(g_cache.hash));
+    // save it
+    tb_dns_cache_save(name, tb_null, ttl? ttl : TB_DNS_CACHE_TTL_FAILED);
+}
+tb_bool_t tb_dns_cache_failed(tb_char_t const* name)
+{
+    // check
+    tb_assert_and_check_return_val(name, tb_false);
 
-    } while (0);
+    // find it
+    tb_dns_cache_addr_t caddr;
+    if (!tb_dns_cache_find(name, &caddr)) return tb_false;
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+    // is failed and not expired?
+    return tb_ipaddr_ip_is_empty(&caddr.addr) && (tb_size_t)caddr.time < caddr.expired;
+}
+tb_void_t tb_dns_cache_stat(tb_dns_cache_stat_ref_t stat)
+{
+    // check
+    tb_assert_and_check_return(stat);
+
+    // init stat, it is only a snapshot
+    stat->hits          = (tb_size_t)tb_atomic_get(&g_stat.hits);
+    stat->misses        = (tb_size_t)tb_atomic_get(&g_stat.misses);
+    stat->expired       = (tb_size_t)tb_atomic_get(&g_stat.expired);
+    stat->failed        = (tb_size_t)tb_atomic_get(&g_stat.failed);
+    stat->evicted       = (tb_size_t)tb_atomic_get(&g_stat.evicted);
+    stat->contention    = g_cache.hash? tb_concurrent_hash_map_contention(g_cache.hash) : 0;
+    stat->size          = g_cache.hash? tb_concurrent_hash_map_size(g_cache.hash) : 0;
+
+    // the hit rate
+    tb_hize_t total = (tb_hize_t)stat->hits + stat->misses;
+    stat->hit_rate      = total? (tb_size_t)(((tb_hize_t)stat->hits * 10000) / total) : 0;
 }
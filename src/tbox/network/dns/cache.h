@@ -29,6 +29,49 @@
  */
 #include "prefix.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default ttl of the cached address, seconds
+#define TB_DNS_CACHE_TTL_DEFAULT            (300)
+
+// the default ttl of the failed host name, seconds
+#define TB_DNS_CACHE_TTL_FAILED             (10)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the dns cache stat type
+typedef struct __tb_dns_cache_stat_t
+{
+    /// the hit count
+    tb_size_t               hits;
+
+    /// the miss count, includes the expired and failed host names
+    tb_size_t               misses;
+
+    /// the expired count
+    tb_size_t               expired;
+
+    /// the hit count of the failed host names
+    tb_size_t               failed;
+
+    /// the evicted count
+    tb_size_t               evicted;
+
+    /// the lock contention count
+    tb_size_t               contention;
+
+    /// the hit rate, 10000: 100%
+    tb_size_t               hit_rate;
+
+    /// the cached item count
+    tb_size_t               size;
+
+}tb_dns_cache_stat_t, *tb_dns_cache_stat_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -37,6 +80,9 @@
  *
  * not using ctime default
  *
+ * @note the lookups are lock-free between the different shards and only share the read lock in the same shard,
+ * the expired time is driven by tb_cache_time
+ *
  * @return          tb_true or tb_false
  */
 tb_bool_t           tb_dns_cache_init(tb_noarg_t);
@@ -49,15 +95,46 @@ tb_void_t           tb_dns_cache_exit(tb_noarg_t);
  * @param name      the host name 
  * @param addr      the host addr
  *
- * @return          tb_true or tb_false
+ * @return          tb_true or tb_false if not found, expired or failed
  */
 tb_bool_t           tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr);
 
-/*! set addr to cache 
+/*! set addr to cache with the default ttl
  *
  * @param name      the host name 
  * @param addr      the host addr
  */
 tb_void_t           tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr);
 
+/*! set addr to cache with the given ttl
+ *
+ * @param name      the host name 
+ * @param addr      the host addr
+ * @param ttl       the ttl (seconds), using the default ttl if be zero
+ */
+tb_void_t           tb_dns_cache_set_ttl(tb_char_t const* name, tb_ipaddr_ref_t addr, tb_size_t ttl);
+
+/*! mark the host name as failed (negative caching)
+ *
+ * the lookups of this host name will fail fast until it is expired
+ *
+ * @param name      the host name 
+ * @param ttl       the ttl (seconds), using TB_DNS_CACHE_TTL_FAILED if be zero
+ */
+tb_void_t           tb_dns_cache_set_failed(tb_char_t const* name, tb_size_t ttl);
+
+/*! is this host name failed recently?
+ *
+ * @param name      the host name 
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_dns_cache_failed(tb_char_t const* name);
+
+/*! get the cache stat
+ *
+ * @param stat      the stat
+ */
+tb_void_t           tb_dns_cache_stat(tb_dns_cache_stat_ref_t stat);
+
 #endif
@@ -94,6 +94,9 @@ typedef struct __tb_dns_looker_impl_t
     // the server maxn
     tb_size_t               maxn;
 
+    // the ttl of the found address
+    tb_size_t               ttl;
+
     // the data
     tb_byte_t               data[TB_DNS_NAME_MAXN + TB_DNS_RPKT_MAXN];
 
@@ -365,6 +368,9 @@ static tb_bool_t tb_dns_looker_resp_done(tb_dns_looker_impl_t* impl, tb_ipaddr_r
                     tb_ipaddr_ipv4_set(addr, &ipv4);
                 }
 
+                // save ttl
+                impl->ttl = answer.res.ttl;
+
                 // found it
                 found = 1;
 
@@ -516,7 +522,7 @@ static tb_long_t tb_dns_looker_resp(tb_dns_looker_impl_t* impl, tb_ipaddr_ref_t
     tb_assert_and_check_return_val(tb_static_string_size(&impl->name) && !tb_ipaddr_ip_is_empty(addr), -1);
 
     // save address to cache
-    tb_dns_cache_set(tb_static_string_cstr(&impl->name), addr);
+    tb_dns_cache_set_ttl(tb_static_string_cstr(&impl->name), addr, impl->ttl);
 
     // finish it
     impl->step |= TB_DNS_LOOKER_STEP_RESP;
@@ -686,6 +692,9 @@ tb_bool_t tb_dns_looker_done(tb_char_t const* name, tb_ipaddr_ref_t addr)
     // try to lookup it from cache first
     if (tb_dns_cache_get(name, addr)) return tb_true;
 
+    // failed recently? fail fast
+    if (tb_dns_cache_failed(name)) return tb_false;
+
     // init looker
     tb_dns_looker_ref_t looker = tb_dns_looker_init(name);
     tb_check_return_val(looker, tb_false);
@@ -702,6 +711,9 @@ tb_bool_t tb_dns_looker_done(tb_char_t const* name, tb_ipaddr_ref_t addr)
     // exit
     tb_dns_looker_exit(looker);
 
+    // failed? cache it for a while
+    if (r <= 0) tb_dns_cache_set_failed(name, 0);
+
     // ok
     return r > 0? tb_true : tb_false;
 }
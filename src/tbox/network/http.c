@@ -36,6 +36,7 @@
 #include "impl/http/option.h"
 #include "impl/http/status.h"
 #include "impl/http/method.h"
+#include "impl/http/pool.h"
 #include "../zip/zip.h"
 #include "../libc/libc.h"
 #include "../math/math.h"
@@ -77,6 +78,15 @@ typedef struct __tb_http_impl_t
     // is opened?
     tb_bool_t           bopened;
 
+    // is the reused alived connection?
+    tb_bool_t           breused;
+
+    // has been responded?
+    tb_bool_t           bresponded;
+
+    // the content offset of the sstream
+    tb_hize_t           content_offset;
+
     // the request data
     tb_string_t         request;
 
@@ -88,7 +98,137 @@ typedef struct __tb_http_impl_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-static tb_bool_t tb_http_connect(tb_http_impl_t* impl)
+static tb_void_t tb_http_sstream_exit(tb_handle_t stream)
+{
+    // exit the alived sock stream
+    if (stream) tb_stream_exit((tb_stream_ref_t)stream);
+}
+static tb_void_t tb_http_sstream_set(tb_http_impl_t* impl, tb_stream_ref_t sstream)
+{
+    // check
+    tb_assert_and_check_return(impl && sstream);
+
+    // exit the old sock stream
+    if (impl->sstream) tb_stream_exit(impl->sstream);
+
+    // switch to the new sock stream
+    impl->stream = impl->sstream = sstream;
+
+    // the filter streams cannot refer to the old sock stream
+    if (impl->cstream) tb_stream_ctrl(impl->cstream, TB_STREAM_CTRL_FLTR_SET_STREAM, sstream);
+    if (impl->zstream) tb_stream_ctrl(impl->zstream, TB_STREAM_CTRL_FLTR_SET_STREAM, sstream);
+}
+static tb_void_t tb_http_alive_check(tb_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->sstream);
+
+    // alived and opened?
+    tb_check_return(impl->status.balived && tb_stream_is_opened(impl->sstream));
+
+    // the whole content have been read? the connection can be reused
+    tb_bool_t finished = tb_false;
+    if (!tb_stream_is_killed(impl->sstream) && impl->content_offset)
+    {
+        // chunked? the end chunk have been read
+        if (impl->status.bchunked)
+        {
+            tb_stream_filter_ref_t filter = tb_null;
+            if (    impl->cstream
+                &&  tb_stream_is_opened(impl->cstream)
+                &&  tb_stream_ctrl(impl->cstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter) && filter)
+                finished = tb_stream_filter_beof(filter);
+        }
+        // the content size is known?
+        else if (impl->status.content_size >= 0)
+            finished = tb_stream_offset(impl->sstream) >= impl->content_offset + impl->status.content_size;
+    }
+
+    // not finished? close the connection
+    if (!finished)
+    {
+        impl->status.balived = 0;
+        tb_stream_ctrl(impl->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+    }
+}
+static tb_void_t tb_http_alive_save(tb_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->sstream);
+
+    // alived and closed?
+    tb_check_return(impl->status.balived && tb_stream_is_closed(impl->sstream));
+
+    // the alived sock stream will be taken away
+    impl->status.balived = 0;
+
+    // init a new sock stream for the next connection
+    tb_stream_ref_t sstream = tb_stream_init_sock();
+    tb_assert_and_check_return(sstream);
+
+    // put the alived sock stream to the pool, it will be closed if failed
+    tb_stream_ref_t alived = impl->sstream;
+    impl->sstream = tb_null;
+    if (!tb_http_pool_put(tb_null, tb_stream_url(alived), alived, tb_http_sstream_exit))
+        tb_stream_exit(alived);
+
+    // switch to the new sock stream
+    tb_http_sstream_set(impl, sstream);
+}
+static tb_void_t tb_http_alive_load(tb_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // get the idle connection of this host from the pool
+    tb_stream_ref_t sstream = tb_null;
+    while ((sstream = (tb_stream_ref_t)tb_http_pool_get(tb_null, &impl->option.url)))
+    {
+        // the idle connection is still alived? 
+        tb_socket_ref_t sock = tb_null;
+        if (tb_stream_ctrl(sstream, TB_STREAM_CTRL_SOCK_GET_SOCK, &sock) && tb_http_pool_alived(sock)) break;
+
+        // trace
+        tb_trace_d("connect: drop the closed connection: %s", tb_url_cstr(tb_stream_url(sstream)));
+
+        // it has been closed by the server, exit it
+        tb_http_sstream_exit(sstream);
+    }
+    tb_check_return(sstream);
+
+    // trace
+    tb_trace_d("connect: reuse the alived connection: %s", tb_url_cstr(tb_stream_url(sstream)));
+
+    // switch to the alived sock stream
+    tb_http_sstream_set(impl, sstream);
+
+    // keep alive
+    impl->status.balived = 1;
+
+    // reused
+    impl->breused = tb_true;
+}
+static tb_bool_t tb_http_clos_stream(tb_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // check the alived connection before closing it
+    tb_http_alive_check(impl);
+
+    // close stream
+    if (impl->stream && !tb_stream_clos(impl->stream)) return tb_false;
+
+    // switch to sstream
+    impl->stream = impl->sstream;
+
+    // put the alived connection to the pool
+    tb_http_alive_save(impl);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_http_connect(tb_http_impl_t* impl, tb_bool_t reuse)
 {
     // check
     tb_assert_and_check_return_val(impl && impl->stream, tb_false);
@@ -97,6 +237,10 @@ static tb_bool_t tb_http_connect(tb_http_impl_t* impl)
     tb_bool_t ok = tb_false;
     do
     {
+        // reuse the idle connection of this host
+        impl->breused = tb_false;
+        if (reuse) tb_http_alive_load(impl);
+
         // the host is changed?
         tb_bool_t           host_changed = tb_true;
         tb_char_t const*    host_old = tb_null;
@@ -122,6 +266,9 @@ static tb_bool_t tb_http_connect(tb_http_impl_t* impl)
         // clear status
         tb_http_status_cler(&impl->status, host_changed);
 
+        // clear the content offset
+        impl->content_offset = 0;
+
         // open stream
         if (!tb_stream_open(impl->stream)) break;
 
@@ -194,8 +341,8 @@ static tb_bool_t tb_http_request(tb_http_impl_t* impl)
         // init accept
         tb_hash_map_insert(impl->head, "Accept", "*/*");
 
-        // init connection
-        tb_hash_map_insert(impl->head, "Connection", impl->status.balived? "keep-alive" : "close");
+        // init connection, keep alive for HTTP/1.1
+        tb_hash_map_insert(impl->head, "Connection", (impl->status.balived || impl->option.version)? "keep-alive" : "close");
 
         // init cookies
         tb_bool_t cookie = tb_false;
@@ -434,6 +581,11 @@ static tb_bool_t tb_http_response_done(tb_http_impl_t* impl, tb_char_t const* li
             impl->status.state = TB_STATE_HTTP_RESPONSE_500 + (impl->status.code - 500);
         else impl->status.state = TB_STATE_HTTP_RESPONSE_UNK;
 
+        // keep alive for HTTP/1.1 if it is requested, it may be changed by the "Connection" field
+        tb_char_t const* connection = (tb_char_t const*)tb_hash_map_get(impl->head, "Connection");
+        impl->status.balived = (impl->status.version && connection && !tb_stricmp(connection, "keep-alive"))? 1 : 0;
+        if (!tb_stream_ctrl(impl->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, impl->status.balived? tb_true : tb_false)) return tb_false;
+
         // check state code: 4xx & 5xx
         if (impl->status.code >= 400 && impl->status.code < 600) return tb_false;
     }
@@ -552,14 +704,27 @@ static tb_bool_t tb_http_response(tb_http_impl_t* impl)
 
     // done
     tb_bool_t ok = tb_false;
+    impl->bresponded = tb_false;
     do
     {
         // read line
         tb_char_t line[8192];
         tb_long_t real = 0;
         tb_size_t indx = 0;
+        tb_hize_t offset = tb_stream_offset(impl->stream);
         while ((real = tb_stream_bread_line(impl->stream, line, sizeof(line) - 1)) >= 0)
         {
+            // nothing has been read? the connection has been closed
+            tb_hize_t offset_now = tb_stream_offset(impl->stream);
+            if (offset_now == offset) break;
+            offset = offset_now;
+
+            // responded
+            impl->bresponded = tb_true;
+
+            // skip the empty lines before the status line, .e.g the left CRLF of the last response
+            if (!real && !indx) continue;
+
             // trace
             tb_trace_d("response: %s", line);
  
@@ -569,6 +734,9 @@ static tb_bool_t tb_http_response(tb_http_impl_t* impl)
             // end?
             if (!real)
             {
+                // save the content offset
+                impl->content_offset = tb_stream_offset(impl->sstream);
+
                 // switch to cstream if chunked
                 if (impl->status.bchunked)
                 {
@@ -650,9 +818,45 @@ static tb_bool_t tb_http_response(tb_http_impl_t* impl)
 
     } while (0);
 
+    // failed? save state
+    if (!ok && !impl->status.state) 
+    {
+        impl->status.state = tb_stream_state(impl->sstream);
+        if (!impl->status.state) impl->status.state = TB_STATE_HTTP_UNKNOWN_ERROR;
+    }
+
     // ok?
     return ok;
 }
+static tb_bool_t tb_http_done(tb_http_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // connect, request and response it
+    if (tb_http_connect(impl, tb_true) && tb_http_request(impl) && tb_http_response(impl)) return tb_true;
+
+    /* the reused connection has been closed by the server before responding? 
+     *
+     * the server may close it after we have checked it, .e.g its keep-alive timeout is expired at the same time,
+     * so we retry it once with a new connection if nothing has been responded.
+     */
+    tb_check_return_val(impl->breused && !impl->bresponded && !tb_stream_is_killed(impl->sstream), tb_false);
+
+    // trace
+    tb_trace_d("done: the reused connection has been closed, retry it");
+
+    // close the closed connection and do not keep it alive
+    impl->status.balived = 0;
+    tb_stream_ctrl(impl->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+    if (!tb_http_clos_stream(impl)) return tb_false;
+
+    // clear the failed state
+    impl->status.state = TB_STATE_OK;
+
+    // connect, request and response it again with a new connection
+    return tb_http_connect(impl, tb_false) && tb_http_request(impl) && tb_http_response(impl);
+}
 static tb_bool_t tb_http_redirect(tb_http_impl_t* impl)
 {
     // check
@@ -685,10 +889,7 @@ static tb_bool_t tb_http_redirect(tb_http_impl_t* impl)
         }
 
         // close stream
-        if (impl->stream && !tb_stream_clos(impl->stream)) break;
-
-        // switch to sstream
-        impl->stream = impl->sstream;
+        if (!tb_http_clos_stream(impl)) break;
 
         // done location url
         tb_char_t const* location = tb_string_cstr(&impl->status.location);
@@ -706,14 +907,8 @@ static tb_bool_t tb_http_redirect(tb_http_impl_t* impl)
             if (!tb_url_cstr_set(&impl->option.url, location)) break;
         }
 
-        // connect it
-        if (!tb_http_connect(impl)) break;
-
-        // request it
-        if (!tb_http_request(impl)) break;
-
-        // response it
-        if (!tb_http_response(impl)) break;
+        // connect, request and response it
+        if (!tb_http_done(impl)) break;
     }
 
     // ok?
@@ -848,14 +1043,8 @@ tb_bool_t tb_http_open(tb_http_ref_t http)
     // opened?
     tb_assert_and_check_return_val(!impl->bopened, tb_false);
 
-    // connect it
-    if (!tb_http_connect(impl)) return tb_false;
-
-    // request it
-    if (!tb_http_request(impl)) return tb_false;
-
-    // response it
-    if (!tb_http_response(impl)) return tb_false;
+    // connect, request and response it
+    if (!tb_http_done(impl)) return tb_false;
 
     // redirect it
     if (!tb_http_redirect(impl)) return tb_false;
@@ -876,10 +1065,7 @@ tb_bool_t tb_http_clos(tb_http_ref_t http)
     tb_check_return_val(impl->bopened, tb_true);
 
     // close stream
-    if (impl->stream && !tb_stream_clos(impl->stream)) return tb_false;
-
-    // switch to sstream
-    impl->stream = impl->sstream;
+    if (!tb_http_clos_stream(impl)) return tb_false;
 
     // clear opened
     impl->bopened = tb_false;
@@ -904,10 +1090,7 @@ tb_bool_t tb_http_seek(tb_http_ref_t http, tb_hize_t offset)
     do
     {
         // close stream
-        if (impl->stream && !tb_stream_clos(impl->stream)) break;
-
-        // switch to sstream
-        impl->stream = impl->sstream;
+        if (!tb_http_clos_stream(impl)) break;
 
         // trace
         tb_trace_d("seek: %llu", offset);
@@ -916,14 +1099,8 @@ tb_bool_t tb_http_seek(tb_http_ref_t http, tb_hize_t offset)
         impl->option.range.bof = offset;
         impl->option.range.eof = impl->status.document_size > 0? impl->status.document_size - 1 : 0;
 
-        // connect it
-        if (!tb_http_connect(impl)) break;
-
-        // request it
-        if (!tb_http_request(impl)) break;
-
-        // response it
-        if (!tb_http_response(impl)) break;
+        // connect, request and response it
+        if (!tb_http_done(impl)) break;
 
         // ok
         ok = tb_true;
@@ -45,6 +45,13 @@
 /// the http option code is setter?
 #define TB_HTTP_OPTION_CODE_IS_SET(x)       ((x) & 0xff00)
 
+/// the http request head maxn
+#ifdef __tb_small__
+#   define TB_HTTP_REQUEST_HEAD_MAXN        (32)
+#else
+#   define TB_HTTP_REQUEST_HEAD_MAXN        (64)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -308,6 +315,68 @@ typedef struct __tb_http_status_t
 
 }tb_http_status_t;
 
+/// the http request head type
+typedef struct __tb_http_request_head_t
+{
+    /// the name
+    tb_char_t const*    name;
+
+    /// the value
+    tb_char_t const*    data;
+
+}tb_http_request_head_t;
+
+/*! the http request type
+ *
+ * all strings point to the parsed request data, 
+ * so they are valid only until the request data is released or reused.
+ */
+typedef struct __tb_http_request_t
+{
+    /// the http method
+    tb_uint16_t             method      : 3;
+
+    /// the http version, 0: HTTP/1.0, 1: HTTP/1.1
+    tb_uint16_t             version     : 1;
+
+    /// keep alive?
+    tb_uint16_t             balived     : 1;
+
+    /// is chunked content?
+    tb_uint16_t             bchunked    : 1;
+
+    /// expect 100-continue?
+    tb_uint16_t             bexpect     : 1;
+
+    /// the error code, TB_HTTP_CODE_OK if ok
+    tb_uint16_t             code;
+
+    /// the path
+    tb_char_t const*        path;
+
+    /// the arguments after '?', null if no arguments
+    tb_char_t const*        args;
+
+    /// the host, null if no host
+    tb_char_t const*        host;
+
+    /// the content size, -1 if no Content-Length
+    tb_hong_t               content_size;
+
+    /// the If-Modified-Since date, 0 if none
+    tb_time_t               modified_since;
+
+    /// the head size, including the request line and the empty line
+    tb_size_t               head_size;
+
+    /// the head count
+    tb_size_t               head_count;
+
+    /// the heads
+    tb_http_request_head_t  heads[TB_HTTP_REQUEST_HEAD_MAXN];
+
+}tb_http_request_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -32,6 +32,16 @@
 #include "date.h"
 #include "../../../libc/libc.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the weeks
+static tb_char_t const* g_http_date_weeks[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+
+// the months
+static tb_char_t const* g_http_date_months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -175,3 +185,34 @@ tb_time_t tb_http_date_from_cstr(tb_char_t const* cstr, tb_size_t size)
     // ok?
     return date;
 }
+tb_size_t tb_http_date_to_cstr(tb_time_t date, tb_char_t* data, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(data && maxn > 29, 0);
+
+    // the gmt time
+    tb_tm_t tm = {0};
+    if (!tb_gmtime(date, &tm)) return 0;
+
+    // check
+    tb_assert_and_check_return_val(tm.month >= 1 && tm.month <= 12, 0);
+
+    // make date
+    tb_long_t size = tb_snprintf(   data
+                                ,   maxn - 1
+                                ,   "%s, %02ld %s %04ld %02ld:%02ld:%02ld GMT"
+                                ,   g_http_date_weeks[tm.week % 7]
+                                ,   tm.mday
+                                ,   g_http_date_months[tm.month - 1]
+                                ,   tm.year
+                                ,   tm.hour
+                                ,   tm.minute
+                                ,   tm.second);
+    tb_check_return_val(size > 0, 0);
+
+    // end
+    data[size] = '\0';
+
+    // ok
+    return size;
+}
@@ -56,6 +56,16 @@ __tb_extern_c_enter__
  */
 tb_time_t               tb_http_date_from_cstr(tb_char_t const* cstr, tb_size_t size);
 
+/* make the http date cstring, .e.g Sun, 06 Nov 1994 08:49:37 GMT
+ *
+ * @param date          the date
+ * @param data          the cstring data
+ * @param maxn          the cstring maxn, must be larger than 29
+ *
+ * @return              the cstring size, return 0 if failed
+ */
+tb_size_t               tb_http_date_to_cstr(tb_time_t date, tb_char_t* data, tb_size_t maxn);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
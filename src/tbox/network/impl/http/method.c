@@ -57,3 +57,18 @@ tb_char_t const* tb_http_method_cstr(tb_size_t method)
     // ok
     return g_http_methods[method];
 }
+tb_long_t tb_http_method_from_cstr(tb_char_t const* cstr, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(cstr, -1);
+
+    // find it, the methods are case-sensitive
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(g_http_methods); i++)
+    {
+        if (!tb_strncmp(g_http_methods[i], cstr, size) && !g_http_methods[i][size]) return i;
+    }
+
+    // unknown
+    return -1;
+}
@@ -45,6 +45,15 @@ __tb_extern_c_enter__
  */
 tb_char_t const*        tb_http_method_cstr(tb_size_t method);
 
+/* get the http method from the given cstring
+ *
+ * @param cstr          the method cstring, .e.g GET
+ * @param size          the cstring length
+ *
+ * @return              the method, return -1 if unknown
+ */
+tb_long_t               tb_http_method_from_cstr(tb_char_t const* cstr, tb_size_t size);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,335 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="impl://www.gnu.org/licenses/"> impl://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        pool.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "http_pool"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "pool.h"
+#include "../../../utils/utils.h"
+#include "../../../memory/memory.h"
+#include "../../../platform/platform.h"
+#include "../../../asio/aioe.h"
+#include "../../../asio/aioo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the http pool item type
+typedef struct __tb_http_pool_item_t
+{
+    // the alived stream, tb_null: unused
+    tb_handle_t                 stream;
+
+    // the owner
+    tb_handle_t                 owner;
+
+    // the exit func
+    tb_http_pool_exit_func_t    exit;
+
+    // the idle timeout task
+    tb_ltimer_task_ref_t        task;
+
+    // the put time
+    tb_hong_t                   time;
+
+    // the host
+    tb_char_t*                  host;
+
+    // the port
+    tb_uint16_t                 port;
+
+    // is ssl?
+    tb_uint16_t                 bssl;
+
+}tb_http_pool_item_t;
+
+// the http pool type
+typedef struct __tb_http_pool_t
+{
+    // the lock
+    tb_spinlock_t               lock;
+
+    // the items
+    tb_http_pool_item_t         items[TB_HTTP_POOL_MAXN];
+
+}tb_http_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+static tb_http_pool_t* tb_http_pool(tb_noarg_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static __tb_inline__ tb_bool_t tb_http_pool_item_is(tb_http_pool_item_t const* item, tb_handle_t owner, tb_char_t const* host, tb_uint16_t port, tb_bool_t bssl)
+{
+    return (    item->stream
+            &&  item->owner == owner
+            &&  item->port == port
+            &&  item->bssl == (bssl? 1 : 0)
+            &&  !tb_stricmp(item->host, host))? tb_true : tb_false;
+}
+static tb_void_t tb_http_pool_item_take(tb_http_pool_item_t* item, tb_http_pool_item_t* taken)
+{
+    // save it
+    *taken = *item;
+    taken->host = tb_null;
+
+    // exit host
+    if (item->host) tb_free(item->host);
+
+    // clear it
+    tb_memset(item, 0, sizeof(tb_http_pool_item_t));
+}
+static tb_void_t tb_http_pool_item_exit(tb_http_pool_item_t* taken, tb_bool_t expired)
+{
+    // check
+    tb_check_return(taken->stream);
+
+    // trace
+    tb_trace_d("exit: %p: %s", taken->stream, expired? "expired" : "evicted");
+
+    // exit the idle timeout task, the expired task need be exited too
+    if (taken->task) tb_ltimer_task_exit(tb_ltimer(), taken->task);
+
+    // exit stream
+    if (taken->exit) taken->exit(taken->stream);
+}
+static tb_void_t tb_http_pool_expired(tb_bool_t killed, tb_cpointer_t priv)
+{
+    // the pool
+    tb_http_pool_t* pool = tb_http_pool();
+    tb_check_return(pool && priv);
+
+    // take the expired stream if it is still idle
+    tb_http_pool_item_t taken = {0};
+    tb_spinlock_enter(&pool->lock);
+    tb_size_t i = 0;
+    for (i = 0; i < TB_HTTP_POOL_MAXN; i++)
+    {
+        if (pool->items[i].stream == (tb_handle_t)priv)
+        {
+            tb_http_pool_item_take(&pool->items[i], &taken);
+            break;
+        }
+    }
+    tb_spinlock_leave(&pool->lock);
+
+    // exit it
+    tb_http_pool_item_exit(&taken, tb_true);
+}
+static tb_handle_t tb_http_pool_instance_init(tb_cpointer_t* ppriv)
+{
+    // make pool
+    tb_http_pool_t* pool = tb_malloc0_type(tb_http_pool_t);
+    tb_assert_and_check_return_val(pool, tb_null);
+
+    // init lock
+    if (!tb_spinlock_init(&pool->lock))
+    {
+        tb_free(pool);
+        return tb_null;
+    }
+
+    // ok
+    return (tb_handle_t)pool;
+}
+static tb_void_t tb_http_pool_instance_exit(tb_handle_t handle, tb_cpointer_t priv)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)handle;
+    tb_assert_and_check_return(pool);
+
+    // exit all idle connections
+    tb_size_t i = 0;
+    for (i = 0; i < TB_HTTP_POOL_MAXN; i++)
+    {
+        // take it
+        tb_http_pool_item_t taken = {0};
+        tb_spinlock_enter(&pool->lock);
+        tb_http_pool_item_take(&pool->items[i], &taken);
+        tb_spinlock_leave(&pool->lock);
+
+        // exit it
+        tb_http_pool_item_exit(&taken, tb_false);
+    }
+
+    // exit lock
+    tb_spinlock_exit(&pool->lock);
+
+    // exit it
+    tb_free(pool);
+}
+static tb_http_pool_t* tb_http_pool()
+{
+    return (tb_http_pool_t*)tb_singleton_instance(TB_SINGLETON_TYPE_HTTP_POOL, tb_http_pool_instance_init, tb_http_pool_instance_exit, tb_null, tb_null);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_bool_t tb_http_pool_put(tb_handle_t owner, tb_url_ref_t url, tb_handle_t stream, tb_http_pool_exit_func_t exit)
+{
+    // check
+    tb_assert_and_check_return_val(url && stream && exit, tb_false);
+
+    // the host
+    tb_char_t const* host = tb_url_host(url);
+    tb_check_return_val(host, tb_false);
+
+    // the pool
+    tb_http_pool_t* pool = tb_http_pool();
+    tb_check_return_val(pool, tb_false);
+
+    // the timer
+    tb_ltimer_ref_t timer = tb_ltimer();
+    tb_check_return_val(timer, tb_false);
+
+    // init item
+    tb_http_pool_item_t item = {0};
+    item.stream = stream;
+    item.owner  = owner;
+    item.exit   = exit;
+    item.time   = tb_mclock();
+    item.port   = tb_url_port(url);
+    item.bssl   = tb_url_ssl(url)? 1 : 0;
+    item.host   = tb_strdup(host);
+    tb_check_return_val(item.host, tb_false);
+
+    // post the idle timeout task, it will be failed if the timer have been killed
+    item.task = tb_ltimer_task_init(timer, TB_HTTP_POOL_IDLE_TIMEOUT, tb_false, tb_http_pool_expired, stream);
+    if (!item.task)
+    {
+        tb_free(item.host);
+        return tb_false;
+    }
+
+    // enter
+    tb_spinlock_enter(&pool->lock);
+
+    // find a free slot, and the oldest item of this host and all hosts for evicting
+    tb_size_t i         = 0;
+    tb_size_t unused    = TB_HTTP_POOL_MAXN;
+    tb_size_t oldest    = TB_HTTP_POOL_MAXN;
+    tb_size_t host_n    = 0;
+    tb_size_t host_old  = TB_HTTP_POOL_MAXN;
+    for (i = 0; i < TB_HTTP_POOL_MAXN; i++)
+    {
+        tb_http_pool_item_t const* it = &pool->items[i];
+        if (!it->stream)
+        {
+            if (unused == TB_HTTP_POOL_MAXN) unused = i;
+            continue;
+        }
+        if (oldest == TB_HTTP_POOL_MAXN || it->time < pool->items[oldest].time) oldest = i;
+        if (tb_http_pool_item_is(it, owner, host, item.port, item.bssl))
+        {
+            host_n++;
+            if (host_old == TB_HTTP_POOL_MAXN || it->time < pool->items[host_old].time) host_old = i;
+        }
+    }
+
+    // the slot, evict the oldest connection of this host or all hosts if be full
+    tb_size_t slot = unused;
+    if (host_n >= TB_HTTP_POOL_HOST_MAXN) slot = host_old;
+    else if (slot == TB_HTTP_POOL_MAXN) slot = oldest;
+    tb_assert(slot < TB_HTTP_POOL_MAXN);
+
+    // save it
+    tb_http_pool_item_t evicted = {0};
+    tb_http_pool_item_take(&pool->items[slot], &evicted);
+    pool->items[slot] = item;
+
+    // leave
+    tb_spinlock_leave(&pool->lock);
+
+    // trace
+    tb_trace_d("put: %p: %s:%u, ssl: %u", stream, host, item.port, item.bssl);
+
+    // exit the evicted connection
+    tb_http_pool_item_exit(&evicted, tb_false);
+
+    // ok
+    return tb_true;
+}
+tb_handle_t tb_http_pool_get(tb_handle_t owner, tb_url_ref_t url)
+{
+    // check
+    tb_assert_and_check_return_val(url, tb_null);
+
+    // the host
+    tb_char_t const* host = tb_url_host(url);
+    tb_check_return_val(host, tb_null);
+
+    // the pool
+    tb_http_pool_t* pool = tb_http_pool();
+    tb_check_return_val(pool, tb_null);
+
+    // the port and ssl
+    tb_uint16_t port = tb_url_port(url);
+    tb_bool_t   bssl = tb_url_ssl(url);
+
+    // take the newest idle connection of this host
+    tb_http_pool_item_t taken = {0};
+    tb_spinlock_enter(&pool->lock);
+    tb_size_t i = 0;
+    tb_size_t newest = TB_HTTP_POOL_MAXN;
+    for (i = 0; i < TB_HTTP_POOL_MAXN; i++)
+    {
+        tb_http_pool_item_t const* it = &pool->items[i];
+        if (tb_http_pool_item_is(it, owner, host, port, bssl) && (newest == TB_HTTP_POOL_MAXN || it->time > pool->items[newest].time)) newest = i;
+    }
+    if (newest < TB_HTTP_POOL_MAXN) tb_http_pool_item_take(&pool->items[newest], &taken);
+    tb_spinlock_leave(&pool->lock);
+
+    // exit the idle timeout task
+    if (taken.task) tb_ltimer_task_exit(tb_ltimer(), taken.task);
+
+    // trace
+    tb_trace_d("get: %p: %s:%u, ssl: %u", taken.stream, host, port, bssl);
+
+    // ok?
+    return taken.stream;
+}
+tb_bool_t tb_http_pool_alived(tb_socket_ref_t sock)
+{
+    // check
+    tb_check_return_val(sock, tb_false);
+
+    // the idle connection is readable? it has been closed or reset by the server, or there are some unexpected data
+    tb_long_t wait = tb_aioo_wait(sock, TB_AIOE_CODE_RECV, 0);
+
+    // trace
+    tb_trace_d("alived: %p: %s", sock, !wait? "ok" : "closed");
+
+    // ok?
+    return !wait? tb_true : tb_false;
+}
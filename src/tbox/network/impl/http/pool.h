@@ -0,0 +1,109 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        pool.h
+ */
+#ifndef TB_NETWORK_IMPL_HTTP_POOL_H
+#define TB_NETWORK_IMPL_HTTP_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the idle connections maxn of the same host
+#ifdef __tb_small__
+#   define TB_HTTP_POOL_HOST_MAXN               (4)
+#else
+#   define TB_HTTP_POOL_HOST_MAXN               (8)
+#endif
+
+// the idle connections maxn of all hosts
+#ifdef __tb_small__
+#   define TB_HTTP_POOL_MAXN                    (16)
+#else
+#   define TB_HTTP_POOL_MAXN                    (64)
+#endif
+
+// the idle timeout, 15s
+#define TB_HTTP_POOL_IDLE_TIMEOUT               (15000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the exit func type of the idle connection
+ *
+ * @param stream        the alived stream which need be closed and exited
+ */
+typedef tb_void_t       (*tb_http_pool_exit_func_t)(tb_handle_t stream);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* put the alived connection to the process-wide pool
+ *
+ * the connection is keyed by the owner and the host, port and ssl of the url,
+ * and it will be exited by the exit func if it is idle timeout, evicted or the pool is exited
+ *
+ * @param owner         the owner, .e.g the aicp of the async stream, tb_null for the stream
+ * @param url           the url of the connection
+ * @param stream        the alived stream
+ * @param exit          the exit func
+ *
+ * @return              tb_true or tb_false, the stream need be closed by the caller if failed
+ */
+tb_bool_t               tb_http_pool_put(tb_handle_t owner, tb_url_ref_t url, tb_handle_t stream, tb_http_pool_exit_func_t exit);
+
+/* get the idle connection for the url from the pool
+ *
+ * @param owner         the owner, .e.g the aicp of the async stream, tb_null for the stream
+ * @param url           the url
+ *
+ * @return              the alived stream or tb_null
+ */
+tb_handle_t             tb_http_pool_get(tb_handle_t owner, tb_url_ref_t url);
+
+/* the socket of the idle connection is still alived?
+ *
+ * the server may close the idle connection before the idle timeout of the pool,
+ * so we need check it before reusing it, it should be not readable before sending the next request
+ *
+ * @param sock          the socket of the idle connection
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_http_pool_alived(tb_socket_ref_t sock);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,285 @@
+/*!The Treasure Box Library
+ *
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox;
+ * If not, see <a href="impl://www.gnu.org/licenses/"> impl://www.gnu.org/licenses/</a>
+ *
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        request.c
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "http_request"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "request.h"
+#include "date.h"
+#include "method.h"
+#include "../../../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_char_t* tb_http_request_line(tb_char_t* p, tb_char_t* e, tb_char_t** next)
+{
+    // find the line end
+    tb_char_t* b = p;
+    while (p < e && *p != '\n') p++;
+    tb_assert_and_check_return_val(p < e, tb_null);
+
+    // the next line
+    *next = p + 1;
+
+    // strip '\r' and end it
+    if (p > b && p[-1] == '\r') p--;
+    *p = '\0';
+
+    // ok
+    return b;
+}
+static tb_bool_t tb_http_request_line_done(tb_http_request_t* request, tb_char_t* line)
+{
+    // the method
+    tb_char_t* p = line;
+    while (*p && *p != ' ') p++;
+    tb_check_return_val(*p && p > line, tb_false);
+
+    // not implemented method? the head will be parsed continually
+    tb_long_t method = tb_http_method_from_cstr(line, p - line);
+    if (method >= 0) request->method = (tb_uint16_t)method;
+    else request->code = TB_HTTP_CODE_NOT_IMPLEMENTED;
+
+    // the path
+    *p++ = '\0';
+    tb_char_t* path = p;
+    while (*p && *p != ' ') p++;
+    tb_check_return_val(*p && p > path, tb_false);
+    *p++ = '\0';
+
+    // split the arguments
+    tb_char_t* args = tb_strchr(path, '?');
+    if (args) *args++ = '\0';
+
+    // save path and args
+    request->path = path;
+    request->args = args && *args? args : tb_null;
+
+    // the version
+    if (!tb_strcmp(p, "HTTP/1.1")) request->version = 1;
+    else if (!tb_strcmp(p, "HTTP/1.0")) request->version = 0;
+    else return tb_false;
+
+    // keep alive for HTTP/1.1 by default
+    request->balived = request->version;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_http_request_head_done(tb_http_request_t* request, tb_char_t* line)
+{
+    // the name, no space is allowed before ':'
+    tb_char_t* p = line;
+    while (*p && *p != ':' && !tb_isspace(*p)) p++;
+    tb_check_return_val(*p == ':' && p > line, tb_false);
+    *p++ = '\0';
+
+    // the value, strip the spaces
+    while (*p && tb_isspace(*p)) p++;
+    tb_char_t* data = p;
+    tb_char_t* tail = p + tb_strlen(p);
+    while (tail > data && tb_isspace(tail[-1])) tail--;
+    *tail = '\0';
+
+    // too many heads?
+    tb_check_return_val(request->head_count < tb_arrayn(request->heads), tb_false);
+
+    // save head
+    request->heads[request->head_count].name = line;
+    request->heads[request->head_count].data = data;
+    request->head_count++;
+
+    // done the known heads
+    switch (tb_tolower(line[0]))
+    {
+    case 'c':
+        {
+            // content-length
+            if (!tb_stricmp(line, "Content-Length"))
+            {
+                // check
+                tb_check_return_val(*data && request->content_size < 0, tb_false);
+                for (p = data; *p; p++) tb_check_return_val(tb_isdigit(*p), tb_false);
+
+                // save the content size
+                request->content_size = (tb_hong_t)tb_s10tou64(data);
+            }
+            // connection
+            else if (!tb_stricmp(line, "Connection"))
+            {
+                if (tb_stristr(data, "close")) request->balived = 0;
+                else if (tb_stristr(data, "keep-alive")) request->balived = 1;
+            }
+        }
+        break;
+    case 'e':
+        {
+            // expect
+            if (!tb_stricmp(line, "Expect")) request->bexpect = !tb_stricmp(data, "100-continue");
+        }
+        break;
+    case 'h':
+        {
+            // host
+            if (!tb_stricmp(line, "Host")) request->host = data;
+        }
+        break;
+    case 'i':
+        {
+            // if-modified-since
+            if (!tb_stricmp(line, "If-Modified-Since")) request->modified_since = tb_http_date_from_cstr(data, tail - data);
+        }
+        break;
+    case 't':
+        {
+            // transfer-encoding
+            if (!tb_stricmp(line, "Transfer-Encoding")) request->bchunked = tb_stristr(data, "chunked")? 1 : 0;
+        }
+        break;
+    default:
+        break;
+    }
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_long_t tb_http_request_parse(tb_http_request_t* request, tb_char_t* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(request && data, -1);
+
+    // skip the empty lines before the request line
+    tb_char_t* p = data;
+    tb_char_t* e = data + size;
+    while (p < e && (*p == '\r' || *p == '\n')) p++;
+
+    // find the head end: "\n\r\n" or "\n\n"
+    tb_char_t* b = p;
+    tb_char_t* tail = tb_null;
+    for (; p < e && !tail; p++)
+    {
+        // the line end?
+        tb_check_continue(*p == '\n');
+
+        // the empty line?
+        if (p + 1 < e && p[1] == '\n') tail = p + 2;
+        else if (p + 2 < e && p[1] == '\r' && p[2] == '\n') tail = p + 3;
+    }
+
+    // not finished?
+    tb_check_return_val(tail, 0);
+
+    // init request
+    request->method         = TB_HTTP_METHOD_GET;
+    request->version        = 1;
+    request->balived        = 0;
+    request->bchunked       = 0;
+    request->bexpect        = 0;
+    request->code           = TB_HTTP_CODE_OK;
+    request->path           = tb_null;
+    request->args           = tb_null;
+    request->host           = tb_null;
+    request->content_size   = -1;
+    request->modified_since = 0;
+    request->head_size      = tail - data;
+    request->head_count     = 0;
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // the head data cannot contain '\0'
+        p = b;
+        while (p < tail && *p) p++;
+        tb_check_break(p == tail);
+
+        // the request line
+        tb_char_t* next = tb_null;
+        tb_char_t* line = tb_http_request_line(b, tail, &next);
+        tb_check_break(line && tb_http_request_line_done(request, line));
+
+        // trace
+        tb_trace_d("request: %s %s", tb_http_method_cstr(request->method), request->path);
+
+        // the heads
+        tb_bool_t failed = tb_false;
+        while (next < tail)
+        {
+            // the line
+            line = tb_http_request_line(next, tail, &next);
+            tb_check_break_state(line, failed, tb_true);
+
+            // end?
+            tb_check_break(*line);
+
+            // the obsolete line folding is not supported
+            tb_check_break_state(!tb_isspace(*line), failed, tb_true);
+
+            // done head
+            tb_check_break_state(tb_http_request_head_done(request, line), failed, tb_true);
+        }
+        tb_check_break(!failed);
+
+        // the content size is ambiguous with the chunked content?
+        tb_check_break(!request->bchunked || request->content_size < 0);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // bad request?
+    if (!ok)
+    {
+        request->code = TB_HTTP_CODE_BAD_REQUEST;
+        return -1;
+    }
+
+    // ok
+    return request->head_size;
+}
+tb_char_t const* tb_http_request_head(tb_http_request_t const* request, tb_char_t const* name)
+{
+    // check
+    tb_assert_and_check_return_val(request && name, tb_null);
+
+    // find it
+    tb_size_t i = 0;
+    for (i = 0; i < request->head_count; i++)
+    {
+        if (!tb_stricmp(request->heads[i].name, name)) return request->heads[i].data;
+    }
+
+    // not found
+    return tb_null;
+}
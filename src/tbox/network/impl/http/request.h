@@ -0,0 +1,67 @@
+/*!The Treasure Box Library
+ *
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox;
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ *
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        request.h
+ *
+ */
+#ifndef TB_NETWORK_IMPL_HTTP_REQUEST_H
+#define TB_NETWORK_IMPL_HTTP_REQUEST_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* parse the http request head in place
+ *
+ * the lines of the head will be terminated with '\0' in the given data,
+ * and all strings of the request will point to it, so it does not allocate any memory.
+ *
+ * @param request       the request
+ * @param data          the request data, the content data may follow the head
+ * @param size          the request data size
+ *
+ * @return              the head size if ok, 0 if the head is not finished, -1 if it is bad request
+ */
+tb_long_t               tb_http_request_parse(tb_http_request_t* request, tb_char_t* data, tb_size_t size);
+
+/* get the head value of the request
+ *
+ * @param request       the request
+ * @param name          the head name, case-insensitive
+ *
+ * @return              the head value, return tb_null if not found
+ */
+tb_char_t const*        tb_http_request_head(tb_http_request_t const* request, tb_char_t const* name);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
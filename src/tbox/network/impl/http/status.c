@@ -32,6 +32,59 @@
  */
 #include "status.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the http code reason type
+typedef struct __tb_http_status_reason_t
+{
+    // the code
+    tb_uint16_t             code;
+
+    // the reason
+    tb_char_t const*        cstr;
+
+}tb_http_status_reason_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the code reasons, must be sorted by the code
+static tb_http_status_reason_t const g_http_status_reasons[] = 
+{
+    {TB_HTTP_CODE_CONTINUE,                 "Continue"                  }
+,   {TB_HTTP_CODE_SWITCHING_PROTOCOLS,      "Switching Protocols"       }
+,   {TB_HTTP_CODE_OK,                       "OK"                        }
+,   {TB_HTTP_CODE_CREATED,                  "Created"                   }
+,   {TB_HTTP_CODE_ACCEPTED,                 "Accepted"                  }
+,   {TB_HTTP_CODE_NO_CONTENT,               "No Content"                }
+,   {TB_HTTP_CODE_PARTIAL_CONTENT,          "Partial Content"           }
+,   {TB_HTTP_CODE_MOVED_PERMANENTLY,        "Moved Permanently"         }
+,   {TB_HTTP_CODE_MOVED_TEMPORARILY,        "Found"                     }
+,   {TB_HTTP_CODE_SEE_OTHER,                "See Other"                 }
+,   {TB_HTTP_CODE_NOT_MODIFIED,             "Not Modified"              }
+,   {TB_HTTP_CODE_TEMPORARY_REDIRECT,       "Temporary Redirect"        }
+,   {TB_HTTP_CODE_BAD_REQUEST,              "Bad Request"               }
+,   {TB_HTTP_CODE_UNAUTHORIZED,             "Unauthorized"              }
+,   {TB_HTTP_CODE_FORBIDDEN,                "Forbidden"                 }
+,   {TB_HTTP_CODE_NOT_FOUND,                "Not Found"                 }
+,   {TB_HTTP_CODE_METHOD_NOT_ALLOWED,       "Method Not Allowed"        }
+,   {TB_HTTP_CODE_REQUEST_TIMEOUT,          "Request Timeout"           }
+,   {TB_HTTP_CODE_LENGTH_REQUIRED,          "Length Required"           }
+,   {TB_HTTP_CODE_PRECONDITION_FAILED,      "Precondition Failed"       }
+,   {TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG,  "Request Entity Too Large"  }
+,   {TB_HTTP_CODE_REQUEST_URI_TOO_LONG,     "Request-URI Too Long"      }
+,   {TB_HTTP_CODE_RANGE_NOT_SATISFIABLE,    "Range Not Satisfiable"     }
+,   {TB_HTTP_CODE_EXPECTATION_FAILED,       "Expectation Failed"        }
+,   {TB_HTTP_CODE_INTERNAL_SERVER_ERROR,    "Internal Server Error"     }
+,   {TB_HTTP_CODE_NOT_IMPLEMENTED,          "Not Implemented"           }
+,   {TB_HTTP_CODE_BAD_GATEWAY,              "Bad Gateway"               }
+,   {TB_HTTP_CODE_SERVICE_UNAVAILABLE,      "Service Unavailable"       }
+,   {TB_HTTP_CODE_GATEWAY_TIMEOUT,          "Gateway Timeout"           }
+};
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -92,6 +145,22 @@ tb_void_t tb_http_status_cler(tb_http_status_t* status, tb_bool_t host_changed)
     }
 }
 
+tb_char_t const* tb_http_status_code_cstr(tb_size_t code)
+{
+    // find it
+    tb_size_t l = 0;
+    tb_size_t r = tb_arrayn(g_http_status_reasons);
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (g_http_status_reasons[m].code < code) l = m + 1;
+        else if (g_http_status_reasons[m].code > code) r = m;
+        else return g_http_status_reasons[m].cstr;
+    }
+
+    // unknown
+    return "Unknown";
+}
 #ifdef __tb_debug__
 tb_void_t tb_http_status_dump(tb_http_status_t* status)
 {
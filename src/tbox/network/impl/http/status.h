@@ -57,6 +57,14 @@ tb_void_t               tb_http_status_exit(tb_http_status_t* status);
  */
 tb_void_t               tb_http_status_cler(tb_http_status_t* status, tb_bool_t host_changed);
 
+/* get the reason phrase of the http code
+ *
+ * @param code          the http code, .e.g TB_HTTP_CODE_OK
+ *
+ * @return              the reason phrase, .e.g "OK"
+ */
+tb_char_t const*        tb_http_status_code_cstr(tb_size_t code);
+
 #ifdef __tb_debug__
 /* dump status
  *
@@ -0,0 +1,441 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        arena.c
+ * @ingroup     object
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "object_arena"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "object.h"
+#include "impl/arena.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default block size
+#ifdef __tb_small__
+#   define TB_OBJECT_ARENA_GROW         (8192)
+#else
+#   define TB_OBJECT_ARENA_GROW         (65536)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the arena block type
+typedef struct __tb_object_arena_block_t
+{
+    // the next block
+    struct __tb_object_arena_block_t*   next;
+
+    // the block size
+    tb_size_t                           size;
+
+}tb_object_arena_block_t;
+
+// the arena hold type
+typedef struct __tb_object_arena_hold_t
+{
+    // the next hold
+    struct __tb_object_arena_hold_t*    next;
+
+    // the object
+    tb_object_ref_t                     object;
+
+}tb_object_arena_hold_t;
+
+// the arena impl type
+typedef struct __tb_object_arena_impl_t
+{
+    // the blocks
+    tb_object_arena_block_t*            blocks;
+
+    // the free data of the current block
+    tb_byte_t*                          head;
+
+    // the end of the current block
+    tb_byte_t*                          tail;
+
+    // the block size
+    tb_size_t                           grow;
+
+    // the allocated bytes of all blocks
+    tb_size_t                           size;
+
+    // the used bytes of all blocks
+    tb_size_t                           used;
+
+    // the held objects
+    tb_object_arena_hold_t*             holds;
+
+    // the string pool for the dictionary keys
+    tb_string_pool_ref_t                pool;
+
+}tb_object_arena_impl_t;
+
+// the arena scope type for the current thread
+typedef struct __tb_object_arena_scope_t
+{
+    // the thread store data base
+    tb_thread_store_data_t              base;
+
+    // the arena of the reading object
+    tb_object_arena_impl_t*             arena;
+
+}tb_object_arena_scope_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the reading count, skip the thread store lookup for the normal objects if be zero
+static tb_atomic_t                      g_reading = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_object_arena_scope_free(tb_thread_store_data_t* data)
+{
+    // exit it
+    if (data) tb_free(data);
+}
+static tb_object_arena_scope_t* tb_object_arena_scope(tb_bool_t binit)
+{
+    // get scope
+    tb_object_arena_scope_t* scope = (tb_object_arena_scope_t*)tb_thread_store_getp_type(TB_THREAD_STORE_DATA_TYPE_OBJECT_ARENA);
+    tb_check_return_val(!scope && binit, scope);
+
+    // make scope
+    scope = tb_malloc0_type(tb_object_arena_scope_t);
+    tb_assert_and_check_return_val(scope, tb_null);
+
+    // init scope
+    scope->base.type = TB_THREAD_STORE_DATA_TYPE_OBJECT_ARENA;
+    scope->base.free = tb_object_arena_scope_free;
+
+    // save scope, it will be freed when the thread exits
+    tb_thread_store_setp((tb_thread_store_data_t const*)scope);
+
+    // ok
+    return scope;
+}
+static tb_void_t tb_object_arena_element_key_dupl(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data)
+{
+    // check
+    tb_assert_and_check_return(element && element->priv && buff);
+
+    // intern it, the string pool will be exited with the arena
+    *((tb_char_t const**)buff) = data? tb_string_pool_insert((tb_string_pool_ref_t)element->priv, (tb_char_t const*)data) : tb_null;
+}
+static tb_void_t tb_object_arena_element_key_repl(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data)
+{
+    // the interned key is readonly, only replace the reference
+    tb_object_arena_element_key_dupl(element, buff, data);
+}
+static tb_object_ref_t tb_object_arena_read_done(tb_object_arena_impl_t* impl, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(impl && stream, tb_null);
+
+    // init scope
+    tb_object_arena_scope_t* scope = tb_object_arena_scope(tb_true);
+    tb_assert_and_check_return_val(scope, tb_null);
+
+    // enter the arena
+    tb_object_arena_impl_t* arena = scope->arena;
+    scope->arena = impl;
+    tb_atomic_fetch_and_inc(&g_reading);
+
+    // read object
+    tb_object_ref_t object = tb_object_read(stream);
+
+    // leave the arena
+    tb_atomic_fetch_and_dec(&g_reading);
+    scope->arena = arena;
+
+    // ok?
+    return object;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_object_arena_ref_t tb_object_arena_init(tb_size_t grow)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_object_arena_impl_t* impl = tb_null;
+    do
+    {
+        // make arena
+        impl = tb_malloc0_type(tb_object_arena_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init arena
+        impl->grow = grow? grow : TB_OBJECT_ARENA_GROW;
+
+        // init pool
+        impl->pool = tb_string_pool_init(tb_true);
+        tb_assert_and_check_break(impl->pool);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_object_arena_exit((tb_object_arena_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (tb_object_arena_ref_t)impl;
+}
+tb_void_t tb_object_arena_exit(tb_object_arena_ref_t arena)
+{
+    // check
+    tb_object_arena_impl_t* impl = (tb_object_arena_impl_t*)arena;
+    tb_assert_and_check_return(impl);
+
+    // exit the containers of the held objects
+    tb_object_arena_hold_t* hold = impl->holds;
+    for (; hold; hold = hold->next)
+    {
+        tb_object_ref_t object = hold->object;
+        if (object && object->exit) object->exit(object);
+    }
+    impl->holds = tb_null;
+
+    // exit blocks
+    tb_object_arena_block_t* block = impl->blocks;
+    while (block)
+    {
+        tb_object_arena_block_t* next = block->next;
+        tb_free(block);
+        block = next;
+    }
+    impl->blocks = tb_null;
+
+    // exit pool
+    if (impl->pool) tb_string_pool_exit(impl->pool);
+    impl->pool = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_object_ref_t tb_object_arena_read(tb_object_arena_ref_t arena, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(arena && stream, tb_null);
+
+    // read it
+    return tb_object_arena_read_done((tb_object_arena_impl_t*)arena, stream);
+}
+tb_object_ref_t tb_object_arena_read_from_url(tb_object_arena_ref_t arena, tb_char_t const* url)
+{
+    // check
+    tb_assert_and_check_return_val(arena && url, tb_null);
+
+    // init
+    tb_object_ref_t object = tb_null;
+
+    // make stream
+    tb_stream_ref_t stream = tb_stream_init_from_url(url);
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // read object
+    if (tb_stream_open(stream)) object = tb_object_arena_read(arena, stream);
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    return object;
+}
+tb_object_ref_t tb_object_arena_read_from_data(tb_object_arena_ref_t arena, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(arena && data && size, tb_null);
+
+    // init
+    tb_object_ref_t object = tb_null;
+
+    // make stream
+    tb_stream_ref_t stream = tb_stream_init_from_data(data, size);
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // read object
+    if (tb_stream_open(stream)) object = tb_object_arena_read(arena, stream);
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    return object;
+}
+tb_size_t tb_object_arena_size(tb_object_arena_ref_t arena)
+{
+    // check
+    tb_object_arena_impl_t* impl = (tb_object_arena_impl_t*)arena;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the size
+    return impl->size;
+}
+tb_size_t tb_object_arena_used(tb_object_arena_ref_t arena)
+{
+    // check
+    tb_object_arena_impl_t* impl = (tb_object_arena_impl_t*)arena;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the used size
+    return impl->used;
+}
+#ifdef __tb_debug__
+tb_void_t tb_object_arena_dump(tb_object_arena_ref_t arena)
+{
+    // check
+    tb_object_arena_impl_t* impl = (tb_object_arena_impl_t*)arena;
+    tb_assert_and_check_return(impl);
+
+    // the block and hold count
+    tb_size_t                   blocks = 0;
+    tb_size_t                   holds = 0;
+    tb_object_arena_block_t*    block = impl->blocks;
+    tb_object_arena_hold_t*     hold = impl->holds;
+    for (; block; block = block->next) blocks++;
+    for (; hold; hold = hold->next) holds++;
+
+    // trace
+    tb_trace_i("arena: size: %lu, used: %lu, blocks: %lu, holds: %lu", impl->size, impl->used, blocks, holds);
+
+    // dump pool
+    tb_string_pool_dump(impl->pool);
+}
+#endif
+tb_object_arena_ref_t tb_object_arena_self()
+{
+    // not reading? the normal object
+    tb_check_return_val(tb_atomic_get(&g_reading), tb_null);
+
+    // the arena of the current thread
+    tb_object_arena_scope_t* scope = tb_object_arena_scope(tb_false);
+    return scope? (tb_object_arena_ref_t)scope->arena : tb_null;
+}
+tb_pointer_t tb_object_arena_malloc0(tb_object_arena_ref_t arena, tb_size_t size)
+{
+    // check
+    tb_object_arena_impl_t* impl = (tb_object_arena_impl_t*)arena;
+    tb_assert_and_check_return_val(impl && size, tb_null);
+
+    // align size
+    size = tb_align8(size);
+
+    // no enough space? make a new block
+    if ((tb_size_t)(impl->tail - impl->head) < size)
+    {
+        // the block size, the large data uses the single block
+        tb_size_t head = tb_align8(sizeof(tb_object_arena_block_t));
+        tb_size_t maxn = tb_max(impl->grow, head + size);
+
+        // make block
+        tb_object_arena_block_t* block = (tb_object_arena_block_t*)tb_malloc(maxn);
+        tb_assert_and_check_return_val(block, tb_null);
+
+        // insert block
+        block->size     = maxn;
+        block->next     = impl->blocks;
+        impl->blocks    = block;
+        impl->size      += maxn;
+
+        // continue to use the current block if the new block is used by the large data only
+        if (maxn - head == size && (tb_size_t)(impl->tail - impl->head) >= (impl->grow >> 2))
+        {
+            impl->used += size;
+            tb_memset((tb_byte_t*)block + head, 0, size);
+            return (tb_byte_t*)block + head;
+        }
+
+        // switch to the new block
+        impl->head = (tb_byte_t*)block + head;
+        impl->tail = (tb_byte_t*)block + maxn;
+    }
+
+    // alloc it
+    tb_byte_t* data = impl->head;
+    impl->head += size;
+    impl->used += size;
+
+    // clear it
+    tb_memset(data, 0, size);
+
+    // ok
+    return data;
+}
+tb_element_t tb_object_arena_element_key(tb_object_arena_ref_t arena)
+{
+    // check
+    tb_object_arena_impl_t* impl = (tb_object_arena_impl_t*)arena;
+    tb_assert(impl && impl->pool);
+
+    // the str element
+    tb_element_t element = tb_element_str(tb_true);
+
+    // the key is interned in the string pool and need not free it
+    element.priv    = impl->pool;
+    element.dupl    = tb_object_arena_element_key_dupl;
+    element.repl    = tb_object_arena_element_key_repl;
+    element.free    = tb_null;
+
+    // ok?
+    return element;
+}
+tb_bool_t tb_object_arena_hold(tb_object_arena_ref_t arena, tb_object_ref_t object)
+{
+    // check
+    tb_object_arena_impl_t* impl = (tb_object_arena_impl_t*)arena;
+    tb_assert_and_check_return_val(impl && object, tb_false);
+
+    // make hold
+    tb_object_arena_hold_t* hold = (tb_object_arena_hold_t*)tb_object_arena_malloc0(arena, sizeof(tb_object_arena_hold_t));
+    tb_assert_and_check_return_val(hold, tb_false);
+
+    // insert hold
+    hold->object    = object;
+    hold->next      = impl->holds;
+    impl->holds     = hold;
+
+    // ok
+    return tb_true;
+}
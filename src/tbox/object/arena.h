@@ -0,0 +1,145 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        arena.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_ARENA_H
+#define TB_OBJECT_ARENA_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the object arena ref type
+typedef struct{}*           tb_object_arena_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the object arena
+ *
+ * the objects read into the arena are allocated from the bump blocks of the arena,
+ * the dictionary keys are interned in the string pool of the arena
+ * and the whole tree will be freed in one shot when the arena exits.
+ *
+ * the arena objects are readonly, tb_object_exit() and tb_object_retain() do nothing for them,
+ * so do not use them after the arena has been exited.
+ *
+ * @code
+ *
+    // init arena
+    tb_object_arena_ref_t arena = tb_object_arena_init(0);
+    if (arena)
+    {
+        // read object
+        tb_object_ref_t object = tb_object_arena_read_from_url(arena, "/tmp/file.json");
+        if (object)
+        {
+            // ...
+        }
+
+        // exit arena and all objects
+        tb_object_arena_exit(arena);
+    }
+ * @endcode
+ *
+ * @param grow      the block size, using the default size if be zero
+ *
+ * @return          the arena
+ */
+tb_object_arena_ref_t   tb_object_arena_init(tb_size_t grow);
+
+/*! exit the object arena and free all objects in it
+ *
+ * @param arena     the arena
+ */
+tb_void_t               tb_object_arena_exit(tb_object_arena_ref_t arena);
+
+/*! read object into the arena
+ *
+ * @param arena     the arena
+ * @param stream    the stream
+ *
+ * @return          the object
+ */
+tb_object_ref_t         tb_object_arena_read(tb_object_arena_ref_t arena, tb_stream_ref_t stream);
+
+/*! read object into the arena from the given url
+ *
+ * @param arena     the arena
+ * @param url       the url
+ *
+ * @return          the object
+ */
+tb_object_ref_t         tb_object_arena_read_from_url(tb_object_arena_ref_t arena, tb_char_t const* url);
+
+/*! read object into the arena from the given data
+ *
+ * @param arena     the arena
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          the object
+ */
+tb_object_ref_t         tb_object_arena_read_from_data(tb_object_arena_ref_t arena, tb_byte_t const* data, tb_size_t size);
+
+/*! the block size of the arena
+ *
+ * @param arena     the arena
+ *
+ * @return          the allocated bytes of all blocks
+ */
+tb_size_t               tb_object_arena_size(tb_object_arena_ref_t arena);
+
+/*! the used size of the arena
+ *
+ * @param arena     the arena
+ *
+ * @return          the used bytes of all blocks
+ */
+tb_size_t               tb_object_arena_used(tb_object_arena_ref_t arena);
+
+#ifdef __tb_debug__
+/*! dump the arena
+ *
+ * @param arena     the arena
+ */
+tb_void_t               tb_object_arena_dump(tb_object_arena_ref_t arena);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
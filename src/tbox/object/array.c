@@ -32,6 +32,8 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
+#include "impl/lazy.h"
 #include "../algorithm/algorithm.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -50,18 +52,48 @@ typedef struct __tb_object_array_t
     // is increase refn?
     tb_bool_t           incr;
 
+    // the lazy loader, the items have not been loaded if exists
+    tb_object_lazy_ref_t    lazy;
+
 }tb_object_array_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+static tb_void_t tb_object_array_lazy_exit(tb_object_array_t* array)
+{
+    // exit the lazy loader
+    tb_object_lazy_ref_t lazy = array->lazy;
+    if (lazy && lazy->exit) lazy->exit(lazy);
+    array->lazy = tb_null;
+}
+static tb_void_t tb_object_array_lazy_load(tb_object_array_t* array)
+{
+    // the lazy loader, clear it first for inserting the loaded items
+    tb_object_lazy_ref_t lazy = array->lazy;
+    array->lazy = tb_null;
+
+    // load items
+    if (!lazy->load(lazy, (tb_object_ref_t)array))
+    {
+        // trace
+        tb_trace_e("load items failed!");
+    }
+
+    // exit the lazy loader
+    if (lazy->exit) lazy->exit(lazy);
+}
 static __tb_inline__ tb_object_array_t* tb_object_array_cast(tb_object_ref_t object)
 {
     // check
     tb_assert_and_check_return_val(object && object->type == TB_OBJECT_TYPE_ARRAY, tb_null);
 
+    // load the lazy items at first
+    tb_object_array_t* array = (tb_object_array_t*)object;
+    if (array->lazy) tb_object_array_lazy_load(array);
+
     // cast
-    return (tb_object_array_t*)object;
+    return array;
 }
 static tb_object_ref_t tb_object_array_copy(tb_object_ref_t object)
 {
@@ -87,21 +119,31 @@ static tb_object_ref_t tb_object_array_copy(tb_object_ref_t object)
 }
 static tb_void_t tb_object_array_exit(tb_object_ref_t object)
 {
-    // check
-    tb_object_array_t* array = tb_object_array_cast(object);
-    tb_assert_and_check_return(array);
+    // check, not load the lazy items
+    tb_assert_and_check_return(object && object->type == TB_OBJECT_TYPE_ARRAY);
+    tb_object_array_t* array = (tb_object_array_t*)object;
+
+    // exit the lazy loader
+    tb_object_array_lazy_exit(array);
 
     // exit vector
     if (array->vector) tb_vector_exit(array->vector);
     array->vector = tb_null;
 
-    // exit it
-    tb_free(array);
+    // exit it, the arena object will be freed with the arena
+    if (!(object->flag & TB_OBJECT_FLAG_ARENA)) tb_free(array);
 }
 static tb_void_t tb_object_array_clear(tb_object_ref_t object)
 {
-    tb_object_array_t* array = tb_object_array_cast(object);
-    tb_assert_and_check_return(array && array->vector);
+    // check, not load the lazy items
+    tb_assert_and_check_return(object && object->type == TB_OBJECT_TYPE_ARRAY);
+    tb_object_array_t* array = (tb_object_array_t*)object;
+
+    // drop the lazy items
+    tb_object_array_lazy_exit(array);
+
+    // check
+    tb_assert_and_check_return(array->vector);
 
     // clear vector
     tb_vector_clear(array->vector);
@@ -113,17 +155,21 @@ static tb_object_array_t* tb_object_array_init_base()
     tb_object_array_t*  array = tb_null;
     do
     {
-        // make array
-        array = tb_malloc0_type(tb_object_array_t);
+        // make array, allocate it from the arena if be reading into the arena
+        tb_object_arena_ref_t arena = tb_object_arena_self();
+        array = arena? (tb_object_array_t*)tb_object_arena_malloc0(arena, sizeof(tb_object_array_t)) : tb_malloc0_type(tb_object_array_t);
         tb_assert_and_check_break(array);
 
         // init array
-        if (!tb_object_init((tb_object_ref_t)array, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_ARRAY)) break;
+        if (!tb_object_init((tb_object_ref_t)array, arena? TB_OBJECT_FLAG_ARENA : TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_ARRAY)) break;
 
         // init base
         array->base.copy    = tb_object_array_copy;
         array->base.exit    = tb_object_array_exit;
         array->base.clear   = tb_object_array_clear;
+
+        // hold it, the vector will be exited when the arena exits
+        if (arena && !tb_object_arena_hold(arena, (tb_object_ref_t)array)) break;
         
         // ok
         ok = tb_true;
@@ -262,3 +308,15 @@ tb_void_t tb_object_array_incr(tb_object_ref_t object, tb_bool_t incr)
 
     array->incr = incr;
 }
+tb_void_t tb_object_array_lazy_set(tb_object_ref_t object, tb_object_lazy_ref_t lazy)
+{
+    // check, not load the lazy items
+    tb_assert_and_check_return(object && object->type == TB_OBJECT_TYPE_ARRAY && lazy && lazy->load);
+    tb_object_array_t* array = (tb_object_array_t*)object;
+
+    // exit the previous lazy loader
+    tb_object_array_lazy_exit(array);
+
+    // set it
+    array->lazy = lazy;
+}
@@ -32,6 +32,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../utils/utils.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -69,8 +70,11 @@ static tb_void_t tb_object_data_exit(tb_object_ref_t object)
     tb_object_data_t* data = tb_object_data_cast(object);
     if (data) 
     {
+        // exit buffer
         tb_buffer_exit(&data->buffer);
-        tb_free(data);
+
+        // exit it, the arena object will be freed with the arena
+        if (!(object->flag & TB_OBJECT_FLAG_ARENA)) tb_free(data);
     }
 }
 static tb_void_t tb_object_data_clear(tb_object_ref_t object)
@@ -85,17 +89,21 @@ static tb_object_data_t* tb_object_data_init_base()
     tb_object_data_t*   data = tb_null;
     do
     {
-        // make data
-        data = tb_malloc0_type(tb_object_data_t);
+        // make data, allocate it from the arena if be reading into the arena
+        tb_object_arena_ref_t arena = tb_object_arena_self();
+        data = arena? (tb_object_data_t*)tb_object_arena_malloc0(arena, sizeof(tb_object_data_t)) : tb_malloc0_type(tb_object_data_t);
         tb_assert_and_check_break(data);
 
         // init data
-        if (!tb_object_init((tb_object_ref_t)data, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DATA)) break;
+        if (!tb_object_init((tb_object_ref_t)data, arena? TB_OBJECT_FLAG_ARENA : TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DATA)) break;
 
         // init base
         data->base.copy     = tb_object_data_copy;
         data->base.exit     = tb_object_data_exit;
         data->base.clear    = tb_object_data_clear;
+
+        // hold it, the buffer will be exited when the arena exits
+        if (arena && !tb_object_arena_hold(arena, (tb_object_ref_t)data)) break;
         
         // ok
         ok = tb_true;
@@ -32,6 +32,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../utils/utils.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -80,12 +81,13 @@ static tb_object_date_t* tb_object_date_init_base()
     tb_object_date_t*   date = tb_null;
     do
     {
-        // make date
-        date = tb_malloc0_type(tb_object_date_t);
+        // make date, allocate it from the arena if be reading into the arena
+        tb_object_arena_ref_t arena = tb_object_arena_self();
+        date = arena? (tb_object_date_t*)tb_object_arena_malloc0(arena, sizeof(tb_object_date_t)) : tb_malloc0_type(tb_object_date_t);
         tb_assert_and_check_break(date);
 
         // init date
-        if (!tb_object_init((tb_object_ref_t)date, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DATE)) break;
+        if (!tb_object_init((tb_object_ref_t)date, arena? TB_OBJECT_FLAG_ARENA : TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DATE)) break;
 
         // init base
         date->base.copy     = tb_object_date_copy;
@@ -32,6 +32,8 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
+#include "impl/lazy.h"
 #include "../string/string.h"
 #include "../algorithm/algorithm.h"
 
@@ -63,18 +65,48 @@ typedef struct __tb_object_dictionary_t
     // increase refn?
     tb_bool_t           incr;
 
+    // the lazy loader, the items have not been loaded if exists
+    tb_object_lazy_ref_t    lazy;
+
 }tb_object_dictionary_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+static tb_void_t tb_object_dictionary_lazy_exit(tb_object_dictionary_t* dictionary)
+{
+    // exit the lazy loader
+    tb_object_lazy_ref_t lazy = dictionary->lazy;
+    if (lazy && lazy->exit) lazy->exit(lazy);
+    dictionary->lazy = tb_null;
+}
+static tb_void_t tb_object_dictionary_lazy_load(tb_object_dictionary_t* dictionary)
+{
+    // the lazy loader, clear it first for inserting the loaded items
+    tb_object_lazy_ref_t lazy = dictionary->lazy;
+    dictionary->lazy = tb_null;
+
+    // load items
+    if (!lazy->load(lazy, (tb_object_ref_t)dictionary))
+    {
+        // trace
+        tb_trace_e("load items failed!");
+    }
+
+    // exit the lazy loader
+    if (lazy->exit) lazy->exit(lazy);
+}
 static __tb_inline__ tb_object_dictionary_t* tb_object_dictionary_cast(tb_object_ref_t object)
 {
     // check
     tb_assert_and_check_return_val(object && object->type == TB_OBJECT_TYPE_DICTIONARY, tb_null);
 
+    // load the lazy items at first
+    tb_object_dictionary_t* dictionary = (tb_object_dictionary_t*)object;
+    if (dictionary->lazy) tb_object_dictionary_lazy_load(dictionary);
+
     // cast
-    return (tb_object_dictionary_t*)object;
+    return dictionary;
 }
 static tb_object_ref_t tb_object_dictionary_copy(tb_object_ref_t object)
 {
@@ -104,21 +136,28 @@ static tb_object_ref_t tb_object_dictionary_copy(tb_object_ref_t object)
 }
 static tb_void_t tb_object_dictionary_exit(tb_object_ref_t object)
 {
-    // check
-    tb_object_dictionary_t* dictionary = tb_object_dictionary_cast(object);
-    tb_assert_and_check_return(dictionary);
+    // check, not load the lazy items
+    tb_assert_and_check_return(object && object->type == TB_OBJECT_TYPE_DICTIONARY);
+    tb_object_dictionary_t* dictionary = (tb_object_dictionary_t*)object;
+
+    // exit the lazy loader
+    tb_object_dictionary_lazy_exit(dictionary);
 
     // exit hash
     if (dictionary->hash) tb_hash_map_exit(dictionary->hash);
     dictionary->hash = tb_null;
 
-    // exit it
-    tb_free(dictionary);
+    // exit it, the arena object will be freed with the arena
+    if (!(object->flag & TB_OBJECT_FLAG_ARENA)) tb_free(dictionary);
 }
 static tb_void_t tb_object_dictionary_clear(tb_object_ref_t object)
 {
-    tb_object_dictionary_t* dictionary = tb_object_dictionary_cast(object);
-    tb_assert_and_check_return(dictionary);
+    // check, not load the lazy items
+    tb_assert_and_check_return(object && object->type == TB_OBJECT_TYPE_DICTIONARY);
+    tb_object_dictionary_t* dictionary = (tb_object_dictionary_t*)object;
+
+    // drop the lazy items
+    tb_object_dictionary_lazy_exit(dictionary);
 
     // clear
     if (dictionary->hash) tb_hash_map_clear(dictionary->hash);
@@ -130,17 +169,21 @@ static tb_object_dictionary_t* tb_object_dictionary_init_base()
     tb_object_dictionary_t*     dictionary = tb_null;
     do
     {
-        // make dictionary
-        dictionary = tb_malloc0_type(tb_object_dictionary_t);
+        // make dictionary, allocate it from the arena if be reading into the arena
+        tb_object_arena_ref_t arena = tb_object_arena_self();
+        dictionary = arena? (tb_object_dictionary_t*)tb_object_arena_malloc0(arena, sizeof(tb_object_dictionary_t)) : tb_malloc0_type(tb_object_dictionary_t);
         tb_assert_and_check_break(dictionary);
 
         // init dictionary
-        if (!tb_object_init((tb_object_ref_t)dictionary, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DICTIONARY)) break;
+        if (!tb_object_init((tb_object_ref_t)dictionary, arena? TB_OBJECT_FLAG_ARENA : TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DICTIONARY)) break;
 
         // init base
         dictionary->base.copy   = tb_object_dictionary_copy;
         dictionary->base.exit   = tb_object_dictionary_exit;
         dictionary->base.clear  = tb_object_dictionary_clear;
+
+        // hold it, the hash will be exited when the arena exits
+        if (arena && !tb_object_arena_hold(arena, (tb_object_ref_t)dictionary)) break;
         
         // ok
         ok = tb_true;
@@ -173,15 +216,16 @@ tb_object_ref_t tb_object_dictionary_init(tb_size_t size, tb_bool_t incr)
         dictionary = tb_object_dictionary_init_base();
         tb_assert_and_check_break(dictionary);
 
-        // using the default size
-        if (!size) size = TB_OBJECT_DICTIONARY_SIZE_DEFAULT;
+        // using the default size, the arena dictionary uses the micro buckets and grows it incrementally
+        if (!size) size = (dictionary->base.flag & TB_OBJECT_FLAG_ARENA)? TB_OBJECT_DICTIONARY_SIZE_MICRO : TB_OBJECT_DICTIONARY_SIZE_DEFAULT;
 
         // init
         dictionary->size = size;
         dictionary->incr = incr;
 
-        // init hash
-        dictionary->hash = tb_hash_map_init(size, tb_element_str(tb_true), tb_element_obj());
+        // init hash, the keys of the arena dictionary are interned in the string pool of the arena
+        tb_element_t element_key = (dictionary->base.flag & TB_OBJECT_FLAG_ARENA)? tb_object_arena_element_key(tb_object_arena_self()) : tb_element_str(tb_true);
+        dictionary->hash = tb_hash_map_init(size, element_key, tb_element_obj());
         tb_assert_and_check_break(dictionary->hash);
 
         // ok
@@ -255,3 +299,15 @@ tb_void_t tb_object_dictionary_incr(tb_object_ref_t object, tb_bool_t incr)
 
     dictionary->incr = incr;
 }
+tb_void_t tb_object_dictionary_lazy_set(tb_object_ref_t object, tb_object_lazy_ref_t lazy)
+{
+    // check, not load the lazy items
+    tb_assert_and_check_return(object && object->type == TB_OBJECT_TYPE_DICTIONARY && lazy && lazy->load);
+    tb_object_dictionary_t* dictionary = (tb_object_dictionary_t*)object;
+
+    // exit the previous lazy loader
+    tb_object_dictionary_lazy_exit(dictionary);
+
+    // set it
+    dictionary->lazy = lazy;
+}
@@ -0,0 +1,80 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        arena.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_IMPL_ARENA_H
+#define TB_OBJECT_IMPL_ARENA_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the arena of the object reading in the current thread
+ *
+ * @return          the arena, tb_null if not be reading into any arena
+ */
+tb_object_arena_ref_t   tb_object_arena_self(tb_noarg_t);
+
+/*! malloc the object data from the arena and fill zero
+ *
+ * @param arena     the arena
+ * @param size      the size
+ *
+ * @return          the data address
+ */
+tb_pointer_t            tb_object_arena_malloc0(tb_object_arena_ref_t arena, tb_size_t size);
+
+/*! the element of the dictionary key which is interned in the string pool of the arena
+ *
+ * @param arena     the arena
+ *
+ * @return          the element
+ */
+tb_element_t            tb_object_arena_element_key(tb_object_arena_ref_t arena);
+
+/*! hold the object which has some containers and exit them when the arena exits
+ *
+ * the exit func of the object only exits the containers for the arena object
+ *
+ * @param arena     the arena
+ * @param object    the object
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_object_arena_hold(tb_object_arena_ref_t arena, tb_object_ref_t object);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
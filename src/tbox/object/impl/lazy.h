@@ -0,0 +1,84 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        lazy.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_IMPL_LAZY_H
+#define TB_OBJECT_IMPL_LAZY_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the lazy loader type for the array and dictionary items
+typedef struct __tb_object_lazy_t
+{
+    /*! load all items into the array or dictionary
+     *
+     * @param lazy      the lazy loader
+     * @param object    the array or dictionary
+     *
+     * @return          tb_true or tb_false
+     */
+    tb_bool_t           (*load)(struct __tb_object_lazy_t* lazy, tb_object_ref_t object);
+
+    /*! exit the lazy loader after loading it or exiting the object
+     *
+     * @param lazy      the lazy loader
+     */
+    tb_void_t           (*exit)(struct __tb_object_lazy_t* lazy);
+
+}tb_object_lazy_t, *tb_object_lazy_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! set the lazy loader of the array, the items will be loaded when accessing the array at first
+ *
+ * @param array     the array
+ * @param lazy      the lazy loader
+ */
+tb_void_t           tb_object_array_lazy_set(tb_object_ref_t array, tb_object_lazy_ref_t lazy);
+
+/*! set the lazy loader of the dictionary, the items will be loaded when accessing the dictionary at first
+ *
+ * @param dictionary    the dictionary
+ * @param lazy          the lazy loader
+ */
+tb_void_t           tb_object_dictionary_lazy_set(tb_object_ref_t dictionary, tb_object_lazy_ref_t lazy);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -33,6 +33,8 @@
  */
 #include "bplist.h"
 #include "reader.h"
+#include "../arena.h"
+#include "../lazy.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -45,6 +47,9 @@
 #   define TB_OBJECT_BPLIST_READER_ARRAY_GROW           (256)
 #endif
 
+// the maximum depth of the array and dictionary in the mapped file
+#define TB_OBJECT_BPLIST_READER_MAP_DEPTH               (256)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -69,6 +74,65 @@ typedef enum __tb_object_bplist_type_e
 
 }tb_object_bplist_type_e;
 
+// the bplist map type, the mapped file will be unmapped after all lazy items have been loaded
+typedef struct __tb_object_bplist_map_t
+{
+    // the refn
+    tb_atomic_t                 refn;
+
+    // the mapped data
+    tb_byte_t const*            data;
+
+    // the mapped size
+    tb_size_t                   size;
+
+    // the offset table, all objects are placed before it
+    tb_byte_t const*            offset_table;
+
+    // the offset size
+    tb_size_t                   offset_size;
+
+    // the item size for array and dictionary
+    tb_size_t                   item_size;
+
+    // the object count
+    tb_size_t                   object_count;
+
+    // load all items at once? 
+    tb_bool_t                   eager;
+
+}tb_object_bplist_map_t;
+
+// the bplist lazy type for the array and dictionary items
+typedef struct __tb_object_bplist_lazy_t
+{
+    // the base
+    tb_object_lazy_t            base;
+
+    // the map
+    tb_object_bplist_map_t*     map;
+
+    // the item refs
+    tb_byte_t const*            refs;
+
+    // the item count
+    tb_size_t                   count;
+
+    // the depth
+    tb_size_t                   depth;
+
+    // the object indices of this container and all its parents 
+    tb_size_t*                  path;
+
+}tb_object_bplist_lazy_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the reader has been hooked? the mapped file will not be used if be hooked
+static tb_bool_t                g_hooked = tb_false;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -470,7 +534,536 @@ static tb_object_ref_t tb_object_bplist_reader_func_dictionary(tb_object_bplist_
     // ok?
     return object;
 }
-static tb_object_ref_t tb_object_bplist_reader_done(tb_stream_ref_t stream)
+static tb_void_t tb_object_bplist_reader_map_exit(tb_object_bplist_map_t* map)
+{
+    // check
+    tb_assert_and_check_return(map);
+
+    // refn--, unmap it if no lazy items refer it
+    if (tb_atomic_fetch_and_dec(&map->refn) == 1)
+    {
+        // unmap it
+        if (map->data) tb_file_munmap(map->data, map->size);
+
+        // exit it
+        tb_free(map);
+    }
+}
+static tb_byte_t const* tb_object_bplist_reader_map_head(tb_object_bplist_map_t* map, tb_size_t index, tb_size_t* ptype, tb_size_t* psize, tb_size_t* pleft)
+{
+    // check
+    tb_assert_and_check_return_val(map && ptype && psize && pleft, tb_null);
+    tb_assert_and_check_return_val(index < map->object_count, tb_null);
+
+    // the object offset
+    tb_size_t offset = tb_object_bplist_bits_get(map->offset_table + index * map->offset_size, map->offset_size);
+    tb_assert_and_check_return_val(offset >= 8 && offset < (tb_size_t)(map->offset_table - map->data), tb_null);
+
+    // the object type and size
+    tb_byte_t const* p = map->data + offset;
+    *ptype = *p & 0xf0;
+    *psize = *p & 0x0f;
+    p++;
+
+    // the left size of the object data
+    *pleft = (tb_size_t)(map->offset_table - p);
+
+    // the object data
+    return p;
+}
+static tb_byte_t const* tb_object_bplist_reader_map_size(tb_byte_t const* p, tb_size_t* psize, tb_size_t* pleft)
+{
+    // check
+    tb_assert_and_check_return_val(p && psize && pleft, tb_null);
+
+    // size is too large? read the following integer size
+    if (*psize == 0x0f)
+    {
+        // check
+        tb_assert_and_check_return_val(*pleft && (*p & 0xf0) == TB_OBJECT_BPLIST_TYPE_UINT, tb_null);
+
+        // the integer size
+        tb_size_t n = (tb_size_t)1 << (*p & 0x0f);
+        tb_assert_and_check_return_val(n <= 8 && n < *pleft, tb_null);
+
+        // read size
+        *psize = tb_object_bplist_bits_get(p + 1, n);
+        *pleft -= n + 1;
+        p += n + 1;
+    }
+
+    // the object data
+    return p;
+}
+static tb_object_ref_t tb_object_bplist_reader_map_number(tb_size_t type, tb_byte_t const* p, tb_size_t size)
+{
+    // done
+    tb_object_ref_t object = tb_null;
+    switch (size)
+    {
+    case 1:
+        object = tb_object_number_init_from_uint8(tb_bits_get_u8(p));
+        break;
+    case 2:
+        object = tb_object_number_init_from_uint16(tb_bits_get_u16_be(p));
+        break;
+    case 4:
+        {
+            if (type == TB_OBJECT_BPLIST_TYPE_UINT)
+                object = tb_object_number_init_from_uint32(tb_bits_get_u32_be(p));
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+            else object = tb_object_number_init_from_float(tb_bits_get_float_be(p));
+#endif
+        }
+        break;
+    case 8:
+        {
+            if (type == TB_OBJECT_BPLIST_TYPE_UINT)
+                object = tb_object_number_init_from_uint64(tb_bits_get_u64_be(p));
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+            else object = tb_object_number_init_from_double(tb_bits_get_double_bbe(p));
+#endif
+        }
+        break;
+    default:
+        break;
+    }
+
+    // ok?
+    return object;
+}
+static tb_object_ref_t tb_object_bplist_reader_map_data(tb_byte_t const* p, tb_size_t size)
+{
+    // init data
+    tb_object_ref_t object = tb_object_data_init_from_data(tb_null, 0);
+    tb_assert_and_check_return_val(object, tb_null);
+
+    /* copy data
+     *
+     * @note the mapped data is not from the memory pool,
+     * we use tb_memcpy_ because the checking of tb_memcpy will read the data head before it
+     */
+    if (size)
+    {
+        tb_buffer_ref_t buffer = tb_object_data_buffer(object);
+        if (buffer && tb_buffer_resize(buffer, size)) tb_memcpy_(tb_buffer_data(buffer), p, size);
+        else
+        {
+            tb_object_exit(object);
+            object = tb_null;
+        }
+    }
+
+    // ok?
+    return object;
+}
+static tb_object_ref_t tb_object_bplist_reader_map_string(tb_size_t type, tb_byte_t const* p, tb_size_t size)
+{
+    // done
+    tb_char_t       data[256];
+    tb_char_t*      utf8 = tb_null;
+    tb_object_ref_t object = tb_null;
+    switch (type)
+    {
+    case TB_OBJECT_BPLIST_TYPE_STRING:
+        {
+            // empty?
+            if (!size)
+            {
+                object = tb_object_string_init_from_cstr(tb_null);
+                break;
+            }
+
+            // make utf8, using the stack data for the short string
+            utf8 = size < sizeof(data)? data : tb_malloc_cstr(size + 1);
+            tb_assert_and_check_break(utf8);
+
+            // copy it, the mapped data is not from the memory pool
+            tb_memcpy_(utf8, p, size);
+            utf8[size] = '\0';
+
+            // init object
+            object = tb_object_string_init_from_cstr(utf8);
+        }
+        break;
+    case TB_OBJECT_BPLIST_TYPE_UNICODE:
+        {
+#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
+            // empty?
+            if (!size)
+            {
+                object = tb_object_string_init_from_cstr(tb_null);
+                break;
+            }
+
+            // make utf8, using the stack data for the short string
+            tb_size_t maxn = (size + 1) << 2;
+            utf8 = maxn <= sizeof(data)? data : tb_malloc_cstr(maxn);
+            tb_assert_and_check_break(utf8);
+
+            // utf16 to utf8
+            tb_long_t osize = tb_charset_conv_data(TB_CHARSET_TYPE_UTF16, TB_CHARSET_TYPE_UTF8, p, size << 1, (tb_byte_t*)utf8, maxn);
+            tb_assert_and_check_break(osize > 0 && osize < (tb_long_t)maxn);
+            utf8[osize] = '\0';
+
+            // init object
+            object = tb_object_string_init_from_cstr(utf8);
+#else
+            // trace
+            tb_trace1_e("unicode type is not supported, please enable charset module config if you want to use it!");
+#endif
+        }
+        break;
+    default:
+        break;
+    }
+
+    // exit utf8
+    if (utf8 && utf8 != data) tb_free(utf8);
+
+    // ok?
+    return object;
+}
+static tb_bool_t tb_object_bplist_reader_map_path(tb_size_t index, tb_size_t const* path, tb_size_t depth)
+{
+    // too deep?
+    if (depth >= TB_OBJECT_BPLIST_READER_MAP_DEPTH)
+    {
+        // trace
+        tb_trace_e("the object is too deep!");
+        return tb_false;
+    }
+
+    // is one of its parents? the cyclic reference will be ignored
+    tb_size_t i = 0;
+    for (i = 0; i < depth; i++)
+    {
+        if (path[i] == index)
+        {
+            // trace
+            tb_trace_e("the object: %lu is referenced cyclically!", index);
+            return tb_false;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_object_ref_t tb_object_bplist_reader_map_object(tb_object_bplist_map_t* map, tb_size_t index, tb_size_t* path, tb_size_t depth);
+static tb_bool_t tb_object_bplist_reader_map_load(tb_object_bplist_map_t* map, tb_object_ref_t object, tb_byte_t const* refs, tb_size_t count, tb_size_t* path, tb_size_t depth)
+{
+    // check
+    tb_assert_and_check_return_val(map && object && refs && path, tb_false);
+
+    // done
+    tb_size_t i = 0;
+    tb_size_t item_size = map->item_size;
+    if (tb_object_type(object) == TB_OBJECT_TYPE_ARRAY)
+    {
+        // walk items
+        for (i = 0; i < count; i++)
+        {
+            // append item
+            tb_object_ref_t item = tb_object_bplist_reader_map_object(map, tb_object_bplist_bits_get(refs + i * item_size, item_size), path, depth);
+            if (item) tb_object_array_append(object, item);
+        }
+    }
+    else
+    {
+        // walk items
+        for (i = 0; i < count; i++)
+        {
+            // the key and val
+            tb_size_t key = tb_object_bplist_bits_get(refs + i * item_size, item_size);
+            tb_size_t val = tb_object_bplist_bits_get(refs + (count + i) * item_size, item_size);
+
+            // the key object
+            tb_object_ref_t okey = tb_object_bplist_reader_map_object(map, key, path, depth);
+            tb_assert_and_check_continue(okey);
+
+            // key must be string now.
+            tb_assert(tb_object_type(okey) == TB_OBJECT_TYPE_STRING);
+            if (tb_object_type(okey) == TB_OBJECT_TYPE_STRING)
+            {
+                // set key => val
+                tb_char_t const*    skey = tb_object_string_cstr(okey);
+                tb_object_ref_t     oval = skey? tb_object_bplist_reader_map_object(map, val, path, depth) : tb_null;
+                if (oval) tb_object_dictionary_insert(object, skey, oval);
+            }
+
+            // exit the key object
+            tb_object_exit(okey);
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_object_bplist_reader_lazy_load(tb_object_lazy_ref_t lazy, tb_object_ref_t object)
+{
+    // check
+    tb_object_bplist_lazy_t* impl = (tb_object_bplist_lazy_t*)lazy;
+    tb_assert_and_check_return_val(impl && impl->map && object, tb_false);
+
+    // load items, the sub-items are lazy too
+    return tb_object_bplist_reader_map_load(impl->map, object, impl->refs, impl->count, impl->path, impl->depth);
+}
+static tb_void_t tb_object_bplist_reader_lazy_exit(tb_object_lazy_ref_t lazy)
+{
+    // check
+    tb_object_bplist_lazy_t* impl = (tb_object_bplist_lazy_t*)lazy;
+    tb_assert_and_check_return(impl);
+
+    // exit map
+    if (impl->map) tb_object_bplist_reader_map_exit(impl->map);
+    impl->map = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+static tb_object_ref_t tb_object_bplist_reader_map_items(tb_object_bplist_map_t* map, tb_object_ref_t object, tb_size_t index, tb_byte_t const* refs, tb_size_t count, tb_size_t* path, tb_size_t depth)
+{
+    // check
+    tb_assert_and_check_return_val(map && object && path, tb_null);
+
+    // no items?
+    tb_check_return_val(count, object);
+
+    // load all items now? the path is the stack of the loading items
+    if (map->eager)
+    {
+        // load items
+        path[depth] = index;
+        if (!tb_object_bplist_reader_map_load(map, object, refs, count, path, depth + 1))
+        {
+            tb_object_exit(object);
+            object = tb_null;
+        }
+        return object;
+    }
+
+    // make lazy with the path of this container
+    tb_object_bplist_lazy_t* lazy = (tb_object_bplist_lazy_t*)tb_malloc0(sizeof(tb_object_bplist_lazy_t) + (depth + 1) * sizeof(tb_size_t));
+    if (lazy)
+    {
+        // init lazy
+        lazy->base.load = tb_object_bplist_reader_lazy_load;
+        lazy->base.exit = tb_object_bplist_reader_lazy_exit;
+        lazy->refs      = refs;
+        lazy->count     = count;
+
+        // init path
+        lazy->path      = (tb_size_t*)&lazy[1];
+        lazy->depth     = depth + 1;
+        if (depth) tb_memcpy(lazy->path, path, depth * sizeof(tb_size_t));
+        lazy->path[depth] = index;
+
+        // refer the map
+        lazy->map       = map;
+        tb_atomic_fetch_and_inc(&map->refn);
+
+        // load the items on the first access
+        if (tb_object_type(object) == TB_OBJECT_TYPE_ARRAY) tb_object_array_lazy_set(object, (tb_object_lazy_ref_t)lazy);
+        else tb_object_dictionary_lazy_set(object, (tb_object_lazy_ref_t)lazy);
+    }
+    else
+    {
+        tb_object_exit(object);
+        object = tb_null;
+    }
+
+    // ok?
+    return object;
+}
+static tb_object_ref_t tb_object_bplist_reader_map_object(tb_object_bplist_map_t* map, tb_size_t index, tb_size_t* path, tb_size_t depth)
+{
+    // the object type, size and data
+    tb_size_t           type = 0;
+    tb_size_t           size = 0;
+    tb_size_t           left = 0;
+    tb_byte_t const*    p = tb_object_bplist_reader_map_head(map, index, &type, &size, &left);
+    tb_check_return_val(p, tb_null);
+
+    // trace
+    tb_trace_d("type: %x, size: %x", type, size);
+
+    // done
+    tb_object_ref_t object = tb_null;
+    switch (type)
+    {
+    case TB_OBJECT_BPLIST_TYPE_NONE:
+        {
+            // the boolean 
+            tb_assert_and_check_break(size == TB_OBJECT_BPLIST_TYPE_TRUE || size == TB_OBJECT_BPLIST_TYPE_FALSE);
+            object = tb_object_boolean_init(size == TB_OBJECT_BPLIST_TYPE_TRUE);
+        }
+        break;
+    case TB_OBJECT_BPLIST_TYPE_UINT:
+    case TB_OBJECT_BPLIST_TYPE_REAL:
+        {
+            // the number
+            size = (tb_size_t)1 << size;
+            tb_assert_and_check_break(size <= left);
+            object = tb_object_bplist_reader_map_number(type, p, size);
+        }
+        break;
+    case TB_OBJECT_BPLIST_TYPE_DATE:
+        {
+            // the date data
+            size = (tb_size_t)1 << size;
+            tb_assert_and_check_break(size <= left);
+            tb_object_ref_t data = tb_object_bplist_reader_map_number(TB_OBJECT_BPLIST_TYPE_REAL, p, size);
+            tb_assert_and_check_break(data);
+
+            // init date
+            object = tb_object_date_init_from_time(tb_object_bplist_reader_time_apple2host((tb_time_t)tb_object_number_uint64(data)));
+
+            // exit data
+            tb_object_exit(data);
+        }
+        break;
+    case TB_OBJECT_BPLIST_TYPE_DATA:
+        {
+            // the data
+            p = tb_object_bplist_reader_map_size(p, &size, &left);
+            tb_assert_and_check_break(p && size <= left);
+            object = tb_object_bplist_reader_map_data(p, size);
+        }
+        break;
+    case TB_OBJECT_BPLIST_TYPE_STRING:
+    case TB_OBJECT_BPLIST_TYPE_UNICODE:
+        {
+            // the string
+            p = tb_object_bplist_reader_map_size(p, &size, &left);
+            tb_assert_and_check_break(p && (type == TB_OBJECT_BPLIST_TYPE_STRING? size : size << 1) <= left);
+            object = tb_object_bplist_reader_map_string(type, p, size);
+        }
+        break;
+    case TB_OBJECT_BPLIST_TYPE_UID:
+    case TB_OBJECT_BPLIST_TYPE_ARRAY:
+        {
+            // the item refs
+            p = tb_object_bplist_reader_map_size(p, &size, &left);
+            tb_assert_and_check_break(p && size <= left / map->item_size);
+
+            // check path
+            if (!tb_object_bplist_reader_map_path(index, path, depth)) break;
+
+            // init array
+            object = tb_object_array_init(size? size : 16, tb_false);
+            tb_assert_and_check_break(object);
+
+            // init items
+            object = tb_object_bplist_reader_map_items(map, object, index, p, size, path, depth);
+        }
+        break;
+    case TB_OBJECT_BPLIST_TYPE_SET:
+    case TB_OBJECT_BPLIST_TYPE_DICT:
+        {
+            // the key and val refs
+            p = tb_object_bplist_reader_map_size(p, &size, &left);
+            tb_assert_and_check_break(p && size <= left / (map->item_size << 1));
+
+            // check path
+            if (!tb_object_bplist_reader_map_path(index, path, depth)) break;
+
+            // init dictionary
+            object = tb_object_dictionary_init(TB_OBJECT_DICTIONARY_SIZE_MICRO, tb_false);
+            tb_assert_and_check_break(object);
+
+            // init items
+            object = tb_object_bplist_reader_map_items(map, object, index, p, size, path, depth);
+        }
+        break;
+    default:
+        break;
+    }
+
+    // ok?
+    return object;
+}
+static tb_bool_t tb_object_bplist_reader_done_map(tb_stream_ref_t stream, tb_object_ref_t* proot)
+{
+    // check
+    tb_assert_and_check_return_val(stream && proot, tb_false);
+
+    // only for the file stream with random access, and the reader has not been hooked
+    tb_check_return_val(!g_hooked && tb_stream_type(stream) == TB_STREAM_TYPE_FILE && !tb_stream_offset(stream), tb_false);
+
+    // the file
+    tb_file_ref_t file = tb_null;
+    if (!tb_stream_ctrl(stream, TB_STREAM_CTRL_FILE_GET_FILE, &file) || !file) return tb_false;
+
+    // map the whole file
+    tb_size_t           size = 0;
+    tb_byte_t const*    data = tb_file_mmap(file, &size);
+    tb_check_return_val(data, tb_false);
+
+    // init map
+    tb_object_bplist_map_t* map = tb_malloc0_type(tb_object_bplist_map_t);
+    if (!map)
+    {
+        tb_file_munmap(data, size);
+        return tb_false;
+    }
+    map->refn = 1;
+    map->data = data;
+    map->size = size;
+
+    // done
+    tb_object_ref_t root = tb_null;
+    tb_size_t       path[TB_OBJECT_BPLIST_READER_MAP_DEPTH];
+    do
+    {
+        // check magic & version
+        tb_assert_and_check_break(size > 8 + 26 && !tb_strncmp((tb_char_t const*)data, "bplist00", 8));
+
+        // the tail
+        tb_byte_t const* tail = data + size - 26;
+
+        // the offset size and the item size for array and dictionary
+        map->offset_size = tail[0];
+        map->item_size   = tail[1];
+
+        // the object count, root object and offset table index
+        tb_uint64_t object_count        = tb_bits_get_u64_be(tail + 2);
+        tb_uint64_t root_object         = tb_bits_get_u64_be(tail + 10);
+        tb_uint64_t offset_table_index  = tb_bits_get_u64_be(tail + 18);
+
+        // trace
+        tb_trace_d("offset_size: %lu",          map->offset_size);
+        tb_trace_d("item_size: %lu",            map->item_size);
+        tb_trace_d("object_count: %llu",        object_count);
+        tb_trace_d("root_object: %llu",         root_object);
+        tb_trace_d("offset_table_index: %llu",  offset_table_index);
+
+        // check
+        tb_assert_and_check_break(map->offset_size && map->offset_size <= 8 && !(map->offset_size & (map->offset_size - 1)));
+        tb_assert_and_check_break(map->item_size && map->item_size <= 8 && !(map->item_size & (map->item_size - 1)));
+        tb_assert_and_check_break(offset_table_index > 8 && offset_table_index <= size - 26);
+        tb_assert_and_check_break(object_count && object_count <= (size - 26 - offset_table_index) / map->offset_size);
+        tb_assert_and_check_break(root_object < object_count);
+
+        // init the offset table
+        map->offset_table   = data + offset_table_index;
+        map->object_count   = (tb_size_t)object_count;
+
+        // load all items at once if reading into the arena
+        map->eager          = tb_object_arena_self()? tb_true : tb_false;
+
+        // read the root object
+        root = tb_object_bplist_reader_map_object(map, (tb_size_t)root_object, path, 0);
+
+    } while (0);
+
+    // exit map, the lazy items will unmap it
+    tb_object_bplist_reader_map_exit(map);
+
+    // ok
+    *proot = root;
+    return tb_true;
+}
+static tb_object_ref_t tb_object_bplist_reader_done_stream(tb_stream_ref_t stream)
 {
     // check
     tb_assert_and_check_return_val(stream, tb_null);
@@ -607,7 +1200,7 @@ static tb_object_ref_t tb_object_bplist_reader_done(tb_stream_ref_t stream)
 
                                 // walk items
                                 tb_size_t j = 0;
-                                for (i = 0; j < count; j++)
+                                for (j = 0; j < count; j++)
                                 {
                                     // the item index
                                     tb_size_t item = tb_object_bplist_bits_get(p + j * item_size, item_size);
@@ -643,7 +1236,7 @@ static tb_object_ref_t tb_object_bplist_reader_done(tb_stream_ref_t stream)
 
                                 // walk items
                                 tb_size_t j = 0;
-                                for (i = 0; j < count; j++)
+                                for (j = 0; j < count; j++)
                                 {
                                     // the key and val
                                     tb_size_t key = tb_object_bplist_bits_get(p + j * item_size, item_size);
@@ -707,6 +1300,15 @@ static tb_object_ref_t tb_object_bplist_reader_done(tb_stream_ref_t stream)
     // ok?
     return root;
 }
+static tb_object_ref_t tb_object_bplist_reader_done(tb_stream_ref_t stream)
+{
+    // read it from the mapped file first, the items will be loaded lazily
+    tb_object_ref_t root = tb_null;
+    if (tb_object_bplist_reader_done_map(stream, &root)) return root;
+
+    // read it from the stream
+    return tb_object_bplist_reader_done_stream(stream);
+}
 static tb_size_t tb_object_bplist_reader_probe(tb_stream_ref_t stream)
 {
     // check
@@ -765,6 +1367,9 @@ tb_bool_t tb_object_bplist_reader_hook(tb_size_t type, tb_object_bplist_reader_f
     // hook it
     tb_hash_map_insert(reader->hooker, (tb_pointer_t)type, func);
 
+    // the hooked func is only used for reading the stream
+    g_hooked = tb_true;
+
     // ok
     return tb_true;
 }
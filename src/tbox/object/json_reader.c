@@ -0,0 +1,817 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        json_reader.c
+ * @ingroup     object
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                    "json_reader"
+#define TB_TRACE_MODULE_DEBUG                   (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "json_reader.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the scan buffer size, it will be grown if one token is larger than it
+#ifdef __tb_small__
+#   define TB_JSON_READER_BUFFER_MAXN           (8192)
+#else
+#   define TB_JSON_READER_BUFFER_MAXN           (65536)
+#endif
+
+// the level maxn
+#define TB_JSON_READER_LEVEL_MAXN               (256)
+
+// the number maxn
+#define TB_JSON_READER_NUMBER_MAXN              (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the json reader impl type
+typedef struct __tb_json_reader_impl_t
+{
+    // the event
+    tb_size_t               event;
+
+    // the level
+    tb_size_t               level;
+
+    // is bowner of the stream?
+    tb_bool_t               bowner;
+
+    // is failed?
+    tb_bool_t               failed;
+
+    // is the first item of the current object or array?
+    tb_bool_t               first;
+
+    // the key has been read and need the value now?
+    tb_bool_t               value;
+
+    // the root value has been read?
+    tb_bool_t               root;
+
+    // the stream
+    tb_stream_ref_t         stream;
+
+    /* the scan buffer
+     *
+     * data: |-- scanned --|-- head: the current token .. --|-- tail --|-- maxn --|
+     */
+    tb_byte_t*              data;
+
+    // the scan buffer maxn
+    tb_size_t               maxn;
+
+    // the scan buffer head
+    tb_size_t               head;
+
+    // the scan buffer tail
+    tb_size_t               tail;
+
+    // the current string, it is unescaped in the scan buffer
+    tb_char_t const*        string;
+
+    // the current string size
+    tb_size_t               string_size;
+
+    // the current number is float?
+    tb_bool_t               number_float;
+
+    // the current number
+    tb_char_t               number[TB_JSON_READER_NUMBER_MAXN];
+
+    // the container stack, '{' or '['
+    tb_byte_t               stack[TB_JSON_READER_LEVEL_MAXN];
+
+}tb_json_reader_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_json_reader_fill(tb_json_reader_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->stream && impl->data, tb_false);
+
+    // move the current token to the buffer head
+    if (impl->head)
+    {
+        if (impl->tail > impl->head) tb_memmov(impl->data, impl->data + impl->head, impl->tail - impl->head);
+        impl->tail -= impl->head;
+        impl->head = 0;
+    }
+
+    // full? grow it, the current token is too large
+    if (impl->tail == impl->maxn)
+    {
+        // grow data, reserve one byte for the string terminator
+        tb_size_t maxn = impl->maxn << 1;
+        tb_byte_t* data = (tb_byte_t*)tb_ralloc(impl->data, maxn + 1);
+        tb_assert_and_check_return_val(data, tb_false);
+
+        // save data
+        impl->data = data;
+        impl->maxn = maxn;
+    }
+
+    // end? the empty file has no eof state
+    tb_hong_t size = tb_stream_size(impl->stream);
+    if (size >= 0 && !tb_stream_left(impl->stream)) return tb_false;
+
+    // read the next data block
+    while (!tb_stream_beof(impl->stream))
+    {
+        // read data
+        tb_long_t real = tb_stream_read(impl->stream, impl->data + impl->tail, impl->maxn - impl->tail);
+
+        // ok?
+        if (real > 0) 
+        {
+            impl->tail += real;
+            return tb_true;
+        }
+        // no data? wait it
+        else if (!real)
+        {
+            // wait
+            real = tb_stream_wait(impl->stream, TB_STREAM_WAIT_READ, tb_stream_timeout(impl->stream));
+            tb_check_break(real > 0);
+
+            // has read?
+            tb_assert_and_check_break(real & TB_STREAM_WAIT_READ);
+        }
+        // failed or end?
+        else break;
+    }
+
+    // end
+    return tb_false;
+}
+static tb_bool_t tb_json_reader_need(tb_json_reader_impl_t* impl, tb_size_t size)
+{
+    // fill it until the data is enough
+    while (impl->tail - impl->head < size)
+    {
+        if (!tb_json_reader_fill(impl)) return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_long_t tb_json_reader_space(tb_json_reader_impl_t* impl)
+{
+    while (1)
+    {
+        // the data
+        tb_byte_t const* p = impl->data + impl->head;
+        tb_byte_t const* e = impl->data + impl->tail;
+
+        // not space? return it directly, the minified json has no space mostly
+        if (p < e && !tb_isspace(*p)) return *p;
+
+#ifdef TB_ARCH_SSE2
+        // skip the spaces of the pretty json by 16-bytes
+        __m128i space   = _mm_set1_epi8(' ');
+        __m128i tab     = _mm_set1_epi8('\t');
+        __m128i lf      = _mm_set1_epi8('\n');
+        __m128i cr      = _mm_set1_epi8('\r');
+        while (p + 16 <= e)
+        {
+            __m128i     v = _mm_loadu_si128((__m128i const*)p);
+            __m128i     s = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)), _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+            tb_uint32_t m = ~(tb_uint32_t)_mm_movemask_epi8(s) & 0xffff;
+            if (m) 
+            {
+                p += tb_bits_fb1_u32_le(m);
+                break;
+            }
+            p += 16;
+        }
+#endif
+
+        // skip the left spaces
+        while (p < e && tb_isspace(*p)) p++;
+
+        // save head
+        impl->head = p - impl->data;
+
+        // found?
+        if (p < e) return *p;
+
+        // end?
+        if (!tb_json_reader_fill(impl)) return -1;
+    }
+
+    // unreachable
+    return -1;
+}
+static __tb_inline__ tb_size_t tb_json_reader_scan(tb_byte_t const* p, tb_size_t i, tb_size_t n)
+{
+#ifdef TB_ARCH_SSE2
+    // find the quote or backslash by 16-bytes
+    __m128i quote       = _mm_set1_epi8('\"');
+    __m128i backslash   = _mm_set1_epi8('\\');
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i     v = _mm_loadu_si128((__m128i const*)(p + i));
+        tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+        if (m) return i + tb_bits_fb1_u32_le(m);
+    }
+#endif
+
+    // find the left characters
+    for (; i < n && p[i] != '\"' && p[i] != '\\'; i++) ;
+
+    // ok
+    return i;
+}
+static tb_long_t tb_json_reader_hex4(tb_byte_t const* p, tb_byte_t const* e)
+{
+    // check
+    tb_check_return_val(p + 4 <= e, -1);
+
+    // done
+    tb_long_t   i = 0;
+    tb_uint32_t v = 0;
+    for (i = 0; i < 4; i++)
+    {
+        tb_byte_t ch = p[i];
+        if (ch >= '0' && ch <= '9') v = (v << 4) | (ch - '0');
+        else if (ch >= 'a' && ch <= 'f') v = (v << 4) | (ch - 'a' + 10);
+        else if (ch >= 'A' && ch <= 'F') v = (v << 4) | (ch - 'A' + 10);
+        else return -1;
+    }
+
+    // ok
+    return (tb_long_t)v;
+}
+static tb_size_t tb_json_reader_utf8(tb_byte_t* q, tb_uint32_t ch)
+{
+    if (ch < 0x80)
+    {
+        q[0] = (tb_byte_t)ch;
+        return 1;
+    }
+    else if (ch < 0x800)
+    {
+        q[0] = (tb_byte_t)(0xc0 | (ch >> 6));
+        q[1] = (tb_byte_t)(0x80 | (ch & 0x3f));
+        return 2;
+    }
+    else if (ch < 0x10000)
+    {
+        q[0] = (tb_byte_t)(0xe0 | (ch >> 12));
+        q[1] = (tb_byte_t)(0x80 | ((ch >> 6) & 0x3f));
+        q[2] = (tb_byte_t)(0x80 | (ch & 0x3f));
+        return 3;
+    }
+    q[0] = (tb_byte_t)(0xf0 | (ch >> 18));
+    q[1] = (tb_byte_t)(0x80 | ((ch >> 12) & 0x3f));
+    q[2] = (tb_byte_t)(0x80 | ((ch >> 6) & 0x3f));
+    q[3] = (tb_byte_t)(0x80 | (ch & 0x3f));
+    return 4;
+}
+static tb_bool_t tb_json_reader_unescape(tb_json_reader_impl_t* impl, tb_byte_t* data, tb_size_t size)
+{
+    // unescape it in place, the unescaped string is always shorter than the escaped string
+    tb_byte_t*          q = data;
+    tb_byte_t const*    p = data;
+    tb_byte_t const*    e = data + size;
+    while (p < e)
+    {
+        // not escaped?
+        if (*p != '\\') 
+        {
+            *q++ = *p++;
+            continue;
+        }
+
+        // the escaped character
+        tb_check_return_val(++p < e, tb_false);
+        switch (*p++)
+        {
+        case '\"':  *q++ = '\"'; break;
+        case '\\':  *q++ = '\\'; break;
+        case '/':   *q++ = '/'; break;
+        case 'b':   *q++ = '\b'; break;
+        case 'f':   *q++ = '\f'; break;
+        case 'n':   *q++ = '\n'; break;
+        case 'r':   *q++ = '\r'; break;
+        case 't':   *q++ = '\t'; break;
+        case 'u':   
+            {
+                // the unicode
+                tb_long_t ch = tb_json_reader_hex4(p, e);
+                tb_check_return_val(ch >= 0, tb_false);
+                p += 4;
+
+                // the surrogate pair?
+                if (ch >= 0xd800 && ch < 0xdc00 && p + 6 <= e && p[0] == '\\' && p[1] == 'u')
+                {
+                    tb_long_t lo = tb_json_reader_hex4(p + 2, e);
+                    if (lo >= 0xdc00 && lo < 0xe000)
+                    {
+                        ch = 0x10000 + ((ch - 0xd800) << 10) + (lo - 0xdc00);
+                        p += 6;
+                    }
+                }
+
+                // save the utf8 characters
+                q += tb_json_reader_utf8(q, (tb_uint32_t)ch);
+            }
+            break;
+        default:
+            return tb_false;
+        }
+    }
+
+    // save string
+    *q = '\0';
+    impl->string        = (tb_char_t const*)data;
+    impl->string_size   = q - data;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_json_reader_string_read(tb_json_reader_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl->head < impl->tail && impl->data[impl->head] == '\"', tb_false);
+
+    // find the end quote, the head is kept at the begin quote and the data maybe be moved after filling it
+    tb_size_t i = 1;
+    tb_bool_t escaped = tb_false;
+    while (1)
+    {
+        // the data
+        tb_byte_t const*    p = impl->data + impl->head;
+        tb_size_t           n = impl->tail - impl->head;
+
+        // scan the quote or backslash
+        i = tb_json_reader_scan(p, i, n);
+        if (i < n)
+        {
+            // end?
+            if (p[i] == '\"') break;
+
+            // skip the escaped character
+            if (i + 1 < n)
+            {
+                escaped = tb_true;
+                i += 2;
+                continue;
+            }
+        }
+
+        // need more data
+        if (!tb_json_reader_fill(impl)) return tb_false;
+    }
+
+    // the string data
+    tb_byte_t*  data = impl->data + impl->head + 1;
+    tb_size_t   size = i - 1;
+
+    // skip the string
+    impl->head += i + 1;
+
+    // escaped? unescape it
+    if (escaped) return tb_json_reader_unescape(impl, data, size);
+
+    // save string, the end quote is replaced with the terminator
+    data[size] = '\0';
+    impl->string        = (tb_char_t const*)data;
+    impl->string_size   = size;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_json_reader_number_read(tb_json_reader_impl_t* impl)
+{
+    // find the number end
+    tb_size_t i = 0;
+    tb_bool_t bf = tb_false;
+    while (1)
+    {
+        // the data
+        tb_byte_t const*    p = impl->data + impl->head;
+        tb_size_t           n = impl->tail - impl->head;
+
+        // scan the number characters
+        for (; i < n; i++)
+        {
+            tb_byte_t ch = p[i];
+            if (tb_isdigit10(ch) || ch == '-' || ch == '+') continue;
+            if (ch == '.' || ch == 'e' || ch == 'E') bf = tb_true;
+            else break;
+        }
+
+        // end?
+        if (i < n || !tb_json_reader_fill(impl)) break;
+    }
+
+    // check
+    tb_check_return_val(i && i < TB_JSON_READER_NUMBER_MAXN, tb_false);
+
+    // save number
+    tb_memcpy(impl->number, impl->data + impl->head, i);
+    impl->number[i]     = '\0';
+    impl->number_float  = bf;
+
+    // skip it
+    impl->head += i;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_json_reader_literal_read(tb_json_reader_impl_t* impl, tb_char_t const* literal, tb_size_t size)
+{
+    // need the literal data
+    tb_check_return_val(tb_json_reader_need(impl, size), tb_false);
+
+    // check it
+    tb_check_return_val(!tb_memcmp(impl->data + impl->head, literal, size), tb_false);
+
+    // skip it
+    impl->head += size;
+
+    // ok
+    return tb_true;
+}
+static tb_size_t tb_json_reader_value_read(tb_json_reader_impl_t* impl, tb_long_t ch)
+{
+    // done
+    tb_size_t event = TB_JSON_READER_EVENT_NONE;
+    switch (ch)
+    {
+    case '{':
+    case '[':
+        {
+            // check
+            tb_assert_and_check_break(impl->level < TB_JSON_READER_LEVEL_MAXN);
+
+            // enter it
+            impl->stack[impl->level++] = (tb_byte_t)ch;
+            impl->first = tb_true;
+            impl->head++;
+
+            // ok
+            event = ch == '{'? TB_JSON_READER_EVENT_OBJECT_BEG : TB_JSON_READER_EVENT_ARRAY_BEG;
+        }
+        break;
+    case '\"':
+        if (tb_json_reader_string_read(impl)) event = TB_JSON_READER_EVENT_STRING;
+        break;
+    case 't':
+        if (tb_json_reader_literal_read(impl, "true", 4)) event = TB_JSON_READER_EVENT_TRUE;
+        break;
+    case 'f':
+        if (tb_json_reader_literal_read(impl, "false", 5)) event = TB_JSON_READER_EVENT_FALSE;
+        break;
+    case 'n':
+        if (tb_json_reader_literal_read(impl, "null", 4)) event = TB_JSON_READER_EVENT_NULL;
+        break;
+    default:
+        if ((ch == '-' || tb_isdigit10(ch)) && tb_json_reader_number_read(impl)) event = TB_JSON_READER_EVENT_NUMBER;
+        break;
+    }
+
+    // the root scalar value has been read?
+    if (event && !impl->level) impl->root = tb_true;
+
+    // ok?
+    return event;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_json_reader_ref_t tb_json_reader_init()
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_json_reader_impl_t*  impl = tb_null;
+    do
+    {
+        // make reader
+        impl = tb_malloc0_type(tb_json_reader_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init the scan buffer, reserve one byte for the string terminator
+        impl->maxn = TB_JSON_READER_BUFFER_MAXN;
+        impl->data = tb_malloc_bytes(impl->maxn + 1);
+        tb_assert_and_check_break(impl->data);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_json_reader_exit((tb_json_reader_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (tb_json_reader_ref_t)impl;
+}
+tb_void_t tb_json_reader_exit(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return(impl);
+
+    // clos it first
+    tb_json_reader_clos(reader);
+
+    // exit data
+    if (impl->data) tb_free(impl->data);
+    impl->data = tb_null;
+
+    // free it
+    tb_free(impl);
+}
+tb_bool_t tb_json_reader_open(tb_json_reader_ref_t reader, tb_stream_ref_t stream, tb_bool_t bowner)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->data && stream, tb_false);
+
+    // check
+    tb_assert_and_check_return_val(!impl->stream, tb_false);
+
+    // init stream
+    impl->stream = stream;
+    impl->bowner = bowner;
+
+    // open the stream if be not opened
+    if (!tb_stream_is_opened(stream) && !tb_stream_open(stream)) 
+    {
+        tb_json_reader_clos(reader);
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_void_t tb_json_reader_clos(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return(impl);
+
+    // exit the stream
+    if (impl->stream && impl->bowner) tb_stream_exit(impl->stream);
+    impl->stream = tb_null;
+
+    // clear state
+    impl->event         = TB_JSON_READER_EVENT_NONE;
+    impl->level         = 0;
+    impl->bowner        = tb_false;
+    impl->failed        = tb_false;
+    impl->first         = tb_false;
+    impl->value         = tb_false;
+    impl->root          = tb_false;
+    impl->head          = 0;
+    impl->tail          = 0;
+    impl->string        = tb_null;
+    impl->string_size   = 0;
+    impl->number[0]     = '\0';
+    impl->number_float  = tb_false;
+}
+tb_size_t tb_json_reader_next(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->stream, TB_JSON_READER_EVENT_NONE);
+
+    // failed?
+    tb_check_return_val(!impl->failed, TB_JSON_READER_EVENT_NONE);
+
+    // done
+    tb_bool_t failed = tb_false;
+    tb_size_t event = TB_JSON_READER_EVENT_NONE;
+    do
+    {
+        // the next character
+        tb_long_t ch = tb_json_reader_space(impl);
+
+        // end? the root value must be read and all objects and arrays must be closed
+        if (ch < 0)
+        {
+            failed = impl->level || !impl->root;
+            break;
+        }
+
+        // the root value has been read? the trailing characters are invalid
+        if (!impl->level && impl->root)
+        {
+            failed = tb_true;
+            break;
+        }
+
+        // in object or array?
+        if (impl->level)
+        {
+            // the container type
+            tb_byte_t type = impl->stack[impl->level - 1];
+
+            // the key has been read? read the value after ':'
+            if (impl->value)
+            {
+                // skip ':'
+                if (ch != ':')
+                {
+                    failed = tb_true;
+                    break;
+                }
+                impl->head++;
+
+                // the value character
+                ch = tb_json_reader_space(impl);
+            }
+            else
+            {
+                // end?
+                if (ch == (type == '{'? '}' : ']'))
+                {
+                    // leave it
+                    impl->head++;
+                    impl->level--;
+                    impl->first = tb_false;
+                    if (!impl->level) impl->root = tb_true;
+
+                    // ok
+                    event = type == '{'? TB_JSON_READER_EVENT_OBJECT_END : TB_JSON_READER_EVENT_ARRAY_END;
+                    break;
+                }
+
+                // skip ',' if be not the first item
+                if (!impl->first)
+                {
+                    if (ch != ',') 
+                    {
+                        failed = tb_true;
+                        break;
+                    }
+                    impl->head++;
+                    ch = tb_json_reader_space(impl);
+                }
+                impl->first = tb_false;
+
+                // read key for object
+                if (type == '{')
+                {
+                    // read key, need read the value next time
+                    if (ch == '\"' && tb_json_reader_string_read(impl))
+                    {
+                        impl->value = tb_true;
+                        event = TB_JSON_READER_EVENT_KEY;
+                    }
+                    else failed = tb_true;
+                    break;
+                }
+            }
+
+            // clear the key state
+            impl->value = tb_false;
+        }
+
+        // read value
+        event = ch >= 0? tb_json_reader_value_read(impl, ch) : TB_JSON_READER_EVENT_NONE;
+        if (!event) failed = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (failed)
+    {
+        // trace
+        tb_trace_d("invalid json at level: %lu", impl->level);
+
+        // save state
+        impl->failed = tb_true;
+        event = TB_JSON_READER_EVENT_NONE;
+    }
+
+    // save event
+    impl->event = event;
+
+    // ok?
+    return event;
+}
+tb_bool_t tb_json_reader_failed(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_true);
+
+    // failed?
+    return impl->failed;
+}
+tb_stream_ref_t tb_json_reader_stream(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the stream
+    return impl->stream;
+}
+tb_size_t tb_json_reader_level(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the level
+    return impl->level;
+}
+tb_char_t const* tb_json_reader_string(tb_json_reader_ref_t reader, tb_size_t* size)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_null);
+    tb_check_return_val(impl->event == TB_JSON_READER_EVENT_KEY || impl->event == TB_JSON_READER_EVENT_STRING, tb_null);
+
+    // save size
+    if (size) *size = impl->string_size;
+
+    // the string
+    return impl->string;
+}
+tb_char_t const* tb_json_reader_number(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_null);
+    tb_check_return_val(impl->event == TB_JSON_READER_EVENT_NUMBER, tb_null);
+
+    // the number
+    return impl->number;
+}
+tb_bool_t tb_json_reader_number_is_float(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->event == TB_JSON_READER_EVENT_NUMBER, tb_false);
+
+    // is float?
+    return impl->number_float;
+}
+tb_sint64_t tb_json_reader_number_sint64(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->event == TB_JSON_READER_EVENT_NUMBER, 0);
+
+    // the integer value
+    return tb_s10toi64(impl->number);
+}
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+tb_double_t tb_json_reader_number_double(tb_json_reader_ref_t reader)
+{
+    // check
+    tb_json_reader_impl_t* impl = (tb_json_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && impl->event == TB_JSON_READER_EVENT_NUMBER, 0);
+
+    // the float value
+    return tb_s10tod(impl->number);
+}
+#endif
@@ -0,0 +1,213 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        json_reader.h
+ * @ingroup     object
+ *
+ */
+#ifndef TB_OBJECT_JSON_READER_H
+#define TB_OBJECT_JSON_READER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the json reader event type for iterator
+typedef enum __tb_json_reader_event_t
+{
+    TB_JSON_READER_EVENT_NONE                   = 0
+,   TB_JSON_READER_EVENT_OBJECT_BEG             = 1
+,   TB_JSON_READER_EVENT_OBJECT_END             = 2
+,   TB_JSON_READER_EVENT_ARRAY_BEG              = 3
+,   TB_JSON_READER_EVENT_ARRAY_END              = 4
+,   TB_JSON_READER_EVENT_KEY                    = 5
+,   TB_JSON_READER_EVENT_STRING                 = 6
+,   TB_JSON_READER_EVENT_NUMBER                 = 7
+,   TB_JSON_READER_EVENT_TRUE                   = 8
+,   TB_JSON_READER_EVENT_FALSE                  = 9
+,   TB_JSON_READER_EVENT_NULL                   = 10
+
+}tb_json_reader_event_t;
+
+/// the json reader ref type
+typedef struct{}*       tb_json_reader_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the json reader
+ *
+ * the json reader is a pull parser, it scans the bulk buffer read from the stream 
+ * and reports the events without building the object tree.
+ *
+ * @return              the reader 
+ */
+tb_json_reader_ref_t    tb_json_reader_init(tb_noarg_t);
+
+/*! exit the json reader
+ *
+ * @param reader        the json reader
+ */
+tb_void_t               tb_json_reader_exit(tb_json_reader_ref_t reader);
+
+/*! open the json reader
+ *
+ * @param reader        the json reader
+ * @param stream        the stream, will open it if be not opened
+ * @param bowner        the json reader is owner of the stream?
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_json_reader_open(tb_json_reader_ref_t reader, tb_stream_ref_t stream, tb_bool_t bowner);
+
+/*! clos the json reader
+ *
+ * @param reader        the json reader
+ */
+tb_void_t               tb_json_reader_clos(tb_json_reader_ref_t reader);
+
+/*! the next iterator for the json reader
+ *
+ * @param reader        the json reader
+ *
+ * @return              the iterator event, end or failed: TB_JSON_READER_EVENT_NONE
+ *
+ * @code
+    // init reader
+    tb_json_reader_ref_t reader = tb_json_reader_init();
+    if (reader)
+    {
+        // open reader
+        if (tb_json_reader_open(reader, tb_stream_init_from_url(argv[1]), tb_true))
+        {
+            // walk
+            tb_size_t event = TB_JSON_READER_EVENT_NONE;
+            while ((event = tb_json_reader_next(reader)))
+            {
+                switch (event)
+                {
+                case TB_JSON_READER_EVENT_KEY:
+                    tb_printf("%s: ", tb_json_reader_string(reader, tb_null));
+                    break;
+                case TB_JSON_READER_EVENT_STRING:
+                    tb_printf("\"%s\"\n", tb_json_reader_string(reader, tb_null));
+                    break;
+                case TB_JSON_READER_EVENT_NUMBER:
+                    tb_printf("%s\n", tb_json_reader_number(reader));
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            // failed?
+            if (tb_json_reader_failed(reader)) tb_trace_e("invalid json!");
+        }
+
+        // exit reader
+        tb_json_reader_exit(reader);
+    }
+ * @endcode
+ */
+tb_size_t               tb_json_reader_next(tb_json_reader_ref_t reader);
+
+/*! the json reader is failed? 
+ *
+ * @param reader        the json reader
+ *
+ * @return              tb_true if the json is invalid or the stream has been broken
+ */
+tb_bool_t               tb_json_reader_failed(tb_json_reader_ref_t reader);
+
+/*! the json stream
+ *
+ * @param reader        the json reader
+ *
+ * @return              the json stream
+ */
+tb_stream_ref_t         tb_json_reader_stream(tb_json_reader_ref_t reader);
+
+/*! the json level
+ *
+ * @param reader        the json reader
+ *
+ * @return              the nesting level of the current object or array
+ */
+tb_size_t               tb_json_reader_level(tb_json_reader_ref_t reader);
+
+/*! the current key or string
+ *
+ * @param reader        the json reader
+ * @param size          the string size, optional
+ *
+ * @return              the unescaped c-string, it is only valid before the next iterator
+ */
+tb_char_t const*        tb_json_reader_string(tb_json_reader_ref_t reader, tb_size_t* size);
+
+/*! the current number text
+ *
+ * @param reader        the json reader
+ *
+ * @return              the number c-string, it is only valid before the next iterator
+ */
+tb_char_t const*        tb_json_reader_number(tb_json_reader_ref_t reader);
+
+/*! the current number is float?
+ *
+ * @param reader        the json reader
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_json_reader_number_is_float(tb_json_reader_ref_t reader);
+
+/*! the current number value for integer
+ *
+ * @param reader        the json reader
+ *
+ * @return              the integer value
+ */
+tb_sint64_t             tb_json_reader_number_sint64(tb_json_reader_ref_t reader);
+
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+/*! the current number value for float
+ *
+ * @param reader        the json reader
+ *
+ * @return              the float value
+ */
+tb_double_t             tb_json_reader_number_double(tb_json_reader_ref_t reader);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
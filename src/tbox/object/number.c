@@ -32,6 +32,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
  
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -189,12 +190,13 @@ static tb_object_number_t* tb_object_number_init_base()
     tb_object_number_t*     number = tb_null;
     do
     {
-        // make number
-        number = tb_malloc0_type(tb_object_number_t);
+        // make number, allocate it from the arena if be reading into the arena
+        tb_object_arena_ref_t arena = tb_object_arena_self();
+        number = arena? (tb_object_number_t*)tb_object_arena_malloc0(arena, sizeof(tb_object_number_t)) : tb_malloc0_type(tb_object_number_t);
         tb_assert_and_check_break(number);
 
         // init number
-        if (!tb_object_init((tb_object_ref_t)number, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_NUMBER)) break;
+        if (!tb_object_init((tb_object_ref_t)number, arena? TB_OBJECT_FLAG_ARENA : TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_NUMBER)) break;
 
         // init base
         number->base.copy   = tb_object_number_copy;
@@ -88,6 +88,9 @@ tb_bool_t tb_object_init(tb_object_ref_t object, tb_size_t flag, tb_size_t type)
     // init
     tb_memset(object, 0, sizeof(tb_object_t));
     object->flag = (tb_uint8_t)flag;
+
+    // the arena object is readonly and will be freed with the arena only
+    if (flag & TB_OBJECT_FLAG_ARENA) object->flag |= TB_OBJECT_FLAG_READONLY;
     object->type = (tb_uint16_t)type;
     object->refn = 1;
 
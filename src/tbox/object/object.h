@@ -36,6 +36,8 @@
 #include "number.h"
 #include "boolean.h"
 #include "dictionary.h"
+#include "json_reader.h"
+#include "arena.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -58,6 +58,7 @@ typedef enum __tb_object_flag_e
     TB_OBJECT_FLAG_NONE         = 0
 ,   TB_OBJECT_FLAG_READONLY     = 1
 ,   TB_OBJECT_FLAG_SINGLETON    = 2
+,   TB_OBJECT_FLAG_ARENA        = 4     //!< allocated from the object arena and freed with it
 
 }tb_object_flag_e;
 
@@ -32,6 +32,7 @@
  * includes
  */
 #include "object.h"
+#include "impl/arena.h"
 #include "../string/string.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -51,6 +52,12 @@ typedef struct __tb_object_string_t
     // the object base
     tb_object_t         base;
 
+    // the arena string data, it is stored after the object and the str is not used
+    tb_char_t const*    data;
+
+    // the arena string size
+    tb_size_t           size;
+
     // the string
     tb_string_t         str;
 
@@ -74,7 +81,7 @@ static tb_object_ref_t tb_object_string_copy(tb_object_ref_t object)
 static tb_void_t tb_object_string_exit(tb_object_ref_t object)
 {
     tb_object_string_t* string = tb_object_string_cast(object);
-    if (string) 
+    if (string && !(object->flag & TB_OBJECT_FLAG_ARENA)) 
     {
         // exit the string
         tb_string_exit(&string->str);
@@ -86,25 +93,54 @@ static tb_void_t tb_object_string_exit(tb_object_ref_t object)
 static tb_void_t tb_object_string_clear(tb_object_ref_t object)
 {
     tb_object_string_t* string = tb_object_string_cast(object);
-    if (string) 
+    if (string && !string->data) 
     {
         // clear the string
         tb_string_clear(&string->str);
     }
 }
-static tb_object_string_t* tb_object_string_init_base()
+static tb_object_string_t* tb_object_string_init_base(tb_char_t const* cstr, tb_size_t size)
 {
     // done
     tb_bool_t            ok = tb_false;
     tb_object_string_t*  string = tb_null;
     do
     {
-        // make string
-        string = tb_malloc0_type(tb_object_string_t);
-        tb_assert_and_check_break(string);
-
-        // init string
-        if (!tb_object_init((tb_object_ref_t)string, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_STRING)) break;
+        // the arena
+        tb_object_arena_ref_t arena = tb_object_arena_self();
+        if (arena)
+        {
+            // make string and its data from the arena
+            string = (tb_object_string_t*)tb_object_arena_malloc0(arena, tb_offsetof(tb_object_string_t, str) + size + 1);
+            tb_assert_and_check_break(string);
+
+            // init string
+            if (!tb_object_init((tb_object_ref_t)string, TB_OBJECT_FLAG_ARENA, TB_OBJECT_TYPE_STRING)) break;
+
+            // copy data
+            tb_char_t* data = (tb_char_t*)string + tb_offsetof(tb_object_string_t, str);
+            if (cstr && size) tb_memcpy(data, cstr, size);
+            data[size] = '\0';
+
+            // save data
+            string->data = data;
+            string->size = size;
+        }
+        else
+        {
+            // make string
+            string = tb_malloc0_type(tb_object_string_t);
+            tb_assert_and_check_break(string);
+
+            // init string
+            if (!tb_object_init((tb_object_ref_t)string, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_STRING)) break;
+
+            // init str
+            if (!tb_string_init(&string->str)) break;
+
+            // copy string
+            if (cstr) tb_string_cstrncpy(&string->str, cstr, size);
+        }
 
         // init base
         string->base.copy   = tb_object_string_copy;
@@ -120,7 +156,7 @@ static tb_object_string_t* tb_object_string_init_base()
     if (!ok)
     {
         // exit it
-        if (string) tb_object_exit((tb_object_ref_t)string);
+        if (string) tb_object_string_exit((tb_object_ref_t)string);
         string = tb_null;
     }
 
@@ -133,69 +169,13 @@ static tb_object_string_t* tb_object_string_init_base()
  */
 tb_object_ref_t tb_object_string_init_from_cstr(tb_char_t const* cstr)
 {
-    // done
-    tb_bool_t           ok = tb_false;
-    tb_object_string_t* string = tb_null;
-    do
-    {
-        // make string
-        string = tb_object_string_init_base();
-        tb_assert_and_check_break(string);
-
-        // init str
-        if (!tb_string_init(&string->str)) break;
-
-        // copy string
-        if (cstr) tb_string_cstrcpy(&string->str, cstr);
-
-        // ok
-        ok = tb_true;
-
-    } while (0);
-
-    // failed?
-    if (!ok)
-    {
-        // exit it
-        tb_object_string_exit((tb_object_ref_t)string);
-        string = tb_null;
-    }
-
-    // ok?
-    return (tb_object_ref_t)string;
+    // make string
+    return (tb_object_ref_t)tb_object_string_init_base(cstr, cstr? tb_strlen(cstr) : 0);
 }
 tb_object_ref_t tb_object_string_init_from_str(tb_string_ref_t str)
 {
-    // done
-    tb_bool_t           ok = tb_false;
-    tb_object_string_t* string = tb_null;
-    do
-    {
-        // make string
-        string = tb_object_string_init_base();
-        tb_assert_and_check_break(string);
-
-        // init str
-        if (!tb_string_init(&string->str)) break;
-
-        // copy string
-        if (str) tb_string_strcpy(&string->str, str);
-
-        // ok
-        ok = tb_true;
-
-    } while (0);
-
-    // failed?
-    if (!ok)
-    {
-        // exit it
-        tb_object_string_exit((tb_object_ref_t)string);
-        string = tb_null;
-    }
-
-    // ok?
-    return (tb_object_ref_t)string;
+    // make string
+    return (tb_object_ref_t)tb_object_string_init_base(str? tb_string_cstr(str) : tb_null, str? tb_string_size(str) : 0);
 }
 tb_char_t const* tb_object_string_cstr(tb_object_ref_t object)
 {
@@ -204,7 +184,7 @@ tb_char_t const* tb_object_string_cstr(tb_object_ref_t object)
     tb_assert_and_check_return_val(string, tb_null);
 
     // cstr
-    return tb_string_cstr(&string->str);
+    return string->data? string->data : tb_string_cstr(&string->str);
 }
 tb_size_t tb_object_string_cstr_set(tb_object_ref_t object, tb_char_t const* cstr)
 {
@@ -212,6 +192,9 @@ tb_size_t tb_object_string_cstr_set(tb_object_ref_t object, tb_char_t const* cst
     tb_object_string_t* string = tb_object_string_cast(object);
     tb_assert_and_check_return_val(string && cstr, 0);
 
+    // the arena string is readonly
+    tb_assert_and_check_return_val(!string->data, string->size);
+
     // copy string
     tb_string_cstrcpy(&string->str, cstr);
  
@@ -225,6 +208,5 @@ tb_size_t tb_object_string_size(tb_object_ref_t object)
     tb_assert_and_check_return_val(string, 0);
 
     // size
-    return tb_string_size(&string->str);
+    return string->data? string->size : tb_string_size(&string->str);
 }
-
@@ -42,6 +42,18 @@
     {
         return tb_iocp_ptor_init(aicp);
     }
+#elif defined(TB_CONFIG_OS_LINUX) && defined(TB_CONFIG_ASIO_HAVE_URING)
+#   include "linux/aicp_uring.c"
+#   include "../asio/impl/aicp_aiop.c"
+    tb_aicp_ptor_impl_t* tb_aicp_ptor_impl_init(tb_aicp_impl_t* aicp)
+    {
+        /* using the io_uring proactor first and fall back to the aiop if the kernel is too old
+         *
+         * @note the io_uring proactor has no reactor shards, so the sharded aicp always uses the aiop
+         */
+        tb_aicp_ptor_impl_t* ptor = aicp->shard <= 1? tb_uring_ptor_init(aicp) : tb_null;
+        return ptor? ptor : tb_aiop_ptor_init(aicp);
+    }
 #else
 #   include "../asio/impl/aicp_aiop.c"
     tb_aicp_ptor_impl_t* tb_aicp_ptor_impl_init(tb_aicp_impl_t* aicp)
@@ -36,6 +36,9 @@
 #   ifndef tb_barrier
 #       define tb_barrier()             __tb_asm__ __tb_volatile__ ("" ::: "memory")
 #   endif
+#   ifndef tb_cpu_pause
+#       define tb_cpu_pause()           __tb_asm__ __tb_volatile__ ("pause" ::: "memory")
+#   endif
 #endif
 
 
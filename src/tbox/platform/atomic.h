@@ -124,6 +124,82 @@
 #   define tb_atomic_and_and_fetch(a, v)      (tb_atomic_fetch_and_and(a, v) & (v))
 #endif
 
+/* the memory order
+ *
+ * the generic implementation only supports the sequentially consistent order, 
+ * so all explicit operations will be the sequentially consistent operations if the compiler have not the memory model
+ */
+#ifndef TB_ATOMIC_RELAXED
+#   define TB_ATOMIC_RELAXED                    (0)
+#   define TB_ATOMIC_CONSUME                    (1)
+#   define TB_ATOMIC_ACQUIRE                    (2)
+#   define TB_ATOMIC_RELEASE                    (3)
+#   define TB_ATOMIC_ACQ_REL                    (4)
+#   define TB_ATOMIC_SEQ_CST                    (5)
+#endif
+
+#ifndef tb_atomic_get_explicit
+#   define tb_atomic_get_explicit(a, mo)                    tb_atomic_get(a)
+#endif
+
+#ifndef tb_atomic_set_explicit
+#   define tb_atomic_set_explicit(a, v, mo)                 tb_atomic_set(a, v)
+#endif
+
+#ifndef tb_atomic_fetch_and_set_explicit
+#   define tb_atomic_fetch_and_set_explicit(a, v, mo)       tb_atomic_fetch_and_set(a, v)
+#endif
+
+#ifndef tb_atomic_fetch_and_pset_explicit
+#   define tb_atomic_fetch_and_pset_explicit(a, p, v, mo)   tb_atomic_fetch_and_pset(a, p, v)
+#endif
+
+#ifndef tb_atomic_fetch_and_add_explicit
+#   define tb_atomic_fetch_and_add_explicit(a, v, mo)       tb_atomic_fetch_and_add(a, v)
+#endif
+
+#ifndef tb_atomic_fetch_and_sub_explicit
+#   define tb_atomic_fetch_and_sub_explicit(a, v, mo)       tb_atomic_fetch_and_sub(a, v)
+#endif
+
+#ifndef tb_atomic_fetch_and_or_explicit
+#   define tb_atomic_fetch_and_or_explicit(a, v, mo)        tb_atomic_fetch_and_or(a, v)
+#endif
+
+#ifndef tb_atomic_fetch_and_xor_explicit
+#   define tb_atomic_fetch_and_xor_explicit(a, v, mo)       tb_atomic_fetch_and_xor(a, v)
+#endif
+
+#ifndef tb_atomic_fetch_and_and_explicit
+#   define tb_atomic_fetch_and_and_explicit(a, v, mo)       tb_atomic_fetch_and_and(a, v)
+#endif
+
+#ifndef tb_atomic_add_and_fetch_explicit
+#   define tb_atomic_add_and_fetch_explicit(a, v, mo)       tb_atomic_add_and_fetch(a, v)
+#endif
+
+#ifndef tb_atomic_sub_and_fetch_explicit
+#   define tb_atomic_sub_and_fetch_explicit(a, v, mo)       tb_atomic_sub_and_fetch(a, v)
+#endif
+
+#ifndef tb_atomic_or_and_fetch_explicit
+#   define tb_atomic_or_and_fetch_explicit(a, v, mo)        tb_atomic_or_and_fetch(a, v)
+#endif
+
+#ifndef tb_atomic_xor_and_fetch_explicit
+#   define tb_atomic_xor_and_fetch_explicit(a, v, mo)       tb_atomic_xor_and_fetch(a, v)
+#endif
+
+#ifndef tb_atomic_and_and_fetch_explicit
+#   define tb_atomic_and_and_fetch_explicit(a, v, mo)       tb_atomic_and_and_fetch(a, v)
+#endif
+
+#define tb_atomic_pset_explicit(a, p, v, mo)                tb_atomic_fetch_and_pset_explicit(a, p, v, mo)
+#define tb_atomic_fetch_and_inc_explicit(a, mo)             tb_atomic_fetch_and_add_explicit(a, 1, mo)
+#define tb_atomic_fetch_and_dec_explicit(a, mo)             tb_atomic_fetch_and_sub_explicit(a, 1, mo)
+#define tb_atomic_inc_and_fetch_explicit(a, mo)             tb_atomic_add_and_fetch_explicit(a, 1, mo)
+#define tb_atomic_dec_and_fetch_explicit(a, mo)             tb_atomic_sub_and_fetch_explicit(a, 1, mo)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
  */
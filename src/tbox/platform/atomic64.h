@@ -73,6 +73,15 @@ __tb_extern_c_enter__
 #   define tb_atomic64_xor_and_fetch(a, v)      tb_atomic_xor_and_fetch(a, v)
 #   define tb_atomic64_and_and_fetch(a, v)      tb_atomic_and_and_fetch(a, v)
 
+#   define tb_atomic64_get_explicit(a, mo)                  tb_atomic_get_explicit(a, mo)
+#   define tb_atomic64_set_explicit(a, v, mo)               tb_atomic_set_explicit(a, v, mo)
+#   define tb_atomic64_fetch_and_set_explicit(a, v, mo)     tb_atomic_fetch_and_set_explicit(a, v, mo)
+#   define tb_atomic64_fetch_and_pset_explicit(a, p, v, mo) tb_atomic_fetch_and_pset_explicit(a, p, v, mo)
+#   define tb_atomic64_fetch_and_add_explicit(a, v, mo)     tb_atomic_fetch_and_add_explicit(a, v, mo)
+#   define tb_atomic64_fetch_and_sub_explicit(a, v, mo)     tb_atomic_fetch_and_sub_explicit(a, v, mo)
+#   define tb_atomic64_add_and_fetch_explicit(a, v, mo)     tb_atomic_add_and_fetch_explicit(a, v, mo)
+#   define tb_atomic64_sub_and_fetch_explicit(a, v, mo)     tb_atomic_sub_and_fetch_explicit(a, v, mo)
+
 #endif
 
 #ifndef tb_atomic64_fetch_and_pset
@@ -159,6 +168,39 @@ __tb_extern_c_enter__
 #   define tb_atomic64_and_and_fetch(a, v)      (tb_atomic64_fetch_and_and(a, v) & (v))
 #endif
 
+// the explicit operations will be the sequentially consistent operations if the compiler have not the memory model
+#ifndef tb_atomic64_get_explicit
+#   define tb_atomic64_get_explicit(a, mo)                  tb_atomic64_get(a)
+#endif
+
+#ifndef tb_atomic64_set_explicit
+#   define tb_atomic64_set_explicit(a, v, mo)               tb_atomic64_set(a, v)
+#endif
+
+#ifndef tb_atomic64_fetch_and_set_explicit
+#   define tb_atomic64_fetch_and_set_explicit(a, v, mo)     tb_atomic64_fetch_and_set(a, v)
+#endif
+
+#ifndef tb_atomic64_fetch_and_pset_explicit
+#   define tb_atomic64_fetch_and_pset_explicit(a, p, v, mo) tb_atomic64_fetch_and_pset(a, p, v)
+#endif
+
+#ifndef tb_atomic64_fetch_and_add_explicit
+#   define tb_atomic64_fetch_and_add_explicit(a, v, mo)     tb_atomic64_fetch_and_add(a, v)
+#endif
+
+#ifndef tb_atomic64_fetch_and_sub_explicit
+#   define tb_atomic64_fetch_and_sub_explicit(a, v, mo)     tb_atomic64_fetch_and_sub(a, v)
+#endif
+
+#ifndef tb_atomic64_add_and_fetch_explicit
+#   define tb_atomic64_add_and_fetch_explicit(a, v, mo)     tb_atomic64_add_and_fetch(a, v)
+#endif
+
+#ifndef tb_atomic64_sub_and_fetch_explicit
+#   define tb_atomic64_sub_and_fetch_explicit(a, v, mo)     tb_atomic64_sub_and_fetch(a, v)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -45,5 +45,10 @@
 #   define tb_barrier()         
 #endif
 
+// the cpu pause hint for the spin-wait loop
+#ifndef tb_cpu_pause
+#   define tb_cpu_pause()           tb_barrier()
+#endif
+
 
 #endif
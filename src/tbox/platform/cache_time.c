@@ -49,22 +49,22 @@ tb_hong_t tb_cache_time_spak()
     // the time value
     tb_hong_t val = ((tb_hong_t)tv.tv_sec * 1000 + tv.tv_usec / 1000);
 
-    // save it
-    tb_atomic64_set(&g_time, val);
+    // save it, only the time value and no other data need be published
+    tb_atomic64_set_explicit(&g_time, val, TB_ATOMIC_RELAXED);
 
     // ok
     return val;
 }
 tb_hong_t tb_cache_time_mclock()
 {
-    return (tb_hong_t)tb_atomic64_get(&g_time);
+    return (tb_hong_t)tb_atomic64_get_explicit(&g_time, TB_ATOMIC_RELAXED);
 }
 tb_hong_t tb_cache_time_sclock()
 {
-    return (tb_hong_t)tb_atomic64_get(&g_time) / 1000;
+    return (tb_hong_t)tb_atomic64_get_explicit(&g_time, TB_ATOMIC_RELAXED) / 1000;
 }
 tb_time_t tb_cache_time()
 {
-    return (tb_time_t)tb_atomic64_get(&g_time) / 1000;
+    return (tb_time_t)tb_atomic64_get_explicit(&g_time, TB_ATOMIC_RELAXED) / 1000;
 }
 
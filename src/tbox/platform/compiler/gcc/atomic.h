@@ -33,28 +33,97 @@
  * macros
  */
 
-#define tb_atomic_fetch_and_set(a, v)       tb_atomic_fetch_and_set_sync(a, v)
-#define tb_atomic_fetch_and_pset(a, p, v)   tb_atomic_fetch_and_pset_sync(a, p, v)
+#ifdef __ATOMIC_SEQ_CST
 
-#define tb_atomic_fetch_and_add(a, v)       tb_atomic_fetch_and_add_sync(a, v)
-#define tb_atomic_fetch_and_sub(a, v)       tb_atomic_fetch_and_sub_sync(a, v)
-#define tb_atomic_fetch_and_or(a, v)        tb_atomic_fetch_and_or_sync(a, v)
-#define tb_atomic_fetch_and_and(a, v)       tb_atomic_fetch_and_and_sync(a, v)
+// the memory order
+#   define TB_ATOMIC_RELAXED                    __ATOMIC_RELAXED
+#   define TB_ATOMIC_CONSUME                    __ATOMIC_CONSUME
+#   define TB_ATOMIC_ACQUIRE                    __ATOMIC_ACQUIRE
+#   define TB_ATOMIC_RELEASE                    __ATOMIC_RELEASE
+#   define TB_ATOMIC_ACQ_REL                    __ATOMIC_ACQ_REL
+#   define TB_ATOMIC_SEQ_CST                    __ATOMIC_SEQ_CST
 
-#define tb_atomic_add_and_fetch(a, v)       tb_atomic_add_and_fetch_sync(a, v)
-#define tb_atomic_sub_and_fetch(a, v)       tb_atomic_sub_and_fetch_sync(a, v)
-#define tb_atomic_or_and_fetch(a, v)        tb_atomic_or_and_fetch_sync(a, v)
-#define tb_atomic_and_and_fetch(a, v)       tb_atomic_and_and_fetch_sync(a, v)
+// the failure memory order of the compare and swap, it cannot be stronger than the success order or release
+#   define tb_atomic_order_fail(mo)             ((mo) == TB_ATOMIC_ACQ_REL? TB_ATOMIC_ACQUIRE : ((mo) == TB_ATOMIC_RELEASE? TB_ATOMIC_RELAXED : (mo)))
+
+#   define tb_atomic_get_explicit(a, mo)                    __atomic_load_n(a, mo)
+#   define tb_atomic_set_explicit(a, v, mo)                 __atomic_store_n(a, v, mo)
+
+#   define tb_atomic_fetch_and_set_explicit(a, v, mo)       __atomic_exchange_n(a, v, mo)
+#   define tb_atomic_fetch_and_pset_explicit(a, p, v, mo)   tb_atomic_fetch_and_pset_explicit_gcc(a, p, v, mo)
+
+#   define tb_atomic_fetch_and_add_explicit(a, v, mo)       __atomic_fetch_add(a, v, mo)
+#   define tb_atomic_fetch_and_sub_explicit(a, v, mo)       __atomic_fetch_sub(a, v, mo)
+#   define tb_atomic_fetch_and_or_explicit(a, v, mo)        __atomic_fetch_or(a, v, mo)
+#   define tb_atomic_fetch_and_and_explicit(a, v, mo)       __atomic_fetch_and(a, v, mo)
+
+#   define tb_atomic_add_and_fetch_explicit(a, v, mo)       __atomic_add_fetch(a, v, mo)
+#   define tb_atomic_sub_and_fetch_explicit(a, v, mo)       __atomic_sub_fetch(a, v, mo)
+#   define tb_atomic_or_and_fetch_explicit(a, v, mo)        __atomic_or_fetch(a, v, mo)
+#   define tb_atomic_and_and_fetch_explicit(a, v, mo)       __atomic_and_fetch(a, v, mo)
 
 // FIXME: ios armv6: no defined refernece?
-#if !(defined(TB_CONFIG_OS_IOS) && TB_ARCH_ARM_VERSION < 7)
-#   define tb_atomic_fetch_and_xor(a, v)    tb_atomic_fetch_and_xor_sync(a, v)
-#   define tb_atomic_xor_and_fetch(a, v)    tb_atomic_xor_and_fetch_sync(a, v)
+#   if !(defined(TB_CONFIG_OS_IOS) && TB_ARCH_ARM_VERSION < 7)
+#       define tb_atomic_fetch_and_xor_explicit(a, v, mo)   __atomic_fetch_xor(a, v, mo)
+#       define tb_atomic_xor_and_fetch_explicit(a, v, mo)   __atomic_xor_fetch(a, v, mo)
+#   endif
+
+// the sequentially consistent operations
+#   define tb_atomic_get(a)                     tb_atomic_get_explicit(a, TB_ATOMIC_SEQ_CST)
+#   define tb_atomic_set(a, v)                  tb_atomic_set_explicit(a, v, TB_ATOMIC_SEQ_CST)
+
+#   define tb_atomic_fetch_and_set(a, v)        tb_atomic_fetch_and_set_explicit(a, v, TB_ATOMIC_SEQ_CST)
+#   define tb_atomic_fetch_and_pset(a, p, v)    tb_atomic_fetch_and_pset_explicit(a, p, v, TB_ATOMIC_SEQ_CST)
+
+#   define tb_atomic_fetch_and_add(a, v)        tb_atomic_fetch_and_add_explicit(a, v, TB_ATOMIC_SEQ_CST)
+#   define tb_atomic_fetch_and_sub(a, v)        tb_atomic_fetch_and_sub_explicit(a, v, TB_ATOMIC_SEQ_CST)
+#   define tb_atomic_fetch_and_or(a, v)         tb_atomic_fetch_and_or_explicit(a, v, TB_ATOMIC_SEQ_CST)
+#   define tb_atomic_fetch_and_and(a, v)        tb_atomic_fetch_and_and_explicit(a, v, TB_ATOMIC_SEQ_CST)
+
+#   define tb_atomic_add_and_fetch(a, v)        tb_atomic_add_and_fetch_explicit(a, v, TB_ATOMIC_SEQ_CST)
+#   define tb_atomic_sub_and_fetch(a, v)        tb_atomic_sub_and_fetch_explicit(a, v, TB_ATOMIC_SEQ_CST)
+#   define tb_atomic_or_and_fetch(a, v)         tb_atomic_or_and_fetch_explicit(a, v, TB_ATOMIC_SEQ_CST)
+#   define tb_atomic_and_and_fetch(a, v)        tb_atomic_and_and_fetch_explicit(a, v, TB_ATOMIC_SEQ_CST)
+
+#   if !(defined(TB_CONFIG_OS_IOS) && TB_ARCH_ARM_VERSION < 7)
+#       define tb_atomic_fetch_and_xor(a, v)    tb_atomic_fetch_and_xor_explicit(a, v, TB_ATOMIC_SEQ_CST)
+#       define tb_atomic_xor_and_fetch(a, v)    tb_atomic_xor_and_fetch_explicit(a, v, TB_ATOMIC_SEQ_CST)
+#   endif
+
+#else
+
+#   define tb_atomic_fetch_and_set(a, v)       tb_atomic_fetch_and_set_sync(a, v)
+#   define tb_atomic_fetch_and_pset(a, p, v)   tb_atomic_fetch_and_pset_sync(a, p, v)
+
+#   define tb_atomic_fetch_and_add(a, v)       tb_atomic_fetch_and_add_sync(a, v)
+#   define tb_atomic_fetch_and_sub(a, v)       tb_atomic_fetch_and_sub_sync(a, v)
+#   define tb_atomic_fetch_and_or(a, v)        tb_atomic_fetch_and_or_sync(a, v)
+#   define tb_atomic_fetch_and_and(a, v)       tb_atomic_fetch_and_and_sync(a, v)
+
+#   define tb_atomic_add_and_fetch(a, v)       tb_atomic_add_and_fetch_sync(a, v)
+#   define tb_atomic_sub_and_fetch(a, v)       tb_atomic_sub_and_fetch_sync(a, v)
+#   define tb_atomic_or_and_fetch(a, v)        tb_atomic_or_and_fetch_sync(a, v)
+#   define tb_atomic_and_and_fetch(a, v)       tb_atomic_and_and_fetch_sync(a, v)
+
+// FIXME: ios armv6: no defined refernece?
+#   if !(defined(TB_CONFIG_OS_IOS) && TB_ARCH_ARM_VERSION < 7)
+#       define tb_atomic_fetch_and_xor(a, v)    tb_atomic_fetch_and_xor_sync(a, v)
+#       define tb_atomic_xor_and_fetch(a, v)    tb_atomic_xor_and_fetch_sync(a, v)
+#   endif
+
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
  */
+#ifdef __ATOMIC_SEQ_CST
+static __tb_inline__ tb_long_t tb_atomic_fetch_and_pset_explicit_gcc(tb_atomic_t* a, tb_long_t p, tb_long_t v, tb_int_t mo)
+{
+    // the old value will be saved to p if failed
+    __atomic_compare_exchange_n(a, &p, v, tb_false, mo, tb_atomic_order_fail(mo));
+    return p;
+}
+#else
 static __tb_inline__ tb_long_t tb_atomic_fetch_and_set_sync(tb_atomic_t* a, tb_long_t v)
 {
     return __sync_lock_test_and_set(a, v);
@@ -107,5 +176,6 @@ static __tb_inline__ tb_long_t tb_atomic_or_and_fetch_sync(tb_atomic_t* a, tb_lo
 {
     return __sync_or_and_fetch(a, v);
 }
+#endif
 
 #endif
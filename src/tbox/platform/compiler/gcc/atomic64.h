@@ -52,9 +52,29 @@
 #   define tb_atomic64_xor_and_fetch(a, v)      tb_atomic64_xor_and_fetch_sync(a, v)
 #endif
 
+// the explicit operations with the memory order
+#ifdef __ATOMIC_SEQ_CST
+#   define tb_atomic64_get_explicit(a, mo)                  __atomic_load_n(a, mo)
+#   define tb_atomic64_set_explicit(a, v, mo)               __atomic_store_n(a, v, mo)
+#   define tb_atomic64_fetch_and_set_explicit(a, v, mo)     __atomic_exchange_n(a, v, mo)
+#   define tb_atomic64_fetch_and_pset_explicit(a, p, v, mo) tb_atomic64_fetch_and_pset_explicit_gcc(a, p, v, mo)
+#   define tb_atomic64_fetch_and_add_explicit(a, v, mo)     __atomic_fetch_add(a, v, mo)
+#   define tb_atomic64_fetch_and_sub_explicit(a, v, mo)     __atomic_fetch_sub(a, v, mo)
+#   define tb_atomic64_add_and_fetch_explicit(a, v, mo)     __atomic_add_fetch(a, v, mo)
+#   define tb_atomic64_sub_and_fetch_explicit(a, v, mo)     __atomic_sub_fetch(a, v, mo)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
  */
+#ifdef __ATOMIC_SEQ_CST
+static __tb_inline__ tb_hong_t tb_atomic64_fetch_and_pset_explicit_gcc(tb_atomic64_t* a, tb_hong_t p, tb_hong_t v, tb_int_t mo)
+{
+    // the old value will be saved to p if failed
+    __atomic_compare_exchange_n(a, &p, v, tb_false, mo, tb_atomic_order_fail(mo));
+    return p;
+}
+#endif
 static __tb_inline__ tb_hong_t tb_atomic64_fetch_and_set_sync(tb_atomic64_t* a, tb_hong_t v)
 {
     return __sync_lock_test_and_set_8(a, v);
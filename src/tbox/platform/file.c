@@ -145,4 +145,14 @@ tb_bool_t tb_file_link(tb_char_t const* path, tb_char_t const* dest)
     tb_trace_noimpl();
     return tb_false;
 }
+tb_byte_t const* tb_file_mmap(tb_file_ref_t file, tb_size_t* psize)
+{
+    tb_trace_noimpl();
+    return tb_null;
+}
+tb_bool_t tb_file_munmap(tb_byte_t const* data, tb_size_t size)
+{
+    tb_trace_noimpl();
+    return tb_false;
+}
 #endif
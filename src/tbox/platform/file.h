@@ -252,6 +252,26 @@ tb_hize_t               tb_file_size(tb_file_ref_t file);
  */
 tb_hong_t               tb_file_offset(tb_file_ref_t file);
 
+/*! map the whole file to the readonly memory
+ *
+ * the mapped data is still valid after the file has been exited
+ * 
+ * @param file          the file 
+ * @param psize         the mapped size
+ *
+ * @return              the mapped data, tb_null if failed or not supported
+ */
+tb_byte_t const*        tb_file_mmap(tb_file_ref_t file, tb_size_t* psize);
+
+/*! unmap the file data
+ * 
+ * @param data          the mapped data
+ * @param size          the mapped size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_file_munmap(tb_byte_t const* data, tb_size_t size);
+
 /*! the file info for file or directory
  * 
  * @param file          the file handle
@@ -70,7 +70,7 @@ typedef struct __tb_exception_list_t
         \
         /* init exception data */ \
         tb_exception_list_t* __l = tb_null; \
-        if (!(__l = (tb_exception_list_t*)tb_thread_store_getp())) \
+        if (!(__l = (tb_exception_list_t*)tb_thread_store_getp_type(TB_THREAD_STORE_DATA_TYPE_EXCEPTION))) \
         { \
             __l = tb_malloc0(sizeof(tb_exception_list_t)); \
             if (__l) \
@@ -142,7 +142,7 @@ typedef struct __tb_exception_list_t
 #if defined(tb_signal) && defined(tb_sigsetjmp) && defined(tb_siglongjmp)
 static __tb_inline__ tb_void_t tb_exception_func_impl(tb_int_t sig)
 {
-    tb_exception_list_t* list = (tb_exception_list_t*)tb_thread_store_getp();
+    tb_exception_list_t* list = (tb_exception_list_t*)tb_thread_store_getp_type(TB_THREAD_STORE_DATA_TYPE_EXCEPTION);
     if (list && list->stack && tb_stack_size(list->stack)) 
     {
         tb_sigjmpbuf_t* jmpbuf = (tb_sigjmpbuf_t*)tb_stack_top(list->stack);
@@ -0,0 +1,1302 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        aicp_uring.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../posix/sockaddr.h"
+#include "../../asio/impl/prefix.h"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the io_uring syscalls
+#ifndef __NR_io_uring_setup
+#   define __NR_io_uring_setup                      (425)
+#endif
+#ifndef __NR_io_uring_enter
+#   define __NR_io_uring_enter                      (426)
+#endif
+#ifndef __NR_io_uring_register
+#   define __NR_io_uring_register                   (427)
+#endif
+
+// the sqe entries maxn
+#ifdef __tb_small__
+#   define TB_URING_SQE_MAXN                        (256)
+#else
+#   define TB_URING_SQE_MAXN                        (4096)
+#endif
+
+// the cqe list maxn for each loop
+#ifdef __tb_small__
+#   define TB_URING_CQE_LIST_MAXN                   (16)
+#else
+#   define TB_URING_CQE_LIST_MAXN                   (64)
+#endif
+
+// the loop maxn
+#define TB_URING_LOOP_MAXN                          (64)
+
+/* the user data of the cqe
+ *
+ * 0:           wake up the loop
+ * aico:        the aice completion
+ * aico | 1:    the internal completion for cancel and linked timeout, ignore it
+ * aico | 3:    the internal completion for the poll before the aice, save its error and ignore it
+ */
+#define TB_URING_DATA_WAKE                          (0)
+#define TB_URING_DATA_AICE(aico)                    ((tb_uint64_t)(tb_size_t)(aico))
+#define TB_URING_DATA_SKIP(aico)                    ((tb_uint64_t)(tb_size_t)(aico) | 1)
+#define TB_URING_DATA_HEAD(aico)                    ((tb_uint64_t)(tb_size_t)(aico) | 3)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the uring loop type
+typedef struct __tb_uring_loop_t
+{
+    // the self
+    tb_size_t                   self;
+
+    // the cqe list
+    struct io_uring_cqe         list[TB_URING_CQE_LIST_MAXN];
+
+    // the cqe index
+    tb_size_t                   list_indx;
+
+    // the cqe size
+    tb_size_t                   list_size;
+
+}tb_uring_loop_t;
+
+// the uring ptor type
+typedef struct __tb_uring_ptor_impl_t
+{
+    // the ptor base
+    tb_aicp_ptor_impl_t         base;
+
+    // the ring fd
+    tb_long_t                   fd;
+
+    // the ring features
+    tb_uint32_t                 features;
+
+    // the sq ring
+    tb_byte_t*                  sq_ring;
+
+    // the sq ring size
+    tb_size_t                   sq_ring_size;
+
+    // the sq head, tail, mask and array
+    tb_uint32_t volatile*       sq_head;
+    tb_uint32_t volatile*       sq_tail;
+    tb_uint32_t volatile*       sq_flags;
+    tb_uint32_t                 sq_mask;
+    tb_uint32_t                 sq_entries;
+    tb_uint32_t*                sq_array;
+
+    // the sqes
+    struct io_uring_sqe*        sqes;
+
+    // the sqes size
+    tb_size_t                   sqes_size;
+
+    // the cq ring, maybe be same as the sq ring
+    tb_byte_t*                  cq_ring;
+
+    // the cq ring size
+    tb_size_t                   cq_ring_size;
+
+    // the cq head, tail and mask
+    tb_uint32_t volatile*       cq_head;
+    tb_uint32_t volatile*       cq_tail;
+    tb_uint32_t                 cq_mask;
+
+    // the cqes
+    struct io_uring_cqe*        cqes;
+
+    // the submission lock
+    tb_spinlock_t               lock;
+
+    // the reaping lock
+    tb_spinlock_t               rlock;
+
+    // the loop list
+    tb_uring_loop_t*            loop_list[TB_URING_LOOP_MAXN];
+
+    // the loop size
+    tb_size_t                   loop_size;
+
+}tb_uring_ptor_impl_t;
+
+// the uring aico type
+typedef struct __tb_uring_aico_t
+{
+    // the base
+    tb_aico_impl_t              base;
+
+    // the impl
+    tb_uring_ptor_impl_t*       impl;
+
+    // the pending aice
+    tb_aice_t                   aice;
+
+    // the message for urecv, usend, recvv, sendv, urecvv and usendv
+    struct msghdr               msg;
+
+    // the iovec for urecv and usend
+    struct iovec                iovec;
+
+    // the address for acpt, conn, urecv, usend, urecvv and usendv
+    struct sockaddr_storage     addr;
+
+    // the address size
+    socklen_t                   addr_size;
+
+    // the timeout for the linked timeout or the runtask
+    struct __kernel_timespec    timeout;
+
+    /* the error of the poll before the aice
+     *
+     * the aice linked to the failed poll will be cancelled, so we need report this error instead of the timeout
+     */
+    tb_long_t                   error;
+
+}tb_uring_aico_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * ring
+ */
+static __tb_inline__ tb_long_t tb_uring_setup(tb_uint32_t entries, struct io_uring_params* params)
+{
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+static __tb_inline__ tb_long_t tb_uring_enter(tb_uring_ptor_impl_t* impl, tb_uint32_t to_submit, tb_uint32_t min_complete, tb_uint32_t flags, tb_cpointer_t arg, tb_size_t argsz)
+{
+    return syscall(__NR_io_uring_enter, (tb_int_t)impl->fd, to_submit, min_complete, flags, arg, argsz);
+}
+static __tb_inline__ tb_long_t tb_uring_register(tb_long_t fd, tb_uint32_t opcode, tb_pointer_t arg, tb_uint32_t nargs)
+{
+    return syscall(__NR_io_uring_register, (tb_int_t)fd, opcode, arg, nargs);
+}
+static __tb_inline__ tb_uint32_t tb_uring_sq_pending(tb_uring_ptor_impl_t* impl)
+{
+    // the tail is only written by us and the head is written by the kernel
+    tb_uint32_t tail = *impl->sq_tail;
+    tb_barrier();
+    return tail - *impl->sq_head;
+}
+static tb_void_t tb_uring_submit(tb_uring_ptor_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    /* submit all pending entries
+     *
+     * the kernel will only submit the available entries if they have been submitted by other threads
+     */
+    tb_uint32_t pending = tb_uring_sq_pending(impl);
+    while (pending && tb_uring_enter(impl, pending, 0, 0, tb_null, 0) < 0 && (errno == EINTR || errno == EAGAIN || errno == EBUSY))
+        pending = tb_uring_sq_pending(impl);
+}
+static tb_bool_t tb_uring_push(tb_uring_ptor_impl_t* impl, struct io_uring_sqe const* list, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(impl && list && size && size <= impl->sq_entries, tb_false);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // done
+    tb_bool_t ok = tb_false;
+    tb_bool_t defer = tb_false;
+    do
+    {
+        // no enough free entries? submit the pending entries first
+        if (impl->sq_entries - tb_uring_sq_pending(impl) < size) tb_uring_submit(impl);
+        if (impl->sq_entries - tb_uring_sq_pending(impl) < size)
+        {
+            // trace
+            tb_trace_e("push: the sq ring is full!");
+            break;
+        }
+
+        // put entries
+        tb_size_t   i = 0;
+        tb_uint32_t tail = *impl->sq_tail;
+        for (i = 0; i < size; i++, tail++)
+        {
+            tb_uint32_t index = tail & impl->sq_mask;
+            impl->sqes[index] = list[i];
+            impl->sq_array[index] = index;
+        }
+
+        // update the tail after the entries have been written
+        tb_barrier();
+        *impl->sq_tail = tail;
+
+        /* posted from the loop thread? defer to submit it
+         *
+         * the loop will submit all pending entries before reaping the next cqes,
+         * so the aices posted from the aice func will be submitted by one syscall
+         */
+        tb_size_t self = tb_thread_self();
+        for (i = 0; i < impl->loop_size && !defer; i++)
+            defer = impl->loop_list[i]->self == self;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+
+    // submit it
+    if (ok && !defer) tb_uring_submit(impl);
+
+    // ok?
+    return ok;
+}
+static tb_size_t tb_uring_reap(tb_uring_ptor_impl_t* impl, struct io_uring_cqe* list, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(impl && list && maxn, 0);
+
+    // enter
+    tb_spinlock_enter(&impl->rlock);
+
+    // reap cqes
+    tb_size_t   size = 0;
+    tb_uint32_t head = *impl->cq_head;
+    tb_uint32_t tail = *impl->cq_tail;
+    tb_barrier();
+    while (head != tail && size < maxn)
+    {
+        // reap it
+        struct io_uring_cqe* cqe = &list[size++];
+        *cqe = impl->cqes[head & impl->cq_mask];
+        head++;
+
+        /* the poll before the aice is failed? save its error now
+         *
+         * the cancelled aice may be reaped and spaked in the other loop before spaking this poll in our loop,
+         * but it is always behind this poll in the completion queue
+         */
+        if ((cqe->user_data & 3) == 3 && cqe->res < 0)
+            ((tb_uring_aico_t*)(tb_size_t)(cqe->user_data & ~(tb_uint64_t)3))->error = cqe->res;
+    }
+
+    // update the head after the cqes have been read
+    tb_barrier();
+    *impl->cq_head = head;
+
+    // leave
+    tb_spinlock_leave(&impl->rlock);
+
+    // no cqes? flush the overflowed cqes
+    if (!size && (*impl->sq_flags & IORING_SQ_CQ_OVERFLOW))
+        tb_uring_enter(impl, 0, 0, IORING_ENTER_GETEVENTS, tb_null, 0);
+
+    // ok
+    return size;
+}
+static tb_long_t tb_uring_wait(tb_uring_ptor_impl_t* impl, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(impl, -1);
+
+    // done
+    tb_long_t ok = -1;
+#ifdef IORING_FEAT_EXT_ARG
+    if (timeout >= 0 && (impl->features & IORING_FEAT_EXT_ARG))
+    {
+        // init timeout
+        struct __kernel_timespec ts;
+        ts.tv_sec   = timeout / 1000;
+        ts.tv_nsec  = (timeout % 1000) * 1000000;
+
+        // init arg
+        struct io_uring_getevents_arg arg = {0};
+        arg.ts = (tb_uint64_t)(tb_size_t)&ts;
+
+        // wait it
+        ok = tb_uring_enter(impl, tb_uring_sq_pending(impl), 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    }
+    else
+#endif
+    {
+        // wait it
+        ok = tb_uring_enter(impl, tb_uring_sq_pending(impl), 1, IORING_ENTER_GETEVENTS, tb_null, 0);
+    }
+
+    // interrupted or timeout?
+    if (ok < 0 && (errno == EINTR || errno == ETIME || errno == EAGAIN || errno == EBUSY)) ok = 0;
+
+    // trace
+    if (ok < 0) tb_trace_e("wait: failed, errno: %d", errno);
+
+    // ok?
+    return ok < 0? -1 : 0;
+}
+static tb_bool_t tb_uring_wake(tb_uring_ptor_impl_t* impl)
+{
+    // init nop
+    struct io_uring_sqe sqe = {0};
+    sqe.opcode      = IORING_OP_NOP;
+    sqe.user_data   = TB_URING_DATA_WAKE;
+
+    // wake up one loop
+    return tb_uring_push(impl, &sqe, 1);
+}
+static tb_bool_t tb_uring_cancel(tb_uring_ptor_impl_t* impl, tb_uring_aico_t* aico)
+{
+    // init cancel
+    struct io_uring_sqe sqe = {0};
+    sqe.opcode      = IORING_OP_ASYNC_CANCEL;
+    sqe.fd          = -1;
+    sqe.addr        = TB_URING_DATA_AICE(aico);
+    sqe.user_data   = TB_URING_DATA_SKIP(aico);
+
+    // cancel the pending aice of this aico
+    return tb_uring_push(impl, &sqe, 1);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * post
+ */
+static tb_bool_t tb_uring_post_aice(tb_uring_ptor_impl_t* impl, tb_uring_aico_t* aico, tb_bool_t wait)
+{
+    // check
+    tb_assert_and_check_return_val(impl && aico, tb_false);
+
+    // the aice
+    tb_aice_ref_t aice = &aico->aice;
+
+    // the handle fd
+    tb_int_t fd = -1;
+    if (aico->base.type == TB_AICO_TYPE_SOCK) fd = tb_sock2fd((tb_socket_ref_t)aico->base.handle);
+    else if (aico->base.type == TB_AICO_TYPE_FILE) fd = tb_file2fd((tb_file_ref_t)aico->base.handle);
+
+    // init sqes
+    tb_size_t           size = 0;
+    struct io_uring_sqe list[3];
+    tb_memset(list, 0, sizeof(list));
+
+    /* wait the socket events first?
+     *
+     * the older kernel maybe return -EAGAIN for the non-blocking socket
+     */
+    if (wait)
+    {
+        struct io_uring_sqe* poll = &list[size++];
+        poll->opcode        = IORING_OP_POLL_ADD;
+        poll->fd            = fd;
+        switch (aice->code)
+        {
+        case TB_AICE_CODE_ACPT:
+        case TB_AICE_CODE_RECV:
+        case TB_AICE_CODE_URECV:
+        case TB_AICE_CODE_RECVV:
+        case TB_AICE_CODE_URECVV:
+            poll->poll_events = POLLIN;
+            break;
+        default:
+            poll->poll_events = POLLOUT;
+            break;
+        }
+        poll->flags         = IOSQE_IO_LINK;
+        poll->user_data     = TB_URING_DATA_HEAD(aico);
+    }
+
+    // init the aice sqe
+    struct io_uring_sqe* sqe = &list[size++];
+    sqe->fd         = fd;
+    sqe->user_data  = TB_URING_DATA_AICE(aico);
+
+    // killed? spak it directly
+    if (tb_aico_impl_is_killed(&aico->base) && aice->code != TB_AICE_CODE_CLOS)
+    {
+        sqe->opcode = IORING_OP_NOP;
+        sqe->fd     = -1;
+        return tb_uring_push(impl, sqe, 1);
+    }
+
+    // done
+    tb_bool_t ok = tb_true;
+    switch (aice->code)
+    {
+    case TB_AICE_CODE_ACPT:
+        {
+            aico->addr_size     = sizeof(aico->addr);
+            sqe->opcode         = IORING_OP_ACCEPT;
+            sqe->addr           = (tb_uint64_t)(tb_size_t)&aico->addr;
+            sqe->addr2          = (tb_uint64_t)(tb_size_t)&aico->addr_size;
+            sqe->accept_flags   = SOCK_NONBLOCK | SOCK_CLOEXEC;
+        }
+        break;
+    case TB_AICE_CODE_CONN:
+        {
+            aico->addr_size     = (socklen_t)tb_sockaddr_load(&aico->addr, &aice->u.conn.addr);
+            sqe->opcode         = IORING_OP_CONNECT;
+            sqe->addr           = (tb_uint64_t)(tb_size_t)&aico->addr;
+            sqe->off            = aico->addr_size;
+            ok = aico->addr_size > 0;
+        }
+        break;
+    case TB_AICE_CODE_RECV:
+        {
+            sqe->opcode         = IORING_OP_RECV;
+            sqe->addr           = (tb_uint64_t)(tb_size_t)aice->u.recv.data;
+            sqe->len            = (tb_uint32_t)aice->u.recv.size;
+        }
+        break;
+    case TB_AICE_CODE_SEND:
+        {
+            sqe->opcode         = IORING_OP_SEND;
+            sqe->addr           = (tb_uint64_t)(tb_size_t)aice->u.send.data;
+            sqe->len            = (tb_uint32_t)aice->u.send.size;
+            sqe->msg_flags      = MSG_NOSIGNAL;
+        }
+        break;
+    case TB_AICE_CODE_URECV:
+    case TB_AICE_CODE_USEND:
+    case TB_AICE_CODE_RECVV:
+    case TB_AICE_CODE_SENDV:
+    case TB_AICE_CODE_URECVV:
+    case TB_AICE_CODE_USENDV:
+        {
+            // init msg
+            tb_memset(&aico->msg, 0, sizeof(struct msghdr));
+            switch (aice->code)
+            {
+            case TB_AICE_CODE_URECV:
+                aico->iovec.iov_base    = aice->u.urecv.data;
+                aico->iovec.iov_len     = aice->u.urecv.size;
+                aico->msg.msg_iov       = &aico->iovec;
+                aico->msg.msg_iovlen    = 1;
+                aico->msg.msg_name      = &aico->addr;
+                aico->msg.msg_namelen   = sizeof(aico->addr);
+                break;
+            case TB_AICE_CODE_USEND:
+                aico->iovec.iov_base    = (tb_pointer_t)aice->u.usend.data;
+                aico->iovec.iov_len     = aice->u.usend.size;
+                aico->msg.msg_iov       = &aico->iovec;
+                aico->msg.msg_iovlen    = 1;
+                aico->msg.msg_name      = &aico->addr;
+                aico->msg.msg_namelen   = (socklen_t)tb_sockaddr_load(&aico->addr, &aice->u.usend.addr);
+                ok = aico->msg.msg_namelen > 0;
+                break;
+            case TB_AICE_CODE_RECVV:
+                aico->msg.msg_iov       = (struct iovec*)aice->u.recvv.list;
+                aico->msg.msg_iovlen    = aice->u.recvv.size;
+                break;
+            case TB_AICE_CODE_SENDV:
+                aico->msg.msg_iov       = (struct iovec*)aice->u.sendv.list;
+                aico->msg.msg_iovlen    = aice->u.sendv.size;
+                break;
+            case TB_AICE_CODE_URECVV:
+                aico->msg.msg_iov       = (struct iovec*)aice->u.urecvv.list;
+                aico->msg.msg_iovlen    = aice->u.urecvv.size;
+                aico->msg.msg_name      = &aico->addr;
+                aico->msg.msg_namelen   = sizeof(aico->addr);
+                break;
+            case TB_AICE_CODE_USENDV:
+                aico->msg.msg_iov       = (struct iovec*)aice->u.usendv.list;
+                aico->msg.msg_iovlen    = aice->u.usendv.size;
+                aico->msg.msg_name      = &aico->addr;
+                aico->msg.msg_namelen   = (socklen_t)tb_sockaddr_load(&aico->addr, &aice->u.usendv.addr);
+                ok = aico->msg.msg_namelen > 0;
+                break;
+            default:
+                break;
+            }
+
+            // init sqe
+            tb_bool_t send = aice->code == TB_AICE_CODE_USEND || aice->code == TB_AICE_CODE_SENDV || aice->code == TB_AICE_CODE_USENDV;
+            sqe->opcode         = send? IORING_OP_SENDMSG : IORING_OP_RECVMSG;
+            sqe->addr           = (tb_uint64_t)(tb_size_t)&aico->msg;
+            sqe->len            = 1;
+            sqe->msg_flags      = send? MSG_NOSIGNAL : 0;
+        }
+        break;
+    case TB_AICE_CODE_SENDF:
+        {
+            // wait the writable event and send file in the loop
+            sqe->opcode         = IORING_OP_POLL_ADD;
+            sqe->poll_events    = POLLOUT;
+        }
+        break;
+    case TB_AICE_CODE_READ:
+        {
+            sqe->opcode         = IORING_OP_READ;
+            sqe->addr           = (tb_uint64_t)(tb_size_t)aice->u.read.data;
+            sqe->len            = (tb_uint32_t)aice->u.read.size;
+            sqe->off            = aice->u.read.seek;
+        }
+        break;
+    case TB_AICE_CODE_WRIT:
+        {
+            sqe->opcode         = IORING_OP_WRITE;
+            sqe->addr           = (tb_uint64_t)(tb_size_t)aice->u.writ.data;
+            sqe->len            = (tb_uint32_t)aice->u.writ.size;
+            sqe->off            = aice->u.writ.seek;
+        }
+        break;
+    case TB_AICE_CODE_READV:
+        {
+            sqe->opcode         = IORING_OP_READV;
+            sqe->addr           = (tb_uint64_t)(tb_size_t)aice->u.readv.list;
+            sqe->len            = (tb_uint32_t)aice->u.readv.size;
+            sqe->off            = aice->u.readv.seek;
+        }
+        break;
+    case TB_AICE_CODE_WRITV:
+        {
+            sqe->opcode         = IORING_OP_WRITEV;
+            sqe->addr           = (tb_uint64_t)(tb_size_t)aice->u.writv.list;
+            sqe->len            = (tb_uint32_t)aice->u.writv.size;
+            sqe->off            = aice->u.writv.seek;
+        }
+        break;
+    case TB_AICE_CODE_FSYNC:
+        {
+            sqe->opcode         = IORING_OP_FSYNC;
+        }
+        break;
+    case TB_AICE_CODE_RUNTASK:
+        {
+            // the delay
+            tb_hong_t now = tb_cache_time_mclock();
+            tb_hong_t delay = aice->u.runtask.when > now? aice->u.runtask.when - now : 0;
+
+            // timeout? spak it directly
+            if (!delay)
+            {
+                sqe->opcode     = IORING_OP_NOP;
+                sqe->fd         = -1;
+                break;
+            }
+
+            // init timeout
+            aico->timeout.tv_sec    = delay / 1000;
+            aico->timeout.tv_nsec   = (delay % 1000) * 1000000;
+            sqe->opcode             = IORING_OP_TIMEOUT;
+            sqe->fd                 = -1;
+            sqe->addr               = (tb_uint64_t)(tb_size_t)&aico->timeout;
+            sqe->len                = 1;
+        }
+        break;
+    default:
+        ok = tb_false;
+        break;
+    }
+    tb_assert_and_check_return_val(ok, tb_false);
+
+    // add the linked timeout
+    if (aice->code != TB_AICE_CODE_RUNTASK)
+    {
+        tb_long_t timeout = tb_aico_impl_timeout_from_code(&aico->base, aice->code);
+        if (timeout >= 0)
+        {
+            // init timeout
+            aico->timeout.tv_sec    = timeout / 1000;
+            aico->timeout.tv_nsec   = (timeout % 1000) * 1000000;
+
+            // link it
+            sqe->flags |= IOSQE_IO_LINK;
+
+            // init the linked timeout
+            struct io_uring_sqe* link = &list[size++];
+            link->opcode            = IORING_OP_LINK_TIMEOUT;
+            link->fd                = -1;
+            link->addr              = (tb_uint64_t)(tb_size_t)&aico->timeout;
+            link->len               = 1;
+            link->user_data         = TB_URING_DATA_SKIP(aico);
+        }
+    }
+
+    // trace
+    tb_trace_d("post: aico: %p, code: %lu, sqes: %lu", aico, aice->code, size);
+
+    // clear the error of the previous poll
+    aico->error = 0;
+
+    // push it
+    ok = tb_uring_push(impl, list, size);
+
+    /* killed now? cancel it
+     *
+     * the aico may be killed before pushing it, but the cancel does not find this aice
+     */
+    if (ok && tb_aico_impl_is_killed(&aico->base)) tb_uring_cancel(impl, aico);
+
+    // ok?
+    return ok;
+}
+static tb_bool_t tb_uring_post_clos(tb_uring_ptor_impl_t* impl, tb_aice_ref_t aice)
+{
+    // check
+    tb_assert_and_check_return_val(impl && aice && aice->code == TB_AICE_CODE_CLOS, tb_false);
+
+    // the aico
+    tb_uring_aico_t* aico = (tb_uring_aico_t*)aice->aico;
+    tb_assert_and_check_return_val(aico, tb_false);
+
+    // trace
+    tb_trace_d("clos: aico: %p, code: %u: %s", aico, aice->code, tb_state_cstr(tb_atomic_get(&aico->base.state)));
+
+    // exit the sock
+    if (aico->base.type == TB_AICO_TYPE_SOCK)
+    {
+        // close the socket handle
+        if (aico->base.handle) tb_socket_exit((tb_socket_ref_t)aico->base.handle);
+        aico->base.handle = tb_null;
+    }
+    // exit file
+    else if (aico->base.type == TB_AICO_TYPE_FILE)
+    {
+        // exit the file handle
+        if (aico->base.handle) tb_file_exit((tb_file_ref_t)aico->base.handle);
+        aico->base.handle = tb_null;
+    }
+
+    // clear waiting state
+    aico->aice.code = TB_AICE_CODE_NONE;
+
+    // clear type
+    aico->base.type = TB_AICO_TYPE_NONE;
+
+    // clear timeout
+    tb_size_t i = 0;
+    tb_size_t n = tb_arrayn(aico->base.timeout);
+    for (i = 0; i < n; i++) aico->base.timeout[i] = -1;
+
+    // closed
+    tb_atomic_set_explicit(&aico->base.state, TB_STATE_CLOSED, TB_ATOMIC_RELEASE);
+
+    // done the aice response function
+    tb_aice_t resp = *aice;
+    resp.state = TB_STATE_OK;
+    aice->func(&resp);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * spak
+ */
+static tb_long_t tb_uring_spak_acpt(tb_uring_ptor_impl_t* impl, tb_aice_ref_t resp, tb_long_t real)
+{
+    // the aico
+    tb_uring_aico_t* aico = (tb_uring_aico_t*)resp->aico;
+    tb_assert_and_check_return_val(aico, -1);
+
+    // failed?
+    if (real < 0) return 1;
+
+    // the accepted socket
+    tb_socket_ref_t sock = tb_fd2sock(real);
+    tb_assert_and_check_return_val(sock, -1);
+
+    // disable the nagle's algorithm for the accepted socket
+    tb_socket_ctrl(sock, TB_SOCKET_CTRL_SET_TCP_NODELAY, tb_true);
+
+    // save the address
+    tb_sockaddr_save(&resp->u.acpt.addr, &aico->addr);
+
+    // init the accepted aico
+    resp->u.acpt.aico = tb_aico_init(aico->base.aicp);
+    if (!resp->u.acpt.aico || !tb_aico_open_sock(resp->u.acpt.aico, sock))
+    {
+        // trace
+        tb_trace_e("acpt[%p]: open aico failed!", aico);
+
+        // exit it
+        if (resp->u.acpt.aico) tb_aico_exit(resp->u.acpt.aico);
+        resp->u.acpt.aico = tb_null;
+        tb_socket_exit(sock);
+    }
+
+    // accept the next socket if not killed
+    if (!tb_aico_impl_is_killed(&aico->base) && !tb_uring_post_aice(impl, aico, tb_false))
+    {
+        // trace
+        tb_trace_e("acpt[%p]: post the next acpt failed!", aico);
+    }
+
+    // no accepted aico? skip this aice
+    return resp->u.acpt.aico? 1 : 0;
+}
+static tb_long_t tb_uring_spak_sendf(tb_uring_ptor_impl_t* impl, tb_aice_ref_t resp, tb_long_t real)
+{
+    // the aico
+    tb_uring_aico_t* aico = (tb_uring_aico_t*)resp->aico;
+    tb_assert_and_check_return_val(aico && aico->base.handle, -1);
+
+    // failed?
+    if (real < 0) return 1;
+
+    // send file
+    tb_hong_t send = tb_socket_sendf((tb_socket_ref_t)aico->base.handle, resp->u.sendf.file, resp->u.sendf.seek, resp->u.sendf.size);
+
+    // trace
+    tb_trace_d("sendf[%p]: %lld", aico, send);
+
+    // ok?
+    if (send > 0)
+    {
+        resp->u.sendf.real = (tb_size_t)send;
+        resp->state = TB_STATE_OK;
+    }
+    // wait it again?
+    else if (!send) return tb_uring_post_aice(impl, aico, tb_false)? 0 : 1;
+    // failed
+    else resp->state = TB_STATE_FAILED;
+
+    // ok
+    return 1;
+}
+static tb_long_t tb_uring_spak_done(tb_uring_ptor_impl_t* impl, tb_aice_ref_t resp, struct io_uring_cqe const* cqe)
+{
+    // check
+    tb_assert_and_check_return_val(impl && resp && cqe, -1);
+
+    // wake up?
+    tb_check_return_val(cqe->user_data != TB_URING_DATA_WAKE, 0);
+
+    // the internal completion? skip it
+    tb_check_return_val(!(cqe->user_data & 1), 0);
+
+    // the aico
+    tb_uring_aico_t* aico = (tb_uring_aico_t*)(tb_size_t)cqe->user_data;
+    tb_assert_and_check_return_val(aico, -1);
+
+    // the result
+    tb_long_t real = cqe->res;
+
+    // save resp
+    *resp = aico->aice;
+
+    // trace
+    tb_trace_d("spak: aico: %p, code: %u, real: %ld", aico, resp->code, real);
+
+    // killed?
+    if (tb_aico_impl_is_killed(&aico->base))
+    {
+        // trace
+        tb_trace_d("spak: aico: %p, code: %u: killed", aico, resp->code);
+
+        // killed
+        resp->state = TB_STATE_KILLED;
+        return 1;
+    }
+
+    // the older kernel maybe not wait the socket events for the non-blocking socket, wait it and post again
+    if ((real == -EAGAIN || real == -EINPROGRESS) && aico->base.type == TB_AICO_TYPE_SOCK)
+        return tb_uring_post_aice(impl, aico, tb_true)? 0 : -1;
+
+    // cancelled by the failed poll before it? report the error of this poll instead of the timeout
+    if (real == -ECANCELED && aico->error < 0) real = aico->error;
+
+    // init the default state
+    if (real == -ECANCELED || real == -ETIME) resp->state = TB_STATE_TIMEOUT;
+    else if (real < 0) resp->state = TB_STATE_FAILED;
+    else if (!real) resp->state = TB_STATE_CLOSED;
+    else resp->state = TB_STATE_OK;
+
+    // done
+    switch (resp->code)
+    {
+    case TB_AICE_CODE_ACPT:
+        if (real >= 0) resp->state = TB_STATE_OK;
+        return tb_uring_spak_acpt(impl, resp, real);
+    case TB_AICE_CODE_CONN:
+        if (!real || real == -EISCONN) resp->state = TB_STATE_OK;
+        break;
+    case TB_AICE_CODE_RECV:
+        if (real > 0) resp->u.recv.real = real;
+        break;
+    case TB_AICE_CODE_SEND:
+        if (real > 0) resp->u.send.real = real;
+        break;
+    case TB_AICE_CODE_URECV:
+        if (real > 0)
+        {
+            resp->u.urecv.real = real;
+            tb_sockaddr_save(&resp->u.urecv.addr, &aico->addr);
+        }
+        break;
+    case TB_AICE_CODE_USEND:
+        if (real > 0) resp->u.usend.real = real;
+        break;
+    case TB_AICE_CODE_RECVV:
+        if (real > 0) resp->u.recvv.real = real;
+        break;
+    case TB_AICE_CODE_SENDV:
+        if (real > 0) resp->u.sendv.real = real;
+        break;
+    case TB_AICE_CODE_URECVV:
+        if (real > 0)
+        {
+            resp->u.urecvv.real = real;
+            tb_sockaddr_save(&resp->u.urecvv.addr, &aico->addr);
+        }
+        break;
+    case TB_AICE_CODE_USENDV:
+        if (real > 0) resp->u.usendv.real = real;
+        break;
+    case TB_AICE_CODE_SENDF:
+        return tb_uring_spak_sendf(impl, resp, real);
+    case TB_AICE_CODE_READ:
+        if (real > 0) resp->u.read.real = real;
+        break;
+    case TB_AICE_CODE_WRIT:
+        if (real > 0) resp->u.writ.real = real;
+        break;
+    case TB_AICE_CODE_READV:
+        if (real > 0) resp->u.readv.real = real;
+        break;
+    case TB_AICE_CODE_WRITV:
+        if (real > 0) resp->u.writv.real = real;
+        break;
+    case TB_AICE_CODE_FSYNC:
+        if (!real) resp->state = TB_STATE_OK;
+        break;
+    case TB_AICE_CODE_RUNTASK:
+        // the timer is expired
+        if (!real || real == -ETIME) resp->state = TB_STATE_OK;
+        break;
+    default:
+        tb_assert_and_check_return_val(0, -1);
+        break;
+    }
+
+    // clear the pending aice
+    aico->aice.code = TB_AICE_CODE_NONE;
+
+    // ok
+    return 1;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t tb_uring_ptor_addo(tb_aicp_ptor_impl_t* ptor, tb_aico_impl_t* aico)
+{
+    // check
+    tb_uring_ptor_impl_t* impl = (tb_uring_ptor_impl_t*)ptor;
+    tb_assert_and_check_return_val(impl && aico, tb_false);
+
+    // check alignment, the lower bit of the user data is used
+    tb_assert_and_check_return_val(!((tb_size_t)aico & 1), tb_false);
+
+    // trace
+    tb_trace_d("addo[%p], handle: %p", aico, aico->handle);
+
+    // done
+    tb_bool_t ok = tb_false;
+    switch (aico->type)
+    {
+    case TB_AICO_TYPE_SOCK:
+    case TB_AICO_TYPE_FILE:
+        ok = aico->handle? tb_true : tb_false;
+        break;
+    case TB_AICO_TYPE_TASK:
+        ok = tb_true;
+        break;
+    default:
+        break;
+    }
+
+    // init the uring aico
+    if (ok) ((tb_uring_aico_t*)aico)->impl = impl;
+
+    // ok?
+    return ok;
+}
+static tb_void_t tb_uring_ptor_kilo(tb_aicp_ptor_impl_t* ptor, tb_aico_impl_t* aico)
+{
+    // check
+    tb_uring_ptor_impl_t* impl = (tb_uring_ptor_impl_t*)ptor;
+    tb_assert_and_check_return(impl && aico);
+
+    // trace
+    tb_trace_d("kill: aico: %p, type: %u: ..", aico, aico->type);
+
+    // cancel the pending aice
+    tb_uring_cancel(impl, (tb_uring_aico_t*)aico);
+}
+static tb_bool_t tb_uring_ptor_post(tb_aicp_ptor_impl_t* ptor, tb_aice_ref_t aice)
+{
+    // check
+    tb_uring_ptor_impl_t* impl = (tb_uring_ptor_impl_t*)ptor;
+    tb_assert_and_check_return_val(impl && aice && aice->aico, tb_false);
+
+    // clos it directly
+    if (aice->code == TB_AICE_CODE_CLOS) return tb_uring_post_clos(impl, aice);
+
+    // the aico
+    tb_uring_aico_t* aico = (tb_uring_aico_t*)aice->aico;
+
+    // save the pending aice
+    aico->aice = *aice;
+
+    // post it
+    return tb_uring_post_aice(impl, aico, tb_false);
+}
+static tb_void_t tb_uring_ptor_kill(tb_aicp_ptor_impl_t* ptor)
+{
+    // check
+    tb_uring_ptor_impl_t* impl = (tb_uring_ptor_impl_t*)ptor;
+    tb_assert_and_check_return(impl && ptor->aicp);
+
+    // trace
+    tb_trace_d("kill: %lu", tb_atomic_get(&ptor->aicp->work));
+
+    // wake up one loop, the left loops will be waked up when the previous loop is exited
+    tb_uring_wake(impl);
+}
+static tb_void_t tb_uring_ptor_exit(tb_aicp_ptor_impl_t* ptor)
+{
+    // check
+    tb_uring_ptor_impl_t* impl = (tb_uring_ptor_impl_t*)ptor;
+    tb_assert_and_check_return(impl);
+
+    // trace
+    tb_trace_d("exit");
+
+    // exit the sqes
+    if (impl->sqes) munmap(impl->sqes, impl->sqes_size);
+    impl->sqes = tb_null;
+
+    // exit the cq ring
+    if (impl->cq_ring && impl->cq_ring != impl->sq_ring) munmap(impl->cq_ring, impl->cq_ring_size);
+    impl->cq_ring = tb_null;
+
+    // exit the sq ring
+    if (impl->sq_ring) munmap(impl->sq_ring, impl->sq_ring_size);
+    impl->sq_ring = tb_null;
+
+    // exit the ring fd
+    if (impl->fd >= 0) close(impl->fd);
+    impl->fd = -1;
+
+    // exit lock
+    tb_spinlock_exit(&impl->lock);
+    tb_spinlock_exit(&impl->rlock);
+
+    // free it
+    tb_free(impl);
+}
+static tb_void_t tb_uring_ptor_loop_exit(tb_aicp_ptor_impl_t* ptor, tb_handle_t hloop)
+{
+    // check
+    tb_uring_ptor_impl_t* impl = (tb_uring_ptor_impl_t*)ptor;
+    tb_assert_and_check_return(impl);
+
+    // the loop
+    tb_uring_loop_t* loop = (tb_uring_loop_t*)hloop;
+    tb_assert_and_check_return(loop);
+
+    // remove this loop
+    tb_size_t i = 0;
+    tb_size_t left = 0;
+    tb_spinlock_enter(&impl->lock);
+    for (i = 0; i < impl->loop_size; i++)
+    {
+        if (impl->loop_list[i] == loop)
+        {
+            impl->loop_list[i] = impl->loop_list[impl->loop_size - 1];
+            impl->loop_size--;
+            break;
+        }
+    }
+    left = impl->loop_size;
+    tb_spinlock_leave(&impl->lock);
+
+    // submit the left entries posted from this loop
+    tb_uring_submit(impl);
+
+    // killed? wake up the next loop
+    if (left && tb_atomic_get(&ptor->aicp->kill)) tb_uring_wake(impl);
+
+    // exit it
+    tb_free(loop);
+}
+static tb_handle_t tb_uring_ptor_loop_init(tb_aicp_ptor_impl_t* ptor)
+{
+    // check
+    tb_uring_ptor_impl_t* impl = (tb_uring_ptor_impl_t*)ptor;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // make loop
+    tb_uring_loop_t* loop = tb_malloc0_type(tb_uring_loop_t);
+    tb_assert_and_check_return_val(loop, tb_null);
+
+    // init self
+    loop->self = tb_thread_self();
+
+    // add this loop
+    tb_bool_t ok = tb_false;
+    tb_spinlock_enter(&impl->lock);
+    if (impl->loop_size < tb_arrayn(impl->loop_list))
+    {
+        impl->loop_list[impl->loop_size++] = loop;
+        ok = tb_true;
+    }
+    tb_spinlock_leave(&impl->lock);
+
+    // failed?
+    if (!ok)
+    {
+        // trace
+        tb_trace_e("loop: too much loops!");
+
+        // exit it
+        tb_free(loop);
+        loop = tb_null;
+    }
+
+    // ok?
+    return (tb_handle_t)loop;
+}
+static tb_long_t tb_uring_ptor_loop_spak(tb_aicp_ptor_impl_t* ptor, tb_handle_t hloop, tb_aice_ref_t resp, tb_long_t timeout)
+{
+    // check
+    tb_uring_ptor_impl_t*   impl = (tb_uring_ptor_impl_t*)ptor;
+    tb_aicp_impl_t*         aicp = impl? impl->base.aicp : tb_null;
+    tb_assert_and_check_return_val(impl && aicp && resp, -1);
+
+    // the loop
+    tb_uring_loop_t* loop = (tb_uring_loop_t*)hloop;
+    tb_assert_and_check_return_val(loop, -1);
+
+    // submit the pending entries posted from this loop
+    tb_uring_submit(impl);
+
+    // spak the reaped cqes
+    while (1)
+    {
+        // no cqes? reap them
+        if (loop->list_indx == loop->list_size)
+        {
+            loop->list_indx = 0;
+            loop->list_size = tb_uring_reap(impl, loop->list, tb_arrayn(loop->list));
+            tb_check_break(loop->list_size);
+        }
+
+        // spak it
+        tb_long_t ok = tb_uring_spak_done(impl, resp, &loop->list[loop->list_indx++]);
+        tb_check_continue(ok);
+
+        // ok or failed
+        return ok;
+    }
+
+    // killed? break it
+    tb_check_return_val(!tb_atomic_get(&aicp->kill), -1);
+
+    // trace
+    tb_trace_d("wait[%lu]: ..", loop->self);
+
+    // wait some time
+    return tb_uring_wait(impl, timeout);
+}
+static tb_bool_t tb_uring_ptor_probe(tb_long_t fd)
+{
+    // the required opcodes
+    static tb_uint8_t const s_opcodes[] =
+    {
+        IORING_OP_NOP
+    ,   IORING_OP_READV
+    ,   IORING_OP_WRITEV
+    ,   IORING_OP_FSYNC
+    ,   IORING_OP_POLL_ADD
+    ,   IORING_OP_SENDMSG
+    ,   IORING_OP_RECVMSG
+    ,   IORING_OP_TIMEOUT
+    ,   IORING_OP_ACCEPT
+    ,   IORING_OP_ASYNC_CANCEL
+    ,   IORING_OP_LINK_TIMEOUT
+    ,   IORING_OP_CONNECT
+    ,   IORING_OP_READ
+    ,   IORING_OP_WRITE
+    ,   IORING_OP_SEND
+    ,   IORING_OP_RECV
+    };
+
+    // init probe
+    tb_size_t               size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe*  probe = (struct io_uring_probe*)tb_malloc0(size);
+    tb_assert_and_check_return_val(probe, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    if (tb_uring_register(fd, IORING_REGISTER_PROBE, probe, 256) >= 0)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < tb_arrayn(s_opcodes); i++)
+        {
+            tb_uint8_t opcode = s_opcodes[i];
+            if (opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) break;
+        }
+        ok = i == tb_arrayn(s_opcodes);
+    }
+
+    // exit probe
+    tb_free(probe);
+
+    // ok?
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+static tb_aicp_ptor_impl_t* tb_uring_ptor_init(tb_aicp_impl_t* aicp)
+{
+    // check
+    tb_assert_and_check_return_val(aicp && aicp->maxn, tb_null);
+
+    // check iovec
+    tb_assert_and_check_return_val(sizeof(tb_iovec_t) == sizeof(struct iovec), tb_null);
+    tb_assert_and_check_return_val(tb_memberof_eq(tb_iovec_t, data, struct iovec, iov_base), tb_null);
+    tb_assert_and_check_return_val(tb_memberof_eq(tb_iovec_t, size, struct iovec, iov_len), tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_uring_ptor_impl_t*   impl = tb_null;
+    do
+    {
+        // make ptor
+        impl = tb_malloc0_type(tb_uring_ptor_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init base
+        impl->base.aicp         = aicp;
+        impl->base.step         = sizeof(tb_uring_aico_t);
+        impl->base.kill         = tb_uring_ptor_kill;
+        impl->base.exit         = tb_uring_ptor_exit;
+        impl->base.addo         = tb_uring_ptor_addo;
+        impl->base.kilo         = tb_uring_ptor_kilo;
+        impl->base.post         = tb_uring_ptor_post;
+        impl->base.loop_init    = tb_uring_ptor_loop_init;
+        impl->base.loop_exit    = tb_uring_ptor_loop_exit;
+        impl->base.loop_spak    = tb_uring_ptor_loop_spak;
+        impl->fd                = -1;
+
+        // init lock
+        if (!tb_spinlock_init(&impl->lock)) break;
+        if (!tb_spinlock_init(&impl->rlock)) break;
+
+        // init ring, the linked timeout and poll need more entries
+        struct io_uring_params params = {0};
+        impl->fd = tb_uring_setup((tb_uint32_t)tb_align_pow2(tb_min((aicp->maxn << 1) + 16, TB_URING_SQE_MAXN)), &params);
+        if (impl->fd < 0)
+        {
+            // trace
+            tb_trace_d("init: io_uring is not supported, errno: %d", errno);
+            break;
+        }
+        impl->features = params.features;
+
+        // the kernel is too old?
+        if (!(impl->features & IORING_FEAT_NODROP) || !(impl->features & IORING_FEAT_SUBMIT_STABLE) || !tb_uring_ptor_probe(impl->fd))
+        {
+            // trace
+            tb_trace_d("init: io_uring is too old, features: %#x", impl->features);
+            break;
+        }
+
+        // init the sq and cq ring
+        impl->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(tb_uint32_t);
+        impl->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if (impl->features & IORING_FEAT_SINGLE_MMAP)
+        {
+            // map them once
+            impl->sq_ring_size = tb_max(impl->sq_ring_size, impl->cq_ring_size);
+            impl->sq_ring = (tb_byte_t*)mmap(tb_null, impl->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, impl->fd, IORING_OFF_SQ_RING);
+            tb_assert_and_check_break(impl->sq_ring != MAP_FAILED || (impl->sq_ring = tb_null));
+            impl->cq_ring = impl->sq_ring;
+        }
+        else
+        {
+            impl->sq_ring = (tb_byte_t*)mmap(tb_null, impl->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, impl->fd, IORING_OFF_SQ_RING);
+            tb_assert_and_check_break(impl->sq_ring != MAP_FAILED || (impl->sq_ring = tb_null));
+            impl->cq_ring = (tb_byte_t*)mmap(tb_null, impl->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, impl->fd, IORING_OFF_CQ_RING);
+            tb_assert_and_check_break(impl->cq_ring != MAP_FAILED || (impl->cq_ring = tb_null));
+        }
+        impl->sq_head       = (tb_uint32_t volatile*)(impl->sq_ring + params.sq_off.head);
+        impl->sq_tail       = (tb_uint32_t volatile*)(impl->sq_ring + params.sq_off.tail);
+        impl->sq_flags      = (tb_uint32_t volatile*)(impl->sq_ring + params.sq_off.flags);
+        impl->sq_mask       = *(tb_uint32_t*)(impl->sq_ring + params.sq_off.ring_mask);
+        impl->sq_entries    = *(tb_uint32_t*)(impl->sq_ring + params.sq_off.ring_entries);
+        impl->sq_array      = (tb_uint32_t*)(impl->sq_ring + params.sq_off.array);
+        impl->cq_head       = (tb_uint32_t volatile*)(impl->cq_ring + params.cq_off.head);
+        impl->cq_tail       = (tb_uint32_t volatile*)(impl->cq_ring + params.cq_off.tail);
+        impl->cq_mask       = *(tb_uint32_t*)(impl->cq_ring + params.cq_off.ring_mask);
+        impl->cqes          = (struct io_uring_cqe*)(impl->cq_ring + params.cq_off.cqes);
+
+        // init the sqes
+        impl->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        impl->sqes = (struct io_uring_sqe*)mmap(tb_null, impl->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, impl->fd, IORING_OFF_SQES);
+        tb_assert_and_check_break(impl->sqes != MAP_FAILED || (impl->sqes = tb_null));
+
+        // register lock profiler
+#ifdef TB_LOCK_PROFILER_ENABLE
+        tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&impl->lock, "aicp_uring");
+        tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&impl->rlock, "aicp_uring_reap");
+#endif
+
+        // trace
+        tb_trace_d("init: sq: %u, cq: %u, features: %#x", params.sq_entries, params.cq_entries, impl->features);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) tb_uring_ptor_exit((tb_aicp_ptor_impl_t*)impl);
+        return tb_null;
+    }
+
+    // ok?
+    return (tb_aicp_ptor_impl_t*)impl;
+}
@@ -160,7 +160,7 @@ static tb_long_t tb_aiop_rtor_epoll_wait(tb_aiop_rtor_impl_t* rtor, tb_aioe_ref_
 {   
     // check
     tb_aiop_rtor_epoll_impl_t* impl = (tb_aiop_rtor_epoll_impl_t*)rtor;
-    tb_assert_and_check_return_val(impl && impl->epfd > 0, -1);
+    tb_assert_and_check_return_val(impl && impl->epfd > 0 && list && maxn, -1);
 
     // the aiop
     tb_aiop_impl_t* aiop = rtor->aiop;
@@ -177,8 +177,11 @@ static tb_long_t tb_aiop_rtor_epoll_wait(tb_aiop_rtor_impl_t* rtor, tb_aioe_ref_
         tb_assert_and_check_return_val(impl->evts, -1);
     }
     
-    // wait events
-    tb_long_t evtn = epoll_wait(impl->epfd, impl->evts, impl->evtn, timeout);
+    /* wait events
+     *
+     * @note do not wait the events more than maxn, the discarded events will be lost for the oneshot mode
+     */
+    tb_long_t evtn = epoll_wait(impl->epfd, impl->evts, tb_min(impl->evtn, maxn), timeout);
 
     // interrupted?(for gdb?) continue it
     if (evtn < 0 && errno == EINTR) return 0;
@@ -202,9 +205,6 @@ static tb_long_t tb_aiop_rtor_epoll_wait(tb_aiop_rtor_impl_t* rtor, tb_aioe_ref_
     }
     tb_assert(evtn <= impl->evtn);
 
-    // limit 
-    evtn = tb_min(evtn, maxn);
-
     // sync
     tb_size_t i = 0;
     tb_size_t wait = 0; 
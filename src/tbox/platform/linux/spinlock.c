@@ -0,0 +1,64 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        spinlock.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the futex word of the lock
+ *
+ * the lock state is always in the low 32-bits: 0 (left), 1 (entered), 2 (entered and contended)
+ */
+#if TB_CPU_BIT64 && defined(TB_WORDS_BIGENDIAN)
+#   define tb_spinlock_futex(lock)      ((tb_int32_t*)(lock) + 1)
+#else
+#   define tb_spinlock_futex(lock)      ((tb_int32_t*)(lock))
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_spinlock_park(tb_spinlock_ref_t lock)
+{
+    /* mark it as contended and sleep until it is left
+     *
+     * the lock will be entered with the contended state, 
+     * so we will wake up the other parked threads after leaving it
+     */
+    while (tb_atomic_fetch_and_set_explicit((tb_atomic_t*)lock, 2, TB_ATOMIC_ACQUIRE))
+        syscall(SYS_futex, tb_spinlock_futex(lock), FUTEX_WAIT_PRIVATE, 2, tb_null, tb_null, 0);
+}
+tb_void_t tb_spinlock_leave_wake(tb_spinlock_ref_t lock)
+{
+    // wake up one parked thread
+    syscall(SYS_futex, tb_spinlock_futex(lock), FUTEX_WAKE_PRIVATE, 1, tb_null, tb_null, 0);
+}
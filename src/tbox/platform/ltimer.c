@@ -35,6 +35,7 @@
 #include "../memory/memory.h"
 #include "../container/container.h"
 #include "../algorithm/algorithm.h"
+#include "../utils/utils.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -308,10 +309,90 @@ static tb_void_t tb_ltimer_expired_list_exit(tb_element_ref_t element, tb_pointe
     // clear it
     *((tb_pointer_t*)buff) = tb_null;
 }
+static tb_pointer_t tb_ltimer_instance_loop(tb_cpointer_t priv)
+{
+    // timer
+    tb_ltimer_ref_t timer = (tb_ltimer_ref_t)priv;
+
+    // trace
+    tb_trace_d("loop: init");
+
+    // loop timer
+    if (timer) tb_ltimer_loop(timer);
+    
+    // trace
+    tb_trace_d("loop: exit");
+
+    // exit
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+static tb_handle_t tb_ltimer_instance_init(tb_cpointer_t* ppriv)
+{
+    // check
+    tb_assert_and_check_return_val(ppriv, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_ltimer_ref_t     timer = tb_null;
+    do
+    {
+        // init timer
+        timer = tb_ltimer_init(0, TB_LTIMER_TICK_S, tb_true);
+        tb_assert_and_check_break(timer);
+
+        // init loop
+        *ppriv = (tb_cpointer_t)tb_thread_init(tb_null, tb_ltimer_instance_loop, timer, 0);
+        tb_assert_and_check_break(*ppriv);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit timer
+        if (timer) tb_ltimer_exit(timer);
+        timer = tb_null;
+    }
+
+    // ok?
+    return (tb_handle_t)timer;
+}
+static tb_void_t tb_ltimer_instance_exit(tb_handle_t handle, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return(handle);
+
+    // exit loop
+    tb_thread_ref_t loop = (tb_thread_ref_t)priv;
+    if (loop)
+    {
+        // wait it
+        if (!tb_thread_wait(loop, 5000)) return ;
+
+        // exit it
+        tb_thread_exit(loop);
+    }
+
+    // exit it
+    tb_ltimer_exit((tb_ltimer_ref_t)handle);
+}
+static tb_void_t tb_ltimer_instance_kill(tb_handle_t handle, tb_cpointer_t priv)
+{
+    // kill it
+    if (handle) tb_ltimer_kill((tb_ltimer_ref_t)handle);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
+tb_ltimer_ref_t tb_ltimer()
+{
+    return (tb_ltimer_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_LTIMER, tb_ltimer_instance_init, tb_ltimer_instance_exit, tb_ltimer_instance_kill, tb_null);
+}
 tb_ltimer_ref_t tb_ltimer_init(tb_size_t maxn, tb_size_t tick, tb_bool_t ctime)
 {
     // check
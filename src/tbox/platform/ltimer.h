@@ -62,6 +62,14 @@ typedef struct{}*               tb_ltimer_task_ref_t;
  * interfaces
  */
 
+/*! the global ltimer
+ *
+ * the tick is one second and the expired tasks are done at the loop thread
+ *
+ * @return              the timer
+ */
+tb_ltimer_ref_t         tb_ltimer(tb_noarg_t);
+
 /*! init timer
  *
  * lower tick and limit range, but faster
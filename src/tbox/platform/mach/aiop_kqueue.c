@@ -220,8 +220,11 @@ static tb_long_t tb_aiop_rtor_kqueue_wait(tb_aiop_rtor_impl_t* rtor, tb_aioe_ref
         tb_assert_and_check_return_val(impl->evts, -1);
     }
 
-    // wait events
-    tb_long_t evtn = kevent(impl->kqfd, tb_null, 0, impl->evts, impl->evtn, timeout >= 0? &t : tb_null);
+    /* wait events
+     *
+     * @note do not wait the events more than maxn, the discarded events will be lost for the oneshot mode
+     */
+    tb_long_t evtn = kevent(impl->kqfd, tb_null, 0, impl->evts, tb_min(impl->evtn, maxn), timeout >= 0? &t : tb_null);
     tb_assert_and_check_return_val(evtn >= 0 && evtn <= impl->evtn, -1);
     
     // timeout?
@@ -240,9 +243,6 @@ static tb_long_t tb_aiop_rtor_kqueue_wait(tb_aiop_rtor_impl_t* rtor, tb_aioe_ref
     }
     tb_assert(evtn <= impl->evtn);
 
-    // limit 
-    evtn = tb_min(evtn, maxn);
-
     // sync
     tb_size_t i = 0;
     tb_size_t wait = 0;
@@ -39,6 +39,9 @@
 #ifdef TB_CONFIG_POSIX_HAVE_SENDFILE
 #   include <sys/sendfile.h>
 #endif
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+#   include <sys/mman.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -355,6 +358,41 @@ tb_hize_t tb_file_size(tb_file_ref_t file)
     // ok?
     return size;
 }
+tb_byte_t const* tb_file_mmap(tb_file_ref_t file, tb_size_t* psize)
+{
+    // check
+    tb_assert_and_check_return_val(file && psize, tb_null);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    // the file size, the empty file cannot be mapped
+    tb_hize_t size = tb_file_size(file);
+    tb_check_return_val(size && (tb_hize_t)(tb_size_t)size == size, tb_null);
+
+    // map it
+    tb_pointer_t data = mmap(tb_null, (size_t)size, PROT_READ, MAP_PRIVATE, tb_file2fd(file), 0);
+    tb_check_return_val(data != MAP_FAILED, tb_null);
+
+    // ok
+    *psize = (tb_size_t)size;
+    return (tb_byte_t const*)data;
+#else
+    tb_trace_noimpl();
+    return tb_null;
+#endif
+}
+tb_bool_t tb_file_munmap(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    // unmap it
+    return !munmap((tb_pointer_t)data, size)? tb_true : tb_false;
+#else
+    tb_trace_noimpl();
+    return tb_false;
+#endif
+}
 tb_bool_t tb_file_info(tb_char_t const* path, tb_file_info_t* info)
 {
     // check
@@ -105,13 +105,22 @@ tb_long_t tb_semaphore_wait(tb_semaphore_ref_t semaphore, tb_long_t timeout)
     sem_t* h = (sem_t*)semaphore;
     tb_assert_and_check_return_val(h, -1);
 
-    // init time
+    /* init time
+     *
+     * @note the absolute time need the nanoseconds of now, 
+     * otherwise the timeout which is less than one second maybe be expired immediately
+     */
     struct timespec t = {0};
-    t.tv_sec = time(tb_null);
+    if (clock_gettime(CLOCK_REALTIME, &t)) t.tv_sec = time(tb_null);
     if (timeout > 0)
     {
         t.tv_sec += timeout / 1000;
         t.tv_nsec += (timeout % 1000) * 1000000;
+        if (t.tv_nsec >= 1000000000)
+        {
+            t.tv_sec++;
+            t.tv_nsec -= 1000000000;
+        }
     }
     else if (timeout < 0) t.tv_sec += 12 * 30 * 24 * 3600; // infinity: one year
 
@@ -0,0 +1,194 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        thread_store.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../memory.h"
+#include <pthread.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the thread store slots type
+typedef struct __tb_thread_store_slots_t
+{
+    // the data for each type
+    tb_thread_store_data_ref_t      data[TB_THREAD_STORE_DATA_TYPE_MAXN];
+
+}tb_thread_store_slots_t, *tb_thread_store_slots_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the thread local key
+static pthread_key_t            g_key;
+
+/* the key have been created? only modified in the lock
+ *
+ * the key will not be deleted when exiting the store, 
+ * so the slots of the other living threads are still freed when they exit
+ */
+static tb_bool_t                g_keyed = tb_false;
+
+// the store have been inited? only modified in the lock
+static __tb_volatile__ tb_bool_t g_inited = tb_false;
+
+// the lock
+static tb_spinlock_t            g_lock = TB_SPINLOCK_INIT;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_thread_store_slots_free(tb_thread_store_slots_ref_t slots)
+{
+    // check
+    tb_assert_and_check_return(slots);
+
+    // free data
+    tb_size_t i = 0;
+    for (i = 0; i < TB_THREAD_STORE_DATA_TYPE_MAXN; i++)
+    {
+        tb_thread_store_data_ref_t data = slots->data[i];
+        slots->data[i] = tb_null;
+        if (data && data->free) data->free(data);
+    }
+
+    // free slots
+    tb_native_memory_free(slots);
+}
+static tb_void_t tb_thread_store_slots_exit(tb_pointer_t priv)
+{
+    // the slots
+    tb_thread_store_slots_ref_t slots = (tb_thread_store_slots_ref_t)priv;
+    tb_check_return(slots);
+
+    // free it
+    tb_thread_store_slots_free(slots);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_thread_store_init()
+{
+    // enter lock
+    tb_spinlock_enter(&g_lock);
+
+    // init the thread local key, the slots will be freed when the thread exits
+    tb_bool_t ok = tb_true;
+    if (!g_keyed)
+    {
+        // init key
+        if (!pthread_key_create(&g_key, tb_thread_store_slots_exit)) g_keyed = tb_true;
+        else ok = tb_false;
+    }
+
+    // inited
+    if (ok) g_inited = tb_true;
+
+    // leave lock
+    tb_spinlock_leave(&g_lock);
+
+    // register lock profiler
+#ifdef TB_LOCK_PROFILER_ENABLE
+    tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&g_lock, TB_TRACE_MODULE_NAME);
+#endif
+
+    // ok?
+    return ok;
+}
+tb_void_t tb_thread_store_exit()
+{
+    // enter lock
+    tb_spinlock_enter(&g_lock);
+
+    /* take the slots of the current thread
+     *
+     * @note the slots of the other living threads may be still used by them now,
+     * so we only free them when these threads exit
+     */
+    tb_thread_store_slots_ref_t slots = tb_null;
+    if (g_inited)
+    {
+        // remove slots
+        slots = (tb_thread_store_slots_ref_t)pthread_getspecific(g_key);
+        if (slots) pthread_setspecific(g_key, tb_null);
+
+        // exited
+        g_inited = tb_false;
+    }
+
+    // leave lock
+    tb_spinlock_leave(&g_lock);
+
+    // free the slots of the current thread
+    if (slots) tb_thread_store_slots_free(slots);
+}
+tb_void_t tb_thread_store_setp(tb_thread_store_data_t const* data)
+{
+    // check
+    tb_assert_and_check_return(data);
+
+    // the slot
+    tb_size_t slot = tb_thread_store_slot(data->type);
+    tb_check_return(g_inited);
+
+    // get slots
+    tb_thread_store_slots_ref_t slots = (tb_thread_store_slots_ref_t)pthread_getspecific(g_key);
+    if (!slots)
+    {
+        // make slots, uses the native memory because the allocator may use the thread store
+        slots = (tb_thread_store_slots_ref_t)tb_native_memory_malloc0(sizeof(tb_thread_store_slots_t));
+        tb_assert_and_check_return(slots);
+
+        // save slots
+        pthread_setspecific(g_key, slots);
+    }
+
+    // save data
+    tb_thread_store_data_ref_t data_old = slots->data[slot];
+    slots->data[slot] = (tb_thread_store_data_ref_t)data;
+
+    // free the old data
+    if (data_old && data_old != data && data_old->free) data_old->free(data_old);
+}
+tb_thread_store_data_ref_t tb_thread_store_getp()
+{
+    // get the user data
+    return tb_thread_store_getp_type(TB_THREAD_STORE_DATA_TYPE_USER);
+}
+tb_thread_store_data_ref_t tb_thread_store_getp_type(tb_size_t type)
+{
+    // the slot
+    tb_size_t slot = tb_thread_store_slot(type);
+    tb_check_return_val(g_inited, tb_null);
+
+    // get data
+    tb_thread_store_slots_ref_t slots = (tb_thread_store_slots_ref_t)pthread_getspecific(g_key);
+    return slots? slots->data[slot] : tb_null;
+}
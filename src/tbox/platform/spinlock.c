@@ -0,0 +1,97 @@
+/*!The Treasure Box Library
+ * 
+ * TBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * TBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with TBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        spinlock.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "spinlock.h"
+#include "barrier.h"
+#include "processor.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the spin count before parking the current thread
+#ifdef __tb_small__
+#   define TB_SPINLOCK_SPIN_MAXN        (64)
+#else
+#   define TB_SPINLOCK_SPIN_MAXN        (128)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the spin count, spinning is useless if there is only one processor
+static tb_atomic_t      g_spin_maxn = -1;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef TB_CONFIG_LINUX_HAVE_FUTEX
+#   include "linux/spinlock.c"
+#else
+static tb_void_t tb_spinlock_park(tb_spinlock_ref_t lock)
+{
+    // yield the processor until the lock is left
+    while (tb_atomic_fetch_and_pset_explicit((tb_atomic_t*)lock, 0, 1, TB_ATOMIC_ACQUIRE)) tb_sched_yield();
+}
+tb_void_t tb_spinlock_leave_wake(tb_spinlock_ref_t lock)
+{
+    // no parked thread
+    tb_used(lock);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_spinlock_enter_wait(tb_spinlock_ref_t lock)
+{
+    // check
+    tb_assert(lock);
+
+    // init the spin count 
+    tb_long_t spin_maxn = tb_atomic_get_explicit(&g_spin_maxn, TB_ATOMIC_RELAXED);
+    if (spin_maxn < 0) 
+    {
+        spin_maxn = tb_processor_count() > 1? TB_SPINLOCK_SPIN_MAXN : 0;
+        tb_atomic_set_explicit(&g_spin_maxn, spin_maxn, TB_ATOMIC_RELAXED);
+    }
+
+    // spin a while, the lock holder running on the other processor may leave it soon
+    while (spin_maxn-- > 0)
+    {
+        // pause the processor
+        tb_cpu_pause();
+
+        // try locking it if it has been left
+        if (!tb_atomic_get_explicit((tb_atomic_t*)lock, TB_ATOMIC_RELAXED) && !tb_atomic_fetch_and_pset_explicit((tb_atomic_t*)lock, 0, 1, TB_ATOMIC_ACQUIRE)) return tb_false;
+    }
+
+    // park the current thread
+    tb_spinlock_park(lock);
+    return tb_true;
+}
@@ -39,10 +39,36 @@
 // the initial value
 #define TB_SPINLOCK_INIT            (0)
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
 
+/*! wait the occupied spinlock and enter it
+ *
+ * spin a while with the cpu pause first, then park the current thread on the futex (linux) 
+ * or yield the processor until the lock is left.
+ *
+ * @note only for the slow path of tb_spinlock_enter()
+ *
+ * @param lock      the lock
+ *
+ * @return          tb_true if the current thread has been parked, otherwise tb_false 
+ */
+tb_bool_t           tb_spinlock_enter_wait(tb_spinlock_ref_t lock);
+
+/*! wake up a parked thread of the left spinlock 
+ *
+ * @note only for the slow path of tb_spinlock_leave()
+ *
+ * @param lock      the lock
+ */
+tb_void_t           tb_spinlock_leave_wake(tb_spinlock_ref_t lock);
+
 /*! init spinlock 
  *
  * @param lock      the lock
@@ -83,43 +109,24 @@ static __tb_inline_force__ tb_void_t tb_spinlock_enter(tb_spinlock_ref_t lock)
     // check
     tb_assert(lock);
 
-    // init tryn
-    tb_size_t tryn = 5;
-    
-    // init occupied
-#ifdef TB_LOCK_PROFILER_ENABLE
-    tb_bool_t occupied = tb_false;
-#endif
-
     // lock it
-    while (tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1))
-    {
+    if (!tb_atomic_fetch_and_pset_explicit((tb_atomic_t*)lock, 0, 1, TB_ATOMIC_ACQUIRE)) return ;
+
 #ifdef TB_LOCK_PROFILER_ENABLE
-        // occupied
-        if (!occupied)
-        {
-            // occupied++
-            occupied = tb_true;
-            tb_lock_profiler_occupied(tb_lock_profiler(), (tb_pointer_t)lock);
-
-            // dump backtrace
+    // occupied
+    tb_lock_profiler_occupied(tb_lock_profiler(), (tb_pointer_t)lock);
+
+    // dump backtrace
 #if 0//def __tb_debug__
-            tb_backtrace_dump("spinlock", tb_null, 10);
-#endif
-        }
+    tb_backtrace_dump("spinlock", tb_null, 10);
 #endif
 
-        // yield the processor
-        if (!tryn--)
-        {
-            // yield
-            tb_sched_yield();
-//          tb_usleep(1);
-
-            // reset tryn
-            tryn = 5;
-        }
-    }
+    // wait it and the current thread has been parked?
+    if (tb_spinlock_enter_wait(lock)) tb_lock_profiler_parked(tb_lock_profiler(), (tb_pointer_t)lock);
+#else
+    // wait it
+    tb_spinlock_enter_wait(lock);
+#endif
 }
 
 /*! enter spinlock without the lock profiler
@@ -131,23 +138,8 @@ static __tb_inline_force__ tb_void_t tb_spinlock_enter_without_profiler(tb_spinl
     // check
     tb_assert(lock);
 
-    // init tryn
-    tb_size_t tryn = 5;
-    
     // lock it
-    while (tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1))
-    {
-        // yield the processor
-        if (!tryn--)
-        {
-            // yield
-            tb_sched_yield();
-//          tb_usleep(1);
-
-            // reset tryn
-            tryn = 5;
-        }
-    }
+    if (tb_atomic_fetch_and_pset_explicit((tb_atomic_t*)lock, 0, 1, TB_ATOMIC_ACQUIRE)) tb_spinlock_enter_wait(lock);
 }
 
 /*! try to enter spinlock
@@ -163,10 +155,10 @@ static __tb_inline_force__ tb_bool_t tb_spinlock_enter_try(tb_spinlock_ref_t loc
 
 #ifndef TB_LOCK_PROFILER_ENABLE
     // try locking it
-    return !tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1);
+    return !tb_atomic_fetch_and_pset_explicit((tb_atomic_t*)lock, 0, 1, TB_ATOMIC_ACQUIRE);
 #else
     // try locking it
-    tb_bool_t ok = !tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1);
+    tb_bool_t ok = !tb_atomic_fetch_and_pset_explicit((tb_atomic_t*)lock, 0, 1, TB_ATOMIC_ACQUIRE);
 
     // occupied?
     if (!ok) tb_lock_profiler_occupied(tb_lock_profiler(), (tb_pointer_t)lock);
@@ -188,7 +180,7 @@ static __tb_inline_force__ tb_bool_t tb_spinlock_enter_try_without_profiler(tb_s
     tb_assert(lock);
 
     // try locking it
-    return !tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1);
+    return !tb_atomic_fetch_and_pset_explicit((tb_atomic_t*)lock, 0, 1, TB_ATOMIC_ACQUIRE);
 }
 
 /*! leave spinlock
@@ -200,8 +192,18 @@ static __tb_inline_force__ tb_void_t tb_spinlock_leave(tb_spinlock_ref_t lock)
     // check
     tb_assert(lock);
 
+#ifdef TB_CONFIG_LINUX_HAVE_FUTEX
+    // leave it and wake up a parked thread if the lock is contended
+    if (tb_atomic_fetch_and_set_explicit((tb_atomic_t*)lock, 0, TB_ATOMIC_RELEASE) > 1) tb_spinlock_leave_wake(lock);
+#else
     // leave
-    *((tb_atomic_t*)lock) = 0;
+    tb_atomic_set_explicit((tb_atomic_t*)lock, 0, TB_ATOMIC_RELEASE);
+#endif
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
 #endif
@@ -76,6 +76,20 @@
 #   define TB_THREAD_POOL_JOBS_PULL_TIME_MAXN   (20000)
 #endif
 
+// the local jobs deque maxn for the work-stealing mode, must be power of 2
+#ifdef __tb_small__
+#   define TB_THREAD_POOL_JOBS_LOCAL_MAXN       (256)
+#else
+#   define TB_THREAD_POOL_JOBS_LOCAL_MAXN       (1024)
+#endif
+
+// the pull jobs maxn from the shared jobs for the work-stealing mode
+#ifdef __tb_small__
+#   define TB_THREAD_POOL_JOBS_LOCAL_PULL_MAXN  (16)
+#else
+#   define TB_THREAD_POOL_JOBS_LOCAL_PULL_MAXN  (32)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -99,6 +113,9 @@ typedef struct __tb_thread_pool_job_t
      */
     tb_atomic_t                         state;
 
+    // the kill generation of the pool when posting it, only for the work-stealing mode
+    tb_size_t                           killn;
+
     // the entry
     tb_list_entry_t                     entry;
 
@@ -126,6 +143,29 @@ typedef struct __tb_thread_pool_worker_priv_t
 
 }tb_thread_pool_worker_priv_t;
 
+/* the thread pool worker local jobs type for the work-stealing mode
+ *
+ * the bounded chase-lev deque:
+ *
+ * the owner pushes and pops jobs at the bottom, the thieves steal jobs at the top
+ *
+ *  top                   bottom
+ *   |                      |
+ * [job, job, job, ..., job]
+ */
+typedef struct __tb_thread_pool_worker_deque_t
+{
+    // the top
+    tb_atomic_t                         top;
+
+    // the bottom
+    tb_atomic_t                         bottom;
+
+    // the jobs
+    tb_thread_pool_job_t* __tb_volatile__* jobs;
+
+}tb_thread_pool_worker_deque_t;
+
 // the thread pool worker type
 typedef struct __tb_thread_pool_worker_t
 {
@@ -138,14 +178,29 @@ typedef struct __tb_thread_pool_worker_t
     // the loop
     tb_thread_ref_t                     loop;
 
+    // the loop thread id
+    tb_size_t                           self;
+
     // the jobs
     tb_vector_ref_t                     jobs;
 
+    // the local jobs for the work-stealing mode
+    tb_thread_pool_worker_deque_t       local;
+
+    // the random seed for choosing the victim
+    tb_size_t                           seed;
+
+    // the done count of the local jobs
+    tb_size_t                           done_local;
+
+    // the done count of the stolen jobs
+    tb_size_t                           done_steal;
+
     // the pull time
     tb_size_t                           pull;
 
     // the stats
-    tb_hash_map_ref_t                   stats;
+    tb_flat_hash_map_ref_t              stats;
 
     // is stoped?
     tb_atomic_t                         bstoped;
@@ -155,6 +210,17 @@ typedef struct __tb_thread_pool_worker_t
 
 }tb_thread_pool_worker_t;
 
+// the thread pool worker scope type for the current thread
+typedef struct __tb_thread_pool_worker_scope_t
+{
+    // the thread store data base
+    tb_thread_store_data_t              base;
+
+    // the worker of the current thread
+    tb_thread_pool_worker_t*            worker;
+
+}tb_thread_pool_worker_scope_t;
+
 // the thread pool type
 typedef struct __tb_thread_pool_impl_t
 {
@@ -167,9 +233,21 @@ typedef struct __tb_thread_pool_impl_t
     // the lock
     tb_spinlock_t                       lock;
 
+    // is work-stealing mode?
+    tb_bool_t                           stealing;
+
     // the jobs pool
     tb_fixed_pool_ref_t                 jobs_pool;
 
+    // the jobs count for the work-stealing mode
+    tb_atomic_t                         jobs_count;
+
+    // the kill generation for the work-stealing mode
+    tb_atomic_t                         jobs_killn;
+
+    // the idle worker count for the work-stealing mode
+    tb_atomic_t                         worker_idle;
+
     // the urgent jobs
     tb_list_entry_head_t                jobs_urgent;
     
@@ -185,8 +263,12 @@ typedef struct __tb_thread_pool_impl_t
     // the semaphore
     tb_semaphore_ref_t                  semaphore;
     
-    // the worker size
-    tb_size_t                           worker_size;
+    /* the worker size
+     *
+     * it is only modified in the lock and published after the new workers have been inited,
+     * so the workers can read it and walk the worker list without the lock
+     */
+    tb_atomic_t                         worker_size;
 
     // the worker list
     tb_thread_pool_worker_t             worker_list[TB_THREAD_POOL_WORKER_MAXN];
@@ -250,9 +332,9 @@ static tb_bool_t tb_thread_pool_worker_walk_pull(tb_iterator_ref_t iterator, tb_
 
     // computate the job average time 
     tb_size_t average_time = 200;
-    if (tb_hash_map_size(worker->stats))
+    if (tb_flat_hash_map_size(worker->stats))
     {
-        tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_hash_map_get(worker->stats, job->task.done);
+        tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_flat_hash_map_get(worker->stats, job->task.done);
         if (stats && stats->done_count) average_time = (tb_size_t)(stats->total_time / stats->done_count);
     }
 
@@ -276,7 +358,7 @@ static tb_bool_t tb_thread_pool_worker_walk_pull_and_clean(tb_iterator_ref_t ite
     tb_assert(job);
 
     // the job state
-    tb_size_t state = tb_atomic_get(&job->state);
+    tb_size_t state = tb_atomic_get_explicit(&job->state, TB_ATOMIC_ACQUIRE);
 
     // waiting and non-full? pull it
     tb_bool_t ok = tb_false;
@@ -287,9 +369,9 @@ static tb_bool_t tb_thread_pool_worker_walk_pull_and_clean(tb_iterator_ref_t ite
 
         // computate the job average time 
         tb_size_t average_time = 200;
-        if (tb_hash_map_size(worker->stats))
+        if (tb_flat_hash_map_size(worker->stats))
         {
-            tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_hash_map_get(worker->stats, job->task.done);
+            tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_flat_hash_map_get(worker->stats, job->task.done);
             if (stats && stats->done_count) average_time = (tb_size_t)(stats->total_time / stats->done_count);
         }
 
@@ -339,7 +421,7 @@ static tb_bool_t tb_thread_pool_worker_walk_clean(tb_iterator_ref_t iterator, tb
     tb_assert(job);
 
     // the job state
-    tb_size_t state = tb_atomic_get(&job->state);
+    tb_size_t state = tb_atomic_get_explicit(&job->state, TB_ATOMIC_ACQUIRE);
 
     // finished or killed? remove it
     tb_bool_t ok = tb_false;
@@ -383,6 +465,398 @@ static tb_void_t tb_thread_pool_worker_post(tb_thread_pool_impl_t* impl, tb_size
     if (value >= 0 && (tb_size_t)value < post) 
         tb_semaphore_post(impl->semaphore, post - value);
 }
+static tb_void_t tb_thread_pool_worker_done(tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert_and_check_return(worker && worker->stats && job && job->task.done);
+
+    // the job state, acquire it for the job data
+    tb_size_t state = tb_atomic_fetch_and_pset_explicit(&job->state, TB_STATE_WAITING, TB_STATE_WORKING, TB_ATOMIC_ACQUIRE);
+    
+    // the job is waiting? work it
+    if (state == TB_STATE_WAITING)
+    {
+        // trace
+        tb_trace_d("worker[%lu]: done: task[%p:%s]: ..", worker->id, job->task.done, job->task.name);
+
+        // init the time
+        tb_hong_t time = tb_cache_time_spak();
+
+        // done the job
+        job->task.done((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+        // computate the time
+        time = tb_cache_time_spak() - time;
+
+        // exists? update time and count
+        tb_size_t                   itor;
+        tb_flat_hash_map_item_ref_t item = tb_null;
+        if (    ((itor = tb_flat_hash_map_find(worker->stats, job->task.done)) != tb_iterator_tail(worker->stats))
+            &&  (item = (tb_flat_hash_map_item_ref_t)tb_iterator_item(worker->stats, itor)))
+        {
+            // the stats
+            tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)item->data;
+            tb_assert(stats);
+
+            // update the done count
+            stats->done_count++;
+
+            // update the total time 
+            stats->total_time += time;
+        }
+        
+        // no item? add it
+        if (!item) 
+        {
+            // init stats
+            tb_thread_pool_job_stats_t stats = {0};
+            stats.done_count = 1;
+            stats.total_time = time;
+
+            // add stats
+            tb_flat_hash_map_insert(worker->stats, job->task.done, &stats);
+        }
+
+#ifdef TB_TRACE_DEBUG
+        tb_size_t done_count = 0;
+        tb_hize_t total_time = 0;
+        tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_flat_hash_map_get(worker->stats, job->task.done);
+        if (stats)
+        {
+            done_count = stats->done_count;
+            total_time = stats->total_time;
+        }
+
+        // trace
+        tb_trace_d("worker[%lu]: done: task[%p:%s]: time: %lld ms, average: %lld ms, count: %lu", worker->id, job->task.done, job->task.name, time, (total_time / (tb_hize_t)done_count), done_count);
+#endif
+
+        // update the job state and publish the job results to the waiter
+        tb_atomic_set_explicit(&job->state, TB_STATE_FINISHED, TB_ATOMIC_RELEASE);
+    }
+    // the job is killing? work it
+    else if (state == TB_STATE_KILLING)
+    {
+        // update the job state
+        tb_atomic_set_explicit(&job->state, TB_STATE_KILLED, TB_ATOMIC_RELEASE);
+    }
+}
+static tb_bool_t tb_thread_pool_worker_local_push(tb_thread_pool_worker_deque_t* local, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(local && local->jobs && job);
+
+    // full?
+    tb_long_t bottom = local->bottom;
+    tb_long_t top = tb_atomic_get(&local->top);
+    tb_check_return_val(bottom - top < TB_THREAD_POOL_JOBS_LOCAL_MAXN, tb_false);
+
+    // push it to the bottom, only for the owner
+    local->jobs[bottom & (TB_THREAD_POOL_JOBS_LOCAL_MAXN - 1)] = job;
+    tb_atomic_set(&local->bottom, bottom + 1);
+
+    // ok
+    return tb_true;
+}
+static tb_thread_pool_job_t* tb_thread_pool_worker_local_pop(tb_thread_pool_worker_deque_t* local)
+{
+    // check
+    tb_assert(local && local->jobs);
+
+    // reserve the bottom job first, only for the owner
+    tb_long_t bottom = local->bottom - 1;
+    tb_atomic_set(&local->bottom, bottom);
+
+    // done
+    tb_long_t               top = tb_atomic_get(&local->top);
+    tb_thread_pool_job_t*   job = tb_null;
+    if (top <= bottom)
+    {
+        // get the bottom job
+        job = local->jobs[bottom & (TB_THREAD_POOL_JOBS_LOCAL_MAXN - 1)];
+
+        // the last job? race with the thieves
+        if (top == bottom)
+        {
+            // failed? it has been stolen
+            if (tb_atomic_fetch_and_pset(&local->top, top, top + 1) != top) job = tb_null;
+
+            // restore the bottom
+            tb_atomic_set(&local->bottom, bottom + 1);
+        }
+    }
+    // empty? restore the bottom
+    else tb_atomic_set(&local->bottom, bottom + 1);
+
+    // ok?
+    return job;
+}
+static tb_thread_pool_job_t* tb_thread_pool_worker_local_steal(tb_thread_pool_worker_deque_t* local)
+{
+    // check
+    tb_assert(local);
+
+    // no jobs?
+    tb_check_return_val(local->jobs, tb_null);
+
+    // empty?
+    tb_long_t top = tb_atomic_get(&local->top);
+    tb_long_t bottom = tb_atomic_get(&local->bottom);
+    tb_check_return_val(top < bottom, tb_null);
+
+    // steal the top job
+    tb_thread_pool_job_t* job = local->jobs[top & (TB_THREAD_POOL_JOBS_LOCAL_MAXN - 1)];
+
+    // ok? 
+    return (tb_atomic_fetch_and_pset(&local->top, top, top + 1) == top)? job : tb_null;
+}
+static tb_thread_pool_job_t* tb_thread_pool_worker_steal(tb_thread_pool_worker_t* worker)
+{
+    // the pool
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+    tb_assert(impl);
+
+    // no other workers?
+    tb_size_t n = (tb_size_t)tb_atomic_get_explicit(&impl->worker_size, TB_ATOMIC_ACQUIRE);
+    tb_check_return_val(n > 1, tb_null);
+
+    // choose the first victim randomly
+    worker->seed = worker->seed * 1103515245 + 12345;
+    tb_size_t i = 0;
+    tb_size_t b = (worker->seed >> 16) % n;
+
+    // steal one job from the other workers
+    tb_thread_pool_job_t* job = tb_null;
+    for (i = 0; i < n && !job; i++)
+    {
+        // the victim
+        tb_thread_pool_worker_t* victim = &impl->worker_list[(b + i) % n];
+        tb_check_continue(victim != worker);
+
+        // steal it
+        job = tb_thread_pool_worker_local_steal(&victim->local);
+    }
+
+    // trace
+    if (job) tb_trace_d("worker[%lu]: steal: task[%p:%s]", worker->id, job->task.done, job->task.name);
+
+    // ok?
+    return job;
+}
+static tb_thread_pool_job_t* tb_thread_pool_worker_pull(tb_thread_pool_worker_t* worker)
+{
+    // the pool
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+    tb_assert(impl);
+
+    // no shared jobs?
+    tb_check_return_val(tb_list_entry_size(&impl->jobs_urgent) + tb_list_entry_size(&impl->jobs_waiting), tb_null);
+
+    // enter 
+    tb_spinlock_enter(&impl->lock);
+
+    /* computate the pull count, the others can steal them from our local jobs 
+     *
+     * the free space of the local jobs will not be decreased by the thieves, 
+     * so we can push the pulled jobs safely
+     */
+    tb_size_t left = TB_THREAD_POOL_JOBS_LOCAL_MAXN - (tb_size_t)(worker->local.bottom - tb_atomic_get(&worker->local.top));
+    tb_size_t maxn = (tb_list_entry_size(&impl->jobs_urgent) + tb_list_entry_size(&impl->jobs_waiting)) / tb_max(impl->worker_size, 1);
+    maxn = tb_min(tb_max(maxn, 1), tb_min(left + 1, TB_THREAD_POOL_JOBS_LOCAL_PULL_MAXN));
+
+    // pull jobs from the urgent jobs first, and then pull them from the waiting jobs
+    tb_size_t                   size = 0;
+    tb_thread_pool_job_t*       jobs[TB_THREAD_POOL_JOBS_LOCAL_PULL_MAXN];
+    tb_list_entry_head_ref_t    lists[TB_THREAD_POOL_JOBS_LOCAL_PULL_MAXN];
+    while (size < maxn)
+    {
+        // the jobs list
+        tb_list_entry_head_ref_t list = tb_list_entry_size(&impl->jobs_urgent)? &impl->jobs_urgent : &impl->jobs_waiting;
+        tb_check_break(tb_list_entry_size(list));
+
+        // pull it and save its source list
+        lists[size] = list;
+        jobs[size++] = (tb_thread_pool_job_t*)tb_list_entry(list, tb_list_entry_head(list));
+        tb_list_entry_remove_head(list);
+    }
+
+    // leave 
+    tb_spinlock_leave(&impl->lock);
+
+    // trace
+    tb_trace_d("worker[%lu]: pull: %lu jobs", worker->id, size);
+
+    // push the other jobs to the local jobs in reverse order, so we will pop them in the original order
+    tb_size_t i = size;
+    while (i > 1 && tb_thread_pool_worker_local_push(&worker->local, jobs[i - 1])) i--;
+
+    // the local jobs is full? put the left jobs back to the head of the shared jobs
+    if (i > 1)
+    {
+        // trace
+        tb_trace_w("worker[%lu]: the local jobs is full, put %lu jobs back!", worker->id, i - 1);
+
+        /* put them back to their source lists in reverse order, so they will be pulled in the original order
+         *
+         * @note the waiting jobs must not be promoted to the urgent jobs
+         */
+        tb_spinlock_enter(&impl->lock);
+        while (i > 1) 
+        {
+            i--;
+            tb_list_entry_insert_head(lists[i], &jobs[i]->entry);
+        }
+        tb_spinlock_leave(&impl->lock);
+    }
+
+    // done the first job directly
+    return size? jobs[0] : tb_null;
+}
+static tb_thread_pool_job_t* tb_thread_pool_worker_find(tb_thread_pool_worker_t* worker, tb_bool_t* stolen)
+{
+    // the pool
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+    tb_assert(impl && stolen);
+
+    // done
+    tb_thread_pool_job_t* job = tb_null;
+    do
+    {
+        // pull the urgent jobs first
+        if (tb_list_entry_size(&impl->jobs_urgent) && (job = tb_thread_pool_worker_pull(worker))) break;
+
+        // pop the local job
+        if ((job = tb_thread_pool_worker_local_pop(&worker->local))) break;
+
+        // steal job from the other workers
+        if ((job = tb_thread_pool_worker_steal(worker)))
+        {
+            *stolen = tb_true;
+            break;
+        }
+
+        // pull the waiting jobs
+        job = tb_thread_pool_worker_pull(worker);
+
+    } while (0);
+
+    // ok?
+    return job;
+}
+static tb_void_t tb_thread_pool_worker_loop_stealing(tb_thread_pool_worker_t* worker)
+{
+    // the pool
+    tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+    tb_assert_and_check_return(impl && impl->semaphore && worker->local.jobs);
+
+    // init the random seed
+    worker->seed = worker->self ^ (worker->id + 1);
+
+    // loop
+    while (1)
+    {
+        // find job
+        tb_bool_t               stolen = tb_false;
+        tb_thread_pool_job_t*   job = tb_thread_pool_worker_find(worker, &stolen);
+        if (!job)
+        {
+            /* idle now, the poster will wake up us if there are some idle workers
+             *
+             * @note it must be sequentially consistent, the poster pushes the job and then checks the idle count
+             */
+            tb_atomic_fetch_and_inc(&impl->worker_idle);
+
+            // find it again, some jobs may be pushed before updating the idle count
+            job = tb_thread_pool_worker_find(worker, &stolen);
+            if (!job)
+            {
+                // killed?
+                if (tb_atomic_get_explicit(&worker->bstoped, TB_ATOMIC_RELAXED))
+                {
+                    tb_atomic_fetch_and_dec(&impl->worker_idle);
+                    break;
+                }
+
+                // trace
+                tb_trace_d("worker[%lu]: wait: ..", worker->id);
+
+                // wait some time
+                tb_long_t wait = tb_semaphore_wait(impl->semaphore, -1);
+
+                // trace
+                tb_trace_d("worker[%lu]: wait: ok", worker->id);
+
+                // busy now
+                tb_atomic_fetch_and_dec(&impl->worker_idle);
+
+                // failed?
+                tb_assert_and_check_break(wait > 0);
+
+                // continue it
+                continue;
+            }
+
+            // busy now
+            tb_atomic_fetch_and_dec(&impl->worker_idle);
+        }
+
+        // check
+        tb_assert_and_check_continue(job->task.done);
+
+        // killed after posting it?
+        if (job->killn != (tb_size_t)tb_atomic_get_explicit(&impl->jobs_killn, TB_ATOMIC_RELAXED))
+            tb_atomic_pset_explicit(&job->state, TB_STATE_WAITING, TB_STATE_KILLING, TB_ATOMIC_RELAXED);
+
+        // done it
+        tb_thread_pool_worker_done(worker, job);
+
+        // update the done count
+        if (stolen) worker->done_steal++;
+        else worker->done_local++;
+
+        // trace
+        tb_trace_d("worker[%lu]: remove: task[%p:%s]", worker->id, job->task.done, job->task.name);
+
+        // exit the job
+        if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+        // refn--, remove it directly if no references
+        if (tb_atomic_fetch_and_dec_explicit(&job->refn, TB_ATOMIC_ACQ_REL) == 1)
+        {
+            tb_free(job);
+            tb_atomic_fetch_and_dec_explicit(&impl->jobs_count, TB_ATOMIC_RELEASE);
+        }
+    }
+}
+static tb_void_t tb_thread_pool_worker_scope_free(tb_thread_store_data_t* data)
+{
+    // exit it
+    if (data) tb_free(data);
+}
+static tb_void_t tb_thread_pool_worker_scope_set(tb_thread_pool_worker_t* worker)
+{
+    // get scope
+    tb_thread_pool_worker_scope_t* scope = (tb_thread_pool_worker_scope_t*)tb_thread_store_getp_type(TB_THREAD_STORE_DATA_TYPE_THREAD_POOL);
+    if (!scope)
+    {
+        // clear it? 
+        tb_check_return(worker);
+
+        // make scope
+        scope = tb_malloc0_type(tb_thread_pool_worker_scope_t);
+        tb_assert_and_check_return(scope);
+
+        // init scope
+        scope->base.type = TB_THREAD_STORE_DATA_TYPE_THREAD_POOL;
+        scope->base.free = tb_thread_pool_worker_scope_free;
+
+        // save scope, it will be freed when the thread exits
+        tb_thread_store_setp((tb_thread_store_data_t const*)scope);
+    }
+
+    // save the worker of the current thread
+    scope->worker = worker;
+}
 static tb_pointer_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
 {
     // the worker
@@ -401,6 +875,9 @@ static tb_pointer_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
         tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
         tb_assert_and_check_break(impl && impl->semaphore);
 
+        // save the loop thread id
+        worker->self = tb_thread_self();
+
         // wait some time for leaving the lock
         tb_msleep((worker->id + 1) * 20);
 
@@ -409,8 +886,22 @@ static tb_pointer_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
         tb_assert_and_check_break(worker->jobs);
 
         // init stats
-        worker->stats = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_ptr(tb_null, tb_null), tb_element_mem(sizeof(tb_thread_pool_job_stats_t), tb_null, tb_null));
+        worker->stats = tb_flat_hash_map_init(TB_FLAT_HASH_MAP_ITEM_SIZE_MICRO, tb_element_ptr(tb_null, tb_null), tb_element_mem(sizeof(tb_thread_pool_job_stats_t), tb_null, tb_null));
         tb_assert_and_check_break(worker->stats);
+
+        // work-stealing mode?
+        if (impl->stealing)
+        {
+            // save the current worker for posting the local jobs
+            tb_thread_pool_worker_scope_set(worker);
+
+            // loop
+            tb_thread_pool_worker_loop_stealing(worker);
+
+            // clear the current worker, it will be exited with the pool
+            tb_thread_pool_worker_scope_set(tb_null);
+            break;
+        }
         
         // loop
         while (1)
@@ -503,76 +994,8 @@ static tb_pointer_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
                 // check
                 tb_assert_and_check_continue(job && job->task.done);
 
-                // the job state
-                tb_size_t state = tb_atomic_fetch_and_pset(&job->state, TB_STATE_WAITING, TB_STATE_WORKING);
-                
-                // the job is waiting? work it
-                if (state == TB_STATE_WAITING)
-                {
-                    // trace
-                    tb_trace_d("worker[%lu]: done: task[%p:%s]: ..", worker->id, job->task.done, job->task.name);
-
-                    // init the time
-                    tb_hong_t time = tb_cache_time_spak();
-
-                    // done the job
-                    job->task.done((tb_thread_pool_worker_ref_t)worker, job->task.priv);
-
-                    // computate the time
-                    time = tb_cache_time_spak() - time;
-
-                    // exists? update time and count
-                    tb_size_t               itor;
-                    tb_hash_map_item_ref_t  item = tb_null;
-                    if (    ((itor = tb_hash_map_find(worker->stats, job->task.done)) != tb_iterator_tail(worker->stats))
-                        &&  (item = (tb_hash_map_item_ref_t)tb_iterator_item(worker->stats, itor)))
-                    {
-                        // the stats
-                        tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)item->data;
-                        tb_assert_and_check_break(stats);
-
-                        // update the done count
-                        stats->done_count++;
-
-                        // update the total time 
-                        stats->total_time += time;
-                    }
-                    
-                    // no item? add it
-                    if (!item) 
-                    {
-                        // init stats
-                        tb_thread_pool_job_stats_t stats = {0};
-                        stats.done_count = 1;
-                        stats.total_time = time;
-
-                        // add stats
-                        tb_hash_map_insert(worker->stats, job->task.done, &stats);
-                    }
-
-#ifdef TB_TRACE_DEBUG
-                    tb_size_t done_count = 0;
-                    tb_hize_t total_time = 0;
-                    tb_thread_pool_job_stats_t* stats = (tb_thread_pool_job_stats_t*)tb_hash_map_get(worker->stats, job->task.done);
-                    if (stats)
-                    {
-                        done_count = stats->done_count;
-                        total_time = stats->total_time;
-                    }
-
-                    // trace
-                    tb_trace_d("worker[%lu]: done: task[%p:%s]: time: %lld ms, average: %lld ms, count: %lu", worker->id, job->task.done, job->task.name, time, (total_time / (tb_hize_t)done_count), done_count);
-#endif
-
-                    // update the job state
-                    tb_atomic_set(&job->state, TB_STATE_FINISHED);
-                }
-                // the job is killing? work it
-                else if (state == TB_STATE_KILLING)
-                {
-                    // update the job state
-                    tb_atomic_set(&job->state, TB_STATE_KILLED);
-                }
+                // done it
+                tb_thread_pool_worker_done(worker, job);
             }
 
             // clear jobs
@@ -607,7 +1030,7 @@ static tb_pointer_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
         }
 
         // exit stats
-        if (worker->stats) tb_hash_map_exit(worker->stats);
+        if (worker->stats) tb_flat_hash_map_exit(worker->stats);
         worker->stats = tb_null;
 
         // exit jobs
@@ -620,6 +1043,42 @@ static tb_pointer_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
     return tb_null;
 }
 
+static tb_void_t tb_thread_pool_worker_spawn(tb_thread_pool_impl_t* impl, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // init workers
+    tb_size_t i = (tb_size_t)impl->worker_size;
+    tb_size_t n = tb_min(size, impl->worker_maxn);
+    for (; i < n; i++)
+    {
+        // the worker 
+        tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+
+        // clear worker
+        tb_memset(worker, 0, sizeof(tb_thread_pool_worker_t));
+
+        // init worker
+        worker->id          = i;
+        worker->pool        = (tb_thread_pool_ref_t)impl;
+
+        // init the local jobs for the work-stealing mode
+        if (impl->stealing)
+        {
+            worker->local.jobs = tb_nalloc0_type(TB_THREAD_POOL_JOBS_LOCAL_MAXN, tb_thread_pool_job_t*);
+            tb_assert_and_check_break(worker->local.jobs);
+        }
+
+        // init loop
+        worker->loop        = tb_thread_init(__tb_lstring__("thread_pool"), tb_thread_pool_worker_loop, worker, impl->stack);
+        tb_assert_and_check_continue(worker->loop);
+    }
+
+    // update the worker size after the new workers have been inited
+    tb_atomic_set_explicit(&impl->worker_size, i, TB_ATOMIC_RELEASE);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * jobs implementation
  */
@@ -633,7 +1092,7 @@ static tb_bool_t tb_thread_pool_jobs_walk_kill_all(tb_pointer_t item, tb_cpointe
     tb_trace_d("task[%p:%s]: kill: ..", job->task.done, job->task.name);
 
     // kill it if be waiting
-    tb_atomic_pset(&job->state, TB_STATE_WAITING, TB_STATE_KILLING);
+    tb_atomic_pset_explicit(&job->state, TB_STATE_WAITING, TB_STATE_KILLING, TB_ATOMIC_RELAXED);
 
     // ok
     return tb_true;
@@ -662,6 +1121,138 @@ static tb_bool_t tb_thread_pool_jobs_walk_dump_all(tb_pointer_t item, tb_cpointe
     return tb_true;
 }
 #endif
+static tb_thread_pool_job_t* tb_thread_pool_jobs_make(tb_thread_pool_impl_t* impl, tb_thread_pool_task_t const* task)
+{
+    // check
+    tb_assert_and_check_return_val(impl && task, tb_null);
+
+    /* make job
+     *
+     * the jobs pool need be locked, so we make job from the allocator directly for the work-stealing mode
+     */
+    tb_thread_pool_job_t* job = tb_null;
+    if (impl->stealing) 
+    {
+        job = tb_malloc0_type(tb_thread_pool_job_t);
+        if (job) 
+        {
+            tb_atomic_fetch_and_inc_explicit(&impl->jobs_count, TB_ATOMIC_RELAXED);
+            job->killn = (tb_size_t)tb_atomic_get_explicit(&impl->jobs_killn, TB_ATOMIC_RELAXED);
+        }
+    }
+    else job = (tb_thread_pool_job_t*)tb_fixed_pool_malloc0(impl->jobs_pool);
+    tb_assert_and_check_return_val(job, tb_null);
+
+    // init job
+    job->refn   = 1;
+    job->state  = TB_STATE_WAITING;
+    job->task   = *task;
+
+    // ok
+    return job;
+}
+static tb_void_t tb_thread_pool_jobs_free(tb_thread_pool_impl_t* impl, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert_and_check_return(impl && job);
+
+    // free it
+    if (impl->stealing)
+    {
+        tb_free(job);
+        tb_atomic_fetch_and_dec_explicit(&impl->jobs_count, TB_ATOMIC_RELEASE);
+    }
+    else tb_fixed_pool_free(impl->jobs_pool, job);
+}
+static tb_size_t tb_thread_pool_jobs_size(tb_thread_pool_impl_t* impl)
+{
+    /* check
+     *
+     * @note all callers have checked it, and gcc will make a null impl path for the inlined spinlock leaving 
+     * after the returned check and warn the atomic exchange of &impl->lock with -Wstringop-overflow in release mode
+     */
+    tb_assert(impl);
+
+    // the jobs count
+    if (impl->stealing) return (tb_size_t)tb_atomic_get_explicit(&impl->jobs_count, TB_ATOMIC_ACQUIRE);
+    return impl->jobs_pool? tb_fixed_pool_size(impl->jobs_pool) : 0;
+}
+static tb_void_t tb_thread_pool_jobs_kill_all(tb_thread_pool_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // work-stealing mode?
+    if (impl->stealing)
+    {
+        // kill all jobs in the shared jobs
+        tb_for_all_if (tb_thread_pool_job_t*, job_urgent, tb_list_entry_itor(&impl->jobs_urgent), job_urgent)
+            tb_thread_pool_jobs_walk_kill_all(job_urgent, tb_null);
+        tb_for_all_if (tb_thread_pool_job_t*, job_waiting, tb_list_entry_itor(&impl->jobs_waiting), job_waiting)
+            tb_thread_pool_jobs_walk_kill_all(job_waiting, tb_null);
+
+        /* kill all jobs in the local jobs of workers
+         *
+         * we cannot walk them safely, so we update the kill generation and the workers will kill them when popping them
+         */
+        tb_atomic_fetch_and_inc_explicit(&impl->jobs_killn, TB_ATOMIC_RELAXED);
+    }
+    // kill all jobs in the jobs pool
+    else if (impl->jobs_pool) tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
+}
+static tb_thread_pool_job_t* tb_thread_pool_jobs_post_local(tb_thread_pool_impl_t* impl, tb_thread_pool_task_t const* task, tb_size_t refn)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->stealing && task && task->done, tb_null);
+
+    // stoped?
+    tb_check_return_val(!impl->bstoped, tb_null);
+
+    // the current worker
+    tb_thread_pool_worker_scope_t*  scope = (tb_thread_pool_worker_scope_t*)tb_thread_store_getp_type(TB_THREAD_STORE_DATA_TYPE_THREAD_POOL);
+    tb_thread_pool_worker_t*        worker = scope? scope->worker : tb_null;
+
+    // not in the worker thread of this pool? 
+    tb_check_return_val(worker && worker->pool == (tb_thread_pool_ref_t)impl && worker->local.jobs, tb_null);
+
+    // full?
+    tb_check_return_val(worker->local.bottom - tb_atomic_get(&worker->local.top) < TB_THREAD_POOL_JOBS_LOCAL_MAXN, tb_null);
+
+    // make job
+    tb_thread_pool_job_t* job = tb_thread_pool_jobs_make(impl, task);
+    tb_assert_and_check_return_val(job, tb_null);
+
+    // init the reference count
+    job->refn = refn;
+
+    // push it to the local jobs
+    if (!tb_thread_pool_worker_local_push(&worker->local, job))
+    {
+        tb_thread_pool_jobs_free(impl, job);
+        return tb_null;
+    }
+
+    // trace
+    tb_trace_d("task[%p:%s]: post: local: worker[%lu]", task->done, task->name, worker->id);
+
+    // wake up one idle worker to steal it
+    if (tb_atomic_get(&impl->worker_idle)) tb_thread_pool_worker_post(impl, 1);
+    // no idle workers? init one more worker for stealing the local jobs
+    else if ((tb_size_t)tb_atomic_get_explicit(&impl->worker_size, TB_ATOMIC_ACQUIRE) < impl->worker_maxn && worker->local.bottom - tb_atomic_get(&worker->local.top) > 1)
+    {
+        // enter
+        tb_spinlock_enter(&impl->lock);
+
+        // init one more worker
+        if (!impl->bstoped) tb_thread_pool_worker_spawn(impl, (tb_size_t)impl->worker_size + 1);
+
+        // leave
+        tb_spinlock_leave(&impl->lock);
+    }
+
+    // ok
+    return job;
+}
 static tb_thread_pool_job_t* tb_thread_pool_jobs_post_task(tb_thread_pool_impl_t* impl, tb_thread_pool_task_t const* task, tb_size_t* post_size)
 {
     // check
@@ -676,14 +1267,9 @@ static tb_thread_pool_job_t* tb_thread_pool_jobs_post_task(tb_thread_pool_impl_t
         tb_assert_and_check_break(tb_list_entry_size(&impl->jobs_waiting) + tb_list_entry_size(&impl->jobs_urgent) + 1 < TB_THREAD_POOL_JOBS_WAITING_MAXN);
 
         // make job
-        job = (tb_thread_pool_job_t*)tb_fixed_pool_malloc0(impl->jobs_pool);
+        job = tb_thread_pool_jobs_make(impl, task);
         tb_assert_and_check_break(job);
 
-        // init job
-        job->refn   = 1;
-        job->state  = TB_STATE_WAITING;
-        job->task   = *task;
-
         // non-urgent job? 
         if (!task->urgent)
         {
@@ -701,34 +1287,13 @@ static tb_thread_pool_job_t* tb_thread_pool_jobs_post_task(tb_thread_pool_impl_t
         tb_assert_and_check_break(jobs_waiting_count);
 
         // update the post size
-        if (*post_size < impl->worker_size) (*post_size)++;
+        if (*post_size < (tb_size_t)impl->worker_size) (*post_size)++;
 
         // trace
         tb_trace_d("task[%p:%s]: post: %lu: ..", task->done, task->name, *post_size);
 
         // init them if the workers have been not inited
-        if (impl->worker_size < jobs_waiting_count)
-        {
-            tb_size_t i = impl->worker_size;
-            tb_size_t n = tb_min(jobs_waiting_count, impl->worker_maxn);
-            for (; i < n; i++)
-            {
-                // the worker 
-                tb_thread_pool_worker_t* worker = &impl->worker_list[i];
-
-                // clear worker
-                tb_memset(worker, 0, sizeof(tb_thread_pool_worker_t));
-
-                // init worker
-                worker->id          = i;
-                worker->pool        = (tb_thread_pool_ref_t)impl;
-                worker->loop        = tb_thread_init(__tb_lstring__("thread_pool"), tb_thread_pool_worker_loop, worker, impl->stack);
-                tb_assert_and_check_continue(worker->loop);
-            }
-
-            // update the worker size
-            impl->worker_size = i;
-        }
+        if ((tb_size_t)impl->worker_size < jobs_waiting_count) tb_thread_pool_worker_spawn(impl, jobs_waiting_count);
 
         // ok
         ok = tb_true;
@@ -739,7 +1304,7 @@ static tb_thread_pool_job_t* tb_thread_pool_jobs_post_task(tb_thread_pool_impl_t
     if (!ok)
     {
         // exit it
-        tb_fixed_pool_free(impl->jobs_pool, job);
+        if (job) tb_thread_pool_jobs_free(impl, job);
         job = tb_null;
     }
 
@@ -748,13 +1313,9 @@ static tb_thread_pool_job_t* tb_thread_pool_jobs_post_task(tb_thread_pool_impl_t
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * private implementation
  */
-tb_thread_pool_ref_t tb_thread_pool()
-{
-    return (tb_thread_pool_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_THREAD_POOL, tb_thread_pool_instance_init, tb_thread_pool_instance_exit, tb_thread_pool_instance_kill, tb_null);
-}
-tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
+static tb_thread_pool_ref_t tb_thread_pool_init_impl(tb_size_t worker_maxn, tb_size_t stack, tb_bool_t stealing)
 {
     // done
     tb_bool_t               ok = tb_false;
@@ -770,18 +1331,25 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
 
         // computate the default worker maxn if be zero
         if (!worker_maxn) worker_maxn = tb_processor_count() << 2;
+        worker_maxn = tb_min(worker_maxn, TB_THREAD_POOL_WORKER_MAXN);
         tb_assert_and_check_break(worker_maxn);
 
         // init thread stack
         impl->stack         = stack;
 
+        // init mode
+        impl->stealing      = stealing;
+
         // init workers
         impl->worker_size   = 0;
         impl->worker_maxn   = worker_maxn;
 
-        // init jobs pool
-        impl->jobs_pool     = tb_fixed_pool_init(tb_null, TB_THREAD_POOL_JOBS_POOL_GROW, sizeof(tb_thread_pool_job_t), tb_null, tb_null, tb_null);
-        tb_assert_and_check_break(impl->jobs_pool);
+        // init jobs pool, the jobs will be made from the allocator directly for the work-stealing mode
+        if (!stealing)
+        {
+            impl->jobs_pool = tb_fixed_pool_init(tb_null, TB_THREAD_POOL_JOBS_POOL_GROW, sizeof(tb_thread_pool_job_t), tb_null, tb_null, tb_null);
+            tb_assert_and_check_break(impl->jobs_pool);
+        }
 
         // init jobs urgent
         tb_list_entry_init(&impl->jobs_urgent, tb_thread_pool_job_t, entry, tb_null);
@@ -817,6 +1385,24 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
     // ok?
     return (tb_thread_pool_ref_t)impl;
 }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_thread_pool_ref_t tb_thread_pool()
+{
+    return (tb_thread_pool_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_THREAD_POOL, tb_thread_pool_instance_init, tb_thread_pool_instance_exit, tb_thread_pool_instance_kill, tb_null);
+}
+tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
+{
+    // init it with the shared jobs mode
+    return tb_thread_pool_init_impl(worker_maxn, stack, tb_false);
+}
+tb_thread_pool_ref_t tb_thread_pool_init_stealing(tb_size_t worker_maxn, tb_size_t stack)
+{
+    // init it with the work-stealing mode
+    return tb_thread_pool_init_impl(worker_maxn, stack, tb_true);
+}
 tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
 {
     // check
@@ -862,6 +1448,10 @@ tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
             tb_thread_exit(worker->loop);
             worker->loop = tb_null;
         }
+
+        // exit the local jobs
+        if (worker->local.jobs) tb_free((tb_pointer_t)worker->local.jobs);
+        worker->local.jobs = tb_null;
     }
     impl->worker_size = 0;
 
@@ -925,7 +1515,7 @@ tb_void_t tb_thread_pool_kill(tb_thread_pool_ref_t pool)
         for (i = 0; i < n; i++) tb_atomic_set(&impl->worker_list[i].bstoped, 1);
 
         // kill all jobs
-        if (impl->jobs_pool) tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
+        tb_thread_pool_jobs_kill_all(impl);
 
         // post it
         post = impl->worker_size;
@@ -984,7 +1574,7 @@ tb_size_t tb_thread_pool_task_size(tb_thread_pool_ref_t pool)
     tb_spinlock_enter(&impl->lock);
 
     // the task size
-    tb_size_t task_size = impl->jobs_pool? tb_fixed_pool_size(impl->jobs_pool) : 0;
+    tb_size_t task_size = tb_thread_pool_jobs_size(impl);
 
     // leave
     tb_spinlock_leave(&impl->lock);
@@ -998,6 +1588,17 @@ tb_bool_t tb_thread_pool_task_post(tb_thread_pool_ref_t pool, tb_char_t const* n
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_false);
 
+    // init task
+    tb_thread_pool_task_t task = {0};
+    task.name       = name;
+    task.done       = done;
+    task.exit       = exit;
+    task.priv       = priv;
+    task.urgent     = urgent;
+
+    // post it to the local jobs of the current worker if be work-stealing mode
+    if (impl->stealing && tb_thread_pool_jobs_post_local(impl, &task, 1)) return tb_true;
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1011,14 +1612,6 @@ tb_bool_t tb_thread_pool_task_post(tb_thread_pool_ref_t pool, tb_char_t const* n
         // stoped?
         tb_check_break(!impl->bstoped);
 
-        // init task
-        tb_thread_pool_task_t task = {0};
-        task.name       = name;
-        task.done       = done;
-        task.exit       = exit;
-        task.priv       = priv;
-        task.urgent     = urgent;
-
         // post task
         tb_thread_pool_job_t* job = tb_thread_pool_jobs_post_task(impl, &task, &post_size);
         tb_assert_and_check_break(job);
@@ -1043,6 +1636,14 @@ tb_size_t tb_thread_pool_task_post_list(tb_thread_pool_ref_t pool, tb_thread_poo
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && list, 0);
 
+    // post them to the local jobs of the current worker if be work-stealing mode
+    tb_size_t ok = 0;
+    if (impl->stealing)
+    {
+        while (ok < size && tb_thread_pool_jobs_post_local(impl, &list[ok], 1)) ok++;
+        tb_check_return_val(ok < size, ok);
+    }
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1050,10 +1651,9 @@ tb_size_t tb_thread_pool_task_post_list(tb_thread_pool_ref_t pool, tb_thread_poo
     tb_spinlock_enter(&impl->lock);
 
     // done
-    tb_size_t ok = 0;
     if (!impl->bstoped)
     {
-        for (ok = 0; ok < size; ok++)
+        for (; ok < size; ok++)
         {
             // post task
             tb_thread_pool_job_t* job = tb_thread_pool_jobs_post_task(impl, &list[ok], &post_size);
@@ -1076,6 +1676,19 @@ tb_thread_pool_task_ref_t tb_thread_pool_task_init(tb_thread_pool_ref_t pool, tb
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_null);
 
+    // init task
+    tb_thread_pool_task_t task = {0};
+    task.name       = name;
+    task.done       = done;
+    task.exit       = exit;
+    task.priv       = priv;
+    task.urgent     = urgent;
+
+    // post it to the local jobs of the current worker if be work-stealing mode
+    tb_thread_pool_job_t* job = tb_null;
+    if (impl->stealing && (job = tb_thread_pool_jobs_post_local(impl, &task, 2))) 
+        return (tb_thread_pool_task_ref_t)job;
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1083,21 +1696,12 @@ tb_thread_pool_task_ref_t tb_thread_pool_task_init(tb_thread_pool_ref_t pool, tb
     tb_spinlock_enter(&impl->lock);
 
     // done
-    tb_bool_t               ok = tb_false;
-    tb_thread_pool_job_t*   job = tb_null;
+    tb_bool_t ok = tb_false;
     do
     {
         // stoped?
         tb_check_break(!impl->bstoped);
 
-        // init task
-        tb_thread_pool_task_t task = {0};
-        task.name       = name;
-        task.done       = done;
-        task.exit       = exit;
-        task.priv       = priv;
-        task.urgent     = urgent;
-
         // post task
         job = tb_thread_pool_jobs_post_task(impl, &task, &post_size);
         tb_assert_and_check_break(job);
@@ -1131,7 +1735,7 @@ tb_void_t tb_thread_pool_task_kill(tb_thread_pool_ref_t pool, tb_thread_pool_tas
     tb_trace_d("task[%p:%s]: kill: state: %s: ..", job->task.done, job->task.name, tb_state_cstr(tb_atomic_get(&job->state)));
 
     // kill it if be waiting
-    tb_atomic_pset(&job->state, TB_STATE_WAITING, TB_STATE_KILLING);
+    tb_atomic_pset_explicit(&job->state, TB_STATE_WAITING, TB_STATE_KILLING, TB_ATOMIC_RELAXED);
 }
 tb_void_t tb_thread_pool_task_kill_all(tb_thread_pool_ref_t pool)
 {
@@ -1143,8 +1747,7 @@ tb_void_t tb_thread_pool_task_kill_all(tb_thread_pool_ref_t pool)
     tb_spinlock_enter(&impl->lock);
 
     // kill all jobs
-    if (!impl->bstoped && impl->jobs_pool) 
-        tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
+    if (!impl->bstoped) tb_thread_pool_jobs_kill_all(impl);
 
     // leave
     tb_spinlock_leave(&impl->lock);
@@ -1158,7 +1761,7 @@ tb_long_t tb_thread_pool_task_wait(tb_thread_pool_ref_t pool, tb_thread_pool_tas
     // wait it
     tb_hong_t time = tb_cache_time_spak();
     tb_size_t state = TB_STATE_WAITING;
-    while ( ((state = tb_atomic_get(&job->state)) != TB_STATE_FINISHED) 
+    while ( ((state = tb_atomic_get_explicit(&job->state, TB_ATOMIC_ACQUIRE)) != TB_STATE_FINISHED) 
         &&  state != TB_STATE_KILLED
         &&  (timeout < 0 || tb_cache_time_spak() < time + timeout))
     {
@@ -1187,7 +1790,7 @@ tb_long_t tb_thread_pool_task_wait_all(tb_thread_pool_ref_t pool, tb_long_t time
         tb_spinlock_enter(&impl->lock);
 
         // the jobs count
-        size = impl->jobs_pool? tb_fixed_pool_size(impl->jobs_pool) : 0;
+        size = tb_thread_pool_jobs_size(impl);
 
         // trace
         tb_trace_d("wait: jobs: %lu, waiting: %lu, pending: %lu, urgent: %lu: .."
@@ -1226,6 +1829,14 @@ tb_void_t tb_thread_pool_task_exit(tb_thread_pool_ref_t pool, tb_thread_pool_tas
     // kill it first
     tb_thread_pool_task_kill(pool, task);
 
+    // work-stealing mode? the worker may release it at the same time
+    if (impl->stealing)
+    {
+        // refn--, remove it directly if no references
+        if (tb_atomic_fetch_and_dec_explicit(&job->refn, TB_ATOMIC_ACQ_REL) == 1) tb_thread_pool_jobs_free(impl, job);
+        return ;
+    }
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -1256,21 +1867,42 @@ tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
 
         // walk
         tb_size_t i = 0;
-        for (i = 0; i < impl->worker_size; i++)
+        for (i = 0; i < (tb_size_t)impl->worker_size; i++)
         {
             // the worker
             tb_thread_pool_worker_t* worker = &impl->worker_list[i];
             tb_assert_and_check_break(worker);
 
             // dump worker
-            tb_trace_i("    worker: id: %lu, stoped: %ld", worker->id, (tb_long_t)tb_atomic_get(&worker->bstoped));
+            if (impl->stealing)
+            {
+                tb_trace_i("    worker: id: %lu, stoped: %ld, local: %ld, done: local: %lu, steal: %lu"
+                    , worker->id
+                    , (tb_long_t)tb_atomic_get(&worker->bstoped)
+                    , (tb_long_t)(tb_atomic_get(&worker->local.bottom) - tb_atomic_get(&worker->local.top))
+                    , worker->done_local
+                    , worker->done_steal);
+            }
+            else tb_trace_i("    worker: id: %lu, stoped: %ld", worker->id, (tb_long_t)tb_atomic_get(&worker->bstoped));
         }
 
         // trace
         tb_trace_i("");
 
+        // dump the shared jobs for the work-stealing mode, the local jobs cannot be walked safely
+        if (impl->stealing)
+        {
+            // trace
+            tb_trace_i("jobs: size: %lu, urgent: %lu, waiting: %lu", tb_thread_pool_jobs_size(impl), tb_list_entry_size(&impl->jobs_urgent), tb_list_entry_size(&impl->jobs_waiting));
+
+            // dump jobs
+            tb_for_all_if (tb_thread_pool_job_t*, job_urgent, tb_list_entry_itor(&impl->jobs_urgent), job_urgent)
+                tb_thread_pool_jobs_walk_dump_all(job_urgent, tb_null);
+            tb_for_all_if (tb_thread_pool_job_t*, job_waiting, tb_list_entry_itor(&impl->jobs_waiting), job_waiting)
+                tb_thread_pool_jobs_walk_dump_all(job_waiting, tb_null);
+        }
         // dump all jobs
-        if (impl->jobs_pool) 
+        else if (impl->jobs_pool) 
         {
             // trace
             tb_trace_i("jobs: size: %lu", tb_fixed_pool_size(impl->jobs_pool));
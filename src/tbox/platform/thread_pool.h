@@ -106,6 +106,20 @@ tb_thread_pool_ref_t        tb_thread_pool(tb_noarg_t);
  */
 tb_thread_pool_ref_t        tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack);
 
+/*! init thread pool with the work-stealing mode
+ *
+ * each worker owns a lock-free jobs deque, the tasks posted from the worker thread
+ * will be pushed to its local deque and the idle workers will steal jobs from others.
+ *
+ * the tasks posted from the other threads still go through the shared jobs lists.
+ *
+ * @param worker_maxn       the thread worker max count, using the default count
+ * @param stack             the thread stack, using the default stack size if be zero
+ *
+ * @return                  the thread pool
+ */
+tb_thread_pool_ref_t        tb_thread_pool_init_stealing(tb_size_t worker_maxn, tb_size_t stack);
+
 /*! exit thread pool
  *
  * @param pool              the thread pool 
@@ -37,6 +37,37 @@
 #include "spinlock.h"
 #include "../container/container.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_size_t tb_thread_store_slot(tb_size_t type)
+{
+    // the internal type? 
+    if (type == TB_THREAD_STORE_DATA_TYPE_EXCEPTION || (type > TB_THREAD_STORE_DATA_TYPE_USER && type < TB_THREAD_STORE_DATA_TYPE_MAXN)) return type;
+
+    // the other types are all stored in the user slot
+    return TB_THREAD_STORE_DATA_TYPE_USER;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef TB_THREAD_STORE_HAVE_NATIVE
+#   include "posix/thread_store.c"
+#else
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the thread store slots type
+typedef struct __tb_thread_store_slots_t
+{
+    // the data for each type
+    tb_thread_store_data_ref_t      data[TB_THREAD_STORE_DATA_TYPE_MAXN];
+
+}tb_thread_store_slots_t, *tb_thread_store_slots_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
@@ -52,14 +83,18 @@ static tb_spinlock_t            g_lock = TB_SPINLOCK_INIT;
  */
 static tb_void_t tb_thread_store_free(tb_element_ref_t element, tb_pointer_t buff)
 {
-    // data item
-    tb_thread_store_data_ref_t data = buff? *((tb_thread_store_data_ref_t*)buff) : tb_null;
+    // the slots
+    tb_thread_store_slots_ref_t slots = (tb_thread_store_slots_ref_t)buff;
+    tb_check_return(slots);
 
     // free data
-    if (data && data->free) data->free(data); 
-
-    // clear it
-    if (buff) *((tb_thread_store_data_ref_t*)buff) = tb_null;
+    tb_size_t i = 0;
+    for (i = 0; i < TB_THREAD_STORE_DATA_TYPE_MAXN; i++)
+    {
+        tb_thread_store_data_ref_t data = slots->data[i];
+        if (data && data->free) data->free(data); 
+        slots->data[i] = tb_null;
+    }
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -74,7 +109,7 @@ tb_bool_t tb_thread_store_init()
     if (!g_store) 
     {
         // init store
-        g_store = tb_hash_map_init(8, tb_element_size(), tb_element_ptr(tb_thread_store_free, tb_null));
+        g_store = tb_hash_map_init(8, tb_element_size(), tb_element_mem(sizeof(tb_thread_store_slots_t), tb_thread_store_free, tb_null));
     }
 
     // leave lock
@@ -102,30 +137,72 @@ tb_void_t tb_thread_store_exit()
 }
 tb_void_t tb_thread_store_setp(tb_thread_store_data_t const* data)
 {
+    // check
+    tb_assert_and_check_return(data);
+
+    // the slot
+    tb_size_t slot = tb_thread_store_slot(data->type);
+
+    // the old data
+    tb_thread_store_data_ref_t data_old = tb_null;
+
     // enter lock
     tb_spinlock_enter(&g_lock);
 
-    // get data
-    if (g_store) tb_hash_map_insert(g_store, (tb_pointer_t)tb_thread_self(), data);
+    // set data
+    if (g_store) 
+    {
+        // get slots
+        tb_thread_store_slots_ref_t slots = (tb_thread_store_slots_ref_t)tb_hash_map_get(g_store, (tb_pointer_t)tb_thread_self());
+        if (!slots)
+        {
+            // insert the empty slots
+            tb_thread_store_slots_t slots_empty = {{0}};
+            if (tb_hash_map_insert(g_store, (tb_pointer_t)tb_thread_self(), &slots_empty))
+                slots = (tb_thread_store_slots_ref_t)tb_hash_map_get(g_store, (tb_pointer_t)tb_thread_self());
+        }
+
+        // save data
+        if (slots)
+        {
+            data_old = slots->data[slot];
+            slots->data[slot] = (tb_thread_store_data_ref_t)data;
+        }
+    }
 
     // leave lock
     tb_spinlock_leave(&g_lock);
+
+    // free the old data
+    if (data_old && data_old != data && data_old->free) data_old->free(data_old);
 }
 tb_thread_store_data_ref_t tb_thread_store_getp()
 {
+    // get the user data
+    return tb_thread_store_getp_type(TB_THREAD_STORE_DATA_TYPE_USER);
+}
+tb_thread_store_data_ref_t tb_thread_store_getp_type(tb_size_t type)
+{
+    // the slot
+    tb_size_t slot = tb_thread_store_slot(type);
+
     // init data
-    tb_pointer_t data = tb_null;
+    tb_thread_store_data_ref_t data = tb_null;
 
     // enter lock
     tb_spinlock_enter(&g_lock);
 
     // get data
-    if (g_store) data = tb_hash_map_get(g_store, (tb_pointer_t)tb_thread_self());
+    if (g_store) 
+    {
+        tb_thread_store_slots_ref_t slots = (tb_thread_store_slots_ref_t)tb_hash_map_get(g_store, (tb_pointer_t)tb_thread_self());
+        if (slots) data = slots->data[slot];
+    }
 
     // leave lock
     tb_spinlock_leave(&g_lock);
 
     // ok?
-    return (tb_thread_store_data_ref_t)data;
+    return data;
 }
-
+#endif
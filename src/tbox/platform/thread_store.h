@@ -34,16 +34,36 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the thread store is backed by the native thread local storage?
+ *
+ * tb_thread_store_getp() will not enter any lock and the data will be freed when the thread exits
+ */
+#if !defined(TB_CONFIG_OS_WINDOWS) && defined(TB_CONFIG_POSIX_HAVE_PTHREAD_CREATE)
+#   define TB_THREAD_STORE_HAVE_NATIVE
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
-// the thread store data type enum
+/* the thread store data type enum
+ *
+ * the user type is kept stable and the new internal types are appended after it,
+ * the data of the other unknown types will be stored in the user slot.
+ */
 typedef enum __tb_thread_store_data_type_e
 {
     TB_THREAD_STORE_DATA_TYPE_NONE          = 0
 ,   TB_THREAD_STORE_DATA_TYPE_EXCEPTION     = 1
 ,   TB_THREAD_STORE_DATA_TYPE_USER          = 2
+,   TB_THREAD_STORE_DATA_TYPE_ALLOCATOR     = 3
+,   TB_THREAD_STORE_DATA_TYPE_OBJECT_ARENA  = 4
+,   TB_THREAD_STORE_DATA_TYPE_THREAD_POOL   = 5
+,   TB_THREAD_STORE_DATA_TYPE_MAXN          = 6
 
 }tb_thread_store_data_type_e;
 
@@ -72,17 +92,28 @@ tb_bool_t                   tb_thread_store_init(tb_noarg_t);
 tb_void_t                   tb_thread_store_exit(tb_noarg_t);
 
 /*! set thread store data
+ *
+ * the old data with the same type will be freed, 
+ * and the data of the unknown type will be stored in the user slot
  *
  * @param data              the thread store data
  */
 tb_void_t                   tb_thread_store_setp(tb_thread_store_data_t const* data);
 
-/*! get thread store data
+/*! get the user data of the thread store
  *
  * @return                  the thread store data
  */
 tb_thread_store_data_ref_t  tb_thread_store_getp(tb_noarg_t);
 
+/*! get thread store data of the given type
+ *
+ * @param type              the data type
+ *
+ * @return                  the thread store data
+ */
+tb_thread_store_data_ref_t  tb_thread_store_getp_type(tb_size_t type);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -34,9 +34,58 @@
 #include "platform.h"
 #include "../memory/memory.h"
 #include "../container/container.h"
-#include "../algorithm/algorithm.h"
 #include "../utils/utils.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the timer wheel
+ *
+ * level 0: 256 slots,  1ms    per slot, 256ms
+ * level 1: 64 slots,   256ms  per slot, 16.4s
+ * level 2: 64 slots,   16.4s  per slot, 17.5m
+ * level 3: 64 slots,   17.5m  per slot, 18.6h
+ * level 4: 64 slots,   18.6h  per slot, 49.7d
+ *
+ * the tasks of the upper level will be cascaded to the lower levels when the lower level is wrapped,
+ * and the tasks out of range will be put into the last slot and be cascaded repeatedly
+ */
+#define TB_TIMER_WHEEL_LEVEL_MAXN           (5)
+
+// the slot bits of the first level
+#define TB_TIMER_WHEEL_BITS_0               (8)
+
+// the slot bits of the other levels
+#define TB_TIMER_WHEEL_BITS_N               (6)
+
+// the slot count of the first level
+#define TB_TIMER_WHEEL_SLOT_0               (1 << TB_TIMER_WHEEL_BITS_0)
+
+// the slot count of the other levels
+#define TB_TIMER_WHEEL_SLOT_N               (1 << TB_TIMER_WHEEL_BITS_N)
+
+// the slot count of all levels
+#define TB_TIMER_WHEEL_SLOT_MAXN            (TB_TIMER_WHEEL_SLOT_0 + TB_TIMER_WHEEL_SLOT_N * (TB_TIMER_WHEEL_LEVEL_MAXN - 1))
+
+// the slot index of the ready list
+#define TB_TIMER_WHEEL_SLOT_READY           (TB_TIMER_WHEEL_SLOT_MAXN)
+
+// the slot index if the task is not in any list
+#define TB_TIMER_WHEEL_SLOT_NONE            (0xffff)
+
+// the time shift of the given level
+#define tb_timer_wheel_shift(level)         ((level)? TB_TIMER_WHEEL_BITS_0 + TB_TIMER_WHEEL_BITS_N * ((level) - 1) : 0)
+
+// the slot count of the given level
+#define tb_timer_wheel_count(level)         ((level)? TB_TIMER_WHEEL_SLOT_N : TB_TIMER_WHEEL_SLOT_0)
+
+// the first slot index of the given level
+#define tb_timer_wheel_offset(level)        ((level)? TB_TIMER_WHEEL_SLOT_0 + TB_TIMER_WHEEL_SLOT_N * ((level) - 1) : 0)
+
+// the time range of the given level
+#define tb_timer_wheel_range(level)         ((tb_hong_t)1 << (tb_timer_wheel_shift(level) + ((level)? TB_TIMER_WHEEL_BITS_N : TB_TIMER_WHEEL_BITS_0)))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -44,6 +93,9 @@
 // the timer task type
 typedef struct __tb_timer_task_impl_t
 {
+    // the list entry
+    tb_list_entry_t             entry;
+
     // the func
     tb_timer_task_func_t        func;
 
@@ -65,6 +117,9 @@ typedef struct __tb_timer_task_impl_t
     // the refn, <= 2
     tb_uint32_t                 refn    : 2;
 
+    // the slot index of the wheel, TB_TIMER_WHEEL_SLOT_READY: in the ready list
+    tb_uint16_t                 slot;
+
 }tb_timer_task_impl_t;
 
 /// the timer type
@@ -88,12 +143,24 @@ typedef struct __tb_timer_impl_t
     // the pool
     tb_fixed_pool_ref_t         pool;
 
-    // the heap
-    tb_heap_ref_t               heap;
-
     // the event
     tb_event_ref_t              event;
 
+    // the base time of the wheel, all slots before it have been expired
+    tb_hong_t                   base;
+
+    // the task count in the wheel
+    tb_size_t                   size;
+
+    // the bitmap of the non-empty slots
+    tb_uint32_t                 bits[TB_TIMER_WHEEL_SLOT_MAXN >> 5];
+
+    // the ready list of the expired tasks
+    tb_list_entry_head_t        ready;
+
+    // the slots of the wheel
+    tb_list_entry_head_t        slots[TB_TIMER_WHEEL_SLOT_MAXN];
+
 }tb_timer_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -112,20 +179,182 @@ static __tb_inline__ tb_hong_t tb_timer_now(tb_timer_t* timer)
     // using cached time
     return tb_cache_time_mclock();
 }
-static tb_long_t tb_timer_comp_by_when(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+static __tb_inline__ tb_list_entry_head_ref_t tb_timer_wheel_list(tb_timer_t* timer, tb_size_t slot)
+{
+    return slot == TB_TIMER_WHEEL_SLOT_READY? &timer->ready : &timer->slots[slot];
+}
+static tb_void_t tb_timer_wheel_insert(tb_timer_t* timer, tb_timer_task_impl_t* task_impl)
+{
+    // the delta time, the expired task will be put into the current slot of the first level
+    tb_hong_t when  = task_impl->when;
+    tb_hong_t delta = when > timer->base? when - timer->base : 0;
+    if (!delta) when = timer->base;
+
+    // find the level
+    tb_size_t level = 0;
+    while (level < TB_TIMER_WHEEL_LEVEL_MAXN - 1 && delta >= tb_timer_wheel_range(level)) level++;
+
+    // out of range? put it into the last slot and it will be cascaded repeatedly
+    if (delta >= tb_timer_wheel_range(level)) when = timer->base + tb_timer_wheel_range(level) - 1;
+
+    // the slot index
+    tb_size_t slot = tb_timer_wheel_offset(level) + (tb_size_t)((when >> tb_timer_wheel_shift(level)) & (tb_timer_wheel_count(level) - 1));
+    tb_assert(slot < TB_TIMER_WHEEL_SLOT_MAXN);
+
+    // insert it
+    tb_list_entry_insert_tail(&timer->slots[slot], &task_impl->entry);
+    task_impl->slot = (tb_uint16_t)slot;
+    timer->bits[slot >> 5] |= (1 << (slot & 31));
+    timer->size++;
+}
+static tb_void_t tb_timer_wheel_remove(tb_timer_t* timer, tb_timer_task_impl_t* task_impl)
 {
     // check
-    tb_timer_task_impl_t const* ltask = (tb_timer_task_impl_t const*)ldata;
-    tb_timer_task_impl_t const* rtask = (tb_timer_task_impl_t const*)rdata;
-    tb_assert_and_check_return_val(ltask && rtask, -1);
+    tb_assert(task_impl->slot != TB_TIMER_WHEEL_SLOT_NONE);
+
+    // remove it
+    tb_size_t                   slot = task_impl->slot;
+    tb_list_entry_head_ref_t    list = tb_timer_wheel_list(timer, slot);
+    tb_list_entry_remove(list, &task_impl->entry);
+    task_impl->slot = TB_TIMER_WHEEL_SLOT_NONE;
+
+    // update the bitmap and size if it is in the wheel
+    if (slot != TB_TIMER_WHEEL_SLOT_READY)
+    {
+        if (!tb_list_entry_size(list)) timer->bits[slot >> 5] &= ~(1 << (slot & 31));
+        timer->size--;
+    }
+}
+static __tb_inline__ tb_timer_task_impl_t* tb_timer_wheel_head(tb_list_entry_head_ref_t list)
+{
+    return tb_list_entry_size(list)? (tb_timer_task_impl_t*)tb_list_entry(list, tb_list_entry_head(list)) : tb_null;
+}
+static tb_void_t tb_timer_wheel_ready(tb_timer_t* timer, tb_timer_task_impl_t* task_impl)
+{
+    // move it to the ready list
+    tb_list_entry_insert_tail(&timer->ready, &task_impl->entry);
+    task_impl->slot = TB_TIMER_WHEEL_SLOT_READY;
+}
+static tb_long_t tb_timer_wheel_find(tb_uint32_t const* bits, tb_size_t count, tb_size_t start)
+{
+    // the word count
+    tb_size_t n = count >> 5;
+    tb_assert(n && !(n & (n - 1)));
+
+    // find it from the start word, skip the bits before the start slot
+    tb_size_t   i = start >> 5;
+    tb_uint32_t word = bits[i] & ((tb_uint32_t)~0 << (start & 31));
+    tb_size_t   k = 0;
+    while (!word && k < n)
+    {
+        // the next word
+        i = (i + 1) & (n - 1);
+        word = bits[i];
+
+        // wrap to the start word? only find the bits before the start slot
+        if (++k == n) word &= (start & 31)? (((tb_uint32_t)1 << (start & 31)) - 1) : 0;
+    }
+
+    // the distance from the start slot
+    return word? (tb_long_t)((((i << 5) + tb_bits_fb1_u32_le(word)) - start) & (count - 1)) : -1;
+}
+static tb_hong_t tb_timer_wheel_next(tb_timer_t* timer)
+{
+    /* get the lower bound of the next expired time
+     *
+     * it is exact for the first level,
+     * and it is the cascading time of the first non-empty slot for the other levels
+     */
+    tb_size_t level = 0;
+    tb_hong_t next = -1;
+    for (level = 0; level < TB_TIMER_WHEEL_LEVEL_MAXN; level++)
+    {
+        // the current slot of this level
+        tb_size_t   shift = tb_timer_wheel_shift(level);
+        tb_size_t   count = tb_timer_wheel_count(level);
+        tb_hize_t   block = (tb_hize_t)timer->base >> shift;
+        tb_size_t   index = (tb_size_t)(block & (count - 1));
+
+        /* find the first non-empty slot 
+         *
+         * the current slot of the upper levels has been cascaded if the base time is not at the start of this slot, 
+         * so the tasks in it will be cascaded at the next cycle
+         */
+        tb_size_t skip = (level && (timer->base & (((tb_hong_t)1 << shift) - 1)))? 1 : 0;
+        tb_long_t distance = tb_timer_wheel_find(timer->bits + (tb_timer_wheel_offset(level) >> 5), count, (index + skip) & (count - 1));
+        tb_check_continue(distance >= 0);
+
+        // the time
+        tb_hong_t time = level? (tb_hong_t)((block + distance + skip) << shift) : timer->base + distance;
+        if (next < 0 || time < next) next = time;
+    }
+    return next;
+}
+static tb_void_t tb_timer_wheel_cascade(tb_timer_t* timer, tb_size_t slot)
+{
+    // re-insert the tasks of this slot to the lower levels
+    tb_list_entry_head_ref_t    list = &timer->slots[slot];
+    tb_timer_task_impl_t*       task_impl = tb_null;
+    while ((task_impl = tb_timer_wheel_head(list)))
+    {
+        tb_timer_wheel_remove(timer, task_impl);
+        tb_timer_wheel_insert(timer, task_impl);
+    }
+}
+static tb_void_t tb_timer_wheel_spak(tb_timer_t* timer, tb_hong_t now)
+{
+    // empty? skip to the current time directly
+    if (!timer->size)
+    {
+        if (timer->base <= now) timer->base = now + 1;
+        return ;
+    }
+
+    // expire the slots until now
+    while (timer->base <= now)
+    {
+        // skip the empty slots
+        tb_hong_t next = tb_timer_wheel_next(timer);
+        if (next < 0 || next > timer->base)
+        {
+            timer->base = (next < 0 || next > now)? now + 1 : next;
+            continue;
+        }
 
-    // comp
-    return (ltask->when > rtask->when? 1 : (ltask->when < rtask->when? -1 : 0));
+        // cascade the upper levels if the lower levels are wrapped
+        tb_size_t level = 1;
+        tb_size_t index = (tb_size_t)(timer->base & (TB_TIMER_WHEEL_SLOT_0 - 1));
+        for (level = 1; !index && level < TB_TIMER_WHEEL_LEVEL_MAXN; level++)
+        {
+            index = (tb_size_t)((timer->base >> tb_timer_wheel_shift(level)) & (TB_TIMER_WHEEL_SLOT_N - 1));
+            tb_timer_wheel_cascade(timer, tb_timer_wheel_offset(level) + index);
+        }
+
+        // move the expired tasks of the current slot to the ready list
+        tb_list_entry_head_ref_t    list = &timer->slots[timer->base & (TB_TIMER_WHEEL_SLOT_0 - 1)];
+        tb_timer_task_impl_t*       task_impl = tb_null;
+        while ((task_impl = tb_timer_wheel_head(list)))
+        {
+            tb_timer_wheel_remove(timer, task_impl);
+            tb_timer_wheel_ready(timer, task_impl);
+        }
+
+        // next slot
+        timer->base++;
+    }
 }
-static tb_bool_t tb_timer_pred_by_task(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+static tb_void_t tb_timer_wheel_clear(tb_timer_t* timer)
 {
-    // is equal?
-    return item == value;
+    // clear slots
+    tb_size_t i = 0;
+    for (i = 0; i < TB_TIMER_WHEEL_SLOT_MAXN; i++) tb_list_entry_clear(&timer->slots[i]);
+    tb_memset(timer->bits, 0, sizeof(timer->bits));
+
+    // clear the ready list
+    tb_list_entry_clear(&timer->ready);
+
+    // clear size
+    timer->size = 0;
 }
 static tb_pointer_t tb_timer_instance_loop(tb_cpointer_t priv)
 {
@@ -222,12 +451,10 @@ tb_timer_ref_t tb_timer_init(tb_size_t maxn, tb_bool_t ctime)
         timer = tb_malloc0_type(tb_timer_t);
         tb_assert_and_check_break(timer);
 
-        // init element
-        tb_element_t element = tb_element_ptr(tb_null, tb_null); element.comp = tb_timer_comp_by_when;
-
         // init timer
         timer->maxn         = tb_max(maxn, 16);
         timer->ctime        = ctime;
+        timer->base         = tb_timer_now(timer);
 
         // init lock
         if (!tb_spinlock_init(&timer->lock)) break;
@@ -236,9 +463,13 @@ tb_timer_ref_t tb_timer_init(tb_size_t maxn, tb_bool_t ctime)
         timer->pool         = tb_fixed_pool_init(tb_null, (maxn >> 4) + 16, sizeof(tb_timer_task_impl_t), tb_null, tb_null, tb_null);
         tb_assert_and_check_break(timer->pool);
         
-        // init heap
-        timer->heap         = tb_heap_init((maxn >> 2) + 16, element);
-        tb_assert_and_check_break(timer->heap);
+        // init slots
+        tb_size_t i = 0;
+        for (i = 0; i < TB_TIMER_WHEEL_SLOT_MAXN; i++) 
+            tb_list_entry_init(&timer->slots[i], tb_timer_task_impl_t, entry, tb_null);
+
+        // init the ready list
+        tb_list_entry_init(&timer->ready, tb_timer_task_impl_t, entry, tb_null);
 
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
@@ -282,9 +513,8 @@ tb_void_t tb_timer_exit(tb_timer_ref_t self)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // exit heap
-    if (timer->heap) tb_heap_exit(timer->heap);
-    timer->heap = tb_null;
+    // exit wheel
+    tb_timer_wheel_clear(timer);
 
     // exit pool
     if (timer->pool) tb_fixed_pool_exit(timer->pool);
@@ -329,8 +559,8 @@ tb_void_t tb_timer_clear(tb_timer_ref_t self)
         // enter
         tb_spinlock_enter(&timer->lock);
 
-        // clear heap
-        if (timer->heap) tb_heap_clear(timer->heap);
+        // clear wheel
+        tb_timer_wheel_clear(timer);
 
         // clear pool
         if (timer->pool) tb_fixed_pool_clear(timer->pool);
@@ -343,7 +573,7 @@ tb_hize_t tb_timer_top(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->heap, -1);
+    tb_assert_and_check_return_val(timer && timer->pool, -1);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_get(&timer->stop), -1);
@@ -351,13 +581,18 @@ tb_hize_t tb_timer_top(tb_timer_ref_t self)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // done
-    tb_hize_t when = -1; 
-    if (tb_heap_size(timer->heap))
+    /* the top when
+     *
+     * it is the lower bound of the next expired time if the top task is in the upper levels,
+     * so the loop may be waked up earlier and cascade it to the lower levels
+     */
+    tb_hize_t               when = -1; 
+    tb_timer_task_impl_t*   task_impl = tb_timer_wheel_head(&timer->ready);
+    if (task_impl) when = task_impl->when;
+    else 
     {
-        // the task
-        tb_timer_task_impl_t const* task_impl = (tb_timer_task_impl_t const*)tb_heap_top(timer->heap);
-        if (task_impl) when = task_impl->when;
+        tb_hong_t next = tb_timer_wheel_next(timer);
+        if (next >= 0) when = next;
     }
 
     // leave
@@ -370,7 +605,7 @@ tb_size_t tb_timer_delay(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->heap, -1);
+    tb_assert_and_check_return_val(timer && timer->pool, -1);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_get(&timer->stop), -1);
@@ -380,17 +615,18 @@ tb_size_t tb_timer_delay(tb_timer_ref_t self)
 
     // done
     tb_size_t delay = -1; 
-    if (tb_heap_size(timer->heap))
+    if (tb_list_entry_size(&timer->ready)) delay = 0;
+    else
     {
-        // the task
-        tb_timer_task_impl_t const* task_impl = (tb_timer_task_impl_t const*)tb_heap_top(timer->heap);
-        if (task_impl)
+        // the next expired time
+        tb_hong_t next = tb_timer_wheel_next(timer);
+        if (next >= 0)
         {
             // the now
             tb_hong_t now = tb_timer_now(timer);
 
             // the delay
-            delay = task_impl->when > now? (tb_size_t)(task_impl->when - now) : 0;
+            delay = next > now? (tb_size_t)(next - now) : 0;
         }
     }
 
@@ -404,43 +640,37 @@ tb_bool_t tb_timer_spak(tb_timer_ref_t self)
 {
     // check
     tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->heap, tb_false);
+    tb_assert_and_check_return_val(timer && timer->pool, tb_false);
 
     // stoped?
     tb_check_return_val(!tb_atomic_get(&timer->stop), tb_false);
 
-    // enter
+    // the now
+    tb_hong_t now = tb_timer_now(timer);
+
+    // move the expired tasks to the ready list
     tb_spinlock_enter(&timer->lock);
+    tb_timer_wheel_spak(timer, now);
+    tb_spinlock_leave(&timer->lock);
 
-    // done
-    tb_bool_t               ok = tb_false;
-    tb_timer_task_func_t    func = tb_null;
-    tb_cpointer_t           priv = tb_null;
-    tb_bool_t               killed = tb_false;
+    // done the ready tasks
+    tb_timer_task_impl_t* task_impl = tb_null;
     do
     {
-        // empty? 
-        if (!tb_heap_size(timer->heap))
-        {
-            ok = tb_true;
-            break;
-        }
-
-        // the top task
-        tb_timer_task_impl_t* task_impl = (tb_timer_task_impl_t*)tb_heap_top(timer->heap);
-        tb_assert_and_check_break(task_impl);
-
-        // check refn
-        tb_assert(task_impl->refn);
-
-        // the now
-        tb_hong_t now = tb_timer_now(timer);
+        // enter
+        tb_spinlock_enter(&timer->lock);
 
-        // timeout?
-        if (task_impl->when <= now)
+        // pop the ready task
+        tb_timer_task_func_t    func = tb_null;
+        tb_cpointer_t           priv = tb_null;
+        tb_bool_t               killed = tb_false;
+        if ((task_impl = tb_timer_wheel_head(&timer->ready)))
         {
-            // pop it
-            tb_heap_pop(timer->heap);
+            // check refn
+            tb_assert(task_impl->refn);
+
+            // remove it
+            tb_timer_wheel_remove(timer, task_impl);
 
             // save func and data for calling it later
             func = task_impl->func;
@@ -456,7 +686,7 @@ tb_bool_t tb_timer_spak(tb_timer_ref_t self)
                 task_impl->when = now + task_impl->period;
 
                 // continue task_impl
-                tb_heap_put(timer->heap, task_impl);
+                tb_timer_wheel_insert(timer, task_impl);
             }
             else 
             {
@@ -467,19 +697,16 @@ tb_bool_t tb_timer_spak(tb_timer_ref_t self)
             }
         }
 
-        // ok
-        ok = tb_true;
-
-    } while (0);
+        // leave
+        tb_spinlock_leave(&timer->lock);
 
-    // leave
-    tb_spinlock_leave(&timer->lock);
+        // done func
+        if (func) func(killed, priv);
 
-    // done func
-    if (func) func(killed, priv);
+    } while (task_impl);
 
-    // ok?
-    return ok;
+    // ok
+    return tb_true;
 }
 tb_void_t tb_timer_loop(tb_timer_ref_t self)
 {
@@ -522,20 +749,10 @@ tb_void_t tb_timer_loop(tb_timer_ref_t self)
     // work--
     tb_atomic_fetch_and_dec(&timer->work);
 }
-tb_timer_task_ref_t tb_timer_task_init(tb_timer_ref_t self, tb_size_t delay, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv)
-{
-    // check
-    tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && func, tb_null);
-
-    // add task_impl
-    return tb_timer_task_init_at(self, tb_timer_now(timer) + delay, delay, repeat, func, priv);
-}
-tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, tb_size_t period, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv)
+static tb_timer_task_impl_t* tb_timer_task_add(tb_timer_t* timer, tb_hize_t when, tb_size_t period, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv, tb_size_t refn)
 {
     // check
-    tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->heap && func, tb_null);
+    tb_assert_and_check_return_val(timer && timer->pool && func, tb_null);
 
     // stoped?
     tb_assert_and_check_return_val(!tb_atomic_get(&timer->stop), tb_null);
@@ -550,14 +767,16 @@ tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, t
     if (task_impl)
     {
         // the top when 
-        if (tb_heap_size(timer->heap))
+        if (timer->size || tb_list_entry_size(&timer->ready))
         {
-            tb_timer_task_impl_t* task_impl = (tb_timer_task_impl_t*)tb_heap_top(timer->heap);
-            if (task_impl) when_top = task_impl->when;
+            tb_hong_t next = tb_list_entry_size(&timer->ready)? timer->base : tb_timer_wheel_next(timer);
+            if (next >= 0) when_top = next;
         }
+        // the wheel is empty? reset the base time
+        else timer->base = tb_timer_now(timer);
 
         // init task
-        task_impl->refn      = 2;
+        task_impl->refn      = refn;
         task_impl->func      = func;
         task_impl->priv      = priv;
         task_impl->when      = when;
@@ -565,7 +784,7 @@ tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, t
         task_impl->repeat    = repeat? 1 : 0;
 
         // add task
-        tb_heap_put(timer->heap, task_impl);
+        tb_timer_wheel_insert(timer, task_impl);
 
         // the event
         event = timer->event;
@@ -579,7 +798,20 @@ tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, t
         tb_event_post(event);
 
     // ok?
-    return (tb_timer_task_ref_t)task_impl;
+    return task_impl;
+}
+tb_timer_task_ref_t tb_timer_task_init(tb_timer_ref_t self, tb_size_t delay, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_timer_t* timer = (tb_timer_t*)self;
+    tb_assert_and_check_return_val(timer && func, tb_null);
+
+    // add task_impl
+    return tb_timer_task_init_at(self, tb_timer_now(timer) + delay, delay, repeat, func, priv);
+}
+tb_timer_task_ref_t tb_timer_task_init_at(tb_timer_ref_t self, tb_hize_t when, tb_size_t period, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv)
+{
+    return (tb_timer_task_ref_t)tb_timer_task_add((tb_timer_t*)self, when, period, repeat, func, priv, 2);
 }
 tb_timer_task_ref_t tb_timer_task_init_after(tb_timer_ref_t self, tb_hize_t after, tb_size_t period, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv)
 {
@@ -601,50 +833,7 @@ tb_void_t tb_timer_task_post(tb_timer_ref_t self, tb_size_t delay, tb_bool_t rep
 }
 tb_void_t tb_timer_task_post_at(tb_timer_ref_t self, tb_hize_t when, tb_size_t period, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv)
 {
-    // check
-    tb_timer_t* timer = (tb_timer_t*)self;
-    tb_assert_and_check_return(timer && timer->pool && timer->heap && func);
-
-    // stoped?
-    tb_assert_and_check_return(!tb_atomic_get(&timer->stop));
-
-    // enter
-    tb_spinlock_enter(&timer->lock);
-
-    // make task
-    tb_event_ref_t          event = tb_null;
-    tb_hize_t               when_top = -1;
-    tb_timer_task_impl_t*   task_impl = (tb_timer_task_impl_t*)tb_fixed_pool_malloc0(timer->pool);
-    if (task_impl)
-    {
-        // the top when 
-        if (tb_heap_size(timer->heap))
-        {
-            tb_timer_task_impl_t* task_impl = (tb_timer_task_impl_t*)tb_heap_top(timer->heap);
-            if (task_impl) when_top = task_impl->when;
-        }
-
-        // init task
-        task_impl->refn      = 1;
-        task_impl->func      = func;
-        task_impl->priv      = priv;
-        task_impl->when      = when;
-        task_impl->period    = period;
-        task_impl->repeat    = repeat? 1 : 0;
-
-        // add task
-        tb_heap_put(timer->heap, task_impl);
-
-        // the event
-        event = timer->event;
-    }
-
-    // leave
-    tb_spinlock_leave(&timer->lock);
-
-    // post event if the top task is changed
-    if (event && task_impl && when < when_top)
-        tb_event_post(event);
+    tb_timer_task_add((tb_timer_t*)self, when, period, repeat, func, priv, 1);
 }
 tb_void_t tb_timer_task_post_after(tb_timer_ref_t self, tb_hize_t after, tb_size_t period, tb_bool_t repeat, tb_timer_task_func_t func, tb_cpointer_t priv)
 {
@@ -668,19 +857,11 @@ tb_void_t tb_timer_task_exit(tb_timer_ref_t self, tb_timer_task_ref_t task)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // remove it?
-    if (task_impl->refn > 1)
-    {
-        // refn--
-        task_impl->refn--;
+    // remove it from the wheel or the ready list if it has been not expired
+    if (task_impl->slot != TB_TIMER_WHEEL_SLOT_NONE) tb_timer_wheel_remove(timer, task_impl);
 
-        // cancel task 
-        task_impl->func      = tb_null;
-        task_impl->priv      = tb_null;
-        task_impl->repeat    = 0;
-    }
-    // remove it from pool directly if the task_impl have been expired 
-    else tb_fixed_pool_free(timer->pool, task_impl);
+    // remove it from pool directly
+    tb_fixed_pool_free(timer->pool, task_impl);
 
     // leave
     tb_spinlock_leave(&timer->lock);
@@ -699,17 +880,14 @@ tb_void_t tb_timer_task_kill(tb_timer_ref_t self, tb_timer_task_ref_t task)
     tb_spinlock_enter(&timer->lock);
 
     // done
+    tb_event_ref_t event = tb_null;
     do
     {
         // expired or removed?
-        tb_check_break(task_impl->refn == 2);
-
-        // find it
-        tb_size_t itor = tb_find_all_if(timer->heap, tb_timer_pred_by_task, task_impl);
-        tb_assert_and_check_break(itor != tb_iterator_tail(timer->heap));
+        tb_check_break(task_impl->refn == 2 && task_impl->slot != TB_TIMER_WHEEL_SLOT_NONE);
 
         // remove this task
-        tb_heap_remove(timer->heap, itor);
+        tb_timer_wheel_remove(timer, task_impl);
 
         // killed
         task_impl->killed = 1;
@@ -720,11 +898,17 @@ tb_void_t tb_timer_task_kill(tb_timer_ref_t self, tb_timer_task_ref_t task)
         // modify when => now
         task_impl->when = tb_timer_now(timer);
 
-        // re-add task_impl
-        tb_heap_put(timer->heap, task_impl);
+        // move it to the ready list
+        tb_timer_wheel_ready(timer, task_impl);
+
+        // the event
+        event = timer->event;
 
     } while (0);
 
     // leave
     tb_spinlock_leave(&timer->lock);
+
+    // post event for spaking the killed task
+    if (event) tb_event_post(event);
 }
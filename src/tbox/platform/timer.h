@@ -97,6 +97,9 @@ tb_void_t           tb_timer_clear(tb_timer_ref_t timer);
 tb_size_t           tb_timer_delay(tb_timer_ref_t timer);
 
 /*! the timer top when
+ *
+ * @note it may be a little earlier than the when of the top task if this task is far away, 
+ * because the tasks are stored in the hierarchical timing wheel
  *
  * @param timer     the timer 
  *
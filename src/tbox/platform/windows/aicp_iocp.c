@@ -691,7 +691,7 @@ static tb_long_t tb_iocp_spak_clos(tb_iocp_ptor_impl_t* impl, tb_aice_ref_t resp
     for (i = 0; i < n; i++) aico->base.timeout[i] = -1;
 
     // closed
-    tb_atomic_set(&aico->base.state, TB_STATE_CLOSED);
+    tb_atomic_set_explicit(&aico->base.state, TB_STATE_CLOSED, TB_ATOMIC_RELEASE);
 
     // clear bDisconnectEx
     aico->bDisconnectEx = 0;
@@ -1913,7 +1913,7 @@ static tb_bool_t tb_iocp_post_clos(tb_iocp_ptor_impl_t* impl, tb_aice_ref_t aice
     for (i = 0; i < n; i++) aico->base.timeout[i] = -1;
 
     // closed
-    tb_atomic_set(&aico->base.state, TB_STATE_CLOSED);
+    tb_atomic_set_explicit(&aico->base.state, TB_STATE_CLOSED, TB_ATOMIC_RELEASE);
 
     // clear bDisconnectEx
     aico->bDisconnectEx = 0;
@@ -374,6 +374,36 @@ tb_hize_t tb_file_size(tb_file_ref_t file)
     LARGE_INTEGER p = {{0}};
     return pGetFileSizeEx(file, &p)? (tb_hong_t)p.QuadPart : 0;
 }
+tb_byte_t const* tb_file_mmap(tb_file_ref_t file, tb_size_t* psize)
+{
+    // check
+    tb_assert_and_check_return_val(file && psize, tb_null);
+
+    // the file size, the empty file cannot be mapped
+    tb_hize_t size = tb_file_size(file);
+    tb_check_return_val(size && (tb_hize_t)(tb_size_t)size == size, tb_null);
+
+    // make mapping
+    HANDLE mapping = CreateFileMappingW((HANDLE)file, tb_null, PAGE_READONLY, 0, 0, tb_null);
+    tb_check_return_val(mapping, tb_null);
+
+    // map it, the view will keep the mapping alive
+    tb_pointer_t data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, (SIZE_T)size);
+    CloseHandle(mapping);
+    tb_check_return_val(data, tb_null);
+
+    // ok
+    *psize = (tb_size_t)size;
+    return (tb_byte_t const*)data;
+}
+tb_bool_t tb_file_munmap(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // unmap it
+    return UnmapViewOfFile((LPCVOID)data)? tb_true : tb_false;
+}
 tb_bool_t tb_file_info(tb_char_t const* path, tb_file_info_t* info)
 {
     // check
@@ -1143,6 +1143,13 @@ static tb_bool_t tb_async_stream_sock_impl_ctrl(tb_async_stream_ref_t stream, tb
             impl->balived = balived? 1 : 0;
             return tb_true;
         }
+    case TB_STREAM_CTRL_SOCK_GET_SOCK:
+        {
+            tb_socket_ref_t* psock = (tb_socket_ref_t*)tb_va_arg(args, tb_socket_ref_t*);
+            tb_assert_and_check_return_val(psock, tb_false);
+            *psock = impl->aico? tb_aico_sock(impl->aico) : tb_null;
+            return tb_true;
+        }
     default:
         break;
     }
@@ -227,6 +227,18 @@ static tb_bool_t tb_stream_file_impl_ctrl(tb_stream_ref_t stream, tb_size_t ctrl
             // is stream
             impl->bstream = (tb_bool_t)tb_va_arg(args, tb_bool_t);
 
+            // ok
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_FILE_GET_FILE:
+        {
+            // the pfile
+            tb_file_ref_t* pfile = (tb_file_ref_t*)tb_va_arg(args, tb_file_ref_t*);
+            tb_assert_and_check_return_val(pfile, tb_false);
+
+            // get file, the stream file has no random access
+            *pfile = !impl->bstream? impl->file : tb_null;
+
             // ok
             return tb_true;
         }
@@ -269,15 +269,15 @@ static tb_bool_t tb_stream_sock_impl_clos(tb_stream_ref_t stream)
     tb_stream_sock_impl_t* impl = tb_stream_sock_impl_cast(stream);
     tb_assert_and_check_return_val(impl, tb_false);
 
+    // keep alive? not close it and the ssl session will be reused
+    tb_check_return_val(!impl->balived, tb_true);
+
 #ifdef TB_SSL_ENABLE
     // close ssl
     if (tb_url_ssl(tb_stream_url(stream)) && impl->hssl)
         tb_ssl_clos(impl->hssl);
 #endif
 
-    // keep alive? not close it
-    tb_check_return_val(!impl->balived, tb_true);
-
     // exit sock
     if (impl->sock && !tb_socket_exit(impl->sock)) return tb_false;
     impl->sock = tb_null;
@@ -574,6 +574,13 @@ static tb_bool_t tb_stream_sock_impl_ctrl(tb_stream_ref_t stream, tb_size_t ctrl
             impl->balived = balived? 1 : 0;
             return tb_true;
         }
+    case TB_STREAM_CTRL_SOCK_GET_SOCK:
+        {
+            tb_socket_ref_t* psock = (tb_socket_ref_t*)tb_va_arg(args, tb_socket_ref_t*);
+            tb_assert_and_check_return_val(psock, tb_false);
+            *psock = impl->sock;
+            return tb_true;
+        }
     default:
         break;
     }
@@ -108,11 +108,13 @@ typedef enum __tb_stream_ctrl_e
 ,   TB_STREAM_CTRL_FILE_GET_MODE            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 1)
 ,   TB_STREAM_CTRL_FILE_SET_MODE            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 2)
 ,   TB_STREAM_CTRL_FILE_IS_STREAM           = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 3)
+,   TB_STREAM_CTRL_FILE_GET_FILE            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 4)
 
     // the stream for sock
 ,   TB_STREAM_CTRL_SOCK_GET_TYPE            = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 1)
 ,   TB_STREAM_CTRL_SOCK_SET_TYPE            = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 2)
 ,   TB_STREAM_CTRL_SOCK_KEEP_ALIVE          = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 3)
+,   TB_STREAM_CTRL_SOCK_GET_SOCK            = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 4)
 
     // the stream for http
 ,   TB_STREAM_CTRL_HTTP_GET_HEAD            = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 1)
@@ -751,6 +751,98 @@ tb_bool_t tb_stream_need(tb_stream_ref_t stream, tb_byte_t** data, tb_size_t siz
     // ok
     return tb_true;
 }
+tb_long_t tb_stream_peek(tb_stream_ref_t stream, tb_byte_t** data, tb_size_t size)
+{
+    // check 
+    tb_stream_impl_t* impl = tb_stream_impl(stream);
+    tb_assert_and_check_return_val(data && size, -1);
+
+    // check stream
+    tb_assert_and_check_return_val(impl && tb_stream_is_opened(stream) && impl->read && impl->wait, -1);
+
+    // stoped?
+    tb_assert_and_check_return_val(TB_STATE_OPENED == tb_atomic_get(&impl->istate), -1);
+
+    // have writed cache? sync first
+    if (impl->bwrited && !tb_queue_buffer_null(&impl->cache) && !tb_stream_sync(stream, tb_false)) return -1;
+
+    // switch to the read cache mode
+    if (impl->bwrited && tb_queue_buffer_null(&impl->cache)) impl->bwrited = 0;
+
+    // check the cache mode, must be read cache
+    tb_assert_and_check_return_val(!impl->bwrited, -1);
+
+    // not enough? grow the cache first
+    if (tb_queue_buffer_maxn(&impl->cache) < size) tb_queue_buffer_resize(&impl->cache, size);
+
+    // check
+    tb_assert_and_check_return_val(tb_queue_buffer_maxn(&impl->cache) && size <= tb_queue_buffer_maxn(&impl->cache), -1);
+
+    // no cached data? fill the cache once
+    if (tb_queue_buffer_null(&impl->cache))
+    {
+        // enter cache for push
+        tb_size_t   push = 0;
+        tb_byte_t*  tail = tb_queue_buffer_push_init(&impl->cache, &push);
+        tb_assert_and_check_return_val(tail && push, -1);
+        if (push > size) push = size;
+
+        // not read the data out of the stream end if the stream size is known
+        tb_hong_t total = tb_stream_size(stream);
+        if (total >= 0)
+        {
+            tb_hize_t offset = tb_stream_offset(stream);
+            push = (tb_size_t)tb_min(push, (tb_hize_t)total > offset? (tb_hize_t)total - offset : 0);
+        }
+
+        // read the available data
+        tb_size_t read = 0;
+        while (push && TB_STATE_OPENED == tb_atomic_get(&impl->istate))
+        {
+            // read data
+            tb_long_t real = impl->read(stream, tail, push);
+
+            // ok?
+            if (real > 0)
+            {
+                read = real;
+                break;
+            }
+            // no data? wait it
+            else if (!real)
+            {
+                // wait
+                real = impl->wait(stream, TB_STREAM_WAIT_READ, tb_stream_timeout(stream));
+
+                // ok?
+                tb_check_break(real > 0);
+            }
+            // failed or end?
+            else break;
+        }
+
+        // leave cache for push
+        tb_queue_buffer_push_exit(&impl->cache, read);
+    }
+
+    // end?
+    tb_size_t left = tb_queue_buffer_size(&impl->cache);
+    if (!left)
+    {
+        // killed? save state
+        if (!impl->state && (TB_STATE_KILLING == tb_atomic_get(&impl->istate)))
+            impl->state = TB_STATE_KILLED;
+
+        // end
+        return -1;
+    }
+
+    // save data
+    *data = tb_queue_buffer_head(&impl->cache);
+
+    // ok
+    return (tb_long_t)tb_min(left, size);
+}
 tb_long_t tb_stream_read(tb_stream_ref_t stream, tb_byte_t* data, tb_size_t size)
 {
     // check 
@@ -1128,6 +1220,24 @@ tb_bool_t tb_stream_seek(tb_stream_ref_t stream, tb_hize_t offset)
 }
 tb_bool_t tb_stream_skip(tb_stream_ref_t stream, tb_hize_t size)
 {
+    // check 
+    tb_stream_impl_t* impl = tb_stream_impl(stream);
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // skip it at the read cache directly? 
+    if (!impl->bwrited && size && size <= tb_queue_buffer_size(&impl->cache) && TB_STATE_OPENED == tb_atomic_get(&impl->istate))
+    {
+        // skip it
+        tb_queue_buffer_pull_exit(&impl->cache, (tb_size_t)size);
+
+        // save offset
+        impl->offset += size;
+
+        // ok
+        return tb_true;
+    }
+
+    // seek it
     return tb_stream_seek(stream, tb_stream_offset(stream) + size);
 }
 tb_long_t tb_stream_bread_line(tb_stream_ref_t stream, tb_char_t* data, tb_size_t size)
@@ -699,6 +699,34 @@ tb_bool_t               tb_stream_sync(tb_stream_ref_t stream, tb_bool_t bclosin
  */
 tb_bool_t               tb_stream_need(tb_stream_ref_t stream, tb_byte_t** data, tb_size_t size);
 
+/*! peek stream
+ *
+ * peek the cached data without reading it, 
+ * and only fill the cache once if the cache is empty
+ *
+ * @code
+ 
+    // peek the data as much as possible
+    tb_byte_t*  data = tb_null;
+    tb_long_t   size = tb_stream_peek(stream, &data, 8192);
+    if (size > 0)
+    {
+        // ..
+
+        // skip the scanned data
+        tb_stream_skip(stream, size);
+    }
+
+ * @endcode
+ *
+ * @param stream        the stream
+ * @param data          the data, it is valid until reading the stream next time
+ * @param size          the maximum size
+ *
+ * @return              the real size, -1: end or failed
+ */
+tb_long_t               tb_stream_peek(tb_stream_ref_t stream, tb_byte_t** data, tb_size_t size);
+
 /*! seek stream
  *
  * @param stream        the stream
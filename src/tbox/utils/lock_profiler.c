@@ -59,6 +59,9 @@ typedef struct __tb_lock_profiler_item_t
     // the occupied count
     tb_atomic_t                     size;
 
+    // the parked count
+    tb_atomic_t                     park;
+
     // the lock name
     tb_atomic_t                     name;
 
@@ -72,6 +75,35 @@ typedef struct __tb_lock_profiler_t
 
 }tb_lock_profiler_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_lock_profiler_item_t* tb_lock_profiler_item(tb_lock_profiler_t* profiler, tb_pointer_t lock)
+{
+    // check
+    tb_check_return_val(profiler && lock, tb_null);
+
+    // the lock address
+    tb_size_t addr = (tb_size_t)lock;
+
+    // compile the hash value
+    addr ^= (addr >> 8) ^ (addr >> 16);
+
+    // walk
+    tb_size_t i = 0;
+    for (i = 0; i < 16; i++, addr++)
+    {
+        // the item
+        tb_lock_profiler_item_t* item = &profiler->list[addr & (TB_LOCK_PROFILER_MAXN - 1)];
+
+        // is this lock?
+        if (lock == (tb_pointer_t)tb_atomic_get(&item->lock)) return item;
+    }
+
+    // no this lock
+    return tb_null;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * instance implementation
  */
@@ -127,7 +159,7 @@ tb_void_t tb_lock_profiler_dump(tb_handle_t handle)
         if ((lock = (tb_pointer_t)tb_atomic_get(&item->lock)))
         {
             // dump lock
-            tb_trace_i("lock: %p, name: %s, occupied: %ld", lock, (tb_char_t const*)tb_atomic_get(&item->name), tb_atomic_get(&item->size));
+            tb_trace_i("lock: %p, name: %s, occupied: %ld, parked: %ld", lock, (tb_char_t const*)tb_atomic_get(&item->name), tb_atomic_get(&item->size), tb_atomic_get(&item->park));
         }
     }
 }
@@ -176,32 +208,13 @@ tb_void_t tb_lock_profiler_register(tb_handle_t handle, tb_pointer_t lock, tb_ch
 }
 tb_void_t tb_lock_profiler_occupied(tb_handle_t handle, tb_pointer_t lock)
 {
-    // check
-    tb_lock_profiler_t* profiler = (tb_lock_profiler_t*)handle;
-    tb_check_return(profiler && lock);
-
-    // the lock address
-    tb_size_t addr = (tb_size_t)lock;
-
-    // compile the hash value
-    addr ^= (addr >> 8) ^ (addr >> 16);
-
-    // walk
-    tb_size_t i = 0;
-    for (i = 0; i < 16; i++, addr++)
-    {
-        // the item
-        tb_lock_profiler_item_t* item = &profiler->list[addr & (TB_LOCK_PROFILER_MAXN - 1)];
-
-        // is this lock?
-        if (lock == (tb_pointer_t)tb_atomic_get(&item->lock))
-        {
-            // occupied++
-            tb_atomic_fetch_and_inc(&item->size);
-
-            // ok
-            break;
-        }
-    }
+    // occupied++
+    tb_lock_profiler_item_t* item = tb_lock_profiler_item((tb_lock_profiler_t*)handle, lock);
+    if (item) tb_atomic_fetch_and_inc(&item->size);
+}
+tb_void_t tb_lock_profiler_parked(tb_handle_t handle, tb_pointer_t lock)
+{
+    // parked++
+    tb_lock_profiler_item_t* item = tb_lock_profiler_item((tb_lock_profiler_t*)handle, lock);
+    if (item) tb_atomic_fetch_and_inc(&item->park);
 }
-
@@ -89,6 +89,13 @@ tb_void_t               tb_lock_profiler_register(tb_handle_t profiler, tb_point
  */
 tb_void_t               tb_lock_profiler_occupied(tb_handle_t profiler, tb_pointer_t lock);
 
+/*! the lock be occupied and the current thread has been parked
+ *
+ * @param profiler      the lock profiler handle
+ * @param lock          the lock address
+ */
+tb_void_t               tb_lock_profiler_parked(tb_handle_t profiler, tb_pointer_t lock);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -28,13 +28,30 @@ option("deprecated")
     set_description("Enable or disable the deprecated interfaces.")
     add_defines_h_if_ok("$(prefix)_API_HAVE_DEPRECATED")
 
+-- add option: thread_cache
+option("thread_cache")
+    set_enable(true)
+    set_showmenu(true)
+    set_category("option")
+    set_description("Enable or disable the thread-local cache for the small allocations")
+    add_defines_h_if_ok("$(prefix)_MEMORY_HAVE_THREAD_CACHE")
+
+-- add option: uring
+option("uring")
+    set_enable(false)
+    set_showmenu(true)
+    set_category("option")
+    set_description("Enable or disable the io_uring proactor for the asio on linux, it is slower than the aiop proactor now.")
+    add_cincludes("linux/io_uring.h")
+    add_defines_h_if_ok("$(prefix)_ASIO_HAVE_URING")
+
 -- add option: smallest
 option("smallest")
     set_enable(false)
     set_showmenu(true)
     set_category("option")
     set_description("Enable the smallest compile mode and disable all modules.")
-    add_rbindings("info", "deprecated")
+    add_rbindings("info", "deprecated", "thread_cache", "uring")
     add_rbindings("xml", "zip", "asio", "hash", "regex", "object", "thread", "network", "charset", "database")
     add_rbindings("zlib", "mysql", "sqlite3", "openssl", "polarssl", "pcre2", "pcre")
 
@@ -78,7 +95,7 @@ target("tbox")
     add_packages("zlib", "mysql", "sqlite3", "openssl", "polarssl", "pcre2", "pcre", "base")
 
     -- add options
-    add_options("info", "float", "wchar", "deprecated")
+    add_options("info", "float", "wchar", "deprecated", "thread_cache", "uring")
 
     -- add modules
     add_options("xml", "zip", "asio", "hash", "regex", "object", "thread", "network", "charset", "database")
@@ -148,6 +165,7 @@ target("tbox")
         add_files("asio/aico.c")
         add_files("asio/aicp.c")
         add_files("asio/http.c")
+        add_files("asio/httpd.c")
         add_files("asio/dns.c")
         add_files("stream/**async_**.c")
         add_files("stream/transfer_pool.c")
@@ -312,11 +330,15 @@ target("tbox")
     add_cfuncs("posix", nil,        "unistd.h",                         "pread64", "pwrite64")
     add_cfuncs("posix", nil,        "unistd.h",                         "fdatasync")
     add_cfuncs("posix", nil,        "sys/sendfile.h",                   "sendfile")
+    add_cfuncs("posix", nil,        "sys/mman.h",                       "mmap")
     add_cfuncs("posix", nil,        "sys/epoll.h",                      "epoll_create", "epoll_wait")
     add_cfuncs("posix", nil,        "spawn.h",                          "posix_spawnp")
     add_cfuncs("posix", nil,        "unistd.h",                         "execvp", "execvpe", "fork", "vfork")
     add_cfuncs("posix", nil,        "sys/wait.h",                       "waitpid")
 
+    -- add the interfaces for linux
+    add_cfuncs("linux", nil,        {"unistd.h", "sys/syscall.h", "linux/futex.h"}, "futex{syscall(SYS_futex, 0, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);}")
+
     -- add the interfaces for systemv
     add_cfuncs("systemv", nil,      {"sys/sem.h", "sys/ipc.h"},         "semget", "semtimedop")
 
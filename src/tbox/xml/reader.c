@@ -33,6 +33,9 @@
  */
 #include "reader.h"
 #include "../charset/charset.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -44,6 +47,13 @@
 #   define TB_XML_READER_ATTRIBUTES_MAXN        (128)
 #endif
 
+// the peek maxn for scanning the stream cache
+#ifdef __tb_small__
+#   define TB_XML_READER_PEEK_MAXN              (8192)
+#else
+#   define TB_XML_READER_PEEK_MAXN              (65536)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -84,11 +94,15 @@ typedef struct __tb_xml_reader_impl_t
     // the text
     tb_string_t             text;
 
-    // the attribute name
-    tb_string_t             attribute_name;
+    /* the current token, the element data between '<' and '>' or the text data
+     *
+     * it refers the stream cache directly if the whole token is in it, 
+     * otherwise it refers the element or text string which the token is copied to 
+     */
+    tb_char_t const*        token;
 
-    // the attribute data
-    tb_string_t             attribute_data;
+    // the current token size
+    tb_size_t               token_size;
 
     // the attributes
     tb_xml_attribute_t      attributes[TB_XML_READER_ATTRIBUTES_MAXN];
@@ -98,47 +112,180 @@ typedef struct __tb_xml_reader_impl_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * parser implementation
  */
-static tb_char_t const* tb_xml_reader_element_parse(tb_xml_reader_impl_t* reader)
+static __tb_inline__ tb_size_t tb_xml_reader_scan(tb_byte_t const* p, tb_size_t i, tb_size_t n, tb_char_t ch)
+{
+#ifdef TB_ARCH_SSE2
+    // find the character by 16-bytes
+    __m128i c = _mm_set1_epi8(ch);
+    for (; i + 16 <= n; i += 16)
+    {
+        tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p + i)), c));
+        if (m) return i + tb_bits_fb1_u32_le(m);
+    }
+#endif
+
+    // find the left characters
+    for (; i < n && p[i] != (tb_byte_t)ch; i++) ;
+
+    // ok
+    return i;
+}
+static tb_bool_t tb_xml_reader_element_done(tb_char_t const* element, tb_size_t size)
+{
+    // is comment: <!-- text -->? the text may contain '>'
+    if (size >= 3 && !tb_strncmp(element, "!--", 3))
+        return (size >= 5 && element[size - 2] == '-' && element[size - 1] == '-')? tb_true : tb_false;
+
+    // is cdata: <![CDATA[ text ]]>? the text may contain '>'
+    if (size >= 8 && !tb_strnicmp(element, "![CDATA[", 8))
+        return (size >= 10 && element[size - 2] == ']' && element[size - 1] == ']')? tb_true : tb_false;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_xml_reader_element_parse(tb_xml_reader_impl_t* reader)
 {
     // clear element
     tb_string_clear(&reader->element);
+    reader->token       = tb_null;
+    reader->token_size  = 0;
 
-    // parse element
-    tb_char_t ch = '\0';
-    tb_size_t in = 0;
-    while (tb_stream_bread_s8(reader->rstream, (tb_sint8_t*)&ch))
+    // skip '<'
+    if (!tb_stream_skip(reader->rstream, 1)) return tb_false;
+
+    // parse element: <...>
+    tb_bool_t   copied = tb_false;
+    tb_byte_t*  p = tb_null;
+    tb_long_t   n = 0;
+    while ((n = tb_stream_peek(reader->rstream, &p, TB_XML_READER_PEEK_MAXN)) > 0 && p)
     {
-        // append element
-        if (!in && ch == '<') in = 1;
-        else if (in)
+        // find '>'
+        tb_size_t b = 0;
+        tb_size_t i = 0;
+        while ((i = tb_xml_reader_scan(p, i, n, '>')) < (tb_size_t)n)
         {
-            if (ch != '>') tb_string_chrcat(&reader->element, ch);
-            else return tb_string_cstr(&reader->element);
+            // the element data
+            tb_char_t const*    data = (tb_char_t const*)p;
+            tb_size_t           size = i;
+            if (copied)
+            {
+                // append it
+                if (i > b) tb_string_cstrncat(&reader->element, (tb_char_t const*)p + b, i - b);
+                b = i;
+
+                // the copied data
+                data = tb_string_cstr(&reader->element);
+                size = tb_string_size(&reader->element);
+            }
+
+            // end?
+            if (tb_xml_reader_element_done(data, size))
+            {
+                // save token
+                reader->token       = data;
+                reader->token_size  = size;
+
+                // skip it
+                return tb_stream_skip(reader->rstream, i + 1);
+            }
+
+            // next
+            i++;
         }
+
+        // the element is cut by the cache end, copy it
+        if ((tb_size_t)n > b) tb_string_cstrncat(&reader->element, (tb_char_t const*)p + b, n - b);
+        copied = tb_true;
+
+        // skip it
+        if (!tb_stream_skip(reader->rstream, n)) break;
     }
 
     // failed
     tb_assertf(0, "invalid element: %s from %s", tb_string_cstr(&reader->element), tb_url_cstr(tb_stream_url(reader->istream)));
-    return tb_null;
+    return tb_false;
 }
-static tb_char_t const* tb_xml_reader_text_parse(tb_xml_reader_impl_t* reader)
+static tb_bool_t tb_xml_reader_text_parse(tb_xml_reader_impl_t* reader)
 {
     // clear text
     tb_string_clear(&reader->text);
-
-    // parse text
-    tb_char_t* pc = tb_null;
-    while (tb_stream_need(reader->rstream, (tb_byte_t**)&pc, 1) && pc)
+    reader->token       = tb_null;
+    reader->token_size  = 0;
+
+    // parse text: <> ... <>
+    tb_bool_t   copied = tb_false;
+    tb_byte_t*  p = tb_null;
+    tb_long_t   n = 0;
+    while ((n = tb_stream_peek(reader->rstream, &p, TB_XML_READER_PEEK_MAXN)) > 0 && p)
     {
-        // is end? </ ..>
-        if (pc[0] == '<') return tb_string_cstr(&reader->text);
-        else
+        // find '<'
+        tb_size_t i = tb_xml_reader_scan(p, 0, n, '<');
+        if (i < (tb_size_t)n)
         {
-            tb_string_chrcat(&reader->text, *pc);
-            if (!tb_stream_skip(reader->rstream, 1)) return tb_null;
+            // save token
+            if (copied)
+            {
+                if (i) tb_string_cstrncat(&reader->text, (tb_char_t const*)p, i);
+                reader->token       = tb_string_cstr(&reader->text);
+                reader->token_size  = tb_string_size(&reader->text);
+            }
+            else
+            {
+                reader->token       = (tb_char_t const*)p;
+                reader->token_size  = i;
+            }
+
+            // skip it
+            return tb_stream_skip(reader->rstream, i);
         }
+
+        // the text is cut by the cache end, copy it
+        tb_string_cstrncat(&reader->text, (tb_char_t const*)p, n);
+        copied = tb_true;
+
+        // skip it
+        if (!tb_stream_skip(reader->rstream, n)) break;
     }
-    return tb_null;
+
+    // failed
+    return tb_false;
+}
+static tb_void_t tb_xml_reader_token_save(tb_xml_reader_impl_t* reader)
+{
+    // copy the element token from the stream cache before switching stream
+    if (reader->token && reader->token != tb_string_cstr(&reader->element))
+        reader->token = tb_string_cstrncpy(&reader->element, reader->token, reader->token_size);
+}
+static tb_char_t const* tb_xml_reader_attribute_parse(tb_char_t const* p, tb_char_t const* e, tb_xml_slice_t* name, tb_xml_slice_t* data)
+{
+    // skip spaces
+    while (p < e && tb_isspace(*p)) p++;
+
+    // parse name
+    tb_char_t const* b = p;
+    p += tb_xml_reader_scan((tb_byte_t const*)p, 0, e - p, '=');
+    if (p >= e) return tb_null;
+
+    // save name, trim the right spaces
+    name->data = b;
+    name->size = p - b;
+    while (name->size && tb_isspace(b[name->size - 1])) name->size--;
+
+    // parse the data quote
+    for (p++; p < e && (*p != '\'' && *p != '\"'); p++) ;
+    if (p >= e) return tb_null;
+
+    // parse data
+    b = ++p;
+    p += tb_xml_reader_scan((tb_byte_t const*)p, 0, e - p, b[-1]);
+    if (p >= e) return tb_null;
+
+    // save data
+    data->data = b;
+    data->size = p - b;
+
+    // the next attribute
+    return p + 1;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -156,8 +303,6 @@ tb_xml_reader_ref_t tb_xml_reader_init()
     tb_string_init(&reader->charset);
     tb_string_init(&reader->element);
     tb_string_init(&reader->element_name);
-    tb_string_init(&reader->attribute_name);
-    tb_string_init(&reader->attribute_data);
     tb_string_cstrcpy(&reader->version, "2.0");
     tb_string_cstrcpy(&reader->charset, "utf-8");
 
@@ -200,11 +345,6 @@ tb_void_t tb_xml_reader_exit(tb_xml_reader_ref_t reader)
     // exit element name
     tb_string_exit(&impl->element_name);
 
-    // exit attribute name
-    tb_string_exit(&impl->attribute_name);
-
-    // exit attribute data
-    tb_string_exit(&impl->attribute_data);
 
     // exit attributes
     tb_long_t i = 0;
@@ -255,11 +395,6 @@ tb_bool_t tb_xml_reader_open(tb_xml_reader_ref_t reader, tb_stream_ref_t stream,
         // clear name
         tb_string_clear(&impl->element_name);
 
-        // clear attribute name
-        tb_string_clear(&impl->attribute_name);
-
-        // clear attribute data
-        tb_string_clear(&impl->attribute_data);
 
         // clear attributes
         tb_long_t i = 0;
@@ -310,11 +445,6 @@ tb_void_t tb_xml_reader_clos(tb_xml_reader_ref_t reader)
     // clear name
     tb_string_clear(&impl->element_name);
 
-    // clear attribute name
-    tb_string_clear(&impl->attribute_name);
-
-    // clear attribute data
-    tb_string_clear(&impl->attribute_data);
 
     // clear attributes
     tb_long_t i = 0;
@@ -361,11 +491,14 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
         if (*pc == '<') 
         {
             // parse element: <...>
-            tb_char_t const* element = tb_xml_reader_element_parse(impl);
+            if (!tb_xml_reader_element_parse(impl)) break;
+
+            // the element
+            tb_char_t const*    element = impl->token;
+            tb_size_t           size = impl->token_size;
             tb_assert_and_check_break(element);
 
             // is document begin: <?xml version="..." charset=".." ?>
-            tb_size_t size = tb_string_size(&impl->element);
             if (size > 4 && !tb_strnicmp(element, "?xml", 4))
             {
                 // update event
@@ -392,6 +525,9 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
                     if (charset != TB_CHARSET_TYPE_UTF8)
                     {
 #ifdef TB_CONFIG_MODULE_HAVE_CHARSET
+                        // save the element token, the cache of the reader stream will be not used
+                        tb_xml_reader_token_save(impl);
+
                         // init the filter stream
                         if (!impl->fstream) impl->fstream = tb_stream_init_filter_from_charset(impl->istream, charset, TB_CHARSET_TYPE_UTF8);
                         else
@@ -440,63 +576,14 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
             // is comment: <!-- text -->
             else if (size >= 3 && !tb_strncmp(element, "!--", 3))
             {
-                // no comment end?
-                if (element[size - 2] != '-' || element[size - 1] != '-')
-                {
-                    // patch '>'
-                    tb_string_chrcat(&impl->element, '>');
-
-                    // seek to comment end
-                    tb_char_t ch = '\0';
-                    tb_int_t n = 0;
-                    while (tb_stream_bread_s8(impl->rstream, (tb_sint8_t*)&ch))
-                    {
-                        // -->
-                        if (n == 2 && ch == '>') break;
-                        else
-                        {
-                            // append it
-                            tb_string_chrcat(&impl->element, ch);
-
-                            if (ch == '-') n++;
-                            else n = 0;
-                        }
-                    }
-
-                    // update event
-                    if (ch != '\0') impl->event = TB_XML_READER_EVENT_COMMENT;
-                }
-                else impl->event = TB_XML_READER_EVENT_COMMENT;
+                // update event
+                impl->event = TB_XML_READER_EVENT_COMMENT;
             }
             // is cdata: <![CDATA[ text ]]>
             else if (size >= 8 && !tb_strnicmp(element, "![CDATA[", 8))
             {
-                if (element[size - 2] != ']' || element[size - 1] != ']')
-                {
-                    // patch '>'
-                    tb_string_chrcat(&impl->element, '>');
-
-                    // seek to cdata end
-                    tb_char_t ch = '\0';
-                    tb_int_t n = 0;
-                    while (tb_stream_bread_s8(impl->rstream, (tb_sint8_t*)&ch))
-                    {
-                        // ]]>
-                        if (n == 2 && ch == '>') break;
-                        else
-                        {
-                            // append it
-                            tb_string_chrcat(&impl->element, ch);
-
-                            if (ch == ']') n++;
-                            else n = 0;
-                        }
-                    }
-
-                    // update event
-                    if (ch != '\0') impl->event = TB_XML_READER_EVENT_CDATA;
-                }
-                else impl->event = TB_XML_READER_EVENT_CDATA;
+                // update event
+                impl->event = TB_XML_READER_EVENT_CDATA;
             }
             // is empty element: <name/>
             else if (size > 1 && element[size - 1] == '/')
@@ -521,12 +608,15 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
         else if (*pc)
         {
             // parse text: <> ... <>
-            tb_char_t const* text = tb_xml_reader_text_parse(impl);
-            if (text && tb_string_cstrcmp(&impl->text, "\r\n") && tb_string_cstrcmp(&impl->text, "\n"))
-                impl->event = TB_XML_READER_EVENT_TEXT;
+            if (!tb_xml_reader_text_parse(impl)) break;
 
-            // trace
-//          tb_trace_d("%s", text);
+            // the text
+            tb_char_t const*    text = impl->token;
+            tb_size_t           size = impl->token_size;
+
+            // not "\n" or "\r\n"?
+            if (!((size == 1 && text[0] == '\n') || (size == 2 && text[0] == '\r' && text[1] == '\n')))
+                impl->event = TB_XML_READER_EVENT_TEXT;
         }
         else 
         {
@@ -801,13 +891,12 @@ tb_char_t const* tb_xml_reader_comment(tb_xml_reader_ref_t reader)
     tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_COMMENT, tb_null);
 
     // init
-    tb_char_t const*    p = tb_string_cstr(&impl->element);
-    tb_size_t           n = tb_string_size(&impl->element);
-    tb_assert_and_check_return_val(p && n >= 6, tb_null);
+    tb_char_t const*    p = impl->token;
+    tb_size_t           n = impl->token_size;
+    tb_assert_and_check_return_val(p && n >= 5, tb_null);
 
     // comment
-    tb_string_cstrncpy(&impl->text, p + 3, n - 5);
-    return tb_string_cstr(&impl->text);
+    return n > 5? tb_string_cstrncpy(&impl->text, p + 3, n - 5) : tb_null;
 }
 tb_char_t const* tb_xml_reader_cdata(tb_xml_reader_ref_t reader)
 {
@@ -816,43 +905,73 @@ tb_char_t const* tb_xml_reader_cdata(tb_xml_reader_ref_t reader)
     tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_CDATA, tb_null);
 
     // init
-    tb_char_t const*    p = tb_string_cstr(&impl->element);
-    tb_size_t           n = tb_string_size(&impl->element);
-    tb_assert_and_check_return_val(p && n >= 11, tb_null);
+    tb_char_t const*    p = impl->token;
+    tb_size_t           n = impl->token_size;
+    tb_assert_and_check_return_val(p && n >= 10, tb_null);
 
-    // comment
-    tb_string_cstrncpy(&impl->text, p + 8, n - 10);
-    return tb_string_cstr(&impl->text);
+    // cdata
+    return n > 10? tb_string_cstrncpy(&impl->text, p + 8, n - 10) : tb_null;
 }
 tb_char_t const* tb_xml_reader_text(tb_xml_reader_ref_t reader)
+{
+    // the text slice
+    tb_xml_slice_t text;
+    if (!tb_xml_reader_text_slice(reader, &text)) return tb_null;
+
+    // the text has been copied?
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    if (text.data == tb_string_cstr(&impl->text)) return text.data;
+
+    // copy it
+    return tb_string_cstrncpy(&impl->text, text.data, text.size);
+}
+tb_bool_t tb_xml_reader_text_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* text)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_TEXT, tb_null);
+    tb_assert_and_check_return_val(impl && text && impl->event == TB_XML_READER_EVENT_TEXT, tb_false);
 
-    // text
-    return tb_string_cstr(&impl->text);
+    // save text
+    text->data = impl->token;
+    text->size = impl->token_size;
+
+    // ok?
+    return text->data? tb_true : tb_false;
 }
 tb_char_t const* tb_xml_reader_element(tb_xml_reader_ref_t reader)
+{
+    // the element name slice
+    tb_xml_slice_t name;
+    if (!tb_xml_reader_element_slice(reader, &name)) return tb_null;
+
+    // copy it
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    return tb_string_cstrncpy(&impl->element_name, name.data, name.size);
+}
+tb_bool_t tb_xml_reader_element_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* name)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && ( impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_null);
+    tb_assert_and_check_return_val(impl && name && ( impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
+                                                    ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
+                                                    ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_false);
 
     // init
     tb_char_t const* p = tb_null;
-    tb_char_t const* b = tb_string_cstr(&impl->element);
-    tb_char_t const* e = b + tb_string_size(&impl->element);
-    tb_assert_and_check_return_val(b, tb_null);
+    tb_char_t const* b = impl->token;
+    tb_char_t const* e = b + impl->token_size;
+    tb_assert_and_check_return_val(b, tb_false);
 
     // </name> or <name ... />
     if (b < e && *b == '/') b++;
     for (p = b; p < e && *p && !tb_isspace(*p) && *p != '/'; p++) ;
 
+    // save name
+    name->data = b;
+    name->size = p - b;
+
     // ok?
-    return p > b? tb_string_cstrncpy(&impl->element_name, b, p - b) : tb_null;
+    return p > b;
 }
 tb_char_t const* tb_xml_reader_doctype(tb_xml_reader_ref_t reader)
 {
@@ -861,66 +980,73 @@ tb_char_t const* tb_xml_reader_doctype(tb_xml_reader_ref_t reader)
     tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_DOCUMENT_TYPE, tb_null);
 
     // doctype
-    tb_char_t const* p = tb_string_cstr(&impl->element);
-    tb_assert_and_check_return_val(p, tb_null);
+    tb_char_t const*    p = impl->token;
+    tb_size_t           n = impl->token_size;
+    tb_assert_and_check_return_val(p && n > 8, tb_null);
 
     // skip !DOCTYPE
-    return (p + 9);
+    return n > 9? tb_string_cstrncpy(&impl->text, p + 9, n - 9) : "";
 }
 tb_xml_node_ref_t tb_xml_reader_attributes(tb_xml_reader_ref_t reader)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && ( impl->event == TB_XML_READER_EVENT_DOCUMENT
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
-                                            ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_null);
-
-    // init
-    tb_char_t const* p = tb_string_cstr(&impl->element);
-    tb_char_t const* e = p + tb_string_size(&impl->element);
-
-    // skip name
-    while (p < e && *p && !tb_isspace(*p)) p++;
-    while (p < e && *p && tb_isspace(*p)) p++;
+    tb_assert_and_check_return_val(impl, tb_null);
 
     // parse attributes
-    tb_size_t n = 0;
-    while (p < e)
+    tb_size_t       n = 0;
+    tb_size_t       itor = 0;
+    tb_xml_slice_t  name;
+    tb_xml_slice_t  data;
+    while (n < TB_XML_READER_ATTRIBUTES_MAXN && tb_xml_reader_attribute_slice(reader, &itor, &name, &data))
     {
-        // parse name
-        tb_string_clear(&impl->attribute_name);
-        for (; p < e && *p != '='; p++) if (!tb_isspace(*p)) tb_string_chrcat(&impl->attribute_name, *p);
-        if (*p != '=') break;
-
-        // parse data
-        tb_string_clear(&impl->attribute_data);
-        for (p++; p < e && (*p != '\'' && *p != '\"'); p++) ;
-        if (*p != '\'' && *p != '\"') break;
-        for (p++; p < e && (*p != '\'' && *p != '\"'); p++) tb_string_chrcat(&impl->attribute_data, *p);
-        if (*p != '\'' && *p != '\"') break;
-        p++;
+        // skip the empty attribute
+        if (!name.size || !data.size) continue;
 
-        // append node
-        if (tb_string_cstr(&impl->attribute_name) && tb_string_cstr(&impl->attribute_data))
-        {
-            // node
-            tb_xml_node_ref_t prev = n > 0? (tb_xml_node_ref_t)&impl->attributes[n - 1] : tb_null;
-            tb_xml_node_ref_t node = (tb_xml_node_ref_t)&impl->attributes[n];
+        // node
+        tb_xml_node_ref_t prev = n > 0? (tb_xml_node_ref_t)&impl->attributes[n - 1] : tb_null;
+        tb_xml_node_ref_t node = (tb_xml_node_ref_t)&impl->attributes[n];
 
-            // init node
-            tb_string_strcpy(&node->name, &impl->attribute_name);
-            tb_string_strcpy(&node->data, &impl->attribute_data);
+        // init node
+        tb_string_cstrncpy(&node->name, name.data, name.size);
+        tb_string_cstrncpy(&node->data, data.data, data.size);
 
-            // append node
-            if (prev) prev->next = node;
-            node->next = tb_null;
+        // append node
+        if (prev) prev->next = node;
+        node->next = tb_null;
 
-            // next
-            n++;
-        }
+        // next
+        n++;
     }
 
     // ok?
     return n? (tb_xml_node_ref_t)&impl->attributes[0] : tb_null;
 }
+tb_bool_t tb_xml_reader_attribute_slice(tb_xml_reader_ref_t reader, tb_size_t* pitor, tb_xml_slice_t* name, tb_xml_slice_t* data)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && pitor && name && data && ( impl->event == TB_XML_READER_EVENT_DOCUMENT
+                                                                    ||  impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
+                                                                    ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
+                                                                    ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_false);
+
+    // init
+    tb_char_t const* b = impl->token;
+    tb_char_t const* e = b + impl->token_size;
+    tb_char_t const* p = b + *pitor;
+    tb_check_return_val(b && p < e, tb_false);
+
+    // skip name at the first time
+    if (!*pitor) while (p < e && *p && !tb_isspace(*p)) p++;
+
+    // parse the next attribute
+    p = tb_xml_reader_attribute_parse(p, e, name, data);
+    tb_check_return_val(p, tb_false);
+
+    // save itor
+    *pitor = p - b;
+
+    // ok
+    return tb_true;
+}
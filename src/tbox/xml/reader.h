@@ -57,6 +57,21 @@ typedef enum __tb_xml_reader_event_t
 /// the xml reader ref type
 typedef struct{}*       tb_xml_reader_ref_t;
 
+/*! the xml slice type
+ *
+ * it refers the data of the reader directly and is not null-terminated, 
+ * only valid before the next event.
+ */
+typedef struct __tb_xml_slice_t
+{
+    /// the data
+    tb_char_t const*    data;
+
+    /// the size
+    tb_size_t           size;
+
+}tb_xml_slice_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -253,6 +268,15 @@ tb_char_t const*        tb_xml_reader_charset(tb_xml_reader_ref_t reader);
  */
 tb_char_t const*        tb_xml_reader_element(tb_xml_reader_ref_t reader);
 
+/*! the current xml element name slice without copying it
+ *
+ * @param reader        the xml reader
+ * @param name          the element name slice
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_element_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* name);
+
 /*! the current xml node text
  *
  * @param reader        the xml reader
@@ -260,6 +284,15 @@ tb_char_t const*        tb_xml_reader_element(tb_xml_reader_ref_t reader);
  */
 tb_char_t const*        tb_xml_reader_text(tb_xml_reader_ref_t reader);
 
+/*! the current xml node text slice without copying it
+ *
+ * @param reader        the xml reader
+ * @param text          the text slice
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_text_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* text);
+
 /*! the current xml node cdata
  *
  * @param reader        the xml reader
@@ -288,6 +321,27 @@ tb_char_t const*        tb_xml_reader_doctype(tb_xml_reader_ref_t reader);
  */
 tb_xml_node_ref_t       tb_xml_reader_attributes(tb_xml_reader_ref_t reader);
 
+/*! the next attribute slice of the current xml node without copying it
+ *
+ * @code
+ * tb_size_t        itor = 0;
+ * tb_xml_slice_t   name;
+ * tb_xml_slice_t   data;
+ * while (tb_xml_reader_attribute_slice(reader, &itor, &name, &data))
+ * {
+ *     tb_trace_i("%.*s: %.*s", (tb_int_t)name.size, name.data, (tb_int_t)data.size, data.data);
+ * }
+ * @endcode
+ *
+ * @param reader        the xml reader
+ * @param pitor         the attribute iterator, be zero for the first attribute
+ * @param name          the attribute name slice
+ * @param data          the attribute data slice
+ *
+ * @return              tb_true or tb_false if no more attributes
+ */
+tb_bool_t               tb_xml_reader_attribute_slice(tb_xml_reader_ref_t reader, tb_size_t* pitor, tb_xml_slice_t* name, tb_xml_slice_t* data);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */